@@ -25,4 +25,4 @@ SUBDIRS +=  tests
 #SUBDIRS +=  sample-basic
 #SUBDIRS +=  sample-behaviour
 #SUBDIRS +=  sample-serializer
-#SUBDIRS +=  benchmarks
+SUBDIRS +=  benchmarks
@@ -6,19 +6,33 @@ QT          += core
 DEPENDPATH  += ../src
 INCLUDEPATH += ../src
 
-include (../common.pri)
+include (../src/gtpo.pri)
 
 # On win32, set Google Benchmarks source and library directories manually
 win32-msvc*:GBENCHMARK_DIR =  c:/projects/DELIA/libs/benchmark
 win32-msvc*:INCLUDEPATH     += $$GBENCHMARK_DIR/include
 
-SOURCES	+=  gtpoBenchmarks.cpp
+SOURCES	+=  gtpoBenchmarks.cpp            \
+            gtpoSerializerBenchmarks.cpp  \
+            gtpoEdgeGeometryBenchmarks.cpp \
+            gtpoForceLayoutBenchmarks.cpp  \
+            gtpoLayeredLayoutBenchmarks.cpp  \
+            gtpoTreeLayoutBenchmarks.cpp  \
+            gtpoCompoundLayoutBenchmarks.cpp  \
+            gtpoComponentLayoutBenchmarks.cpp  \
+            gtpoIncrementalLayoutBenchmarks.cpp  \
+            gtpoOrthogonalRouterBenchmarks.cpp   \
+            gtpoEdgeBundlingBenchmarks.cpp
 HEADERS	+=  
 
 CONFIG(debug, debug|release) {
-    linux-g++*:     LIBS	+= -L../build/ -lbenchmark -lprotobuf
+    linux-g++*:     LIBS	+= -L../build/ -lbenchmark -lpthread
     win32-msvc*:    PRE_TARGETDEPS +=  ../build/gtpod.lib
-    win32-msvc*:    LIBS	+= ../build/gtpod.lib $$GBENCHMARK_DIR/src/Debug/benchmark.lib Shlwapi.lib $$PROTOCOL_BUFFER_LIBDIR_DEBUG/libprotobufd.lib
+    win32-msvc*:    LIBS	+= ../build/gtpod.lib $$GBENCHMARK_DIR/src/Debug/benchmark.lib Shlwapi.lib
     win32-g++*:     LIBS	+= -L../build/ -lgtpod
 }
 
+CONFIG(release, debug|release) {
+    linux-g++*:     LIBS	+= -L../build/ -lbenchmark -lpthread
+    win32-msvc*:    LIBS	+= $$GBENCHMARK_DIR/src/Release/benchmark.lib Shlwapi.lib
+}
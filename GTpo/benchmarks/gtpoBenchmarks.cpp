@@ -20,45 +20,346 @@
 //-----------------------------------------------------------------------------
 // This file is a part of the GTpo software.
 //
-// \file	qtpoBenchmarks.cpp
-// \author	benoit@qanava.org
+// \file	gtpoBenchmarks.cpp
+// \author	benoit@destrat.io
 // \date	2016 03 26
 //-----------------------------------------------------------------------------
 
 // STD headers
 #include <list>
 #include <memory>
-#include <iostream>
+#include <vector>
+#include <deque>
+#include <random>
+#include <string>
+#include <cstring>
+#include <unordered_set>
 
 // GTpo headers
 #include <GTpo>
-#include <GTpoStd>
-#include <gtpoProtoSerializer.h>
-#include <gtpoProgressNotifier.h>
+
+// Qt headers
+#ifdef QT_CORE_LIB
+#include <QVector>
+#include <QSet>
+#endif
 
 // Google Benchmark
 #include <benchmark/benchmark.h>
 
-static void BM_GraphCreationWithBehaviours(benchmark::State& state) {
-    stpo::Graph g;
-    while ( state.KeepRunning( ) ) {
-        auto n1 = g.createNode();
-        auto n2 = g.createNode();
-        auto e = g.createEdge( n1, n2 );
+// Topology benchmarks are run on both default gtpo::GraphConfig (STL containers) and a Qt container configuration
+// similar to qan::GraphConfig, graph size range from 1k to 1M nodes (benchmarks creating edges are limited to 100k
+// nodes since edge creation is linear in node degree with vector containers, complete construction is quadratic). Results are written in JSON format to gtpoBenchmarks.json by default to
+// track regressions between releases:
+//   $ ./gtpoBenchmarks --benchmark_filter=Topology
+//   $ ./gtpoBenchmarks --benchmark_out=gtpo-2.1.json --benchmark_out_format=json
+//   $ compare.py benchmarks gtpo-2.0.json gtpo-2.1.json      (compare.py is distributed with Google Benchmark)
+
+#ifdef QT_CORE_LIB
+template < typename T >
+struct QtContainerAdapter { };
+
+template < typename T >
+struct QtContainerAdapter< QVector<T> > {
+    inline static void          insert( T t, QVector<T>& c ) { c.append( t ); }
+    inline static void          insert( T t, QVector<T>& c, int i ) { c.insert( i, t ); }
+    inline static void          remove( const T& t, QVector<T>& c ) { c.removeAll(t); }
+    inline static std::size_t   size( QVector<T>& c ) { return c.size(); }
+    inline static bool          contains( const QVector<T>& c, const T& t ) { return c.contains(t); }
+    inline static void          reserve( QVector<T>& c, std::size_t s) { c.reserve(static_cast<int>(s)); }
+};
+
+template < typename T >
+struct QtContainerAdapter< QSet<T> > {
+    inline static void          insert( T t, QSet<T>& c ) { c.insert( t ); }
+    inline static void          remove( const T& t, QSet<T>& c ) { c.remove(t); }
+    inline static std::size_t   size( QSet<T>& c ) { return c.size(); }
+    inline static bool          contains( const QSet<T>& c, const T& t ) { return c.contains(t); }
+    inline static void          reserve( QSet<T>& c, std::size_t s) { c.reserve(static_cast<int>(s)); }
+};
+
+template< typename T >
+inline bool operator==(const std::weak_ptr<T>& e1, const std::weak_ptr<T>& e2)
+{
+    return gtpo::compare_weak_ptr( e1, e2 );
+}
+
+template<typename T>
+inline uint qHash(const std::weak_ptr<T>& t, uint seed )
+{
+    return qHash( static_cast<T*>( t.lock().get() ), seed );
+}
+
+//! Qt containers configuration, use the same containers than qan::GraphConfig without QObject base classes.
+struct QtGraphConfig : public gtpo::GraphConfig
+{
+    using FinalGroup        = gtpo::GenGroup<QtGraphConfig>;
+    using FinalNode         = gtpo::GenNode<QtGraphConfig, FinalGroup>;
+    using FinalEdge         = gtpo::GenEdge<QtGraphConfig>;
+    using FinalGroupEdge    = gtpo::GenGroupEdge<QtGraphConfig>;
+
+    template <typename T>
+    using container_adapter = QtContainerAdapter<T>;
+
+    template <class...Ts>
+    using NodeContainer = QVector<Ts...>;
+
+    template <class...Ts>
+    using EdgeContainer = QVector<Ts...>;
+
+    template <class T>
+    using SearchContainer = QSet<T>;
+};
+#endif
+
+//! Pseudo random but deterministic index in [0, n) (Knuth multiplicative hash).
+static inline std::size_t   pick( std::size_t i, std::size_t n ) { return ( i * 2654435761u ) % n; }
+
+//! Create \c nodeCount nodes in \c g and return them.
+template < class Config >
+static auto createNodes( gtpo::GenGraph<Config>& g, std::size_t nodeCount ) -> std::vector< typename gtpo::GenGraph<Config>::WeakNode >
+{
+    std::vector< typename gtpo::GenGraph<Config>::WeakNode > nodes;
+    nodes.reserve( nodeCount );
+    for ( std::size_t n = 0; n < nodeCount; ++n )
+        nodes.push_back( g.createNode() );
+    return nodes;
+}
+
+//! Create \c edgeCount edges between random \c nodes.
+template < class Config >
+static void createEdges( gtpo::GenGraph<Config>& g, const std::vector< typename gtpo::GenGraph<Config>::WeakNode >& nodes, std::size_t edgeCount )
+{
+    for ( std::size_t e = 0; e < edgeCount; ++e )
+        g.createEdge( nodes[pick( e, nodes.size() )], nodes[pick( e + 1, nodes.size() )] );
+}
+
+//-----------------------------------------------------------------------------
+// Topology construction
+//-----------------------------------------------------------------------------
+
+template < class Config >
+static void BM_TopologyNodeInsertion(benchmark::State& state) {
+    const auto nodeCount = static_cast<std::size_t>( state.range(0) );
+    while ( state.KeepRunning() ) {
+        state.PauseTiming();
+        auto g = std::make_unique< gtpo::GenGraph<Config> >();
+        state.ResumeTiming();
+        for ( std::size_t n = 0; n < nodeCount; ++n )
+            benchmark::DoNotOptimize( g->createNode() );
+        state.PauseTiming();
+        g.reset();              // Do not measure destruction
+        state.ResumeTiming();
     }
+    state.SetItemsProcessed( static_cast<int64_t>( state.iterations() ) * state.range(0) );
 }
 
-static void BM_GraphCreationWithoutBehaviours(benchmark::State& state) {
-    stpo::Graph g;
-    while ( state.KeepRunning( ) ) {
-        auto n1 = g.createNode();
-        auto n2 = g.createNode();
-        auto e = g.createEdge( n1, n2 );
+template < class Config >
+static void BM_TopologyEdgeInsertion(benchmark::State& state) {
+    const auto nodeCount = static_cast<std::size_t>( state.range(0) );
+    while ( state.KeepRunning() ) {
+        state.PauseTiming();
+        auto g = std::make_unique< gtpo::GenGraph<Config> >();
+        const auto nodes = createNodes( *g, nodeCount );
+        state.ResumeTiming();
+        createEdges( *g, nodes, 4 * nodeCount );
+        state.PauseTiming();
+        g.reset();
+        state.ResumeTiming();
     }
+    state.SetItemsProcessed( static_cast<int64_t>( state.iterations() ) * 4 * state.range(0) );
 }
 
-BENCHMARK(BM_GraphCreationWithBehaviours);
-BENCHMARK(BM_GraphCreationWithoutBehaviours);
+template < class Config >
+static void BM_TopologyGroupInsertion(benchmark::State& state) {
+    const auto groupCount = static_cast<std::size_t>( state.range(0) );
+    while ( state.KeepRunning() ) {
+        state.PauseTiming();
+        auto g = std::make_unique< gtpo::GenGraph<Config> >();
+        state.ResumeTiming();
+        for ( std::size_t n = 0; n < groupCount; ++n )
+            benchmark::DoNotOptimize( g->createGroup() );
+        state.PauseTiming();
+        g.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed( static_cast<int64_t>( state.iterations() ) * state.range(0) );
+}
 
-BENCHMARK_MAIN()
+//-----------------------------------------------------------------------------
+// Topology removal
+//-----------------------------------------------------------------------------
 
+template < class Config >
+static void BM_TopologyRemoveHighDegreeNode(benchmark::State& state) {
+    // Remove the hub of a star graph with range(0) in and range(0) out edges
+    const auto degree = static_cast<std::size_t>( state.range(0) );
+    while ( state.KeepRunning() ) {
+        state.PauseTiming();
+        auto g = std::make_unique< gtpo::GenGraph<Config> >();
+        const auto nodes = createNodes( *g, degree + 1 );
+        for ( std::size_t n = 1; n <= degree; ++n ) {
+            g->createEdge( nodes[0], nodes[n] );
+            g->createEdge( nodes[n], nodes[0] );
+        }
+        state.ResumeTiming();
+        g->removeNode( nodes[0] );
+        state.PauseTiming();
+        g.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed( static_cast<int64_t>( state.iterations() ) * 2 * state.range(0) );
+}
+
+template < class Config >
+static void BM_TopologyClear(benchmark::State& state) {
+    const auto nodeCount = static_cast<std::size_t>( state.range(0) );
+    while ( state.KeepRunning() ) {
+        state.PauseTiming();
+        auto g = std::make_unique< gtpo::GenGraph<Config> >();
+        const auto nodes = createNodes( *g, nodeCount );
+        createEdges( *g, nodes, 4 * nodeCount );
+        state.ResumeTiming();
+        g->clear();
+        state.PauseTiming();
+        g.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed( static_cast<int64_t>( state.iterations() ) * 5 * state.range(0) );
+}
+
+//-----------------------------------------------------------------------------
+// Topology queries
+//-----------------------------------------------------------------------------
+
+template < class Config >
+static void BM_TopologyFindEdge(benchmark::State& state) {
+    static constexpr std::size_t lookupCount = 1024;
+    const auto nodeCount = static_cast<std::size_t>( state.range(0) );
+    gtpo::GenGraph<Config> g;
+    const auto nodes = createNodes( g, nodeCount );
+    createEdges( g, nodes, 4 * nodeCount );
+    std::size_t i = 0;
+    while ( state.KeepRunning() ) {
+        for ( std::size_t l = 0; l < lookupCount; ++l, ++i )    // Half of lookups hit an existing edge
+            benchmark::DoNotOptimize( g.findEdge( nodes[pick( i, nodeCount )], nodes[pick( i + ( i % 2 ), nodeCount )] ) );
+    }
+    state.SetItemsProcessed( static_cast<int64_t>( state.iterations() * lookupCount ) );
+}
+
+template < class Config >
+static void BM_TopologyContains(benchmark::State& state) {
+    static constexpr std::size_t lookupCount = 1024;
+    const auto nodeCount = static_cast<std::size_t>( state.range(0) );
+    gtpo::GenGraph<Config> g;
+    const auto nodes = createNodes( g, nodeCount );
+    std::size_t i = 0;
+    while ( state.KeepRunning() ) {
+        for ( std::size_t l = 0; l < lookupCount; ++l, ++i )
+            benchmark::DoNotOptimize( g.contains( nodes[pick( i, nodeCount )] ) );
+    }
+    state.SetItemsProcessed( static_cast<int64_t>( state.iterations() * lookupCount ) );
+}
+
+//-----------------------------------------------------------------------------
+// Grouping
+//-----------------------------------------------------------------------------
+
+template < class Config >
+static void BM_TopologyGroupUngroupNode(benchmark::State& state) {
+    // Group then ungroup range(0) connected nodes in 16 groups
+    static constexpr std::size_t groupCount = 16;
+    const auto nodeCount = static_cast<std::size_t>( state.range(0) );
+    gtpo::GenGraph<Config> g;
+    const auto nodes = createNodes( g, nodeCount );
+    createEdges( g, nodes, 4 * nodeCount );
+    std::vector< typename gtpo::GenGraph<Config>::WeakGroup > groups;
+    for ( std::size_t n = 0; n < groupCount; ++n )
+        groups.push_back( g.createGroup() );
+    while ( state.KeepRunning() ) {
+        for ( std::size_t n = 0; n < nodeCount; ++n )
+            g.groupNode( groups[n % groupCount], nodes[n] );
+        for ( std::size_t n = 0; n < nodeCount; ++n )
+            g.ungroupNode( groups[n % groupCount], nodes[n] );
+    }
+    state.SetItemsProcessed( static_cast<int64_t>( state.iterations() ) * 2 * state.range(0) );
+}
+
+//-----------------------------------------------------------------------------
+// Traversal
+//-----------------------------------------------------------------------------
+
+template < class Config >
+static void BM_TopologyTraversal(benchmark::State& state) {
+    // Breadth first traversal of all nodes reachable from a root node, using node out nodes
+    using WeakNode = typename gtpo::GenGraph<Config>::WeakNode;
+    const auto nodeCount = static_cast<std::size_t>( state.range(0) );
+    gtpo::GenGraph<Config> g;
+    const auto nodes = createNodes( g, nodeCount );
+    std::mt19937 generator{ 42 };     // Spanning edges: every node is reachable from nodes[0], parents spread over previous nodes
+    for ( std::size_t n = 1; n < nodeCount; ++n )
+        g.createEdge( nodes[std::uniform_int_distribution<std::size_t>{ 0, n - 1 }( generator )], nodes[n] );
+    createEdges( g, nodes, 3 * nodeCount );
+    std::size_t visitedCount = 0;
+    while ( state.KeepRunning() ) {
+        std::unordered_set< const void* > visited;
+        visited.reserve( nodeCount );
+        std::deque< WeakNode > queue{ nodes[0] };
+        visited.insert( nodes[0].lock().get() );
+        while ( !queue.empty() ) {
+            const auto node = queue.front().lock();
+            queue.pop_front();
+            for ( const auto& outNode : node->getOutNodes() ) {
+                const auto out = outNode.lock();
+                if ( out && visited.insert( out.get() ).second )
+                    queue.push_back( outNode );
+            }
+        }
+        visitedCount = visited.size();
+    }
+    state.counters["visited"] = static_cast<double>( visitedCount );
+    state.SetItemsProcessed( static_cast<int64_t>( state.iterations() ) * 4 * state.range(0) );
+}
+
+//-----------------------------------------------------------------------------
+// Benchmarks registration
+//-----------------------------------------------------------------------------
+
+#define GTPO_TOPOLOGY_BENCHMARK( name, config, maxSize )                    \
+    BENCHMARK_TEMPLATE( name, config )->RangeMultiplier( 10 )->Range( 1000, maxSize )->Unit( benchmark::kMicrosecond );
+
+#define GTPO_TOPOLOGY_BENCHMARKS( config )                                  \
+    GTPO_TOPOLOGY_BENCHMARK( BM_TopologyNodeInsertion, config, 1000000 )    \
+    GTPO_TOPOLOGY_BENCHMARK( BM_TopologyEdgeInsertion, config, 100000 )    \
+    GTPO_TOPOLOGY_BENCHMARK( BM_TopologyGroupInsertion, config, 1000000 )   \
+    GTPO_TOPOLOGY_BENCHMARK( BM_TopologyRemoveHighDegreeNode, config, 100000 )  \
+    GTPO_TOPOLOGY_BENCHMARK( BM_TopologyClear, config, 100000 )            \
+    GTPO_TOPOLOGY_BENCHMARK( BM_TopologyFindEdge, config, 100000 )         \
+    GTPO_TOPOLOGY_BENCHMARK( BM_TopologyContains, config, 100000 )         \
+    GTPO_TOPOLOGY_BENCHMARK( BM_TopologyGroupUngroupNode, config, 100000 )  \
+    GTPO_TOPOLOGY_BENCHMARK( BM_TopologyTraversal, config, 100000 )
+
+GTPO_TOPOLOGY_BENCHMARKS( gtpo::GraphConfig )
+#ifdef QT_CORE_LIB
+GTPO_TOPOLOGY_BENCHMARKS( QtGraphConfig )
+#endif
+
+//! Run benchmarks with JSON output to gtpoBenchmarks.json unless an explicit --benchmark_out is given.
+int main(int argc, char** argv) {
+    std::vector<char*> arguments{ argv, argv + argc };
+    bool hasOut = false;
+    for ( int a = 1; a < argc; ++a )
+        hasOut |= std::strncmp( argv[a], "--benchmark_out=", 16 ) == 0;
+    std::string out{ "--benchmark_out=gtpoBenchmarks.json" };
+    std::string outFormat{ "--benchmark_out_format=json" };
+    if ( !hasOut ) {
+        arguments.push_back( &out[0] );
+        arguments.push_back( &outFormat[0] );
+    }
+    int argumentCount = static_cast<int>( arguments.size() );
+    benchmark::Initialize( &argumentCount, arguments.data() );
+    if ( benchmark::ReportUnrecognizedArguments( argumentCount, arguments.data() ) )
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
@@ -0,0 +1,67 @@
+/*
+    This file is part of Quick Qanava library.
+
+    Copyright (C) 2008-2015 Benoit AUTHEMAN
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoComponentLayoutBenchmarks.cpp
+// \author	benoit@destrat.io
+// \date	2017 12 27
+//-----------------------------------------------------------------------------
+
+// STD headers
+#include <cstddef>
+#include <random>
+
+// GTpo headers
+#include <gtpoComponentLayout.h>
+
+// Google Benchmark
+#include <benchmark/benchmark.h>
+
+// Component layout target: thousands of small components laid out and packed in well under a second. Run with:
+//   $ ./gtpoBenchmarks --benchmark_filter=ComponentLayout
+
+//! Fill \c layout with \c componentCount random trees of 1 to 12 nodes.
+static void generateComponents( gtpo::ComponentLayout& layout, std::size_t componentCount )
+{
+    std::mt19937 generator{ 42 };
+    std::uniform_int_distribution<std::size_t> componentSize{ 1, 12 };
+    for ( std::size_t c = 0; c < componentCount; ++c ) {
+        const auto first = layout.getNodeCount();
+        const auto nodeCount = componentSize( generator );
+        for ( std::size_t n = 0; n < nodeCount; ++n ) {
+            const auto node = layout.addNode( 100., 50. );
+            if ( n > 0 )
+                layout.addEdge( first + std::uniform_int_distribution<std::size_t>{ 0, n - 1 }( generator ), node );
+        }
+    }
+}
+
+static void BM_ComponentLayout(benchmark::State& state) {
+    gtpo::ComponentLayout layout;
+    generateComponents( layout, static_cast< std::size_t >( state.range(0) ) );
+    layout.threadCount = static_cast< unsigned int >( state.range(1) );
+    layout.aspectRatio = 16. / 9.;
+    while ( state.KeepRunning() )
+        layout.compute();
+    state.SetItemsProcessed( static_cast< int64_t >( state.iterations() ) * state.range(0) );
+}
+
+BENCHMARK(BM_ComponentLayout)->Args({1000, 1})->Args({5000, 1})->Args({5000, 8})->Unit( benchmark::kMillisecond );
@@ -0,0 +1,70 @@
+/*
+    This file is part of Quick Qanava library.
+
+    Copyright (C) 2008-2015 Benoit AUTHEMAN
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoCompoundLayoutBenchmarks.cpp
+// \author	benoit@destrat.io
+// \date	2017 12 26
+//-----------------------------------------------------------------------------
+
+// STD headers
+#include <cstddef>
+#include <random>
+
+// GTpo headers
+#include <gtpoCompoundLayout.h>
+
+// Google Benchmark
+#include <benchmark/benchmark.h>
+
+// Compound layout target: groups content laid out concurrently, scaling with thread count. Run with:
+//   $ ./gtpoBenchmarks --benchmark_filter=CompoundLayout
+
+//! Fill \c layout with \c groupCount groups of 50 chained nodes, groups are chained by edges crossing their borders.
+static void generateGroups( gtpo::CompoundLayout& layout, std::size_t groupCount )
+{
+    constexpr std::size_t groupSize = 50;
+    std::mt19937 generator{ 42 };
+    std::uniform_int_distribution<std::size_t> groupNode{ 1, groupSize };
+    for ( std::size_t g = 0; g < groupCount; ++g ) {
+        const auto group = layout.addNode( 100., 100. );
+        for ( std::size_t n = 0; n < groupSize; ++n )
+            layout.addNode( 100., 50., group );
+        for ( std::size_t e = 0; e < groupSize + groupSize / 2; ++e ) {
+            const auto a = groupNode( generator ), b = groupNode( generator );
+            if ( a != b )
+                layout.addEdge( group + std::min( a, b ), group + std::max( a, b ) );
+        }
+        if ( g > 0 )
+            layout.addEdge( group - groupSize - 1 + groupNode( generator ), group + groupNode( generator ) );
+    }
+}
+
+static void BM_CompoundLayout(benchmark::State& state) {
+    gtpo::CompoundLayout layout;
+    generateGroups( layout, static_cast< std::size_t >( state.range(0) ) );
+    layout.threadCount = static_cast< unsigned int >( state.range(1) );
+    while ( state.KeepRunning() )
+        layout.compute();
+    state.SetItemsProcessed( static_cast< int64_t >( state.iterations() ) * static_cast< int64_t >( layout.getNodeCount() ) );
+}
+
+BENCHMARK(BM_CompoundLayout)->Args({20, 1})->Args({200, 1})->Args({200, 8})->Unit( benchmark::kMillisecond );
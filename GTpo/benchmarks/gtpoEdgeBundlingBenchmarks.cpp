@@ -0,0 +1,114 @@
+/*
+    This file is part of Quick Qanava library.
+
+    Copyright (C) 2008-2015 Benoit AUTHEMAN
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoEdgeBundlingBenchmarks.cpp
+// \author	benoit@destrat.io
+// \date	2017 12 30
+//-----------------------------------------------------------------------------
+
+// STD headers
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// GTpo headers
+#include <gtpoEdgeBundling.h>
+
+// Google Benchmark
+#include <benchmark/benchmark.h>
+
+// Bundling target: a node move bundled again in less than 16ms (one frame) on dense graphs. Run with:
+//   $ ./gtpoBenchmarks --benchmark_filter=EdgeBundling
+
+namespace { // ::anonymous
+
+struct Node {
+    double  x;
+    double  y;
+};
+
+//! Generate \c edgeCount edges between random nodes of 20 clusters, return nodes and fill \c edges with edges end nodes.
+auto    generateGraph( gtpo::EdgeBundling& bundling, std::uint32_t edgeCount,
+                       std::vector<std::pair<std::uint32_t, std::uint32_t>>& edges ) -> std::vector<Node>
+{
+    std::mt19937 generator{ 42 };
+    std::uniform_real_distribution<double> position{ 0., 4000. };
+    std::normal_distribution<double> spread{ 0., 150. };
+    std::vector<Node> clusters( 20 );
+    for ( auto& cluster : clusters )
+        cluster = Node{ position( generator ), position( generator ) };
+    std::vector<Node> nodes( edgeCount / 5 );
+    for ( std::size_t n = 0; n < nodes.size(); ++n ) {
+        const auto& cluster = clusters[ n % clusters.size() ];
+        nodes[ n ] = Node{ cluster.x + spread( generator ), cluster.y + spread( generator ) };
+    }
+    std::uniform_int_distribution<std::uint32_t> node{ 0, static_cast<std::uint32_t>( nodes.size() - 1 ) };
+    edges.clear();
+    while ( edges.size() < edgeCount ) {
+        const auto src = node( generator );
+        const auto dst = node( generator );
+        if ( src == dst )
+            continue;
+        bundling.addEdge( nodes[ src ].x, nodes[ src ].y, nodes[ dst ].x, nodes[ dst ].y );
+        edges.emplace_back( src, dst );
+    }
+    return nodes;
+}
+
+} // ::anonymous
+
+static void BM_EdgeBundlingFull(benchmark::State& state) {
+    const auto edgeCount = static_cast< std::uint32_t >( state.range(0) );
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> edges;
+    while ( state.KeepRunning() ) {
+        gtpo::EdgeBundling bundling;
+        generateGraph( bundling, edgeCount, edges );
+        benchmark::DoNotOptimize( bundling.bundle().size() );
+    }
+    state.SetItemsProcessed( static_cast< int64_t >( state.iterations() ) * edgeCount );
+}
+
+static void BM_EdgeBundlingMove(benchmark::State& state) {
+    const auto edgeCount = static_cast< std::uint32_t >( state.range(0) );
+    gtpo::EdgeBundling bundling;
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> edges;
+    auto nodes = generateGraph( bundling, edgeCount, edges );
+    bundling.bundle();
+    std::mt19937 generator{ 42 };
+    std::uniform_int_distribution<std::uint32_t> target{ 0, static_cast<std::uint32_t>( nodes.size() - 1 ) };
+    std::int64_t changed = 0;
+    while ( state.KeepRunning() ) {
+        // Move a random node and update its in and out edges
+        const auto moved = target( generator );
+        nodes[ moved ].x += 20.;
+        for ( std::uint32_t e = 0; e < edges.size(); ++e )
+            if ( edges[ e ].first == moved || edges[ e ].second == moved )
+                bundling.setEdge( e, nodes[ edges[ e ].first ].x, nodes[ edges[ e ].first ].y,
+                                     nodes[ edges[ e ].second ].x, nodes[ edges[ e ].second ].y );
+        changed += static_cast< std::int64_t >( bundling.bundle().size() );
+    }
+    state.counters[ "changed" ] = benchmark::Counter( static_cast< double >( changed ), benchmark::Counter::kAvgIterations );
+    state.SetItemsProcessed( static_cast< int64_t >( state.iterations() ) );
+}
+
+BENCHMARK(BM_EdgeBundlingFull)->Arg(1000)->Arg(5000)->Unit( benchmark::kMillisecond );
+BENCHMARK(BM_EdgeBundlingMove)->Arg(1000)->Arg(5000)->Unit( benchmark::kMillisecond );
@@ -0,0 +1,65 @@
+/*
+    This file is part of Quick Qanava library.
+
+    Copyright (C) 2008-2015 Benoit AUTHEMAN
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoForceLayoutBenchmarks.cpp
+// \author	benoit@destrat.io
+// \date	2017 12 22
+//-----------------------------------------------------------------------------
+
+// STD headers
+#include <cstddef>
+#include <random>
+
+// GTpo headers
+#include <gtpoForceLayout.h>
+
+// Google Benchmark
+#include <benchmark/benchmark.h>
+
+// Force layout target: one step on a 50k nodes graph under 100 ms on 8 cores (ie at least a few layout
+// updates per second). Run with:
+//   $ ./gtpoBenchmarks --benchmark_filter=ForceLayout
+
+//! Fill \c layout with a random graph of \c nodeCount nodes and 1.5 * \c nodeCount edges.
+static void generateLayout( gtpo::ForceLayout& layout, std::size_t nodeCount )
+{
+    std::mt19937 generator{ 42 };
+    std::uniform_real_distribution<double> position{ 0., 10000. };
+    std::uniform_int_distribution<std::size_t> node{ 0, nodeCount - 1 };
+    for ( std::size_t n = 0; n < nodeCount; ++n )
+        layout.addNode( position( generator ), position( generator ) );
+    for ( std::size_t e = 0; e < nodeCount + nodeCount / 2; ++e )
+        layout.addEdge( node( generator ), node( generator ) );
+}
+
+static void BM_ForceLayoutStep(benchmark::State& state) {
+    gtpo::ForceLayout layout;
+    generateLayout( layout, static_cast< std::size_t >( state.range(0) ) );
+    layout.threadCount = static_cast< unsigned int >( state.range(1) );
+    while ( state.KeepRunning() ) {
+        layout.setTemperature( 100. );      // Never converge
+        layout.step();
+    }
+    state.SetItemsProcessed( static_cast< int64_t >( state.iterations() ) * state.range(0) );
+}
+
+BENCHMARK(BM_ForceLayoutStep)->Args({10000, 1})->Args({50000, 1})->Args({50000, 8})->Unit( benchmark::kMillisecond );
@@ -0,0 +1,68 @@
+/*
+    This file is part of Quick Qanava library.
+
+    Copyright (C) 2008-2015 Benoit AUTHEMAN
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoIncrementalLayoutBenchmarks.cpp
+// \author	benoit@destrat.io
+// \date	2017 12 28
+//-----------------------------------------------------------------------------
+
+// STD headers
+#include <cstdint>
+#include <random>
+
+// GTpo headers
+#include <gtpoIncrementalLayout.h>
+
+// Google Benchmark
+#include <benchmark/benchmark.h>
+
+// Incremental layout target: an edit (node insertion or removal) relaid out in less than 16ms (one frame),
+// independently of the graph size. Run with:
+//   $ ./gtpoBenchmarks --benchmark_filter=IncrementalLayout
+
+static void BM_IncrementalLayoutEdit(benchmark::State& state) {
+    // Already placed side x side grid
+    const auto side = static_cast< std::uint32_t >( state.range(0) );
+    gtpo::IncrementalLayout layout;
+    for ( std::uint32_t r = 0; r < side; ++r )
+        for ( std::uint32_t c = 0; c < side; ++c ) {
+            const auto node = layout.addNode( 100., 50., c * 200., r * 150., false );
+            if ( c > 0 )
+                layout.addEdge( node - 1, node, false );
+            if ( r > 0 )
+                layout.addEdge( node - side, node, false );
+        }
+    std::mt19937 generator{ 42 };
+    std::uniform_int_distribution<std::uint32_t> target{ 0, side * side - 1 };
+    while ( state.KeepRunning() ) {
+        // Insert a node connected to two random grid nodes, then remove it
+        const auto node = layout.addNode( 100., 50. );
+        layout.addEdge( target( generator ), node );
+        layout.addEdge( target( generator ), node );
+        layout.relayout();
+        layout.removeNode( node );
+        layout.relayout();
+    }
+    state.SetItemsProcessed( static_cast< int64_t >( state.iterations() ) * 2 );
+}
+
+BENCHMARK(BM_IncrementalLayoutEdit)->Arg(100)->Arg(300)->Arg(700)->Unit( benchmark::kMillisecond );
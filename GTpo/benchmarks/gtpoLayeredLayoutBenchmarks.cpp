@@ -0,0 +1,69 @@
+/*
+    This file is part of Quick Qanava library.
+
+    Copyright (C) 2008-2015 Benoit AUTHEMAN
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoLayeredLayoutBenchmarks.cpp
+// \author	benoit@destrat.io
+// \date	2017 12 23
+//-----------------------------------------------------------------------------
+
+// STD headers
+#include <cstddef>
+#include <random>
+
+// GTpo headers
+#include <gtpoLayeredLayout.h>
+
+// Google Benchmark
+#include <benchmark/benchmark.h>
+
+// Layered layout target: a complete layout of a 10k nodes DAG in less than one second. Run with:
+//   $ ./gtpoBenchmarks --benchmark_filter=LayeredLayout
+
+//! Fill \c layout with a pipeline like DAG of \c nodeCount nodes in stages of 100 nodes, edges mostly connect consecutive stages.
+static void generateDag( gtpo::LayeredLayout& layout, std::size_t nodeCount )
+{
+    constexpr std::size_t stageSize = 100;
+    std::mt19937 generator{ 42 };
+    std::uniform_int_distribution<std::size_t> node{ 0, nodeCount - 1 };
+    std::uniform_int_distribution<std::size_t> stageNode{ 0, stageSize - 1 };
+    std::discrete_distribution<std::size_t> stageDistance{ 0., 80., 10., 5., 5. };
+    for ( std::size_t n = 0; n < nodeCount; ++n )
+        layout.addNode( 100., 50. );
+    for ( std::size_t e = 0; e < nodeCount + nodeCount / 2; ++e ) {
+        const auto src = node( generator );
+        const auto dstStage = src / stageSize + stageDistance( generator );
+        const auto dst = dstStage * stageSize + stageNode( generator );
+        if ( dst < nodeCount )
+            layout.addEdge( src, dst );
+    }
+}
+
+static void BM_LayeredLayout(benchmark::State& state) {
+    gtpo::LayeredLayout layout;
+    generateDag( layout, static_cast< std::size_t >( state.range(0) ) );
+    layout.threadCount = static_cast< unsigned int >( state.range(1) );
+    while ( state.KeepRunning() )
+        layout.compute();
+    state.SetItemsProcessed( static_cast< int64_t >( state.iterations() ) * state.range(0) );
+}
+
+BENCHMARK(BM_LayeredLayout)->Args({1000, 1})->Args({10000, 1})->Args({10000, 8})->Unit( benchmark::kMillisecond );
@@ -0,0 +1,95 @@
+/*
+    This file is part of Quick Qanava library.
+
+    Copyright (C) 2008-2015 Benoit AUTHEMAN
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoOrthogonalRouterBenchmarks.cpp
+// \author	benoit@destrat.io
+// \date	2017 12 29
+//-----------------------------------------------------------------------------
+
+// STD headers
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// GTpo headers
+#include <gtpoOrthogonalRouter.h>
+
+// Google Benchmark
+#include <benchmark/benchmark.h>
+
+// Routing target: a node move rerouted in less than 16ms (one frame), independently of the graph size. Run with:
+//   $ ./gtpoBenchmarks --benchmark_filter=OrthogonalRouter
+
+namespace { // ::anonymous
+
+//! Load a \c side x \c side grid of 100x50 obstacles with routes to right and bottom neighbours and to a random close node.
+auto    generateGrid( gtpo::OrthogonalRouter& router, std::uint32_t side ) -> void
+{
+    std::mt19937 generator{ 42 };
+    std::uniform_int_distribution<std::uint32_t> distance{ 0, 3 };
+    for ( std::uint32_t r = 0; r < side; ++r )
+        for ( std::uint32_t c = 0; c < side; ++c ) {
+            const auto obstacle = router.addObstacle( c * 200., r * 150., 100., 50. );
+            if ( c > 0 )
+                router.addRoute( obstacle - 1, obstacle );
+            if ( r > 0 )
+                router.addRoute( obstacle - side, obstacle );
+            const auto dr = distance( generator );
+            const auto dc = distance( generator );
+            if ( ( dr != 0 || dc != 0 ) && r >= dr && c >= dc )
+                router.addRoute( obstacle - dr * side - dc, obstacle );
+        }
+}
+
+} // ::anonymous
+
+static void BM_OrthogonalRouterFull(benchmark::State& state) {
+    const auto side = static_cast< std::uint32_t >( state.range(0) );
+    while ( state.KeepRunning() ) {
+        gtpo::OrthogonalRouter router;
+        generateGrid( router, side );
+        benchmark::DoNotOptimize( router.route().size() );
+    }
+    state.SetItemsProcessed( static_cast< int64_t >( state.iterations() ) * side * side );
+}
+
+static void BM_OrthogonalRouterMove(benchmark::State& state) {
+    const auto side = static_cast< std::uint32_t >( state.range(0) );
+    gtpo::OrthogonalRouter router;
+    generateGrid( router, side );
+    router.route();
+    std::mt19937 generator{ 42 };
+    std::uniform_int_distribution<std::uint32_t> target{ 0, side * side - 1 };
+    while ( state.KeepRunning() ) {
+        // Move a random obstacle to the middle of its right corridor, then move it back
+        const auto obstacle = target( generator );
+        const auto box = router.getObstacle( obstacle );
+        router.setObstacle( obstacle, box.left + 50., box.top + 75., 100., 50. );
+        router.route();
+        router.setObstacle( obstacle, box.left, box.top, 100., 50. );
+        router.route();
+    }
+    state.SetItemsProcessed( static_cast< int64_t >( state.iterations() ) * 2 );
+}
+
+BENCHMARK(BM_OrthogonalRouterFull)->Arg(10)->Arg(30)->Unit( benchmark::kMillisecond );
+BENCHMARK(BM_OrthogonalRouterMove)->Arg(30)->Arg(100)->Unit( benchmark::kMillisecond );
@@ -0,0 +1,118 @@
+/*
+    This file is part of Quick Qanava library.
+
+    Copyright (C) 2008-2015 Benoit AUTHEMAN
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software.
+//
+// \file	gtpoSerializerBenchmarks.cpp
+// \author	benoit@destrat.io
+// \date	2017 12 04
+//-----------------------------------------------------------------------------
+
+// STD headers
+#include <string>
+#include <sstream>
+#include <memory>         // std::make_unique
+#include <vector>
+
+// GTpo headers
+#include <GTpo>
+#include <gtpoGmlSerializer.h>
+#include <gtpoGexfSerializer.h>
+
+// Google Benchmark
+#include <benchmark/benchmark.h>
+
+// Streaming serializers throughput target (single core, release build, in memory input):
+//   - XmlStreamReader tokenization:    >= 200 MB/s
+//   - GraphML/GEXF import/export:      >= 30 MB/s (bounded by GenGraph node/edge insertion)
+// Benchmarks report throughput with SetBytesProcessed(), run with:
+//   $ ./gtpoBenchmarks --benchmark_filter=Serializer
+
+//! Generate a graph with \c nodeCount nodes and 3 times more edges.
+static void generateGraph( gtpo::GenGraph<>& g, std::size_t nodeCount )
+{
+    std::vector< gtpo::GenGraph<>::WeakNode > nodes;
+    nodes.reserve( nodeCount );
+    for ( std::size_t n = 0; n < nodeCount; ++n )
+        nodes.push_back( g.createNode() );
+    for ( std::size_t e = 0; e < 3 * nodeCount; ++e )
+        g.createEdge( nodes[( e * 7919 ) % nodeCount], nodes[( e * 104729 + 1 ) % nodeCount] );
+}
+
+template < class OutSerializer >
+static std::string  generateDocument( std::size_t nodeCount )
+{
+    gtpo::GenGraph<> g;
+    generateGraph( g, nodeCount );
+    std::ostringstream output;
+    OutSerializer out{ output };
+    out.serializeOut( g );
+    out.finishOut();
+    return output.str();
+}
+
+static void BM_SerializerXmlStreamReader(benchmark::State& state) {
+    const auto document = generateDocument< gtpo::OutGmlSerializer<> >( static_cast< std::size_t >( state.range(0) ) );
+    while ( state.KeepRunning() ) {
+        std::istringstream input{ document };
+        gtpo::XmlStreamReader xml{ input };
+        while ( xml.readNext() != gtpo::XmlStreamReader::Token::EndDocument )
+            ;
+    }
+    state.SetBytesProcessed( static_cast< int64_t >( state.iterations() ) * static_cast< int64_t >( document.size() ) );
+}
+
+template < class InSerializer, class OutSerializer >
+static void BM_SerializerIn(benchmark::State& state) {
+    const auto document = generateDocument< OutSerializer >( static_cast< std::size_t >( state.range(0) ) );
+    while ( state.KeepRunning() ) {
+        state.PauseTiming();
+        std::istringstream input{ document };
+        auto g = std::make_unique< gtpo::GenGraph<> >();
+        state.ResumeTiming();
+        InSerializer in{ input };
+        in.serializeIn( *g );
+        state.PauseTiming();
+        g.reset();                      // Do not measure graph destruction
+        state.ResumeTiming();
+    }
+    state.SetBytesProcessed( static_cast< int64_t >( state.iterations() ) * static_cast< int64_t >( document.size() ) );
+}
+
+template < class OutSerializer >
+static void BM_SerializerOut(benchmark::State& state) {
+    gtpo::GenGraph<> g;
+    generateGraph( g, static_cast< std::size_t >( state.range(0) ) );
+    std::size_t bytes = 0;
+    while ( state.KeepRunning() ) {
+        std::ostringstream output;
+        OutSerializer out{ output };
+        out.serializeOut( g );
+        out.finishOut();
+        bytes = out.getBytesWritten();
+    }
+    state.SetBytesProcessed( static_cast< int64_t >( state.iterations() ) * static_cast< int64_t >( bytes ) );
+}
+
+BENCHMARK(BM_SerializerXmlStreamReader)->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(BM_SerializerIn, gtpo::InGmlSerializer<>, gtpo::OutGmlSerializer<>)->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(BM_SerializerIn, gtpo::InGexfSerializer<>, gtpo::OutGexfSerializer<>)->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(BM_SerializerOut, gtpo::OutGmlSerializer<>)->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(BM_SerializerOut, gtpo::OutGexfSerializer<>)->Range(1 << 10, 1 << 18);
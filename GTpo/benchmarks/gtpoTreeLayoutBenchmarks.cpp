@@ -0,0 +1,78 @@
+/*
+    This file is part of Quick Qanava library.
+
+    Copyright (C) 2008-2015 Benoit AUTHEMAN
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoTreeLayoutBenchmarks.cpp
+// \author	benoit@destrat.io
+// \date	2017 12 24
+//-----------------------------------------------------------------------------
+
+// STD headers
+#include <cstddef>
+#include <random>
+
+// GTpo headers
+#include <gtpoTreeLayout.h>
+
+// Google Benchmark
+#include <benchmark/benchmark.h>
+
+// Tree layout target: linear complete layout time, expanding or collapsing a subtree well under a frame time. Run with:
+//   $ ./gtpoBenchmarks --benchmark_filter=TreeLayout
+
+//! Fill \c layout with a random tree of \c nodeCount nodes, every node having up to 8 children.
+static void generateTree( gtpo::TreeLayout& layout, std::size_t nodeCount )
+{
+    std::mt19937 generator{ 42 };
+    for ( std::size_t n = 0; n < nodeCount; ++n )
+        layout.addNode( 100., 50. );
+    for ( std::size_t n = 1; n < nodeCount; ++n ) {
+        std::uniform_int_distribution<std::size_t> parent{ ( n - 1 ) / 8 > 16 ? ( n - 1 ) / 8 - 16 : 0, ( n - 1 ) / 4 };
+        layout.addEdge( parent( generator ), n );
+    }
+}
+
+static void BM_TreeLayout(benchmark::State& state) {
+    gtpo::TreeLayout layout;
+    generateTree( layout, static_cast< std::size_t >( state.range(0) ) );
+    layout.radial = state.range(1) != 0;
+    while ( state.KeepRunning() )
+        layout.compute();
+    state.SetItemsProcessed( static_cast< int64_t >( state.iterations() ) * state.range(0) );
+}
+
+BENCHMARK(BM_TreeLayout)->Args({10000, 0})->Args({100000, 0})->Args({100000, 1})->Unit( benchmark::kMillisecond );
+
+static void BM_TreeLayoutCollapse(benchmark::State& state) {
+    gtpo::TreeLayout layout;
+    const auto nodeCount = static_cast< std::size_t >( state.range(0) );
+    generateTree( layout, nodeCount );
+    layout.compute();
+    std::mt19937 generator{ 42 };
+    std::uniform_int_distribution<std::size_t> node{ nodeCount / 2, nodeCount - 1 };
+    while ( state.KeepRunning() ) {
+        const auto n = node( generator );
+        layout.collapsed[n] = layout.collapsed[n] ? 0 : 1;
+        layout.update( n );
+    }
+}
+
+BENCHMARK(BM_TreeLayoutCollapse)->Arg(10000)->Arg(100000)->Unit( benchmark::kMillisecond );
@@ -25,6 +25,39 @@ HEADERS +=  $$PWD/gtpoUtils.h               \
             $$PWD/gtpoAdjacentBehaviour.h   \
             $$PWD/gtpoAdjacentBehaviour.hpp \
             $$PWD/gtpoContainerAdapter.h    \
+            $$PWD/gtpoProgressNotifier.h    \
+            $$PWD/gtpoXmlStream.h           \
+            $$PWD/gtpoXmlStream.hpp         \
+            $$PWD/gtpoXmlSerializer.h       \
+            $$PWD/gtpoXmlSerializer.hpp     \
+            $$PWD/gtpoGmlSerializer.h       \
+            $$PWD/gtpoGmlSerializer.hpp     \
+            $$PWD/gtpoGexfSerializer.h      \
+            $$PWD/gtpoGexfSerializer.hpp    \
+            $$PWD/gtpoPagedFile.h           \
+            $$PWD/gtpoPagedFile.hpp         \
+            $$PWD/gtpoOutOfCoreGraph.h      \
+            $$PWD/gtpoOutOfCoreGraph.hpp    \
+            $$PWD/gtpoSpatialIndex.h        \
+            $$PWD/gtpoSpatialIndex.hpp      \
+            $$PWD/gtpoEdgeGeometry.h        \
+            $$PWD/gtpoEdgeGeometry.hpp      \
+            $$PWD/gtpoForceLayout.h         \
+            $$PWD/gtpoForceLayout.hpp       \
+            $$PWD/gtpoLayeredLayout.h       \
+            $$PWD/gtpoLayeredLayout.hpp     \
+            $$PWD/gtpoTreeLayout.h          \
+            $$PWD/gtpoTreeLayout.hpp        \
+            $$PWD/gtpoCompoundLayout.h      \
+            $$PWD/gtpoCompoundLayout.hpp    \
+            $$PWD/gtpoComponentLayout.h     \
+            $$PWD/gtpoComponentLayout.hpp   \
+            $$PWD/gtpoIncrementalLayout.h   \
+            $$PWD/gtpoIncrementalLayout.hpp \
+            $$PWD/gtpoOrthogonalRouter.h    \
+            $$PWD/gtpoOrthogonalRouter.hpp  \
+            $$PWD/gtpoEdgeBundling.h        \
+            $$PWD/gtpoEdgeBundling.hpp      \
             $$PWD/GTpo.h
 
 OTHER_FILES += $$PWD/GTpo
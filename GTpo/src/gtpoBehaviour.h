@@ -37,6 +37,7 @@
 
 // STD headers
 #include <cstddef>          // std::size_t
+#include <algorithm>        // std::find_if
 #include <functional>       // std::function
 #include <vector>
 #include <memory>
@@ -162,6 +163,20 @@ public:
         _behaviours.emplace_back( std::move( behaviour ) );
     }
 
+    /*! \brief Remove and destroy \c behaviour, return false if \c behaviour is not registered.
+     *
+     * \warning Must not be called from a behaviour notification.
+     */
+    inline auto     removeBehaviour( const Behaviour* behaviour ) -> bool {
+        const auto found = std::find_if( _behaviours.begin(), _behaviours.end(),
+                                         [behaviour]( const std::unique_ptr<Behaviour>& b ) { return b.get() == behaviour; } );
+        if ( behaviour == nullptr ||
+             found == _behaviours.end() )
+            return false;
+        _behaviours.erase( found );
+        return true;
+    }
+
     //! std::vector of std::unique_ptr pointers on Behaviour.
     using Behaviours = std::vector< std::unique_ptr< Behaviour > >;
 
@@ -0,0 +1,163 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoComponentLayout.h
+// \author	benoit@destrat.io
+// \date	2017 12 27
+//-----------------------------------------------------------------------------
+
+#ifndef gtpoComponentLayout_h
+#define gtpoComponentLayout_h
+
+// STD headers
+#include <cstddef>          // std::size_t
+#include <cstdint>          // std::uint32_t
+#include <vector>
+
+// GTpo headers
+#include "./gtpoUtils.h"
+#include "./gtpoLayeredLayout.h"
+
+namespace gtpo { // ::gtpo
+
+/*! \brief Connected components layout and packing.
+ *
+ * Connected components of the graph are laid out independently (concurrently) with a gtpo::LayeredLayout, or keep
+ * their nodes actual relative positions when \c layoutComponents is false. Components bounding boxes are then
+ * packed with a bottom left skyline packer, largest components first: several skyline widths around the ideal
+ * width are tried and the packing that best fit a view of \c aspectRatio (ie the packing that would be displayed
+ * with the largest zoom after a fit in view) is kept.
+ *
+ * \code
+ *   gtpo::ComponentLayout layout;
+ *   const auto a = layout.addNode( 100., 50. );
+ *   const auto b = layout.addNode( 100., 50. );
+ *   layout.addNode( 100., 50. );      // Isolated node, another component
+ *   layout.addEdge( a, b );
+ *   layout.aspectRatio = 16. / 9.;
+ *   layout.compute();                 // Node centers are in layout.x and layout.y
+ * \endcode
+ * \nosubgrouping
+ */
+class ComponentLayout
+{
+    /*! \name ComponentLayout Object Management *///---------------------------
+    //@{
+public:
+    ComponentLayout() noexcept = default;
+    ~ComponentLayout() = default;
+    ComponentLayout( const ComponentLayout& ) = delete;
+    ComponentLayout& operator=( const ComponentLayout& ) = delete;
+
+    //! Remove all nodes and edges, allocated memory is kept for the next layout.
+    auto            clear() noexcept -> void;
+    inline auto     getNodeCount() const noexcept -> std::size_t { return width.size(); }
+    inline auto     getEdgeCount() const noexcept -> std::size_t { return edgeSrc.size(); }
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Layout Topology *///---------------------------------------------
+    //@{
+public:
+    //! Add a node of size (\c width, \c height) centered on (\c x, \c y) and return its index.
+    auto            addNode( double width, double height, double x = 0., double y = 0. ) -> std::size_t;
+    /*! \brief Add an edge between \c src and \c dst and return its index.
+     *
+     * \throw gtpo::bad_topology_error if \c src or \c dst is not a valid node index.
+     */
+    auto            addEdge( std::size_t src, std::size_t dst ) noexcept( false ) -> std::size_t;
+
+public:
+    std::vector<double>         width, height;
+
+    std::vector<std::uint32_t>  edgeSrc, edgeDst;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Layout Configuration *///----------------------------------------
+    //@{
+public:
+    //! Lay out components with a layered layout when true, keep nodes relative positions otherwise (default to true).
+    bool            layoutComponents{ true };
+    //! Components layered layout orientation (default to true).
+    bool            horizontal{ true };
+    //! Components layered layout minimum space between two consecutive layers (default to 80.).
+    double          layerSpacing{ 80. };
+    //! Components layered layout minimum space between two nodes in the same layer (default to 30.).
+    double          nodeSpacing{ 30. };
+    //! Minimum space between two components bounding boxes (default to 40.).
+    double          componentSpacing{ 40. };
+    //! Target packing width / height ratio, usually view aspect ratio (default to 1.).
+    double          aspectRatio{ 1. };
+    //! Number of components laid out concurrently, 0 to use all available hardware threads (default to 0).
+    unsigned int    threadCount{ 0 };
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Layout Computation *///------------------------------------------
+    //@{
+public:
+    //! Compute layout, results are available in output arrays.
+    auto            compute() -> void;
+
+    /*! \brief Pack rectangles of size (\c widths, \c heights) in a skyline of width \c binWidth.
+     *
+     * Rectangles are placed in \c order, every rectangle at the lowest position (then leftmost) where it fits.
+     * \return Packing height, rectangles top left corners are set in \c left and \c top.
+     */
+    static auto     packSkyline( const std::vector<double>& widths, const std::vector<double>& heights,
+                                 const std::vector<std::uint32_t>& order, double binWidth,
+                                 std::vector<double>& left, std::vector<double>& top ) -> double;
+
+public:
+    //! Nodes center positions, used as input positions when layoutComponents is false.
+    std::vector<double>         x, y;
+    //! Node component index, components are indexed in increasing order of their smallest node index.
+    std::vector<std::uint32_t>  component;
+    std::size_t                 componentCount{ 0 };
+
+private:
+    //! Lay out \c c component nodes, relative to component bounding box top left corner.
+    auto            layoutComponent( std::size_t c, gtpo::LayeredLayout& layered, std::vector<std::uint32_t>& local ) -> void;
+
+private:
+    //! Components nodes and edges in CSR format.
+    std::vector<std::uint32_t>  _nodeBegin, _nodes, _edgeBegin, _edges;
+    //! Components bounding box sizes.
+    std::vector<double>         _componentWidth, _componentHeight;
+    //@}
+    //-------------------------------------------------------------------------
+};
+
+} // ::gtpo
+
+#include "./gtpoComponentLayout.hpp"
+
+#endif // gtpoComponentLayout_h
+
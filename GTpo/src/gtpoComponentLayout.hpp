@@ -0,0 +1,284 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoComponentLayout.hpp
+// \author	benoit@destrat.io
+// \date	2017 12 27
+//-----------------------------------------------------------------------------
+
+// STD headers
+#include <algorithm>    // std::sort std::max
+#include <cmath>        // std::sqrt
+#include <limits>
+#include <numeric>      // std::iota
+
+namespace gtpo { // ::gtpo
+
+/* ComponentLayout Object Management *///--------------------------------------
+inline auto ComponentLayout::clear() noexcept -> void
+{
+    width.clear();      height.clear();
+    x.clear();          y.clear();
+    edgeSrc.clear();    edgeDst.clear();
+}
+//-----------------------------------------------------------------------------
+
+/* Layout Topology *///--------------------------------------------------------
+inline auto ComponentLayout::addNode( double nodeWidth, double nodeHeight, double nodeX, double nodeY ) -> std::size_t
+{
+    width.push_back( nodeWidth );
+    height.push_back( nodeHeight );
+    x.push_back( nodeX );
+    y.push_back( nodeY );
+    return width.size() - 1;
+}
+
+inline auto ComponentLayout::addEdge( std::size_t src, std::size_t dst ) noexcept( false ) -> std::size_t
+{
+    gtpo::assert_throw( src < getNodeCount() && dst < getNodeCount(),
+                        "gtpo::ComponentLayout::addEdge(): Error: invalid source or destination node index." );
+    edgeSrc.push_back( static_cast<std::uint32_t>( src ) );
+    edgeDst.push_back( static_cast<std::uint32_t>( dst ) );
+    return edgeSrc.size() - 1;
+}
+//-----------------------------------------------------------------------------
+
+/* Layout Computation *///-----------------------------------------------------
+inline auto ComponentLayout::compute() -> void
+{
+    const auto nodeCount = getNodeCount();
+    x.resize( nodeCount, 0. );
+    y.resize( nodeCount, 0. );
+    component.assign( nodeCount, 0 );
+    componentCount = 0;
+    if ( nodeCount == 0 )
+        return;
+
+    // Connected components with an union find (path halving, union by index)
+    std::vector<std::uint32_t> root( nodeCount );
+    std::iota( root.begin(), root.end(), 0 );
+    const auto find = [&root]( std::uint32_t n ) {
+        while ( root[n] != n ) {
+            root[n] = root[root[n]];
+            n = root[n];
+        }
+        return n;
+    };
+    for ( std::size_t e = 0; e < edgeSrc.size(); ++e ) {
+        const auto a = find( edgeSrc[e] ), b = find( edgeDst[e] );
+        if ( a != b )
+            root[std::max( a, b )] = std::min( a, b );
+    }
+    for ( std::size_t n = 0; n < nodeCount; ++n ) {
+        const auto r = find( static_cast<std::uint32_t>( n ) );
+        component[n] = r == n ? static_cast<std::uint32_t>( componentCount++ ) : component[r];
+    }
+
+    // Components nodes and edges
+    _nodeBegin.assign( componentCount + 1, 0 );
+    for ( std::size_t n = 0; n < nodeCount; ++n )
+        ++_nodeBegin[component[n] + 1];
+    _edgeBegin.assign( componentCount + 1, 0 );
+    for ( std::size_t e = 0; e < edgeSrc.size(); ++e )
+        ++_edgeBegin[component[edgeSrc[e]] + 1];
+    for ( std::size_t c = 0; c < componentCount; ++c ) {
+        _nodeBegin[c + 1] += _nodeBegin[c];
+        _edgeBegin[c + 1] += _edgeBegin[c];
+    }
+    _nodes.resize( nodeCount );
+    _edges.resize( edgeSrc.size() );
+    {
+        std::vector<std::uint32_t> fill( _nodeBegin.begin(), _nodeBegin.end() - 1 );
+        for ( std::size_t n = 0; n < nodeCount; ++n )
+            _nodes[fill[component[n]]++] = static_cast<std::uint32_t>( n );
+        fill.assign( _edgeBegin.begin(), _edgeBegin.end() - 1 );
+        for ( std::size_t e = 0; e < edgeSrc.size(); ++e )
+            _edges[fill[component[edgeSrc[e]]]++] = static_cast<std::uint32_t>( e );
+    }
+
+    // Lay out components concurrently
+    _componentWidth.assign( componentCount, 0. );
+    _componentHeight.assign( componentCount, 0. );
+    {
+        const auto threads = static_cast<unsigned int>( std::min<std::size_t>( componentCount,
+                                                                               gtpo::resolveThreadCount( threadCount ) ) );
+        std::vector<gtpo::LayeredLayout> layered( threads );
+        std::vector<std::vector<std::uint32_t>> local( threads, std::vector<std::uint32_t>( nodeCount ) );
+        gtpo::parallelFor( componentCount, threads, [this, &layered, &local]( std::size_t c, unsigned int thread ) {
+            layoutComponent( c, layered[thread], local[thread] );
+        } );
+    }
+
+    // Pack components, largest first, trying skyline widths around the ideal width for aspectRatio
+    std::vector<double> packWidth( componentCount ), packHeight( componentCount );
+    double area = 0., maxWidth = 0.;
+    for ( std::size_t c = 0; c < componentCount; ++c ) {
+        packWidth[c] = _componentWidth[c] + componentSpacing;
+        packHeight[c] = _componentHeight[c] + componentSpacing;
+        area += packWidth[c] * packHeight[c];
+        maxWidth = std::max( maxWidth, packWidth[c] );
+    }
+    std::vector<std::uint32_t> order( componentCount );
+    std::iota( order.begin(), order.end(), 0 );
+    std::sort( order.begin(), order.end(), [&]( std::uint32_t a, std::uint32_t b ) {
+        return packHeight[a] != packHeight[b] ? packHeight[a] > packHeight[b] :
+               packWidth[a] != packWidth[b] ? packWidth[a] > packWidth[b] : a < b;
+    } );
+    const double ratio = aspectRatio > 0. ? aspectRatio : 1.;
+    const double idealWidth = std::sqrt( area * ratio );
+    std::vector<double> left, top, bestLeft, bestTop;
+    double bestScale = std::numeric_limits<double>::max();
+    for ( const double factor : { 0.7, 0.8, 0.9, 1., 1.1, 1.25, 1.4, 1.6 } ) {
+        const double packingHeight = packSkyline( packWidth, packHeight, order, std::max( maxWidth, idealWidth * factor ), left, top );
+        double packingWidth = 0.;
+        for ( std::size_t c = 0; c < componentCount; ++c )
+            packingWidth = std::max( packingWidth, left[c] + packWidth[c] );
+        // Packing is displayed in a view of aspectRatio with a zoom inversely proportional to this scale
+        const double scale = std::max( packingWidth / ratio, packingHeight );
+        if ( scale < bestScale ) {
+            bestScale = scale;
+            bestLeft.swap( left );
+            bestTop.swap( top );
+        }
+    }
+    for ( std::size_t n = 0; n < nodeCount; ++n ) {
+        x[n] += bestLeft[component[n]];
+        y[n] += bestTop[component[n]];
+    }
+}
+
+inline auto ComponentLayout::layoutComponent( std::size_t c, gtpo::LayeredLayout& layered,
+                                              std::vector<std::uint32_t>& local ) -> void
+{
+    const auto nodesBegin = _nodes.cbegin() + _nodeBegin[c];
+    const auto nodesEnd = _nodes.cbegin() + _nodeBegin[c + 1];
+    if ( layoutComponents &&
+         nodesEnd - nodesBegin > 1 ) {
+        layered.clear();
+        for ( auto n = nodesBegin; n != nodesEnd; ++n )
+            local[*n] = static_cast<std::uint32_t>( layered.addNode( width[*n], height[*n] ) );
+        for ( auto e = _edgeBegin[c]; e < _edgeBegin[c + 1]; ++e )
+            layered.addEdge( local[edgeSrc[_edges[e]]], local[edgeDst[_edges[e]]] );
+        layered.horizontal = horizontal;
+        layered.layerSpacing = layerSpacing;
+        layered.nodeSpacing = nodeSpacing;
+        layered.threadCount = 1;
+        layered.compute();
+        for ( auto n = nodesBegin; n != nodesEnd; ++n ) {
+            x[*n] = layered.x[local[*n]];
+            y[*n] = layered.y[local[*n]];
+        }
+    }
+
+    // Move component bounding box top left corner to origin
+    double left = std::numeric_limits<double>::max(), top = std::numeric_limits<double>::max();
+    double right = std::numeric_limits<double>::lowest(), bottom = std::numeric_limits<double>::lowest();
+    for ( auto n = nodesBegin; n != nodesEnd; ++n ) {
+        left = std::min( left, x[*n] - width[*n] / 2. );
+        top = std::min( top, y[*n] - height[*n] / 2. );
+        right = std::max( right, x[*n] + width[*n] / 2. );
+        bottom = std::max( bottom, y[*n] + height[*n] / 2. );
+    }
+    for ( auto n = nodesBegin; n != nodesEnd; ++n ) {
+        x[*n] -= left;
+        y[*n] -= top;
+    }
+    _componentWidth[c] = right - left;
+    _componentHeight[c] = bottom - top;
+}
+
+inline auto ComponentLayout::packSkyline( const std::vector<double>& widths, const std::vector<double>& heights,
+                                          const std::vector<std::uint32_t>& order, double binWidth,
+                                          std::vector<double>& left, std::vector<double>& top ) -> double
+{
+    left.assign( widths.size(), 0. );
+    top.assign( widths.size(), 0. );
+
+    // Skyline segments ordered by x, covering [0, binWidth)
+    struct Segment {
+        double  x, y, width;
+    };
+    std::vector<Segment> skyline{ Segment{ 0., 0., binWidth } };
+    constexpr double epsilon = 1e-9;
+    double packingHeight = 0.;
+    for ( const auto r : order ) {
+        const double w = widths[r], h = heights[r];
+
+        // Lowest position, then leftmost, where rectangle fits under bin width (wider rectangles go on left)
+        std::size_t best = 0, bestEnd = 0;
+        double bestY = std::numeric_limits<double>::max();
+        for ( std::size_t s = 0; s < skyline.size(); ++s ) {
+            if ( s > 0 &&
+                 skyline[s].x + w > binWidth + epsilon )
+                break;
+            double segmentY = 0., covered = 0.;
+            auto end = s;
+            while ( end < skyline.size() &&
+                    covered < w - epsilon ) {
+                segmentY = std::max( segmentY, skyline[end].y );
+                covered += skyline[end].width;
+                ++end;
+            }
+            if ( segmentY < bestY ) {
+                bestY = segmentY;
+                best = s;
+                bestEnd = end;
+            }
+        }
+        const double rx = skyline[best].x;
+        left[r] = rx;
+        top[r] = bestY;
+        packingHeight = std::max( packingHeight, bestY + h );
+
+        // Replace covered segments with rectangle top, keep uncovered part of the last covered segment
+        const auto& last = skyline[bestEnd - 1];
+        const double lastEnd = last.x + last.width;
+        const double lastY = last.y;
+        skyline.erase( skyline.begin() + static_cast<std::ptrdiff_t>( best ),
+                       skyline.begin() + static_cast<std::ptrdiff_t>( bestEnd ) );
+        auto inserted = skyline.insert( skyline.begin() + static_cast<std::ptrdiff_t>( best ), Segment{ rx, bestY + h, w } );
+        if ( lastEnd > rx + w + epsilon )
+            skyline.insert( inserted + 1, Segment{ rx + w, lastY, lastEnd - rx - w } );
+
+        // Merge consecutive segments with the same height
+        std::size_t merged = 0;
+        for ( std::size_t s = 1; s < skyline.size(); ++s ) {
+            if ( std::abs( skyline[s].y - skyline[merged].y ) < epsilon )
+                skyline[merged].width += skyline[s].width;
+            else
+                skyline[++merged] = skyline[s];
+        }
+        skyline.resize( merged + 1 );
+    }
+    return packingHeight;
+}
+//-----------------------------------------------------------------------------
+
+} // ::gtpo
+
@@ -0,0 +1,170 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoCompoundLayout.h
+// \author	benoit@destrat.io
+// \date	2017 12 26
+//-----------------------------------------------------------------------------
+
+#ifndef gtpoCompoundLayout_h
+#define gtpoCompoundLayout_h
+
+// STD headers
+#include <cstddef>          // std::size_t
+#include <cstdint>          // std::uint32_t
+#include <limits>
+#include <utility>          // std::pair
+#include <vector>
+
+// GTpo headers
+#include "./gtpoUtils.h"
+#include "./gtpoLayeredLayout.h"
+
+namespace gtpo { // ::gtpo
+
+/*! \brief Layout of compound graphs: nodes could be grouped in (possibly nested) groups laid out as a single node.
+ *
+ * Layout works bottom up on a structure of arrays snapshot of a graph: a group node is any node referenced as the
+ * \c group of another node. Content of every group is laid out independently in group local coordinates, the group
+ * is then sized to fit its content (plus \c groupPadding) and laid out as a regular node in its parent group (or at
+ * top level). Groups of the same nesting depth are laid out concurrently.
+ *
+ * Edges crossing group borders are lifted to the innermost group containing both extremities, where they link
+ * the outermost groups containing source and destination: an edge from a node inside a group to an ungrouped
+ * node pulls the whole group toward that node at top level.
+ *
+ * In every group, connected nodes are laid out with a gtpo::LayeredLayout, nodes without edges in this group are
+ * then arranged in rows under the layered nodes.
+ *
+ * \code
+ *   gtpo::CompoundLayout layout;
+ *   const auto group = layout.addNode( 200., 100. );
+ *   const auto a = layout.addNode( 100., 50., group );
+ *   const auto b = layout.addNode( 100., 50. );
+ *   layout.addEdge( b, a );
+ *   layout.compute();     // a center is in group local coordinates, group is sized in layoutWidth/layoutHeight
+ * \endcode
+ * \nosubgrouping
+ */
+class CompoundLayout
+{
+    /*! \name CompoundLayout Object Management *///----------------------------
+    //@{
+public:
+    CompoundLayout() noexcept = default;
+    ~CompoundLayout() = default;
+    CompoundLayout( const CompoundLayout& ) = delete;
+    CompoundLayout& operator=( const CompoundLayout& ) = delete;
+
+    //! Remove all nodes and edges, allocated memory is kept for the next layout.
+    auto            clear() noexcept -> void;
+    inline auto     getNodeCount() const noexcept -> std::size_t { return width.size(); }
+    inline auto     getEdgeCount() const noexcept -> std::size_t { return edgeSrc.size(); }
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Layout Topology *///---------------------------------------------
+    //@{
+public:
+    enum : std::uint32_t { NoGroup = std::numeric_limits<std::uint32_t>::max() };
+
+    /*! \brief Add a node of size (\c width, \c height) in group node \c group and return its index.
+     *
+     * Groups must be added before their content, an empty group is laid out with its own size.
+     * \throw gtpo::bad_topology_error if \c group is neither NoGroup nor an existing node index.
+     */
+    auto            addNode( double width, double height, std::size_t group = NoGroup ) noexcept( false ) -> std::size_t;
+    /*! \brief Add an edge from \c src to \c dst and return its index.
+     *
+     * Self loops and edges between a group and its own content are ignored.
+     * \throw gtpo::bad_topology_error if \c src or \c dst is not a valid node index.
+     */
+    auto            addEdge( std::size_t src, std::size_t dst ) noexcept( false ) -> std::size_t;
+
+public:
+    std::vector<double>         width, height;
+    //! Node group index (NoGroup for top level nodes).
+    std::vector<std::uint32_t>  group;
+
+    std::vector<std::uint32_t>  edgeSrc, edgeDst;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Layout Configuration *///----------------------------------------
+    //@{
+public:
+    //! Layers are ordered from left to right when true, from top to bottom otherwise (default to true).
+    bool            horizontal{ true };
+    //! Minimum space between two consecutive layers (default to 80.).
+    double          layerSpacing{ 80. };
+    //! Minimum space between two nodes in the same layer (default to 30.).
+    double          nodeSpacing{ 30. };
+    //! Space between group borders and group content (default to 20.).
+    double          groupPadding{ 20. };
+    //! Number of groups laid out concurrently, 0 to use all available hardware threads (default to 0).
+    unsigned int    threadCount{ 0 };
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Layout Computation *///------------------------------------------
+    //@{
+public:
+    //! Compute layout, results are available in output arrays.
+    auto            compute() -> void;
+
+public:
+    //! Nodes center positions, relative to their group top left corner for grouped nodes.
+    std::vector<double>         x, y;
+    //! Nodes size after layout, non empty groups are sized to fit their content.
+    std::vector<double>         layoutWidth, layoutHeight;
+
+private:
+    //! Per thread layout context, \c local map graph nodes to layered layout nodes.
+    struct Worker {
+        gtpo::LayeredLayout         layered;
+        std::vector<std::uint32_t>  local;
+    };
+    //! Lay out content of group \c container (or top level content when \c container is NoGroup).
+    auto            layoutContainer( std::uint32_t container, Worker& worker ) -> void;
+
+private:
+    //! Containers content in CSR format, top level content is stored last.
+    std::vector<std::uint32_t>  _contentBegin, _content;
+    //! Edges lifted to their innermost common container, as (src, dst) pairs of container content nodes.
+    std::vector<std::vector<std::pair<std::uint32_t, std::uint32_t>>>   _containerEdges;
+    //@}
+    //-------------------------------------------------------------------------
+};
+
+} // ::gtpo
+
+#include "./gtpoCompoundLayout.hpp"
+
+#endif // gtpoCompoundLayout_h
+
@@ -0,0 +1,230 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoCompoundLayout.hpp
+// \author	benoit@destrat.io
+// \date	2017 12 26
+//-----------------------------------------------------------------------------
+
+// STD headers
+#include <algorithm>    // std::sort std::unique std::max
+#include <cmath>        // std::sqrt
+
+namespace gtpo { // ::gtpo
+
+/* CompoundLayout Object Management *///---------------------------------------
+inline auto CompoundLayout::clear() noexcept -> void
+{
+    width.clear();      height.clear();
+    group.clear();
+    edgeSrc.clear();    edgeDst.clear();
+}
+//-----------------------------------------------------------------------------
+
+/* Layout Topology *///--------------------------------------------------------
+inline auto CompoundLayout::addNode( double nodeWidth, double nodeHeight, std::size_t nodeGroup ) noexcept( false ) -> std::size_t
+{
+    gtpo::assert_throw( nodeGroup == NoGroup || nodeGroup < getNodeCount(),
+                        "gtpo::CompoundLayout::addNode(): Error: invalid group node index." );
+    width.push_back( nodeWidth );
+    height.push_back( nodeHeight );
+    group.push_back( static_cast<std::uint32_t>( nodeGroup ) );
+    return width.size() - 1;
+}
+
+inline auto CompoundLayout::addEdge( std::size_t src, std::size_t dst ) noexcept( false ) -> std::size_t
+{
+    gtpo::assert_throw( src < getNodeCount() && dst < getNodeCount(),
+                        "gtpo::CompoundLayout::addEdge(): Error: invalid source or destination node index." );
+    edgeSrc.push_back( static_cast<std::uint32_t>( src ) );
+    edgeDst.push_back( static_cast<std::uint32_t>( dst ) );
+    return edgeSrc.size() - 1;
+}
+//-----------------------------------------------------------------------------
+
+/* Layout Computation *///-----------------------------------------------------
+inline auto CompoundLayout::compute() -> void
+{
+    const auto nodeCount = getNodeCount();
+    x.assign( nodeCount, 0. );
+    y.assign( nodeCount, 0. );
+    layoutWidth = width;
+    layoutHeight = height;
+    if ( nodeCount == 0 )
+        return;
+
+    // Nesting depth, groups are always inserted before their content
+    std::vector<std::uint32_t> depth( nodeCount, 0 );
+    std::uint32_t maxDepth = 0;
+    for ( std::size_t n = 0; n < nodeCount; ++n )
+        if ( group[n] != NoGroup ) {
+            depth[n] = depth[group[n]] + 1;
+            maxDepth = std::max( maxDepth, depth[n] );
+        }
+
+    // Containers content, top level container is indexed by nodeCount
+    const auto containerOf = [this, nodeCount]( std::size_t n ) -> std::size_t {
+        return group[n] != NoGroup ? group[n] : nodeCount;
+    };
+    _contentBegin.assign( nodeCount + 2, 0 );
+    for ( std::size_t n = 0; n < nodeCount; ++n )
+        ++_contentBegin[containerOf( n ) + 1];
+    for ( std::size_t c = 0; c <= nodeCount; ++c )
+        _contentBegin[c + 1] += _contentBegin[c];
+    _content.resize( nodeCount );
+    {
+        std::vector<std::uint32_t> fill( _contentBegin.begin(), _contentBegin.end() - 1 );
+        for ( std::size_t n = 0; n < nodeCount; ++n )
+            _content[fill[containerOf( n )]++] = static_cast<std::uint32_t>( n );
+    }
+
+    // Lift edges to the innermost container of both extremities
+    _containerEdges.resize( nodeCount + 1 );
+    for ( auto& edges : _containerEdges )
+        edges.clear();
+    for ( std::size_t e = 0; e < edgeSrc.size(); ++e ) {
+        auto src = edgeSrc[e], dst = edgeDst[e];
+        while ( depth[src] > depth[dst] )
+            src = group[src];
+        while ( depth[dst] > depth[src] )
+            dst = group[dst];
+        if ( src == dst )       // Self loop, or edge between a group and its content
+            continue;
+        while ( group[src] != group[dst] ) {
+            src = group[src];
+            dst = group[dst];
+        }
+        _containerEdges[containerOf( src )].emplace_back( src, dst );
+    }
+
+    // Lay out groups bottom up, groups with the same depth are independent
+    gtpo::ThreadPool pool{ threadCount };
+    std::vector<Worker> workers( pool.getThreadCount() );
+    std::vector<std::vector<std::uint32_t>> levels( maxDepth );
+    for ( std::size_t n = 0; n < nodeCount; ++n )
+        if ( _contentBegin[n + 1] > _contentBegin[n] )
+            levels[depth[n]].push_back( static_cast<std::uint32_t>( n ) );
+    for ( auto level = levels.rbegin(); level != levels.rend(); ++level ) {
+        const auto& containers = *level;
+        pool.parallelFor( containers.size(), [this, &containers, &workers]( std::size_t c, unsigned int thread ) {
+            layoutContainer( containers[c], workers[thread] );
+        } );
+    }
+    layoutContainer( NoGroup, workers[0] );
+}
+
+inline auto CompoundLayout::layoutContainer( std::uint32_t container, Worker& worker ) -> void
+{
+    const auto nodeCount = getNodeCount();
+    const auto key = container != NoGroup ? container : nodeCount;
+    const auto contentBegin = _content.cbegin() + _contentBegin[key];
+    const auto contentEnd = _content.cbegin() + _contentBegin[key + 1];
+    auto& edges = _containerEdges[key];
+    std::sort( edges.begin(), edges.end() );    // Parallel edges are laid out once
+    edges.erase( std::unique( edges.begin(), edges.end() ), edges.end() );
+
+    // Connected content is laid out in layers, isolated content is arranged in rows below
+    constexpr std::uint32_t Isolated = std::numeric_limits<std::uint32_t>::max();
+    auto& local = worker.local;
+    local.resize( nodeCount );
+    for ( auto n = contentBegin; n != contentEnd; ++n )
+        local[*n] = Isolated;
+    auto& layered = worker.layered;
+    layered.clear();
+    std::vector<std::uint32_t> layeredNodes;
+    for ( const auto& edge : edges )
+        for ( const auto n : { edge.first, edge.second } )
+            if ( local[n] == Isolated ) {
+                local[n] = static_cast<std::uint32_t>( layered.addNode( layoutWidth[n], layoutHeight[n] ) );
+                layeredNodes.push_back( n );
+            }
+    for ( const auto& edge : edges )
+        layered.addEdge( local[edge.first], local[edge.second] );
+    layered.horizontal = horizontal;
+    layered.layerSpacing = layerSpacing;
+    layered.nodeSpacing = nodeSpacing;
+    layered.threadCount = container != NoGroup ? 1 : threadCount;
+    layered.compute();
+
+    double left = 0., top = 0., right = 0., bottom = 0.;
+    if ( !layeredNodes.empty() ) {
+        left = top = std::numeric_limits<double>::max();
+        right = bottom = std::numeric_limits<double>::lowest();
+    }
+    for ( const auto n : layeredNodes ) {
+        const auto l = local[n];
+        x[n] = layered.x[l];
+        y[n] = layered.y[l];
+        left = std::min( left, x[n] - layoutWidth[n] / 2. );
+        top = std::min( top, y[n] - layoutHeight[n] / 2. );
+        right = std::max( right, x[n] + layoutWidth[n] / 2. );
+        bottom = std::max( bottom, y[n] + layoutHeight[n] / 2. );
+    }
+
+    // Isolated nodes rows, rows are at least as wide as layered nodes and as wide as high otherwise
+    double area = 0.;
+    for ( auto n = contentBegin; n != contentEnd; ++n )
+        if ( local[*n] == Isolated )
+            area += ( layoutWidth[*n] + nodeSpacing ) * ( layoutHeight[*n] + nodeSpacing );
+    if ( area > 0. ) {
+        const double rowWidth = std::max( right - left, std::sqrt( area ) );
+        double rowX = left, rowY = layeredNodes.empty() ? top : bottom + layerSpacing, rowHeight = 0.;
+        for ( auto n = contentBegin; n != contentEnd; ++n ) {
+            if ( local[*n] != Isolated )
+                continue;
+            if ( rowX > left &&
+                 rowX + layoutWidth[*n] > left + rowWidth ) {
+                rowX = left;
+                rowY += rowHeight + nodeSpacing;
+                rowHeight = 0.;
+            }
+            x[*n] = rowX + layoutWidth[*n] / 2.;
+            y[*n] = rowY + layoutHeight[*n] / 2.;
+            rowX += layoutWidth[*n] + nodeSpacing;
+            rowHeight = std::max( rowHeight, layoutHeight[*n] );
+            right = std::max( right, rowX - nodeSpacing );
+            bottom = std::max( bottom, rowY + rowHeight );
+        }
+    }
+
+    // Move content top left corner to container origin (plus padding), then fit group size
+    const double padding = container != NoGroup ? groupPadding : 0.;
+    for ( auto n = contentBegin; n != contentEnd; ++n ) {
+        x[*n] += padding - left;
+        y[*n] += padding - top;
+    }
+    if ( container != NoGroup ) {
+        layoutWidth[container] = right - left + 2. * padding;
+        layoutHeight[container] = bottom - top + 2. * padding;
+    }
+}
+//-----------------------------------------------------------------------------
+
+} // ::gtpo
+
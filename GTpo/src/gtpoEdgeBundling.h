@@ -0,0 +1,198 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoEdgeBundling.h
+// \author	benoit@destrat.io
+// \date	2017 12 30
+//-----------------------------------------------------------------------------
+
+#ifndef gtpoEdgeBundling_h
+#define gtpoEdgeBundling_h
+
+// STD headers
+#include <cstddef>          // std::size_t
+#include <cstdint>          // std::uint8_t std::uint32_t
+#include <limits>
+#include <vector>
+
+// GTpo headers
+#include "./gtpoUtils.h"
+#include "./gtpoSpatialIndex.h"
+
+namespace gtpo { // ::gtpo
+
+/*! \brief Incremental force directed edge bundling (FDEB) of straight edges.
+ *
+ * Every edge is subdivided in points attracted by points of compatible edges (edges with similar angle, length,
+ * position and visibility, with a compatibility above \c compatibilityThreshold), while a spring force keeps edge
+ * points along the edge. Bundling runs \c cycles cycles, subdivision points are doubled on every cycle (up to
+ * \c subdivisions points) while step size is halved and iteration count decrease.
+ *
+ * Compatible edges candidates are found with a gtpo::SpatialIndex, every iteration moves edges points concurrently.
+ *
+ * Bundling is incremental: when a few edges are modified (less than \c incrementalRatio edges), only modified edges
+ * and edges compatible with them are bundled again, all other edges keep their points and still attract modified
+ * edges. Bundled points could then be blended with straight edges with getPolyline() (for example to have a
+ * bundling strength depending on view zoom).
+ *
+ * \code
+ *   gtpo::EdgeBundling bundling;
+ *   bundling.addEdge( 0., 0., 300., 0. );
+ *   bundling.addEdge( 0., 40., 300., 40. );
+ *   bundling.bundle();
+ *   const auto polyline = bundling.getPolyline( 0, 0.8 );   // 80% bundled
+ * \endcode
+ * \nosubgrouping
+ */
+class EdgeBundling
+{
+    /*! \name EdgeBundling Object Management *///------------------------------
+    //@{
+public:
+    EdgeBundling() noexcept = default;
+    ~EdgeBundling() = default;
+    EdgeBundling( const EdgeBundling& ) = delete;
+    EdgeBundling& operator=( const EdgeBundling& ) = delete;
+
+    //! Remove all edges.
+    auto            clear() noexcept -> void;
+    //! Number of (non removed) edges.
+    inline auto     getEdgeCount() const noexcept -> std::size_t { return _alive.size() - _freeEdges.size(); }
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Edges Management *///--------------------------------------------
+    //@{
+public:
+    enum : std::uint32_t { NoIndex = std::numeric_limits<std::uint32_t>::max() };
+
+    //! Bundled edge point.
+    struct Point {
+        double  x;
+        double  y;
+    };
+
+    //! Add a dirty straight edge from (\c x1, \c y1) to (\c x2, \c y2) and return its index.
+    auto            addEdge( double x1, double y1, double x2, double y2 ) noexcept( false ) -> std::uint32_t;
+    /*! \brief Modify \c edge end points, \c edge is marked dirty if its end points are actually modified.
+     *
+     * \throw gtpo::bad_topology_error if \c edge is not a valid edge index.
+     */
+    auto            setEdge( std::uint32_t edge, double x1, double y1, double x2, double y2 ) noexcept( false ) -> void;
+    /*! \brief Remove edge \c edge, edges compatible with \c edge are bundled again.
+     *
+     * \throw gtpo::bad_topology_error if \c edge is not a valid edge index.
+     */
+    auto            removeEdge( std::uint32_t edge ) noexcept( false ) -> void;
+    //! Return true if \c edge is a valid (non removed) edge index.
+    inline auto     isEdge( std::uint32_t edge ) const noexcept -> bool {
+        return edge < _alive.size() && _alive[ edge ] != 0;
+    }
+    //! Return true if some edges have been modified since last bundle().
+    inline auto     hasDirtyEdges() const noexcept -> bool { return !_dirty.empty(); }
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Bundling Configuration *///--------------------------------------
+    //@{
+public:
+    //! Minimum compatibility (in [0, 1]) of two edges attracting each other (default to 0.6).
+    double          compatibilityThreshold{ 0.6 };
+    //! Stiffness of edges, higher values give less curved edges (default to 0.1).
+    double          springConstant{ 0.1 };
+    //! Maximum points displacement during an iteration of first cycle, halved on every cycle (default to 4.).
+    double          stepSize{ 4. };
+    //! Number of subdivision cycles (default to 5).
+    unsigned int    cycles{ 5 };
+    //! Number of iterations of first cycle, reduced by a third on every cycle (default to 50).
+    unsigned int    iterations{ 50 };
+    //! Maximum number of subdivision points of an edge (excluding its end points, default to 15).
+    unsigned int    subdivisions{ 15 };
+    //! Maximum number of compatible edges attracting an edge, most compatible edges are kept (default to 32).
+    unsigned int    maxNeighbours{ 32 };
+    //! Maximum ratio of modified edges for an incremental bundling, otherwise all edges are bundled again (default to 0.1).
+    double          incrementalRatio{ 0.1 };
+    //! Number of worker threads, 0 to use all available hardware threads (default to 0).
+    unsigned int    threadCount{ 0 };
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Bundling *///----------------------------------------------------
+    //@{
+public:
+    //! Bundle modified edges (or all edges) and return edges whose points have been modified.
+    auto            bundle() -> const std::vector<std::uint32_t>&;
+    //! Return \c edge bundled points, including its end points (only end points if \c edge has not been bundled, empty if \c edge is invalid).
+    auto            getPoints( std::uint32_t edge ) const noexcept -> const std::vector<Point>&;
+    /*! \brief Return \c edge bundled points blended with \c edge straight line, a \c strength of 0 give a straight line, 1 give bundled points.
+     */
+    auto            getPolyline( std::uint32_t edge, double strength ) const -> std::vector<Point>;
+
+private:
+    //! Compatible edge attracting an edge.
+    struct Neighbour {
+        std::uint32_t   edge;
+        float           compatibility;
+        //! True if neighbour edge has an opposite direction (its points are attracting edge points in reverse order).
+        bool            reversed;
+    };
+    //! Return compatibility of edge \c p with edge \c q in [0, 1] and set \c reversed if they have opposite directions.
+    auto            compatibility( std::uint32_t p, std::uint32_t q, bool& reversed ) const noexcept -> double;
+    //! Find compatible edges of \c edge.
+    auto            findNeighbours( std::uint32_t edge, double radiusFactor, std::vector<Neighbour>& neighbours ) const -> void;
+    //! Resample \c edge points to \c count subdivision points (evenly spaced along actual \c edge polyline).
+    auto            resample( std::uint32_t edge, std::size_t count ) -> void;
+    //! Compute new position of \c edge subdivision points in \c _next from actual points.
+    auto            moveEdge( std::uint32_t edge, double step ) const noexcept -> void;
+
+private:
+    //! Edges end points (straight edge).
+    std::vector<Point>                      _src, _dst;
+    std::vector<std::uint8_t>               _alive;
+    std::vector<std::uint32_t>              _freeEdges;
+    SpatialIndex<std::uint32_t>             _index;
+    std::vector<std::vector<Neighbour>>     _neighbours;
+    //! Edges actual and next (during an iteration) points.
+    std::vector<std::vector<Point>>         _points;
+    std::vector<std::vector<Point>>         _next;
+
+    //! Inserted, modified and removed edges since last bundle().
+    std::vector<std::uint32_t>              _dirty;
+    std::vector<std::uint32_t>              _changed;
+    //! False until all edges have been bundled once.
+    bool                                    _bundled{ false };
+    //@}
+    //-------------------------------------------------------------------------
+};
+
+} // ::gtpo
+
+#include "./gtpoEdgeBundling.hpp"
+
+#endif // gtpoEdgeBundling_h
@@ -0,0 +1,384 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoEdgeBundling.hpp
+// \author	benoit@destrat.io
+// \date	2017 12 30
+//-----------------------------------------------------------------------------
+
+// STD headers
+#include <algorithm>    // std::sort std::unique std::nth_element
+#include <cmath>        // std::sqrt std::abs std::lround
+
+namespace gtpo { // ::gtpo
+
+/* EdgeBundling Object Management *///-----------------------------------------
+inline auto EdgeBundling::clear() noexcept -> void
+{
+    _src.clear();       _dst.clear();
+    _alive.clear();
+    _freeEdges.clear();
+    _index.clear();
+    _neighbours.clear();
+    _points.clear();    _next.clear();
+    _dirty.clear();
+    _changed.clear();
+    _bundled = false;
+}
+//-----------------------------------------------------------------------------
+
+/* Edges Management *///-------------------------------------------------------
+inline auto EdgeBundling::addEdge( double x1, double y1, double x2, double y2 ) noexcept( false ) -> std::uint32_t
+{
+    std::uint32_t edge = NoIndex;
+    if ( !_freeEdges.empty() ) {
+        edge = _freeEdges.back();
+        _freeEdges.pop_back();
+        _alive[ edge ] = 1;
+    } else {
+        edge = static_cast<std::uint32_t>( _alive.size() );
+        _src.emplace_back();
+        _dst.emplace_back();
+        _alive.push_back( 1 );
+        _neighbours.emplace_back();
+        _points.emplace_back();
+        _next.emplace_back();
+    }
+    _src[ edge ] = Point{ x1, y1 };
+    _dst[ edge ] = Point{ x2, y2 };
+    _points[ edge ].assign( { _src[ edge ], _dst[ edge ] } );
+    _index.insert( edge, Box{ std::min( x1, x2 ), std::min( y1, y2 ), std::max( x1, x2 ), std::max( y1, y2 ) } );
+    _dirty.push_back( edge );
+    return edge;
+}
+
+inline auto EdgeBundling::setEdge( std::uint32_t edge, double x1, double y1, double x2, double y2 ) noexcept( false ) -> void
+{
+    gtpo::assert_throw( isEdge( edge ), "gtpo::EdgeBundling::setEdge(): Error: invalid edge index." );
+    if ( _src[ edge ].x == x1 && _src[ edge ].y == y1 &&
+         _dst[ edge ].x == x2 && _dst[ edge ].y == y2 )
+        return;
+    _src[ edge ] = Point{ x1, y1 };
+    _dst[ edge ] = Point{ x2, y2 };
+    _points[ edge ].assign( { _src[ edge ], _dst[ edge ] } );     // Straight until bundled again
+    _index.update( edge, Box{ std::min( x1, x2 ), std::min( y1, y2 ), std::max( x1, x2 ), std::max( y1, y2 ) } );
+    _dirty.push_back( edge );
+}
+
+inline auto EdgeBundling::removeEdge( std::uint32_t edge ) noexcept( false ) -> void
+{
+    gtpo::assert_throw( isEdge( edge ), "gtpo::EdgeBundling::removeEdge(): Error: invalid edge index." );
+    _alive[ edge ] = 0;
+    _index.remove( edge );
+    _neighbours[ edge ].clear();
+    _points[ edge ].clear();
+    _next[ edge ].clear();
+    _freeEdges.push_back( edge );
+    _dirty.push_back( edge );       // Edges attracted by a removed edge are bundled again
+}
+//-----------------------------------------------------------------------------
+
+/* Bundling *///---------------------------------------------------------------
+inline auto EdgeBundling::getPoints( std::uint32_t edge ) const noexcept -> const std::vector<Point>&
+{
+    static const std::vector<Point> empty;
+    return isEdge( edge ) ? _points[ edge ] : empty;
+}
+
+inline auto EdgeBundling::getPolyline( std::uint32_t edge, double strength ) const -> std::vector<Point>
+{
+    if ( !isEdge( edge ) )
+        return std::vector<Point>{};
+    strength = std::min( std::max( strength, 0. ), 1. );
+    const auto& points = _points[ edge ];
+    const auto& src = _src[ edge ];
+    const auto& dst = _dst[ edge ];
+    const double last = static_cast<double>( points.size() - 1 );
+    std::vector<Point> polyline( points.size() );
+    for ( std::size_t p = 0; p < points.size(); ++p ) {
+        const double t = p / last;
+        const double x = src.x + ( dst.x - src.x ) * t;     // Point on straight edge
+        const double y = src.y + ( dst.y - src.y ) * t;
+        polyline[ p ] = Point{ x + ( points[ p ].x - x ) * strength, y + ( points[ p ].y - y ) * strength };
+    }
+    return polyline;
+}
+
+inline auto EdgeBundling::bundle() -> const std::vector<std::uint32_t>&
+{
+    _changed.clear();
+    if ( _dirty.empty() )
+        return _changed;
+    std::sort( _dirty.begin(), _dirty.end() );
+    _dirty.erase( std::unique( _dirty.begin(), _dirty.end() ), _dirty.end() );
+    gtpo::ThreadPool pool{ threadCount };   // Workers are reused for every cycle and iteration
+
+    // Compatible edges midpoints are closer than radiusFactor times edge length: position compatibility is
+    // lavg / ( lavg + distance ) and scale compatibility bound the ratio r between edges lengths
+    const double threshold = std::min( std::max( compatibilityThreshold, 0.05 ), 1. );
+    const auto scaleCompatibility = []( double r ) { return 2. / ( ( 1. + r ) / 2. + 2. * r / ( 1. + r ) ); };
+    double low = 1., high = 1e6;
+    for ( int i = 0; i < 64; ++i ) {
+        const double r = ( low + high ) / 2.;
+        ( scaleCompatibility( r ) >= threshold ? low : high ) = r;
+    }
+    const double radiusFactor = ( 1. + high ) / 2. * ( 1. / threshold - 1. );
+
+    // Affected edges: modified edges, edges attracted by modified edges and edges attracting modified edges
+    std::vector<std::uint8_t> affected( _alive.size(), 0 );
+    std::vector<std::uint32_t> edges;
+    for ( const auto edge : _dirty )
+        if ( isEdge( edge ) ) {
+            affected[ edge ] = 1;
+            edges.push_back( edge );
+        }
+    const auto edgeCount = getEdgeCount();
+    const bool full = !_bundled ||
+                      static_cast<double>( _dirty.size() ) > incrementalRatio * static_cast<double>( edgeCount );
+    if ( full ) {
+        edges.clear();
+        for ( std::uint32_t edge = 0; edge < _alive.size(); ++edge )
+            if ( _alive[ edge ] != 0 ) {
+                affected[ edge ] = 1;
+                edges.push_back( edge );
+            }
+        pool.parallelFor( edges.size(), [this, &edges, radiusFactor]( std::size_t e, unsigned int ) {
+            findNeighbours( edges[ e ], radiusFactor, _neighbours[ edges[ e ] ] );
+        } );
+    } else {
+        std::vector<std::uint8_t> dirty( _alive.size(), 0 );
+        for ( const auto edge : _dirty )
+            dirty[ edge ] = 1;
+        const auto modified = edges.size();
+        pool.parallelFor( modified, [this, &edges, radiusFactor]( std::size_t e, unsigned int ) {
+            findNeighbours( edges[ e ], radiusFactor, _neighbours[ edges[ e ] ] );
+        } );
+        for ( std::size_t e = 0; e < modified; ++e )
+            for ( const auto& neighbour : _neighbours[ edges[ e ] ] )
+                if ( affected[ neighbour.edge ] == 0 ) {
+                    affected[ neighbour.edge ] = 1;
+                    edges.push_back( neighbour.edge );
+                }
+        for ( std::uint32_t edge = 0; edge < _alive.size(); ++edge ) {
+            if ( _alive[ edge ] == 0 || affected[ edge ] != 0 )
+                continue;
+            for ( const auto& neighbour : _neighbours[ edge ] )
+                if ( dirty[ neighbour.edge ] != 0 ) {
+                    affected[ edge ] = 1;
+                    edges.push_back( edge );
+                    break;
+                }
+        }
+        pool.parallelFor( edges.size() - modified, [this, &edges, modified, radiusFactor]( std::size_t e, unsigned int ) {
+            findNeighbours( edges[ modified + e ], radiusFactor, _neighbours[ edges[ modified + e ] ] );
+        } );
+    }
+    for ( const auto edge : edges )     // Affected edges are bundled from their straight line
+        _points[ edge ].assign( { _src[ edge ], _dst[ edge ] } );
+
+    // Subdivision cycles, other edges points are fixed
+    double step = stepSize;
+    unsigned int cycleIterations = iterations;
+    for ( unsigned int cycle = 0; cycle < cycles && subdivisions > 0; ++cycle ) {
+        const auto count = std::min<std::size_t>( subdivisions, std::size_t{ 1 } << std::min( cycle, 30u ) );
+        pool.parallelFor( edges.size(), [this, &edges, count]( std::size_t e, unsigned int ) { resample( edges[ e ], count ); } );
+        for ( unsigned int iteration = 0; iteration < cycleIterations; ++iteration ) {
+            pool.parallelFor( edges.size(), [this, &edges, step]( std::size_t e, unsigned int ) { moveEdge( edges[ e ], step ); } );
+            for ( const auto edge : edges )
+                _points[ edge ].swap( _next[ edge ] );
+        }
+        step /= 2.;
+        cycleIterations = std::max( 1u, cycleIterations * 2 / 3 );
+    }
+
+    _bundled = true;
+    _dirty.clear();
+    std::sort( edges.begin(), edges.end() );
+    _changed.swap( edges );
+    return _changed;
+}
+
+inline auto EdgeBundling::compatibility( std::uint32_t p, std::uint32_t q, bool& reversed ) const noexcept -> double
+{
+    static constexpr double epsilon = 1e-6;
+    const auto& p0 = _src[ p ];
+    const auto& p1 = _dst[ p ];
+    const auto& q0 = _src[ q ];
+    const auto& q1 = _dst[ q ];
+    const double px = p1.x - p0.x, py = p1.y - p0.y;
+    const double qx = q1.x - q0.x, qy = q1.y - q0.y;
+    const double lp = std::sqrt( px * px + py * py );
+    const double lq = std::sqrt( qx * qx + qy * qy );
+    if ( lp < epsilon || lq < epsilon )
+        return 0.;
+    const double dot = px * qx + py * qy;
+    reversed = dot < 0.;
+
+    const double angle = std::abs( dot ) / ( lp * lq );
+    const double average = ( lp + lq ) / 2.;
+    const double scale = 2. / ( average / std::min( lp, lq ) + std::max( lp, lq ) / average );
+    const double mx = ( p0.x + p1.x - q0.x - q1.x ) / 2.;
+    const double my = ( p0.y + p1.y - q0.y - q1.y ) / 2.;
+    const double position = average / ( average + std::sqrt( mx * mx + my * my ) );
+    if ( angle * scale * position < compatibilityThreshold )
+        return 0.;
+
+    // Visibility of an edge from another: project edge on other edge line, compare projection and edge middles
+    const auto visibility = []( const Point& a0, const Point& a1, const Point& b0, const Point& b1 ) -> double {
+        const double ax = a1.x - a0.x, ay = a1.y - a0.y;
+        const double length2 = ax * ax + ay * ay;
+        const double t0 = ( ( b0.x - a0.x ) * ax + ( b0.y - a0.y ) * ay ) / length2;
+        const double t1 = ( ( b1.x - a0.x ) * ax + ( b1.y - a0.y ) * ay ) / length2;
+        const double projection = std::abs( t1 - t0 ) * std::sqrt( length2 );
+        if ( projection < epsilon )
+            return 0.;
+        const double ix = a0.x + ax * ( t0 + t1 ) / 2. - ( b0.x + b1.x ) / 2.;
+        const double iy = a0.y + ay * ( t0 + t1 ) / 2. - ( b0.y + b1.y ) / 2.;
+        return std::max( 0., 1. - 2. * std::sqrt( ix * ix + iy * iy ) / projection );
+    };
+    const double visible = std::min( visibility( p0, p1, q0, q1 ), visibility( q0, q1, p0, p1 ) );
+    return angle * scale * position * visible;
+}
+
+inline auto EdgeBundling::findNeighbours( std::uint32_t edge, double radiusFactor, std::vector<Neighbour>& neighbours ) const -> void
+{
+    neighbours.clear();
+    const auto& src = _src[ edge ];
+    const auto& dst = _dst[ edge ];
+    const double length = std::sqrt( ( dst.x - src.x ) * ( dst.x - src.x ) + ( dst.y - src.y ) * ( dst.y - src.y ) );
+    if ( length < 1e-6 || maxNeighbours == 0 )
+        return;
+    const double mx = ( src.x + dst.x ) / 2., my = ( src.y + dst.y ) / 2.;
+    const double radius = length * radiusFactor;
+    _index.visit( Box{ mx - radius, my - radius, mx + radius, my + radius },
+                  [this, edge, &neighbours]( const std::uint32_t& other, const Box& ) {
+        if ( other == edge )
+            return;
+        bool reversed = false;
+        const double c = compatibility( edge, other, reversed );
+        if ( c > 0. && c >= compatibilityThreshold )
+            neighbours.push_back( Neighbour{ other, static_cast<float>( c ), reversed } );
+    } );
+    if ( neighbours.size() > maxNeighbours ) {      // Keep most compatible edges
+        std::nth_element( neighbours.begin(), neighbours.begin() + maxNeighbours, neighbours.end(),
+                          []( const Neighbour& a, const Neighbour& b ) {
+            return a.compatibility != b.compatibility ? a.compatibility > b.compatibility : a.edge < b.edge;
+        } );
+        neighbours.resize( maxNeighbours );
+    }
+    std::sort( neighbours.begin(), neighbours.end(),
+               []( const Neighbour& a, const Neighbour& b ) { return a.edge < b.edge; } );
+}
+
+inline auto EdgeBundling::resample( std::uint32_t edge, std::size_t count ) -> void
+{
+    const auto& points = _points[ edge ];
+    std::vector<double> lengths( points.size(), 0. );       // Cumulated length at every point
+    for ( std::size_t p = 1; p < points.size(); ++p ) {
+        const double dx = points[ p ].x - points[ p - 1 ].x;
+        const double dy = points[ p ].y - points[ p - 1 ].y;
+        lengths[ p ] = lengths[ p - 1 ] + std::sqrt( dx * dx + dy * dy );
+    }
+    const double length = lengths.back();
+    auto& resampled = _next[ edge ];
+    resampled.resize( count + 2 );
+    resampled.front() = _src[ edge ];
+    resampled.back() = _dst[ edge ];
+    std::size_t segment = 1;
+    for ( std::size_t p = 1; p <= count; ++p ) {
+        const double t = static_cast<double>( p ) / static_cast<double>( count + 1 );
+        if ( length < 1e-6 ) {
+            resampled[ p ] = Point{ _src[ edge ].x + ( _dst[ edge ].x - _src[ edge ].x ) * t,
+                                    _src[ edge ].y + ( _dst[ edge ].y - _src[ edge ].y ) * t };
+            continue;
+        }
+        const double target = t * length;
+        while ( segment + 1 < points.size() && lengths[ segment ] < target )
+            ++segment;
+        const double segmentLength = lengths[ segment ] - lengths[ segment - 1 ];
+        const double u = segmentLength > 0. ? ( target - lengths[ segment - 1 ] ) / segmentLength : 0.;
+        resampled[ p ] = Point{ points[ segment - 1 ].x + ( points[ segment ].x - points[ segment - 1 ].x ) * u,
+                                points[ segment - 1 ].y + ( points[ segment ].y - points[ segment - 1 ].y ) * u };
+    }
+    _points[ edge ].swap( resampled );
+    _next[ edge ] = _points[ edge ];
+}
+
+inline auto EdgeBundling::moveEdge( std::uint32_t edge, double step ) const noexcept -> void
+{
+    const auto& points = _points[ edge ];
+    auto& next = const_cast<std::vector<Point>&>( _next[ edge ] );  // Only edge next points are written
+    const auto count = points.size();
+    const double dx = _dst[ edge ].x - _src[ edge ].x;
+    const double dy = _dst[ edge ].y - _src[ edge ].y;
+    const double length = std::sqrt( dx * dx + dy * dy );
+    if ( count < 3 || length < 1e-6 )
+        return;
+    // Spring between adjacent points, stiffer when there are more (shorter) segments
+    const double spring = springConstant * static_cast<double>( count - 1 ) / length;
+    const auto& neighbours = _neighbours[ edge ];
+    for ( std::size_t p = 1; p + 1 < count; ++p ) {
+        const auto& point = points[ p ];
+        double fx = spring * ( points[ p - 1 ].x + points[ p + 1 ].x - 2. * point.x );
+        double fy = spring * ( points[ p - 1 ].y + points[ p + 1 ].y - 2. * point.y );
+        // Compatible edges points at the same relative position attract point (weighted mean of directions)
+        double ex = 0., ey = 0., weight = 0.;
+        const double t = static_cast<double>( p ) / static_cast<double>( count - 1 );
+        for ( const auto& neighbour : neighbours ) {
+            const auto& others = _points[ neighbour.edge ];
+            if ( others.size() < 2 )
+                continue;
+            const auto last = others.size() - 1;
+            const auto other = static_cast<std::size_t>( std::lround( ( neighbour.reversed ? 1. - t : t ) * last ) );
+            const double ox = others[ other ].x - point.x;
+            const double oy = others[ other ].y - point.y;
+            const double distance = std::sqrt( ox * ox + oy * oy );
+            if ( distance > 1e-6 ) {
+                ex += neighbour.compatibility * ox / distance;
+                ey += neighbour.compatibility * oy / distance;
+            }
+            weight += neighbour.compatibility;
+        }
+        if ( weight > 1. ) {
+            ex /= weight;
+            ey /= weight;
+        }
+        fx += ex;
+        fy += ey;
+        const double force = std::sqrt( fx * fx + fy * fy );
+        if ( force > 1. ) {     // Displacement never exceed step
+            fx /= force;
+            fy /= force;
+        }
+        next[ p ] = Point{ point.x + step * fx, point.y + step * fy };
+    }
+}
+//-----------------------------------------------------------------------------
+
+} // ::gtpo
@@ -0,0 +1,151 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoEdgeGeometry.h
+// \author	benoit@destrat.io
+// \date	2017 12 20
+//-----------------------------------------------------------------------------
+
+#ifndef gtpoEdgeGeometry_h
+#define gtpoEdgeGeometry_h
+
+// STD headers
+#include <cstddef>          // std::size_t
+#include <cstdint>          // std::uint8_t std::uint32_t
+#include <vector>
+
+// GTpo headers
+#include "./gtpoSpatialIndex.h"     // gtpo::Box
+
+namespace gtpo { // ::gtpo
+
+/*! \brief Structure of arrays input and output of gtpo::computeEdgeGeometry().
+ *
+ * A batch store node bounding shapes once (no matter how many edges are connected to a node), and a list of
+ * edges referencing their source and destination shapes by index. Shapes are polylines expressed in a local
+ * coordinate system translated by (\c tx, \c ty), closed shapes must repeat their first point (as a QPolygonF
+ * built from a QRectF do).
+ *
+ * \code
+ *   gtpo::EdgeGeometryBatch batch;
+ *   const auto src = batch.beginShape( 10., 10. );    // Shape translated by (10, 10)
+ *   batch.addShapePoint( 0., 0. );  batch.addShapePoint( 50., 0. );    // ... close shape with (0, 0)
+ *   batch.addEdge( src, dst, 4., false );
+ *   gtpo::computeEdgeGeometry( batch );
+ *   if ( !batch.hidden[0] )
+ *      draw( batch.p1X[0], batch.p1Y[0], batch.p2X[0], batch.p2Y[0] );
+ * \endcode
+ *
+ * Batch memory is kept by clear(), reuse the same batch for successive updates to avoid reallocations.
+ * \nosubgrouping
+ */
+class EdgeGeometryBatch
+{
+    /*! \name EdgeGeometryBatch Object Management *///-------------------------
+    //@{
+public:
+    EdgeGeometryBatch() noexcept = default;
+    ~EdgeGeometryBatch() = default;
+    EdgeGeometryBatch( const EdgeGeometryBatch& ) = delete;
+    EdgeGeometryBatch& operator=( const EdgeGeometryBatch& ) = delete;
+
+    //! Remove all shapes and edges, allocated memory is kept for the next batch.
+    auto            clear() noexcept -> void;
+    inline auto     getShapeCount() const noexcept -> std::size_t { return shapeTx.size(); }
+    inline auto     getEdgeCount() const noexcept -> std::size_t { return edgeSrc.size(); }
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Batch Input *///-------------------------------------------------
+    //@{
+public:
+    //! Start a new shape translated by (\c tx, \c ty) and return its index, shape points are then added with addShapePoint().
+    auto            beginShape( double tx, double ty ) -> std::size_t;
+    //! Add point (\c x, \c y) expressed in the last shape local CS.
+    inline auto     addShapePoint( double x, double y ) -> void { shapeX.push_back( x ); shapeY.push_back( y ); }
+    /*! \brief Add an edge from shape \c src to shape \c dst and return its index.
+     *
+     * \c arrowSize is the destination arrow size (arrow length is 3 * \c arrowSize), \c curved set to
+     * true generate a cubic curve with control points.
+     * \throw gtpo::bad_topology_error if \c src or \c dst is not a valid shape index.
+     */
+    auto            addEdge( std::size_t src, std::size_t dst, double arrowSize, bool curved ) noexcept( false ) -> std::size_t;
+
+public:
+    //! Shapes points in their local CS (points of shape \c s are in [shapeBegin[s], shapeBegin[s+1]).
+    std::vector<double>         shapeX, shapeY;
+    std::vector<std::size_t>    shapeBegin;
+    std::vector<double>         shapeTx, shapeTy;
+
+    std::vector<std::uint32_t>  edgeSrc, edgeDst;
+    std::vector<double>         edgeArrowSize;
+    std::vector<std::uint8_t>   edgeCurved;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Batch Output *///------------------------------------------------
+    //@{
+public:
+    //! Shapes points in global CS (same layout than shapeX and shapeY).
+    std::vector<double>         pointX, pointY;
+    //! Shapes bounding boxes in global CS.
+    std::vector<Box>            shapeBox;
+
+    //! Edge line source and destination points (destination is corrected to take arrow length into account).
+    std::vector<double>         p1X, p1Y, p2X, p2Y;
+    //! Edge cubic control points (curved edges only).
+    std::vector<double>         c1X, c1Y, c2X, c2Y;
+    //! Destination arrow angle in degrees (or a value < 0. when line is too short).
+    std::vector<double>         dstAngle;
+    //! Set to 1 when edge should not be displayed (line too short or fully inside its source or destination shape).
+    std::vector<std::uint8_t>   hidden;
+    //@}
+    //-------------------------------------------------------------------------
+};
+
+/*! \brief Compute edges geometry for all edges in \c batch.
+ *
+ * Shapes are translated to global CS once, then for every edge:
+ * - Line between source and destination shapes bounding boxes centers is clipped against source and
+ *   destination shapes: source point is the last intersection on source shape, destination point the first
+ *   intersection on destination shape.
+ * - Edges shorter than their arrow, or fully contained in their source or destination bounding boxes are hidden.
+ * - Straight edges destination point is moved back by arrow length, curved edges control points are generated
+ *   around line normal and line end points are clipped again on (control point, shape center) lines.
+ *
+ * Inner loops run on contiguous arrays without branches and are expected to be vectorized by the compiler.
+ */
+auto    computeEdgeGeometry( EdgeGeometryBatch& batch ) noexcept -> void;
+
+} // ::gtpo
+
+#include "./gtpoEdgeGeometry.hpp"
+
+#endif // gtpoEdgeGeometry_h
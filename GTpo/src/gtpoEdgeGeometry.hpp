@@ -0,0 +1,302 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoEdgeGeometry.hpp
+// \author	benoit@destrat.io
+// \date	2017 12 20
+//-----------------------------------------------------------------------------
+
+// STD headers
+#include <algorithm>    // std::min std::max
+#include <cmath>        // std::sqrt std::acos std::atan2
+#include <limits>
+
+namespace gtpo { // ::gtpo
+
+/* EdgeGeometryBatch Object Management *///------------------------------------
+inline auto EdgeGeometryBatch::clear() noexcept -> void
+{
+    shapeX.clear();     shapeY.clear();
+    shapeBegin.clear();
+    shapeTx.clear();    shapeTy.clear();
+    edgeSrc.clear();    edgeDst.clear();
+    edgeArrowSize.clear();
+    edgeCurved.clear();
+}
+//-----------------------------------------------------------------------------
+
+/* Batch Input *///------------------------------------------------------------
+inline auto EdgeGeometryBatch::beginShape( double tx, double ty ) -> std::size_t
+{
+    shapeBegin.push_back( shapeX.size() );
+    shapeTx.push_back( tx );
+    shapeTy.push_back( ty );
+    return shapeTx.size() - 1;
+}
+
+inline auto EdgeGeometryBatch::addEdge( std::size_t src, std::size_t dst, double arrowSize, bool curved ) noexcept( false ) -> std::size_t
+{
+    gtpo::assert_throw( src < getShapeCount() && dst < getShapeCount(),
+                        "gtpo::EdgeGeometryBatch::addEdge(): Error: invalid source or destination shape index." );
+    edgeSrc.push_back( static_cast<std::uint32_t>( src ) );
+    edgeDst.push_back( static_cast<std::uint32_t>( dst ) );
+    edgeArrowSize.push_back( arrowSize );
+    edgeCurved.push_back( curved ? 1 : 0 );
+    return edgeSrc.size() - 1;
+}
+//-----------------------------------------------------------------------------
+
+/* Edge Geometry Kernel *///---------------------------------------------------
+namespace impl { // ::gtpo::impl
+
+//! Parameters of the first and last intersections of a segment with a shape (tMin > tMax when there is no intersection).
+struct SegmentHits {
+    double  tMin;
+    double  tMax;
+};
+
+/*! \brief Intersect segment (\c ax, \c ay) + t * (\c dx, \c dy), t in [0, 1] with polyline ( \c xs, \c ys ) of \c count points.
+ *
+ * Loop is branch free (conditions are folded in min/max selections) to let the compiler vectorize it.
+ */
+inline auto segmentHits( const double* xs, const double* ys, std::size_t count,
+                         double ax, double ay, double dx, double dy ) noexcept -> SegmentHits
+{
+    double tMin = std::numeric_limits<double>::max();
+    double tMax = std::numeric_limits<double>::lowest();
+    for ( std::size_t p = 0; p + 1 < count; ++p ) {
+        const double ex = xs[p + 1] - xs[p];
+        const double ey = ys[p + 1] - ys[p];
+        const double wx = xs[p] - ax;
+        const double wy = ys[p] - ay;
+        const double denom = dx * ey - dy * ex;
+        const double invDenom = 1. / ( denom != 0. ? denom : 1. );
+        const double t = ( wx * ey - wy * ex ) * invDenom;
+        const double u = ( wx * dy - wy * dx ) * invDenom;
+        const bool valid = ( denom != 0. ) & ( t >= 0. ) & ( t <= 1. ) & ( u >= 0. ) & ( u <= 1. );
+        tMin = valid && t < tMin ? t : tMin;
+        tMax = valid && t > tMax ? t : tMax;
+    }
+    return SegmentHits{ tMin, tMax };
+}
+
+//! Return (\c dx, \c dy) line angle in degrees in [0, 360[ or -1. when line is too short.
+inline auto lineAngle( double dx, double dy ) noexcept -> double
+{
+    static constexpr    double Pi = 3.141592653;
+    static constexpr    double TwoPi = 2. * Pi;
+    static constexpr    double MinLength = 0.00001;
+    const double length = std::sqrt( dx * dx + dy * dy );
+    if ( length < MinLength )
+        return -1.;
+    double angle = std::acos( dx / length );
+    if ( dy < 0. )
+        angle = TwoPi - angle;
+    return angle * ( 360. / TwoPi );
+}
+
+//! Return tangent angle in degrees of cubic curve (\c p1, \c c1, \c c2, \c p2) at \c pos in [0, 1].
+inline auto cubicCurveAngleAt( double pos, double p1x, double p1y, double p2x, double p2y,
+                               double c1x, double c1y, double c2x, double c2y ) noexcept -> double
+{
+    const double coeff3x = p2x - ( 3. * c2x ) + ( 3. * c1x ) - p1x;
+    const double coeff3y = p2y - ( 3. * c2y ) + ( 3. * c1y ) - p1y;
+    const double coeff2x = ( 3. * c2x ) - ( 6. * c1x ) + ( 3. * p1x );
+    const double coeff2y = ( 3. * c2y ) - ( 6. * c1y ) + ( 3. * p1y );
+    const double coeff1x = ( 3. * c1x ) - ( 3. * p1x );
+    const double coeff1y = ( 3. * c1y ) - ( 3. * p1y );
+
+    const double pos2 = pos * pos;
+    const double dxdt = ( 3. * coeff3x * pos2 ) + ( 2. * coeff2x * pos ) + coeff1x;
+    const double dydt = ( 3. * coeff3y * pos2 ) + ( 2. * coeff2y * pos ) + coeff1y;
+
+    static constexpr    double Pi = 3.141592653;
+    const double degrees = std::atan2( dxdt, dydt ) * 180. / Pi;
+    return degrees > 90. ? 450. - degrees : 90. - degrees;
+}
+
+//! Return true if \c inner is fully inside \c outer, with QRectF::contains() semantic (empty boxes are never contained).
+inline auto boxContains( const Box& outer, const Box& inner ) noexcept -> bool
+{
+    if ( outer.width() <= 0. || outer.height() <= 0. ||
+         inner.width() <= 0. || inner.height() <= 0. )
+        return false;
+    return outer.contains( inner );
+}
+
+} // ::gtpo::impl
+
+inline auto computeEdgeGeometry( EdgeGeometryBatch& batch ) noexcept -> void
+{
+    // Transform shapes to global CS and compute their bounding boxes
+    const std::size_t shapeCount = batch.getShapeCount();
+    const std::size_t pointCount = batch.shapeX.size();
+    batch.pointX.resize( pointCount );
+    batch.pointY.resize( pointCount );
+    batch.shapeBox.resize( shapeCount );
+    auto shapeEnd = [&batch, shapeCount, pointCount]( std::size_t s ) -> std::size_t {
+        return s + 1 < shapeCount ? batch.shapeBegin[s + 1] : pointCount;
+    };
+    for ( std::size_t s = 0; s < shapeCount; ++s ) {
+        const double tx = batch.shapeTx[s];
+        const double ty = batch.shapeTy[s];
+        const std::size_t begin = batch.shapeBegin[s];
+        const std::size_t end = shapeEnd( s );
+        const double* sx = batch.shapeX.data();
+        const double* sy = batch.shapeY.data();
+        double* px = batch.pointX.data();
+        double* py = batch.pointY.data();
+        for ( std::size_t p = begin; p < end; ++p ) {
+            px[p] = sx[p] + tx;
+            py[p] = sy[p] + ty;
+        }
+        Box box{ tx, ty, tx, ty };
+        if ( end > begin ) {
+            box = Box{ px[begin], py[begin], px[begin], py[begin] };
+            for ( std::size_t p = begin + 1; p < end; ++p ) {
+                box.left = px[p] < box.left ? px[p] : box.left;
+                box.right = px[p] > box.right ? px[p] : box.right;
+                box.top = py[p] < box.top ? py[p] : box.top;
+                box.bottom = py[p] > box.bottom ? py[p] : box.bottom;
+            }
+        }
+        batch.shapeBox[s] = box;
+    }
+
+    const std::size_t edgeCount = batch.getEdgeCount();
+    for ( auto output : { &batch.p1X, &batch.p1Y, &batch.p2X, &batch.p2Y,
+                          &batch.c1X, &batch.c1Y, &batch.c2X, &batch.c2Y, &batch.dstAngle } )
+        output->assign( edgeCount, 0. );
+    batch.hidden.assign( edgeCount, 0 );
+
+    auto hits = [&batch, &shapeEnd]( std::size_t s, double ax, double ay, double dx, double dy ) -> impl::SegmentHits {
+        const std::size_t begin = batch.shapeBegin[s];
+        return impl::segmentHits( batch.pointX.data() + begin, batch.pointY.data() + begin,
+                                  shapeEnd( s ) - begin, ax, ay, dx, dy );
+    };
+    for ( std::size_t e = 0; e < edgeCount; ++e ) {
+        const std::size_t src = batch.edgeSrc[e];
+        const std::size_t dst = batch.edgeDst[e];
+        const Box& srcBox = batch.shapeBox[src];
+        const Box& dstBox = batch.shapeBox[dst];
+        const double srcCx = ( srcBox.left + srcBox.right ) / 2.;
+        const double srcCy = ( srcBox.top + srcBox.bottom ) / 2.;
+        const double dstCx = ( dstBox.left + dstBox.right ) / 2.;
+        const double dstCy = ( dstBox.top + dstBox.bottom ) / 2.;
+
+        // Clip (src center, dst center) line on source and destination shapes
+        const double dx = dstCx - srcCx;
+        const double dy = dstCy - srcCy;
+        const auto srcHits = hits( src, srcCx, srcCy, dx, dy );
+        const auto dstHits = hits( dst, srcCx, srcCy, dx, dy );
+        const double t1 = srcHits.tMax >= 0. ? srcHits.tMax : 0.;
+        const double t2 = dstHits.tMin <= 1. ? dstHits.tMin : 1.;
+        double p1x = srcCx + t1 * dx;
+        double p1y = srcCy + t1 * dy;
+        double p2x = srcCx + t2 * dx;
+        double p2y = srcCy + t2 * dy;
+
+        // Hide edges shorter than their arrow or fully contained in src or dst
+        const double arrowSize = batch.edgeArrowSize[e];
+        const double arrowLength = arrowSize * 3.;
+        const double lineDx = p2x - p1x;
+        const double lineDy = p2y - p1y;
+        const double lineLength = std::sqrt( lineDx * lineDx + lineDy * lineDy );
+        const Box lineBox{ std::min( p1x, p2x ), std::min( p1y, p2y ), std::max( p1x, p2x ), std::max( p1y, p2y ) };
+        if ( lineLength < 2.0 + arrowLength ||
+             impl::boxContains( srcBox, lineBox ) ||
+             impl::boxContains( dstBox, lineBox ) ) {
+            batch.hidden[e] = 1;
+            continue;
+        }
+
+        static constexpr    double MinLength = 0.00001;
+        if ( !batch.edgeCurved[e] ) {
+            batch.dstAngle[e] = impl::lineAngle( lineDx, lineDy );
+            if ( lineLength > MinLength ) {     // Correct line dst point to take into account the arrow geometry
+                const double t = 1.0 - ( arrowLength / lineLength );
+                p2x = p1x + lineDx * t;
+                p2y = p1y + lineDy * t;
+            }
+        } else {
+            // Control points: around line center on line normal, bounded to ]0;40.], larger when line is long and
+            // small when line is either vertical or horizontal
+            const double distance = std::min( lineLength, std::min( std::abs( lineDx ) / 2., std::abs( lineDy ) / 2. ) );
+            const double controlPointDistance = std::max( 0.001, std::min( distance, 40. ) );
+            const double centerX = ( p1x + p2x ) / 2.;
+            const double centerY = ( p1y + p2y ) / 2.;
+            const double invert = ( lineDx > 0 && lineDy < 0 ) ||
+                                  ( lineDx < 0 && lineDy > 0 ) ? -1. : 1.;
+            const double normalX = -lineDy / ( lineLength * invert );
+            const double normalY = lineDx / ( lineLength * invert );
+            const double c1x = centerX + normalX * controlPointDistance;
+            const double c1y = centerY + normalY * controlPointDistance;
+            const double c2x = centerX - normalX * controlPointDistance;
+            const double c2y = centerY - normalY * controlPointDistance;
+            batch.c1X[e] = c1x;     batch.c1Y[e] = c1y;
+            batch.c2X[e] = c2x;     batch.c2Y[e] = c2y;
+
+            // Clip curve end points on (control point, shape center) lines
+            const auto c1Hits = hits( src, c1x, c1y, srcCx - c1x, srcCy - c1y );
+            const double tc1 = c1Hits.tMin <= 1. ? c1Hits.tMin : 0.;
+            p1x = c1x + tc1 * ( srcCx - c1x );
+            p1y = c1y + tc1 * ( srcCy - c1y );
+            const auto c2Hits = hits( dst, c2x, c2y, dstCx - c2x, dstCy - c2y );
+            const double tc2 = c2Hits.tMin <= 1. ? c2Hits.tMin : 0.;
+            p2x = c2x + tc2 * ( dstCx - c2x );
+            p2y = c2y + tc2 * ( dstCy - c2y );
+
+            // Arrow orientation: cubic tangent at curve end, averaged with line angle for short curves where
+            // tangent might be very sharp
+            static constexpr    double averageDstAngleFactor = 4.0;
+            const double curveAngle = impl::cubicCurveAngleAt( 0.99, p1x, p1y, p2x, p2y, c1x, c1y, c2x, c2y );
+            const double curveDx = p2x - p1x;
+            const double curveDy = p2y - p1y;
+            if ( std::sqrt( curveDx * curveDx + curveDy * curveDy ) > averageDstAngleFactor * arrowLength )
+                batch.dstAngle[e] = curveAngle;
+            else
+                batch.dstAngle[e] = 0.4 * curveAngle + 0.6 * impl::lineAngle( curveDx, curveDy );
+
+            // Move dst point toward c2 by arrow length
+            const double vx = c2x - p2x;
+            const double vy = c2y - p2y;
+            const double vLength = std::sqrt( vx * vx + vy * vy );
+            if ( vLength > MinLength ) {
+                p2x += vx / vLength * arrowLength;
+                p2y += vy / vLength * arrowLength;
+            }
+        }
+        batch.p1X[e] = p1x;     batch.p1Y[e] = p1y;
+        batch.p2X[e] = p2x;     batch.p2Y[e] = p2y;
+    }
+}
+//-----------------------------------------------------------------------------
+
+} // ::gtpo
@@ -0,0 +1,183 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoForceLayout.h
+// \author	benoit@destrat.io
+// \date	2017 12 22
+//-----------------------------------------------------------------------------
+
+#ifndef gtpoForceLayout_h
+#define gtpoForceLayout_h
+
+// STD headers
+#include <cstddef>          // std::size_t
+#include <cstdint>          // std::uint8_t std::uint32_t
+#include <memory>           // std::unique_ptr
+#include <vector>
+
+// GTpo headers
+#include "./gtpoUtils.h"
+
+namespace gtpo { // ::gtpo
+
+/*! \brief Fruchterman-Reingold force directed layout with a Barnes-Hut quadtree approximation of repulsive forces.
+ *
+ * Layout works on a structure of arrays snapshot of a graph topology and does not reference any graph
+ * primitive, it could then be run in a worker thread while the original graph is still edited. Node
+ * positions are node centers, and are updated in place in \c x and \c y by every step() call.
+ *
+ * \code
+ *   gtpo::ForceLayout layout;
+ *   const auto a = layout.addNode( 0., 0. );
+ *   const auto b = layout.addNode( 10., 5., true );    // b is pinned and will not move
+ *   layout.addEdge( a, b );
+ *   while ( layout.step() )
+ *      ;   // Read layout.x and layout.y
+ * \endcode
+ *
+ * Repulsive forces are computed in parallel for every node on \c threadCount threads (threads are created once
+ * and reused by following step() calls), at each step a quadtree
+ * is built over node positions and groups of nodes seen under an angle lower than \c theta are approximated
+ * by their center of mass: complexity is O(n.log(n)) instead of O(n²). Displacement of every node is bounded
+ * by a temperature cooled down by \c cooling at each step, layout has converged when temperature fall
+ * under \c minTemperature. For incremental layouts (ie after a few nodes have been inserted in an existing
+ * layout), use a low initial temperature with setTemperature() to preserve user mental map.
+ * \nosubgrouping
+ */
+class ForceLayout
+{
+    /*! \name ForceLayout Object Management *///-------------------------------
+    //@{
+public:
+    ForceLayout() noexcept = default;
+    ~ForceLayout() = default;
+    ForceLayout( const ForceLayout& ) = delete;
+    ForceLayout& operator=( const ForceLayout& ) = delete;
+
+    //! Remove all nodes and edges, allocated memory is kept for the next layout.
+    auto            clear() noexcept -> void;
+    inline auto     getNodeCount() const noexcept -> std::size_t { return x.size(); }
+    inline auto     getEdgeCount() const noexcept -> std::size_t { return edgeSrc.size(); }
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Layout Topology *///---------------------------------------------
+    //@{
+public:
+    //! Add a node centered on (\c x, \c y) and return its index, a \c pinned node is never moved by the layout.
+    auto            addNode( double x, double y, bool pinned = false ) -> std::size_t;
+    /*! \brief Add an edge from node \c src to node \c dst and return its index.
+     *
+     * Edge attraction is multiplied by \c weight, self loops are ignored.
+     * \throw gtpo::bad_topology_error if \c src or \c dst is not a valid node index.
+     */
+    auto            addEdge( std::size_t src, std::size_t dst, double weight = 1. ) noexcept( false ) -> std::size_t;
+
+public:
+    //! Nodes center position, updated by step().
+    std::vector<double>         x, y;
+    //! Set to 1 for nodes that should not be moved, pinned nodes still repulse and attract other nodes.
+    std::vector<std::uint8_t>   pinned;
+
+    std::vector<std::uint32_t>  edgeSrc, edgeDst;
+    std::vector<double>         edgeWeight;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Layout Configuration *///----------------------------------------
+    //@{
+public:
+    //! Ideal distance between two connected nodes (FR \c k constant, default to 100.).
+    double          idealLength{ 100. };
+    //! Barnes-Hut opening angle, 0. compute exact repulsive forces (default to 0.9).
+    double          theta{ 0.9 };
+    //! Attraction of every node to layout center of mass, avoid disconnected components drifting away (default to 0.05).
+    double          gravity{ 0.05 };
+    //! Temperature multiplier applied after each step (default to 0.95).
+    double          cooling{ 0.95 };
+    //! Temperature under which layout is considered converged (default to 0.5).
+    double          minTemperature{ 0.5 };
+    //! Number of threads used to compute repulsive forces, 0 to use all available hardware threads (default to 0).
+    unsigned int    threadCount{ 0 };
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Layout Computation *///------------------------------------------
+    //@{
+public:
+    //! Maximum displacement allowed for a node during next step().
+    inline auto     getTemperature() const noexcept -> double { return _temperature; }
+    //! Set current temperature, use a high temperature for an initial layout, a low one for an incremental layout.
+    inline auto     setTemperature( double temperature ) noexcept -> void { _temperature = temperature; }
+    //! Return true when temperature has fallen under \c minTemperature.
+    inline auto     isConverged() const noexcept -> bool { return _temperature < minTemperature; }
+
+    /*! \brief Run one layout iteration: move every non pinned node and cool down temperature.
+     *
+     * \return false once layout has converged (calling step() on a converged layout has no effect).
+     */
+    auto            step() -> bool;
+
+private:
+    //! Quadtree cell, children cells are stored consecutively from \c child, leaves have a null \c child.
+    struct Cell {
+        double          cx{ 0. }, cy{ 0. };     // Center of mass
+        double          mass{ 0. };
+        double          size{ 0. };
+        std::uint32_t   child{ 0 };
+        std::uint32_t   begin{ 0 }, end{ 0 };   // Leaves nodes range in _order
+    };
+    //! Maximum number of nodes in a leaf cell, interactions inside a leaf are computed exactly.
+    static constexpr std::size_t    LeafCapacity = 8;
+    //! Maximum quadtree depth (coincident nodes are kept in a single leaf).
+    static constexpr int            MaxDepth = 24;
+
+    auto            buildTree() -> void;
+    auto            buildCell( std::size_t c, std::size_t begin, std::size_t end,
+                               double ox, double oy, double half, int depth ) -> void;
+    //! Compute repulsive forces for nodes [\c begin, \c end).
+    auto            repulse( std::size_t begin, std::size_t end ) noexcept -> void;
+
+private:
+    double                      _temperature{ 100. };
+    std::vector<Cell>           _cells;
+    std::vector<std::uint32_t>  _order;
+    std::vector<double>         _fx, _fy;
+    //! Repulsion worker threads, created on first concurrent step() and kept alive until layout destruction.
+    std::unique_ptr<ThreadPool> _pool;
+    //@}
+    //-------------------------------------------------------------------------
+};
+
+} // ::gtpo
+
+#include "./gtpoForceLayout.hpp"
+
+#endif // gtpoForceLayout_h
+
@@ -0,0 +1,246 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoForceLayout.hpp
+// \author	benoit@destrat.io
+// \date	2017 12 22
+//-----------------------------------------------------------------------------
+
+// STD headers
+#include <algorithm>    // std::partition std::min std::max
+#include <cmath>        // std::sqrt
+
+namespace gtpo { // ::gtpo
+
+/* ForceLayout Object Management *///------------------------------------------
+inline auto ForceLayout::clear() noexcept -> void
+{
+    x.clear();          y.clear();
+    pinned.clear();
+    edgeSrc.clear();    edgeDst.clear();
+    edgeWeight.clear();
+}
+//-----------------------------------------------------------------------------
+
+/* Layout Topology *///--------------------------------------------------------
+inline auto ForceLayout::addNode( double nx, double ny, bool isPinned ) -> std::size_t
+{
+    x.push_back( nx );
+    y.push_back( ny );
+    pinned.push_back( isPinned ? 1 : 0 );
+    return x.size() - 1;
+}
+
+inline auto ForceLayout::addEdge( std::size_t src, std::size_t dst, double weight ) noexcept( false ) -> std::size_t
+{
+    gtpo::assert_throw( src < getNodeCount() && dst < getNodeCount(),
+                        "gtpo::ForceLayout::addEdge(): Error: invalid source or destination node index." );
+    edgeSrc.push_back( static_cast<std::uint32_t>( src ) );
+    edgeDst.push_back( static_cast<std::uint32_t>( dst ) );
+    edgeWeight.push_back( weight );
+    return edgeSrc.size() - 1;
+}
+//-----------------------------------------------------------------------------
+
+/* Layout Computation *///-----------------------------------------------------
+inline auto ForceLayout::step() -> bool
+{
+    const auto nodeCount = getNodeCount();
+    if ( isConverged() )
+        return false;
+    if ( nodeCount == 0 ) {
+        _temperature = 0.;
+        return false;
+    }
+    _fx.assign( nodeCount, 0. );
+    _fy.assign( nodeCount, 0. );
+
+    // Repulsive forces: Barnes-Hut approximation, nodes are splitted in chunks computed concurrently
+    buildTree();
+    constexpr std::size_t minChunkSize = 1024;
+    const auto threads = gtpo::resolveThreadCount( threadCount );
+    const auto chunkCount = std::min<std::size_t>( threads, ( nodeCount + minChunkSize - 1 ) / minChunkSize );
+    if ( chunkCount <= 1 )
+        repulse( 0, nodeCount );
+    else {
+        if ( !_pool || _pool->getThreadCount() != threads )
+            _pool = std::make_unique<ThreadPool>( threads );
+        const auto chunkSize = ( nodeCount + chunkCount - 1 ) / chunkCount;
+        _pool->parallelFor( chunkCount, [this, chunkSize, nodeCount]( std::size_t c, unsigned int ) {
+            repulse( std::min( nodeCount, c * chunkSize ), std::min( nodeCount, ( c + 1 ) * chunkSize ) );
+        } );
+    }
+
+    // Attractive forces: d² / k along edges
+    const double k = idealLength;
+    for ( std::size_t e = 0; e < edgeSrc.size(); ++e ) {
+        const auto s = edgeSrc[e];
+        const auto d = edgeDst[e];
+        const double dx = x[d] - x[s];
+        const double dy = y[d] - y[s];
+        const double f = std::sqrt( dx * dx + dy * dy ) * edgeWeight[e] / k;
+        _fx[s] += dx * f;   _fy[s] += dy * f;
+        _fx[d] -= dx * f;   _fy[d] -= dy * f;
+    }
+
+    // Gravity to the root cell center of mass, then move nodes by at most temperature
+    const double gx = _cells[0].cx;
+    const double gy = _cells[0].cy;
+    const double t = _temperature;
+    for ( std::size_t n = 0; n < nodeCount; ++n ) {
+        const double fx = _fx[n] + ( gx - x[n] ) * gravity;
+        const double fy = _fy[n] + ( gy - y[n] ) * gravity;
+        const double f = std::sqrt( fx * fx + fy * fy );
+        const double displacement = f > 0. && pinned[n] == 0 ? std::min( f, t ) / f : 0.;
+        x[n] += fx * displacement;
+        y[n] += fy * displacement;
+    }
+    _temperature *= cooling;
+    return !isConverged();
+}
+
+inline auto ForceLayout::buildTree() -> void
+{
+    const auto nodeCount = getNodeCount();
+    _order.resize( nodeCount );
+    for ( std::size_t n = 0; n < nodeCount; ++n )
+        _order[n] = static_cast<std::uint32_t>( n );
+    const auto xBounds = std::minmax_element( x.cbegin(), x.cend() );
+    const auto yBounds = std::minmax_element( y.cbegin(), y.cend() );
+    const double half = std::max( 1., std::max( *xBounds.second - *xBounds.first,
+                                                *yBounds.second - *yBounds.first ) / 2. );
+    _cells.clear();
+    _cells.emplace_back();
+    buildCell( 0, 0, nodeCount,
+               ( *xBounds.first + *xBounds.second ) / 2., ( *yBounds.first + *yBounds.second ) / 2.,
+               half, 0 );
+}
+
+inline auto ForceLayout::buildCell( std::size_t c, std::size_t begin, std::size_t end,
+                                    double ox, double oy, double half, int depth ) -> void
+{
+    Cell cell;
+    cell.size = half * 2.;
+    if ( end - begin <= LeafCapacity ||
+         depth >= MaxDepth ) {
+        cell.begin = static_cast<std::uint32_t>( begin );
+        cell.end = static_cast<std::uint32_t>( end );
+        for ( auto n = begin; n < end; ++n ) {
+            cell.cx += x[_order[n]];
+            cell.cy += y[_order[n]];
+        }
+        cell.mass = static_cast<double>( end - begin );
+        if ( cell.mass > 0. ) {
+            cell.cx /= cell.mass;
+            cell.cy /= cell.mass;
+        }
+        _cells[c] = cell;
+        return;
+    }
+
+    // Split nodes in quadrants: (left, top), (right, top), (left, bottom), (right, bottom)
+    const auto first = _order.begin() + static_cast<std::ptrdiff_t>( begin );
+    const auto last = _order.begin() + static_cast<std::ptrdiff_t>( end );
+    const auto bottom = std::partition( first, last, [this, oy]( std::uint32_t n ) { return y[n] < oy; } );
+    const auto topRight = std::partition( first, bottom, [this, ox]( std::uint32_t n ) { return x[n] < ox; } );
+    const auto bottomRight = std::partition( bottom, last, [this, ox]( std::uint32_t n ) { return x[n] < ox; } );
+    const std::size_t bounds[5] = { begin,
+                                    static_cast<std::size_t>( topRight - _order.begin() ),
+                                    static_cast<std::size_t>( bottom - _order.begin() ),
+                                    static_cast<std::size_t>( bottomRight - _order.begin() ),
+                                    end };
+    cell.child = static_cast<std::uint32_t>( _cells.size() );
+    _cells.resize( _cells.size() + 4 );     // Note: invalidate references on _cells
+    const double h = half / 2.;
+    for ( std::size_t q = 0; q < 4; ++q )
+        buildCell( cell.child + q, bounds[q], bounds[q + 1],
+                   ( q % 2 ) == 0 ? ox - h : ox + h, q < 2 ? oy - h : oy + h,
+                   h, depth + 1 );
+    for ( std::size_t q = 0; q < 4; ++q ) {
+        const auto& child = _cells[cell.child + q];
+        cell.cx += child.cx * child.mass;
+        cell.cy += child.cy * child.mass;
+        cell.mass += child.mass;
+    }
+    cell.cx /= cell.mass;
+    cell.cy /= cell.mass;
+    _cells[c] = cell;
+}
+
+inline auto ForceLayout::repulse( std::size_t begin, std::size_t end ) noexcept -> void
+{
+    const double k2 = idealLength * idealLength;
+    const double theta2 = theta * theta;
+    std::vector<std::uint32_t> stack;
+    stack.reserve( 4 * MaxDepth + 4 );
+    for ( auto n = begin; n < end; ++n ) {
+        const double px = x[n];
+        const double py = y[n];
+        double fx = 0., fy = 0.;
+        stack.clear();
+        stack.push_back( 0 );
+        while ( !stack.empty() ) {
+            const auto& cell = _cells[stack.back()];
+            stack.pop_back();
+            if ( cell.mass <= 0. )
+                continue;
+            if ( cell.child == 0 ) {        // Leaf: exact interactions
+                for ( auto o = cell.begin; o < cell.end; ++o ) {
+                    const auto m = _order[o];
+                    if ( m == n )
+                        continue;
+                    double dx = px - x[m];
+                    double dy = py - y[m];
+                    if ( dx == 0. && dy == 0. )     // Coincident nodes, separate them deterministically
+                        dx = m < n ? 0.01 : -0.01;
+                    const double f = k2 / std::max( dx * dx + dy * dy, 1e-4 );
+                    fx += dx * f;
+                    fy += dy * f;
+                }
+                continue;
+            }
+            const double dx = px - cell.cx;
+            const double dy = py - cell.cy;
+            const double d2 = dx * dx + dy * dy;
+            if ( cell.size * cell.size < theta2 * d2 ) {    // Far enough: approximate cell with its center of mass
+                const double f = k2 * cell.mass / d2;
+                fx += dx * f;
+                fy += dy * f;
+            } else
+                for ( std::uint32_t q = 0; q < 4; ++q )
+                    stack.push_back( cell.child + q );
+        }
+        _fx[n] += fx;
+        _fy[n] += fy;
+    }
+}
+//-----------------------------------------------------------------------------
+
+} // ::gtpo
+
@@ -0,0 +1,111 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoGexfSerializer.h
+// \author	benoit@destrat.io
+// \date	2017 12 04
+//-----------------------------------------------------------------------------
+
+#ifndef gtpoGexfSerializer_h
+#define gtpoGexfSerializer_h
+
+// GTpo headers
+#include "./gtpoXmlSerializer.h"
+
+namespace gtpo { // ::gtpo
+
+/*! \brief Streaming Gephi GEXF reader.
+ *
+ * Read nodes and edges from a GEXF file without building a DOM, see gtpo::InXmlSerializer for
+ * memory usage and customization. Hierarchical nodes (\c nodes sub element of a \c node) are
+ * flattened, node attributes and \c viz extensions are ignored by default.
+ *
+ * \code
+ *  gtpo::GenGraph<> g;
+ *  gtpo::InGexfSerializer<> gexfIn{ "graph.gexf" };
+ *  gexfIn.serializeIn( g );
+ * \endcode
+ */
+template < class Config = GraphConfig >
+class InGexfSerializer : public InXmlSerializer< Config >
+{
+public:
+    explicit InGexfSerializer( const std::string& fileName ) noexcept( false ) :
+        InXmlSerializer< Config >{ fileName, "gexf" } { }
+    explicit InGexfSerializer( std::istream& input ) noexcept :
+        InXmlSerializer< Config >{ input, "gexf" } { }
+    virtual ~InGexfSerializer() noexcept = default;
+    InGexfSerializer( const InGexfSerializer& ) = delete;
+};
+
+/*! \brief Streaming Gephi GEXF (1.2) writer.
+ *
+ * A GEXF document contains a single graph: serializeOut() could be called only once, then
+ * finishOut() must be called to close the document.
+ */
+template < class Config = GraphConfig >
+class OutGexfSerializer : public OutXmlSerializer< Config >
+{
+public:
+    using Graph = typename OutXmlSerializer< Config >::Graph;
+
+    explicit OutGexfSerializer( const std::string& fileName ) noexcept( false ) :
+        OutXmlSerializer< Config >{ fileName } { }
+    explicit OutGexfSerializer( std::ostream& output ) noexcept( false ) :
+        OutXmlSerializer< Config >{ output } { }
+    virtual ~OutGexfSerializer() noexcept = default;
+    OutGexfSerializer( const OutGexfSerializer& ) = delete;
+
+public:
+    /*! \brief Write \c graph in GEXF format.
+     *
+     * \throw gtpo::bad_serialization_error if a graph has already been serialized or if output can't be written.
+     */
+    virtual auto    serializeOut( const Graph& graph, IProgressNotifier* progress = nullptr ) noexcept( false ) -> void override;
+    virtual auto    finishOut() noexcept( false ) -> void override;
+
+protected:
+    virtual auto    beginNodes() noexcept( false ) -> void override { this->getXml().writeStartElement( "nodes" ); }
+    virtual auto    endNodes() noexcept( false ) -> void override { this->getXml().writeEndElement(); }
+    virtual auto    beginEdges() noexcept( false ) -> void override { this->getXml().writeStartElement( "edges" ); }
+    virtual auto    endEdges() noexcept( false ) -> void override { this->getXml().writeEndElement(); }
+
+private:
+    //! Write the GEXF document header (only once).
+    auto            startDocument() noexcept( false ) -> void;
+    bool            _documentStarted = false;
+    bool            _graphSerialized = false;
+};
+
+} // ::gtpo
+
+#include "./gtpoGexfSerializer.hpp"
+
+#endif // gtpoGexfSerializer_h
+
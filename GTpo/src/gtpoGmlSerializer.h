@@ -0,0 +1,109 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoGmlSerializer.h
+// \author	benoit@destrat.io
+// \date	2017 12 04
+//-----------------------------------------------------------------------------
+
+#ifndef gtpoGmlSerializer_h
+#define gtpoGmlSerializer_h
+
+// GTpo headers
+#include "./gtpoXmlSerializer.h"
+
+namespace gtpo { // ::gtpo
+
+/*! \brief Streaming GraphML reader.
+ *
+ * Read nodes and edges from a GraphML file (as produced by yEd or Gephi) without building a DOM,
+ * see gtpo::InXmlSerializer for memory usage and customization. GraphML \c data elements are
+ * ignored by default, override readNode() and readEdge() to read them.
+ *
+ * \code
+ *  gtpo::GenGraph<> g;
+ *  try {
+ *    gtpo::InGmlSerializer<> gmlIn{ "graph.graphml" };
+ *    gmlIn.serializeIn( g );
+ *  } catch ( const gtpo::bad_serialization_error& e ) { std::cerr << e.what() << std::endl; }
+ * \endcode
+ */
+template < class Config = GraphConfig >
+class InGmlSerializer : public InXmlSerializer< Config >
+{
+public:
+    explicit InGmlSerializer( const std::string& fileName ) noexcept( false ) :
+        InXmlSerializer< Config >{ fileName, "graphml" } { }
+    explicit InGmlSerializer( std::istream& input ) noexcept :
+        InXmlSerializer< Config >{ input, "graphml" } { }
+    virtual ~InGmlSerializer() noexcept = default;
+    InGmlSerializer( const InGmlSerializer& ) = delete;
+};
+
+/*! \brief Streaming GraphML writer.
+ *
+ * Every serializeOut() call write a GraphML \c graph element, call finishOut() once all graphs
+ * have been written to close the GraphML document.
+ *
+ * \code
+ *  gtpo::OutGmlSerializer<> gmlOut{ "graph.graphml" };
+ *  gmlOut.serializeOut( g );
+ *  gmlOut.finishOut();
+ * \endcode
+ */
+template < class Config = GraphConfig >
+class OutGmlSerializer : public OutXmlSerializer< Config >
+{
+public:
+    using Graph = typename OutXmlSerializer< Config >::Graph;
+
+    explicit OutGmlSerializer( const std::string& fileName ) noexcept( false ) :
+        OutXmlSerializer< Config >{ fileName } { }
+    explicit OutGmlSerializer( std::ostream& output ) noexcept( false ) :
+        OutXmlSerializer< Config >{ output } { }
+    virtual ~OutGmlSerializer() noexcept = default;
+    OutGmlSerializer( const OutGmlSerializer& ) = delete;
+
+public:
+    virtual auto    serializeOut( const Graph& graph, IProgressNotifier* progress = nullptr ) noexcept( false ) -> void override;
+    virtual auto    finishOut() noexcept( false ) -> void override;
+
+private:
+    //! Write the GraphML document header (only once).
+    auto            startDocument() noexcept( false ) -> void;
+    bool            _documentStarted = false;
+    std::size_t     _graphCount = 0;
+};
+
+} // ::gtpo
+
+#include "./gtpoGmlSerializer.hpp"
+
+#endif // gtpoGmlSerializer_h
+
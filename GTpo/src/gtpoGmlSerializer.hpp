@@ -0,0 +1,74 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoGmlSerializer.hpp
+// \author	benoit@destrat.io
+// \date	2017 12 04
+//-----------------------------------------------------------------------------
+
+namespace gtpo { // ::gtpo
+
+/* OutGmlSerializer Serialization Management *///-----------------------------
+template < class Config >
+auto    OutGmlSerializer< Config >::serializeOut( const Graph& graph, IProgressNotifier* progress ) -> void
+{
+    startDocument();
+    auto& xml = this->getXml();
+    std::string graphId;
+    this->formatId( graphId, 'G', _graphCount++ );
+    xml.writeStartElement( "graph" );
+    xml.writeAttribute( "id", graphId );
+    xml.writeAttribute( "edgedefault", "directed" );
+    this->serializeTopology( graph, progress );
+    xml.writeEndElement();
+}
+
+template < class Config >
+auto    OutGmlSerializer< Config >::finishOut() -> void
+{
+    startDocument();    // Ensure an empty but valid document is written even if no graph has been serialized
+    OutXmlSerializer< Config >::finishOut();
+}
+
+template < class Config >
+auto    OutGmlSerializer< Config >::startDocument() -> void
+{
+    if ( _documentStarted )
+        return;
+    _documentStarted = true;
+    auto& xml = this->getXml();
+    xml.writeStartDocument();
+    xml.writeStartElement( "graphml" );
+    xml.writeAttribute( "xmlns", "http://graphml.graphdrawing.org/xmlns" );
+    xml.writeAttribute( "xmlns:xsi", "http://www.w3.org/2001/XMLSchema-instance" );
+    xml.writeAttribute( "xsi:schemaLocation", "http://graphml.graphdrawing.org/xmlns http://graphml.graphdrawing.org/xmlns/1.0/graphml.xsd" );
+}
+//-----------------------------------------------------------------------------
+
+} // ::gtpo
@@ -105,6 +105,10 @@ public:
     inline auto     addGraphBehaviour( std::unique_ptr<Behaviour> behaviour ) -> void {
         Behaviourable<Behaviour, SBehaviours>::addBehaviour(std::move(behaviour));
     }
+    //! \copydoc gtpo::Behaviourable::removeBehaviour()
+    inline auto     removeGraphBehaviour( const Behaviour* behaviour ) -> bool {
+        return Behaviourable<Behaviour, SBehaviours>::removeBehaviour(behaviour);
+    }
 
     template < class Node >
     auto    notifyNodeInserted( Node& node ) noexcept -> void;
@@ -0,0 +1,236 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoIncrementalLayout.h
+// \author	benoit@destrat.io
+// \date	2017 12 28
+//-----------------------------------------------------------------------------
+
+#ifndef gtpoIncrementalLayout_h
+#define gtpoIncrementalLayout_h
+
+// STD headers
+#include <cstddef>          // std::size_t
+#include <cstdint>          // std::uint8_t std::uint32_t
+#include <limits>
+#include <vector>
+
+// GTpo headers
+#include "./gtpoUtils.h"
+#include "./gtpoSpatialIndex.h"
+
+namespace gtpo { // ::gtpo
+
+/*! \brief Incremental, stability preserving layout of a graph modified by small edits.
+ *
+ * Layout keeps a persistent copy of the graph topology and nodes geometry: nodes and edges have stable indexes
+ * (indexes of removed elements are reused), nodes boxes are stored in a gtpo::SpatialIndex. Every topology
+ * modification mark the modified nodes (or the neighbours of a removed node) as dirty, relayout() then only
+ * re-optimize the \c hops neighbourhood of dirty nodes (at most \c maxNodes nodes), all other nodes stay fixed.
+ *
+ * Neighbourhood is optimized with a local force directed algorithm: movable nodes are attracted by their
+ * neighbours (fixed or not), repulsed by the nodes found around them in the spatial index, pushed out of
+ * overlapping boxes and pulled back to their previous position by a \c stability spring. Newly inserted nodes
+ * are initially placed at the barycenter of their already placed neighbours. Since the amount of work only
+ * depends on the neighbourhood size (and on local density), relayout() cost is independent of the graph size,
+ * optimization also stops when \c timeBudget is exhausted.
+ *
+ * \code
+ *   gtpo::IncrementalLayout layout;
+ *   const auto a = layout.addNode( 100., 50., 0., 0., false );      // Existing, already placed nodes
+ *   const auto b = layout.addNode( 100., 50., 400., 0., false );
+ *   const auto c = layout.addNode( 100., 50. );
+ *   layout.addEdge( a, c );
+ *   layout.addEdge( b, c );
+ *   layout.relayout();                // c is placed between a and b, modified centers are in layout.x and layout.y
+ * \endcode
+ * \nosubgrouping
+ */
+class IncrementalLayout
+{
+    /*! \name IncrementalLayout Object Management *///-------------------------
+    //@{
+public:
+    IncrementalLayout() noexcept = default;
+    ~IncrementalLayout() = default;
+    IncrementalLayout( const IncrementalLayout& ) = delete;
+    IncrementalLayout& operator=( const IncrementalLayout& ) = delete;
+
+    //! Remove all nodes and edges.
+    auto            clear() noexcept -> void;
+    //! Number of (non removed) nodes.
+    inline auto     getNodeCount() const noexcept -> std::size_t { return x.size() - _freeNodes.size(); }
+    //! Number of (non removed) edges.
+    inline auto     getEdgeCount() const noexcept -> std::size_t { return _edgeSrc.size() - _freeEdges.size(); }
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Layout Topology *///---------------------------------------------
+    //@{
+public:
+    enum : std::uint32_t { NoIndex = std::numeric_limits<std::uint32_t>::max() };
+
+    /*! \brief Add a node of size (\c width, \c height) centered on (\c x, \c y) and return its index.
+     *
+     * Node is marked dirty, it will be placed near its neighbours on next relayout(). Set \c dirty to false when
+     * loading an existing layout: node is then considered already placed and is not modified.
+     */
+    auto            addNode( double width, double height, double x = 0., double y = 0.,
+                             bool dirty = true ) -> std::uint32_t;
+    /*! \brief Remove node \c node and its adjacent edges, node neighbours are marked dirty.
+     *
+     * \throw gtpo::bad_topology_error if \c node is not a valid node index.
+     */
+    auto            removeNode( std::uint32_t node ) noexcept( false ) -> void;
+    /*! \brief Add an edge between \c src and \c dst and return its index, \c src and \c dst are marked dirty unless \c dirty is false.
+     *
+     * \throw gtpo::bad_topology_error if \c src or \c dst is not a valid node index.
+     */
+    auto            addEdge( std::uint32_t src, std::uint32_t dst, bool dirty = true ) noexcept( false ) -> std::uint32_t;
+    /*! \brief Remove edge \c edge, its source and destination are marked dirty.
+     *
+     * \throw gtpo::bad_topology_error if \c edge is not a valid edge index.
+     */
+    auto            removeEdge( std::uint32_t edge ) noexcept( false ) -> void;
+
+    //! Return true if \c node is a valid (non removed) node index.
+    inline auto     isNode( std::uint32_t node ) const noexcept -> bool { return node < _alive.size() && _alive[ node ] != 0; }
+    //! Return true if \c edge is a valid (non removed) edge index.
+    inline auto     isEdge( std::uint32_t edge ) const noexcept -> bool { return edge < _edgeSrc.size() && _edgeSrc[ edge ] != NoIndex; }
+
+    /*! \brief Set \c node actual size and center (when node has been moved or resized outside of this layout).
+     *
+     * Node is not marked dirty.
+     * \throw gtpo::bad_topology_error if \c node is not a valid node index.
+     */
+    auto            setGeometry( std::uint32_t node, double width, double height,
+                                 double x, double y ) noexcept( false ) -> void;
+    /*! \brief Mark \c node dirty, its neighbourhood will be optimized on next relayout().
+     *
+     * \throw gtpo::bad_topology_error if \c node is not a valid node index.
+     */
+    auto            markDirty( std::uint32_t node ) noexcept( false ) -> void;
+    //! Return true if some nodes are dirty.
+    inline auto     hasDirtyNodes() const noexcept -> bool { return !_dirty.empty(); }
+
+public:
+    //! Nodes center positions and sizes, indexed by node index (modify with setGeometry()).
+    std::vector<double>         x, y, width, height;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Layout Configuration *///----------------------------------------
+    //@{
+public:
+    //! Maximum graph distance between a dirty node and an optimized node (default to 2).
+    unsigned int    hops{ 2 };
+    //! Maximum number of optimized nodes in one relayout(), remaining dirty nodes are kept for next call (default to 256).
+    std::size_t     maxNodes{ 256 };
+    //! Ideal distance between two adjacent nodes centers (default to 150.).
+    double          idealEdgeLength{ 150. };
+    //! Strength of the spring pulling an already placed node back to its previous position (default to 0.3).
+    double          stability{ 0.3 };
+    //! Minimum space between two nodes boxes (default to 20.).
+    double          nodeSpacing{ 20. };
+    //! Maximum number of optimization iterations (default to 60).
+    std::size_t     maxIterations{ 60 };
+    //! Maximum optimization duration in milliseconds (default to 8.).
+    double          timeBudget{ 8. };
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Layout Computation *///------------------------------------------
+    //@{
+public:
+    /*! \brief Collect the neighbourhood of dirty nodes and return the nodes that will be optimized.
+     *
+     * When nodes might have been moved externally, call setGeometry() between prepare() and optimize() to refresh
+     * returned nodes geometry, then the geometry of nodes in getRegion().
+     */
+    auto            prepare() -> const std::vector<std::uint32_t>&;
+    //! Return an area containing all nodes that might interact with prepared nodes already placed (an empty box if there is none).
+    auto            getRegion() const noexcept -> Box;
+    /*! \brief Optimize prepared nodes positions, return the number of iterations run.
+     *
+     * Newly inserted nodes are first placed at their placed neighbours barycenter.
+     */
+    auto            optimize() -> std::size_t;
+    //! Shortcut for prepare() then optimize(), return optimized nodes.
+    auto            relayout() -> const std::vector<std::uint32_t>&;
+
+    //! Nodes optimized by last prepare() and optimize() calls.
+    inline auto     getMovableNodes() const noexcept -> const std::vector<std::uint32_t>& { return _movable; }
+
+private:
+    //! Return \c node box in spatial index.
+    inline auto     nodeBox( std::uint32_t node ) const noexcept -> Box {
+        return Box::fromRect( x[ node ] - width[ node ] / 2., y[ node ] - height[ node ] / 2., width[ node ], height[ node ] );
+    }
+    //! Return the node on the other side of \c edge from \c node.
+    inline auto     opposite( std::uint32_t edge, std::uint32_t node ) const noexcept -> std::uint32_t {
+        return _edgeSrc[ edge ] == node ? _edgeDst[ edge ] : _edgeSrc[ edge ];
+    }
+    inline auto     assertNode( std::uint32_t node, const char* message ) const noexcept( false ) -> void {
+        gtpo::assert_throw( isNode( node ), message );
+    }
+
+private:
+    //! 0 for removed nodes.
+    std::vector<std::uint8_t>   _alive;
+    //! 1 for nodes that have never been placed.
+    std::vector<std::uint8_t>   _fresh;
+    //! Adjacent edges of every node.
+    std::vector<std::vector<std::uint32_t>> _adjacency;
+    std::vector<std::uint32_t>  _freeNodes;
+
+    //! Edges source and destination, NoIndex for removed edges.
+    std::vector<std::uint32_t>  _edgeSrc, _edgeDst;
+    std::vector<std::uint32_t>  _freeEdges;
+
+    SpatialIndex<std::uint32_t> _index;
+
+    std::vector<std::uint32_t>  _dirty;
+    //! Last traversal that visited a node (avoid clearing per node flags on every relayout()).
+    std::vector<std::uint32_t>  _visited;
+    std::uint32_t               _traversal{ 0 };
+
+    std::vector<std::uint32_t>  _movable;
+    //! Previous positions of movable nodes, \c _anchored is 0 for nodes that were fresh.
+    std::vector<double>         _anchorX, _anchorY;
+    std::vector<std::uint8_t>   _anchored;
+    std::vector<double>         _dx, _dy;
+    //@}
+    //-------------------------------------------------------------------------
+};
+
+} // ::gtpo
+
+#include "./gtpoIncrementalLayout.hpp"
+
+#endif // gtpoIncrementalLayout_h
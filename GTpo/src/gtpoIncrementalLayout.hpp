@@ -0,0 +1,361 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoIncrementalLayout.hpp
+// \author	benoit@destrat.io
+// \date	2017 12 28
+//-----------------------------------------------------------------------------
+
+// STD headers
+#include <algorithm>    // std::max std::min std::find
+#include <chrono>
+#include <cmath>        // std::sqrt std::abs std::cos std::sin
+
+namespace gtpo { // ::gtpo
+
+/* IncrementalLayout Object Management *///------------------------------------
+inline auto IncrementalLayout::clear() noexcept -> void
+{
+    x.clear();          y.clear();
+    width.clear();      height.clear();
+    _alive.clear();     _fresh.clear();
+    _adjacency.clear(); _freeNodes.clear();
+    _edgeSrc.clear();   _edgeDst.clear();
+    _freeEdges.clear();
+    _index.clear();
+    _dirty.clear();
+    _visited.clear();   _traversal = 0;
+    _movable.clear();
+}
+//-----------------------------------------------------------------------------
+
+/* Layout Topology *///--------------------------------------------------------
+inline auto IncrementalLayout::addNode( double nodeWidth, double nodeHeight, double nodeX, double nodeY,
+                                        bool dirty ) -> std::uint32_t
+{
+    std::uint32_t node = NoIndex;
+    if ( !_freeNodes.empty() ) {
+        node = _freeNodes.back();
+        _freeNodes.pop_back();
+        x[ node ] = nodeX;              y[ node ] = nodeY;
+        width[ node ] = nodeWidth;      height[ node ] = nodeHeight;
+        _alive[ node ] = 1;
+        _fresh[ node ] = dirty ? 1 : 0;
+        _adjacency[ node ].clear();
+        _visited[ node ] = 0;
+    } else {
+        node = static_cast<std::uint32_t>( x.size() );
+        x.push_back( nodeX );           y.push_back( nodeY );
+        width.push_back( nodeWidth );   height.push_back( nodeHeight );
+        _alive.push_back( 1 );
+        _fresh.push_back( dirty ? 1 : 0 );
+        _adjacency.emplace_back();
+        _visited.push_back( 0 );
+    }
+    _index.insert( node, nodeBox( node ) );
+    if ( dirty )
+        _dirty.push_back( node );
+    return node;
+}
+
+inline auto IncrementalLayout::removeNode( std::uint32_t node ) noexcept( false ) -> void
+{
+    assertNode( node, "gtpo::IncrementalLayout::removeNode(): Error: invalid node index." );
+    for ( const auto edge : _adjacency[ node ] ) {
+        const auto other = opposite( edge, node );
+        if ( other != node ) {
+            auto& adjacency = _adjacency[ other ];
+            adjacency.erase( std::find( adjacency.begin(), adjacency.end(), edge ) );
+            _dirty.push_back( other );
+        }
+        _edgeSrc[ edge ] = _edgeDst[ edge ] = NoIndex;
+        _freeEdges.push_back( edge );
+    }
+    _adjacency[ node ].clear();
+    _index.remove( node );
+    _alive[ node ] = 0;
+    _freeNodes.push_back( node );
+}
+
+inline auto IncrementalLayout::addEdge( std::uint32_t src, std::uint32_t dst, bool dirty ) noexcept( false ) -> std::uint32_t
+{
+    assertNode( src, "gtpo::IncrementalLayout::addEdge(): Error: invalid source node index." );
+    assertNode( dst, "gtpo::IncrementalLayout::addEdge(): Error: invalid destination node index." );
+    std::uint32_t edge = NoIndex;
+    if ( !_freeEdges.empty() ) {
+        edge = _freeEdges.back();
+        _freeEdges.pop_back();
+        _edgeSrc[ edge ] = src;
+        _edgeDst[ edge ] = dst;
+    } else {
+        edge = static_cast<std::uint32_t>( _edgeSrc.size() );
+        _edgeSrc.push_back( src );
+        _edgeDst.push_back( dst );
+    }
+    _adjacency[ src ].push_back( edge );
+    if ( dst != src )
+        _adjacency[ dst ].push_back( edge );
+    if ( dirty ) {
+        _dirty.push_back( src );
+        _dirty.push_back( dst );
+    }
+    return edge;
+}
+
+inline auto IncrementalLayout::removeEdge( std::uint32_t edge ) noexcept( false ) -> void
+{
+    gtpo::assert_throw( isEdge( edge ), "gtpo::IncrementalLayout::removeEdge(): Error: invalid edge index." );
+    for ( const auto node : { _edgeSrc[ edge ], _edgeDst[ edge ] } ) {
+        auto& adjacency = _adjacency[ node ];
+        const auto e = std::find( adjacency.begin(), adjacency.end(), edge );
+        if ( e != adjacency.end() )     // Self loops are referenced once
+            adjacency.erase( e );
+        _dirty.push_back( node );
+    }
+    _edgeSrc[ edge ] = _edgeDst[ edge ] = NoIndex;
+    _freeEdges.push_back( edge );
+}
+
+inline auto IncrementalLayout::setGeometry( std::uint32_t node, double nodeWidth, double nodeHeight,
+                                            double nodeX, double nodeY ) noexcept( false ) -> void
+{
+    assertNode( node, "gtpo::IncrementalLayout::setGeometry(): Error: invalid node index." );
+    x[ node ] = nodeX;              y[ node ] = nodeY;
+    width[ node ] = nodeWidth;      height[ node ] = nodeHeight;
+    _index.update( node, nodeBox( node ) );
+}
+
+inline auto IncrementalLayout::markDirty( std::uint32_t node ) noexcept( false ) -> void
+{
+    assertNode( node, "gtpo::IncrementalLayout::markDirty(): Error: invalid node index." );
+    _dirty.push_back( node );
+}
+//-----------------------------------------------------------------------------
+
+/* Layout Computation *///-----------------------------------------------------
+inline auto IncrementalLayout::prepare() -> const std::vector<std::uint32_t>&
+{
+    _movable.clear();
+    if ( ++_traversal == 0 ) {      // Stamps wrapped, reset visited flags
+        std::fill( _visited.begin(), _visited.end(), 0 );
+        _traversal = 1;
+    }
+    const auto capacity = std::max( maxNodes, std::size_t{ 1 } );
+
+    // Dirty nodes first, nodes that do not fit are kept dirty for next call
+    std::size_t d = 0;
+    for ( ; d < _dirty.size() && _movable.size() < capacity; ++d ) {
+        const auto node = _dirty[ d ];
+        if ( isNode( node ) && _visited[ node ] != _traversal ) {
+            _visited[ node ] = _traversal;
+            _movable.push_back( node );
+        }
+    }
+    _dirty.erase( _dirty.begin(), _dirty.begin() + static_cast<std::ptrdiff_t>( d ) );
+
+    // Level by level breadth first search up to hops
+    std::size_t levelBegin = 0;
+    for ( unsigned int hop = 0; hop < hops && _movable.size() < capacity; ++hop ) {
+        const auto levelEnd = _movable.size();
+        for ( auto m = levelBegin; m < levelEnd && _movable.size() < capacity; ++m ) {
+            const auto node = _movable[ m ];
+            for ( const auto edge : _adjacency[ node ] ) {
+                const auto other = opposite( edge, node );
+                if ( _visited[ other ] != _traversal ) {
+                    _visited[ other ] = _traversal;
+                    _movable.push_back( other );
+                    if ( _movable.size() >= capacity )
+                        break;
+                }
+            }
+        }
+        levelBegin = levelEnd;
+    }
+    return _movable;
+}
+
+inline auto IncrementalLayout::getRegion() const noexcept -> Box
+{
+    const double range = idealEdgeLength + nodeSpacing;
+    Box region;
+    bool empty = true;
+    for ( const auto node : _movable ) {
+        if ( _fresh[ node ] != 0 )      // Not placed yet
+            continue;
+        region = empty ? nodeBox( node ) : region.united( nodeBox( node ) );
+        empty = false;
+    }
+    if ( empty )
+        return Box{};
+    return Box{ region.left - range, region.top - range, region.right + range, region.bottom + range };
+}
+
+inline auto IncrementalLayout::optimize() -> std::size_t
+{
+    const auto count = _movable.size();
+    if ( count == 0 )
+        return 0;
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+
+    _anchorX.resize( count );   _anchorY.resize( count );
+    _anchored.resize( count );
+    for ( std::size_t m = 0; m < count; ++m ) {
+        const auto node = _movable[ m ];
+        _anchored[ m ] = _fresh[ node ] == 0 ? 1 : 0;
+    }
+
+    // Place fresh nodes at their placed neighbours barycenter, until no more fresh node could be placed
+    constexpr double goldenAngle = 2.39996322972865332;
+    for ( bool placed = true; placed; ) {
+        placed = false;
+        for ( std::size_t m = 0; m < count; ++m ) {
+            const auto node = _movable[ m ];
+            if ( _fresh[ node ] == 0 )
+                continue;
+            double cx = 0., cy = 0.;
+            std::size_t neighbours = 0;
+            for ( const auto edge : _adjacency[ node ] ) {
+                const auto other = opposite( edge, node );
+                if ( other != node && _fresh[ other ] == 0 ) {
+                    cx += x[ other ];
+                    cy += y[ other ];
+                    ++neighbours;
+                }
+            }
+            if ( neighbours == 0 )
+                continue;
+            // Move away from a single neighbour, slightly off the barycenter otherwise
+            const double radius = idealEdgeLength * ( neighbours == 1 ? 1. : 0.25 );
+            const double angle = goldenAngle * node;
+            x[ node ] = cx / neighbours + radius * std::cos( angle );
+            y[ node ] = cy / neighbours + radius * std::sin( angle );
+            _index.update( node, nodeBox( node ) );
+            _fresh[ node ] = 0;
+            placed = true;
+        }
+    }
+    for ( std::size_t m = 0; m < count; ++m ) {
+        const auto node = _movable[ m ];
+        _fresh[ node ] = 0;         // Nodes without placed neighbours keep their initial position
+        _anchorX[ m ] = x[ node ];
+        _anchorY[ m ] = y[ node ];
+    }
+
+    const double length = std::max( idealEdgeLength, 1. );
+    const double range = length + nodeSpacing;
+    const double spacing = std::max( nodeSpacing, 0. );
+    constexpr std::size_t maxRepulsed = 64;    // Bound repulsion work in dense areas
+
+    _dx.resize( count );    _dy.resize( count );
+    double temperature = length / 2.;
+    std::size_t iteration = 0;
+    for ( ; iteration < maxIterations; ++iteration ) {
+        if ( std::chrono::duration<double, std::milli>( Clock::now() - start ).count() >= timeBudget )
+            break;
+        for ( std::size_t m = 0; m < count; ++m ) {
+            const auto node = _movable[ m ];
+            const double nx = x[ node ], ny = y[ node ];
+            double fx = 0., fy = 0.;
+
+            // Attraction from neighbours, movable or fixed
+            for ( const auto edge : _adjacency[ node ] ) {
+                const auto other = opposite( edge, node );
+                if ( other == node )
+                    continue;
+                const double dx = x[ other ] - nx, dy = y[ other ] - ny;
+                const double distance = std::sqrt( dx * dx + dy * dy );
+                fx += dx * distance / length;
+                fy += dy * distance / length;
+            }
+
+            // Repulsion and overlap removal from nodes around
+            const auto box = nodeBox( node );
+            std::size_t repulsed = 0;
+            _index.visit( Box{ box.left - range, box.top - range, box.right + range, box.bottom + range },
+                          [&]( const std::uint32_t& other, const Box& ) -> bool {
+                if ( other == node )
+                    return true;
+                double dx = nx - x[ other ], dy = ny - y[ other ];
+                if ( dx == 0. && dy == 0. ) {       // Deterministic split of coincident nodes
+                    dx = node < other ? -0.5 : 0.5;
+                    dy = 0.;
+                }
+                const double squaredDistance = std::max( dx * dx + dy * dy, 0.01 );
+                fx += dx * length * length / squaredDistance;
+                fy += dy * length * length / squaredDistance;
+                const double overlapX = ( width[ node ] + width[ other ] ) / 2. + spacing - std::abs( dx );
+                const double overlapY = ( height[ node ] + height[ other ] ) / 2. + spacing - std::abs( dy );
+                if ( overlapX > 0. && overlapY > 0. ) {
+                    if ( overlapX < overlapY )
+                        fx += dx < 0. ? -overlapX : overlapX;
+                    else
+                        fy += dy < 0. ? -overlapY : overlapY;
+                }
+                return ++repulsed < maxRepulsed;
+            } );
+
+            // Stability spring to previous position
+            if ( _anchored[ m ] != 0 ) {
+                fx += ( _anchorX[ m ] - nx ) * stability;
+                fy += ( _anchorY[ m ] - ny ) * stability;
+            }
+
+            const double force = std::sqrt( fx * fx + fy * fy );
+            const double step = force > temperature ? temperature / force : 1.;
+            _dx[ m ] = fx * step;
+            _dy[ m ] = fy * step;
+        }
+
+        double maxStep = 0.;
+        for ( std::size_t m = 0; m < count; ++m ) {
+            const auto node = _movable[ m ];
+            x[ node ] += _dx[ m ];
+            y[ node ] += _dy[ m ];
+            _index.update( node, nodeBox( node ) );
+            maxStep = std::max( maxStep, std::abs( _dx[ m ] ) + std::abs( _dy[ m ] ) );
+        }
+        temperature *= 0.9;
+        if ( maxStep < length * 0.001 ) {
+            ++iteration;
+            break;
+        }
+    }
+    return iteration;
+}
+
+inline auto IncrementalLayout::relayout() -> const std::vector<std::uint32_t>&
+{
+    prepare();
+    optimize();
+    return _movable;
+}
+//-----------------------------------------------------------------------------
+
+} // ::gtpo
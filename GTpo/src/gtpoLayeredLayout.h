@@ -0,0 +1,184 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoLayeredLayout.h
+// \author	benoit@destrat.io
+// \date	2017 12 23
+//-----------------------------------------------------------------------------
+
+#ifndef gtpoLayeredLayout_h
+#define gtpoLayeredLayout_h
+
+// STD headers
+#include <cstddef>          // std::size_t
+#include <cstdint>          // std::uint8_t std::uint32_t
+#include <vector>
+
+// GTpo headers
+#include "./gtpoUtils.h"
+
+namespace gtpo { // ::gtpo
+
+/*! \brief Layered (Sugiyama) layout for directed graphs.
+ *
+ * Layout works on a structure of arrays snapshot of a graph topology (node sizes and edges) and does not reference
+ * any graph primitive, it could then be computed in a worker thread. Layout is computed in four steps:
+ * \li \c Cycle breaking: edges are oriented according to their \c reversedHint, then back edges found with a depth
+ * first search are reversed (reversed edges are reported in \c edgeReversed).
+ * \li \c Layer assignment: longest path layering, nodes are then moved toward their neighbours to reduce total
+ * edge span. Edges spanning more than one layer are splitted with virtual nodes.
+ * \li \c Crossing minimization: alternate down and up barycenter sweeps. Independent trials starting from different
+ * initial orders are run concurrently on \c threadCount threads, the order with the fewest crossings is kept. A
+ * trial stops after \c sweepCount sweeps or when a few successive sweeps did not reduce crossings.
+ * \li \c Coordinate assignment: layers are spaced by \c layerSpacing, nodes inside a layer are iteratively moved
+ * to the mean position of their neighbours with a minimal displacement that preserve order and \c nodeSpacing.
+ *
+ * Edges might have source and destination attachment offsets (ie a port position relative to its host node center
+ * along the layer axis), offsets are taken into account to order nodes and align edges.
+ *
+ * \code
+ *   gtpo::LayeredLayout layout;
+ *   const auto a = layout.addNode( 100., 50. );
+ *   const auto b = layout.addNode( 100., 50. );
+ *   layout.addEdge( a, b );
+ *   layout.compute();
+ *   // Node centers are in layout.x and layout.y
+ * \endcode
+ * \nosubgrouping
+ */
+class LayeredLayout
+{
+    /*! \name LayeredLayout Object Management *///-----------------------------
+    //@{
+public:
+    LayeredLayout() noexcept = default;
+    ~LayeredLayout() = default;
+    LayeredLayout( const LayeredLayout& ) = delete;
+    LayeredLayout& operator=( const LayeredLayout& ) = delete;
+
+    //! Remove all nodes and edges, allocated memory is kept for the next layout.
+    auto            clear() noexcept -> void;
+    inline auto     getNodeCount() const noexcept -> std::size_t { return width.size(); }
+    inline auto     getEdgeCount() const noexcept -> std::size_t { return edgeSrc.size(); }
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Layout Topology *///---------------------------------------------
+    //@{
+public:
+    //! Add a node of size (\c width, \c height) and return its index.
+    auto            addNode( double width, double height ) -> std::size_t;
+    /*! \brief Add an edge from node \c src to node \c dst and return its index.
+     *
+     * \c srcOffset and \c dstOffset are edge attachment points offsets relative to source and destination node
+     * centers along the layer axis (ie vertical offsets for an horizontal layout). When \c reversedHint is true,
+     * edge is preferably drawn from \c dst to \c src (for example an edge leaving a port docked against layout
+     * flow). Self loops are ignored.
+     * \throw gtpo::bad_topology_error if \c src or \c dst is not a valid node index.
+     */
+    auto            addEdge( std::size_t src, std::size_t dst, double srcOffset = 0., double dstOffset = 0.,
+                             bool reversedHint = false ) noexcept( false ) -> std::size_t;
+
+public:
+    std::vector<double>         width, height;
+
+    std::vector<std::uint32_t>  edgeSrc, edgeDst;
+    std::vector<double>         edgeSrcOffset, edgeDstOffset;
+    std::vector<std::uint8_t>   edgeReversedHint;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Layout Configuration *///----------------------------------------
+    //@{
+public:
+    //! Layers are ordered from left to right when true, from top to bottom otherwise (default to true).
+    bool            horizontal{ true };
+    //! Minimum space between two consecutive layers (default to 80.).
+    double          layerSpacing{ 80. };
+    //! Minimum space between two nodes in the same layer (default to 30.).
+    double          nodeSpacing{ 30. };
+    //! Maximum number of barycenter sweeps for every crossing minimization trial (default to 24).
+    unsigned int    sweepCount{ 24 };
+    //! Number of concurrent crossing minimization trials, 0 to use all available hardware threads (default to 0).
+    unsigned int    threadCount{ 0 };
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Layout Computation *///------------------------------------------
+    //@{
+public:
+    //! Compute layout, results are available in output arrays.
+    auto            compute() -> void;
+
+public:
+    //! Nodes center positions.
+    std::vector<double>         x, y;
+    //! Nodes layer index.
+    std::vector<std::uint32_t>  layer;
+    //! Set to 1 for edges drawn from destination to source (back edges or reversed hint).
+    std::vector<std::uint8_t>   edgeReversed;
+    //! Number of edge crossings in the final order (virtual edges included).
+    std::size_t                 crossings{ 0 };
+
+private:
+    //! Orient edges and break cycles, fill edgeReversed.
+    auto            breakCycles() -> void;
+    //! Assign layers and split long edges with virtual nodes.
+    auto            assignLayers() -> void;
+    //! Run one crossing minimization trial on \c order, return the number of crossings of the best order found.
+    auto            minimizeCrossings( std::vector<std::vector<std::uint32_t>>& order, unsigned int trial ) const -> std::size_t;
+    //! Return the number of crossings in \c order, \c pos is vertex position in its layer.
+    auto            countCrossings( const std::vector<std::vector<std::uint32_t>>& order,
+                                    const std::vector<std::uint32_t>& pos ) const -> std::size_t;
+    //! Compute vertices positions from layers \c order.
+    auto            assignCoordinates( const std::vector<std::vector<std::uint32_t>>& order ) -> void;
+
+private:
+    // Layered graph: real nodes are vertices [0, nodeCount), virtual nodes are appended
+    std::vector<std::uint32_t>  _vLayer;
+    std::vector<double>         _vBreadth;
+    //! Segments between vertices in consecutive layers (up is in the lowest layer).
+    std::vector<std::uint32_t>  _segUp, _segDown;
+    std::vector<double>         _segUpOffset, _segDownOffset;
+    //! Vertices segments with their neighbours in previous (up) and next (down) layers, in CSR format.
+    std::vector<std::uint32_t>  _upBegin, _upSegs, _downBegin, _downSegs;
+    //! Initial vertices order in every layer.
+    std::vector<std::vector<std::uint32_t>> _layers;
+    //! Scale used to convert attachment offsets to fractional positions in a layer.
+    double                      _offsetScale{ 0. };
+    //@}
+    //-------------------------------------------------------------------------
+};
+
+} // ::gtpo
+
+#include "./gtpoLayeredLayout.hpp"
+
+#endif // gtpoLayeredLayout_h
+
@@ -0,0 +1,481 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoLayeredLayout.hpp
+// \author	benoit@destrat.io
+// \date	2017 12 23
+//-----------------------------------------------------------------------------
+
+// STD headers
+#include <algorithm>    // std::stable_sort std::shuffle std::min_element
+#include <random>
+#include <utility>      // std::pair
+
+namespace gtpo { // ::gtpo
+
+/* LayeredLayout Object Management *///----------------------------------------
+inline auto LayeredLayout::clear() noexcept -> void
+{
+    width.clear();          height.clear();
+    edgeSrc.clear();        edgeDst.clear();
+    edgeSrcOffset.clear();  edgeDstOffset.clear();
+    edgeReversedHint.clear();
+}
+//-----------------------------------------------------------------------------
+
+/* Layout Topology *///--------------------------------------------------------
+inline auto LayeredLayout::addNode( double nodeWidth, double nodeHeight ) -> std::size_t
+{
+    width.push_back( nodeWidth );
+    height.push_back( nodeHeight );
+    return width.size() - 1;
+}
+
+inline auto LayeredLayout::addEdge( std::size_t src, std::size_t dst, double srcOffset, double dstOffset,
+                                    bool reversedHint ) noexcept( false ) -> std::size_t
+{
+    gtpo::assert_throw( src < getNodeCount() && dst < getNodeCount(),
+                        "gtpo::LayeredLayout::addEdge(): Error: invalid source or destination node index." );
+    edgeSrc.push_back( static_cast<std::uint32_t>( src ) );
+    edgeDst.push_back( static_cast<std::uint32_t>( dst ) );
+    edgeSrcOffset.push_back( srcOffset );
+    edgeDstOffset.push_back( dstOffset );
+    edgeReversedHint.push_back( reversedHint ? 1 : 0 );
+    return edgeSrc.size() - 1;
+}
+//-----------------------------------------------------------------------------
+
+/* Layout Computation *///-----------------------------------------------------
+inline auto LayeredLayout::compute() -> void
+{
+    const auto nodeCount = getNodeCount();
+    x.assign( nodeCount, 0. );
+    y.assign( nodeCount, 0. );
+    layer.assign( nodeCount, 0 );
+    edgeReversed.assign( getEdgeCount(), 0 );
+    crossings = 0;
+    if ( nodeCount == 0 )
+        return;
+    breakCycles();
+    assignLayers();
+
+    // Crossing minimization trials are independent, trial 0 start from the topological initial order
+    const unsigned int trials = gtpo::resolveThreadCount( threadCount );
+    std::vector<std::vector<std::vector<std::uint32_t>>> orders( trials, _layers );
+    std::vector<std::size_t> trialCrossings( trials, 0 );
+    gtpo::parallelFor( trials, trials, [this, &orders, &trialCrossings]( std::size_t t, unsigned int ) {
+        trialCrossings[t] = minimizeCrossings( orders[t], static_cast<unsigned int>( t ) );
+    } );
+    const auto best = static_cast<std::size_t>( std::min_element( trialCrossings.cbegin(), trialCrossings.cend() ) -
+                                                trialCrossings.cbegin() );
+    crossings = trialCrossings[best];
+    assignCoordinates( orders[best] );
+}
+
+inline auto LayeredLayout::breakCycles() -> void
+{
+    const auto nodeCount = getNodeCount();
+    const auto edgeCount = getEdgeCount();
+    const auto from = [this]( std::size_t e ) { return edgeReversedHint[e] != 0 ? edgeDst[e] : edgeSrc[e]; };
+    const auto to = [this]( std::size_t e ) { return edgeReversedHint[e] != 0 ? edgeSrc[e] : edgeDst[e]; };
+
+    // Oriented out edges in CSR format
+    std::vector<std::uint32_t> outBegin( nodeCount + 1, 0 );
+    std::vector<std::uint32_t> outEdges( edgeCount );
+    for ( std::size_t e = 0; e < edgeCount; ++e )
+        if ( edgeSrc[e] != edgeDst[e] )
+            ++outBegin[from( e ) + 1];
+    for ( std::size_t n = 0; n < nodeCount; ++n )
+        outBegin[n + 1] += outBegin[n];
+    {
+        std::vector<std::uint32_t> cursor( outBegin.cbegin(), outBegin.cend() - 1 );
+        for ( std::size_t e = 0; e < edgeCount; ++e )
+            if ( edgeSrc[e] != edgeDst[e] )
+                outEdges[cursor[from( e )]++] = static_cast<std::uint32_t>( e );
+    }
+
+    // Iterative DFS: edges to a vertex actually on DFS stack are back edges
+    std::vector<std::uint8_t> state( nodeCount, 0 );   // 0 unvisited, 1 on stack, 2 visited
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> stack;     // (vertex, next out edge)
+    for ( std::size_t root = 0; root < nodeCount; ++root ) {
+        if ( state[root] != 0 )
+            continue;
+        state[root] = 1;
+        stack.emplace_back( static_cast<std::uint32_t>( root ), outBegin[root] );
+        while ( !stack.empty() ) {
+            auto& top = stack.back();
+            if ( top.second < outBegin[top.first + 1] ) {
+                const auto e = outEdges[top.second++];
+                const auto t = to( e );
+                if ( state[t] == 1 )
+                    edgeReversed[e] = 1;
+                else if ( state[t] == 0 ) {
+                    state[t] = 1;
+                    stack.emplace_back( t, outBegin[t] );   // Note: invalidate top
+                }
+            } else {
+                state[top.first] = 2;
+                stack.pop_back();
+            }
+        }
+    }
+    for ( std::size_t e = 0; e < edgeCount; ++e )
+        if ( edgeSrc[e] != edgeDst[e] )
+            edgeReversed[e] ^= edgeReversedHint[e];
+}
+
+inline auto LayeredLayout::assignLayers() -> void
+{
+    const auto nodeCount = getNodeCount();
+    const auto edgeCount = getEdgeCount();
+    const auto from = [this]( std::size_t e ) { return edgeReversed[e] != 0 ? edgeDst[e] : edgeSrc[e]; };
+    const auto to = [this]( std::size_t e ) { return edgeReversed[e] != 0 ? edgeSrc[e] : edgeDst[e]; };
+
+    // Acyclic out edges in CSR format
+    std::vector<std::uint32_t> outBegin( nodeCount + 1, 0 );
+    std::vector<std::uint32_t> outEdges( edgeCount );
+    std::vector<std::uint32_t> inDegree( nodeCount, 0 );
+    for ( std::size_t e = 0; e < edgeCount; ++e )
+        if ( edgeSrc[e] != edgeDst[e] ) {
+            ++outBegin[from( e ) + 1];
+            ++inDegree[to( e )];
+        }
+    for ( std::size_t n = 0; n < nodeCount; ++n )
+        outBegin[n + 1] += outBegin[n];
+    {
+        std::vector<std::uint32_t> cursor( outBegin.cbegin(), outBegin.cend() - 1 );
+        for ( std::size_t e = 0; e < edgeCount; ++e )
+            if ( edgeSrc[e] != edgeDst[e] )
+                outEdges[cursor[from( e )]++] = static_cast<std::uint32_t>( e );
+    }
+
+    // Longest path layering in topological order
+    std::vector<std::uint32_t> topological;
+    topological.reserve( nodeCount );
+    std::vector<std::uint32_t> remaining( inDegree );
+    for ( std::size_t n = 0; n < nodeCount; ++n )
+        if ( inDegree[n] == 0 )
+            topological.push_back( static_cast<std::uint32_t>( n ) );
+    for ( std::size_t t = 0; t < topological.size(); ++t ) {
+        const auto v = topological[t];
+        for ( auto o = outBegin[v]; o < outBegin[v + 1]; ++o ) {
+            const auto w = to( outEdges[o] );
+            layer[w] = std::max( layer[w], layer[v] + 1 );
+            if ( --remaining[w] == 0 )
+                topological.push_back( w );
+        }
+    }
+    // Reduce total edge span (and virtual vertices count): every vertex is moved inside its feasible layers
+    // interval toward the side with more neighbours, until a local minimum is reached
+    std::vector<std::uint32_t> inBegin( nodeCount + 1, 0 );
+    std::vector<std::uint32_t> inEdges( outEdges.size() );
+    for ( std::size_t n = 0; n < nodeCount; ++n )
+        inBegin[n + 1] = inBegin[n] + inDegree[n];
+    {
+        std::vector<std::uint32_t> cursor( inBegin.cbegin(), inBegin.cend() - 1 );
+        for ( const auto e : outEdges )
+            inEdges[cursor[to( e )]++] = e;
+    }
+    const auto maxLayer = *std::max_element( layer.cbegin(), layer.cend() );
+    constexpr int spanReductionPasses = 8;
+    for ( int pass = 0; pass < spanReductionPasses; ++pass ) {
+        bool moved = false;
+        for ( auto t = topological.crbegin(); t != topological.crend(); ++t ) {
+            const auto v = *t;
+            const auto inCount = inBegin[v + 1] - inBegin[v];
+            const auto outCount = outBegin[v + 1] - outBegin[v];
+            if ( inCount == outCount )
+                continue;
+            std::uint32_t minLayer = 0;
+            for ( auto i = inBegin[v]; i < inBegin[v + 1]; ++i )
+                minLayer = std::max( minLayer, layer[from( inEdges[i] )] + 1 );
+            auto maxFeasible = outCount > 0 ? maxLayer : layer[v];   // Do not push sinks further
+            for ( auto o = outBegin[v]; o < outBegin[v + 1]; ++o )
+                maxFeasible = std::min( maxFeasible, layer[to( outEdges[o] )] - 1 );
+            if ( inCount == 0 )                     // Sources are not pulled further up
+                minLayer = layer[v];
+            const auto target = inCount > outCount ? minLayer : maxFeasible;
+            if ( target != layer[v] ) {
+                layer[v] = target;
+                moved = true;
+            }
+        }
+        if ( !moved )
+            break;
+    }
+    const auto layerCount = static_cast<std::size_t>( *std::max_element( layer.cbegin(), layer.cend() ) ) + 1;
+
+    // Build layered graph, edges spanning more than one layer are splitted with virtual vertices
+    _vLayer.assign( layer.cbegin(), layer.cend() );
+    _vBreadth.assign( horizontal ? height.cbegin() : width.cbegin(),
+                      horizontal ? height.cend() : width.cend() );
+    _segUp.clear();         _segDown.clear();
+    _segUpOffset.clear();   _segDownOffset.clear();
+    _layers.assign( layerCount, {} );
+    const auto addSegment = [this]( std::uint32_t up, std::uint32_t down, double upOffset, double downOffset ) {
+        _segUp.push_back( up );
+        _segDown.push_back( down );
+        _segUpOffset.push_back( upOffset );
+        _segDownOffset.push_back( downOffset );
+    };
+    for ( const auto v : topological ) {
+        _layers[layer[v]].push_back( v );
+        for ( auto o = outBegin[v]; o < outBegin[v + 1]; ++o ) {
+            const auto e = outEdges[o];
+            const auto w = to( e );
+            auto up = v;
+            auto upOffset = edgeReversed[e] != 0 ? edgeDstOffset[e] : edgeSrcOffset[e];
+            for ( auto l = layer[v] + 1; l < layer[w]; ++l ) {
+                const auto dummy = static_cast<std::uint32_t>( _vLayer.size() );
+                _vLayer.push_back( l );
+                _vBreadth.push_back( 0. );
+                _layers[l].push_back( dummy );
+                addSegment( up, dummy, upOffset, 0. );
+                up = dummy;
+                upOffset = 0.;
+            }
+            addSegment( up, w, upOffset, edgeReversed[e] != 0 ? edgeSrcOffset[e] : edgeDstOffset[e] );
+        }
+    }
+
+    // Vertices up and down segments in CSR format
+    const auto vertexCount = _vLayer.size();
+    const auto segmentCount = _segUp.size();
+    _upBegin.assign( vertexCount + 1, 0 );
+    _downBegin.assign( vertexCount + 1, 0 );
+    for ( std::size_t s = 0; s < segmentCount; ++s ) {
+        ++_upBegin[_segDown[s] + 1];
+        ++_downBegin[_segUp[s] + 1];
+    }
+    for ( std::size_t v = 0; v < vertexCount; ++v ) {
+        _upBegin[v + 1] += _upBegin[v];
+        _downBegin[v + 1] += _downBegin[v];
+    }
+    _upSegs.resize( segmentCount );
+    _downSegs.resize( segmentCount );
+    std::vector<std::uint32_t> upCursor( _upBegin.cbegin(), _upBegin.cend() - 1 );
+    std::vector<std::uint32_t> downCursor( _downBegin.cbegin(), _downBegin.cend() - 1 );
+    for ( std::size_t s = 0; s < segmentCount; ++s ) {
+        _upSegs[upCursor[_segDown[s]]++] = static_cast<std::uint32_t>( s );
+        _downSegs[downCursor[_segUp[s]]++] = static_cast<std::uint32_t>( s );
+    }
+
+    const auto maxBreadth = *std::max_element( _vBreadth.cbegin(), _vBreadth.cbegin() + static_cast<std::ptrdiff_t>( nodeCount ) );
+    _offsetScale = 1. / std::max( 1., maxBreadth + nodeSpacing );
+}
+
+inline auto LayeredLayout::minimizeCrossings( std::vector<std::vector<std::uint32_t>>& order, unsigned int trial ) const -> std::size_t
+{
+    if ( trial > 0 ) {
+        std::mt19937 generator{ trial };
+        for ( auto& vertices : order )
+            std::shuffle( vertices.begin(), vertices.end(), generator );
+    }
+    std::vector<std::uint32_t> pos( _vLayer.size(), 0 );
+    const auto updatePositions = [&pos]( const std::vector<std::uint32_t>& vertices ) {
+        for ( std::size_t p = 0; p < vertices.size(); ++p )
+            pos[vertices[p]] = static_cast<std::uint32_t>( p );
+    };
+    for ( const auto& vertices : order )
+        updatePositions( vertices );
+
+    auto best = order;
+    auto bestCrossings = countCrossings( order, pos );
+    std::vector<std::pair<double, std::uint32_t>> keys;
+    std::vector<std::uint32_t> sorted;
+    const auto layerCount = order.size();
+    constexpr unsigned int maxStalledSweeps = 4;
+    unsigned int stalledSweeps = 0;
+    for ( unsigned int sweep = 0; sweep < sweepCount && bestCrossings > 0 && stalledSweeps < maxStalledSweeps; ++sweep ) {
+        const bool down = ( sweep % 2 ) == 0;
+        for ( std::size_t i = 1; i < layerCount; ++i ) {
+            auto& vertices = order[down ? i : layerCount - 1 - i];
+            keys.clear();
+            for ( const auto v : vertices ) {
+                // Barycenter of neighbours in previous layer (down sweep) or next layer (up sweep)
+                double sum = 0.;
+                std::uint32_t count = 0;
+                if ( down )
+                    for ( auto s = _upBegin[v]; s < _upBegin[v + 1]; ++s, ++count )
+                        sum += pos[_segUp[_upSegs[s]]] + _segUpOffset[_upSegs[s]] * _offsetScale;
+                else
+                    for ( auto s = _downBegin[v]; s < _downBegin[v + 1]; ++s, ++count )
+                        sum += pos[_segDown[_downSegs[s]]] + _segDownOffset[_downSegs[s]] * _offsetScale;
+                keys.emplace_back( count > 0 ? sum / count : static_cast<double>( pos[v] ), pos[v] );
+            }
+            std::sort( keys.begin(), keys.end() );  // Ties are ordered by actual position
+            sorted.assign( vertices.cbegin(), vertices.cend() );
+            for ( std::size_t k = 0; k < keys.size(); ++k )
+                vertices[k] = sorted[keys[k].second];
+            updatePositions( vertices );
+        }
+        const auto sweepCrossings = countCrossings( order, pos );
+        if ( sweepCrossings < bestCrossings ) {
+            best = order;
+            bestCrossings = sweepCrossings;
+            stalledSweeps = 0;
+        } else
+            ++stalledSweeps;
+    }
+    order.swap( best );
+    return bestCrossings;
+}
+
+inline auto LayeredLayout::countCrossings( const std::vector<std::vector<std::uint32_t>>& order,
+                                           const std::vector<std::uint32_t>& pos ) const -> std::size_t
+{
+    // Segments are sorted on their up extremity, crossings are then inversions in down extremities sequence.
+    // Extremities are fractional positions taking attachment offsets into account: two segments leaving the
+    // same vertex from different ports might cross.
+    std::size_t result = 0;
+    std::vector<std::pair<double, double>> segments;
+    std::vector<double> keys, buffer;
+    for ( std::size_t l = 0; l + 1 < order.size(); ++l ) {
+        keys.clear();
+        for ( const auto u : order[l] ) {
+            segments.clear();
+            for ( auto s = _downBegin[u]; s < _downBegin[u + 1]; ++s ) {
+                const auto segment = _downSegs[s];
+                segments.emplace_back( _segUpOffset[segment],
+                                       pos[_segDown[segment]] + _segDownOffset[segment] * _offsetScale );
+            }
+            std::sort( segments.begin(), segments.end() );
+            for ( const auto& segment : segments )
+                keys.push_back( segment.second );
+        }
+
+        // Bottom up merge sort inversion count, O(|segments| log |segments|)
+        buffer.resize( keys.size() );
+        for ( std::size_t width = 1; width < keys.size(); width *= 2 ) {
+            for ( std::size_t begin = 0; begin < keys.size(); begin += 2 * width ) {
+                const auto middle = std::min( begin + width, keys.size() );
+                const auto end = std::min( begin + 2 * width, keys.size() );
+                std::size_t i = begin, j = middle, k = begin;
+                while ( i < middle && j < end ) {
+                    if ( keys[j] < keys[i] ) {
+                        result += middle - i;
+                        buffer[k++] = keys[j++];
+                    } else
+                        buffer[k++] = keys[i++];
+                }
+                while ( i < middle )
+                    buffer[k++] = keys[i++];
+                while ( j < end )
+                    buffer[k++] = keys[j++];
+            }
+            keys.swap( buffer );
+        }
+    }
+    return result;
+}
+
+inline auto LayeredLayout::assignCoordinates( const std::vector<std::vector<std::uint32_t>>& order ) -> void
+{
+    const auto nodeCount = getNodeCount();
+    const auto layerCount = order.size();
+
+    // Initial coordinates: vertices packed and centered in their layer
+    std::vector<double> coord( _vLayer.size(), 0. );
+    for ( const auto& vertices : order ) {
+        double c = 0.;
+        for ( const auto v : vertices ) {
+            coord[v] = c + _vBreadth[v] / 2.;
+            c += _vBreadth[v] + nodeSpacing;
+        }
+        const double shift = ( c - nodeSpacing ) / 2.;
+        for ( const auto v : vertices )
+            coord[v] -= shift;
+    }
+
+    // Balancing: move vertices toward their neighbours mean position, minimal (least squares) displacement preserving
+    // order and spacing is obtained with the pool adjacent violators algorithm on separation shifted targets
+    std::vector<double> separation, target;
+    struct Block { double mean; double weight; std::size_t end; };
+    std::vector<Block> blocks;
+    constexpr int balancingIterations = 8;
+    for ( int iteration = 0; iteration < balancingIterations; ++iteration ) {
+        const bool down = ( iteration % 2 ) == 0;
+        for ( std::size_t i = 0; i < layerCount; ++i ) {
+            const auto& vertices = order[down ? i : layerCount - 1 - i];
+            const auto n = vertices.size();
+            separation.resize( n );
+            target.resize( n );
+            for ( std::size_t k = 0; k < n; ++k ) {
+                const auto v = vertices[k];
+                double sum = 0.;
+                std::uint32_t count = 0;
+                if ( down )
+                    for ( auto s = _upBegin[v]; s < _upBegin[v + 1]; ++s, ++count ) {
+                        const auto segment = _upSegs[s];
+                        sum += coord[_segUp[segment]] + _segUpOffset[segment] - _segDownOffset[segment];
+                    }
+                else
+                    for ( auto s = _downBegin[v]; s < _downBegin[v + 1]; ++s, ++count ) {
+                        const auto segment = _downSegs[s];
+                        sum += coord[_segDown[segment]] + _segDownOffset[segment] - _segUpOffset[segment];
+                    }
+                separation[k] = k == 0 ? 0. : separation[k - 1] + ( _vBreadth[vertices[k - 1]] + _vBreadth[v] ) / 2. + nodeSpacing;
+                target[k] = ( count > 0 ? sum / count : coord[v] ) - separation[k];
+            }
+            blocks.clear();
+            for ( std::size_t k = 0; k < n; ++k ) {
+                blocks.push_back( Block{ target[k], 1., k + 1 } );
+                while ( blocks.size() > 1 &&
+                        blocks[blocks.size() - 2].mean > blocks.back().mean ) {
+                    const auto last = blocks.back();
+                    blocks.pop_back();
+                    auto& previous = blocks.back();
+                    previous.mean = ( previous.mean * previous.weight + last.mean * last.weight ) / ( previous.weight + last.weight );
+                    previous.weight += last.weight;
+                    previous.end = last.end;
+                }
+            }
+            std::size_t k = 0;
+            for ( const auto& block : blocks )
+                for ( ; k < block.end; ++k )
+                    coord[vertices[k]] = block.mean + separation[k];
+        }
+    }
+
+    // Layers coordinates: layers are spaced according to their longest node
+    std::vector<double> layerLength( layerCount, 0. );
+    for ( std::size_t n = 0; n < nodeCount; ++n )
+        layerLength[layer[n]] = std::max( layerLength[layer[n]], horizontal ? width[n] : height[n] );
+    std::vector<double> layerPos( layerCount, 0. );
+    for ( std::size_t l = 1; l < layerCount; ++l )
+        layerPos[l] = layerPos[l - 1] + ( layerLength[l - 1] + layerLength[l] ) / 2. + layerSpacing;
+    for ( std::size_t n = 0; n < nodeCount; ++n ) {
+        x[n] = horizontal ? layerPos[layer[n]] : coord[n];
+        y[n] = horizontal ? coord[n] : layerPos[layer[n]];
+    }
+}
+//-----------------------------------------------------------------------------
+
+} // ::gtpo
+
@@ -0,0 +1,242 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoOrthogonalRouter.h
+// \author	benoit@destrat.io
+// \date	2017 12 29
+//-----------------------------------------------------------------------------
+
+#ifndef gtpoOrthogonalRouter_h
+#define gtpoOrthogonalRouter_h
+
+// STD headers
+#include <cstddef>          // std::size_t
+#include <cstdint>          // std::uint8_t std::uint32_t std::int64_t
+#include <limits>
+#include <utility>          // std::pair
+#include <vector>
+
+// GTpo headers
+#include "./gtpoUtils.h"
+#include "./gtpoSpatialIndex.h"
+
+namespace gtpo { // ::gtpo
+
+/*! \brief Incremental orthogonal edge router avoiding rectangular obstacles.
+ *
+ * Router keeps a persistent set of obstacles (node or group boxes, indexed in a gtpo::SpatialIndex) and of routes
+ * between two obstacles. Every route is computed independently (routes are routed concurrently): obstacles found
+ * around the route end points are collected, an orthogonal visibility grid is built from obstacles boundaries
+ * (expanded by \c margin) and end points centers, then an A* search with a \c bendPenalty finds the shortest
+ * route with fewest bends. Search window is enlarged when no route is found inside.
+ *
+ * Routed paths are indexed too: when an obstacle is moved with setObstacle(), only routes attached to this
+ * obstacle and routes whose path cross its previous or new area (its corridor) are routed again. Parallel
+ * overlapping segments of different routes lying on the same line are finally nudged apart by \c nudgeSpacing,
+ * only lines modified by rerouted routes are nudged again.
+ *
+ * A route ignores its end points obstacles and their containers (for example the groups of a grouped node).
+ *
+ * \code
+ *   gtpo::OrthogonalRouter router;
+ *   const auto a = router.addObstacle( 0., 0., 100., 50. );
+ *   const auto b = router.addObstacle( 400., 0., 100., 50. );
+ *   router.addObstacle( 200., -50., 100., 150. );     // Between a and b
+ *   const auto route = router.addRoute( a, b );
+ *   router.route();
+ *   for ( const auto& point : router.getRoute( route ) )   // Route from a border to b border
+ *       std::cout << point.x << " " << point.y << std::endl;
+ * \endcode
+ * \nosubgrouping
+ */
+class OrthogonalRouter
+{
+    /*! \name OrthogonalRouter Object Management *///--------------------------
+    //@{
+public:
+    OrthogonalRouter() noexcept = default;
+    ~OrthogonalRouter() = default;
+    OrthogonalRouter( const OrthogonalRouter& ) = delete;
+    OrthogonalRouter& operator=( const OrthogonalRouter& ) = delete;
+
+    //! Remove all obstacles and routes.
+    auto            clear() noexcept -> void;
+    //! Number of (non removed) obstacles.
+    inline auto     getObstacleCount() const noexcept -> std::size_t { return _boxes.size() - _freeObstacles.size(); }
+    //! Number of (non removed) routes.
+    inline auto     getRouteCount() const noexcept -> std::size_t { return _routeSrc.size() - _freeRoutes.size(); }
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Obstacles and Routes Management *///-----------------------------
+    //@{
+public:
+    enum : std::uint32_t { NoIndex = std::numeric_limits<std::uint32_t>::max() };
+
+    //! Route point.
+    struct Point {
+        double  x;
+        double  y;
+    };
+
+    /*! \brief Add an obstacle of size (\c width, \c height) at (\c left, \c top) and return its index.
+     *
+     * Routes attached to an obstacle whose container (or container ancestor) is \c container are allowed to cross \c container.
+     * \throw gtpo::bad_topology_error if \c container is neither NoIndex nor a valid obstacle index.
+     */
+    auto            addObstacle( double left, double top, double width, double height,
+                                 std::uint32_t container = NoIndex ) noexcept( false ) -> std::uint32_t;
+    /*! \brief Move or resize obstacle \c obstacle, routes attached to \c obstacle or crossing its corridor are marked dirty.
+     *
+     * \throw gtpo::bad_topology_error if \c obstacle is not a valid obstacle index.
+     */
+    auto            setObstacle( std::uint32_t obstacle, double left, double top,
+                                 double width, double height ) noexcept( false ) -> void;
+    /*! \brief Remove obstacle \c obstacle and its attached routes, routes crossing its corridor are marked dirty.
+     *
+     * \throw gtpo::bad_topology_error if \c obstacle is not a valid obstacle index.
+     */
+    auto            removeObstacle( std::uint32_t obstacle ) noexcept( false ) -> void;
+    //! Return true if \c obstacle is a valid (non removed) obstacle index.
+    inline auto     isObstacle( std::uint32_t obstacle ) const noexcept -> bool {
+        return obstacle < _alive.size() && _alive[ obstacle ] != 0;
+    }
+    //! Return obstacle \c obstacle box (an empty box if \c obstacle is invalid).
+    inline auto     getObstacle( std::uint32_t obstacle ) const noexcept -> Box {
+        return isObstacle( obstacle ) ? _boxes[ obstacle ] : Box{};
+    }
+
+    /*! \brief Add a dirty route from obstacle \c src to obstacle \c dst and return its index.
+     *
+     * \throw gtpo::bad_topology_error if \c src or \c dst is not a valid obstacle index.
+     */
+    auto            addRoute( std::uint32_t src, std::uint32_t dst ) noexcept( false ) -> std::uint32_t;
+    /*! \brief Remove route \c route.
+     *
+     * \throw gtpo::bad_topology_error if \c route is not a valid route index.
+     */
+    auto            removeRoute( std::uint32_t route ) noexcept( false ) -> void;
+    //! Return true if \c route is a valid (non removed) route index.
+    inline auto     isRoute( std::uint32_t route ) const noexcept -> bool {
+        return route < _routeSrc.size() && _routeSrc[ route ] != NoIndex;
+    }
+    /*! \brief Mark route \c route dirty, it will be routed again on next route() call.
+     *
+     * \throw gtpo::bad_topology_error if \c route is not a valid route index.
+     */
+    auto            markDirty( std::uint32_t route ) noexcept( false ) -> void;
+    //! Return true if some routes have to be routed.
+    inline auto     hasDirtyRoutes() const noexcept -> bool { return !_dirty.empty(); }
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Router Configuration *///----------------------------------------
+    //@{
+public:
+    //! Minimum distance between a route and an obstacle (default to 10.).
+    double          margin{ 10. };
+    //! Cost of a bend, expressed as a route length (default to 40.).
+    double          bendPenalty{ 40. };
+    //! Distance between two nudged parallel segments (default to 6.).
+    double          nudgeSpacing{ 6. };
+    //! Number of routes routed concurrently, 0 to use all available hardware threads (default to 0).
+    unsigned int    threadCount{ 0 };
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Routing *///-----------------------------------------------------
+    //@{
+public:
+    /*! \brief Route dirty routes, nudge modified lines and return routes whose path has been modified.
+     *
+     * Routes are available with getRoute() until next modification of their end points or corridor.
+     */
+    auto            route() -> const std::vector<std::uint32_t>&;
+    //! Return route \c route path, from \c src obstacle border to \c dst obstacle border (empty if \c route is invalid or has never been routed).
+    auto            getRoute( std::uint32_t route ) const noexcept -> const std::vector<Point>&;
+
+private:
+    //! Per thread routing buffers.
+    struct Worker {
+        std::vector<std::uint32_t>  obstacles;
+        std::vector<std::uint32_t>  ignored;
+        std::vector<double>         xs, ys;
+        std::vector<std::uint8_t>   blockedH, blockedV;
+        std::vector<double>         cost;
+        std::vector<std::uint32_t>  previous;
+        std::vector<std::pair<double, std::uint32_t>>   heap;
+    };
+    //! Compute route \c route raw path.
+    auto            routeOne( std::uint32_t route, Worker& worker ) const -> std::vector<Point>;
+    //! Find a path from \c src center to \c dst center inside \c window, return an empty path on failure.
+    auto            searchPath( std::uint32_t src, std::uint32_t dst, const Box& window,
+                                Worker& worker ) const -> std::vector<Point>;
+    //! Mark routes attached to \c obstacle and routes crossing \c area dirty.
+    auto            markCorridorDirty( std::uint32_t obstacle, const Box& area ) -> void;
+    //! Index \c route path bounding box.
+    auto            indexRoute( std::uint32_t route ) -> void;
+    //! Remove \c path duplicated and collinear points, then move its end points from \c src and \c dst centers to their borders.
+    static auto     finishPath( std::vector<Point>& path, const Box& src, const Box& dst ) noexcept -> void;
+    //! Return the nudging line key of segment [\c a, \c b] (orientation and coordinate).
+    static auto     lineKey( const Point& a, const Point& b ) noexcept -> std::int64_t;
+    //! Nudge apart overlapping segments on lines \c keys, routes with modified paths are appended to \c _changed.
+    auto            nudge( std::vector<std::int64_t>& keys ) -> void;
+
+private:
+    std::vector<Box>                        _boxes;
+    std::vector<std::uint32_t>              _container;
+    std::vector<std::uint8_t>               _alive;
+    //! Routes attached to every obstacle.
+    std::vector<std::vector<std::uint32_t>> _attached;
+    std::vector<std::uint32_t>              _freeObstacles;
+    SpatialIndex<std::uint32_t>             _obstacleIndex;
+
+    //! Routes end points, NoIndex for removed routes.
+    std::vector<std::uint32_t>              _routeSrc, _routeDst;
+    std::vector<std::uint32_t>              _freeRoutes;
+    //! Routes raw paths (before nudging), nudging offset of every path segment and final routes.
+    std::vector<std::vector<Point>>         _paths;
+    std::vector<std::vector<double>>        _offsets;
+    std::vector<std::vector<Point>>         _routes;
+    //! Routes paths bounding boxes.
+    SpatialIndex<std::uint32_t>             _routeIndex;
+
+    std::vector<std::uint32_t>              _dirty;
+    //! Lines whose segments must be nudged again (raw paths lines of removed routes).
+    std::vector<std::int64_t>               _dirtyLines;
+    std::vector<std::uint32_t>              _changed;
+    //@}
+    //-------------------------------------------------------------------------
+};
+
+} // ::gtpo
+
+#include "./gtpoOrthogonalRouter.hpp"
+
+#endif // gtpoOrthogonalRouter_h
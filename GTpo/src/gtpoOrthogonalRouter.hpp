@@ -0,0 +1,582 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoOrthogonalRouter.hpp
+// \author	benoit@destrat.io
+// \date	2017 12 29
+//-----------------------------------------------------------------------------
+
+// STD headers
+#include <algorithm>    // std::sort std::unique std::lower_bound std::push_heap
+#include <cmath>        // std::abs std::llround
+#include <functional>   // std::greater
+
+namespace gtpo { // ::gtpo
+
+/* OrthogonalRouter Object Management *///-------------------------------------
+inline auto OrthogonalRouter::clear() noexcept -> void
+{
+    _boxes.clear();         _container.clear();
+    _alive.clear();         _attached.clear();
+    _freeObstacles.clear();
+    _obstacleIndex.clear();
+    _routeSrc.clear();      _routeDst.clear();
+    _freeRoutes.clear();
+    _paths.clear();         _offsets.clear();
+    _routes.clear();
+    _routeIndex.clear();
+    _dirty.clear();         _dirtyLines.clear();
+    _changed.clear();
+}
+//-----------------------------------------------------------------------------
+
+/* Obstacles and Routes Management *///----------------------------------------
+inline auto OrthogonalRouter::addObstacle( double left, double top, double width, double height,
+                                           std::uint32_t container ) noexcept( false ) -> std::uint32_t
+{
+    gtpo::assert_throw( container == NoIndex || isObstacle( container ),
+                        "gtpo::OrthogonalRouter::addObstacle(): Error: invalid container obstacle index." );
+    const auto box = Box::fromRect( left, top, std::max( 0., width ), std::max( 0., height ) );
+    std::uint32_t obstacle = NoIndex;
+    if ( !_freeObstacles.empty() ) {
+        obstacle = _freeObstacles.back();
+        _freeObstacles.pop_back();
+        _boxes[ obstacle ] = box;
+        _container[ obstacle ] = container;
+        _alive[ obstacle ] = 1;
+        _attached[ obstacle ].clear();
+    } else {
+        obstacle = static_cast<std::uint32_t>( _boxes.size() );
+        _boxes.push_back( box );
+        _container.push_back( container );
+        _alive.push_back( 1 );
+        _attached.emplace_back();
+    }
+    _obstacleIndex.insert( obstacle, box );
+    markCorridorDirty( obstacle, Box{ box.left - margin, box.top - margin, box.right + margin, box.bottom + margin } );
+    return obstacle;
+}
+
+inline auto OrthogonalRouter::setObstacle( std::uint32_t obstacle, double left, double top,
+                                           double width, double height ) noexcept( false ) -> void
+{
+    gtpo::assert_throw( isObstacle( obstacle ), "gtpo::OrthogonalRouter::setObstacle(): Error: invalid obstacle index." );
+    const auto previous = _boxes[ obstacle ];
+    const auto box = Box::fromRect( left, top, std::max( 0., width ), std::max( 0., height ) );
+    _boxes[ obstacle ] = box;
+    _obstacleIndex.update( obstacle, box );
+    markCorridorDirty( obstacle, Box{ previous.left - margin, previous.top - margin,
+                                      previous.right + margin, previous.bottom + margin } );
+    markCorridorDirty( NoIndex, Box{ box.left - margin, box.top - margin, box.right + margin, box.bottom + margin } );
+}
+
+inline auto OrthogonalRouter::removeObstacle( std::uint32_t obstacle ) noexcept( false ) -> void
+{
+    gtpo::assert_throw( isObstacle( obstacle ), "gtpo::OrthogonalRouter::removeObstacle(): Error: invalid obstacle index." );
+    const auto attached = _attached[ obstacle ];
+    for ( const auto route : attached )
+        if ( isRoute( route ) )
+            removeRoute( route );
+    const auto box = _boxes[ obstacle ];
+    _obstacleIndex.remove( obstacle );
+    _alive[ obstacle ] = 0;
+    _attached[ obstacle ].clear();
+    for ( auto& container : _container )    // Content of a removed container is no longer contained
+        if ( container == obstacle )
+            container = NoIndex;
+    _freeObstacles.push_back( obstacle );
+    markCorridorDirty( NoIndex, Box{ box.left - margin, box.top - margin, box.right + margin, box.bottom + margin } );
+}
+
+inline auto OrthogonalRouter::addRoute( std::uint32_t src, std::uint32_t dst ) noexcept( false ) -> std::uint32_t
+{
+    gtpo::assert_throw( isObstacle( src ), "gtpo::OrthogonalRouter::addRoute(): Error: invalid source obstacle index." );
+    gtpo::assert_throw( isObstacle( dst ), "gtpo::OrthogonalRouter::addRoute(): Error: invalid destination obstacle index." );
+    std::uint32_t route = NoIndex;
+    if ( !_freeRoutes.empty() ) {
+        route = _freeRoutes.back();
+        _freeRoutes.pop_back();
+        _routeSrc[ route ] = src;
+        _routeDst[ route ] = dst;
+    } else {
+        route = static_cast<std::uint32_t>( _routeSrc.size() );
+        _routeSrc.push_back( src );
+        _routeDst.push_back( dst );
+        _paths.emplace_back();
+        _offsets.emplace_back();
+        _routes.emplace_back();
+    }
+    _attached[ src ].push_back( route );
+    if ( dst != src )
+        _attached[ dst ].push_back( route );
+    _dirty.push_back( route );
+    return route;
+}
+
+inline auto OrthogonalRouter::removeRoute( std::uint32_t route ) noexcept( false ) -> void
+{
+    gtpo::assert_throw( isRoute( route ), "gtpo::OrthogonalRouter::removeRoute(): Error: invalid route index." );
+    for ( const auto obstacle : { _routeSrc[ route ], _routeDst[ route ] } ) {
+        auto& attached = _attached[ obstacle ];
+        const auto r = std::find( attached.begin(), attached.end(), route );
+        if ( r != attached.end() )      // Self loops are attached once
+            attached.erase( r );
+    }
+    // Remaining segments on removed route lines must be nudged again
+    const auto& path = _paths[ route ];
+    for ( std::size_t s = 1; s < path.size(); ++s )
+        _dirtyLines.push_back( lineKey( path[ s - 1 ], path[ s ] ) );
+    _paths[ route ].clear();
+    _offsets[ route ].clear();
+    _routes[ route ].clear();
+    _routeIndex.remove( route );
+    _routeSrc[ route ] = _routeDst[ route ] = NoIndex;
+    _freeRoutes.push_back( route );
+}
+
+inline auto OrthogonalRouter::markDirty( std::uint32_t route ) noexcept( false ) -> void
+{
+    gtpo::assert_throw( isRoute( route ), "gtpo::OrthogonalRouter::markDirty(): Error: invalid route index." );
+    _dirty.push_back( route );
+}
+
+inline auto OrthogonalRouter::markCorridorDirty( std::uint32_t obstacle, const Box& area ) -> void
+{
+    if ( obstacle != NoIndex )
+        _dirty.insert( _dirty.end(), _attached[ obstacle ].begin(), _attached[ obstacle ].end() );
+    _routeIndex.visit( area, [this, &area]( const std::uint32_t& route, const Box& ) {
+        const auto& path = _paths[ route ];
+        for ( std::size_t s = 1; s < path.size(); ++s ) {
+            const auto& a = path[ s - 1 ];
+            const auto& b = path[ s ];
+            if ( std::max( a.x, b.x ) >= area.left && std::min( a.x, b.x ) <= area.right &&
+                 std::max( a.y, b.y ) >= area.top && std::min( a.y, b.y ) <= area.bottom ) {
+                _dirty.push_back( route );
+                break;
+            }
+        }
+    } );
+}
+
+inline auto OrthogonalRouter::indexRoute( std::uint32_t route ) -> void
+{
+    const auto& path = _paths[ route ];
+    if ( path.size() < 2 ) {
+        _routeIndex.remove( route );
+        return;
+    }
+    Box box{ path.front().x, path.front().y, path.front().x, path.front().y };
+    for ( const auto& point : path )
+        box = box.united( Box{ point.x, point.y, point.x, point.y } );
+    _routeIndex.insert( route, box );
+}
+//-----------------------------------------------------------------------------
+
+/* Routing *///----------------------------------------------------------------
+inline auto OrthogonalRouter::getRoute( std::uint32_t route ) const noexcept -> const std::vector<Point>&
+{
+    static const std::vector<Point> empty;
+    return isRoute( route ) ? _routes[ route ] : empty;
+}
+
+inline auto OrthogonalRouter::route() -> const std::vector<std::uint32_t>&
+{
+    _changed.clear();
+    std::sort( _dirty.begin(), _dirty.end() );
+    _dirty.erase( std::unique( _dirty.begin(), _dirty.end() ), _dirty.end() );
+    _dirty.erase( std::remove_if( _dirty.begin(), _dirty.end(),
+                                  [this]( std::uint32_t route ) { return !isRoute( route ); } ), _dirty.end() );
+
+    // Routes are independent, route them concurrently (obstacles and index are only read)
+    std::vector<std::vector<Point>> paths( _dirty.size() );
+    if ( !_dirty.empty() ) {
+        const auto threads = static_cast<unsigned int>( std::min<std::size_t>( gtpo::resolveThreadCount( threadCount ),
+                                                                               _dirty.size() ) );
+        std::vector<Worker> workers( threads );
+        gtpo::parallelFor( _dirty.size(), threads, [this, &paths, &workers]( std::size_t r, unsigned int thread ) {
+            paths[ r ] = routeOne( _dirty[ r ], workers[ thread ] );
+        } );
+    }
+
+    // Previous and new lines of rerouted routes must be nudged again
+    std::vector<std::int64_t> keys;
+    keys.swap( _dirtyLines );
+    for ( std::size_t r = 0; r < _dirty.size(); ++r ) {
+        const auto route = _dirty[ r ];
+        for ( std::size_t s = 1; s < _paths[ route ].size(); ++s )
+            keys.push_back( lineKey( _paths[ route ][ s - 1 ], _paths[ route ][ s ] ) );
+        _paths[ route ] = std::move( paths[ r ] );
+        for ( std::size_t s = 1; s < _paths[ route ].size(); ++s )
+            keys.push_back( lineKey( _paths[ route ][ s - 1 ], _paths[ route ][ s ] ) );
+        _offsets[ route ].assign( _paths[ route ].size() > 1 ? _paths[ route ].size() - 1 : 0, 0. );
+        indexRoute( route );
+        if ( _paths[ route ].size() < 2 ) {     // Not nudged
+            _routes[ route ] = _paths[ route ];
+            _changed.push_back( route );
+        }
+    }
+    nudge( keys );
+    _dirty.clear();
+    std::sort( _changed.begin(), _changed.end() );
+    _changed.erase( std::unique( _changed.begin(), _changed.end() ), _changed.end() );
+    return _changed;
+}
+
+inline auto OrthogonalRouter::routeOne( std::uint32_t route, Worker& worker ) const -> std::vector<Point>
+{
+    const auto src = _routeSrc[ route ];
+    const auto dst = _routeDst[ route ];
+    const auto& srcBox = _boxes[ src ];
+    const auto& dstBox = _boxes[ dst ];
+    const Point srcCenter{ ( srcBox.left + srcBox.right ) / 2., ( srcBox.top + srcBox.bottom ) / 2. };
+    const Point dstCenter{ ( dstBox.left + dstBox.right ) / 2., ( dstBox.top + dstBox.bottom ) / 2. };
+    const double loop = std::max( margin, 1. ) * 2.;
+    if ( src == dst )       // Self loop from right border to top border
+        return std::vector<Point>{ { srcBox.right, srcCenter.y }, { srcBox.right + loop, srcCenter.y },
+                                   { srcBox.right + loop, srcBox.top - loop }, { srcCenter.x, srcBox.top - loop },
+                                   { srcCenter.x, srcBox.top } };
+    if ( srcCenter.x == dstCenter.x && srcCenter.y == dstCenter.y )
+        return std::vector<Point>{};
+
+    // Obstacles containing an end point are not obstacles for this route
+    worker.ignored.clear();
+    for ( auto container = _container[ src ]; container != NoIndex; container = _container[ container ] )
+        worker.ignored.push_back( container );
+    for ( auto container = _container[ dst ]; container != NoIndex; container = _container[ container ] )
+        worker.ignored.push_back( container );
+
+    // Search in a window around end points, then in larger windows
+    const auto ends = srcBox.united( dstBox );
+    double expansion = 2. * margin + std::max( 100., std::max( ends.width(), ends.height() ) / 2. );
+    for ( int attempt = 0; attempt < 3; ++attempt, expansion *= 4. ) {
+        auto path = searchPath( src, dst, Box{ ends.left - expansion, ends.top - expansion,
+                                               ends.right + expansion, ends.bottom + expansion }, worker );
+        if ( !path.empty() )
+            return path;
+    }
+    // No route found, use a route ignoring obstacles
+    std::vector<Point> path{ srcCenter, Point{ dstCenter.x, srcCenter.y }, dstCenter };
+    finishPath( path, srcBox, dstBox );
+    return path;
+}
+
+inline auto OrthogonalRouter::searchPath( std::uint32_t src, std::uint32_t dst, const Box& window,
+                                          Worker& worker ) const -> std::vector<Point>
+{
+    const auto& srcBox = _boxes[ src ];
+    const auto& dstBox = _boxes[ dst ];
+    const Point srcCenter{ ( srcBox.left + srcBox.right ) / 2., ( srcBox.top + srcBox.bottom ) / 2. };
+    const Point dstCenter{ ( dstBox.left + dstBox.right ) / 2., ( dstBox.top + dstBox.bottom ) / 2. };
+
+    // Visibility grid lines: window borders, end points centers and obstacles borders expanded by margin
+    auto& obstacles = worker.obstacles;
+    auto& xs = worker.xs;
+    auto& ys = worker.ys;
+    obstacles.clear();
+    xs.assign( { window.left, window.right, srcCenter.x, dstCenter.x } );
+    ys.assign( { window.top, window.bottom, srcCenter.y, dstCenter.y } );
+    const auto& ignored = worker.ignored;
+    _obstacleIndex.visit( window, [&]( const std::uint32_t& obstacle, const Box& box ) {
+        if ( std::find( ignored.begin(), ignored.end(), obstacle ) != ignored.end() )
+            return;
+        obstacles.push_back( obstacle );
+        for ( const auto x : { box.left - margin, box.right + margin } )
+            if ( x > window.left && x < window.right )
+                xs.push_back( x );
+        for ( const auto y : { box.top - margin, box.bottom + margin } )
+            if ( y > window.top && y < window.bottom )
+                ys.push_back( y );
+    } );
+    std::sort( xs.begin(), xs.end() );
+    xs.erase( std::unique( xs.begin(), xs.end() ), xs.end() );
+    std::sort( ys.begin(), ys.end() );
+    ys.erase( std::unique( ys.begin(), ys.end() ), ys.end() );
+    const auto nx = xs.size();
+    const auto ny = ys.size();
+    constexpr std::size_t maxGridPoints = std::size_t{ 1 } << 20;
+    if ( nx * ny > maxGridPoints )
+        return std::vector<Point>{};
+    const auto indexOf = []( const std::vector<double>& values, double value ) -> std::size_t {
+        return static_cast<std::size_t>( std::lower_bound( values.begin(), values.end(), value ) - values.begin() );
+    };
+    const auto startX = indexOf( xs, srcCenter.x ), startY = indexOf( ys, srcCenter.y );
+    const auto goalX = indexOf( xs, dstCenter.x ), goalY = indexOf( ys, dstCenter.y );
+
+    // Block grid edges inside obstacles, end points obstacles can only be crossed on their center lines
+    auto& blockedH = worker.blockedH;       // Edge from (i, j) to (i + 1, j) at i + j * ( nx - 1 )
+    auto& blockedV = worker.blockedV;       // Edge from (i, j) to (i, j + 1) at i + j * nx
+    blockedH.assign( ( nx - 1 ) * ny, 0 );
+    blockedV.assign( nx * ( ny - 1 ), 0 );
+    constexpr auto none = std::numeric_limits<std::size_t>::max();
+    for ( const auto obstacle : obstacles ) {
+        const auto& box = _boxes[ obstacle ];
+        const double left = box.left - margin, right = box.right + margin;
+        const double top = box.top - margin, bottom = box.bottom + margin;
+        const auto exceptRow = obstacle == src ? startY : obstacle == dst ? goalY : none;
+        const auto exceptColumn = obstacle == src ? startX : obstacle == dst ? goalX : none;
+        const auto xBegin = indexOf( xs, left );
+        const auto xEnd = static_cast<std::size_t>( std::upper_bound( xs.begin(), xs.end(), right ) - xs.begin() );
+        const auto yBegin = indexOf( ys, top );
+        const auto yEnd = static_cast<std::size_t>( std::upper_bound( ys.begin(), ys.end(), bottom ) - ys.begin() );
+        // Rows and columns strictly inside obstacle
+        const auto rowBegin = static_cast<std::size_t>( std::upper_bound( ys.begin(), ys.end(), top ) - ys.begin() );
+        const auto rowEnd = indexOf( ys, bottom );
+        const auto columnBegin = static_cast<std::size_t>( std::upper_bound( xs.begin(), xs.end(), left ) - xs.begin() );
+        const auto columnEnd = indexOf( xs, right );
+        for ( auto j = rowBegin; j < rowEnd; ++j )
+            if ( j != exceptRow )
+                for ( auto i = xBegin; i + 1 < xEnd; ++i )
+                    blockedH[ i + j * ( nx - 1 ) ] = 1;
+        for ( auto i = columnBegin; i < columnEnd; ++i )
+            if ( i != exceptColumn )
+                for ( auto j = yBegin; j + 1 < yEnd; ++j )
+                    blockedV[ i + j * nx ] = 1;
+    }
+
+    // A* on (grid point, direction) states: directions are +x, -x, +y, -y, a direction change cost bendPenalty
+    const auto stateCount = nx * ny * 4;
+    auto& cost = worker.cost;
+    auto& previous = worker.previous;
+    auto& heap = worker.heap;
+    cost.assign( stateCount, std::numeric_limits<double>::max() );
+    previous.assign( stateCount, NoIndex );
+    heap.clear();
+    const auto heuristic = [&]( std::size_t i, std::size_t j ) -> double {
+        const double dx = std::abs( xs[ i ] - xs[ goalX ] );
+        const double dy = std::abs( ys[ j ] - ys[ goalY ] );
+        return dx + dy + ( dx > 0. && dy > 0. ? bendPenalty : 0. );
+    };
+    const auto push = [&heap]( double f, std::size_t state ) {
+        heap.emplace_back( f, static_cast<std::uint32_t>( state ) );
+        std::push_heap( heap.begin(), heap.end(), std::greater<std::pair<double, std::uint32_t>>{} );
+    };
+    const auto start = startX + startY * nx;
+    for ( std::size_t d = 0; d < 4; ++d ) {
+        cost[ start * 4 + d ] = 0.;
+        push( heuristic( startX, startY ), start * 4 + d );
+    }
+    std::size_t goalState = none;
+    while ( !heap.empty() ) {
+        std::pop_heap( heap.begin(), heap.end(), std::greater<std::pair<double, std::uint32_t>>{} );
+        const auto f = heap.back().first;
+        const std::size_t state = heap.back().second;
+        heap.pop_back();
+        const auto point = state / 4;
+        const auto direction = state % 4;
+        const auto i = point % nx, j = point / nx;
+        const double g = cost[ state ];
+        if ( f > g + heuristic( i, j ) + 1e-9 )     // Stale entry
+            continue;
+        if ( i == goalX && j == goalY ) {
+            goalState = state;
+            break;
+        }
+        for ( std::size_t d = 0; d < 4; ++d ) {
+            if ( ( d ^ 1 ) == direction )       // Never go back
+                continue;
+            std::size_t ni = i, nj = j;
+            bool blocked = false;
+            switch ( d ) {
+            case 0: blocked = i + 1 >= nx || blockedH[ i + j * ( nx - 1 ) ] != 0;     ni = i + 1; break;
+            case 1: blocked = i == 0 || blockedH[ ( i - 1 ) + j * ( nx - 1 ) ] != 0;  ni = i - 1; break;
+            case 2: blocked = j + 1 >= ny || blockedV[ i + j * nx ] != 0;             nj = j + 1; break;
+            default: blocked = j == 0 || blockedV[ i + ( j - 1 ) * nx ] != 0;         nj = j - 1; break;
+            }
+            if ( blocked )
+                continue;
+            const double next = g + std::abs( xs[ ni ] - xs[ i ] ) + std::abs( ys[ nj ] - ys[ j ] ) +
+                                ( d != direction ? bendPenalty : 0. );
+            const auto nextState = ( ni + nj * nx ) * 4 + d;
+            if ( next < cost[ nextState ] ) {
+                cost[ nextState ] = next;
+                previous[ nextState ] = static_cast<std::uint32_t>( state );
+                push( next + heuristic( ni, nj ), nextState );
+            }
+        }
+    }
+    if ( goalState == none )
+        return std::vector<Point>{};
+
+    std::vector<Point> path;
+    for ( auto state = goalState; state != NoIndex; state = previous[ state ] ) {
+        const auto point = state / 4;
+        path.push_back( Point{ xs[ point % nx ], ys[ point / nx ] } );
+    }
+    std::reverse( path.begin(), path.end() );
+    finishPath( path, srcBox, dstBox );
+    return path;
+}
+
+inline auto OrthogonalRouter::finishPath( std::vector<Point>& path, const Box& src, const Box& dst ) noexcept -> void
+{
+    std::size_t count = 0;
+    for ( const auto& point : path ) {
+        if ( count > 0 &&
+             point.x == path[ count - 1 ].x && point.y == path[ count - 1 ].y )
+            continue;
+        if ( count > 1 &&       // Extend a collinear segment
+             ( ( point.x == path[ count - 1 ].x && point.x == path[ count - 2 ].x ) ||
+               ( point.y == path[ count - 1 ].y && point.y == path[ count - 2 ].y ) ) ) {
+            path[ count - 1 ] = point;
+            continue;
+        }
+        path[ count++ ] = point;
+    }
+    path.resize( count );
+    if ( count < 2 )
+        return;
+
+    // Move end point to box border along segment, unless next point is inside box
+    const auto clip = []( Point& end, const Point& next, const Box& box ) {
+        if ( next.x >= box.left && next.x <= box.right &&
+             next.y >= box.top && next.y <= box.bottom )
+            return;
+        if ( end.x == next.x )
+            end.y = next.y < end.y ? box.top : box.bottom;
+        else
+            end.x = next.x < end.x ? box.left : box.right;
+    };
+    clip( path[ 0 ], path[ 1 ], src );
+    clip( path[ count - 1 ], path[ count - 2 ], dst );
+}
+
+inline auto OrthogonalRouter::lineKey( const Point& a, const Point& b ) noexcept -> std::int64_t
+{
+    const bool vertical = a.x == b.x;
+    return static_cast<std::int64_t>( std::llround( ( vertical ? a.x : a.y ) * 8. ) ) * 2 + ( vertical ? 1 : 0 );
+}
+
+inline auto OrthogonalRouter::nudge( std::vector<std::int64_t>& keys ) -> void
+{
+    std::sort( keys.begin(), keys.end() );
+    keys.erase( std::unique( keys.begin(), keys.end() ), keys.end() );
+    if ( keys.empty() )
+        return;
+
+    // Collect segments lying on nudged lines
+    struct Segment {
+        std::int64_t    key;
+        double          begin, end;
+        std::uint32_t   route, index;
+    };
+    std::vector<Segment> segments;
+    std::vector<std::uint32_t> routes;
+    for ( std::uint32_t route = 0; route < _paths.size(); ++route ) {
+        const auto& path = _paths[ route ];
+        bool nudged = false;
+        for ( std::size_t s = 1; s < path.size(); ++s ) {
+            const auto key = lineKey( path[ s - 1 ], path[ s ] );
+            if ( !std::binary_search( keys.begin(), keys.end(), key ) )
+                continue;
+            const bool vertical = ( key & 1 ) != 0;
+            const double a = vertical ? path[ s - 1 ].y : path[ s - 1 ].x;
+            const double b = vertical ? path[ s ].y : path[ s ].x;
+            segments.push_back( Segment{ key, std::min( a, b ), std::max( a, b ),
+                                         route, static_cast<std::uint32_t>( s - 1 ) } );
+            _offsets[ route ][ s - 1 ] = 0.;
+            nudged = true;
+        }
+        if ( nudged )
+            routes.push_back( route );
+    }
+    std::sort( segments.begin(), segments.end(), []( const Segment& a, const Segment& b ) {
+        return a.key != b.key ? a.key < b.key :
+               a.begin != b.begin ? a.begin < b.begin :
+               a.route != b.route ? a.route < b.route : a.index < b.index;
+    } );
+
+    // Overlapping segments on a line are assigned to distinct tracks, centered on the line
+    std::vector<double> trackEnds;
+    std::vector<std::uint32_t> tracks;
+    for ( std::size_t first = 0; first < segments.size(); ) {
+        auto last = first + 1;
+        double clusterEnd = segments[ first ].end;
+        while ( last < segments.size() &&
+                segments[ last ].key == segments[ first ].key &&
+                segments[ last ].begin < clusterEnd ) {
+            clusterEnd = std::max( clusterEnd, segments[ last ].end );
+            ++last;
+        }
+        if ( last - first > 1 ) {
+            trackEnds.clear();
+            tracks.clear();
+            for ( auto s = first; s < last; ++s ) {
+                std::size_t track = 0;
+                while ( track < trackEnds.size() && trackEnds[ track ] > segments[ s ].begin )
+                    ++track;
+                if ( track == trackEnds.size() )
+                    trackEnds.push_back( segments[ s ].end );
+                else
+                    trackEnds[ track ] = segments[ s ].end;
+                tracks.push_back( static_cast<std::uint32_t>( track ) );
+            }
+            const double center = ( static_cast<double>( trackEnds.size() ) - 1. ) / 2.;
+            for ( auto s = first; s < last; ++s )
+                _offsets[ segments[ s ].route ][ segments[ s ].index ] = ( tracks[ s - first ] - center ) * nudgeSpacing;
+        }
+        first = last;
+    }
+
+    // Apply offsets, end segments stay on their end point obstacle border
+    std::vector<Point> nudged;
+    for ( const auto route : routes ) {
+        const auto& path = _paths[ route ];
+        auto& offsets = _offsets[ route ];
+        nudged = path;
+        const auto segmentCount = path.size() - 1;
+        for ( std::size_t s = 0; s < segmentCount; ++s ) {
+            if ( offsets[ s ] == 0. )
+                continue;
+            const bool vertical = path[ s ].x == path[ s + 1 ].x;
+            for ( const auto obstacle : { s == 0 ? _routeSrc[ route ] : NoIndex,
+                                          s + 1 == segmentCount ? _routeDst[ route ] : NoIndex } ) {
+                if ( obstacle == NoIndex )
+                    continue;
+                const auto& box = _boxes[ obstacle ];
+                const double low = ( vertical ? box.left : box.top ) + 1.;
+                const double high = ( vertical ? box.right : box.bottom ) - 1.;
+                const double value = vertical ? path[ s ].x : path[ s ].y;
+                offsets[ s ] = low > high ? 0. : std::min( std::max( value + offsets[ s ], low ), high ) - value;
+            }
+            for ( auto p = s; p <= s + 1; ++p )
+                ( vertical ? nudged[ p ].x : nudged[ p ].y ) += offsets[ s ];
+        }
+        auto& current = _routes[ route ];
+        const bool modified = current.size() != nudged.size() ||
+                              !std::equal( current.begin(), current.end(), nudged.begin(),
+                                           []( const Point& a, const Point& b ) { return a.x == b.x && a.y == b.y; } );
+        if ( modified ) {
+            current.swap( nudged );
+            _changed.push_back( route );
+        }
+    }
+}
+//-----------------------------------------------------------------------------
+
+} // ::gtpo
@@ -0,0 +1,312 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoOutOfCoreGraph.h
+// \author	benoit@destrat.io
+// \date	2017 12 10
+//-----------------------------------------------------------------------------
+
+#ifndef gtpoOutOfCoreGraph_h
+#define gtpoOutOfCoreGraph_h
+
+// STD headers
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint64_t
+#include <string>
+#include <vector>
+#include <memory>       // std::unique_ptr
+
+// GTpo headers
+#include "./gtpoUtils.h"
+#include "./gtpoPagedFile.h"
+#include "./gtpoProgressNotifier.h"
+
+namespace gtpo { // ::gtpo
+
+/*! \brief Out-of-core read only directed graph for graphs larger than RAM.
+ *
+ * Graph is stored in a set of paged files sharing a common \c basePath prefix, only a bounded set of hot
+ * pages is kept in memory (see gtpo::PagedFile):
+ * \li \c basePath.meta: node and edge count, nodes bounding rectangle, spatial grid size.
+ * \li \c basePath.x, \c basePath.y: node position attribute columns.
+ * \li \c basePath.out.offsets, \c basePath.out.targets, \c basePath.weights: out adjacency in CSR form
+ * (out edges of node n are edge ids [offsets[n], offsets[n+1]) ) and edge weight attribute column.
+ * \li \c basePath.in.offsets, \c basePath.in.sources: in adjacency in CSR form.
+ * \li \c basePath.cells, \c basePath.cells.offsets: nodes bucketed in a uniform spatial grid, used for
+ * viewport queries (see visitNodesIn()).
+ *
+ * Out-of-core graphs are created with gtpo::OutOfCoreGraphBuilder. Adjacency ranges returned by getOutNodes()
+ * and getInNodes() are iterated with page aware iterators that prefetch the next page.
+ *
+ * \code
+ *  gtpo::OutOfCoreGraph graph{ "capture" };
+ *  for ( auto target : graph.getOutNodes( 42 ) )
+ *    std::cout << target << std::endl;
+ *  graph.visitNodesIn( { 0.f, 0.f, 1000.f, 1000.f }, []( gtpo::OutOfCoreGraph::NodeId node, gtpo::OutOfCoreGraph::Point p ) { } );
+ * \endcode
+ *
+ * \nosubgrouping
+ */
+class OutOfCoreGraph
+{
+    /*! \name OutOfCoreGraph Object Management *///----------------------------
+    //@{
+public:
+    using NodeId    = std::uint64_t;
+    using EdgeId    = std::uint64_t;
+
+    struct Point {
+        float   x = 0.f;
+        float   y = 0.f;
+    };
+
+    struct Rect {
+        float   x = 0.f;
+        float   y = 0.f;
+        float   width = 0.f;
+        float   height = 0.f;
+        inline auto contains( const Point& p ) const noexcept -> bool { return p.x >= x && p.y >= y && p.x <= x + width && p.y <= y + height; }
+    };
+
+    //! Spatial grid cell entry: node id and node position, stored together for sequential access.
+    struct CellEntry {
+        NodeId  node = 0;
+        Point   position;
+    };
+
+    /*! \brief Open out-of-core graph \c basePath files, with at most \c cacheSize bytes of cached pages for each file.
+     *
+     * \throw gtpo::bad_storage_error if a graph file is missing or corrupted.
+     */
+    explicit OutOfCoreGraph( const std::string& basePath,
+                             std::size_t cacheSize = 16 * 1024 * 1024,
+                             std::size_t pageSize = 64 * 1024 ) noexcept( false );
+    ~OutOfCoreGraph() noexcept = default;
+    OutOfCoreGraph( const OutOfCoreGraph& ) = delete;
+    OutOfCoreGraph& operator=( const OutOfCoreGraph& ) = delete;
+
+    inline auto     getBasePath() const noexcept -> const std::string& { return _basePath; }
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Topology Management *///-----------------------------------------
+    //@{
+public:
+    using NodeRange = PagedColumn<NodeId>::Range;
+
+    inline auto     getNodeCount() const noexcept -> std::uint64_t { return _nodeCount; }
+    inline auto     getEdgeCount() const noexcept -> std::uint64_t { return _edgeCount; }
+
+    //! Return \c node out degree.
+    auto            getOutDegree( NodeId node ) const noexcept( false ) -> std::uint64_t;
+    //! Return \c node in degree.
+    auto            getInDegree( NodeId node ) const noexcept( false ) -> std::uint64_t;
+
+    //! Return \c node out edges ids range [first, last), out edge \c e target is getEdgeTarget(e).
+    auto            getOutEdges( NodeId node ) const noexcept( false ) -> std::pair<EdgeId, EdgeId>;
+    //! Return edge \c edge target node.
+    auto            getEdgeTarget( EdgeId edge ) const noexcept( false ) -> NodeId;
+    //! Return edge \c edge weight.
+    auto            getEdgeWeight( EdgeId edge ) const noexcept( false ) -> float;
+
+    //! Return a page aware range on \c node out nodes (an out node is repeated for parallel edges).
+    auto            getOutNodes( NodeId node ) const noexcept( false ) -> NodeRange;
+    //! Return a page aware range on \c node in nodes (an in node is repeated for parallel edges).
+    auto            getInNodes( NodeId node ) const noexcept( false ) -> NodeRange;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Geometry Management *///-----------------------------------------
+    //@{
+public:
+    //! Bounding rectangle of all nodes positions.
+    inline auto     getBounds() const noexcept -> const Rect& { return _bounds; }
+
+    //! Return \c node position.
+    auto            getPosition( NodeId node ) const noexcept( false ) -> Point;
+
+    /*! \brief Call \c visitor( NodeId, Point ) for every node whose position is inside \c rect.
+     *
+     * Only spatial grid cells intersecting \c rect are read, cell content is read sequentially.
+     * Visit stop if visitor return false (visitor might also return void).
+     */
+    template < class Visitor >
+    auto            visitNodesIn( const Rect& rect, Visitor visitor ) const noexcept( false ) -> void;
+
+    //! Return at most \c maxCount nodes whose position is inside \c rect.
+    auto            getNodesIn( const Rect& rect, std::size_t maxCount = ~std::size_t{0} ) const noexcept( false ) -> std::vector<NodeId>;
+
+public:
+    //! Return index of spatial grid cell containing \c p, for a \c columns x \c rows grid covering \c bounds.
+    static auto     getCell( const Point& p, const Rect& bounds,
+                             std::uint32_t columns, std::uint32_t rows ) noexcept -> std::uint64_t;
+private:
+    //! Return grid cell range [first, last] covered by \c rect, false if \c rect does not intersect graph bounds.
+    auto            cellRange( const Rect& rect, std::uint32_t& c0, std::uint32_t& r0,
+                               std::uint32_t& c1, std::uint32_t& r1 ) const noexcept -> bool;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Storage Management *///------------------------------------------
+    //@{
+public:
+    //! Paged file and a column of records of type \c T stored in this file.
+    template < class T >
+    struct ColumnFile {
+        ColumnFile( const std::string& fileName, PagedFile::Mode mode, std::size_t pageSize, std::size_t cacheSize ) noexcept( false ) :
+            file( fileName, mode, pageSize, cacheSize / pageSize ), column( file ) { }
+        PagedFile       file;
+        PagedColumn<T>  column;
+    };
+
+    //! Meta file magic number ("GTOC").
+    static constexpr std::uint32_t  metaMagic = 0x434F5447;
+    //! Current storage format version.
+    static constexpr std::uint32_t  metaVersion = 1;
+
+private:
+    std::string     _basePath;
+    std::uint64_t   _nodeCount = 0;
+    std::uint64_t   _edgeCount = 0;
+    Rect            _bounds;
+    std::uint32_t   _gridColumns = 1;
+    std::uint32_t   _gridRows = 1;
+    //! Spatial grid cells offsets in cells column (gridColumns * gridRows + 1 entries), small enough to stay in memory.
+    std::vector<std::uint64_t>  _cellOffsets;
+
+    std::unique_ptr<ColumnFile<float>>      _x;
+    std::unique_ptr<ColumnFile<float>>      _y;
+    std::unique_ptr<ColumnFile<EdgeId>>     _outOffsets;
+    std::unique_ptr<ColumnFile<NodeId>>     _outTargets;
+    std::unique_ptr<ColumnFile<float>>      _weights;
+    std::unique_ptr<ColumnFile<EdgeId>>     _inOffsets;
+    std::unique_ptr<ColumnFile<NodeId>>     _inSources;
+    std::unique_ptr<ColumnFile<CellEntry>>  _cells;
+    //@}
+    //-------------------------------------------------------------------------
+};
+
+/*! \brief Build a gtpo::OutOfCoreGraph storage without loading the whole graph in memory.
+ *
+ * Nodes and edges are streamed to disk as they are added, build() then generate CSR adjacency and spatial
+ * grid with paged random writes, only a per grid cell counter array is allocated in memory.
+ *
+ * \code
+ *  gtpo::OutOfCoreGraphBuilder builder{ "capture" };
+ *  const auto a = builder.addNode( 0.f, 0.f );
+ *  const auto b = builder.addNode( 100.f, 50.f );
+ *  builder.addEdge( a, b );
+ *  builder.build();
+ *  gtpo::OutOfCoreGraph graph{ "capture" };
+ * \endcode
+ * \nosubgrouping
+ */
+class OutOfCoreGraphBuilder
+{
+    /*! \name OutOfCoreGraphBuilder Object Management *///---------------------
+    //@{
+public:
+    using NodeId    = OutOfCoreGraph::NodeId;
+    using Point     = OutOfCoreGraph::Point;
+
+    /*! \brief Create a builder generating \c basePath storage files (existing files are overwritten).
+     *
+     * \throw gtpo::bad_storage_error if storage files could not be created.
+     */
+    explicit OutOfCoreGraphBuilder( const std::string& basePath,
+                                    std::size_t cacheSize = 16 * 1024 * 1024,
+                                    std::size_t pageSize = 64 * 1024 ) noexcept( false );
+    //! Remove temporary files.
+    ~OutOfCoreGraphBuilder() noexcept;
+    OutOfCoreGraphBuilder( const OutOfCoreGraphBuilder& ) = delete;
+    OutOfCoreGraphBuilder& operator=( const OutOfCoreGraphBuilder& ) = delete;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Graph Construction *///------------------------------------------
+    //@{
+public:
+    //! Add a node at position (\c x, \c y) and return its id (ids are allocated sequentially from 0).
+    auto            addNode( float x, float y ) noexcept( false ) -> NodeId;
+
+    /*! \brief Add a directed edge from \c source to \c target with weight \c weight.
+     *
+     * \throw gtpo::bad_topology_error if \c source or \c target has not been added.
+     */
+    auto            addEdge( NodeId source, NodeId target, float weight = 1.f ) noexcept( false ) -> void;
+
+    inline auto     getNodeCount() const noexcept -> std::uint64_t { return _nodeCount; }
+    inline auto     getEdgeCount() const noexcept -> std::uint64_t { return _edgeCount; }
+
+    /*! \brief Generate adjacency, spatial grid and meta files, builder could not be used after build().
+     *
+     * \param cellCapacity  average number of nodes per spatial grid cell.
+     * \throw gtpo::bad_storage_error on IO error.
+     */
+    auto            build( gtpo::IProgressNotifier* progress = nullptr, std::size_t cellCapacity = 64 ) noexcept( false ) -> void;
+
+private:
+    //! Edge record in temporary edge list file.
+    struct EdgeRecord {
+        NodeId          source = 0;
+        NodeId          target = 0;
+        float           weight = 1.f;
+        std::uint32_t   padding = 0;
+    };
+
+    //! Build a CSR adjacency (\c offsets, \c adjacents) using \c key edge source as key and \c value as adjacent node.
+    template < class Key, class Value, class Attribute >
+    auto            buildAdjacency( PagedColumn<std::uint64_t>& offsets, PagedColumn<NodeId>& adjacents,
+                                    Key key, Value value, Attribute attribute,
+                                    gtpo::IProgressNotifier& progress ) noexcept( false ) -> void;
+
+    auto            buildSpatialGrid( std::size_t cellCapacity, gtpo::IProgressNotifier& progress ) noexcept( false ) -> void;
+
+private:
+    std::string     _basePath;
+    std::size_t     _cacheSize;
+    std::size_t     _pageSize;
+    std::uint64_t   _nodeCount = 0;
+    std::uint64_t   _edgeCount = 0;
+    bool            _built = false;
+    OutOfCoreGraph::Rect    _bounds;
+    std::unique_ptr<OutOfCoreGraph::ColumnFile<float>>      _x;
+    std::unique_ptr<OutOfCoreGraph::ColumnFile<float>>      _y;
+    std::unique_ptr<OutOfCoreGraph::ColumnFile<EdgeRecord>> _edges;
+    std::uint32_t   _gridColumns = 1;
+    std::uint32_t   _gridRows = 1;
+    //@}
+    //-------------------------------------------------------------------------
+};
+
+} // ::gtpo
+
+#include "./gtpoOutOfCoreGraph.hpp"
+
+#endif // gtpoOutOfCoreGraph_h
@@ -0,0 +1,438 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoOutOfCoreGraph.hpp
+// \author	benoit@destrat.io
+// \date	2017 12 10
+//-----------------------------------------------------------------------------
+
+// STD headers
+#include <cmath>        // std::ceil, std::sqrt
+#include <cstdio>       // std::remove
+#include <fstream>
+#include <algorithm>    // std::min, std::max
+#include <limits>
+#include <type_traits>
+
+namespace gtpo { // ::gtpo
+
+namespace impl { // ::gtpo::impl
+
+//! Call a visitor returning bool and return its result.
+template < class Visitor, class... Args >
+auto    visit( Visitor& visitor, Args&&... args ) ->
+            typename std::enable_if< std::is_same< decltype( visitor( std::forward<Args>(args)... ) ), bool >::value, bool >::type
+{
+    return visitor( std::forward<Args>(args)... );
+}
+
+//! Call a visitor returning void, visit always continue.
+template < class Visitor, class... Args >
+auto    visit( Visitor& visitor, Args&&... args ) ->
+            typename std::enable_if< !std::is_same< decltype( visitor( std::forward<Args>(args)... ) ), bool >::value, bool >::type
+{
+    visitor( std::forward<Args>(args)... );
+    return true;
+}
+
+//! Write a trivially copyable \c value to binary output stream \c output.
+template < class T >
+auto    writeBinary( std::ostream& output, const T& value ) -> void
+{
+    output.write( reinterpret_cast<const char*>( &value ), sizeof(T) );
+}
+
+//! Read a trivially copyable \c value from binary input stream \c input.
+template < class T >
+auto    readBinary( std::istream& input, T& value ) -> void
+{
+    input.read( reinterpret_cast<char*>( &value ), sizeof(T) );
+}
+
+} // ::gtpo::impl
+
+/* OutOfCoreGraph Object Management *///---------------------------------------
+inline OutOfCoreGraph::OutOfCoreGraph( const std::string& basePath,
+                                       std::size_t cacheSize,
+                                       std::size_t pageSize ) :
+    _basePath( basePath )
+{
+    std::ifstream meta{ basePath + ".meta", std::ios::binary };
+    if ( !meta )
+        throw gtpo::bad_storage_error( "gtpo::OutOfCoreGraph::OutOfCoreGraph(): Error: Can't open " + basePath + ".meta" );
+    std::uint32_t magic = 0, version = 0;
+    impl::readBinary( meta, magic );
+    impl::readBinary( meta, version );
+    if ( !meta || magic != metaMagic || version > metaVersion )
+        throw gtpo::bad_storage_error( "gtpo::OutOfCoreGraph::OutOfCoreGraph(): Error: " + basePath + " is not a valid GTpo out-of-core graph." );
+    impl::readBinary( meta, _nodeCount );
+    impl::readBinary( meta, _edgeCount );
+    impl::readBinary( meta, _bounds );
+    impl::readBinary( meta, _gridColumns );
+    impl::readBinary( meta, _gridRows );
+    if ( !meta || _gridColumns == 0 || _gridRows == 0 )
+        throw gtpo::bad_storage_error( "gtpo::OutOfCoreGraph::OutOfCoreGraph(): Error: " + basePath + ".meta is corrupted." );
+
+    // Topology files are accessed randomly, cell files mostly sequentially, use a smaller cache for geometry columns
+    const auto mode = PagedFile::Mode::ReadOnly;
+    _x          = std::make_unique<ColumnFile<float>>( basePath + ".x", mode, pageSize, cacheSize / 2 );
+    _y          = std::make_unique<ColumnFile<float>>( basePath + ".y", mode, pageSize, cacheSize / 2 );
+    _outOffsets = std::make_unique<ColumnFile<EdgeId>>( basePath + ".out.offsets", mode, pageSize, cacheSize );
+    _outTargets = std::make_unique<ColumnFile<NodeId>>( basePath + ".out.targets", mode, pageSize, cacheSize );
+    _weights    = std::make_unique<ColumnFile<float>>( basePath + ".weights", mode, pageSize, cacheSize / 2 );
+    _inOffsets  = std::make_unique<ColumnFile<EdgeId>>( basePath + ".in.offsets", mode, pageSize, cacheSize );
+    _inSources  = std::make_unique<ColumnFile<NodeId>>( basePath + ".in.sources", mode, pageSize, cacheSize );
+    _cells      = std::make_unique<ColumnFile<CellEntry>>( basePath + ".cells", mode, pageSize, cacheSize );
+
+    ColumnFile<std::uint64_t> cellOffsets{ basePath + ".cells.offsets", mode, pageSize, cacheSize };
+    const auto cellCount = static_cast<std::uint64_t>( _gridColumns ) * _gridRows;
+    if ( cellOffsets.column.size() != cellCount + 1 ||
+         _outOffsets->column.size() != _nodeCount + 1 ||
+         _inOffsets->column.size() != _nodeCount + 1 ||
+         _x->column.size() != _nodeCount ||
+         _y->column.size() != _nodeCount )
+        throw gtpo::bad_storage_error( "gtpo::OutOfCoreGraph::OutOfCoreGraph(): Error: " + basePath + " storage files are inconsistent." );
+    _cellOffsets.reserve( static_cast<std::size_t>( cellCount + 1 ) );
+    for ( const auto offset : cellOffsets.column )
+        _cellOffsets.push_back( offset );
+}
+//-----------------------------------------------------------------------------
+
+/* Topology Management *///----------------------------------------------------
+inline auto OutOfCoreGraph::getOutDegree( NodeId node ) const -> std::uint64_t
+{
+    const auto edges = getOutEdges( node );
+    return edges.second - edges.first;
+}
+
+inline auto OutOfCoreGraph::getInDegree( NodeId node ) const -> std::uint64_t
+{
+    return getInNodes( node ).size();
+}
+
+inline auto OutOfCoreGraph::getOutEdges( NodeId node ) const -> std::pair<EdgeId, EdgeId>
+{
+    if ( node >= _nodeCount )
+        throw gtpo::bad_topology_error( "gtpo::OutOfCoreGraph::getOutEdges(): Error: Invalid node id." );
+    return std::make_pair( _outOffsets->column.get( node ), _outOffsets->column.get( node + 1 ) );
+}
+
+inline auto OutOfCoreGraph::getEdgeTarget( EdgeId edge ) const -> NodeId
+{
+    if ( edge >= _edgeCount )
+        throw gtpo::bad_topology_error( "gtpo::OutOfCoreGraph::getEdgeTarget(): Error: Invalid edge id." );
+    return _outTargets->column.get( edge );
+}
+
+inline auto OutOfCoreGraph::getEdgeWeight( EdgeId edge ) const -> float
+{
+    if ( edge >= _edgeCount )
+        throw gtpo::bad_topology_error( "gtpo::OutOfCoreGraph::getEdgeWeight(): Error: Invalid edge id." );
+    return _weights->column.get( edge );
+}
+
+inline auto OutOfCoreGraph::getOutNodes( NodeId node ) const -> NodeRange
+{
+    const auto edges = getOutEdges( node );
+    return _outTargets->column.range( edges.first, edges.second );
+}
+
+inline auto OutOfCoreGraph::getInNodes( NodeId node ) const -> NodeRange
+{
+    if ( node >= _nodeCount )
+        throw gtpo::bad_topology_error( "gtpo::OutOfCoreGraph::getInNodes(): Error: Invalid node id." );
+    return _inSources->column.range( _inOffsets->column.get( node ), _inOffsets->column.get( node + 1 ) );
+}
+//-----------------------------------------------------------------------------
+
+/* Geometry Management *///----------------------------------------------------
+inline auto OutOfCoreGraph::getPosition( NodeId node ) const -> Point
+{
+    if ( node >= _nodeCount )
+        throw gtpo::bad_topology_error( "gtpo::OutOfCoreGraph::getPosition(): Error: Invalid node id." );
+    Point p;
+    p.x = _x->column.get( node );
+    p.y = _y->column.get( node );
+    return p;
+}
+
+template < class Visitor >
+auto    OutOfCoreGraph::visitNodesIn( const Rect& rect, Visitor visitor ) const -> void
+{
+    std::uint32_t c0 = 0, r0 = 0, c1 = 0, r1 = 0;
+    if ( !cellRange( rect, c0, r0, c1, r1 ) )
+        return;
+    for ( auto r = r0; r <= r1; ++r ) {
+        // Cells [c0, c1] of a row are contiguous in cells column: read them in one sequential range
+        const auto first = _cellOffsets[static_cast<std::size_t>( r ) * _gridColumns + c0];
+        const auto last = _cellOffsets[static_cast<std::size_t>( r ) * _gridColumns + c1 + 1];
+        for ( const auto entry : _cells->column.range( first, last ) ) {
+            if ( rect.contains( entry.position ) &&
+                 !impl::visit( visitor, entry.node, entry.position ) )
+                return;
+        }
+    }
+}
+
+inline auto OutOfCoreGraph::getNodesIn( const Rect& rect, std::size_t maxCount ) const -> std::vector<NodeId>
+{
+    std::vector<NodeId> nodes;
+    if ( maxCount == 0 )
+        return nodes;
+    visitNodesIn( rect, [&nodes, maxCount]( NodeId node, const Point& ) -> bool {
+        nodes.push_back( node );
+        return nodes.size() < maxCount;
+    } );
+    return nodes;
+}
+
+inline auto OutOfCoreGraph::getCell( const Point& p, const Rect& bounds,
+                                     std::uint32_t columns, std::uint32_t rows ) noexcept -> std::uint64_t
+{
+    const auto cellCoordinate = []( float v, float origin, float extent, std::uint32_t count ) -> std::uint32_t {
+        if ( extent <= 0.f || v <= origin )
+            return 0;
+        const auto c = static_cast<double>( v - origin ) / extent * count;
+        return c >= count ? count - 1 : static_cast<std::uint32_t>( c );
+    };
+    const auto column = cellCoordinate( p.x, bounds.x, bounds.width, columns );
+    const auto row = cellCoordinate( p.y, bounds.y, bounds.height, rows );
+    return static_cast<std::uint64_t>( row ) * columns + column;
+}
+
+inline auto OutOfCoreGraph::cellRange( const Rect& rect, std::uint32_t& c0, std::uint32_t& r0,
+                                       std::uint32_t& c1, std::uint32_t& r1 ) const noexcept -> bool
+{
+    if ( _nodeCount == 0 ||
+         rect.x > _bounds.x + _bounds.width || rect.x + rect.width < _bounds.x ||
+         rect.y > _bounds.y + _bounds.height || rect.y + rect.height < _bounds.y )
+        return false;
+    Point topLeft; topLeft.x = rect.x; topLeft.y = rect.y;
+    Point bottomRight; bottomRight.x = rect.x + rect.width; bottomRight.y = rect.y + rect.height;
+    const auto first = getCell( topLeft, _bounds, _gridColumns, _gridRows );
+    const auto last = getCell( bottomRight, _bounds, _gridColumns, _gridRows );
+    c0 = static_cast<std::uint32_t>( first % _gridColumns );
+    r0 = static_cast<std::uint32_t>( first / _gridColumns );
+    c1 = static_cast<std::uint32_t>( last % _gridColumns );
+    r1 = static_cast<std::uint32_t>( last / _gridColumns );
+    return true;
+}
+//-----------------------------------------------------------------------------
+
+/* OutOfCoreGraphBuilder Object Management *///--------------------------------
+inline OutOfCoreGraphBuilder::OutOfCoreGraphBuilder( const std::string& basePath,
+                                                     std::size_t cacheSize,
+                                                     std::size_t pageSize ) :
+    _basePath( basePath ),
+    _cacheSize( cacheSize ),
+    _pageSize( pageSize )
+{
+    const auto mode = PagedFile::Mode::Truncate;
+    _x      = std::make_unique<OutOfCoreGraph::ColumnFile<float>>( basePath + ".x", mode, pageSize, cacheSize / 4 );
+    _y      = std::make_unique<OutOfCoreGraph::ColumnFile<float>>( basePath + ".y", mode, pageSize, cacheSize / 4 );
+    _edges  = std::make_unique<OutOfCoreGraph::ColumnFile<EdgeRecord>>( basePath + ".edges.tmp", mode, pageSize, cacheSize / 4 );
+    _bounds.x = _bounds.y = std::numeric_limits<float>::max();
+    _bounds.width = _bounds.height = 0.f;
+}
+
+inline OutOfCoreGraphBuilder::~OutOfCoreGraphBuilder() noexcept
+{
+    _edges.reset();
+    std::remove( ( _basePath + ".edges.tmp" ).c_str() );
+}
+//-----------------------------------------------------------------------------
+
+/* Graph Construction *///-----------------------------------------------------
+inline auto OutOfCoreGraphBuilder::addNode( float x, float y ) -> NodeId
+{
+    if ( _built )
+        throw gtpo::bad_storage_error( "gtpo::OutOfCoreGraphBuilder::addNode(): Error: Graph has already been built." );
+    _x->column.push_back( x );
+    _y->column.push_back( y );
+    if ( _nodeCount == 0 ) {
+        _bounds.x = x; _bounds.y = y;
+        _bounds.width = _bounds.height = 0.f;
+    } else {
+        const auto right = std::max( _bounds.x + _bounds.width, x );
+        const auto bottom = std::max( _bounds.y + _bounds.height, y );
+        _bounds.x = std::min( _bounds.x, x );
+        _bounds.y = std::min( _bounds.y, y );
+        _bounds.width = right - _bounds.x;
+        _bounds.height = bottom - _bounds.y;
+    }
+    return _nodeCount++;
+}
+
+inline auto OutOfCoreGraphBuilder::addEdge( NodeId source, NodeId target, float weight ) -> void
+{
+    if ( _built )
+        throw gtpo::bad_storage_error( "gtpo::OutOfCoreGraphBuilder::addEdge(): Error: Graph has already been built." );
+    if ( source >= _nodeCount || target >= _nodeCount )
+        throw gtpo::bad_topology_error( "gtpo::OutOfCoreGraphBuilder::addEdge(): Error: Invalid source or target node id." );
+    EdgeRecord record;
+    record.source = source;
+    record.target = target;
+    record.weight = weight;
+    _edges->column.set( _edgeCount++, record );
+}
+
+inline auto OutOfCoreGraphBuilder::build( gtpo::IProgressNotifier* progress, std::size_t cellCapacity ) -> void
+{
+    if ( _built )
+        throw gtpo::bad_storage_error( "gtpo::OutOfCoreGraphBuilder::build(): Error: Graph has already been built." );
+    _built = true;
+    gtpo::IProgressNotifier nilProgress;
+    auto& buildProgress = progress != nullptr ? *progress : nilProgress;
+    buildProgress.reserveSubProgress( 3 );
+    _x->file.flush();
+    _y->file.flush();
+    _edges->file.flush();
+
+    {   // Out adjacency and edge weights
+        const auto mode = PagedFile::Mode::Truncate;
+        OutOfCoreGraph::ColumnFile<std::uint64_t>   offsets{ _basePath + ".out.offsets", mode, _pageSize, _cacheSize / 4 };
+        OutOfCoreGraph::ColumnFile<NodeId>          targets{ _basePath + ".out.targets", mode, _pageSize, _cacheSize / 4 };
+        OutOfCoreGraph::ColumnFile<float>           weights{ _basePath + ".weights", mode, _pageSize, _cacheSize / 4 };
+        buildAdjacency( offsets.column, targets.column,
+                        []( const EdgeRecord& edge ) { return edge.source; },
+                        []( const EdgeRecord& edge ) { return edge.target; },
+                        [&weights]( std::uint64_t e, const EdgeRecord& edge ) { weights.column.set( e, edge.weight ); },
+                        buildProgress.takeSubProgress() );
+        offsets.file.flush(); targets.file.flush(); weights.file.flush();
+    }
+    {   // In adjacency
+        const auto mode = PagedFile::Mode::Truncate;
+        OutOfCoreGraph::ColumnFile<std::uint64_t>   offsets{ _basePath + ".in.offsets", mode, _pageSize, _cacheSize / 4 };
+        OutOfCoreGraph::ColumnFile<NodeId>          sources{ _basePath + ".in.sources", mode, _pageSize, _cacheSize / 4 };
+        buildAdjacency( offsets.column, sources.column,
+                        []( const EdgeRecord& edge ) { return edge.target; },
+                        []( const EdgeRecord& edge ) { return edge.source; },
+                        []( std::uint64_t, const EdgeRecord& ) { },
+                        buildProgress.takeSubProgress() );
+        offsets.file.flush(); sources.file.flush();
+    }
+    buildSpatialGrid( cellCapacity, buildProgress.takeSubProgress() );
+
+    std::ofstream meta{ _basePath + ".meta", std::ios::binary | std::ios::trunc };
+    const std::uint32_t magic = OutOfCoreGraph::metaMagic;      // Copy static constexpr, writeBinary() odr-use its argument
+    const std::uint32_t version = OutOfCoreGraph::metaVersion;
+    impl::writeBinary( meta, magic );
+    impl::writeBinary( meta, version );
+    impl::writeBinary( meta, _nodeCount );
+    impl::writeBinary( meta, _edgeCount );
+    const auto bounds = _nodeCount > 0 ? _bounds : OutOfCoreGraph::Rect{};
+    impl::writeBinary( meta, bounds );
+    impl::writeBinary( meta, _gridColumns );
+    impl::writeBinary( meta, _gridRows );
+    meta.flush();
+    if ( !meta )
+        throw gtpo::bad_storage_error( "gtpo::OutOfCoreGraphBuilder::build(): Error: Can't write " + _basePath + ".meta" );
+    buildProgress.setProgress( 1. );
+}
+
+template < class Key, class Value, class Attribute >
+auto    OutOfCoreGraphBuilder::buildAdjacency( PagedColumn<std::uint64_t>& offsets, PagedColumn<NodeId>& adjacents,
+                                               Key key, Value value, Attribute attribute,
+                                               gtpo::IProgressNotifier& progress ) -> void
+{
+    // Classical two pass CSR construction: offsets[k+1] first count node k degree, then after an exclusive
+    // prefix sum store node k insertion cursor, once edges are scattered, offsets[k+1] is node k+1 start.
+    static constexpr std::uint64_t progressStep = 64 * 1024;
+    const auto steps = static_cast<double>( 2 * _edgeCount + _nodeCount + 1 );
+    offsets.set( _nodeCount, 0 );       // Allocate _nodeCount + 1 zero initialized offsets
+    std::uint64_t e = 0;
+    for ( auto edge = _edges->column.begin(); edge != _edges->column.end(); ++edge, ++e ) {
+        const auto k = key( *edge ) + 1;
+        offsets.set( k, offsets.get( k ) + 1 );
+        if ( e % progressStep == 0 )
+            progress.setProgress( e / steps );
+    }
+    std::uint64_t start = 0;
+    for ( std::uint64_t k = 0; k < _nodeCount; ++k ) {
+        const auto degree = offsets.get( k + 1 );
+        offsets.set( k + 1, start );
+        start += degree;
+    }
+    e = 0;
+    for ( auto edge = _edges->column.begin(); edge != _edges->column.end(); ++edge, ++e ) {
+        const auto record = *edge;
+        const auto k = key( record ) + 1;
+        const auto position = offsets.get( k );
+        offsets.set( k, position + 1 );
+        adjacents.set( position, value( record ) );
+        attribute( position, record );
+        if ( e % progressStep == 0 )
+            progress.setProgress( ( _edgeCount + _nodeCount + e ) / steps );
+    }
+    progress.setProgress( 1. );
+}
+
+inline auto OutOfCoreGraphBuilder::buildSpatialGrid( std::size_t cellCapacity, gtpo::IProgressNotifier& progress ) -> void
+{
+    // Cell counters are the only per-build memory allocation: grid size is bounded to 1024x1024 cells
+    cellCapacity = std::max( std::size_t{1}, cellCapacity );
+    const auto cellCount = std::max( std::uint64_t{1}, ( _nodeCount + cellCapacity - 1 ) / cellCapacity );
+    const auto side = std::min( std::uint32_t{1024},
+                                std::max( std::uint32_t{1}, static_cast<std::uint32_t>( std::ceil( std::sqrt( static_cast<double>( cellCount ) ) ) ) ) );
+    _gridColumns = _gridRows = side;
+    const auto bounds = _nodeCount > 0 ? _bounds : OutOfCoreGraph::Rect{};
+
+    std::vector<std::uint64_t> cursors( static_cast<std::size_t>( side ) * side + 1, 0 );
+    auto y = _y->column.begin();
+    for ( auto x = _x->column.begin(); x != _x->column.end(); ++x, ++y ) {
+        OutOfCoreGraph::Point p; p.x = *x; p.y = *y;
+        ++cursors[static_cast<std::size_t>( OutOfCoreGraph::getCell( p, bounds, side, side ) ) + 1];
+    }
+    for ( std::size_t c = 1; c < cursors.size(); ++c )
+        cursors[c] += cursors[c - 1];           // cursors[c] is cell c first entry
+    progress.setProgress( 0.3 );
+    {
+        const auto mode = PagedFile::Mode::Truncate;
+        OutOfCoreGraph::ColumnFile<std::uint64_t> offsets{ _basePath + ".cells.offsets", mode, _pageSize, _cacheSize / 4 };
+        for ( const auto offset : cursors )
+            offsets.column.push_back( offset );
+        offsets.file.flush();
+    }
+    OutOfCoreGraph::ColumnFile<OutOfCoreGraph::CellEntry> cells{ _basePath + ".cells", PagedFile::Mode::Truncate, _pageSize, _cacheSize / 4 };
+    NodeId node = 0;
+    y = _y->column.begin();
+    for ( auto x = _x->column.begin(); x != _x->column.end(); ++x, ++y, ++node ) {
+        OutOfCoreGraph::CellEntry entry;
+        entry.node = node;
+        entry.position.x = *x;
+        entry.position.y = *y;
+        const auto cell = static_cast<std::size_t>( OutOfCoreGraph::getCell( entry.position, bounds, side, side ) );
+        cells.column.set( cursors[cell]++, entry );
+    }
+    cells.file.flush();
+    progress.setProgress( 1. );
+}
+//-----------------------------------------------------------------------------
+
+} // ::gtpo
@@ -0,0 +1,290 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoPagedFile.h
+// \author	benoit@destrat.io
+// \date	2017 12 10
+//-----------------------------------------------------------------------------
+
+#ifndef gtpoPagedFile_h
+#define gtpoPagedFile_h
+
+// STD headers
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint64_t
+#include <cstdio>       // std::FILE
+#include <string>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <memory>       // std::shared_ptr
+#include <mutex>
+#include <future>       // std::shared_future
+#include <type_traits>  // std::is_trivially_copyable
+
+// GTpo headers
+#include "./gtpoUtils.h"
+
+namespace gtpo { // ::gtpo
+
+/*! \brief Exception thrown by GTpo out-of-core storage when a paged file could not be read or written.
+ *
+ * Use what() to have a detailled error description.
+ */
+class bad_storage_error : public std::runtime_error
+{
+public:
+    explicit bad_storage_error (const std::string& what_arg) : std::runtime_error( what_arg ) { }
+    explicit bad_storage_error (const char* what_arg) : std::runtime_error( what_arg ) { }
+    bad_storage_error () : bad_storage_error( "GTpo storage unrecoverable error." ) { }
+};
+
+/*! \brief File accessed by fixed size pages through a bounded LRU page cache.
+ *
+ * Only \c cacheCapacity pages are kept in memory: reading a page that is not cached load it from disk and
+ * evict the least recently used page (dirty pages are written back on eviction). Pages returned by page()
+ * are reference counted, a page evicted from cache stay valid as long as a caller reference it.
+ *
+ * prefetch() load a page asynchronously: traversals request the next page while still processing the
+ * current one (see gtpo::PagedColumn<>::Iterator), IO latency is then hidden behind computation.
+ *
+ * Storage is accessed with standard C file IO (64 bits offsets) instead of OS specific memory mapping:
+ * GTpo has no platform dependency, and an explicit page cache bound memory use independently of OS
+ * paging policy.
+ *
+ * \note PagedFile is thread safe, all accesses are serialized with an internal mutex.
+ * \nosubgrouping
+ */
+class PagedFile
+{
+    /*! \name PagedFile Object Management *///---------------------------------
+    //@{
+public:
+    //! Open mode, \c Truncate create a new empty file.
+    enum class Mode : int {
+        ReadOnly,
+        ReadWrite,
+        Truncate
+    };
+
+    //! In memory page content, \c data size is always getPageSize().
+    struct Page {
+        std::uint64_t       index = 0;
+        std::vector<char>   data;
+        bool                dirty = false;
+    };
+    using SharedPage    = std::shared_ptr<Page>;
+    using ConstPage     = std::shared_ptr<const Page>;
+
+    /*! \brief Open \c fileName with a \c pageSize page size and a cache of \c cacheCapacity pages.
+     *
+     * Page size is at least 512 bytes and cache capacity at least 2 pages.
+     * \throw gtpo::bad_storage_error if file could not be opened.
+     */
+    PagedFile( const std::string& fileName, Mode mode,
+               std::size_t pageSize = 64 * 1024,
+               std::size_t cacheCapacity = 64 ) noexcept( false );
+    //! Flush dirty pages and close file (errors are silently ignored, call flush() explicitely to catch them).
+    ~PagedFile() noexcept;
+    PagedFile( const PagedFile& ) = delete;
+    PagedFile& operator=( const PagedFile& ) = delete;
+
+    inline auto     getFileName() const noexcept -> const std::string& { return _fileName; }
+    inline auto     getPageSize() const noexcept -> std::size_t { return _pageSize; }
+    inline auto     getCacheCapacity() const noexcept -> std::size_t { return _cacheCapacity; }
+    //! Logical file size in bytes (including pending writes).
+    auto            getSize() const noexcept -> std::uint64_t;
+    //! Return the number of pages necessary to store getSize() bytes.
+    auto            getPageCount() const noexcept -> std::uint64_t;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Page Management *///---------------------------------------------
+    //@{
+public:
+    /*! \brief Return page \c pageIndex, loading it from disk if it is not actually cached.
+     *
+     * Pages after end of file are zero filled.
+     * \throw gtpo::bad_storage_error on IO error.
+     */
+    auto            page( std::uint64_t pageIndex ) noexcept( false ) -> ConstPage;
+
+    //! Asynchronously load page \c pageIndex in cache (no-op if page is cached, already prefetched or after end of file).
+    auto            prefetch( std::uint64_t pageIndex ) noexcept -> void;
+
+    /*! \brief Copy \c size bytes at \c offset in \c destination.
+     *
+     * \throw gtpo::bad_storage_error on IO error.
+     */
+    auto            read( std::uint64_t offset, void* destination, std::size_t size ) noexcept( false ) -> void;
+
+    /*! \brief Copy \c size bytes from \c source at \c offset, file is extended if necessary.
+     *
+     * \throw gtpo::bad_storage_error if file is read only or on IO error.
+     */
+    auto            write( std::uint64_t offset, const void* source, std::size_t size ) noexcept( false ) -> void;
+
+    //! Write all dirty pages to disk (pages stay cached).
+    auto            flush() noexcept( false ) -> void;
+
+    //! Number of page() requests served from cache (including completed prefetches).
+    inline auto     getCacheHits() const noexcept -> std::uint64_t { return _cacheHits; }
+    //! Number of page() requests that required a synchronous disk read.
+    inline auto     getCacheMisses() const noexcept -> std::uint64_t { return _cacheMisses; }
+
+private:
+    //! Return cached page \c pageIndex or load it (mutex must be locked).
+    auto            cachedPage( std::unique_lock<std::mutex>& lock, std::uint64_t pageIndex ) noexcept( false ) -> SharedPage;
+    //! Insert \c page in cache and evict least recently used pages (mutex must be locked).
+    auto            insertPage( SharedPage page ) noexcept( false ) -> void;
+    //! Read page \c pageIndex from disk (mutex must be locked).
+    auto            loadPage( std::uint64_t pageIndex ) noexcept( false ) -> SharedPage;
+    //! Write \c page to disk (mutex must be locked).
+    auto            storePage( Page& page ) noexcept( false ) -> void;
+    //! Seek file to \c offset (mutex must be locked).
+    auto            seek( std::uint64_t offset ) noexcept( false ) -> void;
+
+private:
+    std::string         _fileName;
+    Mode                _mode;
+    std::size_t         _pageSize;
+    std::size_t         _cacheCapacity;
+    std::FILE*          _file = nullptr;
+    //! Size of file on disk.
+    std::uint64_t       _diskSize = 0;
+    //! Logical file size, might be larger than disk size until dirty pages are flushed.
+    std::uint64_t       _size = 0;
+    mutable std::mutex  _mutex;
+
+    using LruList       = std::list<std::uint64_t>;
+    //! Cached pages indexes, most recently used first.
+    LruList             _lru;
+    std::unordered_map<std::uint64_t, std::pair<SharedPage, LruList::iterator>> _cache;
+    //! Pages actually loaded by prefetch().
+    std::unordered_map<std::uint64_t, std::shared_future<SharedPage>>            _pending;
+    //! Maximum number of concurrent prefetches.
+    static constexpr std::size_t maxPendingPrefetches = 4;
+
+    std::uint64_t       _cacheHits = 0;
+    std::uint64_t       _cacheMisses = 0;
+    //@}
+    //-------------------------------------------------------------------------
+};
+
+/*! \brief Fixed size records column stored in a gtpo::PagedFile (ie an out-of-core std::vector<T>).
+ *
+ * \c T must be trivially copyable, records are stored in host byte order.
+ *
+ * \code
+ *  gtpo::PagedFile file{ "x.col", gtpo::PagedFile::Mode::Truncate };
+ *  gtpo::PagedColumn<float> x{ file };
+ *  x.push_back( 42.f );
+ *  for ( auto v : x ) std::cout << v;  // Page aware iteration with prefetching
+ * \endcode
+ */
+template < class T >
+class PagedColumn
+{
+    static_assert( std::is_trivially_copyable<T>::value, "gtpo::PagedColumn<T>: T must be trivially copyable." );
+    /*! \name PagedColumn Object Management *///-------------------------------
+    //@{
+public:
+    explicit PagedColumn( PagedFile& file ) noexcept : _file( file ) { }
+    PagedColumn( const PagedColumn& ) = delete;
+
+    inline auto     getFile() noexcept -> PagedFile& { return _file; }
+    inline auto     size() const noexcept -> std::uint64_t { return _file.getSize() / sizeof(T); }
+    inline auto     empty() const noexcept -> bool { return size() == 0; }
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Records Management *///------------------------------------------
+    //@{
+public:
+    //! Return record \c index (records after end of column are zero initialized).
+    auto            get( std::uint64_t index ) const noexcept( false ) -> T;
+    //! Set record \c index, column is extended if necessary.
+    auto            set( std::uint64_t index, const T& value ) noexcept( false ) -> void;
+    //! Append \c value at end of column.
+    inline auto     push_back( const T& value ) noexcept( false ) -> void { set( size(), value ); }
+
+public:
+    /*! \brief Page aware forward iterator on a [begin, end) range of records.
+     *
+     * Records contained in current page are read directly from page memory, next page is prefetched
+     * as soon as the iterator enter a page.
+     */
+    class Iterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const T*;
+        using reference         = T;
+
+        Iterator( const PagedColumn<T>* column, std::uint64_t index ) noexcept : _column( column ), _index( index ) { }
+
+        auto    operator*() noexcept( false ) -> T;
+        inline auto operator++() noexcept -> Iterator& { ++_index; return *this; }
+        inline auto operator==( const Iterator& right ) const noexcept -> bool { return _index == right._index; }
+        inline auto operator!=( const Iterator& right ) const noexcept -> bool { return _index != right._index; }
+        inline auto getIndex() const noexcept -> std::uint64_t { return _index; }
+    private:
+        const PagedColumn<T>*   _column = nullptr;
+        std::uint64_t           _index = 0;
+        //! Current page (and its index), keep page alive even if it is evicted from cache.
+        PagedFile::ConstPage    _page;
+    };
+
+    //! Range of records [begin, end) usable in range based for loops.
+    struct Range {
+        Iterator    first;
+        Iterator    last;
+        inline auto begin() const noexcept -> Iterator { return first; }
+        inline auto end() const noexcept -> Iterator { return last; }
+        inline auto size() const noexcept -> std::uint64_t { return last.getIndex() - first.getIndex(); }
+    };
+
+    inline auto     begin() const noexcept -> Iterator { return Iterator{ this, 0 }; }
+    inline auto     end() const noexcept -> Iterator { return Iterator{ this, size() }; }
+    //! Return range of records [first, last).
+    inline auto     range( std::uint64_t first, std::uint64_t last ) const noexcept -> Range { return Range{ Iterator{ this, first }, Iterator{ this, last } }; }
+
+private:
+    PagedFile&      _file;
+    //@}
+    //-------------------------------------------------------------------------
+};
+
+} // ::gtpo
+
+#include "./gtpoPagedFile.hpp"
+
+#endif // gtpoPagedFile_h
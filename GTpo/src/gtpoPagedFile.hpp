@@ -0,0 +1,321 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoPagedFile.hpp
+// \author	benoit@destrat.io
+// \date	2017 12 10
+//-----------------------------------------------------------------------------
+
+// STD headers
+#include <cstring>      // std::memcpy
+#include <algorithm>    // std::min
+#include <chrono>
+
+namespace gtpo { // ::gtpo
+
+namespace impl { // ::gtpo::impl
+
+//! 64 bits offsets std::fseek().
+inline int  fseek64( std::FILE* file, std::uint64_t offset, int origin ) noexcept
+{
+#if defined(_MSC_VER)
+    return _fseeki64( file, static_cast<__int64>( offset ), origin );
+#else
+    return fseeko( file, static_cast<off_t>( offset ), origin );
+#endif
+}
+
+//! 64 bits offsets std::ftell().
+inline std::int64_t ftell64( std::FILE* file ) noexcept
+{
+#if defined(_MSC_VER)
+    return _ftelli64( file );
+#else
+    return static_cast<std::int64_t>( ftello( file ) );
+#endif
+}
+
+} // ::gtpo::impl
+
+/* PagedFile Object Management *///--------------------------------------------
+inline PagedFile::PagedFile( const std::string& fileName, Mode mode,
+                             std::size_t pageSize, std::size_t cacheCapacity ) :
+    _fileName( fileName ),
+    _mode( mode ),
+    _pageSize( pageSize < 512 ? 512 : pageSize ),
+    _cacheCapacity( cacheCapacity < 2 ? 2 : cacheCapacity )
+{
+    const char* fileMode = mode == Mode::ReadOnly ? "rb" :
+                           mode == Mode::ReadWrite ? "r+b" : "w+b";
+    _file = std::fopen( fileName.c_str(), fileMode );
+    if ( _file == nullptr &&
+         mode == Mode::ReadWrite )      // File does not exist, create it
+        _file = std::fopen( fileName.c_str(), "w+b" );
+    if ( _file == nullptr )
+        throw gtpo::bad_storage_error( "gtpo::PagedFile::PagedFile(): Error: Can't open file " + fileName );
+    const auto size = impl::fseek64( _file, 0, SEEK_END ) == 0 ? impl::ftell64( _file ) : -1;
+    if ( size < 0 ) {
+        std::fclose( _file );
+        throw gtpo::bad_storage_error( "gtpo::PagedFile::PagedFile(): Error: Can't access size of file " + fileName );
+    }
+    _diskSize = _size = static_cast<std::uint64_t>( size );
+}
+
+inline PagedFile::~PagedFile() noexcept
+{
+    // Wait for pending prefetches without locking, prefetch tasks lock the mutex
+    for ( auto& pending : _pending )
+        pending.second.wait();
+    try {
+        flush();
+    } catch ( ... ) { }
+    if ( _file != nullptr )
+        std::fclose( _file );
+}
+
+inline auto PagedFile::getSize() const noexcept -> std::uint64_t
+{
+    std::lock_guard<std::mutex> lock{ _mutex };
+    return _size;
+}
+
+inline auto PagedFile::getPageCount() const noexcept -> std::uint64_t
+{
+    const auto size = getSize();
+    return ( size + _pageSize - 1 ) / _pageSize;
+}
+//-----------------------------------------------------------------------------
+
+/* Page Management *///--------------------------------------------------------
+inline auto PagedFile::page( std::uint64_t pageIndex ) -> ConstPage
+{
+    std::unique_lock<std::mutex> lock{ _mutex };
+    return cachedPage( lock, pageIndex );
+}
+
+inline auto PagedFile::prefetch( std::uint64_t pageIndex ) noexcept -> void
+{
+    std::lock_guard<std::mutex> lock{ _mutex };
+    // Move completed prefetches to cache, so that pending slots are not held by pages that are never requested
+    for ( auto pending = _pending.begin(); pending != _pending.end(); ) {
+        if ( pending->second.wait_for( std::chrono::seconds{ 0 } ) == std::future_status::ready ) {
+            try {
+                if ( _cache.find( pending->first ) == _cache.end() )
+                    insertPage( pending->second.get() );
+            } catch ( ... ) { }     // Error will be reported on synchronous access
+            pending = _pending.erase( pending );
+        } else
+            ++pending;
+    }
+    if ( pageIndex * _pageSize >= _diskSize ||          // Nothing to load
+         _pending.size() >= maxPendingPrefetches ||
+         _cache.find( pageIndex ) != _cache.end() ||
+         _pending.find( pageIndex ) != _pending.end() )
+        return;
+    try {
+        _pending.emplace( pageIndex, std::async( std::launch::async, [this, pageIndex]() {
+            std::lock_guard<std::mutex> taskLock{ _mutex };
+            return loadPage( pageIndex );
+        } ).share() );
+    } catch ( ... ) { }     // Thread creation failure: prefetching is only an optimization
+}
+
+inline auto PagedFile::read( std::uint64_t offset, void* destination, std::size_t size ) -> void
+{
+    auto output = static_cast<char*>( destination );
+    std::unique_lock<std::mutex> lock{ _mutex };
+    if ( offset + size > _size )
+        throw gtpo::bad_storage_error( "gtpo::PagedFile::read(): Error: Reading past end of file " + _fileName );
+    while ( size > 0 ) {
+        const auto pageIndex = offset / _pageSize;
+        const auto pageOffset = static_cast<std::size_t>( offset % _pageSize );
+        const auto count = std::min( size, _pageSize - pageOffset );
+        const auto page = cachedPage( lock, pageIndex );
+        std::memcpy( output, page->data.data() + pageOffset, count );
+        output += count;
+        offset += count;
+        size -= count;
+    }
+}
+
+inline auto PagedFile::write( std::uint64_t offset, const void* source, std::size_t size ) -> void
+{
+    if ( _mode == Mode::ReadOnly )
+        throw gtpo::bad_storage_error( "gtpo::PagedFile::write(): Error: File " + _fileName + " is read only." );
+    auto input = static_cast<const char*>( source );
+    std::unique_lock<std::mutex> lock{ _mutex };
+    while ( size > 0 ) {
+        const auto pageIndex = offset / _pageSize;
+        const auto pageOffset = static_cast<std::size_t>( offset % _pageSize );
+        const auto count = std::min( size, _pageSize - pageOffset );
+        const auto page = cachedPage( lock, pageIndex );
+        std::memcpy( page->data.data() + pageOffset, input, count );
+        page->dirty = true;
+        input += count;
+        offset += count;
+        size -= count;
+        if ( offset > _size )
+            _size = offset;
+    }
+}
+
+inline auto PagedFile::flush() -> void
+{
+    std::lock_guard<std::mutex> lock{ _mutex };
+    for ( auto& cached : _cache )
+        if ( cached.second.first->dirty )
+            storePage( *cached.second.first );
+    if ( _file != nullptr &&
+         std::fflush( _file ) != 0 )
+        throw gtpo::bad_storage_error( "gtpo::PagedFile::flush(): Error: Can't flush file " + _fileName );
+}
+
+inline auto PagedFile::cachedPage( std::unique_lock<std::mutex>& lock, std::uint64_t pageIndex ) -> SharedPage
+{
+    auto cached = _cache.find( pageIndex );
+    if ( cached != _cache.end() ) {
+        ++_cacheHits;
+        _lru.splice( _lru.begin(), _lru, cached->second.second );
+        return cached->second.first;
+    }
+    auto pending = _pending.find( pageIndex );
+    if ( pending != _pending.end() ) {
+        auto future = pending->second;
+        _pending.erase( pending );
+        lock.unlock();              // Prefetch task need the lock to complete
+        SharedPage page;
+        try {
+            page = future.get();
+        } catch ( ... ) {
+            lock.lock();
+            throw;
+        }
+        lock.lock();
+        cached = _cache.find( pageIndex );
+        ++_cacheHits;
+        if ( cached != _cache.end() ) {    // Page has been cached by another thread meanwhile
+            _lru.splice( _lru.begin(), _lru, cached->second.second );
+            return cached->second.first;
+        }
+        insertPage( page );
+        return page;
+    }
+    ++_cacheMisses;
+    auto page = loadPage( pageIndex );
+    insertPage( page );
+    return page;
+}
+
+inline auto PagedFile::insertPage( SharedPage page ) -> void
+{
+    _lru.push_front( page->index );
+    _cache.emplace( page->index, std::make_pair( page, _lru.begin() ) );
+    while ( _cache.size() > _cacheCapacity ) {
+        const auto victim = _cache.find( _lru.back() );
+        if ( victim != _cache.end() ) {
+            if ( victim->second.first->dirty )
+                storePage( *victim->second.first );
+            _cache.erase( victim );
+        }
+        _lru.pop_back();
+    }
+}
+
+inline auto PagedFile::loadPage( std::uint64_t pageIndex ) -> SharedPage
+{
+    auto page = std::make_shared<Page>();
+    page->index = pageIndex;
+    page->data.assign( _pageSize, 0 );
+    const auto offset = pageIndex * _pageSize;
+    if ( offset < _diskSize ) {
+        const auto count = static_cast<std::size_t>( std::min<std::uint64_t>( _pageSize, _diskSize - offset ) );
+        seek( offset );
+        if ( std::fread( page->data.data(), 1, count, _file ) != count )
+            throw gtpo::bad_storage_error( "gtpo::PagedFile::loadPage(): Error: Can't read file " + _fileName );
+    }
+    return page;
+}
+
+inline auto PagedFile::storePage( Page& page ) -> void
+{
+    const auto offset = page.index * _pageSize;
+    if ( offset < _size ) {
+        const auto count = static_cast<std::size_t>( std::min<std::uint64_t>( _pageSize, _size - offset ) );
+        seek( offset );
+        if ( std::fwrite( page.data.data(), 1, count, _file ) != count )
+            throw gtpo::bad_storage_error( "gtpo::PagedFile::storePage(): Error: Can't write file " + _fileName );
+        if ( offset + count > _diskSize )
+            _diskSize = offset + count;
+    }
+    page.dirty = false;
+}
+
+inline auto PagedFile::seek( std::uint64_t offset ) -> void
+{
+    if ( impl::fseek64( _file, offset, SEEK_SET ) != 0 )
+        throw gtpo::bad_storage_error( "gtpo::PagedFile::seek(): Error: Can't seek in file " + _fileName );
+}
+//-----------------------------------------------------------------------------
+
+/* PagedColumn Records Management *///-----------------------------------------
+template < class T >
+auto    PagedColumn<T>::get( std::uint64_t index ) const -> T
+{
+    T value;
+    _file.read( index * sizeof(T), &value, sizeof(T) );
+    return value;
+}
+
+template < class T >
+auto    PagedColumn<T>::set( std::uint64_t index, const T& value ) -> void
+{
+    _file.write( index * sizeof(T), &value, sizeof(T) );
+}
+
+template < class T >
+auto    PagedColumn<T>::Iterator::operator*() -> T
+{
+    const auto pageSize = _column->_file.getPageSize();
+    const auto offset = _index * sizeof(T);
+    const auto pageIndex = offset / pageSize;
+    const auto pageOffset = static_cast<std::size_t>( offset % pageSize );
+    if ( pageOffset + sizeof(T) > pageSize )        // Record straddle two pages
+        return _column->get( _index );
+    if ( !_page ||
+         _page->index != pageIndex ) {
+        _page = _column->_file.page( pageIndex );
+        _column->_file.prefetch( pageIndex + 1 );
+    }
+    T value;
+    std::memcpy( &value, _page->data.data() + pageOffset, sizeof(T) );
+    return value;
+}
+//-----------------------------------------------------------------------------
+
+} // ::gtpo
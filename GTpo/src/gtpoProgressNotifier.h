@@ -0,0 +1,178 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoProgressNotifier.h
+// \author	benoit@destrat.io
+// \date	2017 12 04
+//-----------------------------------------------------------------------------
+
+#ifndef gtpoProgressNotifier_h
+#define gtpoProgressNotifier_h
+
+// STD headers
+#include <vector>
+#include <memory>       // std::unique_ptr
+#include <iostream>     // std::cout
+
+namespace gtpo { // ::gtpo
+
+/*! \brief Interface for long running operations (serialization, layouts) progress reporting.
+ *
+ * Progress is reported in the [0.; 1.] range. A notifier could be splitted in multiple
+ * sub progress notifiers, each one reporting a progress in its own [0.; 1.] range that
+ * is mapped in a fraction of this notifier range:
+ * \code
+ *  gtpo::EchoProgressNotifier progress;
+ *  progress.reserveSubProgress( 2 );
+ *  auto& first = progress.takeSubProgress();
+ *  first.setProgress( 1.0 );                   // progress.getProgress() == 0.5
+ *  auto& second = progress.takeSubProgress();
+ *  second.setProgress( 0.5 );                  // progress.getProgress() == 0.75
+ * \endcode
+ *
+ * \nosubgrouping
+ */
+class IProgressNotifier
+{
+    /*! \name IProgressNotifier Object Management *///-------------------------
+    //@{
+public:
+    IProgressNotifier() noexcept = default;
+    virtual ~IProgressNotifier() noexcept = default;
+    IProgressNotifier( const IProgressNotifier& ) = delete;
+    IProgressNotifier& operator=( const IProgressNotifier& ) = delete;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Progress Management *///-----------------------------------------
+    //@{
+public:
+    //! Set the current progress (clamped in the [0.; 1.] range).
+    auto            setProgress( double progress ) noexcept -> void {
+        progress = ( progress < 0. ? 0. : ( progress > 1. ? 1. : progress ) );
+        if ( progress != _progress ) {
+            _progress = progress;
+            notifyProgressModified();
+        }
+    }
+    //! Return the current progress in the [0.; 1.] range.
+    inline auto     getProgress() const noexcept -> double { return _progress; }
+    //! Reset progress to 0. and remove all sub progress notifiers.
+    auto            reset() noexcept -> void {
+        _subProgress.clear();
+        _subProgressIndex = 0;
+        setProgress( 0. );
+    }
+protected:
+    //! Called every time progress is modified, default implementation does nothing.
+    virtual auto    notifyProgressModified() noexcept -> void { }
+private:
+    double          _progress = 0.;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Sub Progress Management *///-------------------------------------
+    //@{
+public:
+    /*! \brief Split this notifier in \c count sub progress notifiers of equal weight.
+     *
+     * Sub progress notifiers must then be acquired in order with takeSubProgress().
+     */
+    inline auto     reserveSubProgress( int count ) noexcept( false ) -> void;
+    /*! \brief Return the next reserved sub progress notifier.
+     *
+     * If no more sub progress are available, a notifier with no effect on this notifier is returned.
+     */
+    auto            takeSubProgress() noexcept -> IProgressNotifier& {
+        if ( _subProgressIndex < _subProgress.size() )
+            return *_subProgress[_subProgressIndex++];
+        static IProgressNotifier nilProgress;
+        return nilProgress;
+    }
+
+private:
+    class SubProgressNotifier;
+    std::vector< std::unique_ptr< IProgressNotifier > > _subProgress;
+    std::size_t                                         _subProgressIndex = 0;
+    //@}
+    //-------------------------------------------------------------------------
+};
+
+/*! \brief Sub progress notifier mapping its progress in a given slot of a parent notifier.
+ *
+ * \note Created and owned by IProgressNotifier::reserveSubProgress(), should not be used directly.
+ */
+class IProgressNotifier::SubProgressNotifier : public IProgressNotifier
+{
+public:
+    SubProgressNotifier( IProgressNotifier& parent, int index, int count ) noexcept :
+        IProgressNotifier{}, _parent( parent ), _index{ index }, _count{ count } { }
+protected:
+    virtual auto    notifyProgressModified() noexcept -> void override {
+        if ( _count > 0 )
+            _parent.setProgress( ( static_cast<double>( _index ) + getProgress() ) / static_cast<double>( _count ) );
+    }
+private:
+    IProgressNotifier&  _parent;
+    int                 _index = 0;
+    int                 _count = 1;
+};
+
+inline auto IProgressNotifier::reserveSubProgress( int count ) noexcept( false ) -> void
+{
+    _subProgress.clear();
+    _subProgressIndex = 0;
+    for ( int s = 0; s < count; ++s )
+        _subProgress.emplace_back( new SubProgressNotifier{ *this, s, count } );
+}
+
+/*! \brief Progress notifier echoing progress modifications to std::cout.
+ *
+ * Output is throttled to one line every percent.
+ */
+class EchoProgressNotifier : public IProgressNotifier
+{
+public:
+    EchoProgressNotifier() noexcept : IProgressNotifier{} { }
+protected:
+    virtual auto    notifyProgressModified() noexcept -> void override {
+        const int percent = static_cast<int>( getProgress() * 100. );
+        if ( percent != _lastPercent ) {
+            _lastPercent = percent;
+            std::cout << "Progress: " << percent << "%" << std::endl;
+        }
+    }
+private:
+    int             _lastPercent = -1;
+};
+
+} // ::gtpo
+
+#endif // gtpoProgressNotifier_h
+
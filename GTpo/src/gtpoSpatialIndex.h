@@ -0,0 +1,214 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoSpatialIndex.h
+// \author	benoit@destrat.io
+// \date	2017 12 16
+//-----------------------------------------------------------------------------
+
+#ifndef gtpoSpatialIndex_h
+#define gtpoSpatialIndex_h
+
+// STD headers
+#include <cstddef>          // std::size_t
+#include <vector>
+#include <memory>           // std::unique_ptr
+#include <unordered_map>
+#include <functional>       // std::hash
+
+// GTpo headers
+#include "./gtpoUtils.h"
+
+namespace gtpo { // ::gtpo
+
+/*! \brief Axis aligned bounding box used by gtpo::SpatialIndex (\c left <= \c right and \c top <= \c bottom).
+ */
+struct Box {
+    double  left = 0.;
+    double  top = 0.;
+    double  right = 0.;
+    double  bottom = 0.;
+
+    //! Create a box from a top left corner and a size.
+    static inline auto  fromRect( double x, double y, double width, double height ) noexcept -> Box {
+        return Box{ x, y, x + width, y + height };
+    }
+    inline auto     width() const noexcept -> double { return right - left; }
+    inline auto     height() const noexcept -> double { return bottom - top; }
+    inline auto     area() const noexcept -> double { return width() * height(); }
+    //! Return true if point (\c x, \c y) is inside box (borders included).
+    inline auto     contains( double x, double y ) const noexcept -> bool {
+        return x >= left && x <= right && y >= top && y <= bottom;
+    }
+    //! Return true if \c box is fully inside this box.
+    inline auto     contains( const Box& box ) const noexcept -> bool {
+        return box.left >= left && box.right <= right && box.top >= top && box.bottom <= bottom;
+    }
+    //! Return true if \c box intersects this box (borders included).
+    inline auto     intersects( const Box& box ) const noexcept -> bool {
+        return box.left <= right && box.right >= left && box.top <= bottom && box.bottom >= top;
+    }
+    //! Return the smallest box containing both this box and \c box.
+    auto            united( const Box& box ) const noexcept -> Box;
+    //! Return squared distance between point (\c x, \c y) and this box (0 when point is inside box).
+    auto            squaredDistance( double x, double y ) const noexcept -> double;
+};
+
+/*! \brief Dynamic R-tree indexing \c Key elements by their bounding box.
+ *
+ * Elements are inserted, moved and removed incrementally: moving an element inside its leaf bounding box is O(1),
+ * other operations are O(log n). Point and rect queries visit only subtrees whose bounding box intersects query
+ * box, k-nearest queries use a best-first traversal.
+ *
+ * Internal nodes are split with Guttman quadratic split, removal reinsert elements of underfull nodes.
+ *
+ * \code
+ *   gtpo::SpatialIndex<int> index;
+ *   index.insert( 42, gtpo::Box::fromRect( 10., 10., 100., 50. ) );
+ *   index.insert( 43, gtpo::Box::fromRect( 300., 10., 100., 50. ) );
+ *   index.queryPoint( 50., 30. );          // { 42 }
+ *   index.nearest( 290., 0., 1 );          // { 43 }
+ * \endcode
+ *
+ * \note \c Key must be copyable and hashable with \c Hash, SpatialIndex is not thread safe.
+ * \nosubgrouping
+ */
+template < class Key, class Hash = std::hash<Key> >
+class SpatialIndex
+{
+    /*! \name SpatialIndex Object Management *///------------------------------
+    //@{
+public:
+    //! Maximum number of entries in a tree node.
+    static constexpr std::size_t    maxEntries = 16;
+    //! Minimum number of entries in a non root tree node.
+    static constexpr std::size_t    minEntries = 6;
+
+    SpatialIndex() noexcept;
+    ~SpatialIndex() = default;
+    SpatialIndex( const SpatialIndex& ) = delete;
+    SpatialIndex& operator=( const SpatialIndex& ) = delete;
+
+    //! Number of indexed elements.
+    inline auto     size() const noexcept -> std::size_t { return _leaves.size(); }
+    inline auto     isEmpty() const noexcept -> bool { return _leaves.empty(); }
+    //! Remove all elements.
+    auto            clear() noexcept -> void;
+    //! Return tree height (1 for a tree with only a root leaf).
+    auto            getHeight() const noexcept -> std::size_t;
+    //! Return bounding box of all elements (an empty box when index is empty).
+    auto            getBounds() const noexcept -> Box;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Element Management *///------------------------------------------
+    //@{
+public:
+    /*! \brief Insert element \c key with bounding box \c box, or move \c key to \c box if it is already indexed.
+     *
+     * \throw gtpo::bad_topology_error if \c box is invalid (ie \c left > \c right or \c top > \c bottom).
+     */
+    auto            insert( const Key& key, const Box& box ) noexcept( false ) -> void;
+    //! Shortcut to insert(), intent revealing name when an indexed element geometry change.
+    inline auto     update( const Key& key, const Box& box ) noexcept( false ) -> void { insert( key, box ); }
+    //! Remove element \c key, return false if \c key was not indexed.
+    auto            remove( const Key& key ) noexcept -> bool;
+    //! Return true if \c key is indexed.
+    inline auto     contains( const Key& key ) const noexcept -> bool { return _leaves.find( key ) != _leaves.end(); }
+    //! Return \c key bounding box (an empty box if \c key is not indexed).
+    auto            getBox( const Key& key ) const noexcept -> Box;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Spatial Queries *///---------------------------------------------
+    //@{
+public:
+    /*! \brief Call \c visitor( const Key&, const Box& ) for every element whose box intersects \c box.
+     *
+     * \c visitor might return void, or a bool set to false to stop traversal. Index must not be modified from \c visitor.
+     */
+    template < class Visitor >
+    auto            visit( const Box& box, Visitor visitor ) const -> void;
+
+    //! Return all elements whose box contains point (\c x, \c y).
+    auto            queryPoint( double x, double y ) const -> std::vector<Key>;
+    //! Return all elements whose box intersects \c box.
+    auto            queryRect( const Box& box ) const -> std::vector<Key>;
+    //! Return at most \c k elements nearest to point (\c x, \c y) ordered by increasing box distance.
+    auto            nearest( double x, double y, std::size_t k ) const -> std::vector<Key>;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name R-Tree Management *///-------------------------------------------
+    //@{
+private:
+    struct Node {
+        explicit Node( bool leaf ) noexcept : isLeaf{ leaf } { }
+        bool                                isLeaf;
+        Node*                               parent = nullptr;
+        //! Entries bounding boxes.
+        std::vector<Box>                    boxes;
+        //! Child nodes (internal nodes only).
+        std::vector<std::unique_ptr<Node>>  children;
+        //! Element keys (leaves only).
+        std::vector<Key>                    keys;
+
+        inline auto size() const noexcept -> std::size_t { return boxes.size(); }
+        auto        bounds() const noexcept -> Box;
+        auto        indexOf( const Node* child ) const noexcept -> std::size_t;
+    };
+
+    //! Insert an element that is not actually indexed.
+    auto            insertElement( const Key& key, const Box& box ) -> void;
+    //! Return the leaf whose box need the least enlargement to contain \c box.
+    auto            chooseLeaf( const Box& box ) const noexcept -> Node*;
+    //! Split overflowing \c node and propagate splits and bounding boxes up to root.
+    auto            adjustTree( Node* node ) -> void;
+    //! Quadratic split of \c node entries, \c node keep the first group and the second group is returned.
+    auto            split( Node& node ) -> std::unique_ptr<Node>;
+    //! Update \c node box in its parent and ancestors.
+    auto            adjustBounds( Node* node ) noexcept -> void;
+    //! Remove underfull nodes after a removal in \c leaf and reinsert their elements.
+    auto            condenseTree( Node* leaf ) -> void;
+    //! Append all elements in \c node subtree to \c elements and unregister them.
+    auto            collectElements( Node& node, std::vector<std::pair<Key, Box>>& elements ) -> void;
+
+private:
+    std::unique_ptr<Node>                       _root;
+    //! Leaf of every indexed element.
+    std::unordered_map<Key, Node*, Hash>        _leaves;
+    //@}
+    //-------------------------------------------------------------------------
+};
+
+} // ::gtpo
+
+#include "./gtpoSpatialIndex.hpp"
+
+#endif // gtpoSpatialIndex_h
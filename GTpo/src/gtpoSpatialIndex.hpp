@@ -0,0 +1,464 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoSpatialIndex.hpp
+// \author	benoit@destrat.io
+// \date	2017 12 16
+//-----------------------------------------------------------------------------
+
+// STD headers
+#include <algorithm>    // std::min std::max
+#include <cmath>        // std::abs
+#include <limits>
+#include <queue>        // std::priority_queue
+
+namespace gtpo { // ::gtpo
+
+/* Box *///--------------------------------------------------------------------
+inline auto Box::united( const Box& box ) const noexcept -> Box
+{
+    return Box{ std::min( left, box.left ), std::min( top, box.top ),
+                std::max( right, box.right ), std::max( bottom, box.bottom ) };
+}
+
+inline auto Box::squaredDistance( double x, double y ) const noexcept -> double
+{
+    const double dx = std::max( { left - x, 0., x - right } );
+    const double dy = std::max( { top - y, 0., y - bottom } );
+    return dx * dx + dy * dy;
+}
+//-----------------------------------------------------------------------------
+
+/* SpatialIndex Object Management *///-----------------------------------------
+template < class Key, class Hash >
+constexpr std::size_t   SpatialIndex< Key, Hash >::maxEntries;
+
+template < class Key, class Hash >
+constexpr std::size_t   SpatialIndex< Key, Hash >::minEntries;
+
+template < class Key, class Hash >
+SpatialIndex< Key, Hash >::SpatialIndex() noexcept :
+    _root{ std::make_unique<Node>( true ) }
+{
+}
+
+template < class Key, class Hash >
+auto    SpatialIndex< Key, Hash >::clear() noexcept -> void
+{
+    _root = std::make_unique<Node>( true );
+    _leaves.clear();
+}
+
+template < class Key, class Hash >
+auto    SpatialIndex< Key, Hash >::getHeight() const noexcept -> std::size_t
+{
+    std::size_t height = 1;
+    for ( const Node* node = _root.get(); !node->isLeaf; node = node->children.front().get() )
+        ++height;
+    return height;
+}
+
+template < class Key, class Hash >
+auto    SpatialIndex< Key, Hash >::getBounds() const noexcept -> Box
+{
+    return _root->bounds();
+}
+//-----------------------------------------------------------------------------
+
+/* Element Management *///-----------------------------------------------------
+template < class Key, class Hash >
+auto    SpatialIndex< Key, Hash >::insert( const Key& key, const Box& box ) noexcept( false ) -> void
+{
+    gtpo::assert_throw( box.left <= box.right && box.top <= box.bottom,
+                        "gtpo::SpatialIndex<>::insert(): Error: Invalid bounding box." );
+    const auto leafIter = _leaves.find( key );
+    if ( leafIter != _leaves.end() ) {
+        Node* leaf = leafIter->second;
+        const auto keyIter = std::find( leaf->keys.begin(), leaf->keys.end(), key );
+        const auto index = static_cast<std::size_t>( keyIter - leaf->keys.begin() );
+        // Fast path: element stays inside its leaf bounds, ancestors bounds are still valid
+        if ( leaf->parent == nullptr ||
+             leaf->parent->boxes[ leaf->parent->indexOf( leaf ) ].contains( box ) ) {
+            leaf->boxes[ index ] = box;
+            return;
+        }
+        remove( key );
+    }
+    insertElement( key, box );
+}
+
+template < class Key, class Hash >
+auto    SpatialIndex< Key, Hash >::remove( const Key& key ) noexcept -> bool
+{
+    const auto leafIter = _leaves.find( key );
+    if ( leafIter == _leaves.end() )
+        return false;
+    Node* leaf = leafIter->second;
+    _leaves.erase( leafIter );
+    const auto keyIter = std::find( leaf->keys.begin(), leaf->keys.end(), key );
+    const auto index = keyIter - leaf->keys.begin();
+    leaf->keys.erase( keyIter );
+    leaf->boxes.erase( leaf->boxes.begin() + index );
+    condenseTree( leaf );
+    return true;
+}
+
+template < class Key, class Hash >
+auto    SpatialIndex< Key, Hash >::getBox( const Key& key ) const noexcept -> Box
+{
+    const auto leafIter = _leaves.find( key );
+    if ( leafIter == _leaves.end() )
+        return Box{};
+    const Node* leaf = leafIter->second;
+    const auto keyIter = std::find( leaf->keys.begin(), leaf->keys.end(), key );
+    return leaf->boxes[ static_cast<std::size_t>( keyIter - leaf->keys.begin() ) ];
+}
+//-----------------------------------------------------------------------------
+
+/* Spatial Queries *///--------------------------------------------------------
+namespace impl { // ::gtpo::impl
+
+//! Call a spatial index visitor, a visitor returning void never stop traversal.
+template < class Visitor, class Key >
+inline auto visitElement( Visitor& visitor, const Key& key, const Box& box, std::true_type ) -> bool { visitor( key, box ); return true; }
+
+template < class Visitor, class Key >
+inline auto visitElement( Visitor& visitor, const Key& key, const Box& box, std::false_type ) -> bool { return static_cast<bool>( visitor( key, box ) ); }
+
+} // ::gtpo::impl
+
+template < class Key, class Hash >
+template < class Visitor >
+auto    SpatialIndex< Key, Hash >::visit( const Box& box, Visitor visitor ) const -> void
+{
+    using ReturnVoid = typename std::is_void< decltype( visitor( std::declval<const Key&>(), std::declval<const Box&>() ) ) >::type;
+    std::vector<const Node*> nodes;
+    nodes.reserve( 64 );
+    nodes.push_back( _root.get() );
+    while ( !nodes.empty() ) {
+        const Node* node = nodes.back();
+        nodes.pop_back();
+        for ( std::size_t e = 0; e < node->size(); ++e ) {
+            if ( !box.intersects( node->boxes[ e ] ) )
+                continue;
+            if ( node->isLeaf ) {
+                if ( !impl::visitElement( visitor, node->keys[ e ], node->boxes[ e ], ReturnVoid{} ) )
+                    return;
+            } else
+                nodes.push_back( node->children[ e ].get() );
+        }
+    }
+}
+
+template < class Key, class Hash >
+auto    SpatialIndex< Key, Hash >::queryPoint( double x, double y ) const -> std::vector<Key>
+{
+    return queryRect( Box{ x, y, x, y } );
+}
+
+template < class Key, class Hash >
+auto    SpatialIndex< Key, Hash >::queryRect( const Box& box ) const -> std::vector<Key>
+{
+    std::vector<Key> keys;
+    visit( box, [&keys]( const Key& key, const Box& ) { keys.push_back( key ); } );
+    return keys;
+}
+
+template < class Key, class Hash >
+auto    SpatialIndex< Key, Hash >::nearest( double x, double y, std::size_t k ) const -> std::vector<Key>
+{
+    std::vector<Key> keys;
+    if ( k == 0 )
+        return keys;
+    keys.reserve( std::min( k, size() ) );
+
+    // Best-first traversal: candidates are either tree nodes or leaf entries, ordered by their box distance
+    struct Candidate {
+        double      distance;
+        const Node* node;
+        std::size_t entry;      // Leaf entry index, or node->size() for a node candidate
+        inline bool operator<( const Candidate& other ) const noexcept { return distance > other.distance; }
+    };
+    std::priority_queue<Candidate> candidates;
+    candidates.push( Candidate{ 0., _root.get(), _root->size() } );
+    while ( !candidates.empty() &&
+            keys.size() < k ) {
+        const auto candidate = candidates.top();
+        candidates.pop();
+        const Node* node = candidate.node;
+        if ( candidate.entry < node->size() ) {
+            keys.push_back( node->keys[ candidate.entry ] );
+            continue;
+        }
+        for ( std::size_t e = 0; e < node->size(); ++e ) {
+            const auto distance = node->boxes[ e ].squaredDistance( x, y );
+            if ( node->isLeaf )
+                candidates.push( Candidate{ distance, node, e } );
+            else
+                candidates.push( Candidate{ distance, node->children[ e ].get(), node->children[ e ]->size() } );
+        }
+    }
+    return keys;
+}
+//-----------------------------------------------------------------------------
+
+/* R-Tree Management *///------------------------------------------------------
+template < class Key, class Hash >
+auto    SpatialIndex< Key, Hash >::Node::bounds() const noexcept -> Box
+{
+    if ( boxes.empty() )
+        return Box{};
+    Box box = boxes.front();
+    for ( const auto& b : boxes )
+        box = box.united( b );
+    return box;
+}
+
+template < class Key, class Hash >
+auto    SpatialIndex< Key, Hash >::Node::indexOf( const Node* child ) const noexcept -> std::size_t
+{
+    std::size_t c = 0;
+    while ( c < children.size() &&
+            children[ c ].get() != child )
+        ++c;
+    return c;
+}
+
+template < class Key, class Hash >
+auto    SpatialIndex< Key, Hash >::insertElement( const Key& key, const Box& box ) -> void
+{
+    Node* leaf = chooseLeaf( box );
+    leaf->keys.push_back( key );
+    leaf->boxes.push_back( box );
+    _leaves[ key ] = leaf;
+    adjustTree( leaf );
+}
+
+template < class Key, class Hash >
+auto    SpatialIndex< Key, Hash >::chooseLeaf( const Box& box ) const noexcept -> Node*
+{
+    Node* node = _root.get();
+    while ( !node->isLeaf ) {
+        std::size_t best = 0;
+        double bestEnlargement = std::numeric_limits<double>::max();
+        double bestArea = std::numeric_limits<double>::max();
+        for ( std::size_t e = 0; e < node->size(); ++e ) {
+            const auto area = node->boxes[ e ].area();
+            const auto enlargement = node->boxes[ e ].united( box ).area() - area;
+            if ( enlargement < bestEnlargement ||
+                 ( enlargement == bestEnlargement && area < bestArea ) ) {
+                best = e;
+                bestEnlargement = enlargement;
+                bestArea = area;
+            }
+        }
+        node = node->children[ best ].get();
+    }
+    return node;
+}
+
+template < class Key, class Hash >
+auto    SpatialIndex< Key, Hash >::adjustTree( Node* node ) -> void
+{
+    while ( node != nullptr ) {
+        if ( node->size() > maxEntries ) {
+            auto sibling = split( *node );
+            if ( node->parent == nullptr ) {    // Root split, tree grows
+                auto root = std::make_unique<Node>( false );
+                root->boxes.push_back( node->bounds() );
+                root->boxes.push_back( sibling->bounds() );
+                node->parent = root.get();
+                sibling->parent = root.get();
+                root->children.push_back( std::move( _root ) );
+                root->children.push_back( std::move( sibling ) );
+                _root = std::move( root );
+                return;
+            }
+            Node* parent = node->parent;
+            parent->boxes[ parent->indexOf( node ) ] = node->bounds();
+            sibling->parent = parent;
+            parent->boxes.push_back( sibling->bounds() );
+            parent->children.push_back( std::move( sibling ) );
+            node = parent;
+        } else {
+            adjustBounds( node );
+            return;
+        }
+    }
+}
+
+template < class Key, class Hash >
+auto    SpatialIndex< Key, Hash >::split( Node& node ) -> std::unique_ptr<Node>
+{
+    const auto count = node.size();
+    const auto& boxes = node.boxes;
+
+    // Pick seeds: the pair of entries that would waste the most area if grouped
+    std::size_t seedA = 0;
+    std::size_t seedB = 1;
+    double worstWaste = -std::numeric_limits<double>::max();
+    for ( std::size_t i = 0; i < count; ++i )
+        for ( std::size_t j = i + 1; j < count; ++j ) {
+            const auto waste = boxes[ i ].united( boxes[ j ] ).area() - boxes[ i ].area() - boxes[ j ].area();
+            if ( waste > worstWaste ) {
+                worstWaste = waste;
+                seedA = i;
+                seedB = j;
+            }
+        }
+
+    // Assign remaining entries to the group that need the least enlargement, while respecting minEntries
+    std::vector<int> group( count, -1 );
+    group[ seedA ] = 0;
+    group[ seedB ] = 1;
+    Box groupBoxes[ 2 ] = { boxes[ seedA ], boxes[ seedB ] };
+    std::size_t groupSizes[ 2 ] = { 1, 1 };
+    std::size_t remaining = count - 2;
+    while ( remaining > 0 ) {
+        int forcedGroup = -1;
+        if ( groupSizes[ 0 ] + remaining <= minEntries )
+            forcedGroup = 0;
+        else if ( groupSizes[ 1 ] + remaining <= minEntries )
+            forcedGroup = 1;
+
+        // Pick next entry: the one with the greatest preference for a group
+        std::size_t next = count;
+        double bestDifference = -1.;
+        double nextEnlargements[ 2 ] = { 0., 0. };
+        for ( std::size_t e = 0; e < count; ++e ) {
+            if ( group[ e ] >= 0 )
+                continue;
+            const double enlargements[ 2 ] = { groupBoxes[ 0 ].united( boxes[ e ] ).area() - groupBoxes[ 0 ].area(),
+                                               groupBoxes[ 1 ].united( boxes[ e ] ).area() - groupBoxes[ 1 ].area() };
+            const auto difference = std::abs( enlargements[ 0 ] - enlargements[ 1 ] );
+            if ( difference > bestDifference ) {
+                bestDifference = difference;
+                next = e;
+                nextEnlargements[ 0 ] = enlargements[ 0 ];
+                nextEnlargements[ 1 ] = enlargements[ 1 ];
+            }
+            if ( forcedGroup >= 0 )
+                break;
+        }
+        int g = forcedGroup;
+        if ( g < 0 ) {
+            if ( nextEnlargements[ 0 ] != nextEnlargements[ 1 ] )
+                g = nextEnlargements[ 0 ] < nextEnlargements[ 1 ] ? 0 : 1;
+            else if ( groupBoxes[ 0 ].area() != groupBoxes[ 1 ].area() )
+                g = groupBoxes[ 0 ].area() < groupBoxes[ 1 ].area() ? 0 : 1;
+            else
+                g = groupSizes[ 0 ] <= groupSizes[ 1 ] ? 0 : 1;
+        }
+        group[ next ] = g;
+        groupBoxes[ g ] = groupBoxes[ g ].united( boxes[ next ] );
+        ++groupSizes[ g ];
+        --remaining;
+    }
+
+    // Distribute entries, node keep group 0
+    auto sibling = std::make_unique<Node>( node.isLeaf );
+    Node kept{ node.isLeaf };
+    for ( std::size_t e = 0; e < count; ++e ) {
+        Node& target = group[ e ] == 0 ? kept : *sibling;
+        target.boxes.push_back( node.boxes[ e ] );
+        if ( node.isLeaf )
+            target.keys.push_back( node.keys[ e ] );
+        else
+            target.children.push_back( std::move( node.children[ e ] ) );
+    }
+    node.boxes = std::move( kept.boxes );
+    node.keys = std::move( kept.keys );
+    node.children = std::move( kept.children );
+    if ( node.isLeaf ) {
+        for ( const auto& key : sibling->keys )
+            _leaves[ key ] = sibling.get();
+    } else {
+        for ( auto& child : node.children )
+            child->parent = &node;
+        for ( auto& child : sibling->children )
+            child->parent = sibling.get();
+    }
+    return sibling;
+}
+
+template < class Key, class Hash >
+auto    SpatialIndex< Key, Hash >::adjustBounds( Node* node ) noexcept -> void
+{
+    while ( node->parent != nullptr ) {
+        Node* parent = node->parent;
+        parent->boxes[ parent->indexOf( node ) ] = node->bounds();
+        node = parent;
+    }
+}
+
+template < class Key, class Hash >
+auto    SpatialIndex< Key, Hash >::condenseTree( Node* leaf ) -> void
+{
+    std::vector<std::pair<Key, Box>> orphans;
+    Node* node = leaf;
+    while ( node->parent != nullptr ) {
+        Node* parent = node->parent;
+        const auto index = parent->indexOf( node );
+        if ( node->size() < minEntries ) {  // Underfull node: remove it and reinsert its elements
+            collectElements( *node, orphans );
+            parent->boxes.erase( parent->boxes.begin() + static_cast<std::ptrdiff_t>( index ) );
+            parent->children.erase( parent->children.begin() + static_cast<std::ptrdiff_t>( index ) );
+        } else
+            parent->boxes[ index ] = node->bounds();
+        node = parent;
+    }
+    // Shorten tree when root has a single child
+    while ( !_root->isLeaf &&
+            _root->size() == 1 ) {
+        auto child = std::move( _root->children.front() );
+        child->parent = nullptr;
+        _root = std::move( child );
+    }
+    if ( !_root->isLeaf &&
+         _root->size() == 0 )
+        _root = std::make_unique<Node>( true );
+    for ( const auto& orphan : orphans )
+        insertElement( orphan.first, orphan.second );
+}
+
+template < class Key, class Hash >
+auto    SpatialIndex< Key, Hash >::collectElements( Node& node, std::vector<std::pair<Key, Box>>& elements ) -> void
+{
+    if ( node.isLeaf ) {
+        for ( std::size_t e = 0; e < node.size(); ++e ) {
+            elements.emplace_back( node.keys[ e ], node.boxes[ e ] );
+            _leaves.erase( node.keys[ e ] );
+        }
+    } else
+        for ( auto& child : node.children )
+            collectElements( *child, elements );
+}
+//-----------------------------------------------------------------------------
+
+} // ::gtpo
@@ -0,0 +1,211 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoTreeLayout.h
+// \author	benoit@destrat.io
+// \date	2017 12 24
+//-----------------------------------------------------------------------------
+
+#ifndef gtpoTreeLayout_h
+#define gtpoTreeLayout_h
+
+// STD headers
+#include <cstddef>          // std::size_t
+#include <cstdint>          // std::uint8_t std::uint32_t
+#include <limits>
+#include <vector>
+
+// GTpo headers
+#include "./gtpoUtils.h"
+
+namespace gtpo { // ::gtpo
+
+/*! \brief Linear time tidy tree (Reingold-Tilford) and radial tree layouts.
+ *
+ * Layout works on a structure of arrays snapshot of a graph (node sizes, edges and roots). A spanning forest is
+ * extracted with a breadth first search from \c roots (or from nodes without in edges when \c roots is empty),
+ * nodes that are not reachable from a root (cycles) become additional roots.
+ *
+ * Subtrees are laid out bottom up: the contours of sibling subtrees are merged from left to right, every subtree
+ * being moved just far enough from its left siblings to respect \c siblingSpacing at every level, parents are then
+ * centered over their children. Contours are persistent linked lists shared between a subtree and its parent, a
+ * merge only allocate and walk O(min(h1, h2)) contour nodes for subtrees of heights h1 and h2, so that a complete
+ * layout is O(n). Subtrees contours and relative positions are kept after compute(): when a subtree is modified
+ * (for example collapsed or expanded), update() lay out this subtree again, then only re-merge the cached contours
+ * of its ancestors children.
+ *
+ * Descendants of \c collapsed nodes are not laid out, they are reported as not \c visible and positioned on
+ * their collapsed ancestor.
+ *
+ * \code
+ *   gtpo::TreeLayout layout;
+ *   const auto root = layout.addNode( 100., 50. );
+ *   const auto child = layout.addNode( 100., 50. );
+ *   layout.addEdge( root, child );
+ *   layout.compute();
+ *   layout.collapsed[root] = 1;
+ *   layout.update( root );        // Node centers are in layout.x and layout.y
+ * \endcode
+ * \nosubgrouping
+ */
+class TreeLayout
+{
+    /*! \name TreeLayout Object Management *///--------------------------------
+    //@{
+public:
+    TreeLayout() noexcept = default;
+    ~TreeLayout() = default;
+    TreeLayout( const TreeLayout& ) = delete;
+    TreeLayout& operator=( const TreeLayout& ) = delete;
+
+    //! Remove all nodes, edges and roots, allocated memory is kept for the next layout.
+    auto            clear() noexcept -> void;
+    inline auto     getNodeCount() const noexcept -> std::size_t { return width.size(); }
+    inline auto     getEdgeCount() const noexcept -> std::size_t { return edgeSrc.size(); }
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Layout Topology *///---------------------------------------------
+    //@{
+public:
+    //! Add a node of size (\c width, \c height) and return its index.
+    auto            addNode( double width, double height ) -> std::size_t;
+    /*! \brief Add an edge from \c parent to \c child and return its index.
+     *
+     * Children are ordered by edge insertion order, self loops are ignored.
+     * \throw gtpo::bad_topology_error if \c parent or \c child is not a valid node index.
+     */
+    auto            addEdge( std::size_t parent, std::size_t child ) noexcept( false ) -> std::size_t;
+
+public:
+    std::vector<double>         width, height;
+    //! Set to 1 for nodes whose subtree should not be laid out.
+    std::vector<std::uint8_t>   collapsed;
+
+    std::vector<std::uint32_t>  edgeSrc, edgeDst;
+
+    //! Tree roots in layout order, nodes without in edges are used when empty.
+    std::vector<std::uint32_t>  roots;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Layout Configuration *///----------------------------------------
+    //@{
+public:
+    //! Levels are ordered from left to right when true, from top to bottom otherwise (default to false).
+    bool            horizontal{ false };
+    //! Generate a radial layout with roots at center when true (default to false).
+    bool            radial{ false };
+    //! Minimum space between two nodes in the same level (default to 20.).
+    double          siblingSpacing{ 20. };
+    //! Minimum space between two levels (default to 60.).
+    double          levelSpacing{ 60. };
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Layout Computation *///------------------------------------------
+    //@{
+public:
+    //! Extract spanning forest and compute a complete layout, results are available in output arrays.
+    auto            compute() -> void;
+    /*! \brief Incremental layout after \c node subtree has been modified (nodes collapsed or expanded, or nodes sizes).
+     *
+     * Topology must not have been modified since last compute() call. Node \c node subtree is laid out again, then
+     * its ancestors children contours are re-merged: other subtrees layout is reused.
+     * \throw gtpo::bad_topology_error if \c node is invalid or if compute() has not been called.
+     */
+    auto            update( std::size_t node ) noexcept( false ) -> void;
+
+public:
+    enum : std::uint32_t { NoParent = std::numeric_limits<std::uint32_t>::max() };
+
+    //! Nodes center positions.
+    std::vector<double>         x, y;
+    //! Set to 0 for nodes inside a collapsed subtree.
+    std::vector<std::uint8_t>   visible;
+    //! Node parent in the spanning forest (NoParent for roots).
+    std::vector<std::uint32_t>  parent;
+    //! Node depth in the spanning forest (0 for roots).
+    std::vector<std::uint32_t>  depth;
+    //! Nodes whose position or visibility has changed during last compute() (all nodes) or update() call.
+    std::vector<std::uint32_t>  modified;
+
+private:
+    //! Persistent contour node: \c value at a given depth, \c nextShift is added to reach \c next node frame.
+    struct ContourNode {
+        double          value;
+        std::uint32_t   next;
+        double          nextShift;
+    };
+    //! Contour head node and its frame shift.
+    struct Contour {
+        std::uint32_t   head{ NoParent };
+        double          shift{ 0. };
+    };
+    //! Merge subtrees \c children contours from left to right, set children offsets and return merged contours height.
+    auto            mergeSubtrees( const std::uint32_t* children, std::size_t count,
+                                   Contour& left, Contour& right ) -> std::uint32_t;
+    //! Lay out subtree \c node (children first).
+    auto            layoutSubtree( std::uint32_t node ) -> void;
+    //! Lay out node \c node from its children cached contours.
+    auto            layoutNode( std::uint32_t node ) -> void;
+    //! Compute absolute positions from relative offsets.
+    auto            assignCoordinates() -> void;
+
+    inline auto     newContourNode( double value, std::uint32_t next, double nextShift ) -> std::uint32_t {
+        _contour.push_back( ContourNode{ value, next, nextShift } );
+        return static_cast<std::uint32_t>( _contour.size() - 1 );
+    }
+
+private:
+    std::vector<std::uint32_t>  _childBegin, _children;
+    std::vector<std::uint32_t>  _forestRoots;
+    //! Node center offset relative to its parent center (or to forest origin for roots).
+    std::vector<double>         _offset;
+    std::vector<Contour>        _left, _right;
+    std::vector<std::uint32_t>  _height;
+    std::vector<double>         _breadth;
+    std::vector<std::uint32_t>  _anchor;
+    std::vector<double>         _levelExtent;
+    Contour                     _forestLeft, _forestRight;
+    std::vector<ContourNode>    _contour;
+    std::vector<std::uint32_t>  _stack;
+    //! Positions and visibility before last update(), used to report modified nodes.
+    std::vector<double>         _previousX, _previousY;
+    std::vector<std::uint8_t>   _previousVisible;
+    //@}
+    //-------------------------------------------------------------------------
+};
+
+} // ::gtpo
+
+#include "./gtpoTreeLayout.hpp"
+
+#endif // gtpoTreeLayout_h
+
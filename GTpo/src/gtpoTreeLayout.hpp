@@ -0,0 +1,403 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoTreeLayout.hpp
+// \author	benoit@destrat.io
+// \date	2017 12 24
+//-----------------------------------------------------------------------------
+
+// STD headers
+#include <algorithm>    // std::max std::min
+#include <cmath>        // std::cos std::sin
+#include <numeric>      // std::iota
+
+namespace gtpo { // ::gtpo
+
+/* TreeLayout Object Management *///-------------------------------------------
+inline auto TreeLayout::clear() noexcept -> void
+{
+    width.clear();      height.clear();
+    collapsed.clear();
+    edgeSrc.clear();    edgeDst.clear();
+    roots.clear();
+    _childBegin.clear();
+}
+//-----------------------------------------------------------------------------
+
+/* Layout Topology *///--------------------------------------------------------
+inline auto TreeLayout::addNode( double nodeWidth, double nodeHeight ) -> std::size_t
+{
+    width.push_back( nodeWidth );
+    height.push_back( nodeHeight );
+    collapsed.push_back( 0 );
+    return width.size() - 1;
+}
+
+inline auto TreeLayout::addEdge( std::size_t src, std::size_t dst ) noexcept( false ) -> std::size_t
+{
+    gtpo::assert_throw( src < getNodeCount() && dst < getNodeCount(),
+                        "gtpo::TreeLayout::addEdge(): Error: invalid parent or child node index." );
+    edgeSrc.push_back( static_cast<std::uint32_t>( src ) );
+    edgeDst.push_back( static_cast<std::uint32_t>( dst ) );
+    return edgeSrc.size() - 1;
+}
+//-----------------------------------------------------------------------------
+
+/* Layout Computation *///-----------------------------------------------------
+inline auto TreeLayout::compute() -> void
+{
+    const auto nodeCount = getNodeCount();
+    collapsed.resize( nodeCount, 0 );
+    x.assign( nodeCount, 0. );
+    y.assign( nodeCount, 0. );
+    visible.assign( nodeCount, 1 );
+    parent.assign( nodeCount, NoParent );
+    depth.assign( nodeCount, 0 );
+    _offset.assign( nodeCount, 0. );
+    _left.assign( nodeCount, Contour{} );
+    _right.assign( nodeCount, Contour{} );
+    _height.assign( nodeCount, 0 );
+    _contour.clear();
+    _contour.reserve( 4 * nodeCount );
+    _forestRoots.clear();
+    _forestLeft = Contour{};
+    _forestRight = Contour{};
+
+    // Out edges in insertion order (counting sort on source)
+    std::vector<std::uint32_t> outBegin( nodeCount + 1, 0 );
+    for ( std::size_t e = 0; e < edgeSrc.size(); ++e )
+        if ( edgeSrc[e] != edgeDst[e] )
+            ++outBegin[edgeSrc[e] + 1];
+    for ( std::size_t n = 0; n < nodeCount; ++n )
+        outBegin[n + 1] += outBegin[n];
+    std::vector<std::uint32_t> outEdges( outBegin[nodeCount] );
+    {
+        std::vector<std::uint32_t> fill( outBegin.begin(), outBegin.end() - 1 );
+        for ( std::size_t e = 0; e < edgeSrc.size(); ++e )
+            if ( edgeSrc[e] != edgeDst[e] )
+                outEdges[fill[edgeSrc[e]]++] = edgeDst[e];
+    }
+
+    // Spanning forest: breadth first search from roots, unreached nodes become new roots
+    std::vector<std::uint8_t> reached( nodeCount, 0 );
+    std::vector<std::uint32_t> order;
+    order.reserve( nodeCount );
+    const auto visit = [&]( std::uint32_t root ) {
+        if ( reached[root] )
+            return;
+        reached[root] = 1;
+        _forestRoots.push_back( root );
+        auto head = order.size();
+        order.push_back( root );
+        while ( head < order.size() ) {
+            const auto n = order[head++];
+            for ( auto o = outBegin[n]; o < outBegin[n + 1]; ++o ) {
+                const auto child = outEdges[o];
+                if ( reached[child] )
+                    continue;
+                reached[child] = 1;
+                parent[child] = n;
+                depth[child] = depth[n] + 1;
+                order.push_back( child );
+            }
+        }
+    };
+    if ( roots.empty() ) {
+        std::vector<std::uint8_t> hasInEdge( nodeCount, 0 );
+        for ( std::size_t e = 0; e < edgeDst.size(); ++e )
+            if ( edgeSrc[e] != edgeDst[e] )
+                hasInEdge[edgeDst[e]] = 1;
+        for ( std::size_t n = 0; n < nodeCount; ++n )
+            if ( !hasInEdge[n] )
+                visit( static_cast<std::uint32_t>( n ) );
+    } else {
+        for ( const auto root : roots ) {
+            gtpo::assert_throw( root < nodeCount, "gtpo::TreeLayout::compute(): Error: invalid root node index." );
+            visit( root );
+        }
+    }
+    for ( std::size_t n = 0; n < nodeCount; ++n )
+        visit( static_cast<std::uint32_t>( n ) );
+
+    // Children CSR, breadth first order keep children in edge insertion order
+    _childBegin.assign( nodeCount + 1, 0 );
+    for ( std::size_t n = 0; n < nodeCount; ++n )
+        if ( parent[n] != NoParent )
+            ++_childBegin[parent[n] + 1];
+    for ( std::size_t n = 0; n < nodeCount; ++n )
+        _childBegin[n + 1] += _childBegin[n];
+    _children.resize( _childBegin[nodeCount] );
+    {
+        std::vector<std::uint32_t> fill( _childBegin.begin(), _childBegin.end() - 1 );
+        for ( const auto n : order )
+            if ( parent[n] != NoParent )
+                _children[fill[parent[n]]++] = n;
+    }
+
+    // Reverse breadth first order visit children before their parent
+    for ( auto n = order.rbegin(); n != order.rend(); ++n )
+        layoutNode( *n );
+    mergeSubtrees( _forestRoots.data(), _forestRoots.size(), _forestLeft, _forestRight );
+    assignCoordinates();
+    modified.resize( nodeCount );
+    std::iota( modified.begin(), modified.end(), 0 );
+}
+
+inline auto TreeLayout::update( std::size_t node ) noexcept( false ) -> void
+{
+    const auto nodeCount = getNodeCount();
+    gtpo::assert_throw( _childBegin.size() == nodeCount + 1 && _height.size() == nodeCount,
+                        "gtpo::TreeLayout::update(): Error: compute() must be called after a topology modification." );
+    gtpo::assert_throw( node < nodeCount, "gtpo::TreeLayout::update(): Error: invalid node index." );
+    collapsed.resize( nodeCount, 0 );
+
+    // Contour nodes are never released by incremental updates, restart from scratch when unused nodes dominate
+    if ( _contour.size() > 8 * nodeCount + 1024 ) {
+        compute();
+        return;
+    }
+    _previousX = x;
+    _previousY = y;
+    _previousVisible = visible;
+    layoutSubtree( static_cast<std::uint32_t>( node ) );
+    for ( auto ancestor = parent[node]; ancestor != NoParent; ancestor = parent[ancestor] )
+        layoutNode( ancestor );
+    mergeSubtrees( _forestRoots.data(), _forestRoots.size(), _forestLeft, _forestRight );
+    assignCoordinates();
+    modified.clear();
+    for ( std::size_t n = 0; n < nodeCount; ++n )
+        if ( x[n] != _previousX[n] || y[n] != _previousY[n] || visible[n] != _previousVisible[n] )
+            modified.push_back( static_cast<std::uint32_t>( n ) );
+}
+
+inline auto TreeLayout::layoutSubtree( std::uint32_t node ) -> void
+{
+    // Collect expanded subtree in pre order, then lay it out in reverse order
+    _stack.clear();
+    _stack.push_back( node );
+    for ( std::size_t s = 0; s < _stack.size(); ++s ) {
+        const auto n = _stack[s];
+        if ( collapsed[n] )
+            continue;
+        for ( auto c = _childBegin[n]; c < _childBegin[n + 1]; ++c )
+            _stack.push_back( _children[c] );
+    }
+    for ( auto n = _stack.rbegin(); n != _stack.rend(); ++n )
+        layoutNode( *n );
+}
+
+inline auto TreeLayout::layoutNode( std::uint32_t node ) -> void
+{
+    const double half = ( horizontal ? height[node] : width[node] ) / 2.;
+    const auto childCount = _childBegin[node + 1] - _childBegin[node];
+    if ( collapsed[node] || childCount == 0 ) {
+        _left[node] = Contour{ newContourNode( -half, NoParent, 0. ), 0. };
+        _right[node] = Contour{ newContourNode( half, NoParent, 0. ), 0. };
+        _height[node] = 1;
+        return;
+    }
+    Contour left, right;
+    const auto childHeight = mergeSubtrees( _children.data() + _childBegin[node], childCount, left, right );
+    _left[node] = Contour{ newContourNode( -half, left.head, left.shift ), 0. };
+    _right[node] = Contour{ newContourNode( half, right.head, right.shift ), 0. };
+    _height[node] = childHeight + 1;
+}
+
+inline auto TreeLayout::mergeSubtrees( const std::uint32_t* children, std::size_t count,
+                                       Contour& left, Contour& right ) -> std::uint32_t
+{
+    left = Contour{};
+    right = Contour{};
+    if ( count == 0 )
+        return 0;
+
+    // Contour cursor: value at current depth is _contour[node].value + shift
+    struct Cursor {
+        std::uint32_t   node;
+        double          shift;
+    };
+    const auto advance = [this]( Cursor& cursor ) {
+        cursor.shift += _contour[cursor.node].nextShift;
+        cursor.node = _contour[cursor.node].next;
+    };
+
+    // Merged forest contours are expressed in first subtree frame
+    left = _left[children[0]];
+    right = _right[children[0]];
+    auto mergedHeight = _height[children[0]];
+    _offset[children[0]] = 0.;
+    for ( std::size_t c = 1; c < count; ++c ) {
+        const auto child = children[c];
+        const auto childHeight = _height[child];
+        const auto common = std::min( mergedHeight, childHeight );
+
+        // Minimum separation respecting sibling spacing at every common depth
+        Cursor forestRight{ right.head, right.shift };
+        Cursor childLeft{ _left[child].head, _left[child].shift };
+        auto position = std::numeric_limits<double>::lowest();
+        for ( std::uint32_t d = 0; d < common; ++d ) {
+            position = std::max( position, ( _contour[forestRight.node].value + forestRight.shift ) -
+                                           ( _contour[childLeft.node].value + childLeft.shift ) );
+            if ( d + 1 < common ) {
+                advance( forestRight );
+                advance( childLeft );
+            }
+        }
+        position += siblingSpacing;
+        _offset[child] = position;
+
+        // Right contour: child right contour, deeper forest right contour when forest is higher
+        if ( childHeight >= mergedHeight ) {
+            right = Contour{ _right[child].head, _right[child].shift + position };
+        } else {
+            Cursor forest{ right.head, right.shift };
+            Cursor source{ _right[child].head, _right[child].shift + position };
+            std::uint32_t head = NoParent, last = NoParent;
+            for ( std::uint32_t d = 0; d < childHeight; ++d ) {
+                const auto node = newContourNode( _contour[source.node].value + source.shift, NoParent, 0. );
+                if ( last == NoParent )
+                    head = node;
+                else
+                    _contour[last].next = node;
+                last = node;
+                advance( source );
+                advance( forest );
+            }
+            _contour[last].next = forest.node;
+            _contour[last].nextShift = forest.shift;
+            right = Contour{ head, 0. };
+        }
+
+        // Left contour: forest left contour, deeper child left contour when child is higher
+        if ( childHeight > mergedHeight ) {
+            Cursor forest{ left.head, left.shift };
+            Cursor source{ _left[child].head, _left[child].shift + position };
+            std::uint32_t head = NoParent, last = NoParent;
+            for ( std::uint32_t d = 0; d < mergedHeight; ++d ) {
+                const auto node = newContourNode( _contour[forest.node].value + forest.shift, NoParent, 0. );
+                if ( last == NoParent )
+                    head = node;
+                else
+                    _contour[last].next = node;
+                last = node;
+                advance( forest );
+                advance( source );
+            }
+            _contour[last].next = source.node;
+            _contour[last].nextShift = source.shift;
+            left = Contour{ head, 0. };
+        }
+        mergedHeight = std::max( mergedHeight, childHeight );
+    }
+
+    // Center subtrees around merged frame origin
+    const double middle = ( _offset[children[0]] + _offset[children[count - 1]] ) / 2.;
+    for ( std::size_t c = 0; c < count; ++c )
+        _offset[children[c]] -= middle;
+    left.shift -= middle;
+    right.shift -= middle;
+    return mergedHeight;
+}
+
+inline auto TreeLayout::assignCoordinates() -> void
+{
+    const auto nodeCount = getNodeCount();
+    _breadth.assign( nodeCount, 0. );
+    _anchor.assign( nodeCount, NoParent );
+    _levelExtent.clear();
+
+    // Pre order: absolute breadth position, visibility and levels extent
+    _stack.clear();
+    for ( auto r = _forestRoots.rbegin(); r != _forestRoots.rend(); ++r )
+        _stack.push_back( *r );
+    double minBreadth = std::numeric_limits<double>::max();
+    double maxBreadth = std::numeric_limits<double>::lowest();
+    while ( !_stack.empty() ) {
+        const auto n = _stack.back();
+        _stack.pop_back();
+        const auto p = parent[n];
+        if ( p != NoParent && ( !visible[p] || collapsed[p] ) ) {
+            visible[n] = 0;
+            _anchor[n] = visible[p] ? p : _anchor[p];
+        } else {
+            visible[n] = 1;
+            _breadth[n] = ( p != NoParent ? _breadth[p] : 0. ) + _offset[n];
+            const double half = ( horizontal ? height[n] : width[n] ) / 2.;
+            minBreadth = std::min( minBreadth, _breadth[n] - half );
+            maxBreadth = std::max( maxBreadth, _breadth[n] + half );
+            if ( depth[n] >= _levelExtent.size() )
+                _levelExtent.resize( depth[n] + 1, 0. );
+            _levelExtent[depth[n]] = std::max( _levelExtent[depth[n]], horizontal ? width[n] : height[n] );
+        }
+        for ( auto c = _childBegin[n + 1]; c > _childBegin[n]; --c )
+            _stack.push_back( _children[c - 1] );
+    }
+    if ( _levelExtent.empty() )
+        return;
+
+    // Levels centers (stored in place of levels extents)
+    double level = 0.;
+    for ( auto& extent : _levelExtent ) {
+        const auto current = extent;
+        extent = level + current / 2.;
+        level += current + levelSpacing;
+    }
+
+    const double pi = 3.14159265358979323846;
+    const double span = std::max( maxBreadth - minBreadth, 1. );
+    const double levelOrigin = _levelExtent[0] - ( _forestRoots.size() > 1 ? levelSpacing : 0. );
+    for ( std::size_t n = 0; n < nodeCount; ++n ) {
+        if ( !visible[n] )
+            continue;
+        const double b = _breadth[n] - minBreadth;
+        const double l = _levelExtent[depth[n]];
+        if ( radial ) {
+            const double angle = 2. * pi * b / span;
+            const double radius = l - levelOrigin;
+            x[n] = radius * std::cos( angle );
+            y[n] = radius * std::sin( angle );
+        } else if ( horizontal ) {
+            x[n] = l;
+            y[n] = b;
+        } else {
+            x[n] = b;
+            y[n] = l;
+        }
+    }
+    for ( std::size_t n = 0; n < nodeCount; ++n ) {
+        if ( visible[n] || _anchor[n] == NoParent )
+            continue;
+        x[n] = x[_anchor[n]];
+        y[n] = y[_anchor[n]];
+    }
+}
+//-----------------------------------------------------------------------------
+
+} // ::gtpo
+
@@ -37,9 +37,16 @@
 
 // STD headers
 #include <algorithm>
-#include <exception>    // std::runtime_error
+#include <exception>    // std::runtime_error std::exception_ptr
 #include <memory>       // std::weak_ptr
 #include <iostream>     // std::cout
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>      // std::size_t
+#include <functional>   // std::function
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace gtpo { // ::gtpo
 
@@ -58,6 +65,18 @@ public:
     bad_topology_error () : bad_topology_error( "GTpo topology unrecoverable error." ) { }
 };
 
+/*! \brief Exception thrown by GTpo serializers when an input is malformed or an output could not be written.
+ *
+ * Use what() to have a detailled error description.
+ */
+class bad_serialization_error : public std::runtime_error
+{
+public:
+    explicit bad_serialization_error (const std::string& what_arg) : std::runtime_error( what_arg ) { }
+    explicit bad_serialization_error (const char* what_arg) : std::runtime_error( what_arg ) { }
+    bad_serialization_error () : bad_serialization_error( "GTpo serialization unrecoverable error." ) { }
+};
+
 /*! Standard GTpo utility to assert an expression  \c expr and throw an exception if \c expr is *false*.
  *
  * Used with no template parameter, assert_throw will throw a gtpo::bad_topology_error with a given \c message.
@@ -90,6 +109,152 @@ auto    find_weak_ptr( const C& container, const T& element ) -> bool {
 }
 
 
+//! Return \c threadCount, or the number of available hardware threads if \c threadCount is 0 (at least 1).
+inline auto     resolveThreadCount( unsigned int threadCount ) noexcept -> unsigned int {
+    return threadCount != 0 ? threadCount : std::max( 1u, std::thread::hardware_concurrency() );
+}
+
+/*! \brief Worker threads kept alive between parallelFor() calls, for algorithms running many short parallel loops.
+ *
+ * The calling thread always takes part in a loop as thread 0, a pool of \c n threads then owns \c n - 1 worker
+ * threads. Worker threads are joined when the pool is destroyed (or if creating them fails).
+ *
+ * \code
+ *   gtpo::ThreadPool pool{ gtpo::resolveThreadCount( 0 ) };
+ *   for ( int iteration = 0; iteration < 100; ++iteration )
+ *     pool.parallelFor( values.size(), [&values]( std::size_t i, unsigned int thread ) { values[i] *= 2.; } );
+ * \endcode
+ */
+class ThreadPool
+{
+public:
+    //! Create a pool of \c threadCount threads, including calling thread (0 to use all available hardware threads).
+    explicit ThreadPool( unsigned int threadCount = 0 ) noexcept( false ) {
+        const auto workerCount = resolveThreadCount( threadCount ) - 1;
+        _workers.reserve( workerCount );
+        try {
+            for ( unsigned int t = 1; t <= workerCount; ++t )
+                _workers.emplace_back( [this, t]() { run( t ); } );
+        } catch ( ... ) {
+            stop();         // Do not destroy joinable threads
+            throw;
+        }
+    }
+    ~ThreadPool() noexcept { stop(); }
+    ThreadPool( const ThreadPool& ) = delete;
+    ThreadPool& operator=( const ThreadPool& ) = delete;
+
+    //! Number of threads used by parallelFor(), including calling thread.
+    inline auto     getThreadCount() const noexcept -> unsigned int { return static_cast<unsigned int>( _workers.size() ) + 1; }
+
+    /*! \brief Call \c work( i, thread ) for every i in [0, \c count) concurrently, return once all calls have returned.
+     *
+     * Indexes are dynamically dispatched to threads, \c thread is the index of the calling thread in
+     * [0, getThreadCount()) and could be used to access per thread data.
+     * \throw first exception thrown by \c work (remaining indexes are not processed).
+     */
+    template < class Work >
+    auto            parallelFor( std::size_t count, Work&& work ) noexcept( false ) -> void {
+        if ( count == 0 )
+            return;
+        std::atomic<std::size_t> next{ 0 };
+        std::atomic<bool> failed{ false };
+        std::exception_ptr error;
+        std::mutex errorMutex;
+        const auto loop = [&]( unsigned int thread ) noexcept {
+            try {
+                for ( auto i = next++; i < count && !failed; i = next++ )
+                    work( i, thread );
+            } catch ( ... ) {
+                std::lock_guard<std::mutex> lock{ errorMutex };
+                if ( !error )
+                    error = std::current_exception();
+                failed = true;
+            }
+        };
+        const auto helpers = static_cast<unsigned int>( std::min<std::size_t>( _workers.size(), count - 1 ) );
+        if ( helpers == 0 )
+            loop( 0 );
+        else {
+            {
+                std::lock_guard<std::mutex> lock{ _mutex };
+                _task = [&loop]( unsigned int thread ) { loop( thread ); };
+                _helpers = helpers;
+                _active = helpers;
+                ++_generation;
+            }
+            _wake.notify_all();
+            loop( 0 );
+            std::unique_lock<std::mutex> lock{ _mutex };
+            _done.wait( lock, [this]() { return _active == 0; } );
+            _task = nullptr;
+        }
+        if ( error )
+            std::rethrow_exception( error );
+    }
+
+private:
+    //! Worker thread \c thread loop: wait for a new parallelFor() generation and take part in it if required.
+    auto            run( unsigned int thread ) noexcept -> void {
+        std::size_t generation = 0;
+        for ( ;; ) {
+            const std::function<void( unsigned int )>* task = nullptr;
+            {
+                std::unique_lock<std::mutex> lock{ _mutex };
+                _wake.wait( lock, [this, generation]() { return _stopped || _generation != generation; } );
+                if ( _stopped )
+                    return;
+                generation = _generation;
+                if ( thread > _helpers )
+                    continue;
+                task = &_task;      // Not modified until all helpers have finished
+            }
+            ( *task )( thread );    // Exceptions are catched in parallelFor() loop
+            std::lock_guard<std::mutex> lock{ _mutex };
+            if ( --_active == 0 )
+                _done.notify_one();
+        }
+    }
+    //! Stop and join all worker threads.
+    auto            stop() noexcept -> void {
+        {
+            std::lock_guard<std::mutex> lock{ _mutex };
+            _stopped = true;
+        }
+        _wake.notify_all();
+        for ( auto& worker : _workers )
+            if ( worker.joinable() )
+                worker.join();
+    }
+
+    std::vector<std::thread>                _workers;
+    std::mutex                              _mutex;
+    std::condition_variable                 _wake, _done;
+    std::function<void( unsigned int )>     _task;
+    std::size_t                             _generation{ 0 };
+    unsigned int                            _helpers{ 0 };
+    unsigned int                            _active{ 0 };
+    bool                                    _stopped{ false };
+};
+
+/*! \brief Call \c work( i, thread ) for every i in [0, \c count) on at most \c threadCount threads (0 to use all available hardware threads).
+ *
+ * Threads are created for this call only (see gtpo::ThreadPool to reuse threads for many calls), and are joined
+ * before returning, even if an exception is thrown.
+ * \throw first exception thrown by \c work (remaining indexes are not processed).
+ */
+template < class Work >
+auto    parallelFor( std::size_t count, unsigned int threadCount, Work&& work ) noexcept( false ) -> void {
+    const auto threads = static_cast<unsigned int>( std::min<std::size_t>( resolveThreadCount( threadCount ), count ) );
+    if ( threads <= 1 ) {
+        for ( std::size_t i = 0; i < count; ++i )
+            work( i, 0u );
+        return;
+    }
+    ThreadPool pool{ threads };
+    pool.parallelFor( count, std::forward<Work>( work ) );
+}
+
 /*! Configuration interface for accessing graph containers.
  *
  * GTpo GenGraph Config configuration struct should inherit from ContainerAccessors since
@@ -0,0 +1,234 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoXmlSerializer.h
+// \author	benoit@destrat.io
+// \date	2017 12 04
+//-----------------------------------------------------------------------------
+
+#ifndef gtpoXmlSerializer_h
+#define gtpoXmlSerializer_h
+
+// STD headers
+#include <string>
+#include <memory>           // std::unique_ptr
+#include <fstream>
+#include <unordered_map>
+
+// GTpo headers
+#include "./GTpo.h"
+#include "./gtpoXmlStream.h"
+#include "./gtpoProgressNotifier.h"
+
+namespace gtpo { // ::gtpo
+
+/*! \brief Base class for streaming XML graph readers (GraphML, GEXF).
+ *
+ * Input is parsed with a gtpo::XmlStreamReader pull parser: no DOM is ever built, nodes and
+ * edges are inserted in the target graph as soon as their element is read. Memory used during
+ * parsing is bounded by the reader buffer size (see setBufferSize()) plus a node identifier
+ * to node map, input file size has no influence on memory consumption.
+ *
+ * GraphML and GEXF share the same \c node (\c id attribute) and \c edge (\c source and \c target
+ * attributes) elements, concrete serializers only specify their root element name. Nested graphs
+ * (GraphML nested graph, GEXF hierarchical nodes) are flattened. An edge may reference a node
+ * declared later in input, the node is then created when the edge is read.
+ *
+ * Node and edge creation could be customized by overriding createNode() and createEdge(), while
+ * readNode() and readEdge() allow reading custom attributes or data sub elements.
+ *
+ * \nosubgrouping
+ */
+template < class Config = GraphConfig >
+class InXmlSerializer
+{
+    /*! \name InXmlSerializer Object Management *///---------------------------
+    //@{
+public:
+    using Graph     = GenGraph< Config >;
+    using WeakNode  = typename Graph::WeakNode;
+    using WeakEdge  = typename Graph::WeakEdge;
+
+    /*! \brief Read graph from file \c fileName with a \c rootElement root XML element.
+     *
+     * \throw gtpo::bad_serialization_error if \c fileName can't be opened.
+     */
+    InXmlSerializer( const std::string& fileName, std::string rootElement ) noexcept( false );
+    //! Read graph from \c input stream with a \c rootElement root XML element (\c input must outlive this serializer).
+    InXmlSerializer( std::istream& input, std::string rootElement ) noexcept;
+    virtual ~InXmlSerializer() noexcept = default;
+    InXmlSerializer( const InXmlSerializer& ) = delete;
+    InXmlSerializer& operator=( const InXmlSerializer& ) = delete;
+
+private:
+    std::unique_ptr< std::ifstream >    _file;
+    std::istream&                       _input;
+    const std::string                   _rootElement;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Serialization Management *///------------------------------------
+    //@{
+public:
+    /*! \brief Read input and insert its nodes and edges in \c graph.
+     *
+     * \c progress is updated every 256kB of input when input size is known.
+     * \throw gtpo::bad_serialization_error if input is malformed, gtpo::bad_topology_error if \c graph insertion fails.
+     */
+    auto            serializeIn( Graph& graph, IProgressNotifier* progress = nullptr ) noexcept( false ) -> void;
+
+    //! Input chunk size used by the XML reader (default to 64kB).
+    inline auto     setBufferSize( std::size_t bufferSize ) noexcept -> void { _bufferSize = bufferSize; }
+    //! \copydoc setBufferSize()
+    inline auto     getBufferSize() const noexcept -> std::size_t { return _bufferSize; }
+
+    //! Number of nodes read during last serializeIn() call (including nodes created from forward references).
+    inline auto     getNodeCount() const noexcept -> std::size_t { return _nodeCount; }
+    //! Number of edges read during last serializeIn() call.
+    inline auto     getEdgeCount() const noexcept -> std::size_t { return _edgeCount; }
+    //! Number of bytes read during last serializeIn() call.
+    inline auto     getBytesRead() const noexcept -> std::size_t { return _bytesRead; }
+
+protected:
+    //! Create a node in \c graph, default implementation use GenGraph<>::createNode().
+    virtual auto    createNode( Graph& graph ) noexcept( false ) -> WeakNode { return graph.createNode(); }
+    //! Create an edge in \c graph, default implementation use GenGraph<>::createEdge().
+    virtual auto    createEdge( Graph& graph, WeakNode source, WeakNode destination ) noexcept( false ) -> WeakEdge {
+        return graph.createEdge( source, destination );
+    }
+    /*! \brief Called when a \c node element is read, \c xml current token is the node StartElement.
+     *
+     * Default implementation does nothing, overriding method could read \c node attributes or
+     * consume its sub elements, but should not read past the node EndElement.
+     */
+    virtual auto    readNode( WeakNode& node, XmlStreamReader& xml ) noexcept( false ) -> void { (void)node; (void)xml; }
+    //! Called when an \c edge element is read, \c xml current token is the edge StartElement \sa readNode().
+    virtual auto    readEdge( WeakEdge& edge, XmlStreamReader& xml ) noexcept( false ) -> void { (void)edge; (void)xml; }
+
+private:
+    //! Return the node with identifier \c id, eventually creating it (\c declaration is true when id is read from a node element).
+    auto            internNode( Graph& graph, const std::string& id, bool declaration ) noexcept( false ) -> WeakNode;
+
+private:
+    std::size_t     _bufferSize = 64 * 1024;
+    std::size_t     _nodeCount = 0;
+    std::size_t     _edgeCount = 0;
+    std::size_t     _bytesRead = 0;
+    //! Map input node identifiers to (node, node has been declared) pairs.
+    std::unordered_map< std::string, std::pair< WeakNode, bool > >  _nodes;
+    //@}
+    //-------------------------------------------------------------------------
+};
+
+/*! \brief Base class for streaming XML graph writers (GraphML, GEXF).
+ *
+ * Output is written with a gtpo::XmlStreamWriter, memory used during serialization is
+ * bounded by the writer buffer plus a node to identifier map.
+ *
+ * Concrete serializers implement serializeOut(), finishOut() must be called once all graphs
+ * have been serialized to close the document.
+ *
+ * \nosubgrouping
+ */
+template < class Config = GraphConfig >
+class OutXmlSerializer
+{
+    /*! \name OutXmlSerializer Object Management *///--------------------------
+    //@{
+public:
+    using Graph     = GenGraph< Config >;
+
+    /*! \brief Write graph to file \c fileName.
+     *
+     * \throw gtpo::bad_serialization_error if \c fileName can't be opened.
+     */
+    explicit OutXmlSerializer( const std::string& fileName ) noexcept( false );
+    //! Write graph to \c output stream (\c output must outlive this serializer).
+    explicit OutXmlSerializer( std::ostream& output ) noexcept( false );
+    virtual ~OutXmlSerializer() noexcept = default;
+    OutXmlSerializer( const OutXmlSerializer& ) = delete;
+    OutXmlSerializer& operator=( const OutXmlSerializer& ) = delete;
+
+private:
+    std::unique_ptr< std::ofstream >    _file;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Serialization Management *///------------------------------------
+    //@{
+public:
+    /*! \brief Write \c graph nodes and edges to output.
+     *
+     * \throw gtpo::bad_serialization_error if output can't be written.
+     */
+    virtual auto    serializeOut( const Graph& graph, IProgressNotifier* progress = nullptr ) noexcept( false ) -> void = 0;
+    //! Close the output document and flush output.
+    virtual auto    finishOut() noexcept( false ) -> void { _xml.writeEndDocument(); }
+
+    //! Number of bytes written to output.
+    inline auto     getBytesWritten() const noexcept -> std::size_t { return _xml.getBytesWritten(); }
+
+protected:
+    inline auto     getXml() noexcept -> XmlStreamWriter& { return _xml; }
+
+    /*! \brief Write \c graph nodes with writeNode() and edges with writeEdge() in current element.
+     *
+     * Nodes are identified with their index in graph node container, non serializable edges and
+     * restricted hyper edges are ignored.
+     */
+    auto            serializeTopology( const Graph& graph, IProgressNotifier* progress ) noexcept( false ) -> void;
+    //! Called before first node is written, default implementation does nothing.
+    virtual auto    beginNodes() noexcept( false ) -> void { }
+    //! Called after last node has been written, default implementation does nothing.
+    virtual auto    endNodes() noexcept( false ) -> void { }
+    //! Write node element with identifier \c id, default implementation write an empty \c node element.
+    virtual auto    writeNode( const typename Graph::SharedNode& node, const std::string& id ) noexcept( false ) -> void;
+    //! Called before first edge is written, default implementation does nothing.
+    virtual auto    beginEdges() noexcept( false ) -> void { }
+    //! Called after last edge has been written, default implementation does nothing.
+    virtual auto    endEdges() noexcept( false ) -> void { }
+    //! Write edge element with identifier \c id, default implementation write an empty \c edge element.
+    virtual auto    writeEdge( const typename Graph::SharedEdge& edge, const std::string& id,
+                               const std::string& source, const std::string& target ) noexcept( false ) -> void;
+
+    //! Set \c id to \c prefix followed by \c index decimal representation (without reallocating \c id).
+    static auto     formatId( std::string& id, char prefix, std::size_t index ) noexcept( false ) -> void;
+
+private:
+    XmlStreamWriter _xml;
+    //@}
+    //-------------------------------------------------------------------------
+};
+
+} // ::gtpo
+
+#include "./gtpoXmlSerializer.hpp"
+
+#endif // gtpoXmlSerializer_h
+
@@ -0,0 +1,247 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoXmlSerializer.hpp
+// \author	benoit@destrat.io
+// \date	2017 12 04
+//-----------------------------------------------------------------------------
+
+namespace gtpo { // ::gtpo
+
+/* InXmlSerializer Object Management *///-------------------------------------
+template < class Config >
+InXmlSerializer< Config >::InXmlSerializer( const std::string& fileName, std::string rootElement ) :
+    _file{ new std::ifstream{ fileName, std::ios::in | std::ios::binary } },
+    _input( *_file ),
+    _rootElement{ std::move( rootElement ) }
+{
+    assert_throw< gtpo::bad_serialization_error >( _file->is_open(), "gtpo::InXmlSerializer<>::InXmlSerializer(): Error: Can't open input file " + fileName );
+}
+
+template < class Config >
+InXmlSerializer< Config >::InXmlSerializer( std::istream& input, std::string rootElement ) noexcept :
+    _input( input ),
+    _rootElement{ std::move( rootElement ) }
+{
+}
+//-----------------------------------------------------------------------------
+
+/* Serialization Management *///-----------------------------------------------
+template < class Config >
+auto    InXmlSerializer< Config >::serializeIn( Graph& graph, IProgressNotifier* progress ) -> void
+{
+    _nodeCount = 0;
+    _edgeCount = 0;
+    _bytesRead = 0;
+    _nodes.clear();
+
+    // Input size is used only for progress reporting, it might be unknown for non seekable streams
+    std::size_t inputSize = 0;
+    if ( progress != nullptr ) {
+        const auto begin = _input.tellg();
+        if ( begin != std::istream::pos_type( -1 ) &&
+             _input.seekg( 0, std::ios::end ) ) {
+            const auto end = _input.tellg();
+            if ( end != std::istream::pos_type( -1 ) && end > begin )
+                inputSize = static_cast< std::size_t >( end - begin );
+            _input.seekg( begin );
+        }
+        _input.clear();
+        progress->setProgress( 0. );
+    }
+    constexpr std::size_t progressStep = 256 * 1024;
+    std::size_t nextProgress = progressStep;
+
+    XmlStreamReader xml{ _input, _bufferSize };
+    bool rootFound = false;
+    for ( auto token = xml.readNext(); token != XmlStreamReader::Token::EndDocument; token = xml.readNext() ) {
+        if ( token != XmlStreamReader::Token::StartElement )
+            continue;
+        const auto& name = xml.getName();
+        if ( xml.getDepth() == 1 ) {
+            assert_throw< gtpo::bad_serialization_error >( name == _rootElement,
+                                                          "gtpo::InXmlSerializer<>::serializeIn(): Error: Unexpected root element <" + name + ">, expecting <" + _rootElement + ">." );
+            rootFound = true;
+        } else if ( name == "node" ) {
+            const auto id = xml.findAttribute( "id" );
+            if ( id == nullptr )    // Note: do not use assert_throw() to avoid building error message for every node
+                throw gtpo::bad_serialization_error( "gtpo::InXmlSerializer<>::serializeIn(): Error: Node with no id at line " + std::to_string( xml.getLineNumber() ) );
+            auto node = internNode( graph, *id, true );
+            readNode( node, xml );
+        } else if ( name == "edge" ) {
+            const auto source = xml.findAttribute( "source" );
+            const auto target = xml.findAttribute( "target" );
+            if ( source == nullptr || target == nullptr )
+                throw gtpo::bad_serialization_error( "gtpo::InXmlSerializer<>::serializeIn(): Error: Edge with no source or target at line " + std::to_string( xml.getLineNumber() ) );
+            auto sourceNode = internNode( graph, *source, false );
+            auto targetNode = internNode( graph, *target, false );
+            auto edge = createEdge( graph, sourceNode, targetNode );
+            ++_edgeCount;
+            readEdge( edge, xml );
+        }
+        if ( inputSize > 0 &&
+             xml.getBytesRead() >= nextProgress ) {
+            progress->setProgress( static_cast< double >( xml.getBytesRead() ) / static_cast< double >( inputSize ) );
+            nextProgress = xml.getBytesRead() + progressStep;
+        }
+    }
+    _bytesRead = xml.getBytesRead();
+    _nodes.clear();
+    assert_throw< gtpo::bad_serialization_error >( rootFound, "gtpo::InXmlSerializer<>::serializeIn(): Error: No <" + _rootElement + "> root element found in input." );
+    if ( progress != nullptr )
+        progress->setProgress( 1. );
+}
+
+template < class Config >
+auto    InXmlSerializer< Config >::internNode( Graph& graph, const std::string& id, bool declaration ) -> WeakNode
+{
+    auto nodeIter = _nodes.find( id );
+    if ( nodeIter == _nodes.end() ) {
+        auto node = createNode( graph );
+        _nodes.emplace( id, std::make_pair( node, declaration ) );
+        ++_nodeCount;
+        return node;
+    }
+    if ( declaration ) {
+        if ( nodeIter->second.second )
+            throw gtpo::bad_serialization_error( "gtpo::InXmlSerializer<>::internNode(): Error: Duplicate node id " + id );
+        nodeIter->second.second = true;
+    }
+    return nodeIter->second.first;
+}
+//-----------------------------------------------------------------------------
+
+
+/* OutXmlSerializer Object Management *///------------------------------------
+template < class Config >
+OutXmlSerializer< Config >::OutXmlSerializer( const std::string& fileName ) :
+    _file{ new std::ofstream{ fileName, std::ios::out | std::ios::binary | std::ios::trunc } },
+    _xml{ *_file }
+{
+    assert_throw< gtpo::bad_serialization_error >( _file->is_open(), "gtpo::OutXmlSerializer<>::OutXmlSerializer(): Error: Can't open output file " + fileName );
+}
+
+template < class Config >
+OutXmlSerializer< Config >::OutXmlSerializer( std::ostream& output ) :
+    _xml{ output }
+{
+}
+//-----------------------------------------------------------------------------
+
+/* Serialization Management *///-----------------------------------------------
+template < class Config >
+auto    OutXmlSerializer< Config >::serializeTopology( const Graph& graph, IProgressNotifier* progress ) -> void
+{
+    const double total = static_cast< double >( graph.getNodeCount() + graph.getEdgeCount() ) + 1.;
+    constexpr std::size_t progressStep = 4096;
+    std::size_t written = 0;
+
+    // Nodes have no identifier in GTpo, use node index in graph nodes container
+    std::unordered_map< const void*, std::size_t > nodesIndex;
+    nodesIndex.reserve( static_cast< std::size_t >( graph.getNodeCount() ) );
+    std::string id, source, target;
+
+    beginNodes();
+    for ( const auto& node : graph.getNodes() ) {
+        if ( !node )
+            continue;
+        const auto index = nodesIndex.size();
+        nodesIndex.emplace( node.get(), index );
+        formatId( id, 'n', index );
+        writeNode( node, id );
+        if ( progress != nullptr &&
+             ++written % progressStep == 0 )
+            progress->setProgress( static_cast< double >( written ) / total );
+    }
+    endNodes();
+
+    beginEdges();
+    std::size_t edgeIndex = 0;
+    for ( const auto& edge : graph.getEdges() ) {
+        if ( progress != nullptr &&
+             ++written % progressStep == 0 )
+            progress->setProgress( static_cast< double >( written ) / total );
+        if ( !edge ||
+             !edge->isSerializable() )
+            continue;
+        const auto sourceNode = edge->getSrc().lock();
+        const auto targetNode = edge->getDst().lock();
+        if ( !sourceNode || !targetNode )     // Restricted hyper edges can't be serialized
+            continue;
+        const auto sourceIndex = nodesIndex.find( sourceNode.get() );
+        const auto targetIndex = nodesIndex.find( targetNode.get() );
+        if ( sourceIndex == nodesIndex.end() ||
+             targetIndex == nodesIndex.end() )
+            continue;
+        formatId( id, 'e', edgeIndex++ );
+        formatId( source, 'n', sourceIndex->second );
+        formatId( target, 'n', targetIndex->second );
+        writeEdge( edge, id, source, target );
+    }
+    endEdges();
+    if ( progress != nullptr )
+        progress->setProgress( 1. );
+}
+
+template < class Config >
+auto    OutXmlSerializer< Config >::writeNode( const typename Graph::SharedNode& node, const std::string& id ) -> void
+{
+    (void)node;
+    _xml.writeStartElement( "node" );
+    _xml.writeAttribute( "id", id );
+    _xml.writeEndElement();
+}
+
+template < class Config >
+auto    OutXmlSerializer< Config >::writeEdge( const typename Graph::SharedEdge& edge, const std::string& id,
+                                               const std::string& source, const std::string& target ) -> void
+{
+    (void)edge;
+    _xml.writeStartElement( "edge" );
+    _xml.writeAttribute( "id", id );
+    _xml.writeAttribute( "source", source );
+    _xml.writeAttribute( "target", target );
+    _xml.writeEndElement();
+}
+
+template < class Config >
+auto    OutXmlSerializer< Config >::formatId( std::string& id, char prefix, std::size_t index ) -> void
+{
+    char digits[24];
+    std::size_t d = sizeof( digits );
+    do {
+        digits[--d] = static_cast< char >( '0' + ( index % 10 ) );
+        index /= 10;
+    } while ( index != 0 );
+    id.assign( 1, prefix );
+    id.append( digits + d, sizeof( digits ) - d );
+}
+//-----------------------------------------------------------------------------
+
+} // ::gtpo
@@ -0,0 +1,308 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoXmlStream.h
+// \author	benoit@destrat.io
+// \date	2017 12 04
+//-----------------------------------------------------------------------------
+
+#ifndef gtpoXmlStream_h
+#define gtpoXmlStream_h
+
+// STD headers
+#include <cstddef>      // std::size_t
+#include <string>
+#include <vector>
+#include <utility>      // std::pair
+#include <istream>
+#include <ostream>
+
+// GTpo headers
+#include "./gtpoUtils.h"
+
+namespace gtpo { // ::gtpo
+
+/*! \brief Minimal streaming (pull) XML reader used by GTpo GraphML and GEXF serializers.
+ *
+ * XmlStreamReader never build a document tree: input is read in fixed size chunks (\c bufferSize) and
+ * only the current token (element name, attributes or character data) is kept in memory. Token
+ * strings are reused from one token to the next, so that once the largest token has been read, parsing
+ * is allocation free. Memory use is bounded by \c bufferSize plus the size of the largest token, a token
+ * larger than getMaxTokenSize() is reported as an error.
+ *
+ * Supported XML subset is the one used in graph exchange formats: elements, attributes, character data,
+ * CDATA sections, predefined and numeric character references. Comments, processing instructions and
+ * DOCTYPE declarations are skipped, namespaces prefixes are not resolved (getName() return the qualified name).
+ *
+ * \code
+ *  std::ifstream input{ "graph.graphml" };
+ *  gtpo::XmlStreamReader xml{ input };
+ *  while ( xml.readNext() != gtpo::XmlStreamReader::Token::EndDocument ) {
+ *    if ( xml.isStartElement( "node" ) )
+ *      std::cout << xml.getAttribute( "id" ) << std::endl;
+ *  }
+ * \endcode
+ *
+ * \throw gtpo::bad_serialization_error on malformed input.
+ * \nosubgrouping
+ */
+class XmlStreamReader
+{
+    /*! \name XmlStreamReader Object Management *///---------------------------
+    //@{
+public:
+    //! Token type returned by readNext().
+    enum class Token : int {
+        Invalid,
+        StartElement,
+        EndElement,
+        Characters,
+        EndDocument
+    };
+
+    explicit XmlStreamReader( std::istream& input, std::size_t bufferSize = 64 * 1024 ) noexcept( false );
+    ~XmlStreamReader() noexcept = default;
+    XmlStreamReader( const XmlStreamReader& ) = delete;
+    XmlStreamReader& operator=( const XmlStreamReader& ) = delete;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Token Management *///--------------------------------------------
+    //@{
+public:
+    /*! \brief Read the next token in input.
+     *
+     * Whitespace only character data is silently skipped. An empty element (<node/>) is reported as
+     * a StartElement immediately followed by an EndElement.
+     * \throw gtpo::bad_serialization_error if input is not well formed.
+     */
+    auto            readNext() noexcept( false ) -> Token;
+
+    //! Current token type (last value returned by readNext()).
+    inline auto     getToken() const noexcept -> Token { return _token; }
+    //! Current element qualified name (valid for StartElement and EndElement tokens).
+    inline auto     getName() const noexcept -> const std::string& { return _name; }
+    //! Return true if current token is a start element with qualified name \c name.
+    inline auto     isStartElement( const char* name ) const noexcept -> bool { return _token == Token::StartElement && _name == name; }
+    //! Return true if current token is an end element with qualified name \c name.
+    inline auto     isEndElement( const char* name ) const noexcept -> bool { return _token == Token::EndElement && _name == name; }
+    //! Current token decoded character data (valid for Characters token).
+    inline auto     getText() const noexcept -> const std::string& { return _text; }
+    //! Current element depth, root element has depth 1.
+    inline auto     getDepth() const noexcept -> std::size_t { return _depth; }
+
+    //! Return a pointer on current start element attribute \c name value, nullptr if there is no such attribute.
+    auto            findAttribute( const char* name ) const noexcept -> const std::string*;
+    //! Return current start element attribute \c name value, or an empty string if there is no such attribute.
+    auto            getAttribute( const char* name ) const noexcept -> const std::string&;
+    //! Return true if current start element has an attribute named \c name.
+    inline auto     hasAttribute( const char* name ) const noexcept -> bool { return findAttribute( name ) != nullptr; }
+    //! Return current start element attributes count.
+    inline auto     getAttributeCount() const noexcept -> std::size_t { return _attributesCount; }
+
+    /*! \brief Skip current start element sub tree, the current token is then the matching EndElement.
+     *
+     * \throw gtpo::bad_serialization_error if input is not well formed.
+     */
+    auto            skipElement() noexcept( false ) -> void;
+
+private:
+    Token           _token{ Token::Invalid };
+    std::string     _name;
+    std::string     _text;
+    //! Element names stack, used to check that end elements match their start element.
+    std::vector< std::string >  _elements;
+    std::size_t     _depth = 0;
+    //! True when an empty element has been read, and its EndElement has not yet been reported.
+    bool            _pendingEndElement = false;
+    //! Attributes (name, value) pairs, never shrinked so that strings capacity is reused.
+    std::vector< std::pair< std::string, std::string > >    _attributes;
+    std::size_t     _attributesCount = 0;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Input Management *///--------------------------------------------
+    //@{
+public:
+    //! Return the number of bytes actually consumed from input.
+    inline auto     getBytesRead() const noexcept -> std::size_t { return _bytesRead - ( _end - _pos ); }
+    //! Return current line number in input (first line is 1).
+    inline auto     getLineNumber() const noexcept -> std::size_t { return _lineNumber; }
+
+    //! Maximum size of a single token (element name, attribute value or character data), default to 16MB.
+    inline auto     getMaxTokenSize() const noexcept -> std::size_t { return _maxTokenSize; }
+    //! \copydoc getMaxTokenSize()
+    inline auto     setMaxTokenSize( std::size_t maxTokenSize ) noexcept -> void { _maxTokenSize = maxTokenSize; }
+
+private:
+    //! Read the next input chunk, return false at end of input.
+    auto            fill() noexcept( false ) -> bool;
+    //! Return next input char or -1 at end of input.
+    inline auto     get() noexcept( false ) -> int {
+        if ( _pos == _end && !fill() )
+            return -1;
+        const auto c = static_cast<unsigned char>( _buffer[_pos++] );
+        if ( c == '\n' )
+            ++_lineNumber;
+        return c;
+    }
+    //! Return next input char without consuming it or -1 at end of input.
+    inline auto     peek() noexcept( false ) -> int {
+        if ( _pos == _end && !fill() )
+            return -1;
+        return static_cast<unsigned char>( _buffer[_pos] );
+    }
+    //! Return next char, throw if end of input is reached.
+    auto            expectChar() noexcept( false ) -> char;
+    //! Skip whitespaces and return the first non whitespace char (consumed).
+    auto            skipWhitespaces() noexcept( false ) -> char;
+    //! Read an element or attribute name starting with \c first in \c name, return the first char following name.
+    auto            readName( char first, std::string& name ) noexcept( false ) -> char;
+    //! Read input until \c delimiter is found, decoding character references in \c text (text is appended).
+    auto            readUntil( char delimiter, std::string& text ) noexcept( false ) -> void;
+    //! Decode a character reference (leading '&' already consumed) and append it to \c text.
+    auto            readReference( std::string& text ) noexcept( false ) -> void;
+    //! Skip input until \c terminator string is found (used for comments, CDATA and processing instructions).
+    auto            skipUntil( const char* terminator, std::string* text = nullptr ) noexcept( false ) -> void;
+    auto            readStartElement( char first ) noexcept( false ) -> void;
+    auto            readEndElement() noexcept( false ) -> void;
+    auto            readMarkupDeclaration() noexcept( false ) -> bool;
+    auto            checkTokenSize( const std::string& token ) const noexcept( false ) -> void;
+    //! Append unicode code point \c code to \c text using UTF-8 encoding.
+    static auto     appendUtf8( unsigned long code, std::string& text ) noexcept( false ) -> bool;
+    [[noreturn]] auto   error( const char* message ) const noexcept( false ) -> void;
+
+private:
+    std::istream&       _input;
+    std::vector<char>   _buffer;
+    std::size_t         _pos = 0;
+    std::size_t         _end = 0;
+    std::size_t         _bytesRead = 0;
+    std::size_t         _lineNumber = 1;
+    std::size_t         _maxTokenSize = 16 * 1024 * 1024;
+    //@}
+    //-------------------------------------------------------------------------
+};
+
+/*! \brief Minimal streaming XML writer used by GTpo GraphML and GEXF serializers.
+ *
+ * Output is accumulated in a fixed size buffer (\c bufferSize) and written to the output
+ * stream when the buffer is full, memory use is bounded by \c bufferSize plus current
+ * element names stack.
+ *
+ * \code
+ *  gtpo::XmlStreamWriter xml{ std::cout };
+ *  xml.writeStartDocument();
+ *  xml.writeStartElement( "graph" );
+ *  xml.writeStartElement( "node" );
+ *  xml.writeAttribute( "id", "n0" );
+ *  xml.writeEndElement();  // Write <node id="n0"/>
+ *  xml.writeEndDocument(); // Close all opened elements and flush output.
+ * \endcode
+ *
+ * \throw gtpo::bad_serialization_error if output can't be written.
+ * \nosubgrouping
+ */
+class XmlStreamWriter
+{
+    /*! \name XmlStreamWriter Object Management *///---------------------------
+    //@{
+public:
+    explicit XmlStreamWriter( std::ostream& output, std::size_t bufferSize = 64 * 1024 ) noexcept( false );
+    //! Flush buffered output, errors are silently ignored, call flush() explicitly to detect them.
+    ~XmlStreamWriter() noexcept;
+    XmlStreamWriter( const XmlStreamWriter& ) = delete;
+    XmlStreamWriter& operator=( const XmlStreamWriter& ) = delete;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Output Management *///-------------------------------------------
+    //@{
+public:
+    //! Write the XML declaration.
+    auto            writeStartDocument() noexcept( false ) -> void;
+    //! Close all opened elements and flush output.
+    auto            writeEndDocument() noexcept( false ) -> void;
+    //! Open element \c name, attributes could then be added with writeAttribute().
+    auto            writeStartElement( const char* name ) noexcept( false ) -> void;
+    //! Close the last opened element (an element with no content is written as an empty element).
+    auto            writeEndElement() noexcept( false ) -> void;
+    //! Add an attribute to the last opened element, must be called before any content is added to that element.
+    auto            writeAttribute( const char* name, const char* value ) noexcept( false ) -> void;
+    //! \copydoc writeAttribute()
+    auto            writeAttribute( const char* name, const std::string& value ) noexcept( false ) -> void;
+    //! \copydoc writeAttribute()
+    auto            writeAttribute( const char* name, const char* value, std::size_t length ) noexcept( false ) -> void;
+    //! Write escaped character data \c text in current element.
+    auto            writeCharacters( const std::string& text ) noexcept( false ) -> void;
+    //! Write a leaf element \c name with character data \c text.
+    auto            writeTextElement( const char* name, const std::string& text ) noexcept( false ) -> void;
+    //! Write buffered data to output stream.
+    auto            flush() noexcept( false ) -> void;
+
+    //! Indent output with one space per element depth, default to true.
+    inline auto     setAutoFormatting( bool autoFormatting ) noexcept -> void { _autoFormatting = autoFormatting; }
+    inline auto     getAutoFormatting() const noexcept -> bool { return _autoFormatting; }
+
+    //! Return the number of bytes actually written (including bytes still buffered).
+    inline auto     getBytesWritten() const noexcept -> std::size_t { return _bytesWritten + _size; }
+
+private:
+    inline auto     write( char c ) noexcept( false ) -> void {
+        if ( _size == _buffer.size() )
+            flush();
+        _buffer[_size++] = c;
+    }
+    auto            write( const char* data, std::size_t length ) noexcept( false ) -> void;
+    auto            writeEscaped( const char* data, std::size_t length, bool attribute ) noexcept( false ) -> void;
+    auto            writeIndent() noexcept( false ) -> void;
+    //! Close a pending start element tag with '>'.
+    auto            closeStartElement() noexcept( false ) -> void;
+
+private:
+    std::ostream&               _output;
+    std::vector<char>           _buffer;
+    std::size_t                 _size = 0;
+    std::size_t                 _bytesWritten = 0;
+    //! Opened elements names stack, never shrinked so that strings capacity is reused.
+    std::vector< std::string >  _elements;
+    std::size_t                 _depth = 0;
+    bool                        _startElementOpened = false;
+    bool                        _elementHasChildren = false;
+    bool                        _autoFormatting = true;
+    //@}
+    //-------------------------------------------------------------------------
+};
+
+} // ::gtpo
+
+#include "./gtpoXmlStream.hpp"
+
+#endif // gtpoXmlStream_h
+
@@ -0,0 +1,546 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoXmlStream.hpp
+// \author	benoit@destrat.io
+// \date	2017 12 04
+//-----------------------------------------------------------------------------
+
+// STD headers
+#include <cstring>      // std::memchr, std::memcpy, std::strlen
+#include <cstdlib>      // std::strtoul
+
+namespace gtpo { // ::gtpo
+
+/* XmlStreamReader Object Management *///-------------------------------------
+inline XmlStreamReader::XmlStreamReader( std::istream& input, std::size_t bufferSize ) :
+    _input( input )
+{
+    _buffer.resize( bufferSize < 64 ? 64 : bufferSize );
+}
+//-----------------------------------------------------------------------------
+
+/* Token Management *///-------------------------------------------------------
+inline auto XmlStreamReader::readNext() -> Token
+{
+    if ( _pendingEndElement ) {     // Report the end of an empty element: name has not been modified since StartElement
+        _pendingEndElement = false;
+        _attributesCount = 0;
+        --_depth;
+        return _token = Token::EndElement;
+    }
+    for ( ;; ) {
+        int c = get();
+        if ( c < 0 ) {
+            if ( _depth > 0 )
+                error( "unexpected end of input" );
+            return _token = Token::EndDocument;
+        }
+        if ( c == '<' ) {
+            c = get();
+            switch ( c ) {
+            case '/':
+                readEndElement();
+                return _token = Token::EndElement;
+            case '?':
+                skipUntil( "?>" );
+                continue;
+            case '!':
+                if ( readMarkupDeclaration() )
+                    return _token = Token::Characters;
+                continue;
+            case -1:
+                error( "unexpected end of input" );
+            default:
+                readStartElement( static_cast<char>( c ) );
+                return _token = Token::StartElement;
+            }
+        }
+        // Character data
+        _text.clear();
+        if ( c == '&' )
+            readReference( _text );
+        else
+            _text.push_back( static_cast<char>( c ) );
+        readUntil( '<', _text );
+        const bool whitespaces = std::all_of( _text.cbegin(), _text.cend(),
+                                              []( char t ) { return t == ' ' || t == '\n' || t == '\r' || t == '\t'; } );
+        if ( whitespaces )
+            continue;
+        if ( _depth == 0 )
+            error( "character data outside of root element" );
+        _attributesCount = 0;
+        return _token = Token::Characters;
+    }
+}
+
+inline auto XmlStreamReader::findAttribute( const char* name ) const noexcept -> const std::string*
+{
+    for ( std::size_t a = 0; a < _attributesCount; ++a )
+        if ( _attributes[a].first == name )
+            return &_attributes[a].second;
+    return nullptr;
+}
+
+inline auto XmlStreamReader::getAttribute( const char* name ) const noexcept -> const std::string&
+{
+    static const std::string empty{};
+    const auto value = findAttribute( name );
+    return value != nullptr ? *value : empty;
+}
+
+inline auto XmlStreamReader::skipElement() -> void
+{
+    if ( _token != Token::StartElement )
+        return;
+    const auto depth = _depth;
+    for ( ;; ) {
+        switch ( readNext() ) {
+        case Token::EndElement:
+            if ( _depth + 1 == depth )
+                return;
+            break;
+        case Token::EndDocument:
+            error( "unexpected end of input" );
+        default: break;
+        }
+    }
+}
+//-----------------------------------------------------------------------------
+
+/* Input Management *///-------------------------------------------------------
+inline auto XmlStreamReader::fill() -> bool
+{
+    _pos = 0;
+    _end = 0;
+    if ( !_input.good() )
+        return false;
+    _input.read( _buffer.data(), static_cast<std::streamsize>( _buffer.size() ) );
+    if ( _input.bad() )
+        error( "input stream read error" );
+    _end = static_cast<std::size_t>( _input.gcount() );
+    _bytesRead += _end;
+    return _end > 0;
+}
+
+inline auto XmlStreamReader::expectChar() -> char
+{
+    const int c = get();
+    if ( c < 0 )
+        error( "unexpected end of input" );
+    return static_cast<char>( c );
+}
+
+inline auto XmlStreamReader::skipWhitespaces() -> char
+{
+    for ( ;; ) {
+        const char c = expectChar();
+        if ( c != ' ' && c != '\n' && c != '\r' && c != '\t' )
+            return c;
+    }
+}
+
+inline auto XmlStreamReader::readName( char first, std::string& name ) -> char
+{
+    const auto isNameEnd = []( char c ) noexcept {
+        return c == ' ' || c == '\n' || c == '\r' || c == '\t' ||
+               c == '=' || c == '>' || c == '/' || c == '?' ||
+               c == '<' || c == '"' || c == '\'';
+    };
+    if ( isNameEnd( first ) )
+        error( "invalid name" );
+    name.assign( 1, first );
+    for ( ;; ) {
+        const char c = expectChar();
+        if ( isNameEnd( c ) )
+            return c;
+        name.push_back( c );
+    }
+}
+
+inline auto XmlStreamReader::readUntil( char delimiter, std::string& text ) -> void
+{
+    for ( ;; ) {
+        if ( _pos == _end && !fill() )
+            return;
+        const char* begin = _buffer.data() + _pos;
+        const std::size_t available = _end - _pos;
+        const char* stop = static_cast<const char*>( std::memchr( begin, delimiter, available ) );
+        const std::size_t length = stop != nullptr ? static_cast<std::size_t>( stop - begin ) : available;
+        const char* reference = static_cast<const char*>( std::memchr( begin, '&', length ) );
+        const std::size_t chunk = reference != nullptr ? static_cast<std::size_t>( reference - begin ) : length;
+        _lineNumber += static_cast<std::size_t>( std::count( begin, begin + chunk, '\n' ) );
+        text.append( begin, chunk );
+        _pos += chunk;
+        if ( reference != nullptr ) {
+            ++_pos;     // Consume '&'
+            readReference( text );
+        } else if ( stop != nullptr ) {
+            checkTokenSize( text );
+            return;
+        }
+        checkTokenSize( text );
+    }
+}
+
+inline auto XmlStreamReader::readReference( std::string& text ) -> void
+{
+    char reference[16];
+    std::size_t length = 0;
+    for ( ;; ) {
+        const char c = expectChar();
+        if ( c == ';' )
+            break;
+        if ( length >= sizeof( reference ) - 1 )
+            error( "invalid character reference" );
+        reference[length++] = c;
+    }
+    reference[length] = '\0';
+    if ( length > 1 && reference[0] == '#' ) {
+        const bool hexa = reference[1] == 'x';
+        const char* digits = reference + ( hexa ? 2 : 1 );
+        char* digitsEnd = nullptr;
+        const auto code = std::strtoul( digits, &digitsEnd, hexa ? 16 : 10 );
+        if ( digitsEnd == digits || *digitsEnd != '\0' ||
+             !appendUtf8( code, text ) )
+            error( "invalid numeric character reference" );
+    }
+    else if ( std::strcmp( reference, "lt" ) == 0 )   text.push_back( '<' );
+    else if ( std::strcmp( reference, "gt" ) == 0 )   text.push_back( '>' );
+    else if ( std::strcmp( reference, "amp" ) == 0 )  text.push_back( '&' );
+    else if ( std::strcmp( reference, "quot" ) == 0 ) text.push_back( '"' );
+    else if ( std::strcmp( reference, "apos" ) == 0 ) text.push_back( '\'' );
+    else error( "unknown entity reference" );
+}
+
+inline auto XmlStreamReader::appendUtf8( unsigned long code, std::string& text ) -> bool
+{
+    if ( code == 0 || code > 0x10FFFF )
+        return false;
+    if ( code < 0x80 )
+        text.push_back( static_cast<char>( code ) );
+    else if ( code < 0x800 ) {
+        text.push_back( static_cast<char>( 0xC0 | ( code >> 6 ) ) );
+        text.push_back( static_cast<char>( 0x80 | ( code & 0x3F ) ) );
+    } else if ( code < 0x10000 ) {
+        text.push_back( static_cast<char>( 0xE0 | ( code >> 12 ) ) );
+        text.push_back( static_cast<char>( 0x80 | ( ( code >> 6 ) & 0x3F ) ) );
+        text.push_back( static_cast<char>( 0x80 | ( code & 0x3F ) ) );
+    } else {
+        text.push_back( static_cast<char>( 0xF0 | ( code >> 18 ) ) );
+        text.push_back( static_cast<char>( 0x80 | ( ( code >> 12 ) & 0x3F ) ) );
+        text.push_back( static_cast<char>( 0x80 | ( ( code >> 6 ) & 0x3F ) ) );
+        text.push_back( static_cast<char>( 0x80 | ( code & 0x3F ) ) );
+    }
+    return true;
+}
+
+inline auto XmlStreamReader::skipUntil( const char* terminator, std::string* text ) -> void
+{
+    // Note: terminator must be a sequence of a repeated char followed by a different
+    // final char ("?>", "-->", "]]>"), allowing a trivial partial match fallback.
+    const std::size_t length = std::strlen( terminator );
+    std::size_t matched = 0;
+    while ( matched < length ) {
+        const char c = expectChar();
+        if ( text != nullptr ) {
+            text->push_back( c );
+            if ( ( text->size() & 0xFFF ) == 0 )
+                checkTokenSize( *text );
+        }
+        if ( c == terminator[matched] )
+            ++matched;
+        else if ( c != terminator[0] )
+            matched = 0;
+        else if ( matched == 0 || terminator[matched - 1] != terminator[0] )
+            matched = 1;
+        // Otherwise, c is a repeated leading char: keep partial match
+    }
+    if ( text != nullptr )
+        text->resize( text->size() - length );
+}
+
+inline auto XmlStreamReader::readStartElement( char first ) -> void
+{
+    char c = readName( first, _name );
+    _attributesCount = 0;
+    for ( ;; ) {
+        if ( c == ' ' || c == '\n' || c == '\r' || c == '\t' )
+            c = skipWhitespaces();
+        if ( c == '>' )
+            break;
+        if ( c == '/' ) {
+            if ( expectChar() != '>' )
+                error( "expecting '>' after '/' in empty element" );
+            _pendingEndElement = true;
+            break;
+        }
+        if ( _attributesCount == _attributes.size() )
+            _attributes.emplace_back();
+        auto& attribute = _attributes[_attributesCount++];
+        c = readName( c, attribute.first );
+        if ( c == ' ' || c == '\n' || c == '\r' || c == '\t' )
+            c = skipWhitespaces();
+        if ( c != '=' )
+            error( "expecting '=' after attribute name" );
+        const char quote = skipWhitespaces();
+        if ( quote != '"' && quote != '\'' )
+            error( "expecting quoted attribute value" );
+        attribute.second.clear();
+        readUntil( quote, attribute.second );
+        if ( expectChar() != quote )
+            error( "unterminated attribute value" );
+        c = expectChar();
+    }
+    if ( _elements.size() <= _depth )
+        _elements.emplace_back();
+    _elements[_depth++] = _name;    // Note: string assignment reuse element name capacity
+}
+
+inline auto XmlStreamReader::readEndElement() -> void
+{
+    char c = readName( expectChar(), _name );
+    if ( c == ' ' || c == '\n' || c == '\r' || c == '\t' )
+        c = skipWhitespaces();
+    if ( c != '>' )
+        error( "expecting '>' in end element" );
+    if ( _depth == 0 ||
+         _elements[_depth - 1] != _name )
+        error( "mismatched end element" );
+    --_depth;
+    _attributesCount = 0;
+}
+
+inline auto XmlStreamReader::readMarkupDeclaration() -> bool
+{
+    const char c = expectChar();
+    if ( c == '-' ) {                       // Comment
+        if ( expectChar() != '-' )
+            error( "invalid comment" );
+        skipUntil( "-->" );
+        return false;
+    }
+    if ( c == '[' ) {                       // CDATA section
+        for ( const char* cdata = "CDATA["; *cdata != '\0'; ++cdata )
+            if ( expectChar() != *cdata )
+                error( "invalid CDATA section" );
+        if ( _depth == 0 )
+            error( "CDATA section outside of root element" );
+        _text.clear();
+        skipUntil( "]]>", &_text );
+        _attributesCount = 0;
+        return true;
+    }
+    int level = 0;                          // DOCTYPE or other declaration, skip with its internal subset
+    for ( char d = c; d != '>' || level > 0; d = expectChar() ) {
+        if ( d == '[' )         ++level;
+        else if ( d == ']' )    --level;
+    }
+    return false;
+}
+
+inline auto XmlStreamReader::checkTokenSize( const std::string& token ) const -> void
+{
+    if ( token.size() > _maxTokenSize )
+        error( "token exceed maximum token size" );
+}
+
+inline auto XmlStreamReader::error( const char* message ) const -> void
+{
+    throw gtpo::bad_serialization_error( std::string{ "gtpo::XmlStreamReader: Error: " } + message +
+                                         " at line " + std::to_string( _lineNumber ) + "." );
+}
+//-----------------------------------------------------------------------------
+
+
+/* XmlStreamWriter Object Management *///-------------------------------------
+inline XmlStreamWriter::XmlStreamWriter( std::ostream& output, std::size_t bufferSize ) :
+    _output( output )
+{
+    _buffer.resize( bufferSize < 64 ? 64 : bufferSize );
+}
+
+inline XmlStreamWriter::~XmlStreamWriter() noexcept
+{
+    try {
+        flush();
+    } catch ( ... ) { }
+}
+//-----------------------------------------------------------------------------
+
+/* Output Management *///------------------------------------------------------
+inline auto XmlStreamWriter::writeStartDocument() -> void
+{
+    static const char declaration[] = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>";
+    write( declaration, sizeof( declaration ) - 1 );
+}
+
+inline auto XmlStreamWriter::writeEndDocument() -> void
+{
+    while ( _depth > 0 )
+        writeEndElement();
+    if ( _autoFormatting )
+        write( '\n' );
+    flush();
+    _output.flush();
+}
+
+inline auto XmlStreamWriter::writeStartElement( const char* name ) -> void
+{
+    closeStartElement();
+    writeIndent();
+    write( '<' );
+    write( name, std::strlen( name ) );
+    if ( _elements.size() <= _depth )
+        _elements.emplace_back();
+    _elements[_depth++] = name;     // Note: string assignment reuse element name capacity
+    _startElementOpened = true;
+    _elementHasChildren = false;
+}
+
+inline auto XmlStreamWriter::writeEndElement() -> void
+{
+    if ( _depth == 0 )
+        throw gtpo::bad_serialization_error( "gtpo::XmlStreamWriter::writeEndElement(): Error: No element to close." );
+    --_depth;
+    if ( _startElementOpened ) {
+        write( "/>", 2 );
+        _startElementOpened = false;
+    } else {
+        if ( _elementHasChildren )
+            writeIndent();
+        write( "</", 2 );
+        write( _elements[_depth].data(), _elements[_depth].size() );
+        write( '>' );
+    }
+    _elementHasChildren = true;     // Parent element now has at least one child
+}
+
+inline auto XmlStreamWriter::writeAttribute( const char* name, const char* value ) -> void
+{
+    writeAttribute( name, value, std::strlen( value ) );
+}
+
+inline auto XmlStreamWriter::writeAttribute( const char* name, const std::string& value ) -> void
+{
+    writeAttribute( name, value.data(), value.size() );
+}
+
+inline auto XmlStreamWriter::writeAttribute( const char* name, const char* value, std::size_t length ) -> void
+{
+    if ( !_startElementOpened )
+        throw gtpo::bad_serialization_error( "gtpo::XmlStreamWriter::writeAttribute(): Error: Attributes must be written just after a start element." );
+    write( ' ' );
+    write( name, std::strlen( name ) );
+    write( "=\"", 2 );
+    writeEscaped( value, length, true );
+    write( '"' );
+}
+
+inline auto XmlStreamWriter::writeCharacters( const std::string& text ) -> void
+{
+    closeStartElement();
+    writeEscaped( text.data(), text.size(), false );
+}
+
+inline auto XmlStreamWriter::writeTextElement( const char* name, const std::string& text ) -> void
+{
+    writeStartElement( name );
+    writeCharacters( text );
+    writeEndElement();
+}
+
+inline auto XmlStreamWriter::flush() -> void
+{
+    if ( _size == 0 )
+        return;
+    _output.write( _buffer.data(), static_cast<std::streamsize>( _size ) );
+    _bytesWritten += _size;
+    _size = 0;
+    if ( !_output )
+        throw gtpo::bad_serialization_error( "gtpo::XmlStreamWriter::flush(): Error: Output stream write error." );
+}
+
+inline auto XmlStreamWriter::write( const char* data, std::size_t length ) -> void
+{
+    if ( length > _buffer.size() - _size )
+        flush();
+    if ( length > _buffer.size() ) {   // Large data is written directly
+        _output.write( data, static_cast<std::streamsize>( length ) );
+        _bytesWritten += length;
+        if ( !_output )
+            throw gtpo::bad_serialization_error( "gtpo::XmlStreamWriter::write(): Error: Output stream write error." );
+        return;
+    }
+    std::memcpy( _buffer.data() + _size, data, length );
+    _size += length;
+}
+
+inline auto XmlStreamWriter::writeEscaped( const char* data, std::size_t length, bool attribute ) -> void
+{
+    std::size_t begin = 0;
+    for ( std::size_t c = 0; c < length; ++c ) {
+        const char* escaped = nullptr;
+        switch ( data[c] ) {
+        case '<': escaped = "&lt;"; break;
+        case '>': escaped = "&gt;"; break;
+        case '&': escaped = "&amp;"; break;
+        case '"': escaped = attribute ? "&quot;" : nullptr; break;
+        case '\n': escaped = attribute ? "&#10;" : nullptr; break;
+        default: break;
+        }
+        if ( escaped != nullptr ) {
+            write( data + begin, c - begin );
+            write( escaped, std::strlen( escaped ) );
+            begin = c + 1;
+        }
+    }
+    write( data + begin, length - begin );
+}
+
+inline auto XmlStreamWriter::writeIndent() -> void
+{
+    if ( !_autoFormatting ||
+         getBytesWritten() == 0 )
+        return;
+    write( '\n' );
+    for ( std::size_t i = 0; i < _depth; ++i )
+        write( ' ' );
+}
+
+inline auto XmlStreamWriter::closeStartElement() -> void
+{
+    if ( _startElementOpened ) {
+        write( '>' );
+        _startElementOpened = false;
+    }
+}
+//-----------------------------------------------------------------------------
+
+} // ::gtpo
@@ -123,6 +123,21 @@ TEST(GTpoBehaviour, graphBehaviour)
     g.removeGroup( gg );
 }
 
+TEST(GTpoBehaviour, graphRemoveBehaviour)
+{
+    gtpo::GenGraph<> g;
+
+    using MockGraphBehaviour = GraphBehaviourMock<>;
+    auto mockBehaviour = new MockGraphBehaviour();
+    g.addGraphBehaviour( std::unique_ptr<MockGraphBehaviour>(mockBehaviour) );
+    EXPECT_EQ( g.getBehaviours().size(), 1u );
+    EXPECT_FALSE( g.removeGraphBehaviour( nullptr ) );
+
+    // A removed behaviour is destroyed
+    EXPECT_TRUE( g.removeGraphBehaviour( mockBehaviour ) );
+    EXPECT_FALSE( g.hasBehaviours() );
+}
+
 //-----------------------------------------------------------------------------
 // GTpo Group Behaviour tests
 //-----------------------------------------------------------------------------
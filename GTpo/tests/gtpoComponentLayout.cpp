@@ -0,0 +1,163 @@
+/*
+    This file is part of Quick Qanava library.
+
+    Copyright (C) 2008-2015 Benoit AUTHEMAN
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoComponentLayout.cpp
+// \author	benoit@destrat.io
+// \date	2017 12 27
+//-----------------------------------------------------------------------------
+
+// STD headers
+#include <array>
+#include <cmath>
+#include <random>
+
+// GTpo headers
+#include <gtpoComponentLayout.h>
+
+// Google Test
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace { // ::anonymous
+
+//! Generate \c componentCount random trees of 1 to 12 nodes.
+auto    generateComponents( gtpo::ComponentLayout& layout, std::size_t componentCount ) -> void
+{
+    std::mt19937 generator{ 42 };
+    std::uniform_int_distribution<std::size_t> componentSize{ 1, 12 };
+    std::uniform_real_distribution<double> size{ 20., 120. };
+    for ( std::size_t c = 0; c < componentCount; ++c ) {
+        const auto first = layout.getNodeCount();
+        const auto nodeCount = componentSize( generator );
+        for ( std::size_t n = 0; n < nodeCount; ++n ) {
+            const auto node = layout.addNode( size( generator ), size( generator ) );
+            if ( n > 0 )
+                layout.addEdge( first + std::uniform_int_distribution<std::size_t>{ 0, n - 1 }( generator ), node );
+        }
+    }
+}
+
+//! Return components bounding boxes as (left, top, right, bottom).
+auto    componentBoxes( const gtpo::ComponentLayout& layout ) -> std::vector<std::array<double, 4>>
+{
+    std::vector<std::array<double, 4>> boxes( layout.componentCount,
+                                              std::array<double, 4>{ { 1e12, 1e12, -1e12, -1e12 } } );
+    for ( std::size_t n = 0; n < layout.getNodeCount(); ++n ) {
+        auto& box = boxes[layout.component[n]];
+        box[0] = std::min( box[0], layout.x[n] - layout.width[n] / 2. );
+        box[1] = std::min( box[1], layout.y[n] - layout.height[n] / 2. );
+        box[2] = std::max( box[2], layout.x[n] + layout.width[n] / 2. );
+        box[3] = std::max( box[3], layout.y[n] + layout.height[n] / 2. );
+    }
+    return boxes;
+}
+
+} // ::anonymous
+
+//-----------------------------------------------------------------------------
+// Component layout tests
+//-----------------------------------------------------------------------------
+
+TEST(GTpoComponentLayout, empty)
+{
+    gtpo::ComponentLayout layout;
+    layout.compute();
+    EXPECT_EQ( layout.componentCount, 0u );
+    EXPECT_THROW( layout.addEdge( 0, 1 ), gtpo::bad_topology_error );
+}
+
+TEST(GTpoComponentLayout, components)
+{
+    gtpo::ComponentLayout layout;
+    for ( int n = 0; n < 6; ++n )
+        layout.addNode( 50., 50. );
+    layout.addEdge( 4, 1 );
+    layout.addEdge( 2, 5 );
+    layout.addEdge( 5, 4 );
+    layout.compute();
+    EXPECT_EQ( layout.componentCount, 3u );
+    EXPECT_EQ( layout.component[0], 0u );
+    EXPECT_EQ( layout.component[1], 1u );
+    EXPECT_EQ( layout.component[2], 1u );
+    EXPECT_EQ( layout.component[3], 2u );
+    EXPECT_EQ( layout.component[5], 1u );
+}
+
+TEST(GTpoComponentLayout, skyline)
+{
+    // Four 10x10 squares in a 20 wide skyline make a 20x20 square, a 20x5 rectangle goes on top
+    const std::vector<double> widths{ 10., 10., 10., 10., 20. };
+    const std::vector<double> heights{ 10., 10., 10., 10., 5. };
+    const std::vector<std::uint32_t> order{ 0, 1, 2, 3, 4 };
+    std::vector<double> left, top;
+    EXPECT_DOUBLE_EQ( gtpo::ComponentLayout::packSkyline( widths, heights, order, 20., left, top ), 25. );
+    EXPECT_DOUBLE_EQ( left[1], 10. );
+    EXPECT_DOUBLE_EQ( top[1], 0. );
+    EXPECT_DOUBLE_EQ( left[2], 0. );
+    EXPECT_DOUBLE_EQ( top[2], 10. );
+    EXPECT_DOUBLE_EQ( top[4], 20. );
+}
+
+TEST(GTpoComponentLayout, packing)
+{
+    gtpo::ComponentLayout layout;
+    generateComponents( layout, 300 );
+    layout.aspectRatio = 16. / 9.;
+    layout.threadCount = 4;
+    layout.compute();
+    EXPECT_EQ( layout.componentCount, 300u );
+    const auto boxes = componentBoxes( layout );
+    double area = 0., right = 0., bottom = 0.;
+    for ( std::size_t a = 0; a < boxes.size(); ++a ) {
+        EXPECT_GE( boxes[a][0], -1e-6 );
+        EXPECT_GE( boxes[a][1], -1e-6 );
+        right = std::max( right, boxes[a][2] );
+        bottom = std::max( bottom, boxes[a][3] );
+        area += ( boxes[a][2] - boxes[a][0] + layout.componentSpacing ) * ( boxes[a][3] - boxes[a][1] + layout.componentSpacing );
+        for ( std::size_t b = a + 1; b < boxes.size(); ++b ) {
+            const bool separated = boxes[a][2] + layout.componentSpacing <= boxes[b][0] + 1e-6 ||
+                                   boxes[b][2] + layout.componentSpacing <= boxes[a][0] + 1e-6 ||
+                                   boxes[a][3] + layout.componentSpacing <= boxes[b][1] + 1e-6 ||
+                                   boxes[b][3] + layout.componentSpacing <= boxes[a][1] + 1e-6;
+            EXPECT_TRUE( separated );
+        }
+    }
+    // Packing is dense and close to target aspect ratio
+    EXPECT_LT( ( right + layout.componentSpacing ) * ( bottom + layout.componentSpacing ), area * 1.5 );
+    EXPECT_NEAR( right / bottom, layout.aspectRatio, 0.5 );
+}
+
+TEST(GTpoComponentLayout, keepComponentsLayout)
+{
+    gtpo::ComponentLayout layout;
+    const auto a = layout.addNode( 50., 50., 1000., 1000. );
+    const auto b = layout.addNode( 50., 50., 1200., 900. );
+    layout.addNode( 50., 50., -500., 0. );
+    layout.addEdge( a, b );
+    layout.layoutComponents = false;
+    layout.compute();
+    EXPECT_DOUBLE_EQ( layout.x[b] - layout.x[a], 200. );   // Relative positions are kept
+    EXPECT_DOUBLE_EQ( layout.y[b] - layout.y[a], -100. );
+    EXPECT_DOUBLE_EQ( layout.x[a], 25. );                  // Largest component is packed first at origin
+    EXPECT_DOUBLE_EQ( layout.y[b], 25. );
+}
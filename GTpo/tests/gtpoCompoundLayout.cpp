@@ -0,0 +1,176 @@
+/*
+    This file is part of Quick Qanava library.
+
+    Copyright (C) 2008-2015 Benoit AUTHEMAN
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoCompoundLayout.cpp
+// \author	benoit@destrat.io
+// \date	2017 12 26
+//-----------------------------------------------------------------------------
+
+// STD headers
+#include <random>
+
+// GTpo headers
+#include <gtpoCompoundLayout.h>
+
+// Google Test
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace { // ::anonymous
+
+//! Generate \c groupCount groups of \c groupSize nodes, one group in every four is nested in the previous group.
+auto    generateGroups( gtpo::CompoundLayout& layout, std::size_t groupCount, std::size_t groupSize ) -> void
+{
+    std::mt19937 generator{ 42 };
+    std::uniform_real_distribution<double> size{ 20., 120. };
+    for ( std::size_t g = 0; g < groupCount; ++g ) {
+        const auto parentGroup = g % 4 == 3 ? layout.getNodeCount() - groupSize - 1 :
+                                 std::size_t{ gtpo::CompoundLayout::NoGroup };
+        const auto group = layout.addNode( 100., 100., parentGroup );
+        for ( std::size_t n = 0; n < groupSize; ++n )
+            layout.addNode( size( generator ), size( generator ), group );
+    }
+    for ( std::size_t n = 0; n < groupCount * 2; ++n )
+        layout.addNode( size( generator ), size( generator ) );
+    std::uniform_int_distribution<std::size_t> node{ 0, layout.getNodeCount() - 1 };
+    for ( std::size_t e = 0; e < layout.getNodeCount() * 2; ++e ) {
+        const auto a = node( generator ), b = node( generator );
+        layout.addEdge( std::min( a, b ), std::max( a, b ) );
+    }
+}
+
+//! Expect that nodes sharing the same group do not overlap and that grouped nodes are inside their group.
+auto    expectContained( const gtpo::CompoundLayout& layout ) -> void
+{
+    const auto nodeCount = layout.getNodeCount();
+    for ( std::size_t n = 0; n < nodeCount; ++n ) {
+        const auto g = layout.group[n];
+        if ( g == gtpo::CompoundLayout::NoGroup )
+            continue;
+        EXPECT_GE( layout.x[n] - layout.layoutWidth[n] / 2. + 1e-6, layout.groupPadding );
+        EXPECT_GE( layout.y[n] - layout.layoutHeight[n] / 2. + 1e-6, layout.groupPadding );
+        EXPECT_LE( layout.x[n] + layout.layoutWidth[n] / 2., layout.layoutWidth[g] - layout.groupPadding + 1e-6 );
+        EXPECT_LE( layout.y[n] + layout.layoutHeight[n] / 2., layout.layoutHeight[g] - layout.groupPadding + 1e-6 );
+    }
+    for ( std::size_t a = 0; a < nodeCount; ++a )
+        for ( std::size_t b = a + 1; b < nodeCount; ++b ) {
+            if ( layout.group[a] != layout.group[b] )
+                continue;
+            const bool separated = std::abs( layout.x[a] - layout.x[b] ) + 1e-6 >= ( layout.layoutWidth[a] + layout.layoutWidth[b] ) / 2. ||
+                                   std::abs( layout.y[a] - layout.y[b] ) + 1e-6 >= ( layout.layoutHeight[a] + layout.layoutHeight[b] ) / 2.;
+            EXPECT_TRUE( separated );
+        }
+}
+
+} // ::anonymous
+
+//-----------------------------------------------------------------------------
+// Compound layout tests
+//-----------------------------------------------------------------------------
+
+TEST(GTpoCompoundLayout, empty)
+{
+    gtpo::CompoundLayout layout;
+    layout.compute();
+    EXPECT_EQ( layout.x.size(), 0u );
+    EXPECT_THROW( layout.addNode( 10., 10., 0 ), gtpo::bad_topology_error );
+    EXPECT_THROW( layout.addEdge( 0, 1 ), gtpo::bad_topology_error );
+    const auto group = layout.addNode( 100., 80. );
+    layout.compute();
+    EXPECT_DOUBLE_EQ( layout.layoutWidth[group], 100. );    // Empty groups keep their size
+    EXPECT_DOUBLE_EQ( layout.layoutHeight[group], 80. );
+}
+
+TEST(GTpoCompoundLayout, groupFit)
+{
+    gtpo::CompoundLayout layout;
+    const auto group = layout.addNode( 300., 300. );
+    const auto a = layout.addNode( 100., 50., group );
+    const auto b = layout.addNode( 100., 50., group );
+    layout.addEdge( a, b );
+    layout.compute();
+    EXPECT_DOUBLE_EQ( layout.x[a], layout.groupPadding + 50. );   // Group local coordinates
+    EXPECT_DOUBLE_EQ( layout.x[b] - layout.x[a], 100. + layout.layerSpacing );
+    EXPECT_DOUBLE_EQ( layout.layoutWidth[group], 200. + layout.layerSpacing + 2. * layout.groupPadding );
+    EXPECT_DOUBLE_EQ( layout.layoutHeight[group], 50. + 2. * layout.groupPadding );
+    EXPECT_DOUBLE_EQ( layout.x[group], layout.layoutWidth[group] / 2. );
+}
+
+TEST(GTpoCompoundLayout, isolatedNodes)
+{
+    gtpo::CompoundLayout layout;
+    const auto group = layout.addNode( 10., 10. );
+    for ( int n = 0; n < 16; ++n )
+        layout.addNode( 50., 50., group );
+    layout.compute();
+    expectContained( layout );
+    // Isolated nodes are arranged in rows, not in a single layer
+    EXPECT_LT( layout.layoutWidth[group], 4. * ( 50. + layout.nodeSpacing ) + 2. * layout.groupPadding );
+    EXPECT_LT( layout.layoutHeight[group], 4. * ( 50. + layout.nodeSpacing ) + 2. * layout.groupPadding );
+}
+
+TEST(GTpoCompoundLayout, crossingEdges)
+{
+    // Edges crossing group borders are laid out between the outermost groups containing their extremities
+    gtpo::CompoundLayout layout;
+    const auto src = layout.addNode( 50., 50. );
+    const auto group = layout.addNode( 10., 10. );
+    const auto nested = layout.addNode( 10., 10., group );
+    const auto dst = layout.addNode( 50., 50., nested );
+    const auto last = layout.addNode( 50., 50. );
+    layout.addEdge( src, dst );
+    layout.addEdge( dst, last );
+    layout.addEdge( group, dst );       // Ignored, group content
+    layout.compute();
+    EXPECT_LT( layout.x[src], layout.x[group] - layout.layoutWidth[group] / 2. );
+    EXPECT_GT( layout.x[last], layout.x[group] + layout.layoutWidth[group] / 2. );
+    EXPECT_DOUBLE_EQ( layout.layoutWidth[nested], 50. + 2. * layout.groupPadding );
+    EXPECT_DOUBLE_EQ( layout.layoutWidth[group], 50. + 4. * layout.groupPadding );
+}
+
+TEST(GTpoCompoundLayout, nestedGroups)
+{
+    gtpo::CompoundLayout layout;
+    generateGroups( layout, 20, 12 );
+    layout.horizontal = false;
+    layout.compute();
+    expectContained( layout );
+}
+
+TEST(GTpoCompoundLayout, concurrentGroups)
+{
+    gtpo::CompoundLayout single, concurrent;
+    generateGroups( single, 40, 20 );
+    generateGroups( concurrent, 40, 20 );
+    single.threadCount = 1;
+    concurrent.threadCount = 4;
+    single.compute();
+    concurrent.compute();
+    for ( std::size_t n = 0; n < single.getNodeCount(); ++n ) {
+        if ( single.group[n] == gtpo::CompoundLayout::NoGroup )
+            continue;       // Top level layered layout crossing minimization depends on thread count
+        EXPECT_DOUBLE_EQ( single.x[n], concurrent.x[n] );
+        EXPECT_DOUBLE_EQ( single.y[n], concurrent.y[n] );
+        EXPECT_DOUBLE_EQ( single.layoutWidth[n], concurrent.layoutWidth[n] );
+    }
+}
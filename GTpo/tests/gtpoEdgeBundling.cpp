@@ -0,0 +1,184 @@
+/*
+    This file is part of Quick Qanava library.
+
+    Copyright (C) 2008-2015 Benoit AUTHEMAN
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoEdgeBundling.cpp
+// \author	benoit@destrat.io
+// \date	2017 12 30
+//-----------------------------------------------------------------------------
+
+// STD headers
+#include <cmath>
+#include <vector>
+
+// GTpo headers
+#include <gtpoEdgeBundling.h>
+
+// Google Test
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace { // ::anonymous
+
+//! Return maximum distance of \c edge bundled points to its straight line.
+auto    deviation( const gtpo::EdgeBundling& bundling, std::uint32_t edge ) -> double
+{
+    const auto& points = bundling.getPoints( edge );
+    const auto& a = points.front();
+    const auto& b = points.back();
+    const double length = std::hypot( b.x - a.x, b.y - a.y );
+    double deviation = 0.;
+    for ( const auto& p : points )
+        deviation = std::max( deviation, std::abs( ( b.x - a.x ) * ( a.y - p.y ) - ( a.x - p.x ) * ( b.y - a.y ) ) / length );
+    return deviation;
+}
+
+//! Return distance between \c edge1 and \c edge2 middle points.
+auto    middleDistance( const gtpo::EdgeBundling& bundling, std::uint32_t edge1, std::uint32_t edge2 ) -> double
+{
+    const auto& points1 = bundling.getPoints( edge1 );
+    const auto& points2 = bundling.getPoints( edge2 );
+    const auto& m1 = points1[ points1.size() / 2 ];
+    const auto& m2 = points2[ points2.size() / 2 ];
+    return std::hypot( m1.x - m2.x, m1.y - m2.y );
+}
+
+} // ::anonymous
+
+//-----------------------------------------------------------------------------
+// Edge bundling tests
+//-----------------------------------------------------------------------------
+
+TEST(GTpoEdgeBundling, topology)
+{
+    gtpo::EdgeBundling bundling;
+    EXPECT_EQ( bundling.getEdgeCount(), 0u );
+    EXPECT_FALSE( bundling.hasDirtyEdges() );
+    const auto e1 = bundling.addEdge( 0., 0., 100., 0. );
+    const auto e2 = bundling.addEdge( 0., 10., 100., 10. );
+    EXPECT_EQ( bundling.getEdgeCount(), 2u );
+    EXPECT_TRUE( bundling.isEdge( e1 ) );
+    EXPECT_TRUE( bundling.hasDirtyEdges() );
+    EXPECT_EQ( bundling.getPoints( e1 ).size(), 2u );    // Straight until bundled
+    bundling.removeEdge( e2 );
+    EXPECT_FALSE( bundling.isEdge( e2 ) );
+    EXPECT_TRUE( bundling.getPoints( e2 ).empty() );
+    EXPECT_THROW( bundling.removeEdge( e2 ), gtpo::bad_topology_error );
+    EXPECT_THROW( bundling.setEdge( 42, 0., 0., 1., 1. ), gtpo::bad_topology_error );
+    EXPECT_EQ( bundling.addEdge( 0., 0., 1., 1. ), e2 );   // Removed edges index are reused
+    bundling.clear();
+    EXPECT_EQ( bundling.getEdgeCount(), 0u );
+    EXPECT_TRUE( bundling.bundle().empty() );
+}
+
+TEST(GTpoEdgeBundling, parallelEdges)
+{
+    gtpo::EdgeBundling bundling;
+    const auto e1 = bundling.addEdge( 0., 0., 400., 0. );
+    const auto e2 = bundling.addEdge( 0., 30., 400., 30. );
+    const auto isolated = bundling.addEdge( 0., 500., 40., 900. );
+    EXPECT_EQ( bundling.bundle().size(), 3u );
+    EXPECT_FALSE( bundling.hasDirtyEdges() );
+    EXPECT_EQ( bundling.getPoints( e1 ).size(), bundling.subdivisions + 2 );
+    // End points are fixed, compatible edges middles attract each other
+    EXPECT_DOUBLE_EQ( bundling.getPoints( e1 ).front().x, 0. );
+    EXPECT_DOUBLE_EQ( bundling.getPoints( e1 ).back().x, 400. );
+    EXPECT_LT( middleDistance( bundling, e1, e2 ), 15. );
+    EXPECT_GT( deviation( bundling, e1 ), 5. );
+    EXPECT_LT( deviation( bundling, isolated ), 1e-6 );
+    EXPECT_TRUE( bundling.bundle().empty() );   // Nothing modified
+}
+
+TEST(GTpoEdgeBundling, oppositeEdges)
+{
+    gtpo::EdgeBundling bundling;
+    const auto e1 = bundling.addEdge( 0., 0., 400., 0. );
+    const auto e2 = bundling.addEdge( 400., 30., 0., 30. );
+    bundling.bundle();
+    EXPECT_LT( middleDistance( bundling, e1, e2 ), 15. );
+}
+
+TEST(GTpoEdgeBundling, polyline)
+{
+    gtpo::EdgeBundling bundling;
+    const auto e1 = bundling.addEdge( 0., 0., 400., 0. );
+    bundling.addEdge( 0., 30., 400., 30. );
+    bundling.bundle();
+    const auto& points = bundling.getPoints( e1 );
+    const auto straight = bundling.getPolyline( e1, 0. );
+    const auto bundled = bundling.getPolyline( e1, 1. );
+    const auto half = bundling.getPolyline( e1, 0.5 );
+    ASSERT_EQ( straight.size(), points.size() );
+    for ( std::size_t p = 0; p < points.size(); ++p ) {
+        EXPECT_DOUBLE_EQ( straight[ p ].y, 0. );
+        EXPECT_DOUBLE_EQ( bundled[ p ].y, points[ p ].y );
+        EXPECT_NEAR( half[ p ].y, points[ p ].y / 2., 1e-9 );
+    }
+    EXPECT_TRUE( bundling.getPolyline( 42, 1. ).empty() );
+}
+
+TEST(GTpoEdgeBundling, incremental)
+{
+    gtpo::EdgeBundling bundling;
+    bundling.threadCount = 2;
+    std::vector<std::uint32_t> edges;
+    for ( int c = 0; c < 20; ++c )          // 20 independent bundles of 3 edges
+        for ( int e = 0; e < 3; ++e ) {
+            const double x = c * 1000.;
+            edges.push_back( bundling.addEdge( x, e * 20., x + 400., e * 20. ) );
+        }
+    EXPECT_EQ( bundling.bundle().size(), edges.size() );
+    const auto before = bundling.getPoints( edges[ 30 ] );
+
+    // Modify an edge of 4th bundle: only 4th bundle is bundled again
+    bundling.setEdge( edges[ 9 ], 3000., 50., 3400., 50. );
+    const auto& changed = bundling.bundle();
+    EXPECT_EQ( changed, ( std::vector<std::uint32_t>{ edges[ 9 ], edges[ 10 ], edges[ 11 ] } ) );
+    EXPECT_EQ( bundling.getPoints( edges[ 30 ] ).size(), before.size() );
+    EXPECT_DOUBLE_EQ( bundling.getPoints( edges[ 30 ] )[ 5 ].y, before[ 5 ].y );
+    EXPECT_GT( deviation( bundling, edges[ 9 ] ), 5. );
+
+    // Unmodified end points do not dirty edge
+    bundling.setEdge( edges[ 9 ], 3000., 50., 3400., 50. );
+    EXPECT_FALSE( bundling.hasDirtyEdges() );
+
+    // Removing an edge rebundle its bundle
+    bundling.removeEdge( edges[ 0 ] );
+    EXPECT_EQ( bundling.bundle(), ( std::vector<std::uint32_t>{ edges[ 1 ], edges[ 2 ] } ) );
+    bundling.removeEdge( edges[ 1 ] );
+    EXPECT_EQ( bundling.bundle(), ( std::vector<std::uint32_t>{ edges[ 2 ] } ) );
+    EXPECT_LT( deviation( bundling, edges[ 2 ] ), 1e-6 );     // Last edge of bundle is straight again
+}
+
+TEST(GTpoEdgeBundling, full)
+{
+    gtpo::EdgeBundling bundling;
+    for ( int e = 0; e < 10; ++e )
+        bundling.addEdge( 0., e * 10., 400., e * 10. );
+    bundling.bundle();
+    bundling.incrementalRatio = 0.;     // Any modification rebundle all edges
+    bundling.setEdge( 0, 0., -5., 400., -5. );
+    EXPECT_EQ( bundling.bundle().size(), 10u );
+    bundling.subdivisions = 0;          // No subdivision: straight edges
+    bundling.setEdge( 0, 0., -10., 400., -10. );
+    bundling.bundle();
+    EXPECT_EQ( bundling.getPoints( 0 ).size(), 2u );
+}
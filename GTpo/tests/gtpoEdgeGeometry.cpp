@@ -0,0 +1,140 @@
+/*
+    This file is part of Quick Qanava library.
+
+    Copyright (C) 2008-2015 Benoit AUTHEMAN
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoEdgeGeometry.cpp
+// \author	benoit@destrat.io
+// \date	2017 12 20
+//-----------------------------------------------------------------------------
+
+// STD headers
+#include <cmath>
+
+// GTpo headers
+#include <gtpoEdgeGeometry.h>
+
+// Google Test
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace { // ::anonymous
+
+//! Add a closed rectangle shape of size (\c width, \c height) at (\c x, \c y).
+auto    addRect( gtpo::EdgeGeometryBatch& batch, double x, double y, double width, double height ) -> std::size_t
+{
+    const auto shape = batch.beginShape( x, y );
+    batch.addShapePoint( 0., 0. );
+    batch.addShapePoint( width, 0. );
+    batch.addShapePoint( width, height );
+    batch.addShapePoint( 0., height );
+    batch.addShapePoint( 0., 0. );
+    return shape;
+}
+
+} // ::anonymous
+
+TEST(GTpoEdgeGeometry, shapes)
+{
+    gtpo::EdgeGeometryBatch batch;
+    EXPECT_EQ( addRect( batch, 10., 20., 100., 50. ), 0u );
+    EXPECT_EQ( addRect( batch, 300., 20., 100., 50. ), 1u );
+    EXPECT_EQ( batch.getShapeCount(), 2u );
+    gtpo::computeEdgeGeometry( batch );
+    EXPECT_DOUBLE_EQ( batch.shapeBox[0].left, 10. );
+    EXPECT_DOUBLE_EQ( batch.shapeBox[0].bottom, 70. );
+    EXPECT_DOUBLE_EQ( batch.shapeBox[1].right, 400. );
+    EXPECT_DOUBLE_EQ( batch.pointX[5 + 2], 400. );
+    EXPECT_THROW( batch.addEdge( 0, 2, 4., false ), gtpo::bad_topology_error );
+}
+
+TEST(GTpoEdgeGeometry, straightEdge)
+{
+    gtpo::EdgeGeometryBatch batch;
+    const auto src = addRect( batch, 0., 0., 100., 50. );
+    const auto dst = addRect( batch, 300., 0., 100., 50. );
+    batch.addEdge( src, dst, 4., false );       // Horizontal edge, arrow length is 12
+    batch.addEdge( dst, src, 4., false );
+    gtpo::computeEdgeGeometry( batch );
+
+    EXPECT_FALSE( batch.hidden[0] );
+    EXPECT_DOUBLE_EQ( batch.p1X[0], 100. );
+    EXPECT_DOUBLE_EQ( batch.p1Y[0], 25. );
+    EXPECT_NEAR( batch.p2X[0], 300. - 12., 1e-9 );
+    EXPECT_DOUBLE_EQ( batch.p2Y[0], 25. );
+    EXPECT_NEAR( batch.dstAngle[0], 0., 1e-6 );
+
+    EXPECT_DOUBLE_EQ( batch.p1X[1], 300. );
+    EXPECT_NEAR( batch.p2X[1], 100. + 12., 1e-9 );
+    EXPECT_NEAR( batch.dstAngle[1], 180., 1e-6 );
+}
+
+TEST(GTpoEdgeGeometry, hiddenEdges)
+{
+    gtpo::EdgeGeometryBatch batch;
+    const auto a = addRect( batch, 0., 0., 100., 50. );
+    const auto b = addRect( batch, 105., 0., 100., 50. );       // Too close for an arrow
+    const auto c = addRect( batch, 10., 10., 20., 20. );        // Inside a
+    batch.addEdge( a, b, 4., false );
+    batch.addEdge( c, a, 4., false );
+    batch.addEdge( a, b, 1., true );
+    gtpo::computeEdgeGeometry( batch );
+    EXPECT_TRUE( batch.hidden[0] );
+    EXPECT_TRUE( batch.hidden[1] );
+    EXPECT_FALSE( batch.hidden[2] );
+}
+
+TEST(GTpoEdgeGeometry, curvedEdge)
+{
+    gtpo::EdgeGeometryBatch batch;
+    const auto src = addRect( batch, 0., 0., 100., 50. );
+    const auto dst = addRect( batch, 300., 200., 100., 50. );
+    batch.addEdge( src, dst, 4., true );
+    gtpo::computeEdgeGeometry( batch );
+    ASSERT_FALSE( batch.hidden[0] );
+
+    // Control points are symmetric around clipped line center and at most 40 away from it
+    const double cx = ( batch.c1X[0] + batch.c2X[0] ) / 2.;
+    const double cy = ( batch.c1Y[0] + batch.c2Y[0] ) / 2.;
+    EXPECT_NEAR( cx, 200., 1e-9 );
+    EXPECT_NEAR( cy, 125., 1e-9 );
+    EXPECT_NEAR( std::hypot( batch.c1X[0] - cx, batch.c1Y[0] - cy ), 40., 1e-9 );
+
+    // Curve source point lay on source shape border, destination is moved back by arrow length toward c2
+    const bool onSrcBorder = std::abs( batch.p1X[0] - 100. ) < 1e-9 || std::abs( batch.p1Y[0] - 50. ) < 1e-9;
+    EXPECT_TRUE( onSrcBorder );
+    EXPECT_LT( batch.p2Y[0], 200. );
+    EXPECT_GT( batch.dstAngle[0], 0. );
+    EXPECT_LT( batch.dstAngle[0], 90. );
+}
+
+TEST(GTpoEdgeGeometry, clearKeepShapes)
+{
+    gtpo::EdgeGeometryBatch batch;
+    addRect( batch, 0., 0., 10., 10. );
+    addRect( batch, 100., 0., 10., 10. );
+    batch.addEdge( 0, 1, 2., false );
+    batch.clear();
+    EXPECT_EQ( batch.getShapeCount(), 0u );
+    EXPECT_EQ( batch.getEdgeCount(), 0u );
+    gtpo::computeEdgeGeometry( batch );
+    EXPECT_TRUE( batch.hidden.empty() );
+}
@@ -0,0 +1,172 @@
+/*
+    This file is part of Quick Qanava library.
+
+    Copyright (C) 2008-2015 Benoit AUTHEMAN
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoForceLayout.cpp
+// \author	benoit@destrat.io
+// \date	2017 12 22
+//-----------------------------------------------------------------------------
+
+// STD headers
+#include <cmath>
+#include <random>
+
+// GTpo headers
+#include <gtpoForceLayout.h>
+
+// Google Test
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace { // ::anonymous
+
+auto    distance( const gtpo::ForceLayout& layout, std::size_t a, std::size_t b ) -> double
+{
+    const double dx = layout.x[b] - layout.x[a];
+    const double dy = layout.y[b] - layout.y[a];
+    return std::sqrt( dx * dx + dy * dy );
+}
+
+//! Generate a random graph with \c nodeCount nodes and \c edgeCount edges in a 1000x1000 square.
+auto    generateRandom( gtpo::ForceLayout& layout, std::size_t nodeCount, std::size_t edgeCount ) -> void
+{
+    std::mt19937 generator{ 42 };
+    std::uniform_real_distribution<double> position{ 0., 1000. };
+    std::uniform_int_distribution<std::size_t> node{ 0, nodeCount - 1 };
+    for ( std::size_t n = 0; n < nodeCount; ++n )
+        layout.addNode( position( generator ), position( generator ) );
+    for ( std::size_t e = 0; e < edgeCount; ++e )
+        layout.addEdge( node( generator ), node( generator ) );
+}
+
+} // ::anonymous
+
+//-----------------------------------------------------------------------------
+// Force layout tests
+//-----------------------------------------------------------------------------
+
+TEST(GTpoForceLayout, empty)
+{
+    gtpo::ForceLayout layout;
+    EXPECT_FALSE( layout.step() );
+    EXPECT_TRUE( layout.isConverged() );
+}
+
+TEST(GTpoForceLayout, addEdgeThrow)
+{
+    gtpo::ForceLayout layout;
+    layout.addNode( 0., 0. );
+    EXPECT_THROW( layout.addEdge( 0, 1 ), gtpo::bad_topology_error );
+    EXPECT_EQ( layout.getEdgeCount(), 0u );
+}
+
+TEST(GTpoForceLayout, idealLength)
+{
+    // Two connected nodes converge to FR equilibrium distance: k²/d == d²/k  <=> d == k
+    gtpo::ForceLayout layout;
+    layout.gravity = 0.;
+    const auto a = layout.addNode( 0., 0. );
+    const auto b = layout.addNode( 10., 5. );
+    layout.addEdge( a, b );
+    while ( layout.step() )
+        ;
+    EXPECT_NEAR( distance( layout, a, b ), layout.idealLength, layout.idealLength * 0.05 );
+}
+
+TEST(GTpoForceLayout, coincidentNodes)
+{
+    gtpo::ForceLayout layout;
+    const auto a = layout.addNode( 50., 50. );
+    const auto b = layout.addNode( 50., 50. );
+    layout.addEdge( a, b );
+    while ( layout.step() )
+        ;
+    EXPECT_FALSE( std::isnan( layout.x[a] ) || std::isnan( layout.x[b] ) );
+    EXPECT_GT( distance( layout, a, b ), layout.idealLength * 0.5 );
+}
+
+TEST(GTpoForceLayout, pinned)
+{
+    gtpo::ForceLayout layout;
+    const auto a = layout.addNode( 0., 0., true );
+    const auto b = layout.addNode( 10., 0. );
+    layout.addEdge( a, b );
+    while ( layout.step() )
+        ;
+    EXPECT_DOUBLE_EQ( layout.x[a], 0. );
+    EXPECT_DOUBLE_EQ( layout.y[a], 0. );
+    EXPECT_GT( distance( layout, a, b ), 10. );
+}
+
+TEST(GTpoForceLayout, barnesHutApproximation)
+{
+    // First step displacement with Barnes-Hut approximation must be close to exact (theta = 0) displacement
+    gtpo::ForceLayout exact, approximated;
+    generateRandom( exact, 2000, 3000 );
+    generateRandom( approximated, 2000, 3000 );
+    exact.theta = 0.;
+    exact.setTemperature( 1e9 );            // Do not bound displacement
+    approximated.setTemperature( 1e9 );
+    const auto x0 = exact.x, y0 = exact.y;
+    exact.step();
+    approximated.step();
+    double error = 0., norm = 0.;
+    for ( std::size_t n = 0; n < x0.size(); ++n ) {
+        const double ex = exact.x[n] - x0[n], ey = exact.y[n] - y0[n];
+        const double ax = approximated.x[n] - x0[n], ay = approximated.y[n] - y0[n];
+        error += std::sqrt( ( ex - ax ) * ( ex - ax ) + ( ey - ay ) * ( ey - ay ) );
+        norm += std::sqrt( ex * ex + ey * ey );
+    }
+    EXPECT_LT( error / norm, 0.05 );
+}
+
+TEST(GTpoForceLayout, multiThreaded)
+{
+    // Repulsive forces are computed independently for every node, result must not depend on thread count
+    gtpo::ForceLayout single, multi;
+    generateRandom( single, 5000, 6000 );
+    generateRandom( multi, 5000, 6000 );
+    single.threadCount = 1;
+    multi.threadCount = 4;
+    for ( int s = 0; s < 10; ++s ) {
+        single.step();
+        multi.step();
+    }
+    EXPECT_EQ( single.x, multi.x );
+    EXPECT_EQ( single.y, multi.y );
+}
+
+TEST(GTpoForceLayout, incremental)
+{
+    // A converged layout run again with a low temperature must stay stable
+    gtpo::ForceLayout layout;
+    generateRandom( layout, 500, 600 );
+    layout.setTemperature( 200. );
+    while ( layout.step() )
+        ;
+    const auto x0 = layout.x, y0 = layout.y;
+    layout.setTemperature( 5. );
+    while ( layout.step() )
+        ;
+    for ( std::size_t n = 0; n < x0.size(); ++n )
+        EXPECT_LT( std::abs( layout.x[n] - x0[n] ) + std::abs( layout.y[n] - y0[n] ), 200. );
+}
@@ -0,0 +1,185 @@
+/*
+    This file is part of Quick Qanava library.
+
+    Copyright (C) 2008-2015 Benoit AUTHEMAN
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoIncrementalLayout.cpp
+// \author	benoit@destrat.io
+// \date	2017 12 28
+//-----------------------------------------------------------------------------
+
+// STD headers
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// GTpo headers
+#include <gtpoIncrementalLayout.h>
+
+// Google Test
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace { // ::anonymous
+
+//! Load an already placed \c side x \c side grid of 50x50 nodes spaced by 150.
+auto    generateGrid( gtpo::IncrementalLayout& layout, std::uint32_t side ) -> void
+{
+    for ( std::uint32_t r = 0; r < side; ++r )
+        for ( std::uint32_t c = 0; c < side; ++c ) {
+            const auto node = layout.addNode( 50., 50., c * 150., r * 150., false );
+            if ( c > 0 )
+                layout.addEdge( node - 1, node, false );
+            if ( r > 0 )
+                layout.addEdge( node - side, node, false );
+        }
+}
+
+} // ::anonymous
+
+//-----------------------------------------------------------------------------
+// Incremental layout tests
+//-----------------------------------------------------------------------------
+
+TEST(GTpoIncrementalLayout, topology)
+{
+    gtpo::IncrementalLayout layout;
+    EXPECT_TRUE( layout.relayout().empty() );
+    EXPECT_THROW( layout.addEdge( 0, 1 ), gtpo::bad_topology_error );
+    EXPECT_THROW( layout.removeNode( 0 ), gtpo::bad_topology_error );
+    EXPECT_THROW( layout.removeEdge( 0 ), gtpo::bad_topology_error );
+
+    const auto a = layout.addNode( 50., 50. );
+    const auto b = layout.addNode( 50., 50. );
+    const auto c = layout.addNode( 50., 50. );
+    layout.addEdge( a, b );
+    const auto bc = layout.addEdge( b, c );
+    layout.addEdge( c, c );
+    EXPECT_EQ( layout.getNodeCount(), 3u );
+    EXPECT_EQ( layout.getEdgeCount(), 3u );
+
+    layout.removeEdge( bc );
+    EXPECT_FALSE( layout.isEdge( bc ) );
+    EXPECT_THROW( layout.removeEdge( bc ), gtpo::bad_topology_error );
+    layout.removeNode( c );                     // Self loop is removed with its node
+    EXPECT_FALSE( layout.isNode( c ) );
+    EXPECT_EQ( layout.getNodeCount(), 2u );
+    EXPECT_EQ( layout.getEdgeCount(), 1u );
+    EXPECT_THROW( layout.addEdge( a, c ), gtpo::bad_topology_error );
+
+    // Removed indexes are reused
+    EXPECT_EQ( layout.addNode( 50., 50. ), c );
+    layout.removeNode( b );
+    EXPECT_EQ( layout.getEdgeCount(), 0u );
+    layout.relayout();
+    EXPECT_FALSE( layout.hasDirtyNodes() );
+    layout.clear();
+    EXPECT_EQ( layout.getNodeCount(), 0u );
+}
+
+TEST(GTpoIncrementalLayout, insertion)
+{
+    gtpo::IncrementalLayout layout;
+    const auto a = layout.addNode( 50., 50., 0., 0., false );
+    const auto b = layout.addNode( 50., 50., 300., 0., false );
+    EXPECT_FALSE( layout.hasDirtyNodes() );
+    const auto c = layout.addNode( 50., 50. );
+    layout.addEdge( a, c );
+    layout.addEdge( b, c );
+    layout.relayout();
+    // New node is placed between its neighbours, existing nodes stay close to their position
+    EXPECT_GT( layout.x[c], 50. );
+    EXPECT_LT( layout.x[c], 250. );
+    EXPECT_LT( std::abs( layout.x[a] ) + std::abs( layout.y[a] ), 75. );
+    EXPECT_LT( std::abs( layout.x[b] - 300. ) + std::abs( layout.y[b] ), 75. );
+    const double distance = std::hypot( layout.x[c] - layout.x[a], layout.y[c] - layout.y[a] );
+    EXPECT_GT( distance, layout.idealEdgeLength * 0.5 );
+    EXPECT_LT( distance, layout.idealEdgeLength * 1.5 );
+}
+
+TEST(GTpoIncrementalLayout, locality)
+{
+    gtpo::IncrementalLayout layout;
+    generateGrid( layout, 40 );
+    const auto x = layout.x;
+    const auto y = layout.y;
+    const std::uint32_t center = 20 * 40 + 20;
+    const auto node = layout.addNode( 50., 50. );
+    layout.addEdge( center, node );
+    const auto& movable = layout.relayout();
+    EXPECT_LE( movable.size(), 14u );           // Node, its neighbour and their 2 hops neighbourhood
+    for ( std::uint32_t n = 0; n < 40 * 40; ++n ) {
+        if ( std::find( movable.begin(), movable.end(), n ) != movable.end() )
+            continue;
+        EXPECT_DOUBLE_EQ( layout.x[n], x[n] );   // Nodes outside neighbourhood are fixed
+        EXPECT_DOUBLE_EQ( layout.y[n], y[n] );
+    }
+    // New node does not overlap a grid node
+    for ( std::uint32_t n = 0; n < 40 * 40; ++n ) {
+        const bool separated = std::abs( layout.x[node] - layout.x[n] ) >= 50. ||
+                               std::abs( layout.y[node] - layout.y[n] ) >= 50.;
+        EXPECT_TRUE( separated );
+    }
+}
+
+TEST(GTpoIncrementalLayout, maxNodes)
+{
+    gtpo::IncrementalLayout layout;
+    generateGrid( layout, 10 );
+    for ( std::uint32_t n = 0; n < 100; ++n )
+        layout.markDirty( n );
+    layout.maxNodes = 30;
+    EXPECT_EQ( layout.relayout().size(), 30u );
+    EXPECT_TRUE( layout.hasDirtyNodes() );      // Remaining dirty nodes are kept for next relayout
+    std::size_t relayouts = 1;
+    while ( layout.hasDirtyNodes() ) {
+        EXPECT_LE( layout.relayout().size(), 30u );
+        ++relayouts;
+    }
+    EXPECT_EQ( relayouts, 4u );
+}
+
+TEST(GTpoIncrementalLayout, removal)
+{
+    gtpo::IncrementalLayout layout;
+    generateGrid( layout, 5 );
+    layout.removeNode( 12 );                    // Grid center
+    EXPECT_TRUE( layout.hasDirtyNodes() );
+    const auto& movable = layout.prepare();
+    EXPECT_EQ( std::count( movable.begin(), movable.end(), 12u ), 0 );
+    EXPECT_EQ( std::count( movable.begin(), movable.end(), 7u ), 1 );
+    EXPECT_EQ( std::count( movable.begin(), movable.end(), 11u ), 1 );
+    const auto region = layout.getRegion();
+    EXPECT_LE( region.left, layout.x[7] - 25. - layout.idealEdgeLength );
+    EXPECT_GE( layout.optimize(), 1u );
+}
+
+TEST(GTpoIncrementalLayout, overlap)
+{
+    gtpo::IncrementalLayout layout;
+    const auto a = layout.addNode( 100., 100., 0., 0., false );
+    const auto b = layout.addNode( 100., 100., 0., 0., false );
+    layout.addEdge( a, b, false );
+    layout.markDirty( a );
+    layout.relayout();
+    const bool separated = std::abs( layout.x[a] - layout.x[b] ) >= 100. ||
+                           std::abs( layout.y[a] - layout.y[b] ) >= 100.;
+    EXPECT_TRUE( separated );
+}
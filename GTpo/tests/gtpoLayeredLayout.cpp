@@ -0,0 +1,194 @@
+/*
+    This file is part of Quick Qanava library.
+
+    Copyright (C) 2008-2015 Benoit AUTHEMAN
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoLayeredLayout.cpp
+// \author	benoit@destrat.io
+// \date	2017 12 23
+//-----------------------------------------------------------------------------
+
+// STD headers
+#include <cmath>
+#include <random>
+
+// GTpo headers
+#include <gtpoLayeredLayout.h>
+
+// Google Test
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace { // ::anonymous
+
+//! Generate a random DAG with \c nodeCount nodes and \c edgeCount edges (edges go from lower to higher indexes).
+auto    generateDag( gtpo::LayeredLayout& layout, std::size_t nodeCount, std::size_t edgeCount ) -> void
+{
+    std::mt19937 generator{ 42 };
+    std::uniform_int_distribution<std::size_t> node{ 0, nodeCount - 1 };
+    for ( std::size_t n = 0; n < nodeCount; ++n )
+        layout.addNode( 100., 50. );
+    for ( std::size_t e = 0; e < edgeCount; ++e ) {
+        const auto a = node( generator ), b = node( generator );
+        if ( a != b )
+            layout.addEdge( std::min( a, b ), std::max( a, b ) );
+    }
+}
+
+//! Expect that nodes in the same layer do not overlap.
+auto    expectNoOverlap( const gtpo::LayeredLayout& layout ) -> void
+{
+    for ( std::size_t a = 0; a < layout.getNodeCount(); ++a )
+        for ( std::size_t b = a + 1; b < layout.getNodeCount(); ++b ) {
+            if ( layout.layer[a] != layout.layer[b] )
+                continue;
+            const auto distance = std::abs( layout.horizontal ? layout.y[a] - layout.y[b] : layout.x[a] - layout.x[b] );
+            const auto breadth = layout.horizontal ? ( layout.height[a] + layout.height[b] ) / 2. :
+                                                     ( layout.width[a] + layout.width[b] ) / 2.;
+            EXPECT_GE( distance + 1e-6, breadth + layout.nodeSpacing );
+        }
+}
+
+} // ::anonymous
+
+//-----------------------------------------------------------------------------
+// Layered layout tests
+//-----------------------------------------------------------------------------
+
+TEST(GTpoLayeredLayout, empty)
+{
+    gtpo::LayeredLayout layout;
+    layout.compute();
+    EXPECT_EQ( layout.x.size(), 0u );
+    EXPECT_EQ( layout.crossings, 0u );
+}
+
+TEST(GTpoLayeredLayout, addEdgeThrow)
+{
+    gtpo::LayeredLayout layout;
+    layout.addNode( 10., 10. );
+    EXPECT_THROW( layout.addEdge( 0, 1 ), gtpo::bad_topology_error );
+}
+
+TEST(GTpoLayeredLayout, chain)
+{
+    // a -> b -> c, left to right
+    gtpo::LayeredLayout layout;
+    const auto a = layout.addNode( 100., 50. );
+    const auto b = layout.addNode( 100., 50. );
+    const auto c = layout.addNode( 100., 50. );
+    layout.addEdge( b, c );
+    layout.addEdge( a, b );
+    layout.compute();
+    EXPECT_EQ( layout.layer[a], 0u );
+    EXPECT_EQ( layout.layer[b], 1u );
+    EXPECT_EQ( layout.layer[c], 2u );
+    EXPECT_DOUBLE_EQ( layout.x[b] - layout.x[a], 100. + layout.layerSpacing );
+    EXPECT_DOUBLE_EQ( layout.y[a], layout.y[b] );       // Straight chain
+    EXPECT_DOUBLE_EQ( layout.y[b], layout.y[c] );
+
+    layout.horizontal = false;
+    layout.compute();
+    EXPECT_DOUBLE_EQ( layout.y[b] - layout.y[a], 50. + layout.layerSpacing );
+    EXPECT_DOUBLE_EQ( layout.x[a], layout.x[c] );
+}
+
+TEST(GTpoLayeredLayout, cycle)
+{
+    // a -> b -> c -> a: exactly one edge is reversed, every edge span at least one layer
+    gtpo::LayeredLayout layout;
+    for ( int n = 0; n < 3; ++n )
+        layout.addNode( 100., 50. );
+    layout.addEdge( 0, 1 );
+    layout.addEdge( 1, 2 );
+    layout.addEdge( 2, 0 );
+    layout.addEdge( 1, 1 );     // Self loop is ignored
+    layout.compute();
+    EXPECT_EQ( layout.edgeReversed[0] + layout.edgeReversed[1] + layout.edgeReversed[2], 1 );
+    EXPECT_EQ( layout.edgeReversed[3], 0 );
+    for ( std::size_t e = 0; e < 3; ++e ) {
+        const auto src = layout.edgeReversed[e] ? layout.edgeDst[e] : layout.edgeSrc[e];
+        const auto dst = layout.edgeReversed[e] ? layout.edgeSrc[e] : layout.edgeDst[e];
+        EXPECT_LT( layout.layer[src], layout.layer[dst] );
+    }
+}
+
+TEST(GTpoLayeredLayout, reversedHint)
+{
+    gtpo::LayeredLayout layout;
+    const auto a = layout.addNode( 100., 50. );
+    const auto b = layout.addNode( 100., 50. );
+    layout.addEdge( a, b, 0., 0., true );
+    layout.compute();
+    EXPECT_EQ( layout.edgeReversed[0], 1 );
+    EXPECT_GT( layout.x[a], layout.x[b] );
+}
+
+TEST(GTpoLayeredLayout, crossingMinimization)
+{
+    // Two layers bipartite graph with a crossing free drawing: a0-b1, a1-b0, a2-b2 in initial order
+    gtpo::LayeredLayout layout;
+    for ( int n = 0; n < 6; ++n )
+        layout.addNode( 100., 50. );
+    layout.addEdge( 0, 4 );
+    layout.addEdge( 1, 3 );
+    layout.addEdge( 2, 5 );
+    layout.addEdge( 0, 3 );
+    layout.threadCount = 1;
+    layout.compute();
+    EXPECT_EQ( layout.crossings, 0u );
+    expectNoOverlap( layout );
+}
+
+TEST(GTpoLayeredLayout, ports)
+{
+    // a has two output ports (top and bottom), b is connected to bottom port, c to top port: c must be above b
+    gtpo::LayeredLayout layout;
+    const auto a = layout.addNode( 100., 80. );
+    const auto b = layout.addNode( 100., 50. );
+    const auto c = layout.addNode( 100., 50. );
+    layout.addEdge( a, b, 30., 0. );
+    layout.addEdge( a, c, -30., 0. );
+    layout.threadCount = 1;
+    layout.compute();
+    EXPECT_LT( layout.y[c], layout.y[b] );
+    EXPECT_EQ( layout.crossings, 0u );
+}
+
+TEST(GTpoLayeredLayout, randomDag)
+{
+    gtpo::LayeredLayout layout;
+    generateDag( layout, 300, 450 );
+    layout.threadCount = 4;
+    layout.compute();
+    for ( std::size_t e = 0; e < layout.getEdgeCount(); ++e ) {
+        EXPECT_EQ( layout.edgeReversed[e], 0 );     // Graph is acyclic
+        EXPECT_LT( layout.layer[layout.edgeSrc[e]], layout.layer[layout.edgeDst[e]] );
+    }
+    expectNoOverlap( layout );
+
+    // Concurrent trials never give more crossings than the single topological trial
+    gtpo::LayeredLayout single;
+    generateDag( single, 300, 450 );
+    single.threadCount = 1;
+    single.compute();
+    EXPECT_LE( layout.crossings, single.crossings );
+}
@@ -0,0 +1,253 @@
+/*
+    This file is part of Quick Qanava library.
+
+    Copyright (C) 2008-2015 Benoit AUTHEMAN
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoOrthogonalRouter.cpp
+// \author	benoit@destrat.io
+// \date	2017 12 29
+//-----------------------------------------------------------------------------
+
+// STD headers
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// GTpo headers
+#include <gtpoOrthogonalRouter.h>
+
+// Google Test
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace { // ::anonymous
+
+using Path = std::vector<gtpo::OrthogonalRouter::Point>;
+
+//! Return true if every \c path segment is horizontal or vertical.
+auto    isOrthogonal( const Path& path ) -> bool
+{
+    for ( std::size_t s = 1; s < path.size(); ++s )
+        if ( path[ s - 1 ].x != path[ s ].x && path[ s - 1 ].y != path[ s ].y )
+            return false;
+    return path.size() >= 2;
+}
+
+//! Return true if point \c p lies on \c box border.
+auto    onBorder( const gtpo::OrthogonalRouter::Point& p, const gtpo::Box& box ) -> bool
+{
+    return box.contains( p.x, p.y ) &&
+           ( p.x == box.left || p.x == box.right || p.y == box.top || p.y == box.bottom );
+}
+
+//! Return true if a \c path segment cross \c box interior.
+auto    crosses( const Path& path, const gtpo::Box& box ) -> bool
+{
+    for ( std::size_t s = 1; s < path.size(); ++s ) {
+        const auto& a = path[ s - 1 ];
+        const auto& b = path[ s ];
+        if ( std::max( a.x, b.x ) > box.left && std::min( a.x, b.x ) < box.right &&
+             std::max( a.y, b.y ) > box.top && std::min( a.y, b.y ) < box.bottom )
+            return true;
+    }
+    return false;
+}
+
+} // ::anonymous
+
+//-----------------------------------------------------------------------------
+// Orthogonal router tests
+//-----------------------------------------------------------------------------
+
+TEST(GTpoOrthogonalRouter, topology)
+{
+    gtpo::OrthogonalRouter router;
+    EXPECT_TRUE( router.route().empty() );
+    EXPECT_THROW( router.addRoute( 0, 1 ), gtpo::bad_topology_error );
+    EXPECT_THROW( router.setObstacle( 0, 0., 0., 10., 10. ), gtpo::bad_topology_error );
+    EXPECT_THROW( router.removeRoute( 0 ), gtpo::bad_topology_error );
+    EXPECT_THROW( router.addObstacle( 0., 0., 10., 10., 3 ), gtpo::bad_topology_error );
+
+    const auto a = router.addObstacle( 0., 0., 50., 50. );
+    const auto b = router.addObstacle( 200., 0., 50., 50. );
+    const auto c = router.addObstacle( 400., 0., 50., 50. );
+    const auto ab = router.addRoute( a, b );
+    const auto bc = router.addRoute( b, c );
+    EXPECT_EQ( router.getObstacleCount(), 3u );
+    EXPECT_EQ( router.getRouteCount(), 2u );
+    EXPECT_TRUE( router.hasDirtyRoutes() );
+    EXPECT_EQ( router.route().size(), 2u );
+    EXPECT_FALSE( router.hasDirtyRoutes() );
+
+    router.removeObstacle( c );             // Attached routes are removed with their obstacle
+    EXPECT_FALSE( router.isObstacle( c ) );
+    EXPECT_FALSE( router.isRoute( bc ) );
+    EXPECT_TRUE( router.isRoute( ab ) );
+    EXPECT_TRUE( router.getRoute( bc ).empty() );
+    EXPECT_EQ( router.getRouteCount(), 1u );
+    EXPECT_THROW( router.markDirty( bc ), gtpo::bad_topology_error );
+
+    // Removed indexes are reused
+    EXPECT_EQ( router.addObstacle( 0., 200., 50., 50. ), c );
+    EXPECT_EQ( router.addRoute( a, c ), bc );
+    router.clear();
+    EXPECT_EQ( router.getObstacleCount(), 0u );
+    EXPECT_EQ( router.getRouteCount(), 0u );
+}
+
+TEST(GTpoOrthogonalRouter, avoidance)
+{
+    gtpo::OrthogonalRouter router;
+    router.threadCount = 2;
+    const auto a = router.addObstacle( 0., 0., 100., 50. );
+    const auto b = router.addObstacle( 400., 0., 100., 50. );
+    const auto wall = router.addObstacle( 200., -50., 100., 150. );
+    const auto route = router.addRoute( a, b );
+    router.route();
+
+    const auto& path = router.getRoute( route );
+    ASSERT_TRUE( isOrthogonal( path ) );
+    EXPECT_GT( path.size(), 2u );           // Bends around wall
+    const auto box = router.getObstacle( wall );
+    EXPECT_FALSE( crosses( path, gtpo::Box{ box.left - router.margin + 1., box.top - router.margin + 1.,
+                                            box.right + router.margin - 1., box.bottom + router.margin - 1. } ) );
+    // Route goes from a border to b border
+    EXPECT_TRUE( onBorder( path.front(), router.getObstacle( a ) ) );
+    EXPECT_TRUE( onBorder( path.back(), router.getObstacle( b ) ) );
+    EXPECT_FALSE( crosses( path, router.getObstacle( a ) ) );
+    EXPECT_FALSE( crosses( path, router.getObstacle( b ) ) );
+}
+
+TEST(GTpoOrthogonalRouter, straight)
+{
+    gtpo::OrthogonalRouter router;
+    const auto a = router.addObstacle( 0., 0., 100., 50. );
+    const auto b = router.addObstacle( 400., 0., 100., 50. );
+    const auto route = router.addRoute( a, b );
+    router.route();
+    const auto& path = router.getRoute( route );
+    ASSERT_EQ( path.size(), 2u );           // Aligned obstacles are connected with a single segment
+    EXPECT_DOUBLE_EQ( path[ 0 ].x, 100. );
+    EXPECT_DOUBLE_EQ( path[ 0 ].y, 25. );
+    EXPECT_DOUBLE_EQ( path[ 1 ].x, 400. );
+    EXPECT_DOUBLE_EQ( path[ 1 ].y, 25. );
+}
+
+TEST(GTpoOrthogonalRouter, incremental)
+{
+    gtpo::OrthogonalRouter router;
+    const auto a = router.addObstacle( 0., 0., 100., 50. );
+    const auto b = router.addObstacle( 400., 0., 100., 50. );
+    const auto c = router.addObstacle( 0., 1000., 100., 50. );
+    const auto d = router.addObstacle( 400., 1000., 100., 50. );
+    const auto far = router.addObstacle( 2000., 2000., 50., 50. );
+    const auto ab = router.addRoute( a, b );
+    const auto cd = router.addRoute( c, d );
+    router.route();
+
+    // Moving an obstacle far from every route does not reroute anything
+    router.setObstacle( far, 2200., 2000., 50., 50. );
+    EXPECT_FALSE( router.route().size() > 0 );
+
+    // Moving an obstacle onto ab corridor only reroutes ab
+    router.setObstacle( far, 200., -50., 100., 150. );
+    const auto changed = router.route();
+    ASSERT_EQ( changed.size(), 1u );
+    EXPECT_EQ( changed[ 0 ], ab );
+    EXPECT_TRUE( isOrthogonal( router.getRoute( ab ) ) );
+    EXPECT_GT( router.getRoute( ab ).size(), 2u );
+    EXPECT_EQ( router.getRoute( cd ).size(), 2u );
+
+    // Moving an end point obstacle reroutes its routes
+    router.setObstacle( d, 400., 1200., 100., 50. );
+    const auto moved = router.route();
+    ASSERT_EQ( moved.size(), 1u );
+    EXPECT_EQ( moved[ 0 ], cd );
+    EXPECT_TRUE( onBorder( router.getRoute( cd ).back(), router.getObstacle( d ) ) );
+}
+
+TEST(GTpoOrthogonalRouter, nudging)
+{
+    gtpo::OrthogonalRouter router;
+    router.nudgeSpacing = 6.;
+    // Two routes sharing the same vertical corridor between two stacked pairs of obstacles
+    const auto a = router.addObstacle( 0., 0., 100., 50. );
+    const auto b = router.addObstacle( 0., 400., 100., 50. );
+    const auto c = router.addObstacle( 0., 0., 100., 50. );
+    const auto d = router.addObstacle( 0., 400., 100., 50. );
+    const auto ab = router.addRoute( a, b );
+    const auto cd = router.addRoute( c, d );
+    router.route();
+
+    const auto& first = router.getRoute( ab );
+    const auto& second = router.getRoute( cd );
+    ASSERT_EQ( first.size(), 2u );
+    ASSERT_EQ( second.size(), 2u );
+    EXPECT_DOUBLE_EQ( std::abs( first[ 0 ].x - second[ 0 ].x ), 6. );
+    EXPECT_DOUBLE_EQ( ( first[ 0 ].x + second[ 0 ].x ) / 2., 50. );   // Centered on original line
+    EXPECT_DOUBLE_EQ( first[ 0 ].x, first[ 1 ].x );
+
+    // Removing a route restore the other one on its line
+    router.removeRoute( cd );
+    const auto changed = router.route();
+    ASSERT_EQ( changed.size(), 1u );
+    EXPECT_EQ( changed[ 0 ], ab );
+    EXPECT_DOUBLE_EQ( router.getRoute( ab )[ 0 ].x, 50. );
+}
+
+TEST(GTpoOrthogonalRouter, containers)
+{
+    gtpo::OrthogonalRouter router;
+    const auto group = router.addObstacle( 0., 0., 300., 300. );
+    const auto a = router.addObstacle( 50., 50., 50., 50., group );
+    const auto b = router.addObstacle( 500., 50., 50., 50. );
+    const auto other = router.addObstacle( 0., 400., 300., 300. );
+    const auto c = router.addObstacle( 50., 450., 50., 50., other );
+    const auto ab = router.addRoute( a, b );
+    const auto bc = router.addRoute( b, c );
+    router.route();
+
+    // ab may leave its group, bc may enter its group
+    EXPECT_TRUE( isOrthogonal( router.getRoute( ab ) ) );
+    EXPECT_EQ( router.getRoute( ab ).size(), 2u );
+    EXPECT_TRUE( isOrthogonal( router.getRoute( bc ) ) );
+    EXPECT_FALSE( crosses( router.getRoute( bc ), router.getObstacle( group ) ) );
+
+    // Content of a removed container is no longer contained
+    router.removeObstacle( group );
+    router.markDirty( ab );
+    router.route();
+    EXPECT_EQ( router.getRoute( ab ).size(), 2u );
+}
+
+TEST(GTpoOrthogonalRouter, selfLoop)
+{
+    gtpo::OrthogonalRouter router;
+    const auto a = router.addObstacle( 0., 0., 100., 50. );
+    const auto loop = router.addRoute( a, a );
+    router.route();
+    const auto& path = router.getRoute( loop );
+    EXPECT_TRUE( isOrthogonal( path ) );
+    EXPECT_EQ( path.size(), 5u );
+    EXPECT_DOUBLE_EQ( path.front().x, 100. );
+    EXPECT_DOUBLE_EQ( path.back().y, 0. );
+    router.removeObstacle( a );
+    EXPECT_EQ( router.getRouteCount(), 0u );
+}
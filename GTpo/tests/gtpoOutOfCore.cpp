@@ -0,0 +1,199 @@
+/*
+    This file is part of Quick Qanava library.
+
+    Copyright (C) 2008-2015 Benoit AUTHEMAN
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software.
+//
+// \file	gtpoOutOfCore.cpp
+// \author	benoit@destrat.io
+// \date	2017 12 10
+//-----------------------------------------------------------------------------
+
+// STD headers
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+// GTpo headers
+#include <gtpoOutOfCoreGraph.h>
+
+// Google Test
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace { // ::anonymous
+
+auto    removeGraphFiles( const std::string& basePath ) -> void
+{
+    for ( const auto suffix : { ".meta", ".x", ".y", ".out.offsets", ".out.targets", ".weights",
+                                ".in.offsets", ".in.sources", ".cells", ".cells.offsets" } )
+        std::remove( ( basePath + suffix ).c_str() );
+}
+
+} // ::anonymous
+
+//-----------------------------------------------------------------------------
+// GTpo paged file tests
+//-----------------------------------------------------------------------------
+
+TEST(GTpoPagedFile, crossPageReadWrite)
+{
+    const std::string fileName{ "gtpoPagedFile.tmp" };
+    {
+        // Small pages and cache to force page eviction and dirty pages write back
+        gtpo::PagedFile file{ fileName, gtpo::PagedFile::Mode::Truncate, 512, 2 };
+        EXPECT_EQ( file.getSize(), 0u );
+        std::vector<char> data( 2000 );
+        for ( std::size_t i = 0; i < data.size(); ++i )
+            data[i] = static_cast<char>( i );
+        file.write( 5, data.data(), data.size() );
+        EXPECT_EQ( file.getSize(), 2005u );
+        EXPECT_EQ( file.getPageCount(), 4u );
+        std::vector<char> read( 2000, 0 );
+        file.read( 5, read.data(), read.size() );
+        EXPECT_EQ( read, data );
+    }
+    {
+        gtpo::PagedFile file{ fileName, gtpo::PagedFile::Mode::ReadOnly, 512, 2 };
+        EXPECT_EQ( file.getSize(), 2005u );
+        char c = 0;
+        file.read( 5 + 1042, &c, 1 );
+        EXPECT_EQ( c, static_cast<char>( 1042 ) );
+        EXPECT_THROW( file.read( 2000, &c, 10 ), gtpo::bad_storage_error );
+        EXPECT_THROW( file.write( 0, &c, 1 ), gtpo::bad_storage_error );
+    }
+    std::remove( fileName.c_str() );
+    EXPECT_THROW( gtpo::PagedFile( fileName, gtpo::PagedFile::Mode::ReadOnly ), gtpo::bad_storage_error );
+}
+
+TEST(GTpoPagedFile, columnIteration)
+{
+    const std::string fileName{ "gtpoPagedColumn.tmp" };
+    {
+        gtpo::PagedFile file{ fileName, gtpo::PagedFile::Mode::Truncate, 512, 2 };
+        gtpo::PagedColumn<std::uint64_t> column{ file };
+        for ( std::uint64_t i = 0; i < 1000; ++i )
+            column.push_back( i * 3 );
+        EXPECT_EQ( column.size(), 1000u );
+        EXPECT_EQ( column.get( 999 ), 2997u );
+        column.set( 10, 42 );
+        std::uint64_t sum = 0, count = 0;
+        for ( auto v : column.range( 8, 12 ) ) {
+            sum += v;
+            ++count;
+        }
+        EXPECT_EQ( count, 4u );
+        EXPECT_EQ( sum, 24u + 27u + 42u + 33u );
+        count = 0;
+        for ( auto v : column ) {
+            if ( count != 10 ) {
+                EXPECT_EQ( v, count * 3 );
+            }
+            ++count;
+        }
+        EXPECT_EQ( count, 1000u );
+        EXPECT_GT( file.getCacheMisses(), 0u );
+    }
+    std::remove( fileName.c_str() );
+}
+
+//-----------------------------------------------------------------------------
+// GTpo out-of-core graph tests
+//-----------------------------------------------------------------------------
+
+TEST(GTpoOutOfCoreGraph, builderTopology)
+{
+    const std::string basePath{ "gtpoOutOfCoreTopology" };
+    {
+        // Small pages to exercise cross page adjacency ranges
+        gtpo::OutOfCoreGraphBuilder builder{ basePath, 4096, 512 };
+        for ( int n = 0; n < 100; ++n )
+            builder.addNode( static_cast<float>( n % 10 ) * 10.f, static_cast<float>( n / 10 ) * 10.f );
+        for ( gtpo::OutOfCoreGraph::NodeId n = 1; n < 100; ++n )
+            builder.addEdge( 0, n, static_cast<float>( n ) );
+        builder.addEdge( 42, 7, 0.5f );
+        EXPECT_THROW( builder.addEdge( 0, 100 ), gtpo::bad_topology_error );
+        EXPECT_EQ( builder.getEdgeCount(), 100u );
+        builder.build( nullptr, 4 );
+        EXPECT_THROW( builder.addNode( 0.f, 0.f ), gtpo::bad_storage_error );
+    }
+    {
+        gtpo::OutOfCoreGraph graph{ basePath, 4096, 512 };
+        EXPECT_EQ( graph.getNodeCount(), 100u );
+        EXPECT_EQ( graph.getEdgeCount(), 100u );
+        EXPECT_EQ( graph.getOutDegree( 0 ), 99u );
+        EXPECT_EQ( graph.getInDegree( 0 ), 0u );
+        EXPECT_EQ( graph.getOutDegree( 42 ), 1u );
+        EXPECT_EQ( graph.getInDegree( 7 ), 2u );
+
+        std::vector<gtpo::OutOfCoreGraph::NodeId> outNodes;
+        for ( auto target : graph.getOutNodes( 0 ) )
+            outNodes.push_back( target );
+        ASSERT_EQ( outNodes.size(), 99u );
+        EXPECT_EQ( outNodes.front(), 1u );     // Insertion order is preserved
+        EXPECT_EQ( outNodes.back(), 99u );
+
+        std::vector<gtpo::OutOfCoreGraph::NodeId> inNodes;
+        for ( auto source : graph.getInNodes( 7 ) )
+            inNodes.push_back( source );
+        EXPECT_EQ( inNodes, ( std::vector<gtpo::OutOfCoreGraph::NodeId>{ 0, 42 } ) );
+
+        const auto edges = graph.getOutEdges( 42 );
+        EXPECT_EQ( graph.getEdgeTarget( edges.first ), 7u );
+        EXPECT_FLOAT_EQ( graph.getEdgeWeight( edges.first ), 0.5f );
+        EXPECT_FLOAT_EQ( graph.getEdgeWeight( graph.getOutEdges( 0 ).first + 9 ), 10.f );
+        EXPECT_THROW( graph.getOutDegree( 100 ), gtpo::bad_topology_error );
+    }
+    removeGraphFiles( basePath );
+}
+
+TEST(GTpoOutOfCoreGraph, spatialQueries)
+{
+    const std::string basePath{ "gtpoOutOfCoreSpatial" };
+    {
+        gtpo::OutOfCoreGraphBuilder builder{ basePath, 4096, 512 };
+        for ( int n = 0; n < 100; ++n )
+            builder.addNode( static_cast<float>( n % 10 ) * 10.f, static_cast<float>( n / 10 ) * 10.f );
+        builder.build( nullptr, 4 );
+    }
+    gtpo::OutOfCoreGraph graph{ basePath, 4096, 512 };
+    EXPECT_FLOAT_EQ( graph.getBounds().width, 90.f );
+    EXPECT_FLOAT_EQ( graph.getBounds().height, 90.f );
+    EXPECT_FLOAT_EQ( graph.getPosition( 42 ).x, 20.f );
+    EXPECT_FLOAT_EQ( graph.getPosition( 42 ).y, 40.f );
+
+    gtpo::OutOfCoreGraph::Rect rect;
+    rect.x = 15.f; rect.y = 15.f; rect.width = 20.f; rect.height = 10.f;   // Nodes (20,20) (30,20)
+    auto nodes = graph.getNodesIn( rect );
+    std::sort( nodes.begin(), nodes.end() );
+    EXPECT_EQ( nodes, ( std::vector<gtpo::OutOfCoreGraph::NodeId>{ 22, 23 } ) );
+
+    rect.x = -100.f; rect.y = -100.f; rect.width = 1000.f; rect.height = 1000.f;
+    EXPECT_EQ( graph.getNodesIn( rect ).size(), 100u );
+    EXPECT_EQ( graph.getNodesIn( rect, 10 ).size(), 10u );
+    std::size_t visited = 0;
+    graph.visitNodesIn( rect, [&visited]( gtpo::OutOfCoreGraph::NodeId, const gtpo::OutOfCoreGraph::Point& ) { ++visited; } );
+    EXPECT_EQ( visited, 100u );
+
+    rect.x = 200.f; rect.y = 200.f; rect.width = 10.f; rect.height = 10.f;
+    EXPECT_TRUE( graph.getNodesIn( rect ).empty() );
+    removeGraphFiles( basePath );
+}
@@ -0,0 +1,88 @@
+/*
+    This file is part of Quick Qanava library.
+
+    Copyright (C) 2008-2015 Benoit AUTHEMAN
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoParallel.cpp
+// \author	benoit@destrat.io
+// \date	2018 01 02
+//-----------------------------------------------------------------------------
+
+// STD headers
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+// GTpo headers
+#include <gtpoUtils.h>
+
+// Google Test
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+//-----------------------------------------------------------------------------
+// gtpo::parallelFor() and gtpo::ThreadPool
+//-----------------------------------------------------------------------------
+
+TEST(GTpoParallel, parallelFor)
+{
+    std::vector<int> visits( 10000, 0 );
+    std::atomic<bool> invalidThread{ false };
+    gtpo::parallelFor( visits.size(), 4, [&visits, &invalidThread]( std::size_t i, unsigned int thread ) {
+        if ( thread >= 4 )
+            invalidThread = true;
+        ++visits[i];
+    } );
+    EXPECT_FALSE( invalidThread );
+    for ( const auto visit : visits )
+        ASSERT_EQ( visit, 1 );
+    gtpo::parallelFor( 0, 4, []( std::size_t, unsigned int ) { FAIL(); } );
+}
+
+TEST(GTpoParallel, threadPoolReuse)
+{
+    gtpo::ThreadPool pool{ 4 };
+    EXPECT_EQ( pool.getThreadCount(), 4u );
+    for ( std::size_t count = 0; count < 500; ++count ) {
+        std::atomic<std::size_t> visits{ 0 };
+        pool.parallelFor( count % 9, [&visits]( std::size_t, unsigned int ) { ++visits; } );
+        ASSERT_EQ( visits, count % 9 );
+    }
+}
+
+TEST(GTpoParallel, exceptionForwarding)
+{
+    // First worker exception is forwarded to caller, threads are joined and the pool is still usable
+    gtpo::ThreadPool pool{ 4 };
+    for ( int run = 0; run < 50; ++run )
+        EXPECT_THROW( pool.parallelFor( 1000, []( std::size_t i, unsigned int ) {
+            if ( i == 500 )
+                throw std::runtime_error{ "Worker error" };
+        } ), std::runtime_error );
+    std::atomic<std::size_t> visits{ 0 };
+    pool.parallelFor( 100, [&visits]( std::size_t, unsigned int ) { ++visits; } );
+    EXPECT_EQ( visits, 100u );
+
+    EXPECT_THROW( gtpo::parallelFor( 1000, 4, []( std::size_t i, unsigned int ) {
+        if ( i == 3 )
+            throw std::runtime_error{ "Worker error" };
+    } ), std::runtime_error );
+}
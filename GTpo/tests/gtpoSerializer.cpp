@@ -0,0 +1,233 @@
+/*
+    This file is part of Quick Qanava library.
+
+    Copyright (C) 2008-2015 Benoit AUTHEMAN
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software.
+//
+// \file	gtpoSerializer.cpp
+// \author	benoit@destrat.io
+// \date	2017 12 04
+//-----------------------------------------------------------------------------
+
+// STD headers
+#include <memory>
+#include <sstream>
+#include <iostream>
+
+// GTpo headers
+#include <GTpo>
+#include <gtpoGmlSerializer.h>
+#include <gtpoGexfSerializer.h>
+
+// Google Test
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+//-----------------------------------------------------------------------------
+// GTpo XML stream reader/writer tests
+//-----------------------------------------------------------------------------
+
+TEST(GTpoXmlStream, readTokens)
+{
+    std::istringstream input{ "<?xml version=\"1.0\"?><!-- comment --><a x='1'><b y=\"2\"/>text</a>" };
+    gtpo::XmlStreamReader xml{ input };
+    using Token = gtpo::XmlStreamReader::Token;
+    EXPECT_EQ( xml.readNext(), Token::StartElement );
+    EXPECT_TRUE( xml.isStartElement( "a" ) );
+    EXPECT_EQ( xml.getAttribute( "x" ), "1" );
+    EXPECT_EQ( xml.readNext(), Token::StartElement );
+    EXPECT_TRUE( xml.isStartElement( "b" ) );
+    EXPECT_EQ( xml.getDepth(), 2u );
+    EXPECT_EQ( xml.getAttribute( "y" ), "2" );
+    EXPECT_FALSE( xml.hasAttribute( "x" ) );
+    EXPECT_EQ( xml.readNext(), Token::EndElement );     // Empty element <b/> is reported as Start/End
+    EXPECT_TRUE( xml.isEndElement( "b" ) );
+    EXPECT_EQ( xml.readNext(), Token::Characters );
+    EXPECT_EQ( xml.getText(), "text" );
+    EXPECT_EQ( xml.readNext(), Token::EndElement );
+    EXPECT_EQ( xml.readNext(), Token::EndDocument );
+}
+
+TEST(GTpoXmlStream, readReferences)
+{
+    std::istringstream input{ "<a v=\"&lt;&amp;&gt;\">&quot;&apos;&#65;&#x42;<![CDATA[<raw>]]></a>" };
+    gtpo::XmlStreamReader xml{ input };
+    using Token = gtpo::XmlStreamReader::Token;
+    EXPECT_EQ( xml.readNext(), Token::StartElement );
+    EXPECT_EQ( xml.getAttribute( "v" ), "<&>" );
+    EXPECT_EQ( xml.readNext(), Token::Characters );
+    EXPECT_EQ( xml.getText(), "\"'AB" );
+    EXPECT_EQ( xml.readNext(), Token::Characters );
+    EXPECT_EQ( xml.getText(), "<raw>" );
+}
+
+TEST(GTpoXmlStream, readSmallBuffer)
+{
+    // Tokens must be correctly read when they cross input chunks boundaries
+    std::string document{ "<graph>" };
+    for ( int n = 0; n < 100; ++n )
+        document += "<node id=\"node" + std::to_string( n ) + "\"/>";
+    document += "</graph>";
+    std::istringstream input{ document };
+    gtpo::XmlStreamReader xml{ input, 64 };
+    int nodeCount = 0;
+    while ( xml.readNext() != gtpo::XmlStreamReader::Token::EndDocument ) {
+        if ( xml.isStartElement( "node" ) ) {
+            EXPECT_EQ( xml.getAttribute( "id" ), "node" + std::to_string( nodeCount ) );
+            ++nodeCount;
+        }
+    }
+    EXPECT_EQ( nodeCount, 100 );
+    EXPECT_EQ( xml.getBytesRead(), document.size() );
+}
+
+TEST(GTpoXmlStream, readMalformed)
+{
+    for ( const auto document : { "<a><b></a>", "<a>", "<a x=1/>", "<a>&unknown;</a>", "text<a/>" } ) {
+        std::istringstream input{ document };
+        gtpo::XmlStreamReader xml{ input };
+        EXPECT_THROW( { while ( xml.readNext() != gtpo::XmlStreamReader::Token::EndDocument ) { } },
+                      gtpo::bad_serialization_error );
+    }
+}
+
+TEST(GTpoXmlStream, readMaxTokenSize)
+{
+    std::istringstream input{ "<a>" + std::string( 1024, 'x' ) + "</a>" };
+    gtpo::XmlStreamReader xml{ input };
+    xml.setMaxTokenSize( 512 );
+    xml.readNext();
+    EXPECT_THROW( xml.readNext(), gtpo::bad_serialization_error );
+}
+
+TEST(GTpoXmlStream, write)
+{
+    std::ostringstream output;
+    gtpo::XmlStreamWriter xml{ output };
+    xml.setAutoFormatting( false );
+    xml.writeStartElement( "a" );
+    xml.writeAttribute( "v", "<\"&>" );
+    xml.writeStartElement( "b" );
+    xml.writeEndElement();
+    xml.writeTextElement( "c", "x<y" );
+    xml.writeEndDocument();
+    EXPECT_EQ( output.str(), "<a v=\"&lt;&quot;&amp;&gt;\"><b/><c>x&lt;y</c></a>" );
+    EXPECT_THROW( xml.writeEndElement(), gtpo::bad_serialization_error );
+}
+
+//-----------------------------------------------------------------------------
+// GTpo GraphML and GEXF serialization tests
+//-----------------------------------------------------------------------------
+
+TEST(GTpoSerializer, gmlInOut)
+{
+    gtpo::GenGraph<> g;
+    auto n1 = g.createNode();
+    auto n2 = g.createNode();
+    auto n3 = g.createNode();
+    g.createEdge( n1, n2 );
+    g.createEdge( n2, n3 );
+
+    std::stringstream stream;
+    gtpo::OutGmlSerializer<> gmlOut{ stream };
+    gmlOut.serializeOut( g );
+    gmlOut.finishOut();
+
+    gtpo::GenGraph<> gi;
+    gtpo::InGmlSerializer<> gmlIn{ stream };
+    gmlIn.serializeIn( gi );
+    EXPECT_EQ( gi.getNodeCount(), 3u );
+    EXPECT_EQ( gi.getEdgeCount(), 2u );
+    EXPECT_EQ( gi.getRootNodeCount(), 1u );
+    EXPECT_EQ( gmlIn.getBytesRead(), gmlOut.getBytesWritten() );
+}
+
+TEST(GTpoSerializer, gexfInOut)
+{
+    gtpo::GenGraph<> g;
+    auto n1 = g.createNode();
+    auto n2 = g.createNode();
+    g.createEdge( n1, n2 );
+    g.createEdge( n2, n1 );
+
+    std::stringstream stream;
+    gtpo::OutGexfSerializer<> gexfOut{ stream };
+    gexfOut.serializeOut( g );
+    EXPECT_THROW( gexfOut.serializeOut( g ), gtpo::bad_serialization_error );   // Only one graph per GEXF document
+    gexfOut.finishOut();
+
+    gtpo::GenGraph<> gi;
+    gtpo::InGexfSerializer<> gexfIn{ stream };
+    gexfIn.serializeIn( gi );
+    EXPECT_EQ( gi.getNodeCount(), 2u );
+    EXPECT_EQ( gi.getEdgeCount(), 2u );
+}
+
+TEST(GTpoSerializer, gmlInForwardReference)
+{
+    // Edges might reference nodes declared later in input
+    std::istringstream input{ "<graphml><graph><edge source=\"a\" target=\"b\"/><node id=\"a\"/><node id=\"b\"/></graph></graphml>" };
+    gtpo::GenGraph<> g;
+    gtpo::InGmlSerializer<> gmlIn{ input };
+    gmlIn.serializeIn( g );
+    EXPECT_EQ( g.getNodeCount(), 2u );
+    EXPECT_EQ( g.getEdgeCount(), 1u );
+}
+
+TEST(GTpoSerializer, gmlInBadInput)
+{
+    {   // Duplicate node id
+        std::istringstream input{ "<graphml><graph><node id=\"a\"/><node id=\"a\"/></graph></graphml>" };
+        gtpo::GenGraph<> g;
+        gtpo::InGmlSerializer<> gmlIn{ input };
+        EXPECT_THROW( gmlIn.serializeIn( g ), gtpo::bad_serialization_error );
+    }
+    {   // Unexpected root element
+        std::istringstream input{ "<gexf><graph/></gexf>" };
+        gtpo::GenGraph<> g;
+        gtpo::InGmlSerializer<> gmlIn{ input };
+        EXPECT_THROW( gmlIn.serializeIn( g ), gtpo::bad_serialization_error );
+    }
+    {   // Edge with no target
+        std::istringstream input{ "<graphml><graph><node id=\"a\"/><edge source=\"a\"/></graph></graphml>" };
+        gtpo::GenGraph<> g;
+        gtpo::InGmlSerializer<> gmlIn{ input };
+        EXPECT_THROW( gmlIn.serializeIn( g ), gtpo::bad_serialization_error );
+    }
+    EXPECT_THROW( gtpo::InGmlSerializer<>{ "/nonexistent/graph.graphml" }, gtpo::bad_serialization_error );
+}
+
+TEST(GTpoSerializer, gmlInProgress)
+{
+    gtpo::GenGraph<> g;
+    for ( int n = 0; n < 10000; ++n )
+        g.createNode();
+    std::stringstream stream;
+    gtpo::OutGmlSerializer<> gmlOut{ stream };
+    gmlOut.serializeOut( g );
+    gmlOut.finishOut();
+
+    gtpo::IProgressNotifier progress;
+    gtpo::GenGraph<> gi;
+    gtpo::InGmlSerializer<> gmlIn{ stream };
+    gmlIn.serializeIn( gi, &progress );
+    EXPECT_DOUBLE_EQ( progress.getProgress(), 1. );
+    EXPECT_EQ( gi.getNodeCount(), 10000u );
+}
+
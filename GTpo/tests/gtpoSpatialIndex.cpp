@@ -0,0 +1,181 @@
+/*
+    This file is part of Quick Qanava library.
+
+    Copyright (C) 2008-2015 Benoit AUTHEMAN
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software.
+//
+// \file	gtpoSpatialIndex.cpp
+// \author	benoit@destrat.io
+// \date	2017 12 16
+//-----------------------------------------------------------------------------
+
+// STD headers
+#include <random>
+#include <vector>
+#include <algorithm>
+
+// GTpo headers
+#include <gtpoSpatialIndex.h>
+
+// Google Test
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace { // ::anonymous
+
+auto    randomBoxes( std::size_t count, unsigned seed ) -> std::vector<gtpo::Box>
+{
+    std::mt19937 generator{ seed };
+    std::uniform_real_distribution<double> position{ 0., 10000. };
+    std::uniform_real_distribution<double> size{ 1., 150. };
+    std::vector<gtpo::Box> boxes;
+    boxes.reserve( count );
+    for ( std::size_t b = 0; b < count; ++b )
+        boxes.push_back( gtpo::Box::fromRect( position( generator ), position( generator ),
+                                              size( generator ), size( generator ) ) );
+    return boxes;
+}
+
+auto    bruteForceRect( const std::vector<gtpo::Box>& boxes, const gtpo::Box& query ) -> std::vector<int>
+{
+    std::vector<int> keys;
+    for ( std::size_t b = 0; b < boxes.size(); ++b )
+        if ( query.intersects( boxes[ b ] ) )
+            keys.push_back( static_cast<int>( b ) );
+    return keys;
+}
+
+auto    sorted( std::vector<int> keys ) -> std::vector<int>
+{
+    std::sort( keys.begin(), keys.end() );
+    return keys;
+}
+
+} // ::anonymous
+
+//-----------------------------------------------------------------------------
+// GTpo spatial index tests
+//-----------------------------------------------------------------------------
+
+TEST(GTpoSpatialIndex, empty)
+{
+    gtpo::SpatialIndex<int> index;
+    EXPECT_TRUE( index.isEmpty() );
+    EXPECT_EQ( index.getHeight(), 1u );
+    EXPECT_TRUE( index.queryPoint( 0., 0. ).empty() );
+    EXPECT_TRUE( index.nearest( 0., 0., 3 ).empty() );
+    EXPECT_FALSE( index.remove( 42 ) );
+    EXPECT_THROW( index.insert( 42, gtpo::Box{ 10., 0., 0., 10. } ), gtpo::bad_topology_error );
+}
+
+TEST(GTpoSpatialIndex, pointAndRectQueries)
+{
+    const auto boxes = randomBoxes( 5000, 42 );
+    gtpo::SpatialIndex<int> index;
+    for ( std::size_t b = 0; b < boxes.size(); ++b )
+        index.insert( static_cast<int>( b ), boxes[ b ] );
+    EXPECT_EQ( index.size(), boxes.size() );
+    EXPECT_GT( index.getHeight(), 2u );
+
+    std::mt19937 generator{ 43 };
+    std::uniform_real_distribution<double> position{ -100., 10100. };
+    for ( int q = 0; q < 200; ++q ) {
+        const double x = position( generator );
+        const double y = position( generator );
+        EXPECT_EQ( sorted( index.queryPoint( x, y ) ), bruteForceRect( boxes, gtpo::Box{ x, y, x, y } ) );
+        const auto query = gtpo::Box::fromRect( x, y, 400., 250. );
+        EXPECT_EQ( sorted( index.queryRect( query ) ), bruteForceRect( boxes, query ) );
+    }
+}
+
+TEST(GTpoSpatialIndex, nearest)
+{
+    const auto boxes = randomBoxes( 3000, 7 );
+    gtpo::SpatialIndex<int> index;
+    for ( std::size_t b = 0; b < boxes.size(); ++b )
+        index.insert( static_cast<int>( b ), boxes[ b ] );
+
+    std::mt19937 generator{ 8 };
+    std::uniform_real_distribution<double> position{ 0., 10000. };
+    for ( int q = 0; q < 50; ++q ) {
+        const double x = position( generator );
+        const double y = position( generator );
+        const auto nearest = index.nearest( x, y, 10 );
+        ASSERT_EQ( nearest.size(), 10u );
+        std::vector<double> distances;
+        for ( const auto& box : boxes )
+            distances.push_back( box.squaredDistance( x, y ) );
+        std::sort( distances.begin(), distances.end() );
+        for ( std::size_t n = 0; n < nearest.size(); ++n )     // Compare distances, ties might be ordered differently
+            EXPECT_DOUBLE_EQ( boxes[ static_cast<std::size_t>( nearest[ n ] ) ].squaredDistance( x, y ), distances[ n ] );
+    }
+    EXPECT_EQ( index.nearest( 0., 0., 5000 ).size(), boxes.size() );
+}
+
+TEST(GTpoSpatialIndex, updateAndRemove)
+{
+    auto boxes = randomBoxes( 4000, 11 );
+    gtpo::SpatialIndex<int> index;
+    for ( std::size_t b = 0; b < boxes.size(); ++b )
+        index.insert( static_cast<int>( b ), boxes[ b ] );
+
+    // Move elements both slightly (fast path) and far away (reinsertion)
+    std::mt19937 generator{ 12 };
+    std::uniform_real_distribution<double> position{ 0., 10000. };
+    for ( std::size_t b = 0; b < boxes.size(); b += 2 ) {
+        auto& box = boxes[ b ];
+        box = ( b % 4 == 0 ) ? gtpo::Box::fromRect( box.left + 1., box.top + 1., box.width(), box.height() ) :
+                               gtpo::Box::fromRect( position( generator ), position( generator ), box.width(), box.height() );
+        index.update( static_cast<int>( b ), box );
+    }
+    EXPECT_EQ( index.size(), boxes.size() );
+    EXPECT_DOUBLE_EQ( index.getBox( 2 ).left, boxes[ 2 ].left );
+
+    // Remove two thirds of elements, removed boxes are emptied in reference vector
+    std::vector<gtpo::Box> reference = boxes;
+    for ( std::size_t b = 0; b < boxes.size(); ++b )
+        if ( b % 3 != 0 ) {
+            EXPECT_TRUE( index.remove( static_cast<int>( b ) ) );
+            reference[ b ] = gtpo::Box{ -1e9, -1e9, -1e9, -1e9 };
+        }
+    EXPECT_FALSE( index.remove( 1 ) );
+    EXPECT_FALSE( index.contains( 1 ) );
+    EXPECT_TRUE( index.contains( 3 ) );
+    EXPECT_EQ( index.size(), ( boxes.size() + 2 ) / 3 );
+    for ( int q = 0; q < 100; ++q ) {
+        const auto query = gtpo::Box::fromRect( position( generator ), position( generator ), 500., 500. );
+        EXPECT_EQ( sorted( index.queryRect( query ) ), bruteForceRect( reference, query ) );
+    }
+
+    for ( std::size_t b = 0; b < boxes.size(); b += 3 )
+        index.remove( static_cast<int>( b ) );
+    EXPECT_TRUE( index.isEmpty() );
+    EXPECT_EQ( index.getHeight(), 1u );
+}
+
+TEST(GTpoSpatialIndex, visitEarlyExit)
+{
+    gtpo::SpatialIndex<int> index;
+    for ( int i = 0; i < 100; ++i )
+        index.insert( i, gtpo::Box::fromRect( 0., 0., 10., 10. ) );
+    int visited = 0;
+    index.visit( gtpo::Box{ 5., 5., 5., 5. }, [&visited]( const int&, const gtpo::Box& ) { return ++visited < 3; } );
+    EXPECT_EQ( visited, 3 );
+}
@@ -0,0 +1,227 @@
+/*
+    This file is part of Quick Qanava library.
+
+    Copyright (C) 2008-2015 Benoit AUTHEMAN
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+//-----------------------------------------------------------------------------
+// This file is a part of the GTpo software library.
+//
+// \file	gtpoTreeLayout.cpp
+// \author	benoit@destrat.io
+// \date	2017 12 24
+//-----------------------------------------------------------------------------
+
+// STD headers
+#include <cmath>
+#include <random>
+
+// GTpo headers
+#include <gtpoTreeLayout.h>
+
+// Google Test
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace { // ::anonymous
+
+//! Generate a random tree with \c nodeCount nodes (parents always have a lower index than their children).
+auto    generateTree( gtpo::TreeLayout& layout, std::size_t nodeCount ) -> void
+{
+    std::mt19937 generator{ 42 };
+    std::uniform_real_distribution<double> size{ 20., 120. };
+    for ( std::size_t n = 0; n < nodeCount; ++n )
+        layout.addNode( size( generator ), size( generator ) );
+    for ( std::size_t n = 1; n < nodeCount; ++n ) {
+        std::uniform_int_distribution<std::size_t> parent{ n > 10 ? n - 10 : 0, n - 1 };
+        layout.addEdge( parent( generator ), n );
+    }
+}
+
+//! Expect that visible nodes at the same depth do not overlap.
+auto    expectNoOverlap( const gtpo::TreeLayout& layout ) -> void
+{
+    for ( std::size_t a = 0; a < layout.getNodeCount(); ++a )
+        for ( std::size_t b = a + 1; b < layout.getNodeCount(); ++b ) {
+            if ( layout.depth[a] != layout.depth[b] || !layout.visible[a] || !layout.visible[b] )
+                continue;
+            const auto distance = std::abs( layout.horizontal ? layout.y[a] - layout.y[b] : layout.x[a] - layout.x[b] );
+            const auto breadth = layout.horizontal ? ( layout.height[a] + layout.height[b] ) / 2. :
+                                                     ( layout.width[a] + layout.width[b] ) / 2.;
+            EXPECT_GE( distance + 1e-6, breadth + layout.siblingSpacing );
+        }
+}
+
+} // ::anonymous
+
+//-----------------------------------------------------------------------------
+// Tree layout tests
+//-----------------------------------------------------------------------------
+
+TEST(GTpoTreeLayout, empty)
+{
+    gtpo::TreeLayout layout;
+    layout.compute();
+    EXPECT_EQ( layout.x.size(), 0u );
+    EXPECT_THROW( layout.addEdge( 0, 1 ), gtpo::bad_topology_error );
+    EXPECT_THROW( layout.update( 0 ), gtpo::bad_topology_error );
+}
+
+TEST(GTpoTreeLayout, simpleTree)
+{
+    gtpo::TreeLayout layout;
+    const auto root = layout.addNode( 100., 50. );
+    const auto a = layout.addNode( 100., 50. );
+    const auto b = layout.addNode( 100., 50. );
+    const auto c = layout.addNode( 100., 50. );
+    layout.addEdge( root, a );
+    layout.addEdge( root, b );
+    layout.addEdge( root, c );
+    layout.addEdge( root, root );       // Self loops are ignored
+    layout.compute();
+    EXPECT_EQ( layout.parent[a], root );
+    EXPECT_EQ( layout.depth[c], 1u );
+    EXPECT_DOUBLE_EQ( layout.x[root], layout.x[b] );    // Parent centered over its children
+    EXPECT_DOUBLE_EQ( layout.x[b] - layout.x[a], 100. + layout.siblingSpacing );
+    EXPECT_DOUBLE_EQ( layout.x[c] - layout.x[b], 100. + layout.siblingSpacing );
+    EXPECT_DOUBLE_EQ( layout.y[a] - layout.y[root], 50. + layout.levelSpacing );
+    EXPECT_DOUBLE_EQ( layout.x[a], 50. );               // Layout bounding box start at origin
+
+    layout.horizontal = true;
+    layout.compute();
+    EXPECT_DOUBLE_EQ( layout.x[a] - layout.x[root], 100. + layout.levelSpacing );
+    EXPECT_DOUBLE_EQ( layout.y[b] - layout.y[a], 50. + layout.siblingSpacing );
+}
+
+TEST(GTpoTreeLayout, deepSubtreesSeparation)
+{
+    // Subtrees are separated on their deepest common level, not only on their roots
+    gtpo::TreeLayout layout;
+    for ( int n = 0; n < 7; ++n )
+        layout.addNode( 10., 10. );
+    layout.addEdge( 0, 1 );  layout.addEdge( 0, 2 );
+    layout.addEdge( 1, 3 );  layout.addEdge( 1, 4 );
+    layout.addEdge( 2, 5 );  layout.addEdge( 2, 6 );
+    layout.siblingSpacing = 10.;
+    layout.compute();
+    EXPECT_DOUBLE_EQ( layout.x[5] - layout.x[4], 20. );
+    EXPECT_DOUBLE_EQ( layout.x[2] - layout.x[1], 40. );
+}
+
+TEST(GTpoTreeLayout, randomTree)
+{
+    gtpo::TreeLayout layout;
+    generateTree( layout, 400 );
+    layout.compute();
+    expectNoOverlap( layout );
+    for ( std::size_t n = 1; n < layout.getNodeCount(); ++n ) {
+        ASSERT_NE( layout.parent[n], gtpo::TreeLayout::NoParent );
+        EXPECT_GT( layout.y[n], layout.y[layout.parent[n]] );
+    }
+}
+
+TEST(GTpoTreeLayout, collapsed)
+{
+    gtpo::TreeLayout layout;
+    generateTree( layout, 200 );
+    layout.collapsed[3] = 1;
+    layout.compute();
+    expectNoOverlap( layout );
+    EXPECT_TRUE( layout.visible[3] );
+    for ( std::size_t n = 4; n < layout.getNodeCount(); ++n ) {
+        bool insideCollapsed = false;
+        for ( auto p = layout.parent[n]; p != gtpo::TreeLayout::NoParent; p = layout.parent[p] )
+            insideCollapsed |= ( p == 3 );
+        EXPECT_EQ( layout.visible[n] == 0, insideCollapsed );
+        if ( insideCollapsed ) {
+            EXPECT_DOUBLE_EQ( layout.x[n], layout.x[3] );
+            EXPECT_DOUBLE_EQ( layout.y[n], layout.y[3] );
+        }
+    }
+}
+
+TEST(GTpoTreeLayout, incrementalUpdate)
+{
+    gtpo::TreeLayout layout, reference;
+    generateTree( layout, 300 );
+    generateTree( reference, 300 );
+    layout.compute();
+    std::mt19937 generator{ 7 };
+    std::uniform_int_distribution<std::size_t> node{ 0, 299 };
+    for ( int toggle = 0; toggle < 50; ++toggle ) {
+        const auto n = node( generator );
+        layout.collapsed[n] = layout.collapsed[n] ? 0 : 1;
+        reference.collapsed[n] = layout.collapsed[n];
+        const auto previousX = layout.x;
+        const auto previousY = layout.y;
+        layout.update( n );
+        reference.compute();
+        std::vector<std::uint8_t> modified( layout.getNodeCount(), 0 );
+        for ( const auto m : layout.modified )
+            modified[m] = 1;
+        for ( std::size_t i = 0; i < layout.getNodeCount(); ++i ) {
+            ASSERT_NEAR( layout.x[i], reference.x[i], 1e-6 );
+            ASSERT_NEAR( layout.y[i], reference.y[i], 1e-6 );
+            ASSERT_EQ( layout.visible[i], reference.visible[i] );
+            if ( !modified[i] ) {   // Unmodified nodes must not have moved
+                ASSERT_EQ( layout.x[i], previousX[i] );
+                ASSERT_EQ( layout.y[i], previousY[i] );
+            }
+        }
+    }
+}
+
+TEST(GTpoTreeLayout, forest)
+{
+    // Nodes without in edges are roots, cycles unreachable from a root get their own root
+    gtpo::TreeLayout layout;
+    for ( int n = 0; n < 6; ++n )
+        layout.addNode( 50., 50. );
+    layout.addEdge( 0, 1 );
+    layout.addEdge( 2, 3 );
+    layout.addEdge( 4, 5 );
+    layout.addEdge( 5, 4 );
+    layout.compute();
+    EXPECT_EQ( layout.parent[0], gtpo::TreeLayout::NoParent );
+    EXPECT_EQ( layout.parent[2], gtpo::TreeLayout::NoParent );
+    EXPECT_EQ( layout.parent[4], gtpo::TreeLayout::NoParent );
+    EXPECT_EQ( layout.parent[5], 4u );
+    expectNoOverlap( layout );
+
+    // Explicit roots
+    layout.roots = { 5 };
+    layout.compute();
+    EXPECT_EQ( layout.parent[4], 5u );
+    EXPECT_EQ( layout.parent[5], gtpo::TreeLayout::NoParent );
+    layout.roots = { 42 };
+    EXPECT_THROW( layout.compute(), gtpo::bad_topology_error );
+}
+
+TEST(GTpoTreeLayout, radial)
+{
+    gtpo::TreeLayout layout;
+    generateTree( layout, 100 );
+    layout.radial = true;
+    layout.compute();
+    EXPECT_DOUBLE_EQ( layout.x[0], 0. );        // Single root at center
+    EXPECT_DOUBLE_EQ( layout.y[0], 0. );
+    for ( std::size_t n = 1; n < layout.getNodeCount(); ++n ) {
+        const auto radius = std::hypot( layout.x[n], layout.y[n] );
+        const auto parentRadius = std::hypot( layout.x[layout.parent[n]], layout.y[layout.parent[n]] );
+        EXPECT_GT( radius, parentRadius );
+    }
+}
@@ -20,7 +20,20 @@ SOURCES	+=  ./gtpoTests.cpp         \
             ./gtpoContainers.cpp    \
             ./gtpoTopology.cpp      \
             ./gtpoGroups.cpp        \
-            ./gtpoBehaviour.cpp
+            ./gtpoBehaviour.cpp     \
+            ./gtpoSerializer.cpp    \
+            ./gtpoOutOfCore.cpp     \
+            ./gtpoSpatialIndex.cpp  \
+            ./gtpoEdgeGeometry.cpp  \
+            ./gtpoForceLayout.cpp   \
+            ./gtpoLayeredLayout.cpp \
+            ./gtpoTreeLayout.cpp    \
+            ./gtpoCompoundLayout.cpp    \
+            ./gtpoComponentLayout.cpp    \
+            ./gtpoIncrementalLayout.cpp    \
+            ./gtpoOrthogonalRouter.cpp     \
+            ./gtpoEdgeBundling.cpp      \
+            ./gtpoParallel.cpp
             #./gtpoConcrete.cpp
 
 HEADERS	+=  
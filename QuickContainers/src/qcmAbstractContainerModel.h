@@ -74,12 +74,48 @@ public:
     //! Return the number of element in this container (shortcut to rowCount( QModelIndex())).
     Q_INVOKABLE int getItemCount( ) const { return rowCount( QModelIndex{} ); }
 protected:
-    //! Shortcut to emit itemCountChanged() signal.
-    inline void     emitItemCountChanged() { emit itemCountChanged(); }
+    //! Shortcut to emit itemCountChanged() signal (rows modification is recorded during a batch).
+    inline void     emitItemCountChanged() {
+        if ( _batchDepth > 0 )
+            _batchModified = true;
+        emit itemCountChanged();
+    }
 signals:
     //! \sa itemCount
     void            itemCountChanged();
 
+public:
+    /*! \brief Suspend model notifications until a matching endBatchNotifications() call (calls might be nested).
+     *
+     * Rows inserted or removed during a batch are notified to views with a single model reset once the outer
+     * batch ends, used for bulk insertions. Model is not reset if no rows have been modified during the batch.
+     */
+    void            beginBatchNotifications() {
+        if ( _batchDepth++ == 0 ) {
+            _batchSignalsBlocked = blockSignals( true );
+            _batchModified = false;
+        }
+    }
+    //! Resume model notifications, views are notified with a model reset when the outer batch ends (only if rows have been modified).
+    void            endBatchNotifications() {
+        if ( _batchDepth <= 0 )
+            return;
+        if ( --_batchDepth == 0 ) {
+            blockSignals( _batchSignalsBlocked );
+            if ( _batchModified ) {
+                _batchModified = false;
+                beginResetModel();
+                endResetModel();
+                emitItemCountChanged();
+            }
+        }
+    }
+private:
+    int             _batchDepth{0};
+    bool            _batchSignalsBlocked{false};
+    //! True when rows or items data have been modified since the outer batch began.
+    bool            _batchModified{false};
+
 public:
     Q_PROPERTY( ContainerModelListReference*    listReference READ getListReference CONSTANT FINAL )
     //! Return a list reference to modify the underlining model from QML (listReference is created on demande, expect a quite slow first call).
@@ -128,7 +164,9 @@ protected slots:
             int qItemIndex = getListReference()->itemIndex( qItem );
             if ( qItemIndex >= 0 ) {
                 QModelIndex itemIndex{ index( qItemIndex ) };
-                if ( itemIndex.isValid( ) )
+                if ( _batchDepth > 0 )      // Notified with batch model reset
+                    _batchModified = true;
+                else if ( itemIndex.isValid( ) )
                     emit dataChanged( itemIndex, itemIndex );
             } else
                 disconnect( qItem, 0, this, 0 );    // Do not disconnect if getListReference() or qItem is nullptr !
@@ -43,6 +43,9 @@ ApplicationWindow {
             objectName: "graph"
             anchors.fill: parent
             clip: true
+            virtualized: true       // Create node delegates only for visible nodes
+            lightweightNodes: true  // Draw nodes with a batched renderer, promote hovered or zoomed nodes to their delegate
+            lod.enabled: true       // Hide labels, arrows and shadows at low zoom levels
             enableConnectorDropNode: true
             Component.onCompleted: {
             }
@@ -77,12 +77,9 @@ int	main( int argc, char** argv )
                 qreal nodeX = static_cast<qreal>(x) * ( defaultWidth + xSpacing ) + xSpacing;
                 for ( int y = 0; y < image.height(); y++ ) {
                     qreal nodeY = static_cast<qreal>(y) * ( defaultHeight + ySpacing ) + ySpacing;
-                    auto node = graph->insertNode();    // FIXME
-                    node->setX(nodeX);
-                    node->setY(nodeY);
-                    node->setMinimumSize( {defaultWidth / 2., defaultHeight / 2.} );
-                    node->setWidth(defaultWidth);
-                    node->setHeight(defaultHeight);
+                    auto node = graph->insertNode();    // Graph is virtualized: node item is not created here
+                    if ( node != nullptr )
+                        node->setGeometry( QRectF{ nodeX, nodeY, defaultWidth, defaultHeight } );
                     //node->setLabel( QString::number(n++) );
                 }
             }
@@ -82,12 +82,13 @@ Item {
         visible: !labelEditor.visible
         Label {
             id: nodeLabel
+            visible: nodeItem && nodeItem.graph ? nodeItem.graph.lod.showLabels : true
             Layout.fillWidth: true;
             Layout.alignment: Qt.AlignHCenter | Qt.AlignVCenter
             Layout.margins: 5
             width: parent.width
             verticalAlignment: Text.AlignVCenter; horizontalAlignment: Text.AlignHCenter
-            text: nodeItem.node.label
+            text: nodeItem && nodeItem.node ? nodeItem.node.label : ""
             wrapMode: Text.Wrap;    elide: Text.ElideRight; maximumLineCount: 4
         }
         Item {
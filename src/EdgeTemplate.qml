@@ -50,7 +50,8 @@ Item {
         rotation: edgeItem.dstAngle
         x: edgeItem.p2.x
         y: edgeItem.p2.y
-        visible: edgeItem.visible && !edgeItem.hidden
+        visible: edgeItem.visible && !edgeItem.hidden &&
+                 ( !edgeItem.graph || edgeItem.graph.lod.showArrows )   // Arrows are hidden at low zoom level
         ShapePath {
             id: cap
             strokeColor: edgeTemplate.color
@@ -103,26 +104,60 @@ Item {
         }
     }
 
+    Component {
+        id: orthoShapePath
+        ShapePath {
+            id: edgeShapePath
+            capStyle: ShapePath.FlatCap
+            joinStyle: ShapePath.MiterJoin
+            strokeWidth: edgeItem.style ? edgeItem.style.lineWidth : 2
+            strokeColor: edgeTemplate.color
+            strokeStyle: edgeItem.style && style.dashed ? ShapePath.DashLine : ShapePath.SolidLine
+            dashPattern: edgeItem.style ? style.dashPattern : [4, 2]
+            fillColor: Qt.rgba(0,0,0,0)
+            // Edge is drawn straight until it has been routed, see qan::OrthogonalRouter and qan::EdgeBundler
+            PathSvg {
+                path: edgeItem.routePath !== "" ? edgeItem.routePath :
+                                                  "M" + edgeItem.p1.x + " " + edgeItem.p1.y + " L" + edgeItem.p2.x + " " + edgeItem.p2.y
+            }
+        }
+    }
     Shape {
         id: edgeShape
         anchors.fill: parent
         visible: edgeItem.visible && !edgeItem.hidden
         //asynchronous: true    // FIXME: Benchmark that
         smooth: true
-        property var lineType : edgeItem.style.lineType
+        // Curved edges are drawn straight at low zoom level, bundled straight edges are drawn as polylines, see qan::EdgeItem::getLineType()
+        property var lineType : edgeItem.graph && !edgeItem.graph.lod.showCurves &&
+                                edgeItem.style.lineType === Qan.EdgeStyle.Curved ? Qan.EdgeStyle.Straight :
+                                edgeItem.style.lineType === Qan.EdgeStyle.Straight &&
+                                edgeItem.routePath !== "" ? Qan.EdgeStyle.Ortho : edgeItem.style.lineType
         property var curvedLine : undefined
         property var straightLine : undefined
+        property var orthoLine : undefined
         onLineTypeChanged: {
             if ( lineType === Qan.EdgeStyle.Straight ) {
                 if ( curvedLine )
                     curvedLine.destroy()
+                if ( orthoLine )
+                    orthoLine.destroy()
                 straightLine = straightShapePath.createObject(edgeShape)
                 edgeShape.data = straightLine
             } else if ( lineType === Qan.EdgeStyle.Curved ) {
                 if ( straightLine )
                     straightLine.destroy()
+                if ( orthoLine )
+                    orthoLine.destroy()
                 curvedLine = curvedShapePath.createObject(edgeShape)
                 edgeShape.data = curvedLine
+            } else if ( lineType === Qan.EdgeStyle.Ortho ) {
+                if ( straightLine )
+                    straightLine.destroy()
+                if ( curvedLine )
+                    curvedLine.destroy()
+                orthoLine = orthoShapePath.createObject(edgeShape)
+                edgeShape.data = orthoLine
             }
         }
     }
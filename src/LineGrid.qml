@@ -33,32 +33,10 @@
 //-----------------------------------------------------------------------------
 
 import QtQuick          2.7
-import QtQuick.Shapes   1.0
 
 import QuickQanava      2.0 as Qan
 
 Qan.AbstractLineGrid {
     opacity: 0.9
-    gridShape : lineGridShape
-    Shape {
-        id: lineGridShape
-        anchors.fill: parent
-        smooth: false
-    }
     gridScale: 25
-    geometryComponent: Component {
-        ShapePath {
-            property alias endX: line.x
-            property alias endY: line.y
-            property bool visible: false
-            startX: 0; startY: 0
-            capStyle: ShapePath.FlatCap
-            strokeWidth: 1
-            strokeColor: visible ? lineGrid.thickColor : Qt.rgba(0,0,0,0)
-            strokeStyle: ShapePath.SolidLine
-            fillColor: Qt.rgba(0,0,0,0)
-            PathLine { id: line; x: 0; y: 0 }
-        }
-    }
-    onAddLine: lineGridShape.data.push(line);
 }
@@ -35,8 +35,10 @@ Qan.AbstractNavigablePreview {
     //! Color for the visible window rect border (default to red).
     property var    visibleWindowColor: Qt.rgba(1, 0, 0, 1)
 
-    //! Show or hide the target navigable content as a background image (default to true).
-    property alias  backgroundPreviewVisible: sourcePreview.visible
+    //! Show or hide the target navigable content as a background image (default to true, used only in SourceTexture preview mode).
+    property bool   backgroundPreviewVisible: true
+
+    onPreviewRectChanged: updatevisibleWindow()
 
     Item {
         id: voidItem
@@ -81,7 +83,9 @@ Qan.AbstractNavigablePreview {
     ShaderEffectSource {
         id: sourcePreview
         anchors.fill: parent
-        live: true; recursive: false
+        visible: backgroundPreviewVisible &&
+                 preview.previewMode === Qan.AbstractNavigablePreview.SourceTexture
+        live: visible; recursive: false
         sourceItem: source.containerItem
         textureSize: Qt.size(width, height)
     }
@@ -91,7 +95,9 @@ Qan.AbstractNavigablePreview {
         var containerItem = source.containerItem
         if ( !containerItem )
             return;
-        var containerItemCr = containerItem.childrenRect
+        // In PointCloud and DensityMap modes, preview is generated from previewRect, not from container item children rect
+        var containerItemCr = preview.previewMode === Qan.AbstractNavigablePreview.SourceTexture ? containerItem.childrenRect :
+                                                                                                   preview.previewRect
         if ( containerItemCr.width < 0.01 ||        // Do not update without a valid children rect
              containerItemCr.height < 0.01 )
             return;
@@ -100,8 +106,8 @@ Qan.AbstractNavigablePreview {
         var previewXRatio = preview.width / containerItemCr.width
         var previewYRatio = preview.height / containerItemCr.height
         var borderHalf = visibleWindow.border.width / 2.
-        visibleWindow.x = ( windowTopLeft.x * previewXRatio ) + borderHalf
-        visibleWindow.y = ( windowTopLeft.y * previewYRatio ) + borderHalf
+        visibleWindow.x = ( ( windowTopLeft.x - containerItemCr.x ) * previewXRatio ) + borderHalf
+        visibleWindow.y = ( ( windowTopLeft.y - containerItemCr.y ) * previewYRatio ) + borderHalf
         visibleWindow.width = ( ( windowBottomRight.x - windowTopLeft.x ) * previewXRatio ) - visibleWindow.border.width
         visibleWindow.height = ( ( windowBottomRight.y - windowTopLeft.y )  * previewYRatio ) - visibleWindow.border.width
         visibleWindowChanged(Qt.rect(visibleWindow.x / preview.width,     visibleWindow.y / preview.height,
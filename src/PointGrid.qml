@@ -33,20 +33,10 @@
 //-----------------------------------------------------------------------------
 
 import QtQuick          2.7
-import QtQuick.Shapes   1.0
 
 import QuickQanava      2.0 as Qan
 
 Qan.AbstractPointGrid {
     gridScale: 100
     opacity: 0.9
-    geometryComponent: Component {
-        Rectangle {
-            smooth: true
-            width: pointGrid.gridWidth
-            height: width
-            radius: width/2.
-            color: pointGrid.thickColor
-        }
-    }
 }
@@ -119,6 +119,7 @@ Qan.PortItem {
 
     Pane {
         id: labelPane
+        visible: portItem.graph ? portItem.graph.lod.showPorts : true     // Port labels are hidden at low zoom level
         opacity: 0.80
         padding: 0
         z: 2
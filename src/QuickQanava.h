@@ -62,6 +62,21 @@
 #include "./qanStyleManager.h"
 #include "./qanBottomRightResizer.h"
 #include "./qanNavigablePreview.h"
+#include "./qanEdgeListLoader.h"
+#include "./qanForceDirectedLayout.h"
+#include "./qanLayeredLayout.h"
+#include "./qanTreeLayout.h"
+#include "./qanCompoundLayout.h"
+#include "./qanComponentLayout.h"
+#include "./qanIncrementalLayout.h"
+#include "./qanOrthogonalRouter.h"
+#include "./qanEdgeBundler.h"
+#include "./qanSceneSerializer.h"
+#include "./qanOutOfCoreMaterializer.h"
+#include "./qanItemPool.h"
+#include "./qanEdgeRenderer.h"
+#include "./qanNodeRenderer.h"
+#include "./qanLevelOfDetail.h"
 
 struct QuickQanava {
     static void initialize(QQmlEngine* engine) {
@@ -97,6 +112,21 @@ struct QuickQanava {
         qmlRegisterType< qan::EdgeStyle >( "QuickQanava", 2, 0, "EdgeStyle");
         qmlRegisterType< qan::StyleManager >( "QuickQanava", 2, 0, "StyleManager");
         qmlRegisterType< qan::BottomRightResizer >( "QuickQanava", 2, 0, "BottomRightResizer" );
+        qmlRegisterType< qan::EdgeListLoader >( "QuickQanava", 2, 0, "EdgeListLoader" );
+        qmlRegisterType< qan::SceneSerializer >( "QuickQanava", 2, 0, "SceneSerializer" );
+        qmlRegisterType< qan::OutOfCoreMaterializer >( "QuickQanava", 2, 0, "OutOfCoreMaterializer" );
+        qmlRegisterType< qan::ItemPool >( "QuickQanava", 2, 0, "ItemPool" );
+        qmlRegisterType< qan::EdgeRenderer >( "QuickQanava", 2, 0, "EdgeRenderer" );
+        qmlRegisterType< qan::NodeRenderer >( "QuickQanava", 2, 0, "NodeRenderer" );
+        qmlRegisterType< qan::LevelOfDetail >( "QuickQanava", 2, 0, "LevelOfDetail" );
+        qmlRegisterType< qan::ForceDirectedLayout >( "QuickQanava", 2, 0, "ForceDirectedLayout" );
+        qmlRegisterType< qan::LayeredLayout >( "QuickQanava", 2, 0, "LayeredLayout" );
+        qmlRegisterType< qan::TreeLayout >( "QuickQanava", 2, 0, "TreeLayout" );
+        qmlRegisterType< qan::CompoundLayout >( "QuickQanava", 2, 0, "CompoundLayout" );
+        qmlRegisterType< qan::ComponentLayout >( "QuickQanava", 2, 0, "ComponentLayout" );
+        qmlRegisterType< qan::IncrementalLayout >( "QuickQanava", 2, 0, "IncrementalLayout" );
+        qmlRegisterType< qan::OrthogonalRouter >( "QuickQanava", 2, 0, "OrthogonalRouter" );
+        qmlRegisterType< qan::EdgeBundler >( "QuickQanava", 2, 0, "EdgeBundler" );
     }
 };
 
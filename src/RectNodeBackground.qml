@@ -51,6 +51,9 @@ Item {
     //! Back color property, default to style.backColor, but available for user overidde.
     property color  backColor: nodeItem.style.backColor
 
+    //! Shadow is not drawn when false, default to graph level of detail \c detailed property.
+    property bool   detailed: nodeItem.graph ? nodeItem.graph.lod.detailed : true
+
     // private:
     // Default settings for rect radius, shadow margin is the _maximum_ shadow radius (+vertical or horizontal offset).
     property real   shadowMargin: 15
@@ -58,7 +61,7 @@ Item {
     Item {
         id: fakeBackground
         anchors.centerIn: parent
-        layer.enabled: true
+        layer.enabled: detailed
         width: nodeItem.width + shadowMargin; height: nodeItem.height + shadowMargin
         visible: false
         Rectangle {
@@ -95,6 +98,7 @@ Item {
     }
     OpacityMask {
         anchors.centerIn: parent
+        visible: detailed       // Shadow is the most expensive part of node background
         width: parent.width + shadowMargin; height: parent.height + shadowMargin
         source: ShaderEffectSource { sourceItem: fakeBackground; hideSource: false }
         maskSource: ShaderEffectSource { format: ShaderEffectSource.Alpha; sourceItem: backgroundMask; hideSource: false }
@@ -108,7 +112,7 @@ Item {
         color: backColor
         border.color: nodeItem.style.borderColor
         border.width: nodeItem.style.borderWidth
-        antialiasing: true
+        antialiasing: detailed
         opacity: nodeItem.style.backOpacity
         // Note: Do not enable layer to avoid aliasing at high scale
     }
@@ -59,6 +59,7 @@ Item {
         visible: !labelEditor.visible
         Label {
             id: nodeLabel
+            visible: nodeItem && nodeItem.graph ? nodeItem.graph.lod.showLabels : true
             Layout.fillWidth: true
             Layout.fillHeight: contentLayout.children.length === 0
             Layout.preferredHeight: contentHeight
@@ -0,0 +1,149 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the QuickQanava software library.
+//
+// \file	qanAbstractLayout.cpp
+// \author	benoit@destrat.io
+// \date	2018 01 02
+//-----------------------------------------------------------------------------
+
+// Qt headers
+#include <QtConcurrent>
+
+// QuickQanava headers
+#include "./qanAbstractLayout.h"
+#include "./qanNodeItem.h"
+
+namespace qan { // ::qan
+
+/* AbstractLayout Object Management *///---------------------------------------
+AbstractLayout::AbstractLayout( QObject* parent ) :
+    QObject{ parent }
+{
+    connect( &_layoutWatcher,   &QFutureWatcher<void>::finished,
+             this,              &AbstractLayout::layoutFinished );
+}
+
+AbstractLayout::~AbstractLayout()
+{
+    _canceled = true;
+    _layoutWatcher.waitForFinished();
+}
+//-----------------------------------------------------------------------------
+
+/* Layout Configuration *///---------------------------------------------------
+void    AbstractLayout::setGraph( qan::Graph* graph ) noexcept
+{
+    if ( graph != _graph ) {
+        cancel();
+        _graph = graph;
+        _nodes.clear();
+        emit graphChanged();
+    }
+}
+//-----------------------------------------------------------------------------
+
+/* Layout Management *///------------------------------------------------------
+void    AbstractLayout::cancel()
+{
+    _canceled = true;       // Result of an uninterrupted computation is not applied
+    _layoutWatcher.waitForFinished();
+    setRunning( false );
+}
+
+void    AbstractLayout::setRunning( bool running ) noexcept
+{
+    if ( running != _running ) {
+        _running = running;
+        emit runningChanged();
+    }
+}
+
+void    AbstractLayout::run( std::function<void()> compute )
+{
+    _canceled = false;
+    _layoutWatcher.setFuture( QtConcurrent::run( std::move( compute ) ) );
+    setRunning( true );
+}
+
+void    AbstractLayout::applyLayout()
+{
+    if ( !_graph )
+        return;
+    _graph->beginGeometryUpdate();
+    apply();
+    _graph->endGeometryUpdate();
+}
+
+void    AbstractLayout::layoutFinished()
+{
+    if ( _canceled )
+        return;
+    setRunning( false );
+    applyLayout();
+    emit finished();
+}
+//-----------------------------------------------------------------------------
+
+/* Nodes Snapshot *///---------------------------------------------------------
+QPointF AbstractLayout::getTranslation( const std::vector<double>& x, const std::vector<double>& y,
+                                        const std::vector<double>& width, const std::vector<double>& height ) const noexcept
+{
+    if ( _nodes.empty() ||
+         x.size() != _nodes.size() )
+        return QPointF{};
+    qreal left = std::numeric_limits<qreal>::max(), top = std::numeric_limits<qreal>::max();
+    for ( std::size_t n = 0; n < _nodes.size(); ++n ) {
+        left = std::min( left, x[n] - width[n] / 2. );
+        top = std::min( top, y[n] - height[n] / 2. );
+    }
+    return _origin - QPointF{ left, top };
+}
+
+void    AbstractLayout::moveNodes( const std::vector<double>& x, const std::vector<double>& y,
+                                   QPointF translation ) const noexcept
+{
+    if ( x.size() != _nodes.size() ||
+         y.size() != _nodes.size() )
+        return;
+    for ( std::size_t n = 0; n < _nodes.size(); ++n ) {
+        const auto node = _nodes[n].data();
+        if ( node == nullptr )      // Node has been removed while layout was running
+            continue;
+        const auto nodeItem = node->getItem();
+        if ( nodeItem != nullptr &&
+             nodeItem->getDragged() )
+            continue;
+        auto geometry = node->getGeometry();
+        geometry.moveCenter( QPointF{ x[n], y[n] } + translation );
+        node->setGeometry( geometry );
+    }
+}
+//-----------------------------------------------------------------------------
+
+} // ::qan
@@ -0,0 +1,194 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the QuickQanava software library.
+//
+// \file	qanAbstractLayout.h
+// \author	benoit@destrat.io
+// \date	2018 01 02
+//-----------------------------------------------------------------------------
+
+#ifndef qanAbstractLayout_h
+#define qanAbstractLayout_h
+
+// Std headers
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <vector>
+
+// Qt headers
+#include <QObject>
+#include <QPointer>
+#include <QHash>
+#include <QFutureWatcher>
+
+// QuickQanava headers
+#include "./qanGraph.h"
+
+namespace qan { // ::qan
+
+/*! \brief Base class for layouts computed in background on a snapshot of a qan::Graph.
+ *
+ * Subclasses copy graph topology and geometry in an algorithm specific snapshot from the GUI thread, then
+ * compute it in a worker thread with run(). Once computation has finished, apply() is called from the GUI
+ * thread in a single graph geometry update (see qan::Graph::beginGeometryUpdate()), unless the layout has been
+ * canceled in the meantime.
+ *
+ * \warning Worker usually reference subclass members: subclasses must call cancel() from their destructor.
+ */
+class AbstractLayout : public QObject
+{
+    /*! \name AbstractLayout Object Management *///----------------------------
+    //@{
+    Q_OBJECT
+public:
+    explicit AbstractLayout( QObject* parent = nullptr );
+    virtual ~AbstractLayout();
+    AbstractLayout( const AbstractLayout& ) = delete;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Layout Configuration *///----------------------------------------
+    //@{
+public:
+    //! Laid out graph (default to nullptr).
+    Q_PROPERTY( qan::Graph* graph READ getGraph WRITE setGraph NOTIFY graphChanged FINAL )
+    //! \copydoc graph
+    inline qan::Graph*  getGraph() const noexcept { return _graph.data(); }
+    //! \copydoc graph
+    void                setGraph( qan::Graph* graph ) noexcept;
+protected:
+    //! \copydoc graph
+    QPointer<qan::Graph> _graph;
+signals:
+    //! \copydoc graph
+    void                graphChanged();
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Layout Management *///-------------------------------------------
+    //@{
+public:
+    //! Cancel a running layout, node positions are left unchanged.
+    Q_INVOKABLE void    cancel();
+
+public:
+    //! True while a layout is computed in background (read only).
+    Q_PROPERTY( bool running READ getRunning NOTIFY runningChanged FINAL )
+    //! \copydoc running
+    inline bool     getRunning() const noexcept { return _running; }
+private:
+    //! \copydoc running
+    void            setRunning( bool running ) noexcept;
+    //! \copydoc running
+    bool            _running{ false };
+signals:
+    //! \copydoc running
+    void            runningChanged();
+    //! Emitted when layout has been computed and applied to graph nodes.
+    void            finished();
+
+protected:
+    //! Run \c compute in a worker thread, apply() is called once \c compute has returned (unless layout is canceled).
+    void            run( std::function<void()> compute );
+    //! Return true when layout has been canceled, long running \c compute functions should return early.
+    inline bool     isCanceled() const noexcept { return _canceled; }
+    //! Apply layout result to graph, called from GUI thread inside a graph geometry update.
+    virtual void    apply() = 0;
+    //! Call apply() inside a graph geometry update, edges are updated once all nodes have been moved.
+    void            applyLayout();
+private:
+    //! Called from GUI thread when layout worker has finished.
+    void            layoutFinished();
+
+    QFutureWatcher<void>    _layoutWatcher;
+    std::atomic<bool>       _canceled{ false };
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Nodes Snapshot *///----------------------------------------------
+    //@{
+protected:
+    /*! \brief Snapshot graph ungrouped nodes, \c addNode( node, geometry ) must insert \c node in layout and return its index.
+     *
+     * Layout indexes must be consecutive from 0 (snapshot order), use the returned hash to snapshot edges.
+     */
+    template < class AddNode >
+    QHash<const qan::Node*, std::size_t>    snapshotNodes( AddNode addNode );
+
+    /*! \brief Return translation keeping snapshot nodes bounding rect top left corner unchanged.
+     *
+     * \c x and \c y are laid out nodes centers, \c width and \c height their sizes, in snapshot order.
+     */
+    QPointF         getTranslation( const std::vector<double>& x, const std::vector<double>& y,
+                                    const std::vector<double>& width, const std::vector<double>& height ) const noexcept;
+
+    /*! \brief Move snapshot nodes center to (\c x, \c y) + \c translation.
+     *
+     * Nodes removed from graph or dragged by user since snapshot are not moved.
+     */
+    void            moveNodes( const std::vector<double>& x, const std::vector<double>& y,
+                               QPointF translation = QPointF{} ) const noexcept;
+
+    //! Nodes of snapshot, in layout node index order.
+    std::vector<QPointer<qan::Node>>    _nodes;
+private:
+    //! Top left corner of snapshot nodes bounding rect.
+    QPointF                             _origin;
+    //@}
+    //-------------------------------------------------------------------------
+};
+
+template < class AddNode >
+QHash<const qan::Node*, std::size_t>    AbstractLayout::snapshotNodes( AddNode addNode )
+{
+    _nodes.clear();
+    QHash<const qan::Node*, std::size_t> nodeIndexes;
+    if ( !_graph )
+        return nodeIndexes;
+    _nodes.reserve( static_cast<std::size_t>( _graph->getNodeCount() ) );
+    nodeIndexes.reserve( _graph->getNodeCount() );
+    qreal left = std::numeric_limits<qreal>::max(), top = std::numeric_limits<qreal>::max();
+    for ( const auto& node : _graph->getNodes() ) {
+        if ( !node ||
+             !node->getGroup().expired() )
+            continue;
+        const auto geometry = node->getGeometry();
+        left = std::min( left, geometry.left() );
+        top = std::min( top, geometry.top() );
+        nodeIndexes.insert( node.get(), addNode( *node, geometry ) );
+        _nodes.emplace_back( node.get() );
+    }
+    _origin = _nodes.empty() ? QPointF{} : QPointF{ left, top };
+    return nodeIndexes;
+}
+
+} // ::qan
+
+#endif // qanAbstractLayout_h
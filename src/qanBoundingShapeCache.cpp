@@ -0,0 +1,135 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+//-----------------------------------------------------------------------------
+// This file is a part of the QuickQanava software library.
+//
+// \file	qanBoundingShapeCache.cpp
+// \author	benoit@destrat.io
+// \date	2017 12 21
+//-----------------------------------------------------------------------------
+
+// Std headers
+#include <algorithm>    // std::min std::max
+
+// Qt headers
+#include <QPainterPath>
+
+// QuickQanava headers
+#include "./qanBoundingShapeCache.h"
+
+namespace qan { // ::qan
+
+uint    qHash( const BoundingShapeCache::Key& key, uint seed ) noexcept
+{
+    seed ^= ::qHash( static_cast<unsigned int>( key.kind ), seed ) + 0x9e3779b9 + ( seed << 6 ) + ( seed >> 2 );
+    seed ^= ::qHash( key.width, seed ) + 0x9e3779b9 + ( seed << 6 ) + ( seed >> 2 );
+    seed ^= ::qHash( key.height, seed ) + 0x9e3779b9 + ( seed << 6 ) + ( seed >> 2 );
+    seed ^= ::qHash( key.radius, seed ) + 0x9e3779b9 + ( seed << 6 ) + ( seed >> 2 );
+    return seed;
+}
+
+/* Bounding Shape Cache Management *///----------------------------------------
+constexpr int   BoundingShapeCache::MaxSize;
+
+QHash<BoundingShapeCache::Key, QPolygonF>&  BoundingShapeCache::cache() noexcept
+{
+    static QHash<Key, QPolygonF> shapes;
+    return shapes;
+}
+
+QPolygonF   BoundingShapeCache::shape( Kind kind, qreal width, qreal height, qreal radius )
+{
+    const Key key{ kind, width, height, kind == Kind::RoundedRect ? radius : 0. };
+    auto& shapes = cache();
+    const auto shape = shapes.constFind( key );
+    if ( shape != shapes.constEnd() )
+        return *shape;              // Implicitly shared copy
+    if ( shapes.size() >= MaxSize ) // Flush cache, mostly usefull when nodes are continuously resized
+        shapes.clear();
+    return *shapes.insert( key, generateShape( key ) );
+}
+
+bool    BoundingShapeCache::contains( Kind kind, qreal width, qreal height, qreal radius, const QPointF& p ) noexcept
+{
+    const qreal x = p.x();
+    const qreal y = p.y();
+    if ( x < 0. || y < 0. || x > width || y > height )
+        return false;
+    switch ( kind ) {
+    case Kind::Rect:
+        return true;
+    case Kind::RoundedRect: {
+        // Point is inside if it is outside of corner boxes, or inside its corner ellipse (radius are
+        // bounded to half width and height, as in QPainterPath::addRoundedRect())
+        const qreal rx = std::min( radius, width / 2. );
+        const qreal ry = std::min( radius, height / 2. );
+        if ( rx <= 0. || ry <= 0. )
+            return true;
+        const qreal dx = std::max( { rx - x, x - ( width - rx ), 0. } ) / rx;
+        const qreal dy = std::max( { ry - y, y - ( height - ry ), 0. } ) / ry;
+        return dx * dx + dy * dy <= 1.;
+    }
+    case Kind::Ellipse: {
+        const qreal rx = width / 2.;
+        const qreal ry = height / 2.;
+        if ( rx <= 0. || ry <= 0. )
+            return false;
+        const qreal nx = ( x - rx ) / rx;
+        const qreal ny = ( y - ry ) / ry;
+        return nx * nx + ny * ny <= 1.;
+    }
+    }
+    return false;
+}
+
+int     BoundingShapeCache::size() noexcept { return cache().size(); }
+
+void    BoundingShapeCache::clear() noexcept { cache().clear(); }
+
+QPolygonF   BoundingShapeCache::generateShape( const Key& key )
+{
+    const QRectF rect{ 0., 0., key.width, key.height };
+    switch ( key.kind ) {
+    case Kind::Rect:
+        return QPolygonF{ rect };
+    case Kind::RoundedRect: {
+        QPainterPath path;
+        path.addRoundedRect( rect, key.radius, key.radius );
+        return path.toFillPolygon( QTransform{} );
+    }
+    case Kind::Ellipse: {
+        QPainterPath path;
+        path.addEllipse( rect );
+        return path.toFillPolygon( QTransform{} );
+    }
+    }
+    return QPolygonF{};
+}
+//-----------------------------------------------------------------------------
+
+} // ::qan
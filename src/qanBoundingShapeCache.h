@@ -0,0 +1,97 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+//-----------------------------------------------------------------------------
+// This file is a part of the QuickQanava software library.
+//
+// \file	qanBoundingShapeCache.h
+// \author	benoit@destrat.io
+// \date	2017 12 21
+//-----------------------------------------------------------------------------
+
+#ifndef qanBoundingShapeCache_h
+#define qanBoundingShapeCache_h
+
+// Qt headers
+#include <QPointF>
+#include <QPolygonF>
+#include <QHash>
+
+namespace qan { // ::qan
+
+/*! \brief Cache of default node bounding shapes shared by all node items.
+ *
+ * Generating a rounded rectangle bounding shape require building a QPainterPath and converting it to a polygon,
+ * cached shapes are keyed by (kind, width, height, radius) and returned as implicitly shared QPolygonF: identical
+ * nodes pay path generation once and share the same polygon storage.
+ *
+ * contains() is an analytic point test that does not use the polygon, use it instead of
+ * QPolygonF::containsPoint() for default shapes.
+ *
+ * \note Cache is not thread safe and must be used from GUI thread, it is flushed when it reach \c MaxSize entries.
+ */
+class BoundingShapeCache
+{
+public:
+    enum class Kind : unsigned int {
+        Rect        = 0,
+        RoundedRect = 1,
+        Ellipse     = 2
+    };
+
+    //! Maximum number of cached shapes.
+    static constexpr int    MaxSize = 4096;
+
+    //! Return a shared \c kind shape polygon of size (\c width, \c height) in shape local CS, \c radius is used only for rounded rectangles.
+    static QPolygonF        shape( Kind kind, qreal width, qreal height, qreal radius = 0. );
+    //! Return true if point \c p (in shape local CS) is inside \c kind shape of size (\c width, \c height) and corner \c radius.
+    static bool             contains( Kind kind, qreal width, qreal height, qreal radius, const QPointF& p ) noexcept;
+
+    //! Number of actually cached shapes.
+    static int              size() noexcept;
+    //! Remove all cached shapes (shapes already returned by shape() are still valid).
+    static void             clear() noexcept;
+
+private:
+    struct Key {
+        Kind    kind;
+        qreal   width;
+        qreal   height;
+        qreal   radius;
+        inline bool operator==( const Key& key ) const noexcept {
+            return kind == key.kind && width == key.width && height == key.height && radius == key.radius;
+        }
+    };
+    friend uint qHash( const Key& key, uint seed ) noexcept;
+
+    static QPolygonF                generateShape( const Key& key );
+    static QHash<Key, QPolygonF>&   cache() noexcept;
+};
+
+} // ::qan
+
+#endif // qanBoundingShapeCache_h
@@ -0,0 +1,168 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the QuickQanava software library.
+//
+// \file	qanComponentLayout.cpp
+// \author	benoit@destrat.io
+// \date	2017 12 27
+//-----------------------------------------------------------------------------
+
+// Qt headers
+#include <QHash>
+
+// GTpo headers
+#include <gtpoComponentLayout.h>
+
+// QuickQanava headers
+#include "./qanComponentLayout.h"
+
+namespace qan { // ::qan
+
+/* ComponentLayout Object Management *///----------------------------------------
+ComponentLayout::ComponentLayout( QObject* parent ) :
+    qan::AbstractLayout{ parent },
+    _layout{ std::make_unique<gtpo::ComponentLayout>() }
+{
+}
+
+ComponentLayout::~ComponentLayout()
+{
+    cancel();
+}
+//-----------------------------------------------------------------------------
+
+/* Layout Configuration *///---------------------------------------------------
+void    ComponentLayout::setOrientation( Orientation orientation ) noexcept
+{
+    if ( orientation != _orientation ) {
+        _orientation = orientation;
+        emit orientationChanged();
+    }
+}
+
+void    ComponentLayout::setLayerSpacing( qreal layerSpacing ) noexcept
+{
+    layerSpacing = std::max( 0., layerSpacing );
+    if ( !qFuzzyCompare( 1. + layerSpacing, 1. + _layerSpacing ) ) {
+        _layerSpacing = layerSpacing;
+        emit layerSpacingChanged();
+    }
+}
+
+void    ComponentLayout::setNodeSpacing( qreal nodeSpacing ) noexcept
+{
+    nodeSpacing = std::max( 0., nodeSpacing );
+    if ( !qFuzzyCompare( 1. + nodeSpacing, 1. + _nodeSpacing ) ) {
+        _nodeSpacing = nodeSpacing;
+        emit nodeSpacingChanged();
+    }
+}
+
+void    ComponentLayout::setLayoutComponents( bool layoutComponents ) noexcept
+{
+    if ( layoutComponents != _layoutComponents ) {
+        _layoutComponents = layoutComponents;
+        emit layoutComponentsChanged();
+    }
+}
+
+void    ComponentLayout::setComponentSpacing( qreal componentSpacing ) noexcept
+{
+    componentSpacing = std::max( 0., componentSpacing );
+    if ( !qFuzzyCompare( 1. + componentSpacing, 1. + _componentSpacing ) ) {
+        _componentSpacing = componentSpacing;
+        emit componentSpacingChanged();
+    }
+}
+
+void    ComponentLayout::setNavigable( qan::Navigable* navigable ) noexcept
+{
+    if ( navigable != _navigable ) {
+        _navigable = navigable;
+        emit navigableChanged();
+    }
+}
+
+void    ComponentLayout::setAspectRatio( qreal aspectRatio ) noexcept
+{
+    aspectRatio = std::max( 0.01, aspectRatio );
+    if ( !qFuzzyCompare( 1. + aspectRatio, 1. + _aspectRatio ) ) {
+        _aspectRatio = aspectRatio;
+        emit aspectRatioChanged();
+    }
+}
+//-----------------------------------------------------------------------------
+
+/* Layout Management *///------------------------------------------------------
+bool    ComponentLayout::start()
+{
+    if ( !_graph ) {
+        qWarning() << "qan::ComponentLayout::start(): Error: No target graph.";
+        return false;
+    }
+    if ( getRunning() ) {
+        qWarning() << "qan::ComponentLayout::start(): Error: A layout is already running.";
+        return false;
+    }
+
+    // Snapshot graph topology in GUI thread: ungrouped nodes geometry and edges between them
+    auto& layout = *_layout;
+    layout.clear();
+    const auto nodeIndexes = snapshotNodes( [&layout]( const qan::Node&, const QRectF& geometry ) {
+        return layout.addNode( geometry.width(), geometry.height(), geometry.center().x(), geometry.center().y() );
+    } );
+    for ( const auto& edge : _graph->getEdges() ) {
+        if ( !edge )
+            continue;
+        const auto src = nodeIndexes.constFind( edge->getSrc().lock().get() );
+        const auto dst = nodeIndexes.constFind( edge->getDst().lock().get() );  // Null for hyper edges
+        if ( src != nodeIndexes.constEnd() &&
+             dst != nodeIndexes.constEnd() )
+            layout.addEdge( src.value(), dst.value() );
+    }
+    layout.layoutComponents = _layoutComponents;
+    layout.horizontal = _orientation == Orientation::LeftToRight;
+    layout.layerSpacing = _layerSpacing;
+    layout.nodeSpacing = _nodeSpacing;
+    layout.componentSpacing = _componentSpacing;
+    layout.aspectRatio = _navigable && _navigable->width() > 0. && _navigable->height() > 0. ?
+                            _navigable->width() / _navigable->height() : _aspectRatio;
+
+    run( [this]() { _layout->compute(); } );
+    return true;
+}
+
+void    ComponentLayout::apply()
+{
+    const auto& layout = *_layout;
+    moveNodes( layout.x, layout.y, getTranslation( layout.x, layout.y, layout.width, layout.height ) );
+}
+//-----------------------------------------------------------------------------
+
+} // ::qan
+
@@ -0,0 +1,222 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the QuickQanava software library.
+//
+// \file	qanComponentLayout.h
+// \author	benoit@destrat.io
+// \date	2017 12 27
+//-----------------------------------------------------------------------------
+
+#ifndef qanComponentLayout_h
+#define qanComponentLayout_h
+
+// Std headers
+#include <memory>
+#include <vector>
+
+// Qt headers
+#include <QObject>
+#include <QPointer>
+
+// QuickQanava headers
+#include "./qanAbstractLayout.h"
+#include "./qanNavigable.h"
+
+namespace gtpo {
+class ComponentLayout;
+}
+
+namespace qan { // ::qan
+
+/*! \brief Disconnected components layout and packing, computed in background.
+ *
+ * Connected components of graph are laid out independently and concurrently (with a layered layout, or keeping
+ * actual nodes relative positions when \c layoutComponents is false), their bounding boxes are then packed with a
+ * skyline packer to fit a view of \c navigable aspect ratio (see gtpo::ComponentLayout). Node positions are
+ * applied to graph in a single geometry update (see qan::Graph::beginGeometryUpdate()).
+ *
+ * \code
+ *  Qan.ComponentLayout {
+ *    id: componentLayout
+ *    graph: graphView.graph
+ *    navigable: graphView
+ *    onFinished: graphView.fitInView()
+ *  }
+ *  // componentLayout.start()
+ * \endcode
+ *
+ * \note Grouped nodes and hyper edges are actually ignored.
+ */
+class ComponentLayout : public qan::AbstractLayout
+{
+    /*! \name ComponentLayout Object Management *///-----------------------------
+    //@{
+    Q_OBJECT
+public:
+    explicit ComponentLayout( QObject* parent = nullptr );
+    virtual ~ComponentLayout();
+    ComponentLayout( const ComponentLayout& ) = delete;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Layout Configuration *///----------------------------------------
+    //@{
+public:
+    enum class Orientation : unsigned int {
+        //! Components layers are ordered from left to right, edges are mostly horizontal.
+        LeftToRight = 0,
+        //! Components layers are ordered from top to bottom, edges are mostly vertical.
+        TopToBottom = 1
+    };
+    Q_ENUM(Orientation)
+
+    //! Components layout flow orientation (default to LeftToRight).
+    Q_PROPERTY( Orientation orientation READ getOrientation WRITE setOrientation NOTIFY orientationChanged FINAL )
+    //! \copydoc orientation
+    inline Orientation  getOrientation() const noexcept { return _orientation; }
+    //! \copydoc orientation
+    void                setOrientation( Orientation orientation ) noexcept;
+private:
+    //! \copydoc orientation
+    Orientation         _orientation{ Orientation::LeftToRight };
+signals:
+    //! \copydoc orientation
+    void                orientationChanged();
+
+public:
+    //! Components layout minimum space between two consecutive layers (default to 80.).
+    Q_PROPERTY( qreal layerSpacing READ getLayerSpacing WRITE setLayerSpacing NOTIFY layerSpacingChanged FINAL )
+    //! \copydoc layerSpacing
+    inline qreal    getLayerSpacing() const noexcept { return _layerSpacing; }
+    //! \copydoc layerSpacing
+    void            setLayerSpacing( qreal layerSpacing ) noexcept;
+private:
+    //! \copydoc layerSpacing
+    qreal           _layerSpacing{ 80. };
+signals:
+    //! \copydoc layerSpacing
+    void            layerSpacingChanged();
+
+public:
+    //! Components layout minimum space between two nodes in the same layer (default to 30.).
+    Q_PROPERTY( qreal nodeSpacing READ getNodeSpacing WRITE setNodeSpacing NOTIFY nodeSpacingChanged FINAL )
+    //! \copydoc nodeSpacing
+    inline qreal    getNodeSpacing() const noexcept { return _nodeSpacing; }
+    //! \copydoc nodeSpacing
+    void            setNodeSpacing( qreal nodeSpacing ) noexcept;
+private:
+    //! \copydoc nodeSpacing
+    qreal           _nodeSpacing{ 30. };
+signals:
+    //! \copydoc nodeSpacing
+    void            nodeSpacingChanged();
+
+public:
+    //! Lay out components when true, only pack components keeping their nodes relative positions otherwise (default to true).
+    Q_PROPERTY( bool layoutComponents READ getLayoutComponents WRITE setLayoutComponents NOTIFY layoutComponentsChanged FINAL )
+    //! \copydoc layoutComponents
+    inline bool     getLayoutComponents() const noexcept { return _layoutComponents; }
+    //! \copydoc layoutComponents
+    void            setLayoutComponents( bool layoutComponents ) noexcept;
+private:
+    //! \copydoc layoutComponents
+    bool            _layoutComponents{ true };
+signals:
+    //! \copydoc layoutComponents
+    void            layoutComponentsChanged();
+
+public:
+    //! Minimum space between two components bounding boxes (default to 40.).
+    Q_PROPERTY( qreal componentSpacing READ getComponentSpacing WRITE setComponentSpacing NOTIFY componentSpacingChanged FINAL )
+    //! \copydoc componentSpacing
+    inline qreal    getComponentSpacing() const noexcept { return _componentSpacing; }
+    //! \copydoc componentSpacing
+    void            setComponentSpacing( qreal componentSpacing ) noexcept;
+private:
+    //! \copydoc componentSpacing
+    qreal           _componentSpacing{ 40. };
+signals:
+    //! \copydoc componentSpacing
+    void            componentSpacingChanged();
+
+public:
+    //! View where graph is displayed, packing aspect ratio match \c navigable aspect ratio when start() is called (default to nullptr).
+    Q_PROPERTY( qan::Navigable* navigable READ getNavigable WRITE setNavigable NOTIFY navigableChanged FINAL )
+    //! \copydoc navigable
+    inline qan::Navigable*  getNavigable() const noexcept { return _navigable.data(); }
+    //! \copydoc navigable
+    void                    setNavigable( qan::Navigable* navigable ) noexcept;
+private:
+    //! \copydoc navigable
+    QPointer<qan::Navigable> _navigable;
+signals:
+    //! \copydoc navigable
+    void                    navigableChanged();
+
+public:
+    //! Packing width / height ratio used when \c navigable is not set or has an empty size (default to 1.).
+    Q_PROPERTY( qreal aspectRatio READ getAspectRatio WRITE setAspectRatio NOTIFY aspectRatioChanged FINAL )
+    //! \copydoc aspectRatio
+    inline qreal    getAspectRatio() const noexcept { return _aspectRatio; }
+    //! \copydoc aspectRatio
+    void            setAspectRatio( qreal aspectRatio ) noexcept;
+private:
+    //! \copydoc aspectRatio
+    qreal           _aspectRatio{ 1. };
+signals:
+    //! \copydoc aspectRatio
+    void            aspectRatioChanged();
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Layout Management *///-------------------------------------------
+    //@{
+public:
+    /*! \brief Start a layout of \c graph in background, packing top left corner is kept at actual nodes top left corner.
+     *
+     * \return false if there is no target graph or if a layout is already running.
+     */
+    Q_INVOKABLE bool    start();
+
+protected:
+    //! Apply node positions computed by layout worker.
+    virtual void    apply() override;
+
+private:
+    //! Layout snapshot, accessed only from the worker thread while layout is running.
+    std::unique_ptr<gtpo::ComponentLayout>  _layout;
+    //@}
+    //-------------------------------------------------------------------------
+};
+
+} // ::qan
+
+QML_DECLARE_TYPE( qan::ComponentLayout )
+
+#endif // qanComponentLayout_h
+
@@ -0,0 +1,286 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the QuickQanava software library.
+//
+// \file	qanCompoundLayout.cpp
+// \author	benoit@destrat.io
+// \date	2017 12 26
+//-----------------------------------------------------------------------------
+
+// Std headers
+#include <algorithm>
+#include <limits>
+
+// Qt headers
+#include <QHash>
+
+// GTpo headers
+#include <gtpoCompoundLayout.h>
+
+// QuickQanava headers
+#include "./qanCompoundLayout.h"
+#include "./qanGroupItem.h"
+
+namespace qan { // ::qan
+
+/* CompoundLayout Object Management *///---------------------------------------
+CompoundLayout::CompoundLayout( QObject* parent ) :
+    qan::AbstractLayout{ parent },
+    _layout{ std::make_unique<gtpo::CompoundLayout>() }
+{
+}
+
+CompoundLayout::~CompoundLayout()
+{
+    cancel();
+}
+//-----------------------------------------------------------------------------
+
+/* Layout Configuration *///---------------------------------------------------
+void    CompoundLayout::setOrientation( Orientation orientation ) noexcept
+{
+    if ( orientation != _orientation ) {
+        _orientation = orientation;
+        emit orientationChanged();
+    }
+}
+
+void    CompoundLayout::setLayerSpacing( qreal layerSpacing ) noexcept
+{
+    layerSpacing = std::max( 0., layerSpacing );
+    if ( !qFuzzyCompare( 1. + layerSpacing, 1. + _layerSpacing ) ) {
+        _layerSpacing = layerSpacing;
+        emit layerSpacingChanged();
+    }
+}
+
+void    CompoundLayout::setNodeSpacing( qreal nodeSpacing ) noexcept
+{
+    nodeSpacing = std::max( 0., nodeSpacing );
+    if ( !qFuzzyCompare( 1. + nodeSpacing, 1. + _nodeSpacing ) ) {
+        _nodeSpacing = nodeSpacing;
+        emit nodeSpacingChanged();
+    }
+}
+
+void    CompoundLayout::setGroupPadding( qreal groupPadding ) noexcept
+{
+    groupPadding = std::max( 0., groupPadding );
+    if ( !qFuzzyCompare( 1. + groupPadding, 1. + _groupPadding ) ) {
+        _groupPadding = groupPadding;
+        emit groupPaddingChanged();
+    }
+}
+//-----------------------------------------------------------------------------
+
+/* Layout Management *///------------------------------------------------------
+//! Return \c group content item (group container, or group item when no container has been configured).
+static QQuickItem*  groupContainer( qan::Group& group ) noexcept
+{
+    const auto groupItem = group.getItem();
+    if ( groupItem == nullptr )
+        return nullptr;
+    return groupItem->getContainer() != nullptr ? groupItem->getContainer() : groupItem;
+}
+
+bool    CompoundLayout::start()
+{
+    if ( !_graph ) {
+        qWarning() << "qan::CompoundLayout::start(): Error: No target graph.";
+        return false;
+    }
+    if ( getRunning() ) {
+        qWarning() << "qan::CompoundLayout::start(): Error: A layout is already running.";
+        return false;
+    }
+    const auto containerItem = _graph->getContainerItem();
+    if ( containerItem == nullptr ) {
+        qWarning() << "qan::CompoundLayout::start(): Error: Graph has no container item.";
+        return false;
+    }
+
+    // Groups must be inserted in layout before their content: sort groups by nesting depth
+    std::vector<std::pair<int, qan::Group*>> groups;
+    groups.reserve( static_cast<std::size_t>( _graph->getGroupCount() ) );
+    for ( const auto& group : _graph->getGroups() ) {
+        if ( !group )
+            continue;
+        int depth = 0;
+        for ( auto parent = group->getGroup().lock(); parent; parent = parent->getGroup().lock() )
+            ++depth;
+        groups.emplace_back( depth, group.get() );
+    }
+    std::stable_sort( groups.begin(), groups.end(),
+                      []( const std::pair<int, qan::Group*>& a, const std::pair<int, qan::Group*>& b ) { return a.first < b.first; } );
+
+    // Snapshot groups and nodes: content of collapsed groups is not laid out, its edges are attached to the
+    // outermost collapsed group
+    auto& layout = *_layout;
+    layout.clear();
+    _groups.clear();
+    _layoutNodes.clear();
+    QHash<const qan::Group*, std::size_t> groupIndexes;      // Laid out groups
+    QHash<const qan::Group*, std::size_t> collapsedIndexes;  // Groups with content not laid out, to outermost collapsed group
+    qreal left = std::numeric_limits<qreal>::max(), top = std::numeric_limits<qreal>::max();
+    const auto topLevelGeometry = [&]( const QRectF& geometry ) {
+        left = std::min( left, geometry.left() );
+        top = std::min( top, geometry.top() );
+    };
+    for ( const auto& depthGroup : groups ) {
+        const auto group = depthGroup.second;
+        const auto container = groupContainer( *group );
+        const auto parent = group->getGroup().lock();
+        std::size_t parentIndex = gtpo::CompoundLayout::NoGroup;
+        if ( parent ) {
+            const auto collapsedParent = collapsedIndexes.constFind( parent.get() );
+            if ( collapsedParent != collapsedIndexes.constEnd() ) {
+                collapsedIndexes.insert( group, collapsedParent.value() );
+                continue;
+            }
+            const auto parentGroup = groupIndexes.constFind( parent.get() );
+            if ( parentGroup == groupIndexes.constEnd() )
+                continue;           // Parent group has no item
+            parentIndex = parentGroup.value();
+        }
+        if ( container == nullptr )
+            continue;
+        const auto groupItem = group->getItem();
+        const auto size = groupItem->getCollapsed() ? QSizeF{ groupItem->width(), groupItem->height() } :
+                                                      QSizeF{ container->width(), container->height() };
+        const auto index = layout.addNode( size.width(), size.height(), parentIndex );
+        groupIndexes.insert( group, index );
+        if ( groupItem->getCollapsed() )
+            collapsedIndexes.insert( group, index );
+        if ( !parent )
+            topLevelGeometry( groupItem->mapRectToItem( containerItem, QRectF{ QPointF{ 0., 0. }, size } ) );
+        _groups.emplace_back( group, index );
+    }
+
+    QHash<const qan::Node*, std::size_t> nodeIndexes;       // Edge extremities (nodes of collapsed groups included)
+    nodeIndexes.reserve( _graph->getNodeCount() );
+    _layoutNodes.reserve( static_cast<std::size_t>( _graph->getNodeCount() ) );
+    for ( const auto& node : _graph->getNodes() ) {
+        if ( !node )
+            continue;
+        const auto group = node->getGroup().lock();
+        std::size_t groupIndex = gtpo::CompoundLayout::NoGroup;
+        if ( group ) {
+            const auto collapsedGroup = collapsedIndexes.constFind( group.get() );
+            if ( collapsedGroup != collapsedIndexes.constEnd() ) {
+                nodeIndexes.insert( node.get(), collapsedGroup.value() );
+                continue;
+            }
+            const auto nodeGroup = groupIndexes.constFind( group.get() );
+            if ( nodeGroup == groupIndexes.constEnd() )
+                continue;
+            groupIndex = nodeGroup.value();
+        }
+        const auto geometry = node->getGeometry();
+        if ( !group )
+            topLevelGeometry( geometry );
+        const auto index = layout.addNode( geometry.width(), geometry.height(), groupIndex );
+        nodeIndexes.insert( node.get(), index );
+        _layoutNodes.emplace_back( node.get(), index );
+    }
+    _topLevelOrigin = layout.getNodeCount() > 0 ? QPointF{ left, top } : QPointF{};
+
+    for ( const auto& edge : _graph->getEdges() ) {
+        if ( !edge )
+            continue;
+        const auto src = nodeIndexes.constFind( edge->getSrc().lock().get() );
+        const auto dst = nodeIndexes.constFind( edge->getDst().lock().get() );  // Null for hyper edges
+        if ( src != nodeIndexes.constEnd() &&
+             dst != nodeIndexes.constEnd() )
+            layout.addEdge( src.value(), dst.value() );
+    }
+    layout.horizontal = _orientation == Orientation::LeftToRight;
+    layout.layerSpacing = _layerSpacing;
+    layout.nodeSpacing = _nodeSpacing;
+    layout.groupPadding = _groupPadding;
+
+    run( [this]() { _layout->compute(); } );
+    return true;
+}
+
+void    CompoundLayout::apply()
+{
+    const auto& layout = *_layout;
+    const auto containerItem = _graph->getContainerItem();
+    if ( containerItem == nullptr ||
+         layout.x.size() != layout.getNodeCount() )
+        return;
+
+    // Translate top level layout to keep its top left corner unchanged
+    qreal left = std::numeric_limits<qreal>::max(), top = std::numeric_limits<qreal>::max();
+    for ( std::size_t n = 0; n < layout.getNodeCount(); ++n ) {
+        if ( layout.group[n] != gtpo::CompoundLayout::NoGroup )
+            continue;
+        left = std::min( left, layout.x[n] - layout.layoutWidth[n] / 2. );
+        top = std::min( top, layout.y[n] - layout.layoutHeight[n] / 2. );
+    }
+    const QPointF translation = layout.getNodeCount() == 0 ? QPointF{} : _topLevelOrigin - QPointF{ left, top };
+
+    // Return node n top left corner in graph container item coordinate system
+    std::vector<QQuickItem*> containers( layout.getNodeCount(), nullptr );
+    const auto topLeft = [&]( std::size_t n ) -> QPointF {
+        const QPointF local{ layout.x[n] - layout.layoutWidth[n] / 2., layout.y[n] - layout.layoutHeight[n] / 2. };
+        const auto g = layout.group[n];
+        if ( g == gtpo::CompoundLayout::NoGroup )
+            return local + translation;
+        return containers[g] != nullptr ? containers[g]->mapToItem( containerItem, local ) : local + translation;
+    };
+
+    // Apply groups geometry parent groups first (content is positioned in group container), then nodes geometry,
+    // groups and nodes removed while layout was running are ignored
+    for ( const auto& groupIndex : _groups ) {
+        const auto group = groupIndex.first.data();
+        const auto n = groupIndex.second;
+        const auto groupItem = group != nullptr ? group->getItem() : nullptr;
+        if ( groupItem == nullptr )
+            continue;
+        const auto position = topLeft( n );
+        const auto parentItem = groupItem->parentItem();
+        groupItem->setPosition( parentItem != nullptr ? parentItem->mapFromItem( containerItem, position ) : position );
+        containers[n] = groupContainer( *group );
+        if ( !groupItem->getCollapsed() &&
+             containers[n] != nullptr )
+            containers[n]->setSize( QSizeF{ layout.layoutWidth[n], layout.layoutHeight[n] } );
+    }
+    for ( const auto& nodeIndex : _layoutNodes ) {
+        const auto node = nodeIndex.first.data();
+        if ( node == nullptr )
+            continue;
+        auto geometry = node->getGeometry();
+        geometry.moveTopLeft( topLeft( nodeIndex.second ) );
+        node->setGeometry( geometry );
+    }
+}
+//-----------------------------------------------------------------------------
+
+} // ::qan
+
@@ -0,0 +1,190 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the QuickQanava software library.
+//
+// \file	qanCompoundLayout.h
+// \author	benoit@destrat.io
+// \date	2017 12 26
+//-----------------------------------------------------------------------------
+
+#ifndef qanCompoundLayout_h
+#define qanCompoundLayout_h
+
+// Std headers
+#include <memory>
+#include <utility>
+#include <vector>
+
+// Qt headers
+#include <QObject>
+#include <QPointer>
+
+// QuickQanava headers
+#include "./qanAbstractLayout.h"
+#include "./qanGroup.h"
+
+namespace gtpo {
+class CompoundLayout;
+}
+
+namespace qan { // ::qan
+
+/*! \brief Group aware hierarchical layout, computed in background.
+ *
+ * Grouped nodes are children of their group container item (see qan::GroupItem::container) and use container
+ * local coordinates: content of every group is laid out independently (groups are laid out concurrently) in its
+ * container, groups containers are then resized to fit their content and groups are laid out with ungrouped
+ * nodes at top level (see gtpo::CompoundLayout). Edges crossing group borders are taken into account at the
+ * innermost level containing both their extremities. Nested groups are laid out recursively.
+ *
+ * Collapsed groups (see qan::GroupItem::collapsed) are laid out as regular nodes, their content is left unchanged
+ * and their content edges are attached to the collapsed group.
+ *
+ * \code
+ *  Qan.CompoundLayout {
+ *    id: compoundLayout
+ *    graph: graphView.graph
+ *    orientation: Qan.CompoundLayout.LeftToRight
+ *    onFinished: graphView.fitInView()
+ *  }
+ *  // compoundLayout.start()
+ * \endcode
+ *
+ * \note Groups without an item and hyper edges are actually ignored.
+ */
+class CompoundLayout : public qan::AbstractLayout
+{
+    /*! \name CompoundLayout Object Management *///----------------------------
+    //@{
+    Q_OBJECT
+public:
+    explicit CompoundLayout( QObject* parent = nullptr );
+    virtual ~CompoundLayout();
+    CompoundLayout( const CompoundLayout& ) = delete;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Layout Configuration *///----------------------------------------
+    //@{
+public:
+    enum class Orientation : unsigned int {
+        //! Layers are ordered from left to right, edges are mostly horizontal.
+        LeftToRight = 0,
+        //! Layers are ordered from top to bottom, edges are mostly vertical.
+        TopToBottom = 1
+    };
+    Q_ENUM(Orientation)
+
+    //! Layout flow orientation (default to LeftToRight).
+    Q_PROPERTY( Orientation orientation READ getOrientation WRITE setOrientation NOTIFY orientationChanged FINAL )
+    //! \copydoc orientation
+    inline Orientation  getOrientation() const noexcept { return _orientation; }
+    //! \copydoc orientation
+    void                setOrientation( Orientation orientation ) noexcept;
+private:
+    //! \copydoc orientation
+    Orientation         _orientation{ Orientation::LeftToRight };
+signals:
+    //! \copydoc orientation
+    void                orientationChanged();
+
+public:
+    //! Minimum space between two consecutive layers (default to 80.).
+    Q_PROPERTY( qreal layerSpacing READ getLayerSpacing WRITE setLayerSpacing NOTIFY layerSpacingChanged FINAL )
+    //! \copydoc layerSpacing
+    inline qreal    getLayerSpacing() const noexcept { return _layerSpacing; }
+    //! \copydoc layerSpacing
+    void            setLayerSpacing( qreal layerSpacing ) noexcept;
+private:
+    //! \copydoc layerSpacing
+    qreal           _layerSpacing{ 80. };
+signals:
+    //! \copydoc layerSpacing
+    void            layerSpacingChanged();
+
+public:
+    //! Minimum space between two nodes in the same layer (default to 30.).
+    Q_PROPERTY( qreal nodeSpacing READ getNodeSpacing WRITE setNodeSpacing NOTIFY nodeSpacingChanged FINAL )
+    //! \copydoc nodeSpacing
+    inline qreal    getNodeSpacing() const noexcept { return _nodeSpacing; }
+    //! \copydoc nodeSpacing
+    void            setNodeSpacing( qreal nodeSpacing ) noexcept;
+private:
+    //! \copydoc nodeSpacing
+    qreal           _nodeSpacing{ 30. };
+signals:
+    //! \copydoc nodeSpacing
+    void            nodeSpacingChanged();
+
+public:
+    //! Space between group container borders and group content (default to 20.).
+    Q_PROPERTY( qreal groupPadding READ getGroupPadding WRITE setGroupPadding NOTIFY groupPaddingChanged FINAL )
+    //! \copydoc groupPadding
+    inline qreal    getGroupPadding() const noexcept { return _groupPadding; }
+    //! \copydoc groupPadding
+    void            setGroupPadding( qreal groupPadding ) noexcept;
+private:
+    //! \copydoc groupPadding
+    qreal           _groupPadding{ 20. };
+signals:
+    //! \copydoc groupPadding
+    void            groupPaddingChanged();
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Layout Management *///-------------------------------------------
+    //@{
+public:
+    /*! \brief Start a layout of \c graph in background, layout top left corner is kept at actual top level nodes and groups top left corner.
+     *
+     * \return false if there is no target graph or if a layout is already running.
+     */
+    Q_INVOKABLE bool    start();
+
+protected:
+    //! Apply groups and nodes geometry computed by layout worker.
+    virtual void    apply() override;
+
+private:
+    //! Layout snapshot, accessed only from the worker thread while layout is running.
+    std::unique_ptr<gtpo::CompoundLayout>   _layout;
+    //! Groups of snapshot (parent groups first) with their layout node index.
+    std::vector<std::pair<QPointer<qan::Group>, std::size_t>>   _groups;
+    //! Nodes of snapshot with their layout node index (groups and nodes indexes are interleaved).
+    std::vector<std::pair<QPointer<qan::Node>, std::size_t>>    _layoutNodes;
+    //! Top left corner of top level nodes and groups bounding rect when layout has been started.
+    QPointF                 _topLevelOrigin;
+    //@}
+    //-------------------------------------------------------------------------
+};
+
+} // ::qan
+
+QML_DECLARE_TYPE( qan::CompoundLayout )
+
+#endif // qanCompoundLayout_h
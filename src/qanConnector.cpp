@@ -234,6 +234,12 @@ auto    Connector::getEdgeItem() noexcept -> qan::EdgeItem*
     return _edgeItem.data();
 }
 
+void    Connector::invalidateAdjacentEdges() noexcept
+{
+    if ( _edgeItem )
+        _edgeItem->invalidateGeometry();
+}
+
 void    Connector::setSourcePort( qan::PortItem* sourcePort ) noexcept
 {
     if ( sourcePort != _sourcePort.data() ) {
@@ -162,6 +162,10 @@ signals:
 protected:
     QPointer<qan::EdgeItem>  _edgeItem;
 
+public:
+    //! Invalidate connector transient edge (it is not registered in graph topology) when connector is dragged.
+    virtual void    invalidateAdjacentEdges() noexcept override;
+
 public:
     /*! \brief Connector source port item (ie host node port item for the visual draggable connector item).
      *
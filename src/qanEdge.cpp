@@ -68,11 +68,10 @@ qan::EdgeItem*   Edge::getItem() noexcept { return _item.data(); }
 
 void    Edge::setItem(qan::EdgeItem* edgeItem) noexcept
 {
-    if ( edgeItem != nullptr ) {
-        _item = edgeItem;
-        if ( edgeItem->getEdge() != this )
-            edgeItem->setEdge(this);
-    }
+    _item = edgeItem;
+    if ( edgeItem != nullptr &&
+         edgeItem->getEdge() != this )
+        edgeItem->setEdge(this);
 }
 //-----------------------------------------------------------------------------
 
@@ -74,6 +74,7 @@ public:
 
     Q_PROPERTY( qan::EdgeItem* item READ getItem CONSTANT )
     qan::EdgeItem*   getItem() noexcept;
+    //! Set edge visual \c edgeItem, nullptr detach current item (item is not destroyed).
     void             setItem(qan::EdgeItem* edgeItem) noexcept;
 private:
     QPointer<qan::EdgeItem> _item;
@@ -0,0 +1,435 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the QuickQanava software library.
+//
+// \file	qanEdgeBundler.cpp
+// \author	benoit@destrat.io
+// \date	2017 12 30
+//-----------------------------------------------------------------------------
+
+// Std headers
+#include <algorithm>
+#include <cmath>
+
+// Qt headers
+#include <QtConcurrent>
+
+// GTpo headers
+#include <gtpoEdgeBundling.h>
+
+// QuickQanava headers
+#include "./qanEdgeBundler.h"
+#include "./qanNodeItem.h"
+#include "./qanEdgeItem.h"
+#include "./qanPortItem.h"
+
+namespace qan { // ::qan
+
+/* EdgeBundler Object Management *///------------------------------------------
+EdgeBundler::EdgeBundler( QObject* parent ) :
+    QObject{ parent },
+    _bundling{ std::make_unique<gtpo::EdgeBundling>() }
+{
+    _bundlingTimer.setSingleShot( true );
+    _bundlingTimer.setInterval( 0 );
+    connect( &_bundlingTimer,   &QTimer::timeout,
+             this,              &EdgeBundler::processEdits );
+    connect( &_bundlingWatcher, &QFutureWatcher<void>::finished,
+             this,              &EdgeBundler::bundlingFinished );
+}
+
+EdgeBundler::~EdgeBundler()
+{
+    _bundlingWatcher.waitForFinished();     // Worker thread reference _bundling
+    if ( _graph )
+        ForwardingBehaviour<qan::EdgeBundler>::uninstall( *_graph, this );
+}
+//-----------------------------------------------------------------------------
+
+/* Bundler Configuration *///--------------------------------------------------
+void    EdgeBundler::setGraph( qan::Graph* graph ) noexcept
+{
+    if ( graph != _graph ) {
+        _bundlingWatcher.waitForFinished();
+        if ( _graph ) {
+            ForwardingBehaviour<qan::EdgeBundler>::uninstall( *_graph, this );
+            disconnect( _graph, nullptr, this, nullptr );
+        }
+        _graph = graph;
+        if ( _graph ) {
+            ForwardingBehaviour<qan::EdgeBundler>::install( *_graph, this );
+            connect( _graph,    &qan::Graph::cleared,
+                     this,      &EdgeBundler::graphCleared );
+            connect( _graph,    &qan::Graph::viewZoomChanged,
+                     this,      &EdgeBundler::viewZoomChanged );
+        }
+        reset();
+        emit graphChanged();
+    }
+}
+
+void    EdgeBundler::setEnabled( bool enabled ) noexcept
+{
+    if ( enabled != _enabled ) {
+        _enabled = enabled;
+        scheduleReset();
+        emit enabledChanged();
+    }
+}
+
+void    EdgeBundler::setStrength( qreal strength ) noexcept
+{
+    strength = std::min( std::max( 0., strength ), 1. );
+    if ( !qFuzzyCompare( 1. + strength, 1. + _strength ) ) {
+        _strength = strength;
+        viewZoomChanged();      // Polylines are blended again, bundling is not modified
+        emit strengthChanged();
+    }
+}
+
+void    EdgeBundler::setMinZoom( qreal minZoom ) noexcept
+{
+    minZoom = std::max( 0., minZoom );
+    if ( !qFuzzyCompare( 1. + minZoom, 1. + _minZoom ) ) {
+        _minZoom = minZoom;
+        viewZoomChanged();
+        emit minZoomChanged();
+    }
+}
+
+void    EdgeBundler::setMaxZoom( qreal maxZoom ) noexcept
+{
+    maxZoom = std::max( 0., maxZoom );
+    if ( !qFuzzyCompare( 1. + maxZoom, 1. + _maxZoom ) ) {
+        _maxZoom = maxZoom;
+        viewZoomChanged();
+        emit maxZoomChanged();
+    }
+}
+
+void    EdgeBundler::setCompatibilityThreshold( qreal compatibilityThreshold ) noexcept
+{
+    compatibilityThreshold = std::min( std::max( 0.05, compatibilityThreshold ), 1. );
+    if ( !qFuzzyCompare( 1. + compatibilityThreshold, 1. + _compatibilityThreshold ) ) {
+        _compatibilityThreshold = compatibilityThreshold;
+        scheduleReset();        // All edges compatible edges are modified
+        emit compatibilityThresholdChanged();
+    }
+}
+//-----------------------------------------------------------------------------
+
+/* Bundling Management *///----------------------------------------------------
+void    EdgeBundler::reset()
+{
+    if ( _running ) {       // Bundling is used from worker thread
+        scheduleReset();
+        return;
+    }
+    _resetPending = false;
+    _geometryModified = false;
+    _bundling->clear();
+    _insertedEdges.clear();
+    _removedEdges.clear();
+    for ( const auto& edge : _edges )   // Restore straight edges until they are bundled again
+        if ( edge && edge->getItem() != nullptr )
+            edge->getItem()->setRoute( QPolygonF{} );
+    _edges.clear();
+    _bundled.clear();
+    if ( !_graph ||
+         !_enabled )
+        return;
+    for ( const auto& edge : _graph->getEdges() )
+        if ( edge )
+            _insertedEdges.emplace_back( edge.get() );
+    scheduleBundling();
+}
+
+void    EdgeBundler::setRunning( bool running ) noexcept
+{
+    if ( running != _running ) {
+        _running = running;
+        emit runningChanged();
+    }
+}
+
+void    EdgeBundler::nodeRemoved( qan::Node* node )
+{
+    if ( node == nullptr )
+        return;
+    for ( const auto& inEdge : node->getInEdges() )
+        removeEdge( inEdge.lock().get() );
+    for ( const auto& outEdge : node->getOutEdges() )
+        removeEdge( outEdge.lock().get() );
+}
+
+void    EdgeBundler::edgeInserted( qan::Edge* edge )
+{
+    if ( edge == nullptr ||
+         !_enabled )
+        return;
+    _insertedEdges.emplace_back( edge );
+    scheduleBundling();
+}
+
+void    EdgeBundler::edgeRemoved( qan::Edge* edge )
+{
+    if ( edge == nullptr )
+        return;
+    _insertedEdges.erase( std::remove( _insertedEdges.begin(), _insertedEdges.end(), edge ), _insertedEdges.end() );
+    removeEdge( edge );
+}
+
+void    EdgeBundler::graphCleared()
+{
+    if ( _graph )
+        ForwardingBehaviour<qan::EdgeBundler>::install( *_graph, this );
+    reset();
+}
+
+void    EdgeBundler::itemGeometryChanged() noexcept
+{
+    // Edges end points are updated in processEdits(), unmodified edges are not bundled again
+    _geometryModified = true;
+    scheduleBundling();
+}
+
+void    EdgeBundler::edgeStyleChanged()
+{
+    const auto edgeItem = qobject_cast<qan::EdgeItem*>( sender() );
+    if ( edgeItem == nullptr ) {        // A shared style line type has been modified
+        scheduleReset();
+        return;
+    }
+    const auto edge = edgeItem->getEdge();
+    if ( edge == nullptr )
+        return;
+    removeEdge( edge );
+    _insertedEdges.emplace_back( edge );
+    scheduleBundling();
+}
+
+void    EdgeBundler::viewZoomChanged()
+{
+    if ( _running )     // Actual strength is applied once running bundling has finished
+        return;
+    const auto strength = zoomStrength();
+    if ( qFuzzyCompare( 1. + strength, 1. + _appliedStrength ) )
+        return;
+    _appliedStrength = strength;
+    for ( std::uint32_t edge = 0; edge < _edges.size(); ++edge )
+        applyPolyline( edge );
+}
+
+void    EdgeBundler::scheduleReset() noexcept
+{
+    _resetPending = true;
+    scheduleBundling();
+}
+
+void    EdgeBundler::scheduleBundling() noexcept
+{
+    if ( !_bundlingTimer.isActive() )
+        _bundlingTimer.start();
+}
+
+void    EdgeBundler::processEdits()
+{
+    if ( _running )     // Edits are processed once running bundling has finished, see bundlingFinished()
+        return;
+    if ( _resetPending ) {
+        reset();        // Schedule a new processEdits() call
+        return;
+    }
+    if ( !_graph ||
+         !_enabled )
+        return;
+    auto& bundling = *_bundling;
+
+    for ( const auto edge : _removedEdges )
+        if ( bundling.isEdge( edge ) )
+            bundling.removeEdge( edge );
+    _removedEdges.clear();
+    if ( _geometryModified ) {      // Only edges with modified end points are marked dirty
+        for ( std::uint32_t edge = 0; edge < _edges.size(); ++edge )
+            if ( _edges[ edge ] &&
+                 bundling.isEdge( edge ) ) {
+                const auto line = edgeLine( *_edges[ edge ] );
+                bundling.setEdge( edge, line.x1(), line.y1(), line.x2(), line.y2() );
+            }
+        _geometryModified = false;
+    }
+    // Inserted edges are now fully initialized (edge items are set)
+    for ( const auto& edge : _insertedEdges )
+        if ( edge )
+            addEdge( edge.data() );
+    _insertedEdges.clear();
+    if ( !bundling.hasDirtyEdges() )
+        return;
+
+    bundling.compatibilityThreshold = _compatibilityThreshold;
+    setRunning( true );
+    _bundlingWatcher.setFuture( QtConcurrent::run( [this]() { _changedEdges = _bundling->bundle(); } ) );
+}
+
+void    EdgeBundler::bundlingFinished()
+{
+    setRunning( false );
+    const auto strength = zoomStrength();
+    if ( !qFuzzyCompare( 1. + strength, 1. + _appliedStrength ) ) {     // Zoom modified while bundling was running
+        _appliedStrength = strength;
+        for ( std::uint32_t edge = 0; edge < _edges.size(); ++edge )
+            applyPolyline( edge );
+    } else {
+        for ( const auto edge : _changedEdges )
+            applyPolyline( edge );
+    }
+    _changedEdges.clear();
+    emit finished();
+    if ( _resetPending || _geometryModified ||
+         !_insertedEdges.empty() || !_removedEdges.empty() )
+        scheduleBundling();
+}
+
+void    EdgeBundler::addEdge( qan::Edge* edge )
+{
+    const auto edgeItem = edge->getItem();
+    if ( edgeItem == nullptr ||
+         _bundled.contains( edge ) )
+        return;
+    // Bundle edges whose style become straight
+    connect( edgeItem,  &qan::EdgeItem::styleChanged,
+             this,      &EdgeBundler::edgeStyleChanged, Qt::UniqueConnection );
+    const auto style = edgeItem->getStyle();
+    if ( style == nullptr )
+        return;
+    connect( style,     &qan::EdgeStyle::lineTypeChanged,
+             this,      &EdgeBundler::edgeStyleChanged, Qt::UniqueConnection );
+    if ( style->getLineType() != qan::EdgeStyle::LineType::Straight ||
+         edgeItem->isHyperEdge() ||
+         qobject_cast<qan::PortItem*>( edgeItem->getSourceItem() ) != nullptr ||
+         qobject_cast<qan::PortItem*>( edgeItem->getDestinationItem() ) != nullptr )
+        return;
+    const auto src = edge->getSrc().lock();
+    const auto dst = edge->getDst().lock();
+    const auto srcItem = src ? static_cast<qan::Node*>( src.get() )->getItem() : nullptr;
+    const auto dstItem = dst ? static_cast<qan::Node*>( dst.get() )->getItem() : nullptr;
+    if ( srcItem == nullptr || dstItem == nullptr ||
+         srcItem == dstItem )
+        return;
+    connectItem( srcItem );
+    connectItem( dstItem );
+    const auto line = edgeLine( *edge );
+    const auto index = _bundling->addEdge( line.x1(), line.y1(), line.x2(), line.y2() );
+    if ( index >= _edges.size() )
+        _edges.resize( index + 1 );
+    _edges[ index ] = edge;
+    _bundled.insert( edge, index );
+}
+
+void    EdgeBundler::removeEdge( qan::Edge* edge )
+{
+    const auto index = _bundled.find( edge );
+    if ( index == _bundled.end() )
+        return;
+    _removedEdges.push_back( index.value() );
+    _edges[ index.value() ] = nullptr;
+    _bundled.erase( index );
+    if ( edge->getItem() != nullptr )
+        edge->getItem()->setRoute( QPolygonF{} );
+    scheduleBundling();
+}
+
+void    EdgeBundler::connectItem( QQuickItem* item )
+{
+    connect( item,  &QQuickItem::parentChanged,     // Node has been grouped or ungrouped
+             this,  &EdgeBundler::scheduleReset, Qt::UniqueConnection );
+    // Grouped nodes are moved with their (eventually nested) group items
+    const auto containerItem = _graph ? _graph->getContainerItem() : nullptr;
+    for ( auto moved = item; moved != nullptr && moved != containerItem; moved = moved->parentItem() )
+        for ( const auto signal : { &QQuickItem::xChanged, &QQuickItem::yChanged,
+                                    &QQuickItem::widthChanged, &QQuickItem::heightChanged } )
+            connect( moved, signal,
+                     this,  &EdgeBundler::itemGeometryChanged, Qt::UniqueConnection );
+}
+
+QLineF  EdgeBundler::edgeLine( const qan::Edge& edge ) const noexcept
+{
+    const auto containerItem = _graph ? _graph->getContainerItem() : nullptr;
+    const auto itemRect = [containerItem]( const QQuickItem* item ) -> QRectF {
+        const QRectF rect{ 0., 0., item->width(), item->height() };
+        return containerItem != nullptr ? item->mapRectToItem( containerItem, rect ) :
+                                          QRectF{ item->position(), rect.size() };
+    };
+    // Clip line between nodes centers on node rect border
+    const auto borderPoint = []( const QRectF& rect, const QPointF& target ) -> QPointF {
+        const auto center = rect.center();
+        const auto d = target - center;
+        const qreal tx = std::abs( d.x() ) > 0.00001 ? rect.width() / ( 2. * std::abs( d.x() ) ) : 1.;
+        const qreal ty = std::abs( d.y() ) > 0.00001 ? rect.height() / ( 2. * std::abs( d.y() ) ) : 1.;
+        return center + d * std::min( 1., std::min( tx, ty ) );
+    };
+    const auto src = edge.getSrc().lock();
+    const auto dst = edge.getDst().lock();
+    const auto srcItem = src ? static_cast<qan::Node*>( src.get() )->getItem() : nullptr;
+    const auto dstItem = dst ? static_cast<qan::Node*>( dst.get() )->getItem() : nullptr;
+    if ( srcItem == nullptr || dstItem == nullptr )
+        return QLineF{};
+    const auto srcRect = itemRect( srcItem );
+    const auto dstRect = itemRect( dstItem );
+    return QLineF{ borderPoint( srcRect, dstRect.center() ), borderPoint( dstRect, srcRect.center() ) };
+}
+
+void    EdgeBundler::applyPolyline( std::uint32_t edge ) noexcept
+{
+    const auto edgeItem = edge < _edges.size() && _edges[ edge ] ? _edges[ edge ]->getItem() : nullptr;
+    if ( edgeItem == nullptr )          // Edge has been removed while bundling was running
+        return;
+    const auto polyline = _bundling->getPolyline( edge, _appliedStrength );
+    if ( _appliedStrength <= 0. ||
+         polyline.size() < 3 ) {        // Straight edge, eventually batched by qan::EdgeRenderer
+        edgeItem->setRoute( QPolygonF{} );
+        return;
+    }
+    QPolygonF polygon;
+    polygon.reserve( static_cast<int>( polyline.size() ) );
+    for ( const auto& point : polyline )
+        polygon.append( QPointF{ point.x, point.y } );
+    edgeItem->setRoute( polygon );
+}
+
+qreal   EdgeBundler::zoomStrength() const noexcept
+{
+    const qreal zoom = _graph ? _graph->getViewZoom() : 1.;
+    qreal factor = zoom <= _minZoom ? 1. : 0.;
+    if ( _maxZoom > _minZoom )
+        factor = std::min( std::max( ( _maxZoom - zoom ) / ( _maxZoom - _minZoom ), 0. ), 1. );
+    return std::round( _strength * factor * 10. ) / 10.;
+}
+//-----------------------------------------------------------------------------
+
+} // ::qan
@@ -0,0 +1,271 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the QuickQanava software library.
+//
+// \file	qanEdgeBundler.h
+// \author	benoit@destrat.io
+// \date	2017 12 30
+//-----------------------------------------------------------------------------
+
+#ifndef qanEdgeBundler_h
+#define qanEdgeBundler_h
+
+// Std headers
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Qt headers
+#include <QObject>
+#include <QPointer>
+#include <QHash>
+#include <QTimer>
+#include <QFutureWatcher>
+
+// QuickQanava headers
+#include "./qanGraph.h"
+#include "./qanForwardingBehaviour.h"
+
+namespace gtpo {
+class EdgeBundling;
+}
+
+namespace qan { // ::qan
+
+/*! \brief Force directed bundling of dense graphs straight edges, computed in background.
+ *
+ * Bundler observe \c graph topology with a GTpo graph behaviour and node items geometry: node to node edges whose
+ * style line type is qan::EdgeStyle::LineType::Straight are bundled with gtpo::EdgeBundling on a worker thread,
+ * bundled polylines are then applied to edge items with qan::EdgeItem::setRoute().
+ *
+ * Edits are coalesced and bundling is incremental: when a node is moved, only its edges and edges compatible with
+ * them are bundled again. Bundling strength depends on graph view zoom (see qan::Graph::viewZoom): edges are fully
+ * bundled below \c minZoom and straight (and batched by qan::EdgeRenderer) above \c maxZoom, changing zoom only
+ * blend computed polylines with straight edges.
+ *
+ * \code
+ *  Qan.EdgeBundler {
+ *    graph: graphView.graph
+ *    strength: 0.8
+ *  }
+ * \endcode
+ *
+ * \note Hyper edges, self loops and edges connected to ports are not bundled.
+ */
+class EdgeBundler : public QObject
+{
+    /*! \name EdgeBundler Object Management *///-------------------------------
+    //@{
+    Q_OBJECT
+public:
+    explicit EdgeBundler( QObject* parent = nullptr );
+    virtual ~EdgeBundler();
+    EdgeBundler( const EdgeBundler& ) = delete;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Bundler Configuration *///---------------------------------------
+    //@{
+public:
+    //! Bundled graph (default to nullptr).
+    Q_PROPERTY( qan::Graph* graph READ getGraph WRITE setGraph NOTIFY graphChanged FINAL )
+    //! \copydoc graph
+    inline qan::Graph*  getGraph() const noexcept { return _graph.data(); }
+    //! \copydoc graph
+    void                setGraph( qan::Graph* graph ) noexcept;
+private:
+    //! \copydoc graph
+    QPointer<qan::Graph> _graph;
+signals:
+    //! \copydoc graph
+    void                graphChanged();
+
+public:
+    //! Edges are bundled only when bundler is enabled, disabling bundler restore straight edges (default to true).
+    Q_PROPERTY( bool enabled READ getEnabled WRITE setEnabled NOTIFY enabledChanged FINAL )
+    //! \copydoc enabled
+    inline bool     getEnabled() const noexcept { return _enabled; }
+    //! \copydoc enabled
+    void            setEnabled( bool enabled ) noexcept;
+private:
+    //! \copydoc enabled
+    bool            _enabled{ true };
+signals:
+    //! \copydoc enabled
+    void            enabledChanged();
+
+public:
+    //! Maximum bundling strength in [0, 1], 0 for straight edges, 1 for fully bundled edges (default to 1.).
+    Q_PROPERTY( qreal strength READ getStrength WRITE setStrength NOTIFY strengthChanged FINAL )
+    //! \copydoc strength
+    inline qreal    getStrength() const noexcept { return _strength; }
+    //! \copydoc strength
+    void            setStrength( qreal strength ) noexcept;
+private:
+    //! \copydoc strength
+    qreal           _strength{ 1. };
+signals:
+    //! \copydoc strength
+    void            strengthChanged();
+
+public:
+    //! Edges are bundled with \c strength when view zoom is less or equal to \c minZoom (default to 0.3).
+    Q_PROPERTY( qreal minZoom READ getMinZoom WRITE setMinZoom NOTIFY minZoomChanged FINAL )
+    //! \copydoc minZoom
+    inline qreal    getMinZoom() const noexcept { return _minZoom; }
+    //! \copydoc minZoom
+    void            setMinZoom( qreal minZoom ) noexcept;
+private:
+    //! \copydoc minZoom
+    qreal           _minZoom{ 0.3 };
+signals:
+    //! \copydoc minZoom
+    void            minZoomChanged();
+
+public:
+    //! Edges are straight when view zoom is greater or equal to \c maxZoom (default to 1.).
+    Q_PROPERTY( qreal maxZoom READ getMaxZoom WRITE setMaxZoom NOTIFY maxZoomChanged FINAL )
+    //! \copydoc maxZoom
+    inline qreal    getMaxZoom() const noexcept { return _maxZoom; }
+    //! \copydoc maxZoom
+    void            setMaxZoom( qreal maxZoom ) noexcept;
+private:
+    //! \copydoc maxZoom
+    qreal           _maxZoom{ 1. };
+signals:
+    //! \copydoc maxZoom
+    void            maxZoomChanged();
+
+public:
+    //! Minimum compatibility in [0, 1] of bundled edges, lower values give larger bundles (default to 0.6).
+    Q_PROPERTY( qreal compatibilityThreshold READ getCompatibilityThreshold WRITE setCompatibilityThreshold NOTIFY compatibilityThresholdChanged FINAL )
+    //! \copydoc compatibilityThreshold
+    inline qreal    getCompatibilityThreshold() const noexcept { return _compatibilityThreshold; }
+    //! \copydoc compatibilityThreshold
+    void            setCompatibilityThreshold( qreal compatibilityThreshold ) noexcept;
+private:
+    //! \copydoc compatibilityThreshold
+    qreal           _compatibilityThreshold{ 0.6 };
+signals:
+    //! \copydoc compatibilityThreshold
+    void            compatibilityThresholdChanged();
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Bundling Management *///-----------------------------------------
+    //@{
+public:
+    //! Reload \c graph actual straight edges, then bundle all edges again.
+    Q_INVOKABLE void    reset();
+
+public:
+    //! True while edges are bundled in background (read only).
+    Q_PROPERTY( bool running READ getRunning NOTIFY runningChanged FINAL )
+    //! \copydoc running
+    inline bool     getRunning() const noexcept { return _running; }
+private:
+    //! \copydoc running
+    void            setRunning( bool running ) noexcept;
+    //! \copydoc running
+    bool            _running{ false };
+signals:
+    //! \copydoc running
+    void            runningChanged();
+    //! Emitted when modified edges have been bundled and applied to edge items.
+    void            finished();
+
+private:
+    friend class qan::ForwardingBehaviour<qan::EdgeBundler>;
+    //! Called from \c graph behaviour when a node is inserted (nodes are not bundled, only their edges).
+    void            nodeInserted( qan::Node* node ) { Q_UNUSED( node ); }
+    //! Called from \c graph behaviour before a node is removed.
+    void            nodeRemoved( qan::Node* node );
+    //! Called from \c graph behaviour when an edge is inserted (edge is not fully initialized yet).
+    void            edgeInserted( qan::Edge* edge );
+    //! Called from \c graph behaviour before an edge is removed.
+    void            edgeRemoved( qan::Edge* edge );
+    //! Reinstall \c graph behaviour (destroyed with graph content) and reload empty graph after qan::Graph::clear().
+    void            graphCleared();
+
+    //! Called when a bundled edge node item (or its group item) is moved or resized.
+    void            itemGeometryChanged() noexcept;
+    //! Called when an edge item style or style line type is modified.
+    void            edgeStyleChanged();
+    //! Called when graph view zoom is modified, apply zoom dependent strength to bundled edges.
+    void            viewZoomChanged();
+    //! Schedule a reset() once running bundling has finished.
+    void            scheduleReset() noexcept;
+
+    //! Schedule processEdits() on next event loop iteration.
+    void            scheduleBundling() noexcept;
+    //! Apply pending edits to bundling, then start bundling dirty edges in background.
+    void            processEdits();
+    //! Called from GUI thread when bundling worker has finished, apply modified polylines to edge items.
+    void            bundlingFinished();
+
+    //! Insert \c edge if edge is a node to node straight edge.
+    void            addEdge( qan::Edge* edge );
+    //! Remove \c edge (if bundled) and restore its straight geometry.
+    void            removeEdge( qan::Edge* edge );
+    //! Monitor \c item geometry (and its group items geometry).
+    void            connectItem( QQuickItem* item );
+    //! Return bundled \c edge straight line from source to destination node borders, in graph container item CS.
+    QLineF          edgeLine( const qan::Edge& edge ) const noexcept;
+    //! Apply \c edge bundled polyline with actual zoom dependent strength to its edge item.
+    void            applyPolyline( std::uint32_t edge ) noexcept;
+    //! Return bundling strength for actual graph view zoom (quantized to limit polylines updates while zooming).
+    qreal           zoomStrength() const noexcept;
+
+private:
+    //! Bundling, accessed only from the worker thread while bundling is running.
+    std::unique_ptr<gtpo::EdgeBundling>         _bundling;
+    //! Bundled edges, in bundling edge index order.
+    std::vector<QPointer<qan::Edge>>            _edges;
+    QHash<const qan::Edge*, std::uint32_t>      _bundled;
+
+    //! Edits occuring since last processEdits(), applied to bundling once bundling is not running.
+    std::vector<QPointer<qan::Edge>>            _insertedEdges;
+    std::vector<std::uint32_t>                  _removedEdges;
+    bool                                        _geometryModified{ false };
+    bool                                        _resetPending{ false };
+
+    //! Edges modified by last bundling, written from the worker thread while bundling is running.
+    std::vector<std::uint32_t>                  _changedEdges;
+    //! Strength applied to actual edge items polylines.
+    qreal                                       _appliedStrength{ 0. };
+    QTimer                                      _bundlingTimer;
+    QFutureWatcher<void>                        _bundlingWatcher;
+    //@}
+    //-------------------------------------------------------------------------
+};
+
+} // ::qan
+
+QML_DECLARE_TYPE( qan::EdgeBundler )
+
+#endif // qanEdgeBundler_h
@@ -35,10 +35,16 @@
 // Qt headers
 #include <QBrush>
 #include <QPainter>
+#include <QHash>
+#include <QSet>
+
+// GTpo headers
+#include <gtpoEdgeGeometry.h>
 
 // QuickQanava headers
 #include "./qanEdgeItem.h"
 #include "./qanNodeItem.h"      // Resolve forward declaration
+#include "./qanPortItem.h"
 #include "./qanGroupItem.h"
 #include "./qanGraph.h"
 
@@ -65,10 +71,13 @@ auto    EdgeItem::getEdge() noexcept -> qan::Edge* { return _edge.data(); }
 auto    EdgeItem::getEdge() const noexcept -> const qan::Edge* { return _edge.data(); }
 auto    EdgeItem::setEdge(qan::Edge* edge) noexcept -> void
 {
+    const bool edgeChanged = edge != _edge;
     _edge = edge;
     if ( edge != nullptr&&
          edge->getItem() != this )
         edge->setItem(this);
+    if ( edgeChanged )
+        emit this->edgeChanged();
 }
 
 auto    EdgeItem::getGraph() const noexcept -> const qan::Graph* {
@@ -86,6 +95,19 @@ auto    EdgeItem::setGraph(qan::Graph* graph) noexcept -> void {
 }
 //-----------------------------------------------------------------------------
 
+/* Recycling Management *///-------------------------------------------------
+void    EdgeItem::itemPooled() noexcept
+{
+    _sourceItem = nullptr;
+    _destinationItem = nullptr;
+    _destinationEdge = nullptr;
+    emit sourceItemChanged();
+    emit destinationItemChanged();
+    emit destinationEdgeChanged();
+    setEdge(nullptr);
+}
+//-----------------------------------------------------------------------------
+
 /* Edge Topology Management *///-----------------------------------------------
 bool    EdgeItem::isHyperEdge() const noexcept { return ( _edge ? _edge->getHDst().lock() != nullptr : false ); }
 
@@ -93,43 +115,13 @@ auto    EdgeItem::setSourceItem( qan::NodeItem* source ) -> void
 {
     if ( source == nullptr )
         return;
-
-    // Connect dst x and y monitored properties change notify signal to slot updateEdge()
-    QMetaMethod updateItemSlot = metaObject()->method( metaObject()->indexOfSlot( "updateItemSlot()" ) );
-    if ( updateItemSlot.isValid() ) {  // Connect src and dst x and y monitored properties change notify signal to slot updateItemSlot()
-        auto srcMetaObj = source->metaObject();
-        QMetaProperty srcX      = srcMetaObj->property( srcMetaObj->indexOfProperty( "x" ) );
-        QMetaProperty srcY      = srcMetaObj->property( srcMetaObj->indexOfProperty( "y" ) );
-        QMetaProperty srcZ      = srcMetaObj->property( srcMetaObj->indexOfProperty( "z" ) );
-        QMetaProperty srcWidth  = srcMetaObj->property( srcMetaObj->indexOfProperty( "width" ) );
-        QMetaProperty srcHeight = srcMetaObj->property( srcMetaObj->indexOfProperty( "height" ) );
-        if ( !srcX.isValid() || !srcX.hasNotifySignal() ) {
-            qWarning() << "qan::EdgeItem::setSourceItem(): Error: can't access source x property.";
-            return;
-        }
-        if (  !srcY.isValid() || !srcY.hasNotifySignal() ) {
-            qWarning() << "qan::EdgeItem::setSourceItem(): Error: can't access source y property.";
-            return;
-        }
-        if (  !srcWidth.isValid() || !srcWidth.hasNotifySignal() ) {
-            qWarning() << "qan::EdgeItem::setSourceItem(): Error: can't access source width property.";
-            return;
-        }
-        if (  !srcHeight.isValid() || !srcHeight.hasNotifySignal() ) {
-            qWarning() << "qan::EdgeItem::setSourceItem(): Error: can't access source height property.";
-            return;
-        }
-        connect( source, srcX.notifySignal(),       this, updateItemSlot );
-        connect( source, srcY.notifySignal(),       this, updateItemSlot );
-        connect( source, srcZ.notifySignal(),       this, updateItemSlot );
-        connect( source, srcWidth.notifySignal(),   this, updateItemSlot );
-        connect( source, srcHeight.notifySignal(),  this, updateItemSlot );
-        _sourceItem = source;
-        emit sourceItemChanged();
-        if ( source->z() < z() )
-            setZ( source->z() );
-        updateItem();
-    }
+    // Note: source geometry is not monitored, edge is invalidated from its source node item, see
+    // qan::NodeItem::invalidateAdjacentEdges()
+    _sourceItem = source;
+    emit sourceItemChanged();
+    if ( source->z() < z() )
+        setZ( source->z() );
+    invalidateGeometry();
 }
 
 auto    EdgeItem::setDestinationItem( qan::NodeItem* destination ) -> void
@@ -137,7 +129,7 @@ auto    EdgeItem::setDestinationItem( qan::NodeItem* destination ) -> void
     configureDestinationItem( destination );
     _destinationItem = destination;
     emit destinationItemChanged();
-    updateItem();
+    invalidateGeometry();
 }
 
 void    EdgeItem::setDestinationEdge( qan::EdgeItem* destination )
@@ -145,48 +137,15 @@ void    EdgeItem::setDestinationEdge( qan::EdgeItem* destination )
     configureDestinationItem( destination );
     _destinationEdge = destination;
     emit destinationEdgeChanged();
-    updateItem();
+    invalidateGeometry();
 }
 
 void    EdgeItem::configureDestinationItem( QQuickItem* item )
 {
-    if ( item == nullptr )
-        return;
-
-    // Connect dst x and y monitored properties change notify signal to slot updateItemSlot()
-    QMetaMethod updateItemSlot = metaObject( )->method( metaObject( )->indexOfSlot( "updateItemSlot()" ) );
-    if ( !updateItemSlot.isValid( ) ) {
-        qWarning() << "qan::EdgeItem::setDestinationItem(): Error: no access to edge updateItem slot.";
-        return;
-    }
-    auto dstMetaObj = item->metaObject( );
-    QMetaProperty dstX      = dstMetaObj->property( dstMetaObj->indexOfProperty( "x" ) );
-    QMetaProperty dstY      = dstMetaObj->property( dstMetaObj->indexOfProperty( "y" ) );
-    QMetaProperty dstZ      = dstMetaObj->property( dstMetaObj->indexOfProperty( "z" ) );
-    QMetaProperty dstWidth  = dstMetaObj->property( dstMetaObj->indexOfProperty( "width" ) );
-    QMetaProperty dstHeight = dstMetaObj->property( dstMetaObj->indexOfProperty( "height" ) );
-    if ( !dstX.isValid() || !dstX.hasNotifySignal() ) {
-        qWarning() << "qan::EdgeItem::setDestinationItem(): Error: can't access source x property.";
-        return;
-    }
-    if (  !dstY.isValid() || !dstY.hasNotifySignal() ) {
-        qWarning() << "qan::EdgeItem::setDestinationItem(): Error: can't access source y property.";
-        return;
-    }
-    if (  !dstWidth.isValid() || !dstWidth.hasNotifySignal() ) {
-        qWarning() << "qan::EdgeItem::setDestinationItem(): Error: can't access source width property.";
-        return;
-    }
-    if (  !dstHeight.isValid() || !dstHeight.hasNotifySignal() ) {
-        qWarning() << "qan::EdgeItem::setDestinationItem(): Error: can't access source height property.";
-        return;
-    }
-    connect( item, dstX.notifySignal(),       this, updateItemSlot );
-    connect( item, dstY.notifySignal(),       this, updateItemSlot );
-    connect( item, dstZ.notifySignal(),       this, updateItemSlot );
-    connect( item, dstWidth.notifySignal(),   this, updateItemSlot );
-    connect( item, dstHeight.notifySignal(),  this, updateItemSlot );
-    if ( item->z() < z() )
+    // Note: destination geometry is not monitored, edge is invalidated from its destination node item or,
+    // for hyper edges, when destination edge is updated (see updateItem())
+    if ( item != nullptr &&
+         item->z() < z() )
         setZ( item->z() );
 }
 //-----------------------------------------------------------------------------
@@ -202,6 +161,9 @@ void    EdgeItem::setHidden(bool hidden) noexcept
 
 void    EdgeItem::updateItem() noexcept
 {
+    if ( _graph &&
+         _graph->isBatchUpdating() )    // Geometry is updated once batch update ends, see qan::Graph::endGeometryUpdate()
+        return;
     auto cache = generateGeometryCache();
     if ( cache.isValid() ) {
         generateLineGeometry(cache);
@@ -211,7 +173,8 @@ void    EdgeItem::updateItem() noexcept
             else if ( cache.lineType == qan::EdgeStyle::LineType::Curved ) {
                 generateLineControlPoints(cache);
                 generateArrowGeometry(cache);
-            }
+            } else if ( cache.lineType == qan::EdgeStyle::LineType::Ortho )
+                generateRouteGeometry(cache);
             generateLabelPosition(cache);
         }
     }
@@ -222,6 +185,144 @@ void    EdgeItem::updateItem() noexcept
         applyGeometry(cache);
     else
         setHidden(true);
+
+    invalidateHyperEdges();
+}
+
+void    EdgeItem::invalidateHyperEdges() noexcept
+{
+    if ( _edge ) {      // Hyper edges connected to this edge must follow its geometry
+        for ( const auto& inHEdge : _edge->getInHEdges() ) {
+            const auto hEdge = inHEdge.lock();
+            if ( hEdge &&
+                 hEdge->getItem() != nullptr )
+                hEdge->getItem()->invalidateGeometry();
+        }
+    }
+}
+
+void    EdgeItem::invalidateGeometry() noexcept
+{
+    if ( window() != nullptr ) {
+        if ( _graph )
+            _graph->invalidateEdgeItem( this );
+        polish();       // Coalesced by Qt Quick: updatePolish() is called once before next frame
+    } else
+        updateItem();
+}
+
+void    EdgeItem::updatePolish()
+{
+    QQuickItem::updatePolish();
+    if ( _graph )       // First polished edge update all edges invalidated in this frame in one batch
+        _graph->updateInvalidatedEdgeItems();
+    else
+        updateItem();
+}
+
+void    EdgeItem::updateItems( const std::vector<qan::EdgeItem*>& edgeItems ) noexcept
+{
+    // Gather node to node edges in a structure of arrays batch, every node bounding shape is
+    // mapped once, then run gtpo::computeEdgeGeometry() and apply results to edge items.
+    std::vector<qan::EdgeItem*> batchedItems;
+    std::vector<qan::EdgeItem*> otherItems;
+    batchedItems.reserve( edgeItems.size() );
+
+    gtpo::EdgeGeometryBatch     batch;
+    QHash<qan::NodeItem*, int>  shapes;     // Shape index for a node item, -1 if item can't be batched
+    const QQuickItem* graphContainerItem = nullptr;
+
+    // Return node item shape index in batch, or -1 if node item is transformed with more than a translation
+    auto nodeShape = [&batch, &shapes, &graphContainerItem]( qan::NodeItem* nodeItem ) -> int {
+        const auto shape = shapes.constFind( nodeItem );
+        if ( shape != shapes.constEnd() )
+            return *shape;
+        int index = -1;
+        const QPointF origin = nodeItem->mapToItem( graphContainerItem, QPointF{ 0., 0. } );
+        const QPointF xAxis = nodeItem->mapToItem( graphContainerItem, QPointF{ 1., 0. } ) - origin;
+        const QPointF yAxis = nodeItem->mapToItem( graphContainerItem, QPointF{ 0., 1. } ) - origin;
+        const auto boundingShape = nodeItem->getBoundingShape();
+        if ( qFuzzyCompare( xAxis.x(), 1. ) && qFuzzyIsNull( xAxis.y() ) &&
+             qFuzzyIsNull( yAxis.x() ) && qFuzzyCompare( yAxis.y(), 1. ) &&
+             !boundingShape.isEmpty() ) {
+            index = static_cast<int>( batch.beginShape( origin.x(), origin.y() ) );
+            for ( const auto& point : boundingShape )
+                batch.addShapePoint( point.x(), point.y() );
+        }
+        shapes.insert( nodeItem, index );
+        return index;
+    };
+
+    QSet<const qan::EdgeItem*>  visited;     // Edges might be invalidated more than once
+    for ( const auto edgeItem : edgeItems ) {
+        if ( edgeItem == nullptr ||
+             visited.contains( edgeItem ) )
+            continue;
+        visited.insert( edgeItem );
+        const auto graph = edgeItem->getGraph();
+        if ( graph != nullptr &&
+             graph->isBatchUpdating() )
+            continue;
+        const QQuickItem* containerItem = graph != nullptr ? graph->getContainerItem() : nullptr;
+        if ( graphContainerItem == nullptr )
+            graphContainerItem = containerItem;
+        const auto srcItem = edgeItem->_sourceItem.data();
+        const auto dstItem = edgeItem->_destinationItem.data();
+        const bool batchable = edgeItem->isBatchable() &&
+                               containerItem != nullptr &&
+                               containerItem == graphContainerItem &&
+                               !edgeItem->isHyperEdge() &&
+                               srcItem != nullptr && dstItem != nullptr &&
+                               edgeItem->getLineType() != qan::EdgeStyle::LineType::Ortho &&
+                               qobject_cast<qan::PortItem*>( srcItem ) == nullptr &&
+                               qobject_cast<qan::PortItem*>( dstItem ) == nullptr;
+        const int srcShape = batchable ? nodeShape( srcItem ) : -1;
+        const int dstShape = batchable && srcShape >= 0 ? nodeShape( dstItem ) : -1;
+        if ( srcShape < 0 || dstShape < 0 ) {
+            otherItems.push_back( edgeItem );
+            continue;
+        }
+        const auto arrowSize = edgeItem->getStyle() != nullptr ? edgeItem->getStyle()->getArrowSize() : 4.0;
+        batch.addEdge( static_cast<std::size_t>( srcShape ), static_cast<std::size_t>( dstShape ), arrowSize,
+                       edgeItem->getLineType() == qan::EdgeStyle::LineType::Curved );
+        batchedItems.push_back( edgeItem );
+    }
+
+    gtpo::computeEdgeGeometry( batch );
+
+    // Edge z is source or destination maximum z (including their group z)
+    auto nodeZ = []( const qan::NodeItem* nodeItem ) -> qreal {
+        const auto node = nodeItem->getNode();
+        const auto group = node != nullptr ? qobject_cast<qan::Group*>( node->getGroup().lock().get() ) : nullptr;
+        const auto groupItem = group != nullptr ? group->getItem() : nullptr;
+        return groupItem != nullptr ? groupItem->z() + nodeItem->z() : nodeItem->z();
+    };
+    for ( std::size_t e = 0; e < batchedItems.size(); ++e ) {
+        const auto edgeItem = batchedItems[e];
+        GeometryCache cache{};
+        cache.srcItem = edgeItem->_sourceItem.data();
+        cache.dstItem = edgeItem->_destinationItem.data();
+        cache.lineType = batch.edgeCurved[e] ? qan::EdgeStyle::LineType::Curved : qan::EdgeStyle::LineType::Straight;
+        cache.z = qMax( nodeZ( edgeItem->_sourceItem.data() ), nodeZ( edgeItem->_destinationItem.data() ) ) + 0.1;
+        cache.hidden = batch.hidden[e] != 0;
+        cache.valid = true;
+        if ( !cache.hidden ) {
+            const qreal arrowSize = batch.edgeArrowSize[e];
+            cache.dstA1 = QPointF{ 0.,              -arrowSize  };
+            cache.dstA2 = QPointF{ arrowSize * 3.,  0.          };
+            cache.dstA3 = QPointF{ 0.,              arrowSize   };
+            cache.p1 = QPointF{ batch.p1X[e], batch.p1Y[e] };
+            cache.p2 = QPointF{ batch.p2X[e], batch.p2Y[e] };
+            cache.c1 = QPointF{ batch.c1X[e], batch.c1Y[e] };
+            cache.c2 = QPointF{ batch.c2X[e], batch.c2Y[e] };
+            cache.dstAngle = batch.dstAngle[e];
+            edgeItem->generateLabelPosition( cache );
+        }
+        edgeItem->applyGeometry( cache );
+        edgeItem->invalidateHyperEdges();
+    }
+    for ( const auto edgeItem : otherItems )
+        edgeItem->updateItem();
 }
 
 EdgeItem::GeometryCache  EdgeItem::generateGeometryCache() const noexcept
@@ -324,7 +425,13 @@ EdgeItem::GeometryCache  EdgeItem::generateGeometryCache() const noexcept
     cache.z = qMax(srcZ, dstZ) + 0.1;
 
     if ( _style )
-        cache.lineType = _style->getLineType();
+        cache.lineType = getLineType();
+    if ( cache.lineType == qan::EdgeStyle::LineType::Ortho ) {
+        if ( _graphRoute.size() >= 2 )
+            cache.route = _graphRoute;
+        else                                // Not routed yet
+            cache.lineType = qan::EdgeStyle::LineType::Straight;
+    }
 
     cache.valid = true;  // Finally, validate cache
     return cache;        // Expecting RVO
@@ -651,6 +758,34 @@ void    EdgeItem::generateLineControlPoints(GeometryCache& cache) const noexcept
     cache.p2 = getLineIntersection( cache.c2, cache.dstBrCenter, cache.dstBs);
 }
 
+void    EdgeItem::generateRouteGeometry(GeometryCache& cache) const noexcept
+{
+    // PRECONDITIONS:
+        // cache should be valid
+        // cache route must have at least two points
+    if ( !cache.isValid() )
+        return;
+    if ( cache.route.size() < 2 ) {
+        cache.lineType = qan::EdgeStyle::LineType::Straight;
+        generateArrowGeometry(cache);
+        return;
+    }
+
+    const qreal arrowSize = getStyle() != nullptr ? getStyle()->getArrowSize() : 4.0;
+    const qreal arrowLength = arrowSize * 3.;
+    cache.dstA1 = QPointF{ 0.,           -arrowSize  };
+    cache.dstA2 = QPointF{ arrowLength,  0.          };
+    cache.dstA3 = QPointF{ 0.,           arrowSize   };
+
+    // Route is already clipped on source and destination borders, correct last point to take into account arrow geometry
+    const QLineF last{ cache.route[cache.route.size() - 2], cache.route.last() };
+    cache.dstAngle = lineAngle(last);
+    if ( last.length() > arrowLength )
+        cache.route.last() = last.pointAt( 1.0 - (arrowLength/last.length()) );
+    cache.p1 = cache.route.first();
+    cache.p2 = cache.route.last();
+}
+
 void    EdgeItem::generateLabelPosition(GeometryCache& cache) const noexcept
 {
     // PRECONDITIONS:
@@ -666,6 +801,20 @@ void    EdgeItem::generateLabelPosition(GeometryCache& cache) const noexcept
         QPolygonF p{ {cache.p1, cache.p2, cache.c1, cache.c2 } };
         if (!p.isEmpty())
             cache.labelPosition = p.boundingRect().center();
+    } else if ( cache.lineType == qan::EdgeStyle::LineType::Ortho ) {
+        // Get the route point at half route length
+        qreal length = 0.;
+        for ( auto p = 1; p < cache.route.size(); ++p )
+            length += QLineF{ cache.route[p - 1], cache.route[p] }.length();
+        qreal half = length / 2.;
+        for ( auto p = 1; p < cache.route.size(); ++p ) {
+            const QLineF segment{ cache.route[p - 1], cache.route[p] };
+            if ( segment.length() >= half ) {
+                cache.labelPosition = ( segment.length() > 0. ? segment.pointAt( half / segment.length() ) : segment.p1() ) + QPointF{10., 10.};
+                break;
+            }
+            half -= segment.length();
+        }
     }
 }
 
@@ -689,6 +838,8 @@ void    EdgeItem::applyGeometry(const GeometryCache& cache) noexcept
         edgeBrPolygon << cache.p1 << cache.p2;
         if ( cache.lineType == qan::EdgeStyle::LineType::Curved )
             edgeBrPolygon << cache.c1 << cache.c2;
+        else if ( cache.lineType == qan::EdgeStyle::LineType::Ortho )
+            edgeBrPolygon << cache.route;
         //QRectF lineBr = QRectF{cache.p1, cache.p2}.normalized();  // Generate a Br with intersection points
         const QRectF edgeBr = edgeBrPolygon.boundingRect();
         setPosition( edgeBr.topLeft() );    // Note: setPosition() call must occurs before mapFromItem()
@@ -696,6 +847,13 @@ void    EdgeItem::applyGeometry(const GeometryCache& cache) noexcept
 
         _p1 = mapFromItem(graphContainerItem, cache.p1);
         _p2 = mapFromItem(graphContainerItem, cache.p2);
+        _route.resize(cache.route.size());  // Empty for non orthogonal edges
+        _routePath.clear();
+        for ( auto p = 0; p < cache.route.size(); ++p ) {
+            _route[p] = mapFromItem(graphContainerItem, cache.route[p]);
+            _routePath += QStringLiteral("%1%2 %3 ").arg( p == 0 ? QChar('M') : QChar('L') )
+                                                    .arg( _route[p].x() ).arg( _route[p].y() );
+        }
         emit lineGeometryChanged();
 
         {   // Apply arrow geometry
@@ -723,6 +881,14 @@ void    EdgeItem::applyGeometry(const GeometryCache& cache) noexcept
     setHidden(false);
 }
 
+void    EdgeItem::setRoute( const QPolygonF& route ) noexcept
+{
+    if ( route != _graphRoute ) {
+        _graphRoute = route;
+        updateItem();
+    }
+}
+
 qreal   EdgeItem::lineAngle(const QLineF& line) const noexcept
 {
     static constexpr    qreal Pi = 3.141592653;
@@ -829,7 +995,7 @@ qreal   EdgeItem::cubicCurveAngleAt(qreal pos, const QPointF& start, const QPoin
 /* Mouse Management *///-------------------------------------------------------
 void    EdgeItem::mouseDoubleClickEvent( QMouseEvent* event )
 {
-    const qreal d = distanceFromLine( event->localPos(), QLineF{_p1, _p2} );
+    const qreal d = distanceFromEdge( event->localPos() );
     if ( d > -0.0001 && d < 5. &&
          event->button() == Qt::LeftButton ) {
         emit edgeDoubleClicked( this, event->localPos() );
@@ -842,7 +1008,7 @@ void    EdgeItem::mouseDoubleClickEvent( QMouseEvent* event )
 
 void    EdgeItem::mousePressEvent( QMouseEvent* event )
 {
-    const qreal d = distanceFromLine( event->localPos( ), QLineF{_p1, _p2} );
+    const qreal d = distanceFromEdge( event->localPos( ) );
     if ( d > -0.0001 && d < 5. ) {
         if ( event->button() == Qt::LeftButton ) {
             emit edgeClicked( this, event->localPos() );
@@ -874,6 +1040,19 @@ qreal   EdgeItem::distanceFromLine( const QPointF& p, const QLineF& line ) const
                       line.y1() + u * ( line.y2() - line.y1() ) };
     return QLineF{p, i}.length();
 }
+
+qreal   EdgeItem::distanceFromEdge( const QPointF& p ) const noexcept
+{
+    if ( _route.size() < 2 )
+        return distanceFromLine( p, QLineF{_p1, _p2} );
+    qreal distance = -1.;       // Minimum distance to route segments
+    for ( auto s = 1; s < _route.size(); ++s ) {
+        const qreal d = distanceFromLine( p, QLineF{_route[s - 1], _route[s]} );
+        if ( d >= 0. && ( distance < 0. || d < distance ) )
+            distance = d;
+    }
+    return distance;
+}
 //-----------------------------------------------------------------------------
 
 /* Style and Properties Management *///----------------------------------------
@@ -900,6 +1079,20 @@ void    EdgeItem::setStyle( EdgeStyle* style ) noexcept
     }
 }
 
+qan::EdgeStyle::LineType    EdgeItem::getLineType() const noexcept
+{
+    if ( !_style )
+        return qan::EdgeStyle::LineType::Straight;
+    if ( _graph &&
+         !_graph->getLod()->getShowCurves() &&
+         _style->getLineType() == qan::EdgeStyle::LineType::Curved )
+        return qan::EdgeStyle::LineType::Straight;
+    if ( _style->getLineType() == qan::EdgeStyle::LineType::Straight &&
+         _graphRoute.size() >= 2 )      // Bundled straight edge, drawn as a polyline
+        return qan::EdgeStyle::LineType::Ortho;
+    return _style->getLineType();
+}
+
 void    EdgeItem::styleDestroyed( QObject* style )
 {
     if ( style != nullptr )
@@ -911,7 +1104,7 @@ void    EdgeItem::styleDestroyed( QObject* style )
 /* Drag'nDrop Management *///--------------------------------------------------
 bool    EdgeItem::contains( const QPointF& point ) const
 {
-    const qreal d = distanceFromLine( point, QLineF{_p1, _p2} );
+    const qreal d = distanceFromEdge( point );
     return ( d > 0. && d < 5. );
 }
 
@@ -944,7 +1137,7 @@ void    EdgeItem::dragEnterEvent( QDragEnterEvent* event )
 void	EdgeItem::dragMoveEvent( QDragMoveEvent* event )
 {
     if ( getAcceptDrops() ) {
-        qreal d = distanceFromLine( event->posF( ), QLineF{_p1, _p2} );
+        qreal d = distanceFromEdge( event->posF( ) );
         if ( d > 0. && d < 5. )
             event->accept();
         else event->ignore();
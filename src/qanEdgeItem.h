@@ -35,6 +35,9 @@
 #ifndef qanEdgeItem_h
 #define qanEdgeItem_h
 
+// STD headers
+#include <vector>
+
 // Qt headers
 #include <QLineF>
 
@@ -43,6 +46,7 @@
 #include "./qanStyle.h"
 #include "./qanNodeItem.h"
 #include "./qanNode.h"
+#include "./qanRecyclable.h"
 
 namespace qan { // ::qan
 
@@ -57,23 +61,28 @@ class NodeItem;
  *
  * \nosubgrouping
  */
-class EdgeItem : public QQuickItem
+class EdgeItem : public QQuickItem,
+                 public qan::Recyclable
 {
     /*! \name Edge Object Management *///--------------------------------------
     //@{
     Q_OBJECT
+    Q_INTERFACES(qan::Recyclable)
 public:
     explicit EdgeItem(QQuickItem* parent = nullptr);
     virtual ~EdgeItem();
     EdgeItem( const EdgeItem& ) = delete;
 
 public:
-    Q_PROPERTY( qan::Edge* edge READ getEdge CONSTANT FINAL )
+    //! Item edge (might change when item is reused from a qan::ItemPool).
+    Q_PROPERTY( qan::Edge* edge READ getEdge NOTIFY edgeChanged FINAL )
     auto        getEdge() noexcept -> qan::Edge*;
     auto        getEdge() const noexcept -> const qan::Edge*;
     auto        setEdge(qan::Edge* edge) noexcept -> void;
 private:
     QPointer<qan::Edge>    _edge;
+signals:
+    void        edgeChanged();
 
 public:
     Q_PROPERTY( qan::Graph* graph READ getGraph WRITE setGraph NOTIFY graphChanged )
@@ -89,6 +98,14 @@ private:
     //@}
     //-------------------------------------------------------------------------
 
+    /*! \name Recycling Management *///--------------------------------------
+    //@{
+public:
+    //! Disconnect source and destination items, reset edge reference (see qan::Recyclable::itemPooled()).
+    virtual void    itemPooled() noexcept override;
+    //@}
+    //-------------------------------------------------------------------------
+
     /*! \name Edge Topology Management *///------------------------------------
     //@{
 public:
@@ -120,7 +137,7 @@ signals:
 private:
     QPointer<qan::EdgeItem> _destinationEdge;
 protected:
-    //! Configure either a node or an edge (for hyper edges) item.
+    //! Configure either a node or an edge (for hyper edges) destination item.
     void            configureDestinationItem( QQuickItem* item );
     //@}
     //-------------------------------------------------------------------------
@@ -151,6 +168,34 @@ public:
      * \note Override to an empty method with no base class calls for an edge with no graphics content.
      */
     virtual void        updateItem() noexcept;
+
+    /*! \brief Schedule an updateItem() call in next polish pass, multiple invalidations in a frame are coalesced.
+     *
+     * Called when source or destination items are moved or resized (see qan::NodeItem::invalidateAdjacentEdges()),
+     * update is synchronous when edge item is not in a window. Edges invalidated in the same frame are updated
+     * together with updateItems() (see qan::Graph::invalidateEdgeItem()).
+     */
+    void                invalidateGeometry() noexcept;
+
+    /*! \brief Update geometry of all \c edgeItems in a single pass, equivalent to calling updateItem() on every item.
+     *
+     * Node bounding shapes are mapped to graph CS once per node instead of once per edge, and node to node edges
+     * geometry is generated with gtpo::computeEdgeGeometry() batched kernel. Edges connected to ports, hyper edges,
+     * edges between rotated or scaled nodes and non batchable edges (see isBatchable()) fall back to updateItem().
+     */
+    static void         updateItems( const std::vector<qan::EdgeItem*>& edgeItems ) noexcept;
+protected:
+    //! Update invalidated edge geometry, see invalidateGeometry().
+    virtual void        updatePolish() override;
+
+    /*! \brief Return true if this edge geometry could be generated by updateItems() (default to true).
+     *
+     * \note Override to false when overriding updateItem(), otherwise batched updates would ignore custom geometry.
+     */
+    virtual bool        isBatchable() const noexcept { return true; }
+private:
+    //! Invalidate hyper edges connected to this edge, they must follow its geometry.
+    void                invalidateHyperEdges() noexcept;
 protected:
 
      /*! FIXME document that
@@ -177,6 +222,7 @@ protected:
             dstA3{std::move(rha.dstA3)},
             dstAngle{rha.dstAngle},
             c1{std::move(rha.c1)},          c2{std::move(rha.c2)},
+            route{std::move(rha.route)},
             labelPosition{std::move(rha.labelPosition)}
         {
             srcItem.swap(rha.srcItem);
@@ -211,6 +257,9 @@ protected:
         QPointF c1;
         QPointF c2;
 
+        //! Orthogonal route (with its last point corrected to fit arrow geometry), empty for non orthogonal edges.
+        QPolygonF   route;
+
         QPointF labelPosition;
     };
     inline GeometryCache    generateGeometryCache() const noexcept;
@@ -227,6 +276,9 @@ protected:
     //! Generate edge line control points when edge has curved style (GeometryCache::c1 and GeometryCache::c2).
     inline void             generateLineControlPoints(GeometryCache& cache) const noexcept;
 
+    //! Generate orthogonal edge line geometry and arrow geometry from edge route (line type fall back to straight when edge has not been routed).
+    inline void             generateRouteGeometry(GeometryCache& cache) const noexcept;
+
     //! Generate edge line label position.
     inline void             generateLabelPosition(GeometryCache& cache) const noexcept;
 
@@ -258,6 +310,32 @@ protected:
     //@}
     //-------------------------------------------------------------------------
 
+    /*! \name Orthogonal Route Management *///--------------------------------
+    //@{
+public:
+    /*! \brief Set edge orthogonal \c route in graph container item CS, from source border to destination border.
+     *
+     * Route is used only when edge line type is qan::EdgeStyle::LineType::Ortho, it is usually set from a
+     * qan::OrthogonalRouter, or when edge line type is qan::EdgeStyle::LineType::Straight, route is then a bundled
+     * polyline set from a qan::EdgeBundler. Setting an empty route restore a straight line geometry.
+     */
+    void            setRoute( const QPolygonF& route ) noexcept;
+    //! Edge orthogonal route in item CS (empty if edge is not an orthogonal routed edge).
+    inline  auto    getRoute() const noexcept -> const QPolygonF& { return _route; }
+    //! Edge orthogonal route as an SVG path in item CS (empty if edge is not an orthogonal routed edge), used from QML PathSvg.
+    Q_PROPERTY( QString routePath READ getRoutePath NOTIFY lineGeometryChanged FINAL )
+    //! \copydoc routePath
+    inline  auto    getRoutePath() const noexcept -> const QString& { return _routePath; }
+private:
+    //! Route set with setRoute(), in graph container item CS.
+    QPolygonF       _graphRoute;
+    //! Route in item CS.
+    QPolygonF       _route;
+    //! \copydoc routePath
+    QString         _routePath;
+    //@}
+    //-------------------------------------------------------------------------
+
     /*! \name Curve Control Points Management *///-----------------------------
     //@{
 public:
@@ -347,6 +425,8 @@ signals:
 private:
     //! Return orthogonal distance between point \c p and \c line, or -1 on error.
     inline qreal    distanceFromLine( const QPointF& p, const QLineF& line ) const noexcept;
+    //! Return orthogonal distance between point \c p and edge line or route, or -1 on error.
+    inline qreal    distanceFromEdge( const QPointF& p ) const noexcept;
 
 public:
     //! Edge label position.
@@ -375,6 +455,14 @@ private:
     QPointer<qan::EdgeStyle>    _style{nullptr};
 signals:
     void            styleChanged();
+
+public:
+    /*! \brief Return style line type, or straight line type when curves are hidden by graph level of detail (see qan::LevelOfDetail::showCurves).
+     *
+     * Straight edges with a route (bundled edges, see qan::EdgeBundler) are drawn as polylines with an orthogonal line type.
+     */
+    qan::EdgeStyle::LineType    getLineType() const noexcept;
+
 private slots:
     //! Called when the style associed to this edge is destroyed.
     void            styleDestroyed( QObject* style );
@@ -0,0 +1,748 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the QuickQanava software library.
+//
+// \file	qanEdgeListLoader.cpp
+// \author	benoit@destrat.io
+// \date	2017 12 06
+//-----------------------------------------------------------------------------
+
+// Std headers
+#include <vector>
+#include <cstring>      // std::memchr()
+#include <cstdlib>      // std::strtof()
+#include <cmath>        // std::ceil()
+#include <functional>
+#include <atomic>
+
+// Qt headers
+#include <QFile>
+#include <QFileInfo>
+#include <QUrl>
+#include <QHash>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QtConcurrent>
+
+// QuickQanava headers
+#include "./qanEdgeListLoader.h"
+#include "./qanNodeItem.h"
+
+namespace qan { // ::qan
+
+/* EdgeListLoader Data *///----------------------------------------------------
+struct EdgeListLoader::Data
+{
+    //! Global node dictionary: node identifier to node index.
+    QHash<QByteArray, quint32>      ids;
+    //! Node index to node identifier.
+    std::vector<QByteArray>         names;
+    //! Node table header columns (first column is node identifier).
+    QList<QByteArray>               columns;
+    //! Index of "label" column in node table or -1 if there is no such column.
+    int                             labelColumn{-1};
+    //! Node table rows indexed by node index (might be smaller than names when some nodes are only referenced in edge list).
+    std::vector<QList<QByteArray>>  attributes;
+    //! Edge source node index.
+    std::vector<quint32>            src;
+    //! Edge destination node index.
+    std::vector<quint32>            dst;
+    //! Edge weights, empty when edge list has no weight column.
+    std::vector<float>              weights;
+    //! Number of non empty lines that have been ignored during parsing.
+    qint64                          malformedLines{0};
+    //! Parsing error description.
+    QString                         error;
+    //! Cancellation flag shared with this loading worker threads.
+    std::atomic<bool>               canceled{false};
+
+    //! Nodes inserted in graph, indexed by node index.
+    std::vector<std::weak_ptr<qan::Node>>   nodes;
+    //! Edges inserted in graph, indexed by edge index.
+    std::vector<std::weak_ptr<qan::Edge>>   edges;
+    //! Index of the next primitive to process in current loading step (nodes first, then edges).
+    size_t                          cursor{0};
+};
+//-----------------------------------------------------------------------------
+
+namespace { // ::qan::anonymous
+
+/* Edge List Parser *///-------------------------------------------------------
+//! Field in a parsed line, points either in the input buffer or in a worker unescape buffer.
+struct Field {
+    const char* data{nullptr};
+    int         size{0};
+};
+
+/*! \brief Line aligned part of an input block parsed by a worker.
+ *
+ * Each chunk intern node identifiers in its own dictionary, local ids are
+ * remapped to global node indexes when chunks are merged.
+ */
+struct Chunk {
+    const char*                     begin{nullptr};
+    const char*                     end{nullptr};
+    QHash<QByteArray, quint32>      ids;        // Node identifier to local id
+    std::vector<QByteArray>         names;      // Local id to node identifier
+    std::vector<quint32>            src;        // Edge source (local id)
+    std::vector<quint32>            dst;        // Edge destination (local id)
+    std::vector<float>              weights;
+    bool                            hasWeights{false};
+    std::vector<quint32>            rowIds;     // Node table row identifier (local id)
+    std::vector<QList<QByteArray>>  rows;       // Node table row fields
+    qint64                          malformedLines{0};
+    std::vector<quint32>            remap;      // Local id to global node index (set during merge)
+    size_t                          offset{0};  // Chunk first edge index in global edge list (set during merge)
+    std::vector<Field>              fields;     // Reused line fields
+    std::vector<QByteArray>         unescaped;  // Reused unescape buffers
+
+    quint32 intern( const Field& field ) {
+        const auto key = QByteArray::fromRawData( field.data, field.size );
+        const auto id = ids.constFind( key );
+        if ( id != ids.constEnd() )
+            return id.value();
+        const auto localId = static_cast<quint32>( names.size() );
+        const QByteArray name{ field.data, field.size };  // Deep copy, input block might be released before merge
+        ids.insert( name, localId );
+        names.push_back( name );
+        return localId;
+    }
+
+    void clear() {
+        begin = end = nullptr;
+        ids.clear(); names.clear();
+        src.clear(); dst.clear(); weights.clear(); hasWeights = false;
+        rowIds.clear(); rows.clear();
+        malformedLines = 0;
+        remap.clear(); offset = 0;
+    }
+};
+
+//! Return a pointer on the next '\n' in [b, e) or \c e.
+inline const char*  findEol( const char* b, const char* e ) noexcept
+{
+    const auto eol = static_cast<const char*>( std::memchr( b, '\n', static_cast<size_t>( e - b ) ) );
+    return eol != nullptr ? eol : e;
+}
+
+//! Return the end of line [b, eol) without trailing '\r'.
+inline const char*  trimEol( const char* b, const char* eol ) noexcept
+{
+    return ( eol > b && eol[-1] == '\r' ) ? eol - 1 : eol;
+}
+
+//! Return true if line [b, e) is empty or a comment.
+inline bool         isIgnored( const char* b, const char* e ) noexcept
+{
+    return b >= e || *b == '#' || *b == '%';
+}
+
+//! Return the first non empty and non comment line in [b, e).
+const char*         skipComments( const char* b, const char* e ) noexcept
+{
+    while ( b < e ) {
+        const auto eol = findEol( b, e );
+        if ( !isIgnored( b, trimEol( b, eol ) ) )
+            return b;
+        b = eol + 1;
+    }
+    return e;
+}
+
+//! Detect separator from first non ignored line in [b, e): tab, comma, semicolon or whitespace.
+char                detectSeparator( const char* b, const char* e ) noexcept
+{
+    b = skipComments( b, e );
+    const auto eol = findEol( b, e );
+    for ( const char separator : { '\t', ',', ';' } )
+        if ( std::memchr( b, separator, static_cast<size_t>( eol - b ) ) != nullptr )
+            return separator;
+    return ' ';
+}
+
+/*! \brief Split line [b, e) in \c chunk fields according to \c separator.
+ *
+ * Double quoted fields are unquoted, escaped quotes ("") are collapsed in \c chunk unescape buffers. With
+ * a whitespace separator, consecutive spaces or tabs are considered as a single separator.
+ */
+void                splitLine( const char* b, const char* e, char separator, Chunk& chunk )
+{
+    const bool whitespace = separator == ' ';
+    const auto isSeparator = [whitespace, separator]( char c ) noexcept {
+        return whitespace ? ( c == ' ' || c == '\t' ) : c == separator;
+    };
+    chunk.fields.clear();
+    const char* p = b;
+    while ( true ) {
+        while ( p < e && ( *p == ' ' || ( whitespace && *p == '\t' ) ) )
+            ++p;
+        if ( whitespace && p >= e )
+            break;
+        Field field;
+        if ( p < e && *p == '"' ) {
+            const char* s = ++p;
+            bool escaped = false;
+            for ( ; p < e; ++p ) {
+                if ( *p != '"' )
+                    continue;
+                if ( p + 1 < e && p[1] == '"' ) {
+                    escaped = true;
+                    ++p;
+                    continue;
+                }
+                break;
+            }
+            field.data = s;
+            field.size = static_cast<int>( p - s );
+            if ( escaped ) {
+                const auto f = chunk.fields.size();
+                if ( chunk.unescaped.size() <= f )
+                    chunk.unescaped.resize( f + 1 );
+                auto& buffer = chunk.unescaped[f];
+                buffer.clear();
+                for ( const char* c = s; c < p; ++c ) {
+                    buffer.append( *c );
+                    if ( *c == '"' )
+                        ++c;            // Skip second quote of an escaped quote
+                }
+                field.data = buffer.constData();
+                field.size = buffer.size();
+            }
+            while ( p < e && !isSeparator( *p ) )
+                ++p;                    // Skip closing quote and garbage until next separator
+        } else {
+            const char* s = p;
+            while ( p < e && !isSeparator( *p ) )
+                ++p;
+            const char* fe = p;
+            while ( fe > s && fe[-1] == ' ' )
+                --fe;
+            field.data = s;
+            field.size = static_cast<int>( fe - s );
+        }
+        chunk.fields.push_back( field );
+        if ( p >= e )
+            break;
+        ++p;                            // Skip separator
+    }
+}
+
+//! Parse a weight field, return \c defaultWeight if field is not a valid number.
+float               parseWeight( const Field& field, float defaultWeight, bool& ok ) noexcept
+{
+    char buffer[64];
+    ok = false;
+    if ( field.size <= 0 ||
+         field.size >= static_cast<int>( sizeof(buffer) ) )
+        return defaultWeight;
+    std::memcpy( buffer, field.data, static_cast<size_t>( field.size ) );
+    buffer[field.size] = '\0';
+    char* end = nullptr;
+    const float weight = std::strtof( buffer, &end );
+    ok = end == buffer + field.size;
+    return ok ? weight : defaultWeight;
+}
+
+} // ::qan::anonymous
+
+/*! \brief Parse a CSV/TSV edge list or node table file in EdgeListLoader::Data.
+ *
+ * Input file is memory mapped when possible, otherwise it is read in fixed size blocks. Each block is splitted
+ * in line aligned chunks parsed concurrently, chunks dictionaries are then merged in global node dictionary.
+ */
+class EdgeListLoader::Parser
+{
+public:
+    using Progress      = std::function<void(qint64)>;
+
+    Parser( Data& data, const std::atomic<bool>& canceled, Progress progress ) :
+        _data( data ), _canceled( canceled ), _progress( progress ),
+        _chunks( static_cast<size_t>( std::max( 1, QThread::idealThreadCount() ) ) ) { }
+
+    //! Parse \c fileName as a node table if \c nodeTable is true, as an edge list otherwise, return false on error.
+    bool    parse( const QString& fileName, bool nodeTable, bool hasHeader )
+    {
+        _nodeTable = nodeTable;
+        _hasHeader = hasHeader || nodeTable;
+        _firstBlock = true;
+        QFile file{ fileName };
+        if ( !file.open( QIODevice::ReadOnly ) ) {
+            _data.error = QStringLiteral( "Can't open file " ) + fileName + QStringLiteral( ": " ) + file.errorString();
+            return false;
+        }
+        const qint64 size = file.size();
+        uchar* map = size > 0 ? file.map( 0, size ) : nullptr;
+        if ( map != nullptr ) {
+            const auto b = reinterpret_cast<const char*>( map );
+            parseBlock( b, b + size );
+            file.unmap( map );
+        } else {                    // Mapping not available (sequential device, 32 bits address space, etc.), read by blocks
+            static constexpr qint64 blockSize = 32 * 1024 * 1024;
+            QByteArray block;
+            while ( !file.atEnd() && !_canceled ) {
+                const auto previous = block.size();
+                block.append( file.read( blockSize ) );
+                if ( block.size() == previous )
+                    break;          // Read error
+                const auto lastEol = block.lastIndexOf( '\n' );
+                if ( lastEol < 0 )
+                    continue;       // Very long line, wait for next block
+                parseBlock( block.constData(), block.constData() + lastEol + 1 );
+                block.remove( 0, lastEol + 1 );
+            }
+            if ( !block.isEmpty() && !_canceled )
+                parseBlock( block.constData(), block.constData() + block.size() );
+        }
+        return true;
+    }
+
+private:
+    void    parseBlock( const char* b, const char* e )
+    {
+        if ( _firstBlock ) {
+            _firstBlock = false;
+            _separator = detectSeparator( b, e );
+            if ( _hasHeader ) {
+                const char* header = skipComments( b, e );
+                const auto eol = findEol( header, e );
+                if ( _nodeTable ) {
+                    Chunk& chunk = _chunks.front();
+                    splitLine( header, trimEol( header, eol ), _separator, chunk );
+                    _data.columns.clear();
+                    for ( const auto& field : chunk.fields ) {
+                        const QByteArray column{ field.data, field.size };
+                        if ( _data.labelColumn < 0 &&
+                             column.toLower() == QByteArrayLiteral( "label" ) )
+                            _data.labelColumn = _data.columns.size();
+                        _data.columns.append( column );
+                    }
+                }
+                if ( _progress )
+                    _progress( eol - b );
+                b = eol < e ? eol + 1 : e;
+            }
+        }
+
+        // Split [b, e) in line aligned chunks, small blocks are not splitted
+        static constexpr qint64 minChunkSize = 64 * 1024;
+        const qint64 size = e - b;
+        const auto chunkCount = static_cast<qint64>( size < minChunkSize ? 1 : _chunks.size() );
+        const char* cb = b;
+        for ( qint64 c = 0; c < static_cast<qint64>( _chunks.size() ); ++c ) {
+            auto& chunk = _chunks[static_cast<size_t>(c)];
+            chunk.clear();
+            const char* ce = c >= chunkCount - 1 ? e : std::max( cb, b + ( size / chunkCount ) * ( c + 1 ) );
+            if ( ce < e && ce > cb )
+                ce = std::min( e, findEol( ce - 1, e ) + 1 );  // Align chunk end on next line start
+            chunk.begin = cb;
+            chunk.end = ce;
+            cb = ce;
+        }
+        QtConcurrent::blockingMap( _chunks, [this]( Chunk& chunk ) { parseChunk( chunk ); } );
+        if ( !_canceled )
+            merge();
+    }
+
+    void    parseChunk( Chunk& chunk )
+    {
+        static constexpr qint64 progressStep = 1024 * 1024;
+        const char* p = chunk.begin;
+        const char* reported = p;
+        while ( p < chunk.end ) {
+            const auto eol = findEol( p, chunk.end );
+            const auto le = trimEol( p, eol );
+            if ( !isIgnored( p, le ) ) {
+                splitLine( p, le, _separator, chunk );
+                const auto& fields = chunk.fields;
+                if ( _nodeTable ) {
+                    if ( !fields.empty() && fields[0].size > 0 ) {
+                        chunk.rowIds.push_back( chunk.intern( fields[0] ) );
+                        QList<QByteArray> row;
+                        row.reserve( static_cast<int>( fields.size() ) );
+                        for ( const auto& field : fields )
+                            row.append( QByteArray{ field.data, field.size } );
+                        chunk.rows.push_back( std::move( row ) );
+                    } else
+                        ++chunk.malformedLines;
+                } else {
+                    if ( fields.size() >= 2 &&
+                         fields[0].size > 0 && fields[1].size > 0 ) {
+                        chunk.src.push_back( chunk.intern( fields[0] ) );
+                        chunk.dst.push_back( chunk.intern( fields[1] ) );
+                        bool ok = false;
+                        chunk.weights.push_back( fields.size() >= 3 ? parseWeight( fields[2], 1.f, ok ) : 1.f );
+                        chunk.hasWeights |= ok;
+                    } else
+                        ++chunk.malformedLines;
+                }
+            }
+            p = eol + 1;
+            if ( p - reported >= progressStep ) {
+                if ( _canceled )
+                    return;
+                if ( _progress )
+                    _progress( p - reported );
+                reported = p;
+            }
+        }
+        if ( _progress )
+            _progress( std::min( p, chunk.end ) - reported );
+    }
+
+    //! Merge chunks dictionaries in global node dictionary and append chunks edges or rows to \c _data.
+    void    merge()
+    {
+        size_t edgeCount = _data.src.size();
+        bool hasWeights = !_data.weights.empty();
+        for ( auto& chunk : _chunks ) {
+            chunk.remap.resize( chunk.names.size() );
+            for ( size_t localId = 0; localId < chunk.names.size(); ++localId ) {
+                const auto& name = chunk.names[localId];
+                auto id = _data.ids.constFind( name );
+                if ( id == _data.ids.constEnd() ) {
+                    id = _data.ids.insert( name, static_cast<quint32>( _data.names.size() ) );
+                    _data.names.push_back( name );
+                }
+                chunk.remap[localId] = id.value();
+            }
+            chunk.offset = edgeCount;
+            edgeCount += chunk.src.size();
+            hasWeights |= chunk.hasWeights;
+            _data.malformedLines += chunk.malformedLines;
+        }
+        if ( _nodeTable ) {
+            _data.attributes.resize( _data.names.size() );
+            for ( auto& chunk : _chunks )
+                for ( size_t r = 0; r < chunk.rows.size(); ++r )
+                    _data.attributes[chunk.remap[chunk.rowIds[r]]] = std::move( chunk.rows[r] );
+            return;
+        }
+        if ( hasWeights )
+            _data.weights.resize( _data.src.size(), 1.f );  // Previous blocks had no weights
+        _data.src.resize( edgeCount );
+        _data.dst.resize( edgeCount );
+        if ( hasWeights )
+            _data.weights.resize( edgeCount );
+        QtConcurrent::blockingMap( _chunks, [this, hasWeights]( Chunk& chunk ) {
+            for ( size_t e = 0; e < chunk.src.size(); ++e ) {
+                _data.src[chunk.offset + e] = chunk.remap[chunk.src[e]];
+                _data.dst[chunk.offset + e] = chunk.remap[chunk.dst[e]];
+                if ( hasWeights )
+                    _data.weights[chunk.offset + e] = chunk.weights[e];
+            }
+        } );
+    }
+
+private:
+    Data&                       _data;
+    const std::atomic<bool>&    _canceled;
+    Progress                    _progress;
+    std::vector<Chunk>          _chunks;
+    bool                        _nodeTable{false};
+    bool                        _hasHeader{false};
+    bool                        _firstBlock{true};
+    char                        _separator{','};
+};
+//-----------------------------------------------------------------------------
+
+/* EdgeListLoader Object Management *///---------------------------------------
+EdgeListLoader::EdgeListLoader( QObject* parent ) :
+    QObject{ parent }
+{
+    _batchTimer.setInterval( 0 );
+    connect( &_batchTimer,      &QTimer::timeout,
+             this,              &EdgeListLoader::processBatch );
+    connect( &_parsingWatcher,  &QFutureWatcher<bool>::finished,
+             this,              &EdgeListLoader::parsingFinished );
+}
+
+EdgeListLoader::~EdgeListLoader()
+{
+    if ( _data )
+        _data->canceled = true;
+    _batchTimer.stop();
+    _parsingWatcher.waitForFinished();  // Worker threads report progress to this
+}
+//-----------------------------------------------------------------------------
+
+/* Loader Configuration *///---------------------------------------------------
+void    EdgeListLoader::setGraph( qan::Graph* graph ) noexcept
+{
+    if ( graph != _graph ) {
+        _graph = graph;
+        emit graphChanged();
+    }
+}
+
+void    EdgeListLoader::setHasHeader( bool hasHeader ) noexcept
+{
+    if ( hasHeader != _hasHeader ) {
+        _hasHeader = hasHeader;
+        emit hasHeaderChanged();
+    }
+}
+
+void    EdgeListLoader::setFrameBudget( int frameBudget ) noexcept
+{
+    frameBudget = std::max( 1, frameBudget );
+    if ( frameBudget != _frameBudget ) {
+        _frameBudget = frameBudget;
+        emit frameBudgetChanged();
+    }
+}
+
+void    EdgeListLoader::setCreateDelegates( bool createDelegates ) noexcept
+{
+    if ( createDelegates != _createDelegates ) {
+        _createDelegates = createDelegates;
+        emit createDelegatesChanged();
+    }
+}
+//-----------------------------------------------------------------------------
+
+/* Loading Management *///-----------------------------------------------------
+bool    EdgeListLoader::load( const QString& edgesFile, const QString& nodesFile )
+{
+    if ( !_graph ) {
+        qWarning() << "qan::EdgeListLoader::load(): Error: No target graph.";
+        return false;
+    }
+    if ( _status == Status::Parsing ||
+         _status == Status::Topology ||
+         _status == Status::Delegates ) {
+        qWarning() << "qan::EdgeListLoader::load(): Error: A loading is already in progress.";
+        return false;
+    }
+    const auto toLocalFile = []( const QString& fileName ) {
+        const QUrl url{ fileName };
+        return url.isLocalFile() ? url.toLocalFile() : fileName;
+    };
+    const QString edgesPath = toLocalFile( edgesFile );
+    const QString nodesPath = nodesFile.isEmpty() ? QString{} : toLocalFile( nodesFile );
+
+    // A canceled loading worker might still be running, it is canceled and has its own data: wait until it stops
+    // to reuse the parsing watcher
+    _parsingWatcher.waitForFinished();
+    _data = std::make_shared<Data>();
+    _errorString.clear();
+    setProgress( 0. );
+    setStatus( Status::Parsing );
+
+    const auto data = _data;
+    const std::weak_ptr<Data> job = _data;
+    const bool hasHeader = _hasHeader;
+    const qint64 totalBytes = std::max( qint64{1}, QFileInfo{ edgesPath }.size() +
+                                                   ( nodesPath.isEmpty() ? 0 : QFileInfo{ nodesPath }.size() ) );
+    auto parsedBytes = std::make_shared<std::atomic<qint64>>( 0 );
+    const auto progress = [this, job, parsedBytes, totalBytes]( qint64 bytes ) {
+        const qint64 parsed = ( *parsedBytes += bytes );
+        const qreal p = 0.4 * static_cast<qreal>( parsed ) / totalBytes;   // Parsing is the first 40% of loading
+        QMetaObject::invokeMethod( this, [this, job, p]() {
+            if ( _status == Status::Parsing &&
+                 _data && _data == job.lock() )  // Ignore progress of a canceled loading
+                setProgress( p );
+        }, Qt::QueuedConnection );
+    };
+    // Worker own its data, it is released once both worker and loader no longer reference it
+    _parsingWatcher.setFuture( QtConcurrent::run( [data, edgesPath, nodesPath, hasHeader, progress]() -> bool {
+        Parser parser{ *data, data->canceled, progress };
+        if ( !nodesPath.isEmpty() &&
+             !parser.parse( nodesPath, true, true ) )
+            return false;
+        return parser.parse( edgesPath, false, hasHeader );
+    } ) );
+    return true;
+}
+
+void    EdgeListLoader::cancel()
+{
+    if ( _data ) {              // Running worker (if any) still reference its data
+        _data->canceled = true;
+        _data.reset();
+    }
+    _batchTimer.stop();
+    if ( _status == Status::Parsing ||
+         _status == Status::Topology ||
+         _status == Status::Delegates )
+        setStatus( Status::Null );
+}
+
+void    EdgeListLoader::setStatus( Status status ) noexcept
+{
+    if ( status != _status ) {
+        _status = status;
+        emit statusChanged();
+    }
+}
+
+void    EdgeListLoader::setProgress( qreal progress ) noexcept
+{
+    progress = qBound( 0., progress, 1. );
+    if ( !qFuzzyCompare( 1. + progress, 1. + _progress ) ) {
+        _progress = progress;
+        emit progressChanged();
+    }
+}
+
+void    EdgeListLoader::parsingFinished()
+{
+    if ( !_data ||
+         _data->canceled )
+        return;
+    if ( !_parsingWatcher.result() ) {
+        fail( _data->error );
+        return;
+    }
+    if ( _data->malformedLines > 0 )
+        qWarning() << "qan::EdgeListLoader::parsingFinished(): Warning:" << _data->malformedLines << "malformed lines have been ignored.";
+    _data->ids.clear();         // Dictionary is no longer necessary
+    _data->nodes.resize( _data->names.size() );
+    _data->edges.resize( _data->src.size() );
+    _data->cursor = 0;
+    setProgress( 0.4 );
+    setStatus( Status::Topology );
+    _batchTimer.start();
+}
+
+void    EdgeListLoader::processBatch()
+{
+    if ( !_data ||
+         ( _status != Status::Topology && _status != Status::Delegates ) ) {
+        _batchTimer.stop();
+        return;
+    }
+    if ( !_graph ) {
+        fail( QStringLiteral( "Target graph has been destroyed." ) );
+        return;
+    }
+    auto& data = *_data;
+    const size_t nodeCount = data.nodes.size();
+    const size_t primitiveCount = nodeCount + data.edges.size();
+    const auto gridColumns = static_cast<size_t>( std::max( 1., std::ceil( std::sqrt( static_cast<double>( nodeCount ) ) ) ) );
+
+    QElapsedTimer timer;
+    timer.start();
+    for ( unsigned int n = 1; data.cursor < primitiveCount; ++n ) {
+        if ( ( n & 0x0F ) == 0 &&       // Don't query timer for every primitive
+             timer.elapsed() >= _frameBudget )
+            break;
+        const size_t i = data.cursor++;
+        if ( _status == Status::Topology ) {
+            if ( i < nodeCount ) {
+                auto node = _graph->insertNonVisualNode<qan::Node>();
+                if ( node == nullptr )
+                    continue;
+                static const QList<QByteArray> noAttributes;
+                const auto& attributes = i < data.attributes.size() ? data.attributes[i] : noAttributes;
+                const auto labelColumn = data.labelColumn;
+                node->setLabel( QString::fromUtf8( labelColumn >= 0 && labelColumn < attributes.size() ? attributes[labelColumn] :
+                                                                                                         data.names[i] ) );
+                for ( int c = 0; c < attributes.size() && c < data.columns.size(); ++c )
+                    if ( c != labelColumn && !data.columns[c].isEmpty() )
+                        node->setProperty( data.columns[c].constData(), QString::fromUtf8( attributes[c] ) );
+                data.nodes[i] = node->shared_from_this();
+            } else {
+                const size_t e = i - nodeCount;
+                const auto src = data.nodes[data.src[e]].lock();
+                const auto dst = data.nodes[data.dst[e]].lock();
+                if ( !src || !dst )
+                    continue;
+                auto edge = _graph->insertNonVisualEdge<qan::Edge>( *src, dst.get() );
+                if ( edge == nullptr )
+                    continue;
+                if ( !data.weights.empty() )
+                    edge->setWeight( static_cast<qreal>( data.weights[e] ) );
+                data.edges[e] = edge->shared_from_this();
+            }
+        } else {
+            if ( i < nodeCount ) {
+                const auto node = data.nodes[i].lock();
+                if ( !node ||
+                     !_graph->createNodeItem( *node ) )
+                    continue;
+                // Default grid placement, nodes would otherwise be stacked at origin (node item might still be incubated
+                // in an asynchronous graph, geometry is then applied once item is created)
+                const auto geometry = node->getGeometry();
+                const qreal spacing = 50.;
+                node->setGeometry( QRectF{ QPointF{ ( i % gridColumns ) * ( geometry.width() + spacing ),
+                                                    ( i / gridColumns ) * ( geometry.height() + spacing ) },
+                                           geometry.size() } );
+            } else {
+                const auto edge = data.edges[i - nodeCount].lock();
+                if ( edge )
+                    _graph->createEdgeItem( *edge );
+            }
+        }
+    }
+
+    const qreal stepProgress = primitiveCount > 0 ? static_cast<qreal>( data.cursor ) / primitiveCount : 1.;
+    if ( _status == Status::Topology ) {
+        setProgress( 0.4 + stepProgress * ( _createDelegates ? 0.3 : 0.6 ) );
+        if ( data.cursor >= primitiveCount ) {
+            data.src.clear(); data.src.shrink_to_fit();
+            data.dst.clear(); data.dst.shrink_to_fit();
+            data.weights.clear(); data.weights.shrink_to_fit();
+            data.attributes.clear(); data.attributes.shrink_to_fit();
+            emit topologyLoaded();
+            if ( _status != Status::Topology )    // Loading canceled from topologyLoaded() handler
+                return;
+            if ( _createDelegates ) {
+                data.cursor = 0;
+                setStatus( Status::Delegates );
+            } else {
+                _batchTimer.stop();
+                _data.reset();
+                setProgress( 1. );
+                setStatus( Status::Ready );
+                emit loaded();
+            }
+        }
+    } else {
+        setProgress( 0.7 + stepProgress * 0.3 );
+        if ( data.cursor >= primitiveCount ) {
+            _batchTimer.stop();
+            _data.reset();
+            setProgress( 1. );
+            setStatus( Status::Ready );
+            emit loaded();
+        }
+    }
+}
+
+void    EdgeListLoader::fail( const QString& error )
+{
+    qWarning() << "qan::EdgeListLoader: Error:" << error;
+    _batchTimer.stop();
+    _data.reset();
+    _errorString = error;
+    setStatus( Status::Error );
+    emit this->error( error );
+}
+//-----------------------------------------------------------------------------
+
+} // ::qan
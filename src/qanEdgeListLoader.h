@@ -0,0 +1,256 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the QuickQanava software library.
+//
+// \file	qanEdgeListLoader.h
+// \author	benoit@destrat.io
+// \date	2017 12 06
+//-----------------------------------------------------------------------------
+
+#ifndef qanEdgeListLoader_h
+#define qanEdgeListLoader_h
+
+// Std headers
+#include <memory>
+
+// Qt headers
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+#include <QFutureWatcher>
+
+// QuickQanava headers
+#include "./qanGraph.h"
+
+namespace qan { // ::qan
+
+/*! \brief Parallel CSV/TSV edge list and node attribute table importer for qan::Graph.
+ *
+ * Loading is done in three steps, the GUI thread is never blocked for more than \c frameBudget ms:
+ * \li \c Parsing: input files are memory mapped (or read by blocks when mapping is not available), splitted
+ * in line aligned chunks and parsed concurrently out of GUI thread. Each worker intern node identifiers in its
+ * own dictionary, dictionaries are then merged in a global node table.
+ * \li \c Topology: non visual nodes and edges are inserted in graph from GUI thread in frame budgeted batches (graph
+ * primitives are QObject with GUI thread affinity), topologyLoaded() is emitted once the complete topology could
+ * be queried.
+ * \li \c Delegates: node and edge items are progressively instantiated in frame budgeted batches (nodes first),
+ * loaded() is emitted once all delegates have been created.
+ *
+ * Edge list format is one edge per line: "source<sep>destination[<sep>weight]". In node attribute tables, first
+ * column is node identifier, a "label" column is used as node label, other columns are set as node dynamic
+ * properties (a header line is mandatory for node tables). Separator is either tab, comma, semicolon or whitespace
+ * and is detected from the first line of each file. Empty lines and lines starting with '#' or '%' are ignored,
+ * fields might be double quoted.
+ *
+ * \code
+ *  Qan.EdgeListLoader {
+ *    id: loader
+ *    graph: graphView.graph
+ *    onTopologyLoaded: console.debug( "Node count=" + graph.getNodeCount() )
+ *    onLoaded: graphView.fitInView()
+ *  }
+ *  // loader.load( "edges.csv", "nodes.csv" )
+ * \endcode
+ */
+class EdgeListLoader : public QObject
+{
+    /*! \name EdgeListLoader Object Management *///----------------------------
+    //@{
+    Q_OBJECT
+public:
+    explicit EdgeListLoader( QObject* parent = nullptr );
+    virtual ~EdgeListLoader();
+    EdgeListLoader( const EdgeListLoader& ) = delete;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Loader Configuration *///----------------------------------------
+    //@{
+public:
+    //! Target graph, nodes and edges are inserted in \c graph (default to nullptr).
+    Q_PROPERTY( qan::Graph* graph READ getGraph WRITE setGraph NOTIFY graphChanged FINAL )
+    //! \copydoc graph
+    inline qan::Graph*  getGraph() const noexcept { return _graph.data(); }
+    //! \copydoc graph
+    void                setGraph( qan::Graph* graph ) noexcept;
+private:
+    //! \copydoc graph
+    QPointer<qan::Graph> _graph;
+signals:
+    //! \copydoc graph
+    void                graphChanged();
+
+public:
+    //! Set to true when edge list first line is a header line that should be skipped (default to false).
+    Q_PROPERTY( bool hasHeader READ getHasHeader WRITE setHasHeader NOTIFY hasHeaderChanged FINAL )
+    //! \copydoc hasHeader
+    inline bool     getHasHeader() const noexcept { return _hasHeader; }
+    //! \copydoc hasHeader
+    void            setHasHeader( bool hasHeader ) noexcept;
+private:
+    //! \copydoc hasHeader
+    bool            _hasHeader{ false };
+signals:
+    //! \copydoc hasHeader
+    void            hasHeaderChanged();
+
+public:
+    //! Maximum time spent in GUI thread per batch in ms (default to 8ms, ie half a 60Hz frame).
+    Q_PROPERTY( int frameBudget READ getFrameBudget WRITE setFrameBudget NOTIFY frameBudgetChanged FINAL )
+    //! \copydoc frameBudget
+    inline int      getFrameBudget() const noexcept { return _frameBudget; }
+    //! \copydoc frameBudget
+    void            setFrameBudget( int frameBudget ) noexcept;
+private:
+    //! \copydoc frameBudget
+    int             _frameBudget{ 8 };
+signals:
+    //! \copydoc frameBudget
+    void            frameBudgetChanged();
+
+public:
+    /*! \brief When set to false, only graph topology is loaded and no visual delegates are created (default to true).
+     *
+     * Delegates could later be created for specific nodes or edges with qan::Graph::createNodeItem() and
+     * qan::Graph::createEdgeItem().
+     */
+    Q_PROPERTY( bool createDelegates READ getCreateDelegates WRITE setCreateDelegates NOTIFY createDelegatesChanged FINAL )
+    //! \copydoc createDelegates
+    inline bool     getCreateDelegates() const noexcept { return _createDelegates; }
+    //! \copydoc createDelegates
+    void            setCreateDelegates( bool createDelegates ) noexcept;
+private:
+    //! \copydoc createDelegates
+    bool            _createDelegates{ true };
+signals:
+    //! \copydoc createDelegates
+    void            createDelegatesChanged();
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Loading Management *///-----------------------------------------
+    //@{
+public:
+    /*! \brief Start loading edge list \c edgesFile and optional node attribute table \c nodesFile in \c graph.
+     *
+     * Method returns immediately, loading is asynchronous: monitor \c status and \c progress properties or
+     * topologyLoaded(), loaded() and error() signals. Local file urls (ie "file:///...") are supported.
+     * \return false if a loading is already in progress or if there is no target graph.
+     */
+    Q_INVOKABLE bool    load( const QString& edgesFile, const QString& nodesFile = QString{} );
+
+    //! Cancel current loading (primitives already inserted in graph are not removed).
+    Q_INVOKABLE void    cancel();
+
+public:
+    enum class Status : unsigned int {
+        //! No loading has been requested.
+        Null        = 0,
+        //! Input files are actually parsed in worker threads.
+        Parsing     = 1,
+        //! Non visual nodes and edges are inserted in graph.
+        Topology    = 2,
+        //! Node and edge delegates are progressively created.
+        Delegates   = 3,
+        //! Loading has finished successfully.
+        Ready       = 4,
+        //! Loading has failed, see \c errorString.
+        Error       = 5
+    };
+    Q_ENUM(Status)
+
+    //! Current loading status (read only).
+    Q_PROPERTY( Status status READ getStatus NOTIFY statusChanged FINAL )
+    //! \copydoc status
+    inline Status   getStatus() const noexcept { return _status; }
+private:
+    //! \copydoc status
+    void            setStatus( Status status ) noexcept;
+    //! \copydoc status
+    Status          _status{ Status::Null };
+signals:
+    //! \copydoc status
+    void            statusChanged();
+
+public:
+    //! Global loading progress in [0., 1.] range (read only).
+    Q_PROPERTY( qreal progress READ getProgress NOTIFY progressChanged FINAL )
+    //! \copydoc progress
+    inline qreal    getProgress() const noexcept { return _progress; }
+private:
+    //! \copydoc progress
+    void            setProgress( qreal progress ) noexcept;
+    //! \copydoc progress
+    qreal           _progress{ 0. };
+signals:
+    //! \copydoc progress
+    void            progressChanged();
+
+public:
+    //! Description of the last loading error (read only).
+    Q_PROPERTY( QString errorString READ getErrorString NOTIFY statusChanged FINAL )
+    //! \copydoc errorString
+    inline QString  getErrorString() const noexcept { return _errorString; }
+private:
+    //! \copydoc errorString
+    QString         _errorString{};
+
+signals:
+    //! Emitted when the complete graph topology has been inserted in graph (delegates might not have been created yet).
+    void            topologyLoaded();
+    //! Emitted once loading has finished, all delegates have been created.
+    void            loaded();
+    //! Emitted when loading fails with an \c error description.
+    void            error( QString error );
+
+private:
+    //! Called from GUI thread when worker threads have finished parsing.
+    void            parsingFinished();
+    //! Insert nodes, edges or delegates in graph until \c frameBudget is elapsed.
+    void            processBatch();
+    //! Stop loading and report \c error.
+    void            fail( const QString& error );
+
+private:
+    struct Data;
+    class Parser;
+    //! Current loading parsed node table and edge list, topology insertion state and cancellation flag (shared with loading worker).
+    std::shared_ptr<Data>   _data;
+    //! Watcher on the worker parsing job.
+    QFutureWatcher<bool>    _parsingWatcher;
+    //! Drive progressive topology and delegates instantiation.
+    QTimer                  _batchTimer;
+    //@}
+    //-------------------------------------------------------------------------
+};
+
+} // ::qan
+
+QML_DECLARE_TYPE( qan::EdgeListLoader )
+
+#endif // qanEdgeListLoader_h
@@ -0,0 +1,385 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the QuickQanava software library.
+//
+// \file	qanEdgeRenderer.cpp
+// \author	benoit@destrat.io
+// \date	2017 12 18
+//-----------------------------------------------------------------------------
+
+// Std headers
+#include <algorithm>    // std::max
+#include <cmath>        // std::sqrt std::cos std::sin
+
+// Qt headers
+#include <QtMath>
+#include <QSGVertexColorMaterial>
+
+// QuickQanava headers
+#include "./qanEdgeRenderer.h"
+#include "./qanEdgeItem.h"
+#include "./qanStyle.h"
+#include "./qanGraph.h"
+
+namespace qan { // ::qan
+
+/* EdgeRenderer Object Management *///-----------------------------------------
+EdgeRenderer::EdgeRenderer( QQuickItem* parent ) :
+    QQuickItem{ parent }
+{
+    setFlag( QQuickItem::ItemHasContents, true );
+    setAcceptedMouseButtons( Qt::NoButton );    // Interactions are handled by edge items
+    setObjectName( QStringLiteral("qan::EdgeRenderer") );
+}
+
+EdgeRenderer::~EdgeRenderer()
+{
+    for ( auto edgeItem = _slots.keyBegin(); edgeItem != _slots.keyEnd(); ++edgeItem )
+        disconnect( *edgeItem, nullptr, this, nullptr );
+}
+//-----------------------------------------------------------------------------
+
+/* Edge Registration Management *///-------------------------------------------
+void    EdgeRenderer::addEdge( qan::EdgeItem* edgeItem ) noexcept
+{
+    if ( edgeItem == nullptr ||
+         _slots.contains( edgeItem ) )
+        return;
+    const auto slot = allocateSlot( edgeKind( *edgeItem ), edgeItem );
+    _slots.insert( edgeItem, slot );
+    markDirty( slot );
+
+    // Note: control points and arrow geometry are always modified with line geometry, see qan::EdgeItem::applyGeometry()
+    connect( edgeItem, &qan::EdgeItem::lineGeometryChanged,
+             this,     [this, edgeItem]() { invalidateEdge( edgeItem ); } );
+    connect( edgeItem, &qan::EdgeItem::visibleChanged,
+             this,     [this, edgeItem]() { invalidateEdge( edgeItem ); } );
+    connect( edgeItem, &qan::EdgeItem::styleChanged,
+             this,     [this, edgeItem]() { invalidateEdge( edgeItem ); } );
+    connect( edgeItem, &QObject::destroyed,
+             this,     [this, edgeItem]() { removeEdge( edgeItem ); } );
+    invalidateEdge( edgeItem );     // Monitor edge style
+    emit edgeCountChanged();
+}
+
+void    EdgeRenderer::removeEdge( qan::EdgeItem* edgeItem ) noexcept
+{
+    const auto slot = _slots.find( edgeItem );
+    if ( slot == _slots.end() )
+        return;
+    releaseSlot( *slot );
+    _slots.erase( slot );
+    disconnect( edgeItem, nullptr, this, nullptr );
+    emit edgeCountChanged();
+}
+
+void    EdgeRenderer::invalidateEdge( qan::EdgeItem* edgeItem ) noexcept
+{
+    const auto slot = _slots.find( edgeItem );
+    if ( slot == _slots.end() )
+        return;
+    const auto style = edgeItem->getStyle();
+    if ( style != nullptr &&
+         !_styles.contains( style ) ) {
+        _styles.insert( style );
+        connect( style, &qan::EdgeStyle::styleModified,
+                 this,  &EdgeRenderer::invalidateEdges );
+        connect( style, &QObject::destroyed,
+                 this,  [this, style]() { _styles.remove( style ); } );
+    }
+    const auto kind = edgeKind( *edgeItem );
+    if ( kind != slot->kind ||      // Line type or route length has changed: move edge to slots with the right vertex count
+         slotCount( kind, *edgeItem ) != 1 + static_cast<int>( slot->continuations.size() ) ) {
+        releaseSlot( *slot );
+        *slot = allocateSlot( kind, edgeItem );
+    }
+    markDirty( *slot );
+}
+
+void    EdgeRenderer::invalidateEdges() noexcept
+{
+    for ( auto edgeItem = _slots.keyBegin(); edgeItem != _slots.keyEnd(); ++edgeItem )
+        invalidateEdge( *edgeItem );
+}
+
+EdgeRenderer::Kind  EdgeRenderer::edgeKind( const qan::EdgeItem& edgeItem ) noexcept
+{
+    switch ( edgeItem.getLineType() ) {
+    case qan::EdgeStyle::LineType::Curved:  return Curved;
+    case qan::EdgeStyle::LineType::Ortho:   return Ortho;
+    default:                                return Straight;
+    }
+}
+
+int     EdgeRenderer::slotCount( Kind kind, const qan::EdgeItem& edgeItem ) noexcept
+{
+    if ( kind != Ortho )
+        return 1;
+    const int segmentCount = edgeItem.getRoute().size() - 1;
+    return std::max( 1, ( segmentCount + RouteSegments - 1 ) / RouteSegments );
+}
+
+EdgeRenderer::Slot  EdgeRenderer::allocateSlot( Kind kind, qan::EdgeItem* edgeItem ) noexcept
+{
+    Slot slot;
+    slot.kind = kind;
+    slot.index = allocateSlotIndex( kind, edgeItem, 0 );
+    const int count = edgeItem != nullptr ? slotCount( kind, *edgeItem ) : 1;
+    for ( int part = 1; part < count; ++part )
+        slot.continuations.push_back( allocateSlotIndex( kind, edgeItem, part ) );
+    return slot;
+}
+
+int     EdgeRenderer::allocateSlotIndex( Kind kind, qan::EdgeItem* edgeItem, int part ) noexcept
+{
+    auto& kindSlots = _kindSlots[kind];
+    int index = -1;
+    if ( !kindSlots.freeSlots.empty() ) {
+        index = kindSlots.freeSlots.back();
+        kindSlots.freeSlots.pop_back();
+        kindSlots.items[index] = edgeItem;
+        kindSlots.parts[index] = part;
+    } else {
+        index = static_cast<int>( kindSlots.items.size() );
+        kindSlots.items.emplace_back( edgeItem );
+        kindSlots.parts.push_back( part );
+        kindSlots.dirtyFlags.push_back( false );
+    }
+    return index;
+}
+
+void    EdgeRenderer::releaseSlot( const Slot& slot ) noexcept
+{
+    auto& kindSlots = _kindSlots[slot.kind];
+    const auto release = [this, &kindSlots, &slot]( int index ) {
+        kindSlots.items[index] = nullptr;
+        kindSlots.parts[index] = 0;
+        kindSlots.freeSlots.push_back( index );
+        markDirty( slot.kind, index );  // Collapse slot vertices
+    };
+    release( slot.index );
+    for ( const auto index : slot.continuations )
+        release( index );
+}
+
+void    EdgeRenderer::markDirty( const Slot& slot ) noexcept
+{
+    markDirty( slot.kind, slot.index );
+    for ( const auto index : slot.continuations )
+        markDirty( slot.kind, index );
+}
+
+void    EdgeRenderer::markDirty( Kind kind, int index ) noexcept
+{
+    auto& kindSlots = _kindSlots[kind];
+    if ( !kindSlots.dirtyFlags[index] ) {
+        kindSlots.dirtyFlags[index] = true;
+        kindSlots.dirtySlots.push_back( index );
+        polish();
+        update();
+    }
+}
+//-----------------------------------------------------------------------------
+
+/* Scene Graph Management *///-------------------------------------------------
+void    EdgeRenderer::updatePolish()
+{
+    QQuickItem::updatePolish();
+    // Edges are drawn above their end points (see qan::EdgeItem::generateGeometryCache()), renderer must be above all its edges
+    qreal maxZ = z();
+    for ( const auto& kindSlots : _kindSlots )
+        for ( const auto slotIndex : kindSlots.dirtySlots ) {
+            const auto edgeItem = kindSlots.items[slotIndex].data();
+            if ( edgeItem != nullptr )
+                maxZ = std::max( maxZ, edgeItem->z() );
+        }
+    if ( maxZ > z() )
+        setZ( maxZ );
+}
+
+int     EdgeRenderer::slotVertexCount( Kind kind ) noexcept
+{
+    const int segmentCount = kind == Curved ? CurveSegments :
+                             kind == Ortho  ? RouteSegments : 1;
+    return segmentCount * 6 + 3;    // Two triangles per line segment, one triangle for arrow
+}
+
+QSGNode*    EdgeRenderer::updatePaintNode( QSGNode* oldNode, UpdatePaintNodeData* )
+{
+    auto root = oldNode;
+    if ( root == nullptr ) {    // First frame or scene graph invalidation: all chunks are created again
+        root = new QSGNode{};
+        for ( int kind = 0; kind < KindCount; ++kind ) {
+            _chunkNodes[kind].clear();
+            auto& kindSlots = _kindSlots[kind];
+            kindSlots.dirtySlots.clear();
+            for ( int s = 0; s < static_cast<int>( kindSlots.items.size() ); ++s ) {
+                kindSlots.dirtyFlags[s] = true;
+                kindSlots.dirtySlots.push_back( s );
+            }
+        }
+    }
+
+    for ( int k = 0; k < KindCount; ++k ) {
+        const auto kind = static_cast<Kind>( k );
+        auto& kindSlots = _kindSlots[kind];
+        auto& chunkNodes = _chunkNodes[kind];
+        const int vertexCount = slotVertexCount( kind );
+
+        // Chunks are never removed, released slots are reused
+        const auto chunkCount = ( kindSlots.items.size() + ChunkCapacity - 1 ) / ChunkCapacity;
+        while ( chunkNodes.size() < chunkCount ) {
+            auto geometry = new QSGGeometry{ QSGGeometry::defaultAttributes_ColoredPoint2D(), ChunkCapacity * vertexCount };
+            geometry->setDrawingMode( QSGGeometry::DrawTriangles );
+            const auto vertices = geometry->vertexDataAsColoredPoint2D();
+            for ( int v = 0; v < geometry->vertexCount(); ++v )     // Collapse all chunk slots
+                vertices[v].set( 0.f, 0.f, 0, 0, 0, 0 );
+            auto chunkNode = new QSGGeometryNode{};
+            chunkNode->setGeometry( geometry );
+            chunkNode->setFlag( QSGNode::OwnsGeometry );
+            chunkNode->setMaterial( new QSGVertexColorMaterial{} );
+            chunkNode->setFlag( QSGNode::OwnsMaterial );
+            root->appendChildNode( chunkNode );
+            chunkNodes.push_back( chunkNode );
+        }
+
+        std::vector<bool> dirtyChunks( chunkNodes.size(), false );
+        for ( const auto slotIndex : kindSlots.dirtySlots ) {
+            const auto chunk = static_cast<std::size_t>( slotIndex / ChunkCapacity );
+            const auto vertices = chunkNodes[chunk]->geometry()->vertexDataAsColoredPoint2D() +
+                                  ( slotIndex % ChunkCapacity ) * vertexCount;
+            writeSlot( vertices, kind, kindSlots.items[slotIndex].data(), kindSlots.parts[slotIndex] );
+            kindSlots.dirtyFlags[slotIndex] = false;
+            dirtyChunks[chunk] = true;
+        }
+        kindSlots.dirtySlots.clear();
+        for ( std::size_t chunk = 0; chunk < chunkNodes.size(); ++chunk )
+            if ( dirtyChunks[chunk] )
+                chunkNodes[chunk]->markDirty( QSGNode::DirtyGeometry );
+    }
+    return root;
+}
+
+void    EdgeRenderer::writeSlot( QSGGeometry::ColoredPoint2D* vertices, Kind kind,
+                                     const qan::EdgeItem* edgeItem, int part ) const noexcept
+{
+    const int vertexCount = slotVertexCount( kind );
+    if ( edgeItem == nullptr ||
+         !edgeItem->isVisible() ||
+         edgeItem->getHidden() ) {
+        for ( int v = 0; v < vertexCount; ++v )     // Degenerated triangles are not rasterized
+            vertices[v].set( 0.f, 0.f, 0, 0, 0, 0 );
+        return;
+    }
+
+    // Edge geometry is expressed in edge item CS
+    const QPointF origin = edgeItem->parentItem() == parentItem() ? edgeItem->position() - position() :
+                                                                    edgeItem->mapToItem( this, QPointF{ 0., 0. } );
+    const auto style = edgeItem->getStyle();
+    const QColor color = style != nullptr ? style->getLineColor() : QColor{ Qt::black };
+    const float halfWidth = static_cast<float>( style != nullptr ? style->getLineWidth() : 2. ) / 2.f;
+    const auto alpha = color.alpha();   // Vertex color material use premultiplied colors
+    const auto r = static_cast<uchar>( color.red() * alpha / 255 );
+    const auto g = static_cast<uchar>( color.green() * alpha / 255 );
+    const auto b = static_cast<uchar>( color.blue() * alpha / 255 );
+    const auto a = static_cast<uchar>( alpha );
+
+    const QPointF p1 = origin + edgeItem->getP1();
+    const QPointF p2 = origin + edgeItem->getP2();
+    auto vertex = vertices;
+    const auto appendSegment = [&vertex, halfWidth, r, g, b, a]( const QPointF& s, const QPointF& e ) {
+        float nx = static_cast<float>( s.y() - e.y() );     // Segment normal
+        float ny = static_cast<float>( e.x() - s.x() );
+        const float length = std::sqrt( nx * nx + ny * ny );
+        if ( length > 0.0001f ) {
+            nx *= halfWidth / length;
+            ny *= halfWidth / length;
+        } else
+            nx = ny = 0.f;
+        const float sx = static_cast<float>( s.x() ), sy = static_cast<float>( s.y() );
+        const float ex = static_cast<float>( e.x() ), ey = static_cast<float>( e.y() );
+        ( vertex++ )->set( sx + nx, sy + ny, r, g, b, a );
+        ( vertex++ )->set( sx - nx, sy - ny, r, g, b, a );
+        ( vertex++ )->set( ex + nx, ey + ny, r, g, b, a );
+        ( vertex++ )->set( ex + nx, ey + ny, r, g, b, a );
+        ( vertex++ )->set( sx - nx, sy - ny, r, g, b, a );
+        ( vertex++ )->set( ex - nx, ey - ny, r, g, b, a );
+    };
+    if ( kind == Curved ) {     // Tessellate cubic bezier curve
+        const QPointF c1 = origin + edgeItem->getC1();
+        const QPointF c2 = origin + edgeItem->getC2();
+        QPointF previous = p1;
+        for ( int s = 1; s <= CurveSegments; ++s ) {
+            const qreal t = static_cast<qreal>( s ) / CurveSegments;
+            const qreal u = 1. - t;
+            const QPointF current = u * u * u * p1 + 3. * u * u * t * c1 + 3. * u * t * t * c2 + t * t * t * p2;
+            appendSegment( previous, current );
+            previous = current;
+        }
+    } else if ( kind == Ortho ) {   // Draw route polyline part, unused segments are collapsed
+        const auto& route = edgeItem->getRoute();
+        int segmentCount = 0;
+        if ( route.size() >= 2 ) {
+            const int last = route.size() - 1;
+            for ( int s = part * RouteSegments + 1; s <= last && segmentCount < RouteSegments; ++s, ++segmentCount )
+                appendSegment( origin + route[s - 1], origin + route[s] );
+        } else if ( part == 0 ) {   // Edge has not been routed yet
+            appendSegment( p1, p2 );
+            segmentCount = 1;
+        }
+        for ( ; segmentCount < RouteSegments; ++segmentCount )
+            for ( int v = 0; v < 6; ++v )
+                ( vertex++ )->set( 0.f, 0.f, 0, 0, 0, 0 );
+    } else
+        appendSegment( p1, p2 );
+
+    const auto graph = edgeItem->getGraph();
+    if ( part > 0 ||        // Arrow is drawn with the first part of a route
+         ( graph != nullptr &&
+           !graph->getLod()->getShowArrows() ) ) {   // Collapse arrow triangle
+        for ( int v = 0; v < 3; ++v )
+            ( vertex++ )->set( 0.f, 0.f, 0, 0, 0, 0 );
+        return;
+    }
+
+    // Destination arrow is expressed in an arrow CS rotated by dstAngle around p2 (see EdgeTemplate.qml)
+    const qreal angle = qDegreesToRadians( edgeItem->getDstAngle() );
+    const qreal cosAngle = std::cos( angle );
+    const qreal sinAngle = std::sin( angle );
+    const auto appendArrowPoint = [&vertex, &p2, cosAngle, sinAngle, r, g, b, a]( const QPointF& p ) {
+        ( vertex++ )->set( static_cast<float>( p2.x() + p.x() * cosAngle - p.y() * sinAngle ),
+                           static_cast<float>( p2.y() + p.x() * sinAngle + p.y() * cosAngle ),
+                           r, g, b, a );
+    };
+    appendArrowPoint( edgeItem->getDstA1() );
+    appendArrowPoint( edgeItem->getDstA3() );
+    appendArrowPoint( edgeItem->getDstA2() );
+}
+//-----------------------------------------------------------------------------
+
+} // ::qan
@@ -0,0 +1,195 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the QuickQanava software library.
+//
+// \file	qanEdgeRenderer.h
+// \author	benoit@destrat.io
+// \date	2017 12 18
+//-----------------------------------------------------------------------------
+
+#ifndef qanEdgeRenderer_h
+#define qanEdgeRenderer_h
+
+// Std headers
+#include <vector>
+
+// Qt headers
+#include <QQuickItem>
+#include <QPointer>
+#include <QHash>
+#include <QSet>
+#include <QSGNode>
+#include <QSGGeometry>
+
+namespace qan { // ::qan
+
+class EdgeItem;
+class EdgeStyle;
+
+/*! \brief Draw lines and arrows of many edge items in a few batched scene graph geometry nodes.
+ *
+ * Registered edge items keep handling interactions (and hit testing), but should have no visual
+ * content (see BatchedEdge.qml): their straight or curved line and destination arrow are drawn
+ * by this item from edge item geometry (\c p1, \c p2, \c c1, \c c2, \c dstA1, \c dstA2, \c dstA3 and \c dstAngle)
+ * and style \c lineColor and \c lineWidth.
+ *
+ * Every edge owns a fixed size vertex sub range in a shared chunk vertex buffer: when an edge is modified,
+ * only its sub range is rewritten and only its chunk geometry is uploaded again. Lines are expanded to
+ * triangles, so that all edges are drawn with a single vertex color material whatever their color and width.
+ *
+ * \note Dashed line styles are drawn as solid lines, use a custom edge delegate for dashed edges.
+ * \sa qan::Graph::batchedEdges
+ */
+class EdgeRenderer : public QQuickItem
+{
+    /*! \name EdgeRenderer Object Management *///------------------------------
+    //@{
+    Q_OBJECT
+public:
+    explicit EdgeRenderer( QQuickItem* parent = nullptr );
+    virtual ~EdgeRenderer() override;
+    EdgeRenderer( const EdgeRenderer& ) = delete;
+    EdgeRenderer& operator=( const EdgeRenderer& ) = delete;
+    EdgeRenderer( EdgeRenderer&& ) = delete;
+    EdgeRenderer& operator=( EdgeRenderer&& ) = delete;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Edge Registration Management *///--------------------------------
+    //@{
+public:
+    //! Draw \c edgeItem line and arrow with this renderer (no-op if \c edgeItem is already registered).
+    void            addEdge( qan::EdgeItem* edgeItem ) noexcept;
+    //! Stop drawing \c edgeItem (called automatically when \c edgeItem is destroyed).
+    void            removeEdge( qan::EdgeItem* edgeItem ) noexcept;
+    //! Return true if \c edgeItem is drawn by this renderer.
+    inline bool     hasEdge( qan::EdgeItem* edgeItem ) const noexcept { return _slots.contains( edgeItem ); }
+
+    //! Number of edges drawn by this renderer (read only).
+    Q_PROPERTY( int edgeCount READ getEdgeCount NOTIFY edgeCountChanged FINAL )
+    //! \copydoc edgeCount
+    inline int      getEdgeCount() const noexcept { return _slots.size(); }
+signals:
+    //! \copydoc edgeCount
+    void            edgeCountChanged();
+
+public:
+    //! Mark \c edgeItem geometry as dirty, its vertices are updated before next frame.
+    void            invalidateEdge( qan::EdgeItem* edgeItem ) noexcept;
+    //! Mark all registered edges as dirty (used when an edge style is modified).
+    void            invalidateEdges() noexcept;
+
+private:
+    //! Edge line type, every kind has its own chunks (with a fixed slot size).
+    enum Kind : int {
+        Straight    = 0,
+        Curved      = 1,
+        Ortho       = 2,
+        KindCount   = 3
+    };
+    /*! \brief Location of an edge vertices in kind chunks.
+     *
+     * Routes with more than RouteSegments segments are drawn in \c index slot followed by \c continuations slots,
+     * each continuation slot draw the next RouteSegments segments of the route.
+     */
+    struct Slot {
+        Kind                kind{ Straight };
+        int                 index{ -1 };
+        std::vector<int>    continuations;
+    };
+    //! Registered edge items indexed by slot, a nullptr item mark a free slot.
+    struct KindSlots {
+        std::vector<QPointer<qan::EdgeItem>>    items;
+        //! Part of edge route drawn in slot (0 for the main slot, 1 for the first continuation slot, etc.).
+        std::vector<int>                        parts;
+        std::vector<int>                        freeSlots;
+        //! Dirty slot indexes (with no duplicates, see \c dirtyFlags), processed in updatePaintNode().
+        std::vector<int>                        dirtySlots;
+        std::vector<bool>                       dirtyFlags;
+    };
+
+    //! Return \c edgeItem current line kind.
+    static Kind     edgeKind( const qan::EdgeItem& edgeItem ) noexcept;
+    //! Return the number of \c kind slots necessary to draw \c edgeItem (more than one for long routes).
+    static int      slotCount( Kind kind, const qan::EdgeItem& edgeItem ) noexcept;
+    //! Allocate \c kind slots for \c edgeItem (with continuation slots for long routes).
+    Slot            allocateSlot( Kind kind, qan::EdgeItem* edgeItem ) noexcept;
+    //! Allocate a single \c kind slot drawing \c part of \c edgeItem and return its index.
+    int             allocateSlotIndex( Kind kind, qan::EdgeItem* edgeItem, int part ) noexcept;
+    //! Release \c slot, its vertices are collapsed on next update.
+    void            releaseSlot( const Slot& slot ) noexcept;
+    //! Mark \c slot for update and schedule a new frame.
+    void            markDirty( const Slot& slot ) noexcept;
+    //! Mark \c kind slot \c index for update and schedule a new frame.
+    void            markDirty( Kind kind, int index ) noexcept;
+
+    //! Edge items slots.
+    QHash<qan::EdgeItem*, Slot> _slots;
+    KindSlots                   _kindSlots[KindCount];
+    //! Edge styles whose modifications are monitored (shared by many edges).
+    QSet<qan::EdgeStyle*>       _styles;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Scene Graph Management *///--------------------------------------
+    //@{
+public:
+    //! Maximum number of edges in a chunk geometry node.
+    static constexpr int    ChunkCapacity = 1024;
+    //! Number of line segments used to tessellate curved edges.
+    static constexpr int    CurveSegments = 16;
+    //! Number of line segments of orthogonal and bundled edges routes drawn in a slot (longer routes use continuation slots).
+    static constexpr int    RouteSegments = 16;
+
+protected:
+    //! Keep renderer above registered edges z and check edge kind changes before the scene graph is synchronized.
+    virtual void        updatePolish() override;
+    virtual QSGNode*    updatePaintNode( QSGNode* oldNode, UpdatePaintNodeData* ) override;
+private:
+    //! Number of vertices of a \c kind slot (line segments quads and arrow triangle).
+    static int          slotVertexCount( Kind kind ) noexcept;
+    /*! \brief Write \c edgeItem triangles in \c vertices (collapse them if \c edgeItem is nullptr or hidden).
+     *
+     * Route edges \c part > 0 draw route segments following the ones drawn by previous part, with no arrow.
+     */
+    void                writeSlot( QSGGeometry::ColoredPoint2D* vertices, Kind kind,
+                                   const qan::EdgeItem* edgeItem, int part ) const noexcept;
+
+    //! Chunk geometry nodes (owned by scene graph root node), only accessed from updatePaintNode().
+    std::vector<QSGGeometryNode*>   _chunkNodes[KindCount];
+    //! Set when root node has to be (re)built, for example after a scene graph invalidation.
+    bool                            _rebuildNodes{ true };
+    //@}
+    //-------------------------------------------------------------------------
+};
+
+} // ::qan
+
+QML_DECLARE_TYPE( qan::EdgeRenderer )
+
+#endif // qanEdgeRenderer_h
@@ -0,0 +1,257 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the QuickQanava software library.
+//
+// \file	qanForceDirectedLayout.cpp
+// \author	benoit@destrat.io
+// \date	2017 12 22
+//-----------------------------------------------------------------------------
+
+// Std headers
+#include <cmath>        // std::sqrt()
+#include <random>
+#include <limits>
+
+// Qt headers
+#include <QHash>
+
+// GTpo headers
+#include <gtpoForceLayout.h>
+
+// QuickQanava headers
+#include "./qanForceDirectedLayout.h"
+#include "./qanNodeItem.h"
+
+namespace qan { // ::qan
+
+/* ForceDirectedLayout Object Management *///----------------------------------
+ForceDirectedLayout::ForceDirectedLayout( QObject* parent ) :
+    qan::AbstractLayout{ parent },
+    _layout{ std::make_unique<gtpo::ForceLayout>() }
+{
+    _updateTimer.setInterval( _updateInterval );
+    connect( &_updateTimer, &QTimer::timeout, this, [this]() {
+        std::unique_lock<std::mutex> lock{ _publishedMutex };
+        if ( _published ) {
+            lock.unlock();
+            applyLayout();
+        }
+    } );
+    connect( this, &AbstractLayout::runningChanged, this, [this]() {
+        if ( !getRunning() )
+            _updateTimer.stop();
+    } );
+}
+
+ForceDirectedLayout::~ForceDirectedLayout()
+{
+    cancel();
+}
+//-----------------------------------------------------------------------------
+
+/* Layout Configuration *///---------------------------------------------------
+void    ForceDirectedLayout::setIdealEdgeLength( qreal idealEdgeLength ) noexcept
+{
+    if ( idealEdgeLength <= 0. ) {
+        qWarning() << "qan::ForceDirectedLayout::setIdealEdgeLength(): Error: ideal edge length must be strictly positive.";
+        return;
+    }
+    if ( !qFuzzyCompare( 1. + idealEdgeLength, 1. + _idealEdgeLength ) ) {
+        _idealEdgeLength = idealEdgeLength;
+        emit idealEdgeLengthChanged();
+    }
+}
+
+void    ForceDirectedLayout::setTheta( qreal theta ) noexcept
+{
+    theta = std::max( 0., theta );
+    if ( !qFuzzyCompare( 1. + theta, 1. + _theta ) ) {
+        _theta = theta;
+        emit thetaChanged();
+    }
+}
+
+void    ForceDirectedLayout::setMaxIterations( int maxIterations ) noexcept
+{
+    maxIterations = std::max( 1, maxIterations );
+    if ( maxIterations != _maxIterations ) {
+        _maxIterations = maxIterations;
+        emit maxIterationsChanged();
+    }
+}
+
+void    ForceDirectedLayout::setUpdateInterval( int updateInterval ) noexcept
+{
+    updateInterval = std::max( 1, updateInterval );
+    if ( updateInterval != _updateInterval ) {
+        _updateInterval = updateInterval;
+        _updateTimer.setInterval( _updateInterval );
+        emit updateIntervalChanged();
+    }
+}
+//-----------------------------------------------------------------------------
+
+/* Pinned Nodes Management *///------------------------------------------------
+void    ForceDirectedLayout::setPinned( qan::Node* node, bool pinned ) noexcept
+{
+    if ( node == nullptr )
+        return;
+    if ( pinned &&
+         !_pinned.contains( node ) ) {
+        _pinned.insert( node );
+        connect( node, &QObject::destroyed, this, [this, node]() { _pinned.remove( node ); } );
+    } else if ( !pinned &&
+                _pinned.remove( node ) )
+        disconnect( node, &QObject::destroyed, this, nullptr );
+}
+
+bool    ForceDirectedLayout::isPinned( qan::Node* node ) const noexcept
+{
+    return node != nullptr && _pinned.contains( node );
+}
+
+void    ForceDirectedLayout::clearPinned() noexcept
+{
+    for ( const auto node : _pinned )
+        disconnect( node, &QObject::destroyed, this, nullptr );
+    _pinned.clear();
+}
+//-----------------------------------------------------------------------------
+
+/* Layout Management *///------------------------------------------------------
+bool    ForceDirectedLayout::start()
+{
+    return launch( false );
+}
+
+bool    ForceDirectedLayout::restart()
+{
+    return launch( true );
+}
+
+void    ForceDirectedLayout::stop()
+{
+    cancel();
+}
+
+bool    ForceDirectedLayout::launch( bool incremental )
+{
+    if ( !_graph ) {
+        qWarning() << "qan::ForceDirectedLayout::launch(): Error: No target graph.";
+        return false;
+    }
+    cancel();
+
+    // Snapshot graph topology in GUI thread: ungrouped nodes centers and edges between them
+    auto& layout = *_layout;
+    layout.clear();
+    const auto nodeIndexes = snapshotNodes( [this, &layout]( const qan::Node& node, const QRectF& geometry ) {
+        const auto nodeItem = node.getItem();
+        const bool pinned = _pinned.contains( &node ) ||
+                            ( nodeItem != nullptr && nodeItem->getDragged() );
+        return layout.addNode( geometry.center().x(), geometry.center().y(), pinned );
+    } );
+    for ( const auto& edge : _graph->getEdges() ) {
+        if ( !edge )
+            continue;
+        const auto src = nodeIndexes.constFind( edge->getSrc().lock().get() );
+        const auto dst = nodeIndexes.constFind( edge->getDst().lock().get() );     // Null for hyper edges
+        if ( src != nodeIndexes.constEnd() &&
+             dst != nodeIndexes.constEnd() &&
+             src.value() != dst.value() )
+            layout.addEdge( src.value(), dst.value(), std::max( 0., edge->getWeight() ) );
+    }
+
+    const double k = _idealEdgeLength;
+    const auto nodeCount = layout.getNodeCount();
+    layout.idealLength = k;
+    layout.theta = _theta;
+    if ( incremental )
+        layout.setTemperature( k / 4. );
+    else {
+        // Nodes created without a position (ie all in a k wide square) are randomly scattered
+        double minX = std::numeric_limits<double>::max(), maxX = std::numeric_limits<double>::lowest();
+        double minY = minX, maxY = maxX;
+        for ( std::size_t n = 0; n < nodeCount; ++n ) {
+            minX = std::min( minX, layout.x[n] );   maxX = std::max( maxX, layout.x[n] );
+            minY = std::min( minY, layout.y[n] );   maxY = std::max( maxY, layout.y[n] );
+        }
+        const double side = k * std::sqrt( static_cast<double>( nodeCount ) );
+        if ( nodeCount > 1 &&
+             maxX - minX < k && maxY - minY < k ) {
+            std::mt19937 generator{ 42 };
+            std::uniform_real_distribution<double> position{ 0., side };
+            for ( std::size_t n = 0; n < nodeCount; ++n ) {
+                if ( layout.pinned[n] != 0 )
+                    continue;
+                layout.x[n] = minX + position( generator );
+                layout.y[n] = minY + position( generator );
+            }
+        }
+        layout.setTemperature( std::max( k, side / 4. ) );
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{ _publishedMutex };
+        _published = false;
+    }
+    const int maxIterations = _maxIterations;
+    run( [this, maxIterations]() {
+        auto& layout = *_layout;
+        for ( int i = 0; i < maxIterations && !isCanceled(); ++i ) {
+            const bool converging = layout.step();
+            {   // Publish positions, copy assignment reuse published vectors memory
+                std::lock_guard<std::mutex> lock{ _publishedMutex };
+                _publishedX = layout.x;
+                _publishedY = layout.y;
+                _published = true;
+            }
+            if ( !converging )
+                break;
+        }
+    } );
+    _updateTimer.start();
+    return true;
+}
+
+void    ForceDirectedLayout::apply()
+{
+    {
+        std::lock_guard<std::mutex> lock{ _publishedMutex };
+        if ( !_published )
+            return;
+        _publishedX.swap( _appliedX );
+        _publishedY.swap( _appliedY );
+        _published = false;
+    }
+    moveNodes( _appliedX, _appliedY );
+}
+//-----------------------------------------------------------------------------
+
+} // ::qan
+
@@ -0,0 +1,213 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the QuickQanava software library.
+//
+// \file	qanForceDirectedLayout.h
+// \author	benoit@destrat.io
+// \date	2017 12 22
+//-----------------------------------------------------------------------------
+
+#ifndef qanForceDirectedLayout_h
+#define qanForceDirectedLayout_h
+
+// Std headers
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Qt headers
+#include <QObject>
+#include <QTimer>
+#include <QSet>
+
+// QuickQanava headers
+#include "./qanAbstractLayout.h"
+
+namespace gtpo {
+class ForceLayout;
+}
+
+namespace qan { // ::qan
+
+/*! \brief Background force directed layout (Fruchterman-Reingold with a Barnes-Hut approximation) for qan::Graph.
+ *
+ * When layout is started, graph topology and node positions are copied in a gtpo::ForceLayout snapshot that is
+ * run in a worker thread, graph could then be edited while the layout is running. Intermediate positions are
+ * streamed back to graph nodes every \c updateInterval ms in a single geometry update (see
+ * qan::Graph::beginGeometryUpdate()), positions are applied with qan::Node::setGeometry() so that nodes without
+ * visual item (virtualized or topology only graphs) are laid out too.
+ *
+ * \li start() compute a complete layout, nodes with coincident positions (for example nodes loaded with
+ * qan::EdgeListLoader) are first scattered randomly.
+ * \li restart() should be called after graph edition: layout is restarted from current node positions with a
+ * low temperature to preserve existing layout.
+ * \li Pinned nodes (see setPinned()) and nodes actually dragged by user are never moved.
+ *
+ * \code
+ *  Qan.ForceDirectedLayout {
+ *    id: forceLayout
+ *    graph: graphView.graph
+ *    onFinished: graphView.fitInView()
+ *  }
+ *  // forceLayout.start()
+ * \endcode
+ *
+ * \note Grouped nodes and hyper edges are actually ignored.
+ */
+class ForceDirectedLayout : public qan::AbstractLayout
+{
+    /*! \name ForceDirectedLayout Object Management *///-----------------------
+    //@{
+    Q_OBJECT
+public:
+    explicit ForceDirectedLayout( QObject* parent = nullptr );
+    virtual ~ForceDirectedLayout();
+    ForceDirectedLayout( const ForceDirectedLayout& ) = delete;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Layout Configuration *///----------------------------------------
+    //@{
+public:
+    //! Ideal distance between two connected node centers (default to 150.).
+    Q_PROPERTY( qreal idealEdgeLength READ getIdealEdgeLength WRITE setIdealEdgeLength NOTIFY idealEdgeLengthChanged FINAL )
+    //! \copydoc idealEdgeLength
+    inline qreal    getIdealEdgeLength() const noexcept { return _idealEdgeLength; }
+    //! \copydoc idealEdgeLength
+    void            setIdealEdgeLength( qreal idealEdgeLength ) noexcept;
+private:
+    //! \copydoc idealEdgeLength
+    qreal           _idealEdgeLength{ 150. };
+signals:
+    //! \copydoc idealEdgeLength
+    void            idealEdgeLengthChanged();
+
+public:
+    //! Barnes-Hut approximation opening angle, lower values are slower but more accurate (default to 0.9).
+    Q_PROPERTY( qreal theta READ getTheta WRITE setTheta NOTIFY thetaChanged FINAL )
+    //! \copydoc theta
+    inline qreal    getTheta() const noexcept { return _theta; }
+    //! \copydoc theta
+    void            setTheta( qreal theta ) noexcept;
+private:
+    //! \copydoc theta
+    qreal           _theta{ 0.9 };
+signals:
+    //! \copydoc theta
+    void            thetaChanged();
+
+public:
+    //! Maximum number of layout iterations (default to 1000).
+    Q_PROPERTY( int maxIterations READ getMaxIterations WRITE setMaxIterations NOTIFY maxIterationsChanged FINAL )
+    //! \copydoc maxIterations
+    inline int      getMaxIterations() const noexcept { return _maxIterations; }
+    //! \copydoc maxIterations
+    void            setMaxIterations( int maxIterations ) noexcept;
+private:
+    //! \copydoc maxIterations
+    int             _maxIterations{ 1000 };
+signals:
+    //! \copydoc maxIterations
+    void            maxIterationsChanged();
+
+public:
+    //! Minimum delay between two node position updates in ms (default to 33ms, ie 30Hz).
+    Q_PROPERTY( int updateInterval READ getUpdateInterval WRITE setUpdateInterval NOTIFY updateIntervalChanged FINAL )
+    //! \copydoc updateInterval
+    inline int      getUpdateInterval() const noexcept { return _updateInterval; }
+    //! \copydoc updateInterval
+    void            setUpdateInterval( int updateInterval ) noexcept;
+private:
+    //! \copydoc updateInterval
+    int             _updateInterval{ 33 };
+signals:
+    //! \copydoc updateInterval
+    void            updateIntervalChanged();
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Pinned Nodes Management *///-------------------------------------
+    //@{
+public:
+    //! Pin (or unpin) \c node, pinned nodes are never moved by layout (modification apply on next start() or restart()).
+    Q_INVOKABLE void    setPinned( qan::Node* node, bool pinned = true ) noexcept;
+    //! Return true if \c node has been pinned with setPinned().
+    Q_INVOKABLE bool    isPinned( qan::Node* node ) const noexcept;
+    //! Unpin all nodes.
+    Q_INVOKABLE void    clearPinned() noexcept;
+private:
+    QSet<const qan::Node*>  _pinned;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Layout Management *///-------------------------------------------
+    //@{
+public:
+    /*! \brief Start a complete layout of \c graph in background.
+     *
+     * A running layout is stopped first.
+     * \return false if there is no target graph.
+     */
+    Q_INVOKABLE bool    start();
+    /*! \brief Incremental layout: restart layout from current node positions with a low initial temperature.
+     *
+     * Call restart() after nodes or edges have been inserted or removed, a running layout is stopped first.
+     * \return false if there is no target graph.
+     */
+    Q_INVOKABLE bool    restart();
+    //! Stop a running layout, nodes keep their last streamed positions (same as cancel()).
+    Q_INVOKABLE void    stop();
+
+protected:
+    //! Apply last positions published by layout worker to graph nodes.
+    virtual void    apply() override;
+
+private:
+    //! Snapshot graph topology and start a background layout, \c incremental layouts start with a low temperature.
+    bool            launch( bool incremental );
+
+private:
+    //! Layout snapshot, accessed only from the worker thread while layout is running.
+    std::unique_ptr<gtpo::ForceLayout>  _layout;
+    //! Positions published by worker thread (protected by _publishedMutex).
+    std::vector<double>     _publishedX, _publishedY;
+    bool                    _published{ false };
+    std::mutex              _publishedMutex;
+    //! Positions actually applied to nodes (GUI thread).
+    std::vector<double>     _appliedX, _appliedY;
+    QTimer                  _updateTimer;
+    //@}
+    //-------------------------------------------------------------------------
+};
+
+} // ::qan
+
+QML_DECLARE_TYPE( qan::ForceDirectedLayout )
+
+#endif // qanForceDirectedLayout_h
+
@@ -0,0 +1,123 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the QuickQanava software library.
+//
+// \file	qanForwardingBehaviour.h
+// \author	benoit@destrat.io
+// \date	2017 12 31
+//-----------------------------------------------------------------------------
+
+#ifndef qanForwardingBehaviour_h
+#define qanForwardingBehaviour_h
+
+// Std headers
+#include <memory>
+#include <vector>
+
+// Qt headers
+#include <QObject>
+#include <QPointer>
+
+// GTpo headers
+#include "../GTpo/src/gtpoGraphBehaviour.h"
+
+// QuickQanava headers
+#include "./qanGraphConfig.h"
+#include "./qanGraph.h"
+
+namespace qan { // ::qan
+
+/*! \brief Forward \c graph node and edge insertions and removals to a \c Target QObject (a layout, a router, etc.).
+ *
+ * \c Target must provide nodeInserted(), nodeRemoved(), edgeInserted() and edgeRemoved() methods taking a
+ * primitive pointer (they might be private if \c Target is a friend of ForwardingBehaviour<Target>).
+ *
+ * Behaviour is owned by graph and target keep no pointer on it: a behaviour is found again with its target in
+ * uninstall(), and a destroyed target is never notified. Graph behaviours are destroyed by qan::Graph::clear(),
+ * targets must call install() again on qan::Graph::cleared().
+ *
+ * \code
+ *   // In Target::setGraph( qan::Graph* graph ):
+ *   if ( _graph ) qan::ForwardingBehaviour<Target>::uninstall( *_graph, this );
+ *   _graph = graph;
+ *   if ( _graph ) qan::ForwardingBehaviour<Target>::install( *_graph, this );
+ * \endcode
+ */
+template < class Target >
+class ForwardingBehaviour : public gtpo::GraphBehaviour< qan::GraphConfig >
+{
+public:
+    explicit ForwardingBehaviour( Target* target ) noexcept : _target{ target } { }
+    virtual ~ForwardingBehaviour() { }
+    ForwardingBehaviour( const ForwardingBehaviour& ) = delete;
+
+    //! Return behaviour target, nullptr if target has been destroyed.
+    inline Target*  getTarget() const noexcept { return _target.data(); }
+
+    //! Install a behaviour forwarding \c graph modifications to \c target (a behaviour already installed for \c target is replaced).
+    static void     install( qan::Graph& graph, Target* target ) noexcept {
+        if ( target == nullptr )
+            return;
+        uninstall( graph, target );
+        graph.addGraphBehaviour( std::make_unique<ForwardingBehaviour<Target>>( target ) );
+    }
+
+    //! Remove and destroy behaviours forwarding \c graph modifications to \c target, behaviours of destroyed targets are removed too.
+    static void     uninstall( qan::Graph& graph, const Target* target ) noexcept {
+        std::vector<const gtpo::GraphBehaviour< qan::GraphConfig >*> behaviours;
+        for ( const auto& behaviour : graph.getBehaviours() ) {
+            const auto forwarding = dynamic_cast<const ForwardingBehaviour<Target>*>( behaviour.get() );
+            if ( forwarding != nullptr &&
+                 ( forwarding->getTarget() == target || forwarding->getTarget() == nullptr ) )
+                behaviours.push_back( forwarding );
+        }
+        for ( const auto behaviour : behaviours )
+            graph.removeGraphBehaviour( behaviour );
+    }
+
+protected:
+    virtual void    nodeInserted( WeakNode& weakNode ) noexcept override {
+        if ( _target ) _target->nodeInserted( weakNode.lock().get() );
+    }
+    virtual void    nodeRemoved( WeakNode& weakNode ) noexcept override {
+        if ( _target ) _target->nodeRemoved( weakNode.lock().get() );
+    }
+    virtual void    edgeInserted( WeakEdge& weakEdge ) noexcept override {
+        if ( _target ) _target->edgeInserted( weakEdge.lock().get() );
+    }
+    virtual void    edgeRemoved( WeakEdge& weakEdge ) noexcept override {
+        if ( _target ) _target->edgeRemoved( weakEdge.lock().get() );
+    }
+
+private:
+    QPointer<Target>    _target;
+};
+
+} // ::qan
+
+#endif // qanForwardingBehaviour_h
@@ -32,11 +32,17 @@
 // \date	2004 February 15
 //-----------------------------------------------------------------------------
 
+// Std headers
+#include <vector>
+#include <algorithm>    // std::max
+
 // Qt headers
 #include <QQmlProperty>
 #include <QVariant>
 #include <QQmlEngine>
 #include <QQmlComponent>
+#include <QQmlContext>
+#include <QSet>
 
 // QuickQanava headers
 #include "./qanUtils.h"
@@ -48,6 +54,7 @@
 #include "./qanGroup.h"
 #include "./qanGroupItem.h"
 #include "./qanConnector.h"
+#include "./qanForwardingBehaviour.h"
 
 namespace qan { // ::qan
 
@@ -58,9 +65,35 @@ Graph::Graph( QQuickItem* parent ) noexcept :
     setContainerItem( this );
     setAntialiasing( true );
     setSmooth( true );
+
+    connect( &_lod, &qan::LevelOfDetail::levelChanged,
+             this,  &Graph::applyLevelOfDetail );
+
+    _virtualUpdateTimer.setSingleShot( true );
+    _virtualUpdateTimer.setInterval( 0 );
+    connect( &_virtualUpdateTimer,  &QTimer::timeout,
+             this,                  &Graph::updateVirtualItems );
+
+    _incubationTimer.setSingleShot( true );
+    _incubationTimer.setInterval( 16 );     // Approximate a frame when graph is not in a window
+    connect( &_incubationTimer, &QTimer::timeout,
+             this,              &Graph::incubateFrame );
+
+    // Topology modifications are monitored to maintain virtual indexes
+    ForwardingBehaviour<qan::Graph>::install( *this, this );
 }
 
-Graph::~Graph() { /* Nil */ }
+Graph::~Graph()
+{
+    ForwardingBehaviour<qan::Graph>::uninstall( *this, this );
+    clearIncubation();
+    if ( _incubationController &&
+         _incubationController->engine() != nullptr )
+        _incubationController->engine()->setIncubationController( nullptr );
+    // Primitives are destroyed in base graph destructor, after _virtualDelegates: disconnect destroyed() notifications
+    for ( auto primitive = _virtualDelegates.keyBegin(); primitive != _virtualDelegates.keyEnd(); ++primitive )
+        disconnect( *primitive, &QObject::destroyed, this, nullptr );
+}
 
 void    Graph::classBegin()
 {
@@ -114,61 +147,124 @@ void    Graph::qmlClearGraph() noexcept
 
 void    Graph::clear() noexcept
 {
+    clearIncubation();
     _selectedNodes.clear();
+    // Recycle items before primitives are destroyed: edges, nodes (ungrouped from their group item) and then groups
+    for ( const auto& edge : getEdges() )
+        if ( edge )
+            recycleEdgeItem( *edge );
+    for ( const auto& node : getNodes() )
+        if ( node )
+            recycleNodeItem( *node );
+    for ( const auto& group : getGroups() )
+        if ( group )
+            recycleGroupItem( *group );
     gtpo::GenGraph< qan::GraphConfig >::clear();
     _styleManager.clear();
+    ForwardingBehaviour<qan::Graph>::install( *this, this );   // Graph behaviours have been destroyed
+    resetVirtualIndex();
+    emit cleared();
 }
 
 QQuickItem* Graph::graphChildAt(qreal x, qreal y) const
 {
-    if ( getContainerItem() == nullptr )
+    const auto container = getContainerItem();
+    if ( container == nullptr )
         return nullptr;
-    const QList<QQuickItem*> children = getContainerItem()->childItems();
-    for (int i = children.count()-1; i >= 0; --i) {
-        QQuickItem *child = children.at(i);
-        QPointF point = mapToItem( child, QPointF(x, y) );  // Map coordinates to the child element's coordinate space
+    flushSpatialIndex();
+
+    // Collect indexed items under (x, y), taking their actual shape into account
+    std::vector<QQuickItem*> candidates;
+    const auto collect = [this, x, y, &candidates](QQuickItem* child, const gtpo::Box&) {
+        const QPointF point = mapToItem( child, QPointF(x, y) );  // Map coordinates to the child element's coordinate space
         if ( child->isVisible() &&
              child->contains( point ) &&    // Note 20160508: childAt do not call contains()
              point.x() > -0.0001 &&
              child->width() > point.x() &&
              point.y() > -0.0001 &&
-             child->height() > point.y() ) {
-            if ( child->inherits( "qan::GroupItem" ) ) {  // For group, look in group childs
-                const auto groupItem = qobject_cast<qan::GroupItem*>( child );
-                if ( groupItem != nullptr &&
-                     groupItem->getContainer() != nullptr ) {
-                    const QList<QQuickItem *> groupChildren = groupItem->getContainer()->childItems();
-                    for (int gc = groupChildren.count()-1; gc >= 0; --gc) {
-                        QQuickItem *groupChild = groupChildren.at(gc);
-                        point = mapToItem( groupChild, QPointF(x, y) ); // Map coordinates to group child element's coordinate space
-                        if ( groupChild->isVisible() &&
-                             groupChild->contains( point ) &&
-                             point.x() > -0.0001 &&
-                             groupChild->width() > point.x() &&
-                             point.y() > -0.0001 &&
-                             groupChild->height() > point.y() ) {
-                            return groupChild;
-                        }
-                    }
-                }
+             child->height() > point.y() )
+            candidates.push_back( child );
+    };
+    const QPointF p = mapToItem( container, QPointF(x, y) );
+    const gtpo::Box pointBox{ p.x(), p.y(), p.x(), p.y() };
+    _nodeIndex.visit( pointBox, collect );
+    _edgeIndex.visit( pointBox, collect );
+    _groupIndex.visit( pointBox, collect );
+
+    // Return topmost candidate among parent children: higher z first, then last in parent children
+    const auto topmost = [&candidates](const QQuickItem* parent) -> QQuickItem* {
+        QQuickItem* top = nullptr;
+        QList<QQuickItem*> children;    // Only necessary to order candidates with same z
+        for ( const auto candidate : candidates ) {
+            if ( candidate->parentItem() != parent )
+                continue;
+            if ( top == nullptr ||
+                 candidate->z() > top->z() )
+                top = candidate;
+            else if ( qFuzzyCompare( 1. + candidate->z(), 1. + top->z() ) ) {
+                if ( children.isEmpty() )
+                    children = parent->childItems();
+                if ( children.indexOf( candidate ) > children.indexOf( top ) )
+                    top = candidate;
             }
-            return child;
         }
+        return top;
+    };
+    auto child = topmost( container );
+    for ( auto groupItem = qobject_cast<qan::GroupItem*>( child );     // For group, look in group childs (and nested groups childs)
+          groupItem != nullptr && groupItem->getContainer() != nullptr;
+          groupItem = qobject_cast<qan::GroupItem*>( child ) ) {
+        const auto groupChild = topmost( groupItem->getContainer() );
+        if ( groupChild == nullptr )
+            break;
+        child = groupChild;
     }
-    return nullptr;
+    return child;
 }
 
 qan::Group* Graph::groupAt( const QPointF& p, const QSizeF& s ) const
 {
-    for ( const auto& group : getGroups() )
-        if ( group &&
-             group->getItem() != nullptr ) {
-            const auto groupItem = group->getItem();
-             if ( QRectF{ groupItem->position(),
-                  QSizeF{ groupItem->width(), groupItem->height() } }.contains( QRectF{ p, s } ) )
-                 return group.get();
-        }
-    return nullptr;
+    flushSpatialIndex();
+    const auto box = gtpo::Box::fromRect( p.x(), p.y(), s.width(), s.height() );
+    qan::GroupItem* topmost = nullptr;
+    _groupIndex.visit( box, [&box, &topmost](QQuickItem* item, const gtpo::Box& groupBox) {
+        const auto groupItem = qobject_cast<qan::GroupItem*>( item );
+        if ( groupItem != nullptr &&
+             groupItem->getGroup() != nullptr &&
+             groupBox.contains( box ) &&
+             ( topmost == nullptr || groupItem->z() > topmost->z() ) )
+            topmost = groupItem;
+    } );
+    return topmost != nullptr ? topmost->getGroup() : nullptr;
+}
+
+QVariantList    Graph::graphChildrenIn( const QRectF& rect ) const
+{
+    flushSpatialIndex();
+    QVariantList children;
+    const auto collect = [&children](QQuickItem* item, const gtpo::Box&) {
+        children.append( QVariant::fromValue( item ) );
+    };
+    const auto box = gtpo::Box::fromRect( rect.x(), rect.y(), rect.width(), rect.height() );
+    _nodeIndex.visit( box, collect );
+    _edgeIndex.visit( box, collect );
+    _groupIndex.visit( box, collect );
+    return children;
+}
+
+QVariantList    Graph::nearestNodes( const QPointF& p, int k ) const
+{
+    QVariantList nodes;
+    if ( k <= 0 )
+        return nodes;
+    flushSpatialIndex();
+    for ( const auto item : _nodeIndex.nearest( p.x(), p.y(), static_cast<std::size_t>( k ) ) ) {
+        const auto nodeItem = qobject_cast<qan::NodeItem*>( item );
+        if ( nodeItem != nullptr &&
+             nodeItem->getNode() != nullptr )
+            nodes.append( QVariant::fromValue( nodeItem->getNode() ) );
+    }
+    return nodes;
 }
 
 void    Graph::setContainerItem( QQuickItem* containerItem )
@@ -176,6 +272,10 @@ void    Graph::setContainerItem( QQuickItem* containerItem )
     if ( containerItem != nullptr &&
          containerItem != _containerItem.data() ) {
         _containerItem = containerItem;
+        if ( _edgeRenderer )
+            _edgeRenderer->setParentItem( containerItem );
+        if ( _nodeRenderer )
+            _nodeRenderer->setParentItem( containerItem );
         emit containerItemChanged();
     }
 }
@@ -316,7 +416,14 @@ QQuickItem* Graph::createFromComponent( QQmlComponent* component,
         qWarning() << "qan::Graph::createFromComponent(): Error called with a nullptr delegate component.";
         return nullptr;
     }
-    QQuickItem* item = nullptr;
+    QQuickItem* item = _itemPool.acquire(component);   // Reuse a pooled item: no QML object creation necessary
+    if ( item != nullptr ) {
+        configureComponentItem( item, component, style, node, edge, group );
+        item->setVisible( true );
+        item->setParentItem( getContainerItem() );
+        _itemPool.notifyReused( item );
+        return item;
+    }
     try {
         if ( !component->isReady() )
             throw qan::Error{ "Error delegate component is not ready." };
@@ -333,42 +440,14 @@ QQuickItem* Graph::createFromComponent( QQmlComponent* component,
                               component->errorString() };
         }
         // No error occurs
-        if ( node != nullptr ) {
-            const auto nodeItem = qobject_cast<qan::NodeItem*>(object);
-            if ( nodeItem != nullptr ) {
-                node->setItem(nodeItem);
-                nodeItem->setNode(node);
-                nodeItem->setGraph(this);
-                nodeItem->setStyle(qobject_cast<qan::NodeStyle*>(&style));
-                _styleManager.setStyleComponent(&style, component );
-            }
-        } else if ( edge != nullptr ) {
-            const auto edgeItem = qobject_cast<qan::EdgeItem*>(object);
-            if ( edgeItem != nullptr ) {
-                edge->setItem(edgeItem);
-                edgeItem->setEdge(edge);
-                edgeItem->setGraph(this);
-                _styleManager.setStyleComponent(edgeItem->getStyle(), component );
-            }
-        } else if ( group != nullptr ) {
-            const auto groupItem = qobject_cast<qan::GroupItem*>(object);
-            if ( groupItem != nullptr ) {
-                group->setItem(groupItem);
-                groupItem->setGroup(group);
-                groupItem->setGraph(this);
-                _styleManager.setStyleComponent(groupItem->getStyle(), component );
-            }
-        } else {
-            const auto nodeItem = qobject_cast<qan::NodeItem*>(object); // Note 20170323: Usefull for Qan.StyleListView, where there
-            if ( nodeItem != nullptr )                                  // is a preview item, but now actual underlining node.
-                nodeItem->setItemStyle(&style);
-        }
+        configureComponentItem( object, component, style, node, edge, group );
         component->completeCreate();
         if ( !component->isError() ) {
             QQmlEngine::setObjectOwnership( object, QQmlEngine::CppOwnership );
             item = qobject_cast< QQuickItem* >( object );
             item->setVisible( true );
             item->setParentItem( getContainerItem() );
+            _itemPool.track( item, component );
         } // Note: There is no leak until cpp ownership is set
     } catch ( const qan::Error& e ) {
         Q_UNUSED(e);
@@ -385,6 +464,44 @@ QQuickItem* Graph::createFromComponent( QQmlComponent* component, qan::Style* st
              style != nullptr ) ? createFromComponent( component, *style, nullptr, nullptr, nullptr ) : nullptr;
 }
 
+void    Graph::configureComponentItem( QObject* object, QQmlComponent* component, qan::Style& style,
+                                       qan::Node* node, qan::Edge* edge, qan::Group* group ) noexcept
+{
+    if ( node != nullptr ) {
+        const auto nodeItem = qobject_cast<qan::NodeItem*>(object);
+        if ( nodeItem != nullptr ) {
+            node->setItem(nodeItem);
+            nodeItem->setNode(node);
+            nodeItem->setGraph(this);
+            nodeItem->setStyle(qobject_cast<qan::NodeStyle*>(&style));
+            _styleManager.setStyleComponent(&style, component );
+            indexItem( nodeItem, _nodeIndex );
+        }
+    } else if ( edge != nullptr ) {
+        const auto edgeItem = qobject_cast<qan::EdgeItem*>(object);
+        if ( edgeItem != nullptr ) {
+            edge->setItem(edgeItem);
+            edgeItem->setEdge(edge);
+            edgeItem->setGraph(this);
+            _styleManager.setStyleComponent(edgeItem->getStyle(), component );
+            indexItem( edgeItem, _edgeIndex );
+        }
+    } else if ( group != nullptr ) {
+        const auto groupItem = qobject_cast<qan::GroupItem*>(object);
+        if ( groupItem != nullptr ) {
+            group->setItem(groupItem);
+            groupItem->setGroup(group);
+            groupItem->setGraph(this);
+            _styleManager.setStyleComponent(groupItem->getStyle(), component );
+            indexItem( groupItem, _groupIndex );
+        }
+    } else {
+        const auto nodeItem = qobject_cast<qan::NodeItem*>(object); // Note 20170323: Usefull for Qan.StyleListView, where there
+        if ( nodeItem != nullptr )                                  // is a preview item, but now actual underlining node.
+            nodeItem->setItemStyle(&style);
+    }
+}
+
 void Graph::setSelectionDelegate(QQmlComponent* selectionDelegate) noexcept
 {
     // Note: Cpp ownership is voluntarily not set to avoid destruction of
@@ -419,7 +536,12 @@ void Graph::setSelectionDelegate(std::unique_ptr<QQmlComponent> selectionDelegat
 
 QPointer<QQuickItem> Graph::createSelectionItem( QQuickItem* parent ) noexcept
 {
-    const auto selectionItem = createItemFromComponent(_selectionDelegate.get());
+    QPointer<QQuickItem> selectionItem{ _itemPool.acquire(_selectionDelegate.get()) };
+    const bool reused = selectionItem != nullptr;
+    if ( !reused ) {
+        selectionItem = createItemFromComponent(_selectionDelegate.get());
+        _itemPool.track(selectionItem.data(), _selectionDelegate.get());
+    }
     if ( selectionItem ) {
         selectionItem->setEnabled(false); // Avoid node/edge/group selection problems
         selectionItem->setState("UNSELECTED");
@@ -427,6 +549,8 @@ QPointer<QQuickItem> Graph::createSelectionItem( QQuickItem* parent ) noexcept
         QQmlEngine::setObjectOwnership( selectionItem, QQmlEngine::CppOwnership );
         if (parent != nullptr )
             selectionItem->setParentItem(parent);
+        if ( reused )
+            _itemPool.notifyReused(selectionItem.data());
         return selectionItem;
     }
     return QPointer<QQuickItem>{nullptr};
@@ -508,6 +632,87 @@ qan::Node*  Graph::insertNode( QQmlComponent* nodeComponent )
     return insertNode<qan::Node>(nodeComponent);
 }
 
+bool    Graph::createNodeItem( qan::Node& node, QQmlComponent* nodeComponent )
+{
+    if ( node.getItem() != nullptr )
+        return false;
+    if ( nodeComponent == nullptr ) {
+        nodeComponent = qan::Node::delegate(this);
+        if ( nodeComponent == nullptr )
+            nodeComponent = _nodeDelegate.get();
+    }
+    if ( nodeComponent == nullptr ||
+         nodeComponent->isError() ) {
+        qWarning() << "qan::Graph::createNodeItem(): Error: Can't find a valid node delegate component.";
+        return false;
+    }
+    qan::NodeStyle* nodeStyle = qan::Node::style();
+    if ( nodeStyle == nullptr ) {
+        qWarning() << "qan::Graph::createNodeItem(): Error: style() factory has returned a nullptr style.";
+        return false;
+    }
+    return configureNode( node, *nodeComponent, *nodeStyle );
+}
+
+bool    Graph::configureNode( qan::Node& node, QQmlComponent& nodeComponent, qan::NodeStyle& nodeStyle )
+{
+    _styleManager.setStyleComponent(&nodeStyle, &nodeComponent);
+    if ( _asynchronous )
+        return incubateItem( nodeComponent, nodeStyle, &node, nullptr, nullptr );
+    qan::NodeItem* nodeItem = static_cast<qan::NodeItem*>( createFromComponent( &nodeComponent,
+                                                                                nodeStyle,
+                                                                                &node ) );
+    if ( nodeItem == nullptr )
+        return false;
+    configureNodeItem( node, *nodeItem );
+    return true;
+}
+
+void    Graph::configureNodeItem( qan::Node& node, qan::NodeItem& nodeItem )
+{
+    nodeItem.setNode(&node);
+    nodeItem.setGraph(this);
+    node.setItem(&nodeItem);
+    auto notifyNodeClicked = [this] (qan::NodeItem* nodeItem, QPointF p) {
+        if ( nodeItem != nullptr && nodeItem->getNode() != nullptr )
+            emit this->nodeClicked(nodeItem->getNode(), p);
+    };
+    connect( &nodeItem, &qan::NodeItem::nodeClicked, this, notifyNodeClicked );   // Graph context: disconnected when item is recycled
+
+    auto notifyNodeRightClicked = [this] (qan::NodeItem* nodeItem, QPointF p) {
+        if ( nodeItem != nullptr && nodeItem->getNode() != nullptr )
+            emit this->nodeRightClicked(nodeItem->getNode(), p);
+    };
+    connect( &nodeItem, &qan::NodeItem::nodeRightClicked, this, notifyNodeRightClicked );
+
+    auto notifyNodeDoubleClicked = [this] (qan::NodeItem* nodeItem, QPointF p) {
+        if ( nodeItem != nullptr && nodeItem->getNode() != nullptr )
+            emit this->nodeDoubleClicked(nodeItem->getNode(), p);
+    };
+    connect( &nodeItem, &qan::NodeItem::nodeDoubleClicked, this, notifyNodeDoubleClicked );
+
+    // Adjacent edges or group items might have been created first (asynchronous or virtualized graph)
+    for ( const auto& inEdge : node.getInEdges() ) {
+        const auto edge = inEdge.lock();
+        if ( edge &&
+             edge->getItem() != nullptr &&
+             edge->getItem()->getDestinationItem() == nullptr )
+            edge->getItem()->setDestinationItem( &nodeItem );
+    }
+    for ( const auto& outEdge : node.getOutEdges() ) {
+        const auto edge = outEdge.lock();
+        if ( edge &&
+             edge->getItem() != nullptr &&
+             edge->getItem()->getSourceItem() == nullptr )
+            edge->getItem()->setSourceItem( &nodeItem );
+    }
+    const auto group = node.getGroup().lock();
+    if ( group &&
+         group->getItem() != nullptr &&
+         nodeItem.parentItem() != group->getItem()->getContainer() )
+        group->getItem()->groupNodeItem( &nodeItem );
+}
+
 void    Graph::removeNode( qan::Node* node )
 {
     if ( node == nullptr )
@@ -518,6 +723,14 @@ void    Graph::removeNode( qan::Node* node )
     } catch ( std::bad_weak_ptr ) { return; }
     if ( _selectedNodes.contains(node) )
         _selectedNodes.remove(node);
+    // Adjacent edges are removed with node, recycle their items first
+    for ( const auto& inEdge : node->getInEdges() )
+        if ( const auto edge = inEdge.lock() )
+            recycleEdgeItems( *edge );
+    for ( const auto& outEdge : node->getOutEdges() )
+        if ( const auto edge = outEdge.lock() )
+            recycleEdgeItems( *edge );
+    recycleNodeItem( *node );
     GTpoGraph::removeNode( weakNode );
 }
 //-----------------------------------------------------------------------------
@@ -608,43 +821,100 @@ bool    Graph::configureEdge( qan::Edge& edge, QQmlComponent& edgeComponent, qan
                               qan::Node& src, qan::Node* dstNode, qan::Edge* dstEdge )
 {
     _styleManager.setStyleComponent(&style, &edgeComponent);
-    auto edgeItem = qobject_cast< qan::EdgeItem* >( createFromComponent( &edgeComponent, style, nullptr, &edge ) );
+    edge.setSrc( src.shared_from_this() );
+    if ( dstNode != nullptr )
+        edge.setDst( dstNode->shared_from_this() );
+    else if ( dstEdge != nullptr)
+        edge.setHDst( dstEdge->shared_from_this() );
+    auto& itemComponent = getBatchedEdgeComponent( edgeComponent );
+    if ( _asynchronous )
+        return incubateItem( itemComponent, style, nullptr, &edge, nullptr );
+
+    auto edgeItem = qobject_cast< qan::EdgeItem* >( createFromComponent( &itemComponent, style, nullptr, &edge ) );
     // FIXME: a leak miht occurs if qobject_cast fails, but createFromComponent() return a non nullptr object...
     if ( edgeItem == nullptr ) {
         qWarning() << "qan::Graph::insertEdge(): Warning: Edge creation from QML delegate failed.";
         return false;
     }
-    edge.setItem(edgeItem);
-    edgeItem->setSourceItem( src.getItem() );
-    if ( dstNode != nullptr )
-        edgeItem->setDestinationItem( dstNode->getItem() );
-    else if ( dstEdge != nullptr )
-        edgeItem->setDestinationEdge( dstEdge->getItem() );
+    configureEdgeItem( edge, *edgeItem );
+    return true;
+}
 
-    edge.setSrc( src.shared_from_this() );
-    if ( dstNode != nullptr )
-        edge.setDst( dstNode->shared_from_this() );
-    else if ( dstEdge != nullptr)
-        edge.setHDst( dstEdge->shared_from_this() );
+void    Graph::configureEdgeItem( qan::Edge& edge, qan::EdgeItem& edgeItem )
+{
+    edge.setItem(&edgeItem);
+    if ( _edgeRenderer &&
+         _batchedEdgeDelegate &&
+         _itemPool.getComponent( &edgeItem ) == _batchedEdgeDelegate.get() )
+        _edgeRenderer->addEdge( &edgeItem );
+    // End points items might not exist yet (asynchronous or virtualized graph), see configureNodeItem()
+    const auto src = edge.getSrc().lock();
+    if ( src &&
+         src->getItem() != nullptr )
+        edgeItem.setSourceItem( src->getItem() );
+    const auto dstNode = edge.getDst().lock();
+    const auto dstEdge = edge.getHDst().lock();
+    if ( dstNode &&
+         dstNode->getItem() != nullptr )
+        edgeItem.setDestinationItem( dstNode->getItem() );
+    else if ( dstEdge &&
+              dstEdge->getItem() != nullptr )
+        edgeItem.setDestinationEdge( dstEdge->getItem() );
+    for ( const auto& inHEdge : edge.getInHEdges() ) {
+        const auto hEdge = inHEdge.lock();
+        if ( hEdge &&
+             hEdge->getItem() != nullptr &&
+             hEdge->getItem()->getDestinationEdge() == nullptr )
+            hEdge->getItem()->setDestinationEdge( &edgeItem );
+    }
 
     auto notifyEdgeClicked = [this] (qan::EdgeItem* edgeItem, QPointF p) {
         if ( edgeItem != nullptr && edgeItem->getEdge() != nullptr )
             emit this->edgeClicked(edgeItem->getEdge(), p);
     };
-    connect( edgeItem, &qan::EdgeItem::edgeClicked, notifyEdgeClicked );
+    connect( &edgeItem, &qan::EdgeItem::edgeClicked, this, notifyEdgeClicked );   // Graph context: disconnected when item is recycled
 
     auto notifyEdgeRightClicked = [this] (qan::EdgeItem* edgeItem, QPointF p) {
         if ( edgeItem != nullptr && edgeItem->getEdge() != nullptr )
             emit this->edgeRightClicked(edgeItem->getEdge(), p);
     };
-    connect( edgeItem, &qan::EdgeItem::edgeRightClicked, notifyEdgeRightClicked );
+    connect( &edgeItem, &qan::EdgeItem::edgeRightClicked, this, notifyEdgeRightClicked );
 
     auto notifyEdgeDoubleClicked = [this] (qan::EdgeItem* edgeItem, QPointF p) {
         if ( edgeItem != nullptr && edgeItem->getEdge() != nullptr )
             emit this->edgeDoubleClicked(edgeItem->getEdge(), p);
     };
-    connect( edgeItem, &qan::EdgeItem::edgeDoubleClicked, notifyEdgeDoubleClicked );
-    return true;
+    connect( &edgeItem, &qan::EdgeItem::edgeDoubleClicked, this, notifyEdgeDoubleClicked );
+}
+
+bool    Graph::createEdgeItem( qan::Edge& edge, QQmlComponent* edgeComponent )
+{
+    if ( edge.getItem() != nullptr )
+        return false;
+    if ( edgeComponent == nullptr ) {
+        edgeComponent = qan::Edge::delegate(this);
+        if ( edgeComponent == nullptr )
+            edgeComponent = _edgeDelegate.get();
+    }
+    if ( edgeComponent == nullptr ) {
+        qWarning() << "qan::Graph::createEdgeItem(): Error: Can't find a valid edge delegate component.";
+        return false;
+    }
+    const auto style = qobject_cast<qan::EdgeStyle*>(qan::Edge::style());
+    if ( style == nullptr ) {
+        qWarning() << "qan::Graph::createEdgeItem(): Error: style() factory has returned a nullptr style.";
+        return false;
+    }
+    const auto src = edge.getSrc().lock();
+    const auto dstNode = edge.getDst().lock();
+    const auto dstEdge = edge.getHDst().lock();
+    if ( !src ||
+         ( !dstNode && !dstEdge ) ) {
+        qWarning() << "qan::Graph::createEdgeItem(): Error: Edge source or destination is invalid.";
+        return false;
+    }
+    return configureEdge( edge, *edgeComponent, *style,
+                          *src, dstNode.get(), dstEdge.get() );
 }
 
 void    Graph::removeEdge( qan::Node* source, qan::Node* destination )
@@ -657,14 +927,18 @@ void    Graph::removeEdge( qan::Node* source, qan::Node* destination )
         sharedSource = WeakNode{ source->shared_from_this() };
         sharedDestination = WeakNode{ destination->shared_from_this() };
     } catch ( std::bad_weak_ptr ) { return; }
+    if ( const auto edge = GTpoGraph::findEdge( sharedSource, sharedDestination ).lock() )
+        recycleEdgeItems( *edge );
     return GTpoGraph::removeEdge( sharedSource, sharedDestination );
 }
 
 void    Graph::removeEdge( qan::Edge* edge )
 {
     using WeakEdge = std::weak_ptr<qan::Edge>;
-    if ( edge != nullptr )
+    if ( edge != nullptr ) {
+        recycleEdgeItems( *edge );
         GTpoGraph::removeEdge( WeakEdge{edge->shared_from_this()} );
+    }
 }
 
 bool    Graph::hasEdge( qan::Node* source, qan::Node* destination ) const
@@ -687,27 +961,71 @@ qan::Group* Graph::insertGroup()
     return insertGroup<qan::Group>();
 }
 
+bool    Graph::configureGroup( qan::Group& group, QQmlComponent& groupComponent, qan::Style& style )
+{
+    if ( _asynchronous )
+        return incubateItem( groupComponent, style, nullptr, nullptr, &group );
+    const auto groupItem = qobject_cast<qan::GroupItem*>( createFromComponent( &groupComponent, style,
+                                                                               nullptr, nullptr, &group ) );
+    if ( groupItem == nullptr )
+        return false;
+    configureGroupItem( group, *groupItem );
+    return true;
+}
+
+void    Graph::configureGroupItem( qan::Group& group, qan::GroupItem& groupItem )
+{
+    groupItem.setGroup(&group);
+    groupItem.setGraph(this);
+    group.setItem(&groupItem);
+
+    auto notifyGroupClicked = [this] (qan::GroupItem* groupItem, QPointF p) {
+        if ( groupItem != nullptr && groupItem->getGroup() != nullptr )
+            emit this->groupClicked(groupItem->getGroup(), p);
+    };
+    connect( &groupItem, &qan::GroupItem::groupClicked, this, notifyGroupClicked );   // Graph context: disconnected when item is recycled
+
+    auto notifyGroupRightClicked = [this] (qan::GroupItem* groupItem, QPointF p) {
+        if ( groupItem != nullptr && groupItem->getGroup() != nullptr )
+            emit this->groupRightClicked(groupItem->getGroup(), p);
+    };
+    connect( &groupItem, &qan::GroupItem::groupRightClicked, this, notifyGroupRightClicked );
+
+    auto notifyGroupDoubleClicked = [this] (qan::GroupItem* groupItem, QPointF p) {
+        if ( groupItem != nullptr && groupItem->getGroup() != nullptr )
+            emit this->groupDoubleClicked(groupItem->getGroup(), p);
+    };
+    connect( &groupItem, &qan::GroupItem::groupDoubleClicked, this, notifyGroupDoubleClicked );
+
+    // Nodes might have been grouped while group item was incubated (asynchronous graph)
+    for ( const auto& weakNode : group.getNodes() ) {
+        const auto node = weakNode.lock();
+        if ( node &&
+             node->getItem() != nullptr )
+            groupItem.groupNodeItem( node->getItem() );
+    }
+}
+
 void    Graph::removeGroup( qan::Group* group )
 {
     if ( group == nullptr )
         return;
-    // Reparent all group childrens (ie node) to graph before destructing the group
-    // otherwise all child iems get destructed too
-
-    // FIXME QAN3       (use std::copy() here...)
-    /*auto groupNodes{group->getNodes()};
-    for ( auto& node : groupNodes ) {
-        auto nodePtr{ node.lock() };
-        if ( nodePtr != nullptr ) {
-            // FIXME QAN3
-            //nodePtr->ungroup();
-            //nodePtr->setParentItem( this );
-        }
-    }
-    WeakGroup weakGroup = group->shared_from_this();
-    if ( !weakGroup.expired() )
-        gtpo::GenGraph< qan::GraphConfig >::removeGroup( weakGroup );
-    */
+    using WeakGroup = std::weak_ptr<qan::Group>;
+    WeakGroup weakGroup;
+    try {
+        weakGroup = WeakGroup{ group->shared_from_this() };
+    } catch ( std::bad_weak_ptr ) { return; }
+
+    // Reparent all group childrens (ie node) to graph before recycling the group item
+    // otherwise all child items get recycled (or destructed) too
+    const auto groupNodes = group->getNodes();     // Copy, ungroupNode() modify group nodes
+    for ( const auto& groupNode : groupNodes )
+        if ( const auto node = groupNode.lock() )
+            ungroupNode( group, node.get() );
+    if ( _selectedGroups.contains(group) )
+        _selectedGroups.remove(group);
+    recycleGroupItem( *group );
+    GTpoGraph::removeGroup( weakGroup );
 }
 
 bool    Graph::hasGroup( qan::Group* group ) const
@@ -732,16 +1050,27 @@ auto    qan::Graph::groupNode( qan::Group* group, qan::Node* node, bool transfor
     }
 }
 
-auto    qan::Graph::groupNode( Group* group, qan::Group* node ) noexcept(false) -> void
+auto    qan::Graph::groupNode( Group* group, qan::Group* node, bool transformPosition ) noexcept(false) -> void
 {
-    if ( group != nullptr &&
-         node != nullptr ) {
-        qDebug() << "qan::Graph::groupNode(qan::Group*, qan::Group*)";
-        try {
-            /*if ( group->getItem() )
-                group->getItem()->ungroupNodeItem(node->getItem());
-            GTpoGraph::ungroupNode( group->shared_from_this(), node->shared_from_this() );*/
-        } catch ( ... ) { qWarning() << "qan::Graph::ungroupNode(): Topology error."; }
+    if ( group == nullptr ||
+         node == nullptr ||
+         group == node )
+        return;
+    for ( auto parent = group->getGroup().lock(); parent; parent = parent->getGroup().lock() )
+        if ( parent.get() == node ) {       // Group would be nested in itself
+            qWarning() << "qan::Graph::groupNode(): Error: Can't group a group in one of its sub groups.";
+            return;
+        }
+    // Nesting is stored in sub group, group nodes content is not modified
+    node->setGroup( group->shared_from_this() );
+    const auto groupItem = group->getItem();
+    const auto subGroupItem = node->getItem();
+    if ( groupItem != nullptr &&
+         groupItem->getContainer() != nullptr &&
+         subGroupItem != nullptr ) {
+        if ( transformPosition )
+            subGroupItem->setPosition( subGroupItem->mapToItem( groupItem->getContainer(), QPointF{0., 0.} ) );
+        subGroupItem->setParentItem( groupItem->getContainer() );
     }
 }
 
@@ -761,16 +1090,969 @@ auto    qan::Graph::ungroupNode( Group* group, qan::Group* node ) noexcept(false
 {
     if ( group != nullptr &&
          node != nullptr ) {
-        try {
-            /*if ( group->getItem() )
-                group->getItem()->ungroupNodeItem(node->getItem());
-            GTpoGraph::ungroupNode( group->shared_from_this(), node->shared_from_this() );*/
-        } catch ( ... ) { qWarning() << "qan::Graph::ungroupNode(): Topology error."; }
+        if ( node->getGroup().lock().get() != group )
+            return;
+        node->setGroup( std::weak_ptr<qan::Group>{} );
+        const auto subGroupItem = node->getItem();
+        if ( subGroupItem != nullptr &&
+             getContainerItem() != nullptr ) {
+            const auto position = subGroupItem->mapToItem( getContainerItem(), QPointF{0., 0.} );
+            subGroupItem->setParentItem( getContainerItem() );
+            subGroupItem->setPosition( position );
+        }
     }
 }
 //-----------------------------------------------------------------------------
 
 
+/* Batch Update Management *///----------------------------------------------
+void    Graph::beginBatchUpdate() noexcept
+{
+    if ( _batchModelsDepth++ == 0 )
+        for ( const auto model : getBatchedModels() )
+            model->beginBatchNotifications();
+    beginGeometryUpdate();
+}
+
+void    Graph::endBatchUpdate() noexcept
+{
+    if ( _batchModelsDepth <= 0 )
+        return;
+    if ( --_batchModelsDepth == 0 )
+        for ( const auto model : getBatchedModels() )   // Views are notified with a single reset, if rows have changed
+            model->endBatchNotifications();
+    endGeometryUpdate();
+}
+
+void    Graph::beginGeometryUpdate() noexcept
+{
+    ++_batchUpdateDepth;
+}
+
+void    Graph::endGeometryUpdate() noexcept
+{
+    if ( _batchUpdateDepth <= 0 )
+        return;
+    if ( --_batchUpdateDepth == 0 ) {
+        _invalidatedEdgeItems.clear();      // All edges are updated
+        std::vector<qan::EdgeItem*> edgeItems;
+        edgeItems.reserve( static_cast<std::size_t>( getEdgeCount() ) );
+        for ( const auto& edge : getEdges() )
+            if ( edge &&
+                 edge->getItem() != nullptr )
+                edgeItems.push_back( edge->getItem() );
+        qan::EdgeItem::updateItems( edgeItems );
+        emit batchUpdateFinished();
+    }
+}
+
+std::vector<qcm::AbstractContainerModel*>   Graph::getBatchedModels() const noexcept
+{
+    const auto model = []( const qcm::AbstractContainerModel& container ) {
+        return const_cast<qcm::AbstractContainerModel*>( &container );
+    };
+    return { model( getNodes() ), model( getRootNodes() ), model( getEdges() ), model( getGroups() ) };
+}
+
+void    Graph::invalidateEdgeItem( qan::EdgeItem* edgeItem ) noexcept
+{
+    if ( edgeItem == nullptr )
+        return;
+    auto& invalidated = _invalidatedEdgeItems[edgeItem];
+    if ( !invalidated )     // Guard is null for a new entry or a destroyed item whose address has been reused
+        invalidated = edgeItem;
+}
+
+void    Graph::updateInvalidatedEdgeItems() noexcept
+{
+    if ( _invalidatedEdgeItems.isEmpty() )
+        return;
+    std::vector<qan::EdgeItem*> edgeItems;
+    edgeItems.reserve( _invalidatedEdgeItems.size() );
+    for ( const auto& edgeItem : _invalidatedEdgeItems )
+        if ( edgeItem )
+            edgeItems.push_back( edgeItem.data() );
+    _invalidatedEdgeItems.clear();  // Hyper edges invalidated during update are registered for next pass
+    qan::EdgeItem::updateItems( edgeItems );
+}
+//-----------------------------------------------------------------------------
+
+/* Virtualization Management *///----------------------------------------------
+void    Graph::setVirtualized( bool virtualized ) noexcept
+{
+    if ( virtualized == _virtualized )
+        return;
+    _virtualized = virtualized;
+    resetVirtualIndex();
+    if ( isDeferred() )
+        scheduleVirtualUpdate();
+    else
+        createMissingItems();
+    emit virtualizedChanged();
+}
+
+void    Graph::createMissingItems()
+{
+    // Create all missing delegates, nodes first since edge items reference node items
+    _virtualUpdateTimer.stop();
+    beginGeometryUpdate();
+    for ( const auto& node : getNodes() )
+        if ( node &&
+             node->getItem() == nullptr )
+            createVirtualNodeItem( *node );
+    for ( const auto& edge : getEdges() )
+        if ( edge &&
+             edge->getItem() == nullptr &&
+             edge->getHDst().expired() )
+            createVirtualEdgeItem( *edge );
+    for ( const auto& edge : getEdges() )
+        if ( edge &&
+             edge->getItem() == nullptr )
+            createVirtualEdgeItem( *edge );
+    endGeometryUpdate();
+    if ( _nodeRenderer )
+        _nodeRenderer->invalidate();
+}
+
+void    Graph::invalidateVirtualGeometry( qan::Node* node ) noexcept
+{
+    if ( node == nullptr ||
+         !isDeferred() )
+        return;
+    _dirtyVirtualNodes.insert( node );
+    scheduleVirtualUpdate();    // Node might enter virtual viewport
+}
+
+void    Graph::nodeInserted( qan::Node* node )
+{
+    if ( node == nullptr ||
+         !isDeferred() )
+        return;
+    _dirtyVirtualNodes.insert( node );
+    _virtualNodeItems.insert( node );   // Node might have been inserted with an item
+}
+
+void    Graph::nodeRemoved( qan::Node* node )
+{
+    _dirtyVirtualNodes.remove( node );
+    _virtualNodeIndex.remove( node );
+    _virtualNodeItems.remove( node );
+}
+
+void    Graph::edgeInserted( qan::Edge* edge )
+{
+    if ( edge == nullptr ||
+         !isDeferred() )
+        return;
+    _dirtyVirtualEdges.insert( edge );
+    _virtualEdgeItems.insert( edge );
+}
+
+void    Graph::edgeRemoved( qan::Edge* edge )
+{
+    _dirtyVirtualEdges.remove( edge );
+    _virtualEdgeIndex.remove( edge );
+    _virtualEdgeItems.remove( edge );
+}
+
+void    Graph::resetVirtualIndex() noexcept
+{
+    _virtualNodeIndex.clear();
+    _virtualEdgeIndex.clear();
+    _dirtyVirtualNodes.clear();
+    _dirtyVirtualEdges.clear();
+    _virtualNodeItems.clear();
+    _virtualEdgeItems.clear();
+    if ( !isDeferred() )
+        return;
+    for ( const auto& node : getNodes() )
+        if ( node ) {
+            _dirtyVirtualNodes.insert( node.get() );
+            if ( node->getItem() != nullptr ||
+                 _incubatingPrimitives.contains( node.get() ) )
+                _virtualNodeItems.insert( node.get() );
+        }
+    for ( const auto& edge : getEdges() )
+        if ( edge ) {
+            _dirtyVirtualEdges.insert( edge.get() );
+            if ( edge->getItem() != nullptr ||
+                 _incubatingPrimitives.contains( edge.get() ) )
+                _virtualEdgeItems.insert( edge.get() );
+        }
+}
+
+void    Graph::flushVirtualIndex() noexcept
+{
+    flushSpatialIndex();    // Moved node items are marked dirty in flushSpatialIndex()
+    const auto box = []( const QRectF& r ) { return gtpo::Box::fromRect( r.x(), r.y(), r.width(), r.height() ); };
+    try {
+        for ( const auto node : _dirtyVirtualNodes ) {
+            _virtualNodeIndex.update( node, box( node->getGeometry() ) );
+            for ( const auto& inEdge : node->getInEdges() )     // Adjacent edges bounding rect has changed too
+                if ( const auto edge = inEdge.lock() )
+                    _dirtyVirtualEdges.insert( edge.get() );
+            for ( const auto& outEdge : node->getOutEdges() )
+                if ( const auto edge = outEdge.lock() )
+                    _dirtyVirtualEdges.insert( edge.get() );
+        }
+        for ( const auto edge : _dirtyVirtualEdges ) {
+            const auto src = edge->getSrc().lock();
+            const auto dst = edge->getDst().lock();
+            if ( src && dst )
+                _virtualEdgeIndex.update( edge, box( src->getGeometry().united( dst->getGeometry() ) ) );
+            else                // Hyper edges visibility depends on their destination edge
+                _virtualEdgeIndex.remove( edge );
+        }
+    } catch ( const std::exception& e ) {
+        qWarning() << "qan::Graph::flushVirtualIndex(): Error: " << e.what();
+    }
+    _dirtyVirtualNodes.clear();
+    _dirtyVirtualEdges.clear();
+}
+
+void    Graph::setVirtualViewport( const QRectF& virtualViewport ) noexcept
+{
+    if ( virtualViewport != _virtualViewport ) {
+        _virtualViewport = virtualViewport;
+        emit virtualViewportChanged();
+        scheduleVirtualUpdate();
+    }
+}
+
+void    Graph::setVirtualMargin( qreal virtualMargin ) noexcept
+{
+    if ( !qFuzzyCompare( 1. + virtualMargin, 1. + _virtualMargin ) ) {
+        _virtualMargin = virtualMargin;
+        emit virtualMarginChanged();
+        scheduleVirtualUpdate();
+    }
+}
+
+void    Graph::updateVirtualItems()
+{
+    _virtualUpdateTimer.stop();
+    if ( !isDeferred() )
+        return;
+    const auto viewport = _virtualViewport.adjusted( -_virtualMargin, -_virtualMargin,
+                                                     _virtualMargin, _virtualMargin );
+
+    flushVirtualIndex();
+    const auto box = []( const QRectF& r ) { return gtpo::Box::fromRect( r.x(), r.y(), r.width(), r.height() ); };
+
+    QSet<qan::Edge*> visibleEdges;
+    QSet<qan::Node*> visibleNodes;
+    if ( _lightweightNodes ) {
+        // Only promoted nodes have an item (see isPromoted()), edges between promoted nodes are visible
+        for ( const auto promoted : _promotedNodes )
+            visibleNodes.insert( static_cast<qan::Node*>( const_cast<QObject*>( promoted ) ) );
+        if ( _hoveredNode )
+            visibleNodes.insert( _hoveredNode.data() );
+        if ( _viewZoom >= _promotionZoom )
+            _virtualNodeIndex.visit( box( _virtualViewport ), [&visibleNodes]( qan::Node* node, const gtpo::Box& ) {
+                visibleNodes.insert( node );
+            } );
+        for ( const auto node : visibleNodes )
+            for ( const auto& outEdge : node->getOutEdges() ) {
+                const auto edge = outEdge.lock();
+                const auto dst = edge ? edge->getDst().lock() : SharedNode{};
+                if ( dst &&
+                     visibleNodes.contains( dst.get() ) &&
+                     ( !_virtualized ||
+                       viewport.intersects( node->getGeometry().united( dst->getGeometry() ) ) ) )
+                    visibleEdges.insert( edge.get() );
+            }
+        for ( const auto edge : QSet<qan::Edge*>{ visibleEdges } )
+            for ( const auto& inHEdge : edge->getInHEdges() ) {
+                const auto hyperEdge = inHEdge.lock();
+                const auto src = hyperEdge ? hyperEdge->getSrc().lock() : SharedNode{};
+                if ( src &&
+                     visibleNodes.contains( src.get() ) )
+                    visibleEdges.insert( hyperEdge.get() );
+            }
+    } else {
+        // Collect visible edges (ie edges whose end points bounding rect intersect viewport) and nodes necessary to display them
+        _virtualEdgeIndex.visit( box( viewport ), [&visibleEdges, &visibleNodes]( qan::Edge* edge, const gtpo::Box& ) {
+            const auto src = edge->getSrc().lock();
+            const auto dst = edge->getDst().lock();
+            if ( src && dst ) {
+                visibleEdges.insert( edge );
+                visibleNodes.insert( src.get() );
+                visibleNodes.insert( dst.get() );
+            }
+        } );
+        for ( const auto edge : QSet<qan::Edge*>{ visibleEdges } )   // Hyper edges are visible when their destination edge is visible
+            for ( const auto& inHEdge : edge->getInHEdges() ) {
+                const auto hyperEdge = inHEdge.lock();
+                const auto src = hyperEdge ? hyperEdge->getSrc().lock() : SharedNode{};
+                if ( src ) {
+                    visibleEdges.insert( hyperEdge.get() );
+                    visibleNodes.insert( src.get() );
+                }
+            }
+        _virtualNodeIndex.visit( box( viewport ), [&visibleNodes]( qan::Node* node, const gtpo::Box& ) {
+            visibleNodes.insert( node );
+        } );
+    }
+
+    beginGeometryUpdate();
+    // Release edges first: a released node is never referenced by a visible edge. Only primitives that
+    // had an item after previous update are visited, items still incubated are released on a next update
+    QSet<qan::Edge*> edgeItems;
+    for ( const auto edge : _virtualEdgeItems ) {
+        if ( visibleEdges.contains( edge ) )
+            continue;
+        if ( edge->getItem() != nullptr )
+            releaseEdgeItem( *edge );
+        else if ( _incubatingPrimitives.contains( edge ) )
+            edgeItems.insert( edge );
+    }
+    QSet<qan::Node*> nodeItems;
+    for ( const auto node : _virtualNodeItems ) {
+        if ( visibleNodes.contains( node ) )
+            continue;
+        if ( node->getItem() != nullptr ) {
+            if ( isVirtualPinned( *node ) )
+                nodeItems.insert( node );
+            else
+                releaseNodeItem( *node );
+        } else if ( _incubatingPrimitives.contains( node ) )
+            nodeItems.insert( node );
+    }
+
+    // Create missing delegates: nodes, edges and then hyper edges
+    for ( const auto node : visibleNodes ) {
+        if ( node->getItem() == nullptr )
+            createVirtualNodeItem( *node );
+        nodeItems.insert( node );
+    }
+    for ( const auto edge : visibleEdges )
+        if ( edge->getItem() == nullptr &&
+             edge->getHDst().expired() )
+            createVirtualEdgeItem( *edge );
+    for ( const auto edge : visibleEdges ) {
+        if ( edge->getItem() == nullptr )
+            createVirtualEdgeItem( *edge );
+        edgeItems.insert( edge );
+    }
+    _virtualNodeItems = nodeItems;
+    _virtualEdgeItems = edgeItems;
+    endGeometryUpdate();
+    if ( _nodeRenderer ) {
+        _nodeRenderer->setViewport( _virtualViewport );
+        _nodeRenderer->setZoom( _viewZoom );
+        _nodeRenderer->invalidate();
+    }
+    emit virtualItemsUpdated();
+}
+
+void    Graph::scheduleVirtualUpdate() noexcept
+{
+    if ( isDeferred() &&
+         !_virtualUpdateTimer.isActive() )
+        _virtualUpdateTimer.start();
+}
+
+void    Graph::setVirtualDelegate( QObject* primitive, QQmlComponent* component, qan::Style* style ) noexcept
+{
+    if ( primitive == nullptr )
+        return;
+    if ( !_virtualDelegates.contains( primitive ) )
+        connect( primitive, &QObject::destroyed,
+                 this,      [this]( QObject* destroyed ) { _virtualDelegates.remove( destroyed ); } );
+    _virtualDelegates.insert( primitive, VirtualDelegate{ component, style } );
+}
+
+bool    Graph::createVirtualNodeItem( qan::Node& node )
+{
+    const auto delegate = _virtualDelegates.value( &node );
+    auto nodeComponent = delegate.component.data();
+    if ( nodeComponent == nullptr ) {
+        nodeComponent = qan::Node::delegate(this);
+        if ( nodeComponent == nullptr )
+            nodeComponent = _nodeDelegate.get();
+    }
+    auto nodeStyle = qobject_cast<qan::NodeStyle*>( delegate.style.data() );
+    if ( nodeStyle == nullptr )
+        nodeStyle = qan::Node::style();
+    if ( nodeComponent == nullptr ||
+         nodeComponent->isError() ||
+         nodeStyle == nullptr ) {
+        qWarning() << "qan::Graph::createVirtualNodeItem(): Error: Can't find a valid node delegate component or style.";
+        return false;
+    }
+    const auto geometry = node.getGeometry();
+    if ( !configureNode( node, *nodeComponent, *nodeStyle ) )
+        return false;
+    node.setGeometry( geometry );
+    return true;
+}
+
+bool    Graph::createVirtualEdgeItem( qan::Edge& edge )
+{
+    const auto delegate = _virtualDelegates.value( &edge );
+    auto edgeComponent = delegate.component.data();
+    if ( edgeComponent == nullptr ) {
+        edgeComponent = qan::Edge::delegate(this);
+        if ( edgeComponent == nullptr )
+            edgeComponent = _edgeDelegate.get();
+    }
+    auto style = qobject_cast<qan::EdgeStyle*>( delegate.style.data() );
+    if ( style == nullptr )
+        style = qobject_cast<qan::EdgeStyle*>( qan::Edge::style() );
+    const auto src = edge.getSrc().lock();
+    const auto dstNode = edge.getDst().lock();
+    const auto dstEdge = edge.getHDst().lock();
+    if ( edgeComponent == nullptr ||
+         style == nullptr ||
+         !src ||
+         ( !dstNode && !dstEdge ) ) {
+        qWarning() << "qan::Graph::createVirtualEdgeItem(): Error: Invalid edge delegate, style or topology.";
+        return false;
+    }
+    return configureEdge( edge, *edgeComponent, *style,
+                          *src, dstNode.get(), dstEdge.get() );
+}
+
+void    Graph::releaseNodeItem( qan::Node& node )
+{
+    const auto nodeItem = node.getItem();
+    if ( nodeItem == nullptr )
+        return;
+    const auto geometry = node.getGeometry();
+    setVirtualDelegate( &node, _virtualDelegates.value( &node ).component, nodeItem->getStyle() );
+    recycleNodeItem( node );
+    node.setGeometry( geometry );
+}
+
+void    Graph::releaseEdgeItem( qan::Edge& edge )
+{
+    const auto edgeItem = edge.getItem();
+    if ( edgeItem == nullptr )
+        return;
+    setVirtualDelegate( &edge, _virtualDelegates.value( &edge ).component, edgeItem->getStyle() );
+    recycleEdgeItem( edge );
+}
+
+bool    Graph::isVirtualPinned( qan::Node& node ) const noexcept
+{
+    const auto nodeItem = node.getItem();
+    if ( nodeItem == nullptr )
+        return false;
+    return nodeItem->getSelected() ||
+           nodeItem->getDragged() ||
+           !node.getGroup().expired() ||
+           nodeItem->getLeftDock() != nullptr ||
+           nodeItem->getTopDock() != nullptr ||
+           nodeItem->getRightDock() != nullptr ||
+           nodeItem->getBottomDock() != nullptr;
+}
+//-----------------------------------------------------------------------------
+
+/* Lightweight Nodes Management *///-----------------------------------------
+void    Graph::setLightweightNodes( bool lightweightNodes ) noexcept
+{
+    if ( lightweightNodes == _lightweightNodes )
+        return;
+    _lightweightNodes = lightweightNodes;
+    if ( _lightweightNodes &&
+         !_nodeRenderer ) {
+        _nodeRenderer = new qan::NodeRenderer{};
+        _nodeRenderer->setParent( this );
+        _nodeRenderer->setParentItem( getContainerItem() );
+        _nodeRenderer->setZ( -1. );     // Below node and edge items
+        _nodeRenderer->setGraph( this );
+        connect( _nodeRenderer, &qan::NodeRenderer::nodeHovered,
+                 this,          &qan::Graph::lightweightNodeHovered );
+        connect( _nodeRenderer, &qan::NodeRenderer::nodePressed,
+                 this,          &qan::Graph::lightweightNodePressed );
+        emit nodeRendererChanged();
+    }
+    if ( !_lightweightNodes ) {
+        _hoveredNode.clear();
+        _promotedNodes.clear();
+    }
+    resetVirtualIndex();
+    if ( isDeferred() )
+        scheduleVirtualUpdate();
+    else
+        createMissingItems();
+    if ( _nodeRenderer )    // Renderer draw nothing when lightweight nodes are disabled
+        _nodeRenderer->invalidate();
+    emit lightweightNodesChanged();
+}
+
+void    Graph::setPromotionZoom( qreal promotionZoom ) noexcept
+{
+    if ( !qFuzzyCompare( 1. + promotionZoom, 1. + _promotionZoom ) ) {
+        _promotionZoom = promotionZoom;
+        emit promotionZoomChanged();
+        scheduleVirtualUpdate();
+    }
+}
+
+void    Graph::setViewZoom( qreal viewZoom ) noexcept
+{
+    if ( !qFuzzyCompare( 1. + viewZoom, 1. + _viewZoom ) ) {
+        _viewZoom = viewZoom;
+        _lod.setZoom( viewZoom );
+        emit viewZoomChanged();
+        scheduleVirtualUpdate();
+    }
+}
+
+void    Graph::promoteNode( qan::Node* node ) noexcept
+{
+    if ( node == nullptr ||
+         _promotedNodes.contains( node ) )
+        return;
+    _promotedNodes.insert( node );
+    connect( node, &QObject::destroyed,
+             this, [this]( QObject* destroyed ) { _promotedNodes.remove( destroyed ); } );
+    scheduleVirtualUpdate();
+}
+
+void    Graph::demoteNode( qan::Node* node ) noexcept
+{
+    if ( node != nullptr &&
+         _promotedNodes.remove( node ) )
+        scheduleVirtualUpdate();
+}
+
+bool    Graph::isPromoted( const qan::Node& node ) const noexcept
+{
+    return _promotedNodes.contains( &node ) ||
+           &node == _hoveredNode.data() ||
+           ( _viewZoom >= _promotionZoom &&
+             _virtualViewport.intersects( node.getGeometry() ) );
+}
+
+void    Graph::lightweightNodeHovered( qan::Node* node ) noexcept
+{
+    _hoveredNode = node;
+    scheduleVirtualUpdate();
+}
+
+void    Graph::lightweightNodePressed( qan::Node* node, QPointF pos, Qt::MouseButton button, Qt::KeyboardModifiers modifiers ) noexcept
+{
+    if ( node == nullptr )
+        return;
+    _hoveredNode = node;
+    updateVirtualItems();   // Create node item synchronously, a selected node item is never released
+    const auto itemPos = pos - node->getGeometry().topLeft();
+    if ( button == Qt::LeftButton ) {
+        if ( node->getItem() != nullptr )
+            selectNode( *node, modifiers );
+        emit nodeClicked( node, itemPos );
+    } else if ( button == Qt::RightButton )
+        emit nodeRightClicked( node, itemPos );
+}
+//-----------------------------------------------------------------------------
+
+/* Asynchronous Delegate Management *///-------------------------------------
+/*! \brief Incubate a node, edge or group delegate, primitive is bound to its item when incubation is finished.
+ *
+ * Item side properties (node, edge, group, graph and style) are set in setInitialState() so that
+ * they are available in delegate bindings, primitive item is set only once incubation is finished:
+ * a primitive never reference an incomplete item.
+ */
+class Graph::DelegateIncubator : public QQmlIncubator
+{
+public:
+    DelegateIncubator( qan::Graph& graph, QQmlComponent& component, qan::Style& style,
+                       qan::Node* node, qan::Edge* edge, qan::Group* group ) noexcept :
+        QQmlIncubator{ QQmlIncubator::Asynchronous },
+        _graph{ graph }, _component{ &component }, _style{ &style },
+        _node{ node }, _edge{ edge }, _group{ group },
+        _primitiveKey{ node != nullptr ? static_cast<QObject*>( node ) :
+                       edge != nullptr ? static_cast<QObject*>( edge ) : static_cast<QObject*>( group ) } { }
+    DelegateIncubator( const DelegateIncubator& ) = delete;
+
+    //! Primitive whose item is incubated (nullptr if primitive has been destroyed during incubation).
+    inline QObject*         getPrimitive() const noexcept {
+        return _node ? static_cast<QObject*>( _node.data() ) :
+               _edge ? static_cast<QObject*>( _edge.data() ) : static_cast<QObject*>( _group.data() );
+    }
+    //! Address of the primitive given at construction, valid as a key only (primitive might have been destroyed).
+    inline const QObject*   getPrimitiveKey() const noexcept { return _primitiveKey; }
+    inline QQmlComponent*   getComponent() const noexcept { return _component.data(); }
+    inline qan::Style*      getStyle() const noexcept { return _style.data(); }
+    inline qan::Node*       getNode() const noexcept { return _node.data(); }
+    inline qan::Edge*       getEdge() const noexcept { return _edge.data(); }
+    inline qan::Group*      getGroup() const noexcept { return _group.data(); }
+
+protected:
+    virtual void    setInitialState( QObject* object ) override {
+        if ( _node ) {
+            const auto nodeItem = qobject_cast<qan::NodeItem*>( object );
+            if ( nodeItem != nullptr ) {
+                nodeItem->setNode( _node.data() );
+                nodeItem->setGraph( &_graph );
+                nodeItem->setStyle( qobject_cast<qan::NodeStyle*>( _style.data() ) );
+            }
+        } else if ( _edge ) {
+            const auto edgeItem = qobject_cast<qan::EdgeItem*>( object );
+            if ( edgeItem != nullptr ) {
+                edgeItem->setEdge( _edge.data() );
+                edgeItem->setGraph( &_graph );
+            }
+        } else if ( _group ) {
+            const auto groupItem = qobject_cast<qan::GroupItem*>( object );
+            if ( groupItem != nullptr ) {
+                groupItem->setGroup( _group.data() );
+                groupItem->setGraph( &_graph );
+            }
+        }
+    }
+    virtual void    statusChanged( Status status ) override {
+        if ( status == QQmlIncubator::Ready ||
+             status == QQmlIncubator::Error )
+            _graph.incubatorFinished( *this );
+    }
+
+private:
+    qan::Graph&             _graph;
+    QPointer<QQmlComponent> _component;
+    QPointer<qan::Style>    _style;
+    QPointer<qan::Node>     _node;
+    QPointer<qan::Edge>     _edge;
+    QPointer<qan::Group>    _group;
+    const QObject*          _primitiveKey{ nullptr };
+};
+
+void    Graph::setAsynchronous( bool asynchronous ) noexcept
+{
+    if ( asynchronous != _asynchronous ) {
+        _asynchronous = asynchronous;
+        emit asynchronousChanged();
+    }
+}
+
+void    Graph::setIncubationBudget( int incubationBudget ) noexcept
+{
+    incubationBudget = std::max( 1, incubationBudget );
+    if ( incubationBudget != _incubationBudget ) {
+        _incubationBudget = incubationBudget;
+        emit incubationBudgetChanged();
+    }
+}
+
+void    Graph::completeIncubation()
+{
+    // Note: incubators created while completing (from delegates Component.onCompleted for example) are appended and completed too
+    for ( const auto& incubator : _incubators )
+        if ( incubator->isLoading() )
+            incubator->forceCompletion();
+}
+
+bool    Graph::incubateItem( QQmlComponent& component, qan::Style& style,
+                             qan::Node* node, qan::Edge* edge, qan::Group* group ) noexcept
+{
+    const QObject* primitive = node != nullptr ? static_cast<QObject*>( node ) :
+                               edge != nullptr ? static_cast<QObject*>( edge ) : static_cast<QObject*>( group );
+    if ( primitive == nullptr )
+        return false;
+    {   // Item already requested (virtualized graph), ignore stale entries for a destroyed primitive at the same address
+        const auto incubating = _incubatingPrimitives.value( primitive, nullptr );
+        if ( incubating != nullptr &&
+             incubating->getPrimitive() == primitive )
+            return true;
+    }
+
+    QQuickItem* item = _itemPool.acquire( &component ); // Pooled items are cheap to reuse: no incubation necessary
+    if ( item != nullptr ) {
+        const auto geometry = node != nullptr ? node->getGeometry() : QRectF{};
+        configureComponentItem( item, &component, style, node, edge, group );
+        item->setVisible( true );
+        item->setParentItem( getContainerItem() );
+        _itemPool.notifyReused( item );
+        if ( node != nullptr ) {
+            node->setGeometry( geometry );
+            configureNodeItem( *node, *static_cast<qan::NodeItem*>( item ) );
+        } else if ( edge != nullptr )
+            configureEdgeItem( *edge, *static_cast<qan::EdgeItem*>( item ) );
+        else if ( group != nullptr )
+            configureGroupItem( *group, *static_cast<qan::GroupItem*>( item ) );
+        return true;
+    }
+
+    const auto context = qmlContext( this );
+    if ( context == nullptr ||
+         context->engine() == nullptr ) {
+        qWarning() << "qan::Graph::incubateItem(): Error: Can't access to local QML context.";
+        return false;
+    }
+    if ( !component.isReady() ) {
+        qWarning() << "qan::Graph::incubateItem(): Error: Delegate component is not ready:" << component.errors();
+        return false;
+    }
+    const auto engine = context->engine();
+    if ( engine->incubationController() == nullptr ) {  // Without controller, QML engine incubate synchronously
+        _incubationController = std::make_unique<QQmlIncubationController>();
+        engine->setIncubationController( _incubationController.get() );
+    }
+
+    _incubators.emplace_back( std::make_unique<DelegateIncubator>( *this, component, style, node, edge, group ) );
+    _incubatingPrimitives.insert( primitive, _incubators.back().get() );
+    ++_pendingItemCount;
+    emit pendingItemCountChanged();
+    component.create( *_incubators.back(), context );  // Note: incubator might be finished synchronously, see incubatorFinished()
+    scheduleIncubation();
+    return true;
+}
+
+void    Graph::incubatorFinished( DelegateIncubator& incubator ) noexcept
+{
+    // Note: use primitive key, primitive guard is null when primitive has been removed during incubation
+    const auto primitiveKey = incubator.getPrimitiveKey();
+    if ( _incubatingPrimitives.value( primitiveKey, nullptr ) == &incubator )
+        _incubatingPrimitives.remove( primitiveKey );
+    QObject* object = incubator.isReady() ? incubator.object() : nullptr;
+    const auto item = qobject_cast<QQuickItem*>( object );
+    if ( incubator.isError() )
+        qWarning() << "qan::Graph::incubatorFinished(): Error: Delegate incubation failed:" << incubator.errors();
+    else if ( item == nullptr ||
+              incubator.getPrimitive() == nullptr ||   // Primitive has been removed during incubation
+              incubator.getComponent() == nullptr ||
+              incubator.getStyle() == nullptr ) {
+        if ( object != nullptr )
+            object->deleteLater();
+    } else {
+        QQmlEngine::setObjectOwnership( item, QQmlEngine::CppOwnership );
+        const auto node = incubator.getNode();
+        const auto edge = incubator.getEdge();
+        const auto group = incubator.getGroup();
+        const auto geometry = node != nullptr ? node->getGeometry() : QRectF{};   // Placeholder geometry
+        item->setVisible( true );
+        item->setParentItem( getContainerItem() );
+        _itemPool.track( item, incubator.getComponent() );
+        configureComponentItem( item, incubator.getComponent(), *incubator.getStyle(), node, edge, group );
+        if ( node != nullptr ) {
+            node->setGeometry( geometry );
+            configureNodeItem( *node, *static_cast<qan::NodeItem*>( item ) );
+        } else if ( edge != nullptr )
+            configureEdgeItem( *edge, *static_cast<qan::EdgeItem*>( item ) );
+        else if ( group != nullptr )
+            configureGroupItem( *group, *static_cast<qan::GroupItem*>( item ) );
+    }
+    --_pendingItemCount;
+    emit pendingItemCountChanged();
+    if ( _pendingItemCount == 0 )
+        emit itemsIncubated();
+}
+
+void    Graph::incubateFrame() noexcept
+{
+    if ( _incubators.empty() )
+        return;
+    const auto engine = qmlEngine( this );
+    if ( engine != nullptr &&
+         engine->incubationController() != nullptr &&
+         _pendingItemCount > 0 )
+        engine->incubationController()->incubateFor( _incubationBudget );
+    // Incubators can't be destroyed from their statusChanged(), finished incubators are released once per frame
+    _incubators.remove_if( []( const std::unique_ptr<DelegateIncubator>& incubator ) {
+        return !incubator->isLoading();
+    } );
+    scheduleIncubation();
+}
+
+void    Graph::scheduleIncubation() noexcept
+{
+    if ( _incubators.empty() )
+        return;
+    const auto quickWindow = window();
+    if ( quickWindow != nullptr ) {
+        if ( _incubationWindow != quickWindow ) {
+            if ( _incubationWindow )
+                disconnect( _incubationWindow.data(), &QQuickWindow::afterAnimating, this, &Graph::incubateFrame );
+            _incubationWindow = quickWindow;
+            connect( quickWindow, &QQuickWindow::afterAnimating, this, &Graph::incubateFrame );
+        }
+        quickWindow->update();  // Request a new frame, incubation is done when it starts
+    } else if ( !_incubationTimer.isActive() )
+        _incubationTimer.start();
+}
+
+void    Graph::clearIncubation() noexcept
+{
+    _incubators.clear();    // Pending incubations are aborted, finished items are already bound to their primitives
+    _incubatingPrimitives.clear();
+    if ( _pendingItemCount != 0 ) {
+        _pendingItemCount = 0;
+        emit pendingItemCountChanged();
+    }
+}
+//-----------------------------------------------------------------------------
+
+/* Batched Edge Rendering Management *///------------------------------------
+void    Graph::setBatchedEdges( bool batchedEdges ) noexcept
+{
+    if ( batchedEdges == _batchedEdges )
+        return;
+    _batchedEdges = batchedEdges;
+    if ( _batchedEdges ) {
+        if ( !_batchedEdgeDelegate )
+            _batchedEdgeDelegate = createComponent( QStringLiteral("qrc:/QuickQanava/BatchedEdge.qml") );
+        if ( !_edgeRenderer ) {     // Note: renderer is kept when batching is disabled, it still draw existing batched edges
+            _edgeRenderer = new qan::EdgeRenderer{};
+            _edgeRenderer->setParent( this );
+            _edgeRenderer->setParentItem( getContainerItem() );
+            emit edgeRendererChanged();
+        }
+    }
+    emit batchedEdgesChanged();
+}
+
+QQmlComponent&  Graph::getBatchedEdgeComponent( QQmlComponent& edgeComponent ) noexcept
+{
+    static const QUrl defaultEdgeUrl{ QStringLiteral("qrc:/QuickQanava/Edge.qml") };
+    if ( _batchedEdges &&
+         _batchedEdgeDelegate &&
+         !_batchedEdgeDelegate->isError() &&
+         edgeComponent.url() == defaultEdgeUrl )
+        return *_batchedEdgeDelegate;
+    return edgeComponent;
+}
+//-----------------------------------------------------------------------------
+
+/* Item Recycling Management *///----------------------------------------------
+void    Graph::recycleNodeItem( qan::Node& node ) noexcept
+{
+    const auto nodeItem = node.getItem();
+    if ( nodeItem == nullptr )
+        return;
+    const auto group = node.getGroup().lock();
+    if ( group &&
+         group->getItem() != nullptr )
+        group->getItem()->ungroupNodeItem( nodeItem );  // Restore container parent and drag configuration
+    node.setItem( nullptr );
+    unindexItem( nodeItem );
+    disconnect( nodeItem, nullptr, this, nullptr );     // Click and geometry notifications, see configureNode() and indexItem()
+    _itemPool.recycle( nodeItem );
+}
+
+void    Graph::recycleEdgeItem( qan::Edge& edge ) noexcept
+{
+    const auto edgeItem = edge.getItem();
+    if ( edgeItem == nullptr )
+        return;
+    edge.setItem( nullptr );
+    unindexItem( edgeItem );
+    if ( _edgeRenderer )
+        _edgeRenderer->removeEdge( edgeItem );
+    disconnect( edgeItem, nullptr, this, nullptr );     // Click and geometry notifications, see configureEdge() and indexItem()
+    _itemPool.recycle( edgeItem );
+}
+
+void    Graph::recycleEdgeItems( qan::Edge& edge ) noexcept
+{
+    for ( const auto& inHEdge : edge.getInHEdges() )
+        if ( const auto hEdge = inHEdge.lock() )
+            recycleEdgeItems( *hEdge );
+    recycleEdgeItem( edge );
+}
+
+void    Graph::recycleGroupItem( qan::Group& group ) noexcept
+{
+    const auto groupItem = group.getItem();
+    if ( groupItem == nullptr )
+        return;
+    group.setItem( nullptr );
+    unindexItem( groupItem );
+    disconnect( groupItem, nullptr, this, nullptr );    // Click and geometry notifications, see insertGroup() and indexItem()
+    _itemPool.recycle( groupItem );
+}
+
+void    Graph::recycleSelectionItem( QQuickItem* selectionItem ) noexcept
+{
+    if ( selectionItem != nullptr )
+        _itemPool.recycle( selectionItem );
+}
+//-----------------------------------------------------------------------------
+
+/* Spatial Index Management *///-----------------------------------------------
+void    Graph::indexItem( QQuickItem* item, ItemIndex& index ) noexcept
+{
+    if ( item == nullptr ||
+         index.contains( item ) )
+        return;
+    try {
+        index.insert( item, getItemBox( *item ) );
+    } catch ( const std::exception& e ) {
+        qWarning() << "qan::Graph::indexItem(): Error: " << e.what();
+        return;
+    }
+    const auto markDirty = [this, item]() { _dirtyIndexItems.insert( item ); };
+    connect( item, &QQuickItem::xChanged,       this, markDirty );
+    connect( item, &QQuickItem::yChanged,       this, markDirty );
+    connect( item, &QQuickItem::widthChanged,   this, markDirty );
+    connect( item, &QQuickItem::heightChanged,  this, markDirty );
+    connect( item, &QQuickItem::parentChanged,  this, markDirty );  // Grouped and ungrouped nodes
+    connect( item, &QObject::destroyed,         this, [this, item]() { unindexItem( item ); } );
+}
+
+void    Graph::unindexItem( QQuickItem* item ) const noexcept
+{
+    _dirtyIndexItems.remove( item );
+    if ( !_nodeIndex.remove( item ) &&
+         !_edgeIndex.remove( item ) )
+        _groupIndex.remove( item );
+}
+
+void    Graph::flushSpatialIndex() const noexcept
+{
+    if ( _dirtyIndexItems.isEmpty() )
+        return;
+    // Grouped node and sub group items move with their group item, without any change in their own position
+    std::vector<QQuickItem*> movedItems( _dirtyIndexItems.cbegin(), _dirtyIndexItems.cend() );
+    while ( !movedItems.empty() ) {
+        const auto groupItem = qobject_cast<qan::GroupItem*>( movedItems.back() );
+        movedItems.pop_back();
+        if ( groupItem != nullptr &&
+             groupItem->getContainer() != nullptr )
+            for ( const auto groupChild : groupItem->getContainer()->childItems() ) {
+                if ( _nodeIndex.contains( groupChild ) )
+                    _dirtyIndexItems.insert( groupChild );
+                else if ( _groupIndex.contains( groupChild ) &&
+                          !_dirtyIndexItems.contains( groupChild ) ) {
+                    _dirtyIndexItems.insert( groupChild );
+                    movedItems.push_back( groupChild );     // Nested group content moves too
+                }
+            }
+    }
+    try {
+        for ( const auto item : _dirtyIndexItems ) {
+            const auto box = getItemBox( *item );
+            if ( _nodeIndex.contains( item ) ) {
+                _nodeIndex.update( item, box );
+                const auto nodeItem = isDeferred() ? qobject_cast<qan::NodeItem*>( item ) : nullptr;
+                if ( nodeItem != nullptr &&
+                     nodeItem->getNode() != nullptr )
+                    _dirtyVirtualNodes.insert( nodeItem->getNode() );
+            }
+            else if ( _edgeIndex.contains( item ) )
+                _edgeIndex.update( item, box );
+            else if ( _groupIndex.contains( item ) )
+                _groupIndex.update( item, box );
+        }
+    } catch ( const std::exception& e ) {
+        qWarning() << "qan::Graph::flushSpatialIndex(): Error: " << e.what();
+    }
+    _dirtyIndexItems.clear();
+}
+
+gtpo::Box   Graph::getItemBox( const QQuickItem& item ) const noexcept
+{
+    QRectF rect{ item.position(), QSizeF{ std::max( 0., item.width() ), std::max( 0., item.height() ) } };
+    const auto container = getContainerItem();
+    if ( container != nullptr &&
+         item.parentItem() != nullptr &&
+         item.parentItem() != container )   // Map grouped items to container coordinates
+        rect = item.parentItem()->mapRectToItem( container, rect );
+    return gtpo::Box::fromRect( rect.x(), rect.y(), rect.width(), rect.height() );
+}
+//-----------------------------------------------------------------------------
+
 /* Selection Management *///---------------------------------------------------
 void    Graph::setSelectionPolicy( SelectionPolicy selectionPolicy ) noexcept
 {
@@ -933,6 +2215,7 @@ void    Graph::clearSelection()
              group->getItem() != nullptr )
             group->getItem()->setSelected(false);
     _selectedGroups.clear();
+    scheduleVirtualUpdate();    // Deselected node items might be released
 }
 
 void    Graph::mousePressEvent( QMouseEvent* event )
@@ -950,6 +2233,40 @@ void    Graph::mousePressEvent( QMouseEvent* event )
 //-----------------------------------------------------------------------------
 
 
+/* Level of Detail Management *///-------------------------------------------
+void    Graph::applyLevelOfDetail()
+{
+    const auto changedDetails = _lod.getChangedDetails();
+    if ( changedDetails & qan::LevelOfDetail::Docks ) {
+        const bool showDocks = _lod.getShowDocks();
+        for ( const auto& node : getNodes() ) {
+            const auto nodeItem = node ? node->getItem() : nullptr;
+            if ( nodeItem != nullptr )
+                for ( const auto dock : { qan::NodeItem::Dock::Left, qan::NodeItem::Dock::Top,
+                                          qan::NodeItem::Dock::Right, qan::NodeItem::Dock::Bottom } ) {
+                    const auto dockItem = nodeItem->getDock( dock );
+                    if ( dockItem != nullptr )
+                        dockItem->setVisible( showDocks );
+                }
+        }
+    }
+    if ( changedDetails & qan::LevelOfDetail::Curves ) {     // Only curved edges geometry is modified
+        std::vector<qan::EdgeItem*> curvedEdgeItems;
+        for ( const auto& edge : getEdges() ) {
+            const auto edgeItem = edge ? edge->getItem() : nullptr;
+            if ( edgeItem != nullptr &&
+                 edgeItem->getStyle() != nullptr &&
+                 edgeItem->getStyle()->getLineType() == qan::EdgeStyle::LineType::Curved )
+                curvedEdgeItems.push_back( edgeItem );
+        }
+        qan::EdgeItem::updateItems( curvedEdgeItems );
+    }
+    if ( _edgeRenderer &&
+         ( changedDetails & ( qan::LevelOfDetail::Arrows | qan::LevelOfDetail::Curves ) ) )
+        _edgeRenderer->invalidateEdges();
+}
+//-----------------------------------------------------------------------------
+
 /* Port/Dock Management *///---------------------------------------------------
 qan::PortItem*  Graph::insertInPort(qan::Node* node, qan::NodeItem::Dock dockType, QString label) noexcept
 {
@@ -1061,23 +2378,29 @@ QPointer<QQuickItem> Graph::createDockFromDelegate(qan::NodeItem::Dock dock, qan
     if ( dock == Dock::Left ||
          dock == Dock::Right ) {
         if ( _verticalDockDelegate ) {
-            auto verticalDock = createItemFromComponent(_verticalDockDelegate.get());;
-            verticalDock->setParentItem(node.getItem());
-            verticalDock->setProperty("hostNodeItem",
-                                      QVariant::fromValue(node.getItem()));
-            verticalDock->setProperty("dockType",
-                                      QVariant::fromValue(dock));
+            auto verticalDock = createItemFromComponent(_verticalDockDelegate.get());
+            if ( verticalDock != nullptr ) {     // Delegate might fail to instantiate
+                verticalDock->setParentItem(node.getItem());
+                verticalDock->setProperty("hostNodeItem",
+                                          QVariant::fromValue(node.getItem()));
+                verticalDock->setProperty("dockType",
+                                          QVariant::fromValue(dock));
+                verticalDock->setVisible(_lod.getShowDocks());
+            }
             return verticalDock;
         }
     } else if ( dock == Dock::Top ||
                 dock == Dock::Bottom ) {
         if ( _horizontalDockDelegate ) {
             auto horizontalDock = createItemFromComponent(_horizontalDockDelegate.get());
-            horizontalDock->setParentItem(node.getItem());
-            horizontalDock->setProperty("hostNodeItem",
-                                        QVariant::fromValue(node.getItem()));
-            horizontalDock->setProperty("dockType",
-                                        QVariant::fromValue(dock));
+            if ( horizontalDock != nullptr ) {     // Delegate might fail to instantiate
+                horizontalDock->setParentItem(node.getItem());
+                horizontalDock->setProperty("hostNodeItem",
+                                            QVariant::fromValue(node.getItem()));
+                horizontalDock->setProperty("dockType",
+                                            QVariant::fromValue(dock));
+                horizontalDock->setVisible(_lod.getShowDocks());
+            }
             return horizontalDock;
         }
     }
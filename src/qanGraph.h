@@ -35,8 +35,14 @@
 #ifndef qanGraph_h
 #define qanGraph_h
 
+// Std headers
+#include <list>
+#include <memory>
+#include <vector>
+
 // GTpo headers
 #include <GTpo>
+#include <gtpoSpatialIndex.h>
 
 // QuickQanava headers
 #include "./qanUtils.h"
@@ -48,18 +54,28 @@
 #include "./qanNavigable.h"
 #include "./qanSelectable.h"
 #include "./qanConnector.h"
+#include "./qanItemPool.h"
+#include "./qanEdgeRenderer.h"
+#include "./qanNodeRenderer.h"
+#include "./qanLevelOfDetail.h"
 
 // Qt headers
 #include <QQuickItem>
+#include <QQuickWindow>
+#include <QQmlIncubator>
 #include <QQmlParserStatus>
 #include <QSharedPointer>
 #include <QAbstractListModel>
+#include <QTimer>
+#include <QHash>
+#include <QSet>
 
 //! Main QuickQanava namespace
 namespace qan { // ::qan
 
 class Graph;
 class PortItem;
+template < class Target > class ForwardingBehaviour;
 
 /*! \brief Main interface to manage graph topology.
  *
@@ -100,7 +116,15 @@ public:
      *
      */
     Q_INVOKABLE virtual void    qmlClearGraph() noexcept;
+    /*! \brief Clear this graph topology, styles and graph behaviours.
+     *
+     * Graph behaviours are destroyed without node or edge removal notifications, clients observing graph topology
+     * with a behaviour (see qan::ForwardingBehaviour) reinstall it when cleared() is emitted.
+     */
     void                        clear() noexcept;
+signals:
+    //! Emitted at the end of clear(), graph is then empty and has no graph behaviours.
+    void                        cleared();
 
 public:
     /*! \brief Similar to QQuickItem::childAt() method, except that it take edge bounding shape into account.
@@ -108,15 +132,30 @@ public:
      * Using childAt() method will most of the time return qan::Edge items since childAt() use bounding boxes
      * for item detection.
      *
+     * Candidates are found in graph spatial index in O(log n).
+     *
+     * \note Only node, edge and group items are returned: items added to graph container item that are not
+     * graph primitives delegates (for example user decorations) are not indexed and are ignored.
+     *
      * \return nullptr if there is no child at requested position, or a QQuickItem that can be casted qan::Node, qan::Edge or qan::Group with qobject_cast<>.
      */
     Q_INVOKABLE QQuickItem* graphChildAt(qreal x, qreal y) const;
 
-    /*! \brief Similar to QQuickItem::childAt() method, except that it only take groups into account (and is hence faster, but still O(n)).
+    /*! \brief Return the topmost group whose item fully contains rect (\c p, \c s) in container item coordinates, or nullptr.
      *
+     * Used for node drop target detection, groups are found in graph spatial index in O(log n).
      */
     Q_INVOKABLE qan::Group* groupAt( const QPointF& p, const QSizeF& s ) const;
 
+    /*! \brief Return node, edge and group items whose bounding box intersects \c rect (in container item coordinates).
+     *
+     * \note Only existing items are returned, nodes and edges with no item in a virtualized graph are ignored.
+     */
+    Q_INVOKABLE QVariantList    graphChildrenIn( const QRectF& rect ) const;
+
+    //! Return at most \c k nodes whose item bounding box is nearest to \c p (in container item coordinates), ordered by increasing distance.
+    Q_INVOKABLE QVariantList    nearestNodes( const QPointF& p, int k ) const;
+
 public:
     /*! \brief Quick item used as a parent for all graphics item "factored" by this graph (default to this).
      *
@@ -269,6 +308,11 @@ protected:
     //! Shortcut to createComponent(), mainly used in Qan.StyleList View to generate item for style pre visualization.
     Q_INVOKABLE QQuickItem* createFromComponent( QQmlComponent* component, qan::Style* style );
 
+private:
+    //! Bind an \c object created (or reused) from \c component to either \c node, \c edge or \c group (see createFromComponent()).
+    void                    configureComponentItem( QObject* object, QQmlComponent* component, qan::Style& style,
+                                                    qan::Node* node, qan::Edge* edge, qan::Group* group ) noexcept;
+
 public:
     /*! \brief QML component used to create qan::NodeItem or qan::GroupItem \c selectionItem, could be dynamically changed from either c++ or QML.
      *
@@ -342,6 +386,20 @@ public:
     template < class Node_t >
     qan::Node*              insertNonVisualNode();
 
+    /*! \brief Create a visual delegate for an existing non visual \c node (ie a node inserted with insertNonVisualNode<>()).
+     *
+     * Used to progressively instantiate delegates for large topologies (see qan::EdgeListLoader), default
+     * qan::Node::delegate() (or graph \c nodeDelegate) and qan::Node::style() are used when \c nodeComponent is nullptr.
+     * \return true if \c node item has been successfully created, false otherwise (or if \c node already has an item).
+     */
+    bool                    createNodeItem( qan::Node& node, QQmlComponent* nodeComponent = nullptr );
+private:
+    //! Internal utility used to create \c node graphical delegate using \c nodeComponent and \c nodeStyle.
+    bool                    configureNode( qan::Node& node, QQmlComponent& nodeComponent, qan::NodeStyle& nodeStyle );
+    //! Bind a created \c nodeItem to \c node, connect it to adjacent edges items and to its group item.
+    void                    configureNodeItem( qan::Node& node, qan::NodeItem& nodeItem );
+public:
+
     /*! \brief Remove node \c node from this graph. Shortcut to gtpo::GenGraph<>::removeNode().
      */
     Q_INVOKABLE void        removeNode( qan::Node* node );
@@ -400,10 +458,19 @@ private:
      */
     bool                    configureEdge( qan::Edge& source, QQmlComponent& edgeComponent, qan::EdgeStyle& style,
                                            qan::Node& src, qan::Node* dstNode, qan::Edge* dstEdge = nullptr );
+    //! Bind a created \c edgeItem to \c edge and connect it to its source and destination items.
+    void                    configureEdgeItem( qan::Edge& edge, qan::EdgeItem& edgeItem );
 public:
     template < class Edge_t >
     qan::Edge*              insertNonVisualEdge( qan::Node& src, qan::Node* dstNode, qan::Edge* dstEdge = nullptr );
 
+    /*! \brief Create a visual delegate for an existing non visual \c edge (ie an edge inserted with insertNonVisualEdge<>()).
+     *
+     * \c edge source and destination items must have been created before calling this method (see createNodeItem()).
+     * \return true if \c edge item has been successfully created, false otherwise (or if \c edge already has an item).
+     */
+    bool                    createEdgeItem( qan::Edge& edge, QQmlComponent* edgeComponent = nullptr );
+
 public:
     //! Shortcut to gtpo::GenGraph<>::removeEdge().
     Q_INVOKABLE void        removeEdge( qan::Node* source, qan::Node* destination );
@@ -454,19 +521,30 @@ public:
     //! Return true if \c group is registered in graph.
     bool                    hasGroup( qan::Group* group ) const;
 
+private:
+    //! Internal utility used to create \c group graphical delegate using \c groupComponent and \c style.
+    bool                    configureGroup( qan::Group& group, QQmlComponent& groupComponent, qan::Style& style );
+    //! Bind a created \c groupItem to \c group and group its existing nodes items.
+    void                    configureGroupItem( qan::Group& group, qan::GroupItem& groupItem );
+public:
+
     //! Shortcut to gtpo::GenGraph<>::getGroupCount().
     Q_INVOKABLE int         getGroupCount( ) const { return gtpo::GenGraph< qan::GraphConfig >::getGroupCount(); }
 
     //! \copydoc gtpo::GenGraph::groupNode()
     auto            groupNode( qan::Group* group, qan::Node* node, bool transformPosition = true ) noexcept(false) -> void;
 
-    //! \copydoc gtpo::GenGraph::groupNode()
-    auto            groupNode( qan::Group* group, qan::Group* node ) noexcept(false) -> void;
+    /*! \brief Nest group \c node in \c group (sub group item is reparented in \c group container item).
+     *
+     * Sub group position is transformed to \c group container coordinate system when \c transformPosition is true, grouping
+     * a group in one of its sub groups is an error. Nesting is available from sub group getGroup().
+     */
+    auto            groupNode( qan::Group* group, qan::Group* node, bool transformPosition = true ) noexcept(false) -> void;
 
     //! \copydoc gtpo::GenGraph::ungroupNode()
     auto            ungroupNode( Group* group, qan::Node* node ) noexcept(false) -> void;
 
-    //! \copydoc gtpo::GenGraph::ungroupNode()
+    //! Ungroup sub group \c node from \c group, sub group item is reparented in graph container item.
     auto            ungroupNode( Group* group, qan::Group* node ) noexcept(false) -> void;
 
 signals:
@@ -482,6 +560,472 @@ signals:
     //@}
     //-------------------------------------------------------------------------
 
+    /*! \name Batch Update Management *///-------------------------------------
+    //@{
+public:
+    /*! \brief Suspend edge geometry updates and nodes, edges and groups models notifications until a matching endBatchUpdate() call.
+     *
+     * Used when a large number of primitives are inserted or removed at once (see qan::SceneSerializer),
+     * calls might be nested. Use beginGeometryUpdate() when primitives are only moved or their items created.
+     */
+    void            beginBatchUpdate() noexcept;
+    /*! \brief Resume edge geometry updates and models notifications.
+     *
+     * All graph edges are updated once when the outer batch update ends, nodes, edges and groups models whose
+     * rows have been modified during the batch then notify a single model reset.
+     */
+    void            endBatchUpdate() noexcept;
+
+    /*! \brief Suspend edge geometry updates until a matching endGeometryUpdate() call (calls might be nested).
+     *
+     * Models notifications are not suspended, used when many nodes are moved at once (layouts) or when nodes
+     * and edges items are created or released (see updateVirtualItems()).
+     */
+    void            beginGeometryUpdate() noexcept;
+    //! Resume edge geometry updates, all graph edges are updated once when the outer geometry update ends.
+    void            endGeometryUpdate() noexcept;
+    //! Return true while a batch or geometry update is in progress.
+    inline bool     isBatchUpdating() const noexcept { return _batchUpdateDepth > 0; }
+
+    /*! \brief Register \c edgeItem for a geometry update in next polish pass (see qan::EdgeItem::invalidateGeometry()).
+     *
+     * Edges invalidated during a frame are updated at once by the first polished edge item with
+     * updateInvalidatedEdgeItems(), node moves and group drags then generate a single batched geometry update.
+     */
+    void            invalidateEdgeItem( qan::EdgeItem* edgeItem ) noexcept;
+    //! Update all edge items registered with invalidateEdgeItem() using qan::EdgeItem::updateItems().
+    void            updateInvalidatedEdgeItems() noexcept;
+private:
+    //! Return nodes, edges and groups models whose notifications are suspended during a batch update.
+    std::vector<qcm::AbstractContainerModel*>   getBatchedModels() const noexcept;
+    //! Nesting depth of batch and geometry updates (edge geometry updates are suspended while not 0).
+    int             _batchUpdateDepth{0};
+    //! Nesting depth of batch updates (models notifications are suspended while not 0).
+    int             _batchModelsDepth{0};
+    //! Edge items invalidated since last update, keyed by item so that an item is registered once per update pass.
+    QHash<const qan::EdgeItem*, QPointer<qan::EdgeItem>>    _invalidatedEdgeItems;
+signals:
+    //! Emitted when the outer batch update ends, after all edges have been updated.
+    void            batchUpdateFinished();
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Virtualization Management *///-----------------------------------
+    //@{
+public:
+    /*! \brief When true, node and edge delegates are created only for primitives visible in \c virtualViewport (default to false).
+     *
+     * In a virtualized graph, insertNode() and insertEdge() insert non visual primitives: node geometry is
+     * stored in qan::Node (see qan::Node::setGeometry()), visual delegates are created when primitives
+     * intersect \c virtualViewport extended by \c virtualMargin, and released when they scroll away. Memory
+     * and delegate creation time then scale with the viewport instead of graph size. Qan.GraphView
+     * automatically update \c virtualViewport when the view is panned, zoomed or resized.
+     *
+     * An edge is materialized (with its source and destination nodes) when the bounding rectangle of its
+     * end points intersects viewport. Selected or dragged nodes, grouped nodes and nodes with ports are never
+     * released. Since node items might not exist, code using a virtualized graph should use qan::Node::getGeometry()
+     * instead of qan::Node::getItem().
+     *
+     * Switching virtualization off creates all missing delegates.
+     */
+    Q_PROPERTY( bool virtualized READ getVirtualized WRITE setVirtualized NOTIFY virtualizedChanged FINAL )
+    //! \copydoc virtualized
+    inline bool     getVirtualized() const noexcept { return _virtualized; }
+    //! \copydoc virtualized
+    void            setVirtualized( bool virtualized ) noexcept;
+private:
+    //! \copydoc virtualized
+    bool            _virtualized{ false };
+signals:
+    //! \copydoc virtualized
+    void            virtualizedChanged();
+
+public:
+    //! Visible rectangle in graph container item coordinate system (usually set from Qan.GraphView).
+    Q_PROPERTY( QRectF virtualViewport READ getVirtualViewport WRITE setVirtualViewport NOTIFY virtualViewportChanged FINAL )
+    //! \copydoc virtualViewport
+    inline QRectF   getVirtualViewport() const noexcept { return _virtualViewport; }
+    //! \copydoc virtualViewport
+    void            setVirtualViewport( const QRectF& virtualViewport ) noexcept;
+private:
+    //! \copydoc virtualViewport
+    QRectF          _virtualViewport{};
+signals:
+    //! \copydoc virtualViewport
+    void            virtualViewportChanged();
+
+public:
+    //! Margin added around \c virtualViewport to avoid creating delegates on small pans (default to 200.).
+    Q_PROPERTY( qreal virtualMargin READ getVirtualMargin WRITE setVirtualMargin NOTIFY virtualMarginChanged FINAL )
+    //! \copydoc virtualMargin
+    inline qreal    getVirtualMargin() const noexcept { return _virtualMargin; }
+    //! \copydoc virtualMargin
+    void            setVirtualMargin( qreal virtualMargin ) noexcept;
+private:
+    //! \copydoc virtualMargin
+    qreal           _virtualMargin{ 200. };
+signals:
+    //! \copydoc virtualMargin
+    void            virtualMarginChanged();
+
+public:
+    /*! \brief Synchronize node and edge delegates with \c virtualViewport.
+     *
+     * Updates are automatically scheduled (and coalesced) on viewport change or primitive insertion, calling this
+     * method is necessary only to access delegates synchronously.
+     */
+    Q_INVOKABLE void    updateVirtualItems();
+    //! Schedule an updateVirtualItems() on next event loop iteration (multiple requests are coalesced, no-op if graph is not virtualized).
+    void                scheduleVirtualUpdate() noexcept;
+signals:
+    //! Emitted when delegates have been synchronized with \c virtualViewport.
+    void                virtualItemsUpdated();
+
+private:
+    //! Register \c primitive delegate component and style, used when its item is created in a virtualized graph.
+    void                setVirtualDelegate( QObject* primitive, QQmlComponent* component, qan::Style* style ) noexcept;
+    //! Create \c node item from its virtual delegate and restore its geometry.
+    bool                createVirtualNodeItem( qan::Node& node );
+    //! Create \c edge item from its virtual delegate.
+    bool                createVirtualEdgeItem( qan::Edge& edge );
+    //! Save \c node geometry and style and recycle its item.
+    void                releaseNodeItem( qan::Node& node );
+    //! Save \c edge style and recycle its item.
+    void                releaseEdgeItem( qan::Edge& edge );
+    //! Return true if \c node item should not be released.
+    bool                isVirtualPinned( qan::Node& node ) const noexcept;
+
+    //! Delegate component and style used to create a primitive item.
+    struct VirtualDelegate {
+        QPointer<QQmlComponent> component;
+        QPointer<qan::Style>    style;
+    };
+    //! Virtual delegates indexed by node or edge (entries are removed when primitives are destroyed).
+    QHash<const QObject*, VirtualDelegate>  _virtualDelegates;
+    QTimer                                  _virtualUpdateTimer;
+
+public:
+    //! Return style of a \c primitive that has no item (or nullptr if \c primitive style is the default one).
+    inline qan::Style*  getVirtualStyle( const QObject* primitive ) const noexcept { return _virtualDelegates.value( primitive ).style.data(); }
+private:
+    //! Return true if primitive items are created on demand (ie graph is virtualized or use lightweight nodes).
+    inline bool         isDeferred() const noexcept { return _virtualized || _lightweightNodes; }
+    //! Create all missing node and edge delegates.
+    void                createMissingItems();
+
+public:
+    //! Notify graph that \c node geometry has been modified while it has no item (called from qan::Node::setGeometry()).
+    void                invalidateVirtualGeometry( qan::Node* node ) noexcept;
+private:
+    template < class Target > friend class qan::ForwardingBehaviour;
+    //! Called from graph behaviour when a node is inserted, its geometry is indexed on next virtual update.
+    void                nodeInserted( qan::Node* node );
+    //! Called from graph behaviour before a node is removed.
+    void                nodeRemoved( qan::Node* node );
+    //! Called from graph behaviour when an edge is inserted, its geometry is indexed on next virtual update.
+    void                edgeInserted( qan::Edge* edge );
+    //! Called from graph behaviour before an edge is removed.
+    void                edgeRemoved( qan::Edge* edge );
+
+    /*! \brief Index all nodes and edges geometry and collect nodes and edges with an item (called when graph become deferred or is cleared).
+     *
+     * Virtual indexes are cleared when graph is not deferred.
+     */
+    void                resetVirtualIndex() noexcept;
+    //! Update virtual indexes boxes of nodes and edges modified since last virtual update.
+    void                flushVirtualIndex() noexcept;
+
+    /*! \brief Nodes geometry and edges end points bounding rect (only maintained when graph is deferred).
+     *
+     * updateVirtualItems() query indexes with \c virtualViewport: an update cost is proportional to visible (and previously
+     * visible) primitives, not to graph size.
+     */
+    gtpo::SpatialIndex<qan::Node*>  _virtualNodeIndex;
+    gtpo::SpatialIndex<qan::Edge*>  _virtualEdgeIndex;
+    //! Nodes whose geometry has changed since last virtual update (node items moves are collected in flushSpatialIndex()).
+    mutable QSet<qan::Node*>        _dirtyVirtualNodes;
+    QSet<qan::Edge*>                _dirtyVirtualEdges;
+    //! Nodes and edges that have (or might soon have) an item, candidates for release in updateVirtualItems().
+    QSet<qan::Node*>                _virtualNodeItems;
+    QSet<qan::Edge*>                _virtualEdgeItems;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Lightweight Nodes Management *///-------------------------------
+    //@{
+public:
+    /*! \brief When true, nodes are drawn by a batched qan::NodeRenderer and promoted to their QML delegate only when necessary (default to false).
+     *
+     * With thousands of simple rectangular nodes, a full QML item tree per node is too expensive: a lightweight
+     * node has no item, its geometry, label and style background and border are drawn by \c nodeRenderer with a
+     * few scene graph nodes. A node is promoted to its real QML delegate when it is:
+     * \li hovered or pressed (a pressed node is then selected).
+     * \li explicitly promoted with promoteNode(), for example while it is edited.
+     * \li visible in \c virtualViewport while \c viewZoom is greater than \c promotionZoom.
+     *
+     * Promoted nodes are demoted once these conditions are no longer met, unless they are selected, dragged,
+     * grouped or have ports (see \c virtualized). Edges have an item only when both their end points are promoted,
+     * other edges are drawn by \c nodeRenderer as straight lines. Since node items might not exist, code using
+     * lightweight nodes should use qan::Node::getGeometry() instead of qan::Node::getItem().
+     *
+     * Lightweight nodes work with or without \c virtualized, switching both off creates all missing delegates.
+     */
+    Q_PROPERTY( bool lightweightNodes READ getLightweightNodes WRITE setLightweightNodes NOTIFY lightweightNodesChanged FINAL )
+    //! \copydoc lightweightNodes
+    inline bool     getLightweightNodes() const noexcept { return _lightweightNodes; }
+    //! \copydoc lightweightNodes
+    void            setLightweightNodes( bool lightweightNodes ) noexcept;
+private:
+    //! \copydoc lightweightNodes
+    bool            _lightweightNodes{ false };
+signals:
+    //! \copydoc lightweightNodes
+    void            lightweightNodesChanged();
+
+public:
+    //! Lightweight nodes visible in \c virtualViewport are promoted when \c viewZoom is greater or equal to \c promotionZoom (default to 1.5).
+    Q_PROPERTY( qreal promotionZoom READ getPromotionZoom WRITE setPromotionZoom NOTIFY promotionZoomChanged FINAL )
+    //! \copydoc promotionZoom
+    inline qreal    getPromotionZoom() const noexcept { return _promotionZoom; }
+    //! \copydoc promotionZoom
+    void            setPromotionZoom( qreal promotionZoom ) noexcept;
+private:
+    //! \copydoc promotionZoom
+    qreal           _promotionZoom{ 1.5 };
+signals:
+    //! \copydoc promotionZoom
+    void            promotionZoomChanged();
+
+public:
+    //! Current view zoom level (default to 1.0, usually set from Qan.GraphView).
+    Q_PROPERTY( qreal viewZoom READ getViewZoom WRITE setViewZoom NOTIFY viewZoomChanged FINAL )
+    //! \copydoc viewZoom
+    inline qreal    getViewZoom() const noexcept { return _viewZoom; }
+    //! \copydoc viewZoom
+    void            setViewZoom( qreal viewZoom ) noexcept;
+private:
+    //! \copydoc viewZoom
+    qreal           _viewZoom{ 1.0 };
+signals:
+    //! \copydoc viewZoom
+    void            viewZoomChanged();
+
+public:
+    //! Renderer used to draw lightweight nodes (nullptr until \c lightweightNodes is set to true).
+    Q_PROPERTY( qan::NodeRenderer* nodeRenderer READ getNodeRenderer NOTIFY nodeRendererChanged FINAL )
+    //! \copydoc nodeRenderer
+    inline qan::NodeRenderer*   getNodeRenderer() const noexcept { return _nodeRenderer.data(); }
+signals:
+    //! \copydoc nodeRenderer
+    void                        nodeRendererChanged();
+
+public:
+    //! Keep \c node promoted to its QML delegate until demoteNode() is called (delegate is created on next virtual update).
+    Q_INVOKABLE void    promoteNode( qan::Node* node ) noexcept;
+    //! Release a promotion requested with promoteNode().
+    Q_INVOKABLE void    demoteNode( qan::Node* node ) noexcept;
+
+private:
+    //! Return true if \c node should have an item in a graph with lightweight nodes.
+    bool                isPromoted( const qan::Node& node ) const noexcept;
+    //! Promote hovered \c node (called from nodeRenderer).
+    void                lightweightNodeHovered( qan::Node* node ) noexcept;
+    //! Promote and select pressed \c node (called from nodeRenderer).
+    void                lightweightNodePressed( qan::Node* node, QPointF pos, Qt::MouseButton button, Qt::KeyboardModifiers modifiers ) noexcept;
+
+    //! Nodes promoted with promoteNode() (entries are removed when nodes are destroyed).
+    QSet<const QObject*>        _promotedNodes;
+    QPointer<qan::Node>         _hoveredNode;
+    QPointer<qan::NodeRenderer> _nodeRenderer;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Asynchronous Delegate Management *///---------------------------
+    //@{
+public:
+    /*! \brief When true, node, edge and group delegates are created asynchronously with a QQmlIncubator (default to false).
+     *
+     * In asynchronous mode, insertNode(), insertEdge() and insertGroup() insert primitive topology immediately
+     * and return a valid primitive, its visual delegate is then incubated over the next frames, using at most
+     * \c incubationBudget ms per frame. While its delegate is pending, primitive getItem() return nullptr: use
+     * qan::Node::getGeometry() and qan::Node::setGeometry() as a placeholder geometry, it is applied to node item
+     * once created. Edge items are connected to their end points items as soon as they are available, and node items
+     * are added to their group item when both exist.
+     *
+     * Delegates available in \c itemPool are always reused synchronously.
+     */
+    Q_PROPERTY( bool asynchronous READ getAsynchronous WRITE setAsynchronous NOTIFY asynchronousChanged FINAL )
+    //! \copydoc asynchronous
+    inline bool     getAsynchronous() const noexcept { return _asynchronous; }
+    //! \copydoc asynchronous
+    void            setAsynchronous( bool asynchronous ) noexcept;
+private:
+    //! \copydoc asynchronous
+    bool            _asynchronous{ false };
+signals:
+    //! \copydoc asynchronous
+    void            asynchronousChanged();
+
+public:
+    /*! \brief Maximum time in ms spent incubating delegates per frame in \c asynchronous mode (default to 5ms).
+     *
+     * \note When QML engine incubation controller is installed by a QQuickWindow, window also incubates
+     * pending delegates in its own idle time.
+     */
+    Q_PROPERTY( int incubationBudget READ getIncubationBudget WRITE setIncubationBudget NOTIFY incubationBudgetChanged FINAL )
+    //! \copydoc incubationBudget
+    inline int      getIncubationBudget() const noexcept { return _incubationBudget; }
+    //! \copydoc incubationBudget
+    void            setIncubationBudget( int incubationBudget ) noexcept;
+private:
+    //! \copydoc incubationBudget
+    int             _incubationBudget{ 5 };
+signals:
+    //! \copydoc incubationBudget
+    void            incubationBudgetChanged();
+
+public:
+    //! Number of node, edge and group delegates still being incubated (read only).
+    Q_PROPERTY( int pendingItemCount READ getPendingItemCount NOTIFY pendingItemCountChanged FINAL )
+    //! \copydoc pendingItemCount
+    inline int      getPendingItemCount() const noexcept { return _pendingItemCount; }
+private:
+    //! \copydoc pendingItemCount
+    int             _pendingItemCount{ 0 };
+signals:
+    //! \copydoc pendingItemCount
+    void            pendingItemCountChanged();
+    //! Emitted when the last pending delegate has been created.
+    void            itemsIncubated();
+
+public:
+    //! Synchronously complete creation of all pending delegates.
+    Q_INVOKABLE void    completeIncubation();
+
+private:
+    class DelegateIncubator;
+
+    /*! \brief Start \c component incubation for either \c node, \c edge or \c group (item is bound to its primitive in incubatorFinished()).
+     *
+     * \return false if incubation can't be started.
+     */
+    bool                incubateItem( QQmlComponent& component, qan::Style& style,
+                                      qan::Node* node, qan::Edge* edge, qan::Group* group ) noexcept;
+    //! Bind an incubated item to its primitive (called from \c incubator when its status become Ready or Error).
+    void                incubatorFinished( DelegateIncubator& incubator ) noexcept;
+    //! Incubate pending delegates for at most \c incubationBudget ms, then destroy finished incubators.
+    void                incubateFrame() noexcept;
+    //! Request an incubateFrame() call on next frame (or next timer tick when graph has no window).
+    void                scheduleIncubation() noexcept;
+    //! Abort all pending incubations (primitives are left without items).
+    void                clearIncubation() noexcept;
+
+    std::list<std::unique_ptr<DelegateIncubator>>       _incubators;
+    /*! \brief Primitives whose delegate is currently incubated, mapped to their incubator.
+     *
+     * Keys are raw primitive addresses, they are removed when incubation finish even if primitive has been
+     * destroyed in the meantime (an address reused by a new primitive is detected with incubator primitive guard).
+     */
+    QHash<const QObject*, DelegateIncubator*>           _incubatingPrimitives;
+    //! Fallback controller installed when QML engine has no incubation controller.
+    std::unique_ptr<QQmlIncubationController>           _incubationController;
+    QPointer<QQuickWindow>                              _incubationWindow;
+    QTimer                                              _incubationTimer;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Batched Edge Rendering Management *///--------------------------
+    //@{
+public:
+    /*! \brief When true, edges using default Edge.qml delegate are drawn by a single qan::EdgeRenderer (default to false).
+     *
+     * Edge items are still created to handle interactions, but with BatchedEdge.qml, a delegate with no visual
+     * content: their line and arrow are drawn in a few batched scene graph nodes instead of one QtQuick.Shapes
+     * item per edge. Edges with a custom delegate component keep drawing their own QML delegate.
+     *
+     * \note Should be set before edges are inserted, existing edges items are not modified.
+     */
+    Q_PROPERTY( bool batchedEdges READ getBatchedEdges WRITE setBatchedEdges NOTIFY batchedEdgesChanged FINAL )
+    //! \copydoc batchedEdges
+    inline bool     getBatchedEdges() const noexcept { return _batchedEdges; }
+    //! \copydoc batchedEdges
+    void            setBatchedEdges( bool batchedEdges ) noexcept;
+private:
+    //! \copydoc batchedEdges
+    bool            _batchedEdges{ false };
+signals:
+    //! \copydoc batchedEdges
+    void            batchedEdgesChanged();
+
+public:
+    //! Renderer used to draw batched edges (nullptr until \c batchedEdges is set to true).
+    Q_PROPERTY( qan::EdgeRenderer* edgeRenderer READ getEdgeRenderer NOTIFY edgeRendererChanged FINAL )
+    //! \copydoc edgeRenderer
+    inline qan::EdgeRenderer*   getEdgeRenderer() const noexcept { return _edgeRenderer.data(); }
+signals:
+    //! \copydoc edgeRenderer
+    void                        edgeRendererChanged();
+
+private:
+    //! Return BatchedEdge.qml delegate if \c edgeComponent is default Edge.qml delegate and \c batchedEdges is true, \c edgeComponent otherwise.
+    QQmlComponent&                  getBatchedEdgeComponent( QQmlComponent& edgeComponent ) noexcept;
+
+    std::unique_ptr<QQmlComponent>  _batchedEdgeDelegate;
+    QPointer<qan::EdgeRenderer>     _edgeRenderer;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Item Recycling Management *///---------------------------------
+    //@{
+public:
+    /*! \brief Pool of node, edge, group and selection items (read only).
+     *
+     * Items of removed primitives (and items released from a virtualized graph) are stored in pool and reused
+     * when a primitive with the same delegate component is inserted.
+     */
+    Q_PROPERTY( qan::ItemPool* itemPool READ getItemPool CONSTANT FINAL )
+    inline qan::ItemPool*       getItemPool() noexcept { return &_itemPool; }
+    inline const qan::ItemPool* getItemPool() const noexcept { return &_itemPool; }
+
+private:
+    //! Detach \c node item (ungrouping it from its group item) and give it back to \c itemPool.
+    void                recycleNodeItem( qan::Node& node ) noexcept;
+    //! Detach \c edge item and give it back to \c itemPool.
+    void                recycleEdgeItem( qan::Edge& edge ) noexcept;
+    //! Recycle \c edge item and, recursively, its in hyper edges items (used before \c edge removal).
+    void                recycleEdgeItems( qan::Edge& edge ) noexcept;
+    //! Detach \c group item and give it back to \c itemPool, group nodes must have been ungrouped.
+    void                recycleGroupItem( qan::Group& group ) noexcept;
+    //! Give a \c selectionItem created with createSelectionItem() back to \c itemPool (used from qan::Selectable).
+    void                recycleSelectionItem( QQuickItem* selectionItem ) noexcept;
+
+private:
+    qan::ItemPool       _itemPool;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Spatial Index Management *///----------------------------------
+    //@{
+private:
+    using ItemIndex = gtpo::SpatialIndex<QQuickItem*>;
+
+    //! Insert \c item in \c index and monitor its geometry (called when a node, edge or group item is created or reused).
+    void                indexItem( QQuickItem* item, ItemIndex& index ) noexcept;
+    //! Remove \c item from spatial indexes (called when item is recycled or destroyed, \c item is not dereferenced).
+    void                unindexItem( QQuickItem* item ) const noexcept;
+    //! Update boxes of items whose geometry has changed since last query.
+    void                flushSpatialIndex() const noexcept;
+    //! Return \c item bounding box in container item coordinates.
+    gtpo::Box           getItemBox( const QQuickItem& item ) const noexcept;
+
+    // Indexes are lazily updated before queries: geometry changes only mark items as dirty
+    mutable ItemIndex           _nodeIndex;
+    mutable ItemIndex           _edgeIndex;
+    mutable ItemIndex           _groupIndex;
+    mutable QSet<QQuickItem*>   _dirtyIndexItems;
+    //@}
+    //-------------------------------------------------------------------------
+
     /*! \name Selection Management *///----------------------------------------
     //@{
 public:
@@ -612,6 +1156,26 @@ private:
     //@}
     //-------------------------------------------------------------------------
 
+    /*! \name Level of Detail Management *///---------------------------------
+    //@{
+public:
+    /*! \brief Graph zoom driven level of detail policy, policy zoom is updated with \c viewZoom (see qan::LevelOfDetail).
+     *
+     * When a zoom threshold is crossed, dock items visibility and curved edges geometry are updated in a single
+     * pass, node labels, port labels, edge arrows and node delegates details are updated with bindings on
+     * \c lod properties in default delegates.
+     */
+    Q_PROPERTY( qan::LevelOfDetail* lod READ getLod CONSTANT FINAL )
+    inline qan::LevelOfDetail*          getLod() noexcept { return &_lod; }
+    inline const qan::LevelOfDetail*    getLod() const noexcept { return &_lod; }
+private:
+    //! Apply last \c lod level modifications to existing dock and edge items.
+    void                applyLevelOfDetail();
+
+    qan::LevelOfDetail  _lod;
+    //@}
+    //-------------------------------------------------------------------------
+
     /*! \name Port/Dock Management *///----------------------------------------
     //@{
 public:
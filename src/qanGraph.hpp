@@ -58,34 +58,12 @@ qan::Node*  Graph::insertNode(QQmlComponent* nodeComponent)
         qan::NodeStyle* nodeStyle = Node_t::style();
         if ( nodeStyle == nullptr )
             throw qan::Error{"style() factory has returned a nullptr style."};
-        _styleManager.setStyleComponent(nodeStyle, nodeComponent);
-        qan::NodeItem* nodeItem = static_cast<qan::NodeItem*>( createFromComponent( nodeComponent,
-                                                                                    *nodeStyle,
-                                                                                    node.get() ) );
-        if ( nodeItem  == nullptr )
+        if ( isDeferred() )         // Node item is created when node enter virtual viewport or is promoted
+            setVirtualDelegate( node.get(), nodeComponent, nodeStyle );
+        else if ( !configureNode( *node, *nodeComponent, *nodeStyle ) )
             throw qan::Error{"Node item creation failed."};
-        nodeItem->setNode(node.get());
-        nodeItem->setGraph(this);
-        node->setItem(nodeItem);
-        auto notifyNodeClicked = [this] (qan::NodeItem* nodeItem, QPointF p) {
-            if ( nodeItem != nullptr && nodeItem->getNode() != nullptr )
-                emit this->nodeClicked(nodeItem->getNode(), p);
-        };
-        connect( nodeItem, &qan::NodeItem::nodeClicked, notifyNodeClicked );
-
-        auto notifyNodeRightClicked = [this] (qan::NodeItem* nodeItem, QPointF p) {
-            if ( nodeItem != nullptr && nodeItem->getNode() != nullptr )
-                emit this->nodeRightClicked(nodeItem->getNode(), p);
-        };
-        connect( nodeItem, &qan::NodeItem::nodeRightClicked, notifyNodeRightClicked );
-
-        auto notifyNodeDoubleClicked = [this] (qan::NodeItem* nodeItem, QPointF p) {
-            if ( nodeItem != nullptr && nodeItem->getNode() != nullptr )
-                emit this->nodeDoubleClicked(nodeItem->getNode(), p);
-        };
-        connect( nodeItem, &qan::NodeItem::nodeDoubleClicked, notifyNodeDoubleClicked );
-        node->setItem(nodeItem);
         GTpoGraph::insertNode( node );
+        scheduleVirtualUpdate();
     } catch ( const gtpo::bad_topology_error& e ) {
         qWarning() << "qan::Graph::insertNode(): Error: Topology error: " << e.what();
         return nullptr; // node eventually destroyed by shared_ptr
@@ -145,8 +123,18 @@ qan::Edge*  Graph::insertEdge( qan::Node& src, qan::Node* dstNode, qan::Edge* ds
     try {
         auto edge = std::make_shared<Edge_t>();
         QQmlEngine::setObjectOwnership( edge.get(), QQmlEngine::CppOwnership );
-        if ( configureEdge( *edge,  *edgeComponent, *style,
-                            src,    dstNode,        dstEdge ) ) {
+        if ( isDeferred() ) {       // Edge item is created when edge enter virtual viewport or its end points are promoted
+            edge->setSrc( src.shared_from_this() );
+            if ( dstNode != nullptr )
+                edge->setDst( dstNode->shared_from_this() );
+            else
+                edge->setHDst( dstEdge->shared_from_this() );
+            setVirtualDelegate( edge.get(), edgeComponent, style );
+            GTpoGraph::insertEdge( edge );
+            configuredEdge = edge.get();
+            scheduleVirtualUpdate();
+        } else if ( configureEdge( *edge,  *edgeComponent, *style,
+                                   src,    dstNode,        dstEdge ) ) {
             GTpoGraph::insertEdge( edge );
             configuredEdge = edge.get();
         }
@@ -202,40 +190,17 @@ qan::Group* Graph::insertGroup()
     if ( group ) {
         QQmlEngine::setObjectOwnership( group.get(), QQmlEngine::CppOwnership );
         qan::Style* style = qan::Group::style();
-        if ( style != nullptr ) {
-            // Group styles are not well supported (for the moment 20170317)
-            //_styleManager.setStyleComponent(style, edgeComponent);
-            qan::GroupItem* groupItem = static_cast<qan::GroupItem*>( createFromComponent( groupComponent,
-                                                                                           *style,
-                                                                                           nullptr,
-                                                                                           nullptr,                                                                                           group.get() ) );
-            if ( groupItem != nullptr ) {
-                groupItem->setGroup(group.get());
-                groupItem->setGraph(this);
-                group->setItem(groupItem);
-
-                GTpoGraph::insertGroup( group );
-
-                auto notifyGroupClicked = [this] (qan::GroupItem* groupItem, QPointF p) {
-                    if ( groupItem != nullptr && groupItem->getGroup() != nullptr )
-                        emit this->groupClicked(groupItem->getGroup(), p);
-                };
-                connect( groupItem, &qan::GroupItem::groupClicked, notifyGroupClicked );
-
-                auto notifyGroupRightClicked = [this] (qan::GroupItem* groupItem, QPointF p) {
-                    if ( groupItem != nullptr && groupItem->getGroup() != nullptr )
-                        emit this->groupRightClicked(groupItem->getGroup(), p);
-                };
-                connect( groupItem, &qan::GroupItem::groupRightClicked, notifyGroupRightClicked );
-
-                auto notifyGroupDoubleClicked = [this] (qan::GroupItem* groupItem, QPointF p) {
-                    if ( groupItem != nullptr && groupItem->getGroup() != nullptr )
-                        emit this->groupDoubleClicked(groupItem->getGroup(), p);
-                };
-                connect( groupItem, &qan::GroupItem::groupDoubleClicked, notifyGroupDoubleClicked );
-            } else
-                qWarning() << "qan::Graph::insertGroup<>(): Warning: Group delegate from QML component creation failed.";
-        } else qWarning() << "qan::Graph::insertGroup<>(): Error: style() factory has returned a nullptr style.";
+        if ( style == nullptr ) {
+            qWarning() << "qan::Graph::insertGroup<>(): Error: style() factory has returned a nullptr style.";
+            return nullptr;
+        }
+        // Group styles are not well supported (for the moment 20170317)
+        //_styleManager.setStyleComponent(style, edgeComponent);
+        if ( !configureGroup( *group, *groupComponent, *style ) ) {
+            qWarning() << "qan::Graph::insertGroup<>(): Warning: Group delegate from QML component creation failed.";
+            return nullptr;     // group eventually destroyed by shared_ptr
+        }
+        GTpoGraph::insertGroup( group );
     }
     return group.get();
 
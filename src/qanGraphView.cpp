@@ -39,6 +39,7 @@
 #include "./qanNavigable.h"
 #include "./qanGraphView.h"
 #include "./qanGraph.h"
+#include "./qanGroupItem.h"
 
 namespace qan { // ::qan
 
@@ -48,6 +49,12 @@ GraphView::GraphView( QQuickItem* parent ) :
 {
     setAntialiasing( true );
     setSmooth( true );
+    connect( this, &qan::Navigable::containerItemModified,
+             this, &qan::GraphView::updateVirtualViewport );
+    connect( this, &QQuickItem::widthChanged,
+             this, &qan::GraphView::updateVirtualViewport );
+    connect( this, &QQuickItem::heightChanged,
+             this, &qan::GraphView::updateVirtualViewport );
 }
 
 void    GraphView::setGraph( qan::Graph* graph )
@@ -90,6 +97,12 @@ void    GraphView::setGraph( qan::Graph* graph )
                  this,   &qan::GraphView::groupRightClicked );
         connect( _graph, &qan::Graph::groupDoubleClicked,
                  this,   &qan::GraphView::groupDoubleClicked );
+
+        connect( _graph, &qan::Graph::virtualizedChanged,
+                 this,   &qan::GraphView::updateVirtualViewport );
+        connect( _graph, &qan::Graph::lightweightNodesChanged,
+                 this,   &qan::GraphView::updateVirtualViewport );
+        updateVirtualViewport();
         emit graphChanged();
     }
 }
@@ -102,6 +115,37 @@ void    GraphView::navigableClicked(QPointF pos)
 }
 
 void    GraphView::navigableRightClicked(QPointF pos) { emit    rightClicked(pos); }
+
+void    GraphView::collectOverviewRects( std::vector<QRectF>& rects, std::vector<QRectF>& containerRects ) const
+{
+    rects.clear();
+    containerRects.clear();
+    const qan::Graph* graph = _graph.data();
+    if ( graph == nullptr )
+        return;
+    rects.reserve( graph->getNodes().size() );
+    for ( const auto& node : graph->getNodes() )    // Node geometry is available even for item less nodes
+        if ( node )
+            rects.push_back( node->getGeometry() );
+    const auto containerItem = graph->getContainerItem();
+    for ( const auto& group : graph->getGroups() ) {
+        const auto groupItem = group ? group->getItem() : nullptr;
+        if ( groupItem != nullptr &&
+             containerItem != nullptr )
+            containerRects.push_back( groupItem->mapRectToItem( containerItem, groupItem->boundingRect() ) );
+    }
+}
+
+void    GraphView::updateVirtualViewport()
+{
+    if ( _graph &&
+         getContainerItem() != nullptr ) {
+        _graph->setViewZoom( getZoom() );     // Used for level of detail and lightweight nodes promotion
+        if ( _graph->getVirtualized() ||
+             _graph->getLightweightNodes() )
+            _graph->setVirtualViewport( getContainerItem()->mapRectFromItem( this, boundingRect() ) );
+    }
+}
 //-----------------------------------------------------------------------------
 
 } // ::qan
@@ -75,11 +75,19 @@ private:
 signals:
     void                    graphChanged( );
 
+private:
+    //! Update graph view zoom, and virtual viewport when graph is virtualized or use lightweight nodes (see qan::Graph::virtualized).
+    void                    updateVirtualViewport();
+
 protected:
     //! Called when the mouse is clicked in the container (base implementation empty).
     virtual void    navigableClicked(QPointF pos) override;
     virtual void    navigableRightClicked(QPointF pos) override;
 
+public:
+    //! Collect graph nodes geometry (including virtualized and lightweight nodes) and groups geometry.
+    virtual void    collectOverviewRects( std::vector<QRectF>& rects, std::vector<QRectF>& containerRects ) const override;
+
 signals:
     void            connectorChanged();
 
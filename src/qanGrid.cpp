@@ -34,9 +34,12 @@
 
 // Std headers
 #include <cmath>        // std::round
-#include <iostream>
 
 // Qt headers
+#include <QQuickWindow>
+#include <QSGFlatColorMaterial>
+#include <QSGRectangleNode>
+#include <QSGRendererInterface>
 
 // QuickQanava headers
 #include "./qanGrid.h"
@@ -56,6 +59,7 @@ void    Grid::setThickColor( QColor thickColor ) noexcept
     if ( thickColor != _thickColor ) {
         _thickColor = thickColor;
         emit thickColorChanged();
+        update();
     }
 }
 
@@ -68,6 +72,7 @@ void    Grid::setGridWidth( qreal gridWidth ) noexcept
     if ( !qFuzzyCompare(1.0 + gridWidth, 1.0 + _gridWidth) ) {
         _gridWidth = gridWidth;
         emit gridWidthChanged();
+        updateGrid();
     }
 }
 
@@ -102,39 +107,14 @@ void    Grid::setGridMajor( int gridMajor ) noexcept
 /* OrthoGrid Object Management *///---------------------------------------------
 OrthoGrid::OrthoGrid( QQuickItem* parent ) :
     Grid( parent )
-{ /* Nil */ }
-
-OrthoGrid::~OrthoGrid()
 {
-    // Delete the geometry component if it is not owned by QML
-    if ( _geometryComponent != nullptr &&
-         QQmlEngine::objectOwnership(_geometryComponent) == QQmlEngine::CppOwnership ) {
-        _geometryComponent->deleteLater();
-        _geometryComponent.clear();
-    }
+    setFlag( QQuickItem::ItemHasContents, true );
 }
+
+OrthoGrid::~OrthoGrid() { /* Nil */ }
 //-----------------------------------------------------------------------------
 
 /* Grid Management *///--------------------------------------------------------
-void    OrthoGrid::setGeometryComponent( QQmlComponent* geometryComponent ) noexcept
-{
-    if ( _geometryComponent &&
-         _geometryComponent != geometryComponent ) {
-        qWarning() << "qan::ORthoGrid::setGeometryComponent(): Component couldn't be initialized dynamically more than one time.";
-        return;
-    }
-
-    if ( _geometryComponent != geometryComponent ) {
-        if ( _geometryComponent != nullptr &&   // Shouldn't happen since dynamic components change are forbiden.
-             QQmlEngine::objectOwnership(_geometryComponent) == QQmlEngine::CppOwnership ) {
-            _geometryComponent->deleteLater();
-            _geometryComponent.clear();
-        }
-        _geometryComponent = geometryComponent;
-        emit geometryComponentChanged();
-    }
-}
-
 bool    OrthoGrid::updateGrid(const QRectF& viewRect,
                               const QQuickItem& container,
                               const QQuickItem& navigable ) noexcept
@@ -142,13 +122,10 @@ bool    OrthoGrid::updateGrid(const QRectF& viewRect,
     // PRECONDITIONS:
         // Grid item must be visible
         // View rect must be valid
-        // _geometryComponent must have been set.
     if ( !isVisible() )   // Do not update an invisible grid
         return false;
     if ( !viewRect.isValid() )
         return false;
-    if ( !_geometryComponent )
-        return false;
 
     _viewRectCache = viewRect;      // Cache all arguments for an eventual updateGrid() call with
     _containerCache = const_cast<QQuickItem*>(&container);   // no arguments (for example on a qan::Grid property change)
@@ -165,24 +142,121 @@ bool    OrthoGrid::updateGrid() noexcept
         return updateGrid( _viewRectCache, *_containerCache, *_navigableCache );
     return false;
 }
+
+bool    OrthoGrid::generateLayout( const QRectF& viewRect, const QQuickItem& container, const QQuickItem& navigable,
+                                   QRectF& rectified, qreal& adaptativeScale,
+                                   QPointF& origin, QPointF& step ) const noexcept
+{
+    const qreal gridScale{getGridScale()};
+
+    qreal containerZoom = container.scale();
+    if ( qFuzzyCompare(1.0 + containerZoom, 1.0) )  // Protect against 0 zoom
+        containerZoom = 1.0;
+    adaptativeScale = containerZoom < 1. ? gridScale / containerZoom : gridScale;
+    const QPointF rectifiedTopLeft{ std::floor(viewRect.topLeft().x() / adaptativeScale) * adaptativeScale,
+                                    std::floor(viewRect.topLeft().y() / adaptativeScale) * adaptativeScale };
+    const QPointF rectifiedBottomRight{ ( std::ceil(viewRect.bottomRight().x() / adaptativeScale) * adaptativeScale ),
+                                        ( std::ceil(viewRect.bottomRight().y() / adaptativeScale) * adaptativeScale )};
+    rectified = QRectF{rectifiedTopLeft, rectifiedBottomRight };
+
+    // Container is only translated and scaled in navigable, map two points instead of every thick
+    origin = container.mapToItem(&navigable, QPointF{0., 0.});
+    step = container.mapToItem(&navigable, QPointF{1., 1.}) - origin;
+    return rectified.isValid();
+}
+
+bool    OrthoGrid::isMajor( qreal c, qreal adaptativeScale ) const noexcept
+{
+    return qFuzzyCompare( 1. + std::fmod(c, getGridMajor() * adaptativeScale), 1. );
+}
 //-----------------------------------------------------------------------------
 
+/* Grid Rendering *///---------------------------------------------------------
+QSGNode*    OrthoGrid::updatePaintNode( QSGNode* oldNode, UpdatePaintNodeData* )
+{
+    if ( _quads.empty() ) {
+        delete oldNode;
+        return nullptr;
+    }
+    // Flat color material is not supported by software backend, use one rectangle node per quad
+    const auto rendererInterface = window() != nullptr ? window()->rendererInterface() : nullptr;
+    if ( rendererInterface != nullptr &&
+         rendererInterface->graphicsApi() == QSGRendererInterface::Software ) {
+        auto node = oldNode != nullptr ? oldNode : new QSGNode{};
+        updateRectangleNodes( *node );
+        return node;
+    }
+    auto node = static_cast<QSGGeometryNode*>(oldNode);
+    if ( node == nullptr ) {
+        node = new QSGGeometryNode{};
+        auto geometry = new QSGGeometry{ QSGGeometry::defaultAttributes_Point2D(), 0 };
+        geometry->setDrawingMode( QSGGeometry::DrawTriangles );
+        node->setGeometry( geometry );
+        node->setFlag( QSGNode::OwnsGeometry );
+        node->setMaterial( new QSGFlatColorMaterial{} );
+        node->setFlag( QSGNode::OwnsMaterial );
+    }
+    updateGeometryNode( *node );
+    return node;
+}
 
-/* PointGrid Object Management *///--------------------------------------------
-PointGrid::PointGrid( QQuickItem* parent ) :
-    OrthoGrid( parent ) { /* Nil */ }
+void    OrthoGrid::updateGeometryNode( QSGGeometryNode& node ) noexcept
+{
+    auto geometry = node.geometry();
+    const int vertexCount = static_cast<int>( _quads.size() * 6 );
+    if ( geometry->vertexCount() != vertexCount )
+        geometry->allocate( vertexCount );
+    auto vertex = geometry->vertexDataAsPoint2D();
+    for ( const auto& quad : _quads ) {     // Two triangles per quad
+        const auto left = static_cast<float>( quad.left() ), top = static_cast<float>( quad.top() );
+        const auto right = static_cast<float>( quad.right() ), bottom = static_cast<float>( quad.bottom() );
+        ( vertex++ )->set( left, top );
+        ( vertex++ )->set( right, top );
+        ( vertex++ )->set( right, bottom );
+        ( vertex++ )->set( left, top );
+        ( vertex++ )->set( right, bottom );
+        ( vertex++ )->set( left, bottom );
+    }
+    node.markDirty( QSGNode::DirtyGeometry );
 
-PointGrid::~PointGrid( )
+    auto material = static_cast<QSGFlatColorMaterial*>( node.material() );
+    if ( material->color() != getThickColor() ) {
+        material->setColor( getThickColor() );
+        node.markDirty( QSGNode::DirtyMaterial );
+    }
+}
+
+void    OrthoGrid::updateRectangleNodes( QSGNode& node ) noexcept
 {
-    for ( auto& point : _points ) {
-        if ( point != nullptr &&
-             QQmlEngine::objectOwnership(point) == QQmlEngine::CppOwnership )
-             point->deleteLater();
+    // Rectangle nodes are reused, unused ones are removed from the end
+    const int quadCount = static_cast<int>( _quads.size() );
+    int childCount = node.childCount();
+    for ( ; childCount > quadCount; --childCount ) {
+        auto child = node.lastChild();
+        node.removeChildNode( child );
+        delete child;
+    }
+    for ( ; childCount < quadCount; ++childCount )
+        node.appendChildNode( window()->createRectangleNode() );
+    auto child = node.firstChild();
+    for ( const auto& quad : _quads ) {
+        auto rectangleNode = static_cast<QSGRectangleNode*>( child );
+        rectangleNode->setRect( quad );
+        if ( rectangleNode->color() != getThickColor() )
+            rectangleNode->setColor( getThickColor() );
+        child = child->nextSibling();
     }
-    _points.clear();
 }
 //-----------------------------------------------------------------------------
 
+
+/* PointGrid Object Management *///--------------------------------------------
+PointGrid::PointGrid( QQuickItem* parent ) :
+    OrthoGrid( parent ) { /* Nil */ }
+
+PointGrid::~PointGrid( ) { /* Nil */ }
+//-----------------------------------------------------------------------------
+
 /* Grid Management *///--------------------------------------------------------
 bool    PointGrid::updateGrid(const QRectF& viewRect,
                               const QQuickItem& container,
@@ -193,77 +267,34 @@ bool    PointGrid::updateGrid(const QRectF& viewRect,
     if ( !OrthoGrid::updateGrid(viewRect, container, navigable) )
         return false;
 
-    const unsigned int gridMajor{static_cast<unsigned int>(getGridMajor())}; // On major thick every 10 minor thicks
-    const qreal gridScale{getGridScale()};
-
-    qreal containerZoom = container.scale();
-    if ( qFuzzyCompare(1.0 + containerZoom, 1.0) )  // Protect against 0 zoom
-        containerZoom = 1.0;
-    const qreal adaptativeScale = containerZoom < 1. ? gridScale / containerZoom : gridScale;
-    QPointF rectifiedTopLeft{ std::floor(viewRect.topLeft().x() / adaptativeScale) * adaptativeScale,
-                              std::floor(viewRect.topLeft().y() / adaptativeScale) * adaptativeScale };
-    QPointF rectifiedBottomRight{ ( std::ceil(viewRect.bottomRight().x() / adaptativeScale) * adaptativeScale ),
-                                  ( std::ceil(viewRect.bottomRight().y() / adaptativeScale) * adaptativeScale )};
-    QRectF rectified{rectifiedTopLeft, rectifiedBottomRight };
-
-    //qDebug() << "rect.topLeft=" << rect.topLeft();
-    //qDebug() << "rect.bottomRight=" << rect.bottomRight();
-    //qDebug() << "adaptativeScale=" << adaptativeScale;
-    //qDebug() << "rectified.topLeft=" << rectified.topLeft();
-    //qDebug() << "rectified.bottomRight=" << rectified.bottomRight();
-
-    // FIXME: check that the rounding do not generate the graphics glitchs...
-    const unsigned int numPointsX = static_cast<unsigned int>(std::round(rectified.width() / adaptativeScale));
-    const unsigned int numPointsY = static_cast<unsigned int>(std::round(rectified.height() / adaptativeScale));
-
-    // Update points cache size
-    const unsigned int pointsCount = static_cast<unsigned int>(numPointsX * numPointsY);
-    if ( getGeometryComponent() &&
-         _points.size() < pointsCount ) {
-        unsigned int cachedPointsCount = static_cast<unsigned int>(_points.size());
+    QRectF  rectified;
+    qreal   adaptativeScale{1.};
+    QPointF origin, step;
+    _quads.clear();
+    if ( generateLayout(viewRect, container, navigable, rectified, adaptativeScale, origin, step) ) {
+        // FIXME: check that the rounding do not generate the graphics glitchs...
+        const unsigned int numPointsX = static_cast<unsigned int>(std::round(rectified.width() / adaptativeScale));
+        const unsigned int numPointsY = static_cast<unsigned int>(std::round(rectified.height() / adaptativeScale));
         try {
-            if ( _points.size() < pointsCount )     // Optimize append of new cached points items
-                _points.resize(pointsCount);
+            _quads.reserve( numPointsX * numPointsY );
         } catch (...) { return false; } // Might be std::bad_alloc or std::length_error
 
-        auto gridContext = QQmlEngine::contextForObject(this);
-        if ( gridContext == nullptr ) {
-            qWarning() << "qan::PointGrid::updateGrid(): Error: No QML context available.";
-            return false;
-        }
-        for ( auto p = cachedPointsCount; p < pointsCount; p++ ) {   // Initialize the necessary items
-            const auto pointItem = qobject_cast<QQuickItem*>(getGeometryComponent()->create(gridContext));
-            if ( pointItem != nullptr ) {
-                pointItem->setParentItem(this);
-                pointItem->setParent( this );
-                _points[p] = pointItem;
+        // Generate grid points: a square centered on thick, larger on major thicks
+        const qreal minorSize = getGridWidth() / 2.;
+        const qreal majorSize = minorSize * 1.5;
+        for ( unsigned int npx = 0; npx < numPointsX; npx++ ) {
+            const auto px = rectified.left() + ( npx * adaptativeScale );
+            const bool isMajorColumn = isMajor( px, adaptativeScale );
+            const auto x = origin.x() + px * step.x();
+            for ( unsigned int npy = 0; npy < numPointsY; npy++ ) {
+                const auto py = rectified.top() + ( npy * adaptativeScale );
+                const auto y = origin.y() + py * step.y();
+                const auto size = isMajorColumn && isMajor( py, adaptativeScale ) ? majorSize : minorSize;
+                appendQuad( x - size, y - size, x + size, y + size );
             }
         }
     }
-    if ( _points.size() < pointsCount )
-        return false;
-
-    // Generate grid points
-    unsigned int p = 0;
-    for ( unsigned int npx = 0; npx < numPointsX; npx++ ) {
-        auto px = rectifiedTopLeft.x() + ( npx * adaptativeScale );
-        bool isMajorColumn = qFuzzyCompare( 1. + std::fmod(px, gridMajor * adaptativeScale), 1. );
-        for ( unsigned int npy = 0; npy < numPointsY; npy++ ) {
-            auto py = rectifiedTopLeft.y() + ( npy * adaptativeScale );
-            bool isMajorRow = qFuzzyCompare( 1. + std::fmod(py, gridMajor * adaptativeScale), 1. );
-            _points[p]->setVisible(true);
-            auto navigablePoint = container.mapToItem(&navigable, QPointF{px, py});
-            _points[p]->setX(navigablePoint.x());
-            _points[p]->setY(navigablePoint.y());
-            _points[p]->setScale( isMajorColumn && isMajorRow ? 1.5 : 1.0 );
-            p++;
-        }
-    }
-    while ( p < _points.size() ) {
-        if ( _points[p] != nullptr )
-            _points[p]->setVisible(false);
-        ++p;
-    }
+    update();
     return true;
 }
 //-----------------------------------------------------------------------------
@@ -273,118 +304,48 @@ bool    PointGrid::updateGrid(const QRectF& viewRect,
 LineGrid::LineGrid( QQuickItem* parent ) :
     OrthoGrid( parent ) { /* Nil */ }
 
-LineGrid::~LineGrid( )
-{
-    for ( auto& line : _lines ) {
-        if ( line != nullptr &&
-             QQmlEngine::objectOwnership(line) == QQmlEngine::CppOwnership )
-             line->deleteLater();
-    }
-    _lines.clear();
-}
+LineGrid::~LineGrid( ) { /* Nil */ }
 //-----------------------------------------------------------------------------
 
 /* Grid Management *///--------------------------------------------------------
-void    LineGrid::setGridShape( QObject* gridShape ) noexcept
-{
-    if ( _gridShape != gridShape ) {
-        _gridShape = gridShape;
-        emit gridShapeChanged();
-    }
-}
-
 bool    LineGrid::updateGrid( const QRectF& viewRect,
                               const QQuickItem& container,
                               const QQuickItem& navigable ) noexcept
 {
     // PRECONDITIONS:
         // Base implementation should return true
-        // gridShape property should have been set
     if ( !OrthoGrid::updateGrid(viewRect, container, navigable) )
         return false;
-    if ( !getGridShape() )
-        return false;
-
-    const unsigned int  gridMajor{static_cast<unsigned int>(getGridMajor())}; // On major thick every 10 minor thicks
-    const qreal gridScale{getGridScale()};
 
-    qreal containerZoom = container.scale();
-    if ( qFuzzyCompare(1.0 + containerZoom, 1.0) )  // Protect against 0 zoom
-        containerZoom = 1.0;
-    const qreal adaptativeScale = containerZoom < 1. ? gridScale / containerZoom : gridScale;
-    QPointF rectifiedTopLeft{ std::floor(viewRect.topLeft().x() / adaptativeScale) * adaptativeScale,
-                              std::floor(viewRect.topLeft().y() / adaptativeScale) * adaptativeScale };
-    QPointF rectifiedBottomRight{ ( std::ceil(viewRect.bottomRight().x() / adaptativeScale) * adaptativeScale ),
-                                  ( std::ceil(viewRect.bottomRight().y() / adaptativeScale) * adaptativeScale )};
-    QRectF rectified{rectifiedTopLeft, rectifiedBottomRight };
-
-    //qDebug() << "rect.topLeft=" << rect.topLeft();
-    //qDebug() << "rect.bottomRight=" << rect.bottomRight();
-    //qDebug() << "adaptativeScale=" << adaptativeScale;
-    //qDebug() << "rectified.topLeft=" << rectified.topLeft();
-    //qDebug() << "rectified.bottomRight=" << rectified.bottomRight();
-
-    const unsigned int numLinesX = static_cast<unsigned int>(std::round(rectified.width() / adaptativeScale));
-    const unsigned int numLinesY = static_cast<unsigned int>(std::round(rectified.height() / adaptativeScale));
-
-    // Update points cache size
-    const unsigned int linesCount = numLinesX + numLinesY;
-    if ( getGeometryComponent() &&
-         _lines.size() < linesCount ) {
-        unsigned int cachedLinesCount = static_cast<unsigned int>(_lines.size());
+    QRectF  rectified;
+    qreal   adaptativeScale{1.};
+    QPointF origin, step;
+    _quads.clear();
+    if ( generateLayout(viewRect, container, navigable, rectified, adaptativeScale, origin, step) ) {
+        const unsigned int numLinesX = static_cast<unsigned int>(std::round(rectified.width() / adaptativeScale));
+        const unsigned int numLinesY = static_cast<unsigned int>(std::round(rectified.height() / adaptativeScale));
         try {
-            if ( _lines.size() < linesCount )     // Optimize append of new cached points items
-                _lines.resize(linesCount);
+            _quads.reserve( numLinesX + numLinesY );
         } catch (...) { return false; } // Might be std::bad_alloc or std::length_error
 
-        auto gridContext = QQmlEngine::contextForObject(getGridShape());
-        if ( gridContext == nullptr ) {
-            qWarning() << "qan::LineGrid::updateGrid(): Error: No QML context available.";
-            return false;
+        const auto left = origin.x() + rectified.left() * step.x();
+        const auto top = origin.y() + rectified.top() * step.y();
+        const auto right = origin.x() + rectified.right() * step.x();
+        const auto bottom = origin.y() + rectified.bottom() * step.y();
+        for ( unsigned int npx = 0; npx < numLinesX; ++npx ) {     // Generate VERTICAL lines
+            const auto px = rectified.left() + ( npx * adaptativeScale );
+            const auto x = origin.x() + px * step.x();
+            const qreal halfWidth = isMajor( px, adaptativeScale ) ? 1. : 0.5;
+            appendQuad( x - halfWidth, top, x + halfWidth, bottom );
         }
-        for ( unsigned int p = cachedLinesCount; p < linesCount; p++ ) {   // Initialize the necessary items
-            const auto point = qobject_cast<QObject*>(getGeometryComponent()->create(gridContext));
-            if ( point != nullptr ) {
-                point->setParent( getGridShape() );
-                emit addLine(point);
-                _lines[p] = point;
-            }
+        for ( unsigned int npy = 0; npy < numLinesY; ++npy ) {     // Generate HORIZONTAL lines
+            const auto py = rectified.top() + ( npy * adaptativeScale );
+            const auto y = origin.y() + py * step.y();
+            const qreal halfWidth = isMajor( py, adaptativeScale ) ? 1. : 0.5;
+            appendQuad( left, y - halfWidth, right, y + halfWidth );
         }
     }
-    if ( _lines.size() < linesCount )
-        return false;
-
-    const auto navigableRectified = container.mapRectToItem(&navigable, rectified);
-    unsigned int p = 0; // Generate HORIZONTAL lines
-    for ( unsigned int npx = 0; npx < numLinesX; ++npx ) {
-        auto px = rectifiedTopLeft.x() + ( npx * adaptativeScale );
-        bool isMajorColumn = qFuzzyCompare( 1. + std::fmod(px, gridMajor * adaptativeScale), 1. );
-        auto navigablePoint = container.mapToItem(&navigable, QPointF{px, 0.});
-        _lines[p]->setProperty( "visible", QVariant{true});
-        _lines[p]->setProperty( "startX", QVariant{navigablePoint.x()});
-        _lines[p]->setProperty( "startY", QVariant{navigableRectified.top()});
-        _lines[p]->setProperty( "endX", QVariant{navigablePoint.x()});
-        _lines[p]->setProperty( "endY", QVariant{navigableRectified.bottom()});
-        _lines[p]->setProperty( "strokeWidth", QVariant{ isMajorColumn ? 2. : 1. } );
-        ++p;
-    }
-    for ( unsigned int npy = 0; npy < numLinesY; ++npy ) {   // Generate VERTICAL lines
-        auto py = rectifiedTopLeft.y() + ( npy * adaptativeScale );
-        bool isMajorRow = qFuzzyCompare( 1. + std::fmod(py, gridMajor * adaptativeScale), 1. );
-        auto navigablePoint = container.mapToItem(&navigable, QPointF{0., py});
-        _lines[p]->setProperty( "visible", QVariant{true});
-        _lines[p]->setProperty( "startX", QVariant{navigableRectified.left()});
-        _lines[p]->setProperty( "startY", QVariant{navigablePoint.y()});
-        _lines[p]->setProperty( "endX", QVariant{navigableRectified.right()});
-        _lines[p]->setProperty( "endY", QVariant{navigablePoint.y()});
-        _lines[p]->setProperty( "strokeWidth", QVariant{ isMajorRow ? 2. : 1. } );
-        ++p;
-    }
-    while (p < _lines.size()) {    // Hide unconfigured cached points
-        if ( _lines[p] != nullptr )
-            _lines[p]->setProperty("visible", QVariant{false});
-        ++p;
-    }
+    update();
     return true;
 }
 //-----------------------------------------------------------------------------
@@ -35,9 +35,13 @@
 #ifndef qanPointGrid_h
 #define qanPointGrid_h
 
+// Std headers
+#include <vector>
+
 // Qt headers
 #include <QtQml>
 #include <QQuickItem>
+#include <QSGGeometryNode>
 
 namespace qan {  // ::qan
 
@@ -120,9 +124,15 @@ private:
 
 /*! \brief Abstract grid with orthogonal geometry.
  *
- * \warning Changing \c geometryComponent dynamically is impossible and sill issue
- * a warning.
+ * Grid thicks are drawn in a single scene graph geometry node: concrete grids generate a list of rectangles
+ * in updateGrid() (see appendQuad()) and no QML object is created, whatever the number of thicks in view. Since
+ * thick spacing is adapted to zoom, the number of generated rectangles depends only on the view size.
+ *
+ * With Qt Quick software backend (QSGGeometryNode with custom materials are not drawn), every rectangle is
+ * drawn with a rectangle node created with QQuickWindow::createRectangleNode().
  *
+ * \note \c geometryComponent (and LineGrid \c gridShape and \c addLine()) have been removed since grids no
+ * longer create QML objects: remove them from custom grid definitions.
  * \nosubgrouping
  */
 class OrthoGrid : public Grid
@@ -139,20 +149,6 @@ public:
 
     /*! \name Grid Management *///---------------------------------------------
     //@{
-public:
-    //! Component used to generate grid concrete layout: usually a rounded Rectangle for point grid or a Qt Quick ShapePath for LineGrid.
-    Q_PROPERTY( QQmlComponent* geometryComponent READ getGeometryComponent WRITE setGeometryComponent NOTIFY geometryComponentChanged FINAL )
-    //! \copydoc geometryComponent
-    void                    setGeometryComponent( QQmlComponent* geometryComponent ) noexcept;
-    //! \copydoc geometryComponent
-    inline QQmlComponent*   getGeometryComponent() noexcept { return _geometryComponent.data(); }
-signals:
-    //! \copydoc geometryComponent
-    void                    geometryComponentChanged();
-private:
-    //! \copydoc geometryComponent
-    QPointer< QQmlComponent > _geometryComponent{ nullptr };
-
 public:
     virtual bool    updateGrid(const QRectF& viewRect,
                                const QQuickItem& container,
@@ -160,6 +156,17 @@ public:
 protected:
     virtual bool    updateGrid() noexcept override;
 
+    /*! \brief Compute adaptative grid layout for \c viewRect, return false if there is nothing to draw.
+     *
+     * \c origin and \c step are used to project a container point (x, y) in grid CS with
+     * (origin.x + x * step.x, origin.y + y * step.y).
+     */
+    bool            generateLayout( const QRectF& viewRect, const QQuickItem& container, const QQuickItem& navigable,
+                                    QRectF& rectified, qreal& adaptativeScale,
+                                    QPointF& origin, QPointF& step ) const noexcept;
+    //! Return true if container coordinate \c c is on a major thick for \c adaptativeScale.
+    bool            isMajor( qreal c, qreal adaptativeScale ) const noexcept;
+
 private:
     //! View rect cached updated in updateGrid(), allow updateGrid() use with no arguments.
     QRectF                  _viewRectCache;
@@ -169,12 +176,31 @@ private:
     QPointer<QQuickItem>    _navigableCache;
     //@}
     //-------------------------------------------------------------------------
+
+    /*! \name Grid Rendering *///----------------------------------------------
+    //@{
+protected:
+    //! Append rectangle (\c left, \c top, \c right, \c bottom) to grid quads.
+    inline void     appendQuad( qreal left, qreal top, qreal right, qreal bottom ) {
+        _quads.emplace_back( QPointF{ left, top }, QPointF{ right, bottom } );
+    }
+    //! Grid rectangles in grid CS, generated in updateGrid() and copied to scene graph in updatePaintNode().
+    std::vector<QRectF>     _quads;
+
+    virtual QSGNode*    updatePaintNode( QSGNode* oldNode, UpdatePaintNodeData* ) override;
+private:
+    //! Write grid quads triangles in \c node geometry (default hardware accelerated backends).
+    void                updateGeometryNode( QSGGeometryNode& node ) noexcept;
+    //! Write grid quads in \c node rectangle node children (software backend).
+    void                updateRectangleNodes( QSGNode& node ) noexcept;
+    //@}
+    //-------------------------------------------------------------------------
 };
 
 
 /*! \brief Draw an (orthogonal) adaptative grid of point on a qan::Navigable \c overlay or \c underlay.
  *
- * A valid QML Component must be provided by the user to visualize points, for example:
+ * Points are squares of \c gridWidth size (1.5 times larger on major thicks) filled with \c thickColor:
  * \code
  *  Qan.Navigable {
  *    navigable: true
@@ -203,15 +229,13 @@ public:
     virtual bool    updateGrid(const QRectF& viewRect,
                                const QQuickItem& container,
                                const QQuickItem& navigable ) noexcept override;
-private:
-    //! Grid points cache.
-    std::vector<QQuickItem*>    _points;
     //@}
     //-------------------------------------------------------------------------
 };
 
 /*! * \brief Draw an orthogonal grid with lines.
  *
+ * Lines are 1 pixel wide (2 pixels on major thicks) and filled with \c thickColor:
  * \code
  *  Qan.Navigable {
  *    navigable: true
@@ -236,30 +260,10 @@ public:
 
     /*! \name Grid Management *///---------------------------------------------
     //@{
-public:
-    //! Concrete grid Qt Quick Shape visual view.
-    Q_PROPERTY( QObject* gridShape READ getGridShape WRITE setGridShape NOTIFY gridShapeChanged FINAL )
-    //! \copydoc gridShape
-    void                setGridShape( QObject* gridShape ) noexcept;
-    //! \copydoc gridShape
-    inline QObject*     getGridShape() noexcept { return _gridShape.data(); }
-signals:
-    //! \copydoc gridShape
-    void                gridShapeChanged();
-private:
-    //! \copydoc gridShape
-    QPointer< QObject > _gridShape{nullptr};
-signals:
-    //! Emmited when a new line should be inserted in the grid internall Shape (Qt Quick Shapes) view.
-    void                addLine(QObject* line);
-
 public:
     virtual bool        updateGrid(const QRectF& viewRect,
                                    const QQuickItem& container,
                                    const QQuickItem& navigable ) noexcept override;
-private:
-    //! Grid line cache (contains QuickShapePath* objects).
-    std::vector<QObject*>   _lines;
     //@}
     //-------------------------------------------------------------------------
 };
@@ -70,11 +70,10 @@ const qan::GroupItem*   Group::getItem() const noexcept { return _item.data(); }
 
 void    Group::setItem(qan::GroupItem* item) noexcept
 {
-    if ( item != nullptr ) {
-        _item = item;
-        if ( item->getGroup() != this )
-            item->setGroup(this);
-    }
+    _item = item;
+    if ( item != nullptr &&
+         item->getGroup() != this )
+        item->setGroup(this);
 }
 
 void    Group::itemProposeNodeDrop()
@@ -81,12 +81,15 @@ qan::AbstractDraggableCtrl& GroupItem::draggableCtrl() { Q_ASSERT(_draggableCtrl
 auto    GroupItem::getGroup() noexcept -> qan::Group* { return _group.data(); }
 auto    GroupItem::getGroup() const noexcept -> const qan::Group* { return _group.data(); }
 auto    GroupItem::setGroup(qan::Group* group) noexcept -> void {
+    const bool groupChanged = group != _group;
     _group = group;
     if ( group != nullptr &&            // Warning: Do that after having set _group
          group->getItem() != this )
         group->setItem(this);
     const auto groupDraggableCtrl = static_cast<GroupDraggableCtrl*>(_draggableCtrl.get());
     groupDraggableCtrl->setTarget(group);
+    if ( groupChanged )
+        emit this->groupChanged();
 }
 
 auto    GroupItem::setGraph(qan::Graph* graph) noexcept -> void {
@@ -97,6 +100,15 @@ auto    GroupItem::getGraph() const noexcept -> const qan::Graph* { return _grap
 auto    GroupItem::getGraph() noexcept -> qan::Graph* { return _graph.data(); }
 //-----------------------------------------------------------------------------
 
+/* Recycling Management *///-------------------------------------------------
+void    GroupItem::itemPooled() noexcept
+{
+    setSelected(false);     // Selection item is kept and reused with this item
+    setDragged(false);
+    setGroup(nullptr);
+}
+//-----------------------------------------------------------------------------
+
 /* Style Management *///-------------------------------------------------------
 void    GroupItem::setStyle( qan::Style* style ) noexcept
 {
@@ -161,7 +173,7 @@ void    GroupItem::groupMoved()
             qan::Edge* edge = weakEdge.lock().get();
             if ( edge != nullptr &&
                  edge->getItem() != nullptr )
-                edge->getItem()->updateItem();
+                edge->getItem()->invalidateGeometry();  // Coalesced: x and y changes are processed once per frame
         }
     }
 }
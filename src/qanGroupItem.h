@@ -44,6 +44,7 @@
 #include "./qanGraphConfig.h"
 #include "./qanSelectable.h"
 #include "./qanDraggable.h"
+#include "./qanRecyclable.h"
 #include "./qanAbstractDraggableCtrl.h"
 #include "./qanNode.h"
 #include "./qanGroup.h"
@@ -61,13 +62,15 @@ class Graph;
  */
 class GroupItem : public QQuickItem,
                   public qan::Selectable,
-                  public qan::Draggable
+                  public qan::Draggable,
+                  public qan::Recyclable
 {
     /*! \name Group Object Management *///-------------------------------------
     //@{
     Q_OBJECT
     Q_INTERFACES(qan::Selectable)
     Q_INTERFACES(qan::Draggable)
+    Q_INTERFACES(qan::Recyclable)
 public:
     //! Group constructor.
     explicit GroupItem( QQuickItem* parent = nullptr );
@@ -80,12 +83,15 @@ private:
     std::unique_ptr<qan::AbstractDraggableCtrl> _draggableCtrl;
 
 public:
-    Q_PROPERTY( qan::Group* group READ getGroup CONSTANT FINAL )
+    //! Item group (might change when item is reused from a qan::ItemPool).
+    Q_PROPERTY( qan::Group* group READ getGroup NOTIFY groupChanged FINAL )
     auto        getGroup() noexcept -> qan::Group*;
     auto        getGroup() const noexcept -> const qan::Group*;
     auto        setGroup(qan::Group* group) noexcept -> void;
 private:
     QPointer<qan::Group> _group{nullptr};
+signals:
+    void        groupChanged();
 
 public:
     Q_PROPERTY( qan::Graph* graph READ getGraph FINAL )
@@ -100,6 +106,14 @@ private:
     //@}
     //-------------------------------------------------------------------------
 
+    /*! \name Recycling Management *///--------------------------------------
+    //@{
+public:
+    //! Reset selection, dragging and group reference (see qan::Recyclable::itemPooled()).
+    virtual void    itemPooled() noexcept override;
+    //@}
+    //-------------------------------------------------------------------------
+
     /*! \name Style Management *///--------------------------------------------
     //@{
 public:
@@ -0,0 +1,350 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the QuickQanava software library.
+//
+// \file	qanIncrementalLayout.cpp
+// \author	benoit@destrat.io
+// \date	2017 12 28
+//-----------------------------------------------------------------------------
+
+// Std headers
+#include <algorithm>
+
+// GTpo headers
+#include <gtpoIncrementalLayout.h>
+
+// QuickQanava headers
+#include "./qanIncrementalLayout.h"
+#include "./qanNodeItem.h"
+
+namespace qan { // ::qan
+
+/* IncrementalLayout Object Management *///------------------------------------
+IncrementalLayout::IncrementalLayout( QObject* parent ) :
+    QObject{ parent },
+    _layout{ std::make_unique<gtpo::IncrementalLayout>() }
+{
+    _relayoutTimer.setSingleShot( true );
+    _relayoutTimer.setInterval( 0 );
+    connect( &_relayoutTimer,   &QTimer::timeout,
+             this,              &IncrementalLayout::processEdits );
+}
+
+IncrementalLayout::~IncrementalLayout()
+{
+    if ( _graph )
+        ForwardingBehaviour<qan::IncrementalLayout>::uninstall( *_graph, this );
+}
+//-----------------------------------------------------------------------------
+
+/* Layout Configuration *///---------------------------------------------------
+void    IncrementalLayout::setGraph( qan::Graph* graph ) noexcept
+{
+    if ( graph != _graph ) {
+        if ( _graph ) {
+            ForwardingBehaviour<qan::IncrementalLayout>::uninstall( *_graph, this );
+            disconnect( _graph, nullptr, this, nullptr );
+        }
+        _graph = graph;
+        if ( _graph ) {
+            ForwardingBehaviour<qan::IncrementalLayout>::install( *_graph, this );
+            connect( _graph,    &qan::Graph::cleared,
+                     this,      &IncrementalLayout::graphCleared );
+        }
+        reset();
+        emit graphChanged();
+    }
+}
+
+void    IncrementalLayout::setEnabled( bool enabled ) noexcept
+{
+    if ( enabled != _enabled ) {
+        _enabled = enabled;
+        reset();            // Modifications are not tracked while disabled
+        emit enabledChanged();
+    }
+}
+
+void    IncrementalLayout::setHops( int hops ) noexcept
+{
+    hops = std::max( 0, hops );
+    if ( hops != _hops ) {
+        _hops = hops;
+        emit hopsChanged();
+    }
+}
+
+void    IncrementalLayout::setMaxNodes( int maxNodes ) noexcept
+{
+    maxNodes = std::max( 1, maxNodes );
+    if ( maxNodes != _maxNodes ) {
+        _maxNodes = maxNodes;
+        emit maxNodesChanged();
+    }
+}
+
+void    IncrementalLayout::setIdealEdgeLength( qreal idealEdgeLength ) noexcept
+{
+    idealEdgeLength = std::max( 1., idealEdgeLength );
+    if ( !qFuzzyCompare( 1. + idealEdgeLength, 1. + _idealEdgeLength ) ) {
+        _idealEdgeLength = idealEdgeLength;
+        emit idealEdgeLengthChanged();
+    }
+}
+
+void    IncrementalLayout::setNodeSpacing( qreal nodeSpacing ) noexcept
+{
+    nodeSpacing = std::max( 0., nodeSpacing );
+    if ( !qFuzzyCompare( 1. + nodeSpacing, 1. + _nodeSpacing ) ) {
+        _nodeSpacing = nodeSpacing;
+        emit nodeSpacingChanged();
+    }
+}
+
+void    IncrementalLayout::setStability( qreal stability ) noexcept
+{
+    stability = std::max( 0., stability );
+    if ( !qFuzzyCompare( 1. + stability, 1. + _stability ) ) {
+        _stability = stability;
+        emit stabilityChanged();
+    }
+}
+
+void    IncrementalLayout::setTimeBudget( qreal timeBudget ) noexcept
+{
+    timeBudget = std::max( 0.1, timeBudget );
+    if ( !qFuzzyCompare( 1. + timeBudget, 1. + _timeBudget ) ) {
+        _timeBudget = timeBudget;
+        emit timeBudgetChanged();
+    }
+}
+//-----------------------------------------------------------------------------
+
+/* Layout Management *///------------------------------------------------------
+void    IncrementalLayout::reset()
+{
+    _relayoutTimer.stop();
+    auto& layout = *_layout;
+    layout.clear();
+    _nodes.clear();
+    _nodeIndexes.clear();
+    _edgeIndexes.clear();
+    _insertedNodes.clear();
+    _insertedEdges.clear();
+    if ( !_graph ||
+         !_enabled )
+        return;
+
+    // Load actual ungrouped nodes geometry and edges between them, they are considered already placed
+    _nodes.reserve( static_cast<std::size_t>( _graph->getNodeCount() ) );
+    _nodeIndexes.reserve( _graph->getNodeCount() );
+    for ( const auto& node : _graph->getNodes() ) {
+        if ( !node ||
+             !node->getGroup().expired() )
+            continue;
+        const auto geometry = node->getGeometry();
+        const auto center = geometry.center();
+        _nodeIndexes.insert( node.get(), layout.addNode( geometry.width(), geometry.height(),
+                                                         center.x(), center.y(), false ) );
+        _nodes.emplace_back( node.get() );
+    }
+    for ( const auto& edge : _graph->getEdges() ) {
+        if ( !edge )
+            continue;
+        const auto src = _nodeIndexes.constFind( edge->getSrc().lock().get() );
+        const auto dst = _nodeIndexes.constFind( edge->getDst().lock().get() );  // Null for hyper edges
+        if ( src != _nodeIndexes.constEnd() &&
+             dst != _nodeIndexes.constEnd() )
+            _edgeIndexes.insert( edge.get(), layout.addEdge( src.value(), dst.value(), false ) );
+    }
+}
+
+void    IncrementalLayout::relayout( qan::Node* node )
+{
+    const auto index = _nodeIndexes.constFind( node );
+    if ( index == _nodeIndexes.constEnd() )
+        return;
+    _layout->markDirty( index.value() );
+    scheduleRelayout();
+}
+
+void    IncrementalLayout::nodeInserted( qan::Node* node )
+{
+    if ( node == nullptr ||
+         !_enabled )
+        return;
+    _insertedNodes.emplace_back( node );
+    scheduleRelayout();
+}
+
+void    IncrementalLayout::nodeRemoved( qan::Node* node )
+{
+    if ( node == nullptr ||
+         !_enabled )
+        return;
+    // Node might be destroyed later, it must not be inserted on next processEdits()
+    _insertedNodes.erase( std::remove( _insertedNodes.begin(), _insertedNodes.end(), node ), _insertedNodes.end() );
+    const auto index = _nodeIndexes.find( node );
+    if ( index == _nodeIndexes.end() )
+        return;
+    // Adjacent edges are removed from layout with their node, they are notified afterward
+    for ( const auto& inEdge : node->getInEdges() )
+        _edgeIndexes.remove( inEdge.lock().get() );
+    for ( const auto& outEdge : node->getOutEdges() )
+        _edgeIndexes.remove( outEdge.lock().get() );
+    _layout->removeNode( index.value() );
+    _nodes[ index.value() ] = nullptr;
+    _nodeIndexes.erase( index );
+    scheduleRelayout();
+}
+
+void    IncrementalLayout::edgeInserted( qan::Edge* edge )
+{
+    if ( edge == nullptr ||
+         !_enabled )
+        return;
+    _insertedEdges.emplace_back( edge );
+    scheduleRelayout();
+}
+
+void    IncrementalLayout::edgeRemoved( qan::Edge* edge )
+{
+    if ( edge == nullptr ||
+         !_enabled )
+        return;
+    _insertedEdges.erase( std::remove( _insertedEdges.begin(), _insertedEdges.end(), edge ), _insertedEdges.end() );
+    const auto index = _edgeIndexes.find( edge );
+    if ( index == _edgeIndexes.end() )
+        return;
+    _layout->removeEdge( index.value() );
+    _edgeIndexes.erase( index );
+    scheduleRelayout();
+}
+
+void    IncrementalLayout::graphCleared()
+{
+    if ( _graph )
+        ForwardingBehaviour<qan::IncrementalLayout>::install( *_graph, this );
+    reset();
+}
+
+void    IncrementalLayout::scheduleRelayout() noexcept
+{
+    if ( !_relayoutTimer.isActive() )
+        _relayoutTimer.start();
+}
+
+void    IncrementalLayout::refreshGeometry( std::uint32_t node )
+{
+    const auto graphNode = _nodes[ node ].data();
+    if ( graphNode == nullptr ||
+         !graphNode->getGroup().expired() )
+        return;
+    const auto geometry = graphNode->getGeometry();
+    const auto center = geometry.center();
+    _layout->setGeometry( node, geometry.width(), geometry.height(), center.x(), center.y() );
+}
+
+void    IncrementalLayout::processEdits()
+{
+    if ( !_graph ||
+         !_enabled )
+        return;
+    auto& layout = *_layout;
+
+    // Inserted nodes and edges are now fully initialized (node items and geometry are set)
+    for ( const auto& node : _insertedNodes ) {
+        if ( !node ||
+             !node->getGroup().expired() ||
+             _nodeIndexes.contains( node.data() ) )
+            continue;
+        const auto geometry = node->getGeometry();
+        const auto center = geometry.center();
+        const auto index = layout.addNode( geometry.width(), geometry.height(), center.x(), center.y() );
+        if ( index >= _nodes.size() )
+            _nodes.resize( index + 1 );
+        _nodes[ index ] = node;
+        _nodeIndexes.insert( node.data(), index );
+    }
+    _insertedNodes.clear();
+    for ( const auto& edge : _insertedEdges ) {
+        if ( !edge ||
+             _edgeIndexes.contains( edge.data() ) )
+            continue;
+        const auto src = _nodeIndexes.constFind( edge->getSrc().lock().get() );
+        const auto dst = _nodeIndexes.constFind( edge->getDst().lock().get() );  // Null for hyper edges
+        if ( src != _nodeIndexes.constEnd() &&
+             dst != _nodeIndexes.constEnd() )
+            _edgeIndexes.insert( edge.data(), layout.addEdge( src.value(), dst.value() ) );
+    }
+    _insertedEdges.clear();
+    if ( !layout.hasDirtyNodes() )
+        return;
+
+    layout.hops = static_cast<unsigned int>( _hops );
+    layout.maxNodes = static_cast<std::size_t>( _maxNodes );
+    layout.idealEdgeLength = _idealEdgeLength;
+    layout.nodeSpacing = _nodeSpacing;
+    layout.stability = _stability;
+    layout.timeBudget = _timeBudget;
+    const auto& nodes = layout.prepare();
+
+    // Nodes might have been moved by user or by another layout: refresh relaid out nodes and nodes around them
+    for ( const auto node : nodes )
+        refreshGeometry( node );
+    const auto region = layout.getRegion();
+    if ( region.width() > 0. ) {
+        const auto children = _graph->graphChildrenIn( QRectF{ region.left, region.top, region.width(), region.height() } );
+        for ( const auto& child : children ) {
+            const auto nodeItem = qobject_cast<qan::NodeItem*>( child.value<QQuickItem*>() );
+            const auto index = _nodeIndexes.constFind( nodeItem != nullptr ? nodeItem->getNode() : nullptr );
+            if ( index != _nodeIndexes.constEnd() )
+                refreshGeometry( index.value() );
+        }
+    }
+    layout.optimize();
+
+    // Apply modified positions in a single batch, edges are then updated once
+    _graph->beginGeometryUpdate();
+    for ( const auto node : nodes ) {
+        const auto graphNode = _nodes[ node ].data();
+        if ( graphNode == nullptr ||
+             !graphNode->getGroup().expired() )
+            continue;
+        auto geometry = graphNode->getGeometry();
+        geometry.moveCenter( QPointF{ layout.x[ node ], layout.y[ node ] } );
+        graphNode->setGeometry( geometry );
+    }
+    _graph->endGeometryUpdate();
+    if ( layout.hasDirtyNodes() )       // Too many modified nodes, continue on next event loop iteration
+        scheduleRelayout();
+    emit finished();
+}
+//-----------------------------------------------------------------------------
+
+} // ::qan
@@ -0,0 +1,257 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the QuickQanava software library.
+//
+// \file	qanIncrementalLayout.h
+// \author	benoit@destrat.io
+// \date	2017 12 28
+//-----------------------------------------------------------------------------
+
+#ifndef qanIncrementalLayout_h
+#define qanIncrementalLayout_h
+
+// Std headers
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Qt headers
+#include <QObject>
+#include <QPointer>
+#include <QHash>
+#include <QTimer>
+
+// QuickQanava headers
+#include "./qanGraph.h"
+#include "./qanForwardingBehaviour.h"
+
+namespace gtpo {
+class IncrementalLayout;
+}
+
+namespace qan { // ::qan
+
+/*! \brief Incremental, stability preserving relayout of a graph after node and edge insertions or removals.
+ *
+ * Layout observe \c graph topology modifications with a GTpo graph behaviour. Edits are coalesced and processed
+ * on next event loop iteration: only the \c hops neighbourhood of modified nodes (at most \c maxNodes nodes) is
+ * re-optimized, all other nodes keep their position (see gtpo::IncrementalLayout). Inserted nodes are placed near
+ * their neighbours, positions are applied in a single geometry update (see qan::Graph::beginGeometryUpdate()).
+ *
+ * Optimization stops after \c timeBudget milliseconds, when too many nodes are modified at once, remaining nodes are
+ * relaid out on following event loop iterations so that the GUI is never blocked for more than a frame.
+ *
+ * \code
+ *  Qan.IncrementalLayout {
+ *    graph: graphView.graph
+ *    idealEdgeLength: 150
+ *  }
+ * \endcode
+ *
+ * \note Grouped nodes and hyper edges are ignored. Nodes moved outside of this layout are refreshed when they are
+ * near an edit, call reset() after a complete graph layout.
+ */
+class IncrementalLayout : public QObject
+{
+    /*! \name IncrementalLayout Object Management *///-------------------------
+    //@{
+    Q_OBJECT
+public:
+    explicit IncrementalLayout( QObject* parent = nullptr );
+    virtual ~IncrementalLayout();
+    IncrementalLayout( const IncrementalLayout& ) = delete;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Layout Configuration *///----------------------------------------
+    //@{
+public:
+    //! Observed graph (default to nullptr).
+    Q_PROPERTY( qan::Graph* graph READ getGraph WRITE setGraph NOTIFY graphChanged FINAL )
+    //! \copydoc graph
+    inline qan::Graph*  getGraph() const noexcept { return _graph.data(); }
+    //! \copydoc graph
+    void                setGraph( qan::Graph* graph ) noexcept;
+private:
+    //! \copydoc graph
+    QPointer<qan::Graph> _graph;
+signals:
+    //! \copydoc graph
+    void                graphChanged();
+
+public:
+    //! Graph edits are relaid out only when true (default to true).
+    Q_PROPERTY( bool enabled READ getEnabled WRITE setEnabled NOTIFY enabledChanged FINAL )
+    //! \copydoc enabled
+    inline bool     getEnabled() const noexcept { return _enabled; }
+    //! \copydoc enabled
+    void            setEnabled( bool enabled ) noexcept;
+private:
+    //! \copydoc enabled
+    bool            _enabled{ true };
+signals:
+    //! \copydoc enabled
+    void            enabledChanged();
+
+public:
+    //! Maximum graph distance between a modified node and a relaid out node (default to 2).
+    Q_PROPERTY( int hops READ getHops WRITE setHops NOTIFY hopsChanged FINAL )
+    //! \copydoc hops
+    inline int      getHops() const noexcept { return _hops; }
+    //! \copydoc hops
+    void            setHops( int hops ) noexcept;
+private:
+    //! \copydoc hops
+    int             _hops{ 2 };
+signals:
+    //! \copydoc hops
+    void            hopsChanged();
+
+public:
+    //! Maximum number of nodes relaid out in one event loop iteration (default to 256).
+    Q_PROPERTY( int maxNodes READ getMaxNodes WRITE setMaxNodes NOTIFY maxNodesChanged FINAL )
+    //! \copydoc maxNodes
+    inline int      getMaxNodes() const noexcept { return _maxNodes; }
+    //! \copydoc maxNodes
+    void            setMaxNodes( int maxNodes ) noexcept;
+private:
+    //! \copydoc maxNodes
+    int             _maxNodes{ 256 };
+signals:
+    //! \copydoc maxNodes
+    void            maxNodesChanged();
+
+public:
+    //! Ideal distance between two adjacent nodes centers (default to 150.).
+    Q_PROPERTY( qreal idealEdgeLength READ getIdealEdgeLength WRITE setIdealEdgeLength NOTIFY idealEdgeLengthChanged FINAL )
+    //! \copydoc idealEdgeLength
+    inline qreal    getIdealEdgeLength() const noexcept { return _idealEdgeLength; }
+    //! \copydoc idealEdgeLength
+    void            setIdealEdgeLength( qreal idealEdgeLength ) noexcept;
+private:
+    //! \copydoc idealEdgeLength
+    qreal           _idealEdgeLength{ 150. };
+signals:
+    //! \copydoc idealEdgeLength
+    void            idealEdgeLengthChanged();
+
+public:
+    //! Minimum space between two nodes (default to 20.).
+    Q_PROPERTY( qreal nodeSpacing READ getNodeSpacing WRITE setNodeSpacing NOTIFY nodeSpacingChanged FINAL )
+    //! \copydoc nodeSpacing
+    inline qreal    getNodeSpacing() const noexcept { return _nodeSpacing; }
+    //! \copydoc nodeSpacing
+    void            setNodeSpacing( qreal nodeSpacing ) noexcept;
+private:
+    //! \copydoc nodeSpacing
+    qreal           _nodeSpacing{ 20. };
+signals:
+    //! \copydoc nodeSpacing
+    void            nodeSpacingChanged();
+
+public:
+    //! Strength of the spring keeping existing nodes at their position, higher values give a more stable layout (default to 0.3).
+    Q_PROPERTY( qreal stability READ getStability WRITE setStability NOTIFY stabilityChanged FINAL )
+    //! \copydoc stability
+    inline qreal    getStability() const noexcept { return _stability; }
+    //! \copydoc stability
+    void            setStability( qreal stability ) noexcept;
+private:
+    //! \copydoc stability
+    qreal           _stability{ 0.3 };
+signals:
+    //! \copydoc stability
+    void            stabilityChanged();
+
+public:
+    //! Maximum optimization duration per event loop iteration in milliseconds (default to 8.).
+    Q_PROPERTY( qreal timeBudget READ getTimeBudget WRITE setTimeBudget NOTIFY timeBudgetChanged FINAL )
+    //! \copydoc timeBudget
+    inline qreal    getTimeBudget() const noexcept { return _timeBudget; }
+    //! \copydoc timeBudget
+    void            setTimeBudget( qreal timeBudget ) noexcept;
+private:
+    //! \copydoc timeBudget
+    qreal           _timeBudget{ 8. };
+signals:
+    //! \copydoc timeBudget
+    void            timeBudgetChanged();
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Layout Management *///-------------------------------------------
+    //@{
+public:
+    //! Reload \c graph actual topology and node positions, pending edits are dropped.
+    Q_INVOKABLE void    reset();
+    //! Relayout \c node neighbourhood on next event loop iteration.
+    Q_INVOKABLE void    relayout( qan::Node* node );
+
+signals:
+    //! Emitted when modified nodes neighbourhood has been relaid out and applied to graph nodes.
+    void            finished();
+
+private:
+    friend class qan::ForwardingBehaviour<qan::IncrementalLayout>;
+    //! Called from \c graph behaviour when a node is inserted (node is not fully initialized yet).
+    void            nodeInserted( qan::Node* node );
+    //! Called from \c graph behaviour before a node is removed.
+    void            nodeRemoved( qan::Node* node );
+    //! Called from \c graph behaviour when an edge is inserted.
+    void            edgeInserted( qan::Edge* edge );
+    //! Called from \c graph behaviour before an edge is removed.
+    void            edgeRemoved( qan::Edge* edge );
+    //! Reinstall \c graph behaviour (destroyed with graph content) and reload empty graph after qan::Graph::clear().
+    void            graphCleared();
+
+    //! Schedule processEdits() on next event loop iteration.
+    void            scheduleRelayout() noexcept;
+    //! Insert pending nodes and edges, then relayout modified nodes neighbourhood.
+    void            processEdits();
+    //! Set layout \c node geometry from its actual graph geometry.
+    void            refreshGeometry( std::uint32_t node );
+
+private:
+    std::unique_ptr<gtpo::IncrementalLayout>    _layout;
+    //! Nodes of layout, in layout node index order.
+    std::vector<QPointer<qan::Node>>            _nodes;
+    QHash<const qan::Node*, std::uint32_t>      _nodeIndexes;
+    QHash<const qan::Edge*, std::uint32_t>      _edgeIndexes;
+    //! Nodes and edges inserted since last processEdits(), inserted in layout once fully initialized.
+    std::vector<QPointer<qan::Node>>            _insertedNodes;
+    std::vector<QPointer<qan::Edge>>            _insertedEdges;
+    QTimer                                      _relayoutTimer;
+    //@}
+    //-------------------------------------------------------------------------
+};
+
+} // ::qan
+
+QML_DECLARE_TYPE( qan::IncrementalLayout )
+
+#endif // qanIncrementalLayout_h
@@ -0,0 +1,263 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the QuickQanava software library.
+//
+// \file	qanItemPool.cpp
+// \author	benoit@destrat.io
+// \date	2017 12 14
+//-----------------------------------------------------------------------------
+
+// Std headers
+#include <algorithm>
+
+// Qt headers
+#include <QDebug>
+
+// QuickQanava headers
+#include "./qanItemPool.h"
+
+namespace qan { // ::qan
+
+/* ItemPool Object Management *///---------------------------------------------
+ItemPool::ItemPool( QObject* parent ) :
+    QObject{ parent }
+{
+}
+
+ItemPool::~ItemPool()
+{
+    clear();
+}
+
+ItemPoolAttached*   ItemPool::qmlAttachedProperties( QObject* object )
+{
+    return new ItemPoolAttached{ object };
+}
+//-----------------------------------------------------------------------------
+
+/* Pool Configuration *///-----------------------------------------------------
+void    ItemPool::setEnabled( bool enabled ) noexcept
+{
+    if ( enabled != _enabled ) {
+        _enabled = enabled;
+        if ( !_enabled )
+            clear();
+        emit enabledChanged();
+    }
+}
+
+void    ItemPool::setHighWaterMark( int highWaterMark ) noexcept
+{
+    highWaterMark = std::max( 0, highWaterMark );
+    if ( highWaterMark != _highWaterMark ) {
+        _highWaterMark = highWaterMark;
+        for ( const auto component : _pools.keys() )
+            trim( component );
+        emit highWaterMarkChanged();
+    }
+}
+
+void    ItemPool::setComponentHighWaterMark( QQmlComponent* component, int highWaterMark ) noexcept
+{
+    if ( component == nullptr ) {
+        qWarning() << "qan::ItemPool::setComponentHighWaterMark(): Error: Invalid nullptr component.";
+        return;
+    }
+    componentPool( component ).highWaterMark = std::max( -1, highWaterMark );
+    trim( component );
+}
+
+int     ItemPool::getComponentHighWaterMark( QQmlComponent* component ) const noexcept
+{
+    const auto poolIter = _pools.constFind( component );
+    return ( poolIter != _pools.constEnd() &&
+             poolIter->highWaterMark >= 0 ) ? poolIter->highWaterMark : _highWaterMark;
+}
+//-----------------------------------------------------------------------------
+
+/* Pool Management *///--------------------------------------------------------
+QQuickItem* ItemPool::acquire( QQmlComponent* component ) noexcept
+{
+    if ( component == nullptr )
+        return nullptr;
+    QQuickItem* item = nullptr;
+    const auto poolIter = _pools.find( component );
+    if ( poolIter != _pools.end() ) {
+        auto& items = poolIter->items;
+        while ( item == nullptr &&
+                !items.isEmpty() ) {
+            item = items.takeLast().data();     // Skip items that might have been destroyed while pooled
+            --_pooledCount;
+        }
+    }
+    if ( item != nullptr )
+        ++_hitCount;
+    else
+        ++_missCount;
+    emit statisticsChanged();
+    return item;
+}
+
+void    ItemPool::notifyReused( QQuickItem* item ) noexcept
+{
+    if ( item == nullptr )
+        return;
+    const auto recyclable = qobject_cast<qan::Recyclable*>( item );
+    if ( recyclable != nullptr )
+        recyclable->itemReused();
+    const auto attached = qobject_cast<qan::ItemPoolAttached*>( qmlAttachedPropertiesObject<qan::ItemPool>( item, false ) );
+    if ( attached != nullptr )
+        emit attached->reused();
+}
+
+void    ItemPool::track( QQuickItem* item, QQmlComponent* component ) noexcept
+{
+    if ( item == nullptr ||
+         component == nullptr )
+        return;
+    componentPool( component );
+    _components.insert( item, component );
+    connect( item, &QObject::destroyed,
+             this, [this, item]() { _components.remove( item ); } );
+}
+
+bool    ItemPool::recycle( QQuickItem* item ) noexcept
+{
+    if ( item == nullptr )
+        return false;
+    item->setVisible( false );
+    item->setParentItem( nullptr );
+
+    const auto component = _components.value( item, nullptr );
+    const auto recyclable = qobject_cast<qan::Recyclable*>( item );
+    if ( !_enabled ||
+         component == nullptr ||
+         ( recyclable != nullptr && !recyclable->isRecyclable() ) ||
+         getComponentPooledCount( component ) >= getComponentHighWaterMark( component ) ) {
+        item->deleteLater();
+        ++_discardedCount;
+        emit statisticsChanged();
+        return false;
+    }
+
+    // Reset C++ and then QML state
+    if ( recyclable != nullptr )
+        recyclable->itemPooled();
+    const auto attached = qobject_cast<qan::ItemPoolAttached*>( qmlAttachedPropertiesObject<qan::ItemPool>( item, false ) );
+    if ( attached != nullptr )
+        emit attached->pooled();
+
+    componentPool( component ).items.append( QPointer<QQuickItem>{ item } );  // Hooks might have modified pools, do not cache pool
+    ++_pooledCount;
+    ++_recycledCount;
+    emit statisticsChanged();
+    return true;
+}
+
+void    ItemPool::clear() noexcept
+{
+    for ( auto& pool : _pools )
+        for ( const auto& item : pool.items )
+            if ( item )
+                item->deleteLater();
+    for ( auto& pool : _pools )
+        pool.items.clear();
+    if ( _pooledCount != 0 ) {
+        _pooledCount = 0;
+        emit statisticsChanged();
+    }
+}
+
+void    ItemPool::trim( QQmlComponent* component ) noexcept
+{
+    const auto poolIter = _pools.find( component );
+    if ( poolIter == _pools.end() )
+        return;
+    const auto highWaterMark = getComponentHighWaterMark( component );
+    auto& items = poolIter->items;
+    if ( items.size() <= highWaterMark )
+        return;
+    while ( items.size() > highWaterMark ) {
+        const auto item = items.takeLast();
+        if ( item )
+            item->deleteLater();
+        --_pooledCount;
+        ++_discardedCount;
+    }
+    emit statisticsChanged();
+}
+
+ItemPool::Pool& ItemPool::componentPool( QQmlComponent* component ) noexcept
+{
+    auto poolIter = _pools.find( component );
+    if ( poolIter == _pools.end() ) {
+        poolIter = _pools.insert( component, Pool{} );
+        connect( component, &QObject::destroyed,
+                 this,      [this, component]() { removeComponent( component ); } );
+    }
+    return *poolIter;
+}
+
+void    ItemPool::removeComponent( QQmlComponent* component ) noexcept
+{
+    const auto poolIter = _pools.find( component );
+    if ( poolIter == _pools.end() )
+        return;
+    for ( const auto& item : poolIter->items ) {
+        if ( item )
+            item->deleteLater();
+        --_pooledCount;
+    }
+    _pools.erase( poolIter );
+    for ( auto itemIter = _components.begin(); itemIter != _components.end(); )
+        if ( itemIter.value() == component )
+            itemIter = _components.erase( itemIter );
+        else
+            ++itemIter;
+    emit statisticsChanged();
+}
+//-----------------------------------------------------------------------------
+
+/* Pool Statistics *///--------------------------------------------------------
+int     ItemPool::getComponentPooledCount( QQmlComponent* component ) const noexcept
+{
+    const auto poolIter = _pools.constFind( component );
+    return poolIter != _pools.constEnd() ? poolIter->items.size() : 0;
+}
+
+void    ItemPool::resetStatistics() noexcept
+{
+    _hitCount = 0;
+    _missCount = 0;
+    _recycledCount = 0;
+    _discardedCount = 0;
+    emit statisticsChanged();
+}
+//-----------------------------------------------------------------------------
+
+} // ::qan
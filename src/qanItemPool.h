@@ -0,0 +1,238 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the QuickQanava software library.
+//
+// \file	qanItemPool.h
+// \author	benoit@destrat.io
+// \date	2017 12 14
+//-----------------------------------------------------------------------------
+
+#ifndef qanItemPool_h
+#define qanItemPool_h
+
+// Qt headers
+#include <QObject>
+#include <QPointer>
+#include <QQuickItem>
+#include <QQmlComponent>
+#include <QQmlEngine>
+#include <QHash>
+#include <QVector>
+
+// QuickQanava headers
+#include "./qanRecyclable.h"
+
+namespace qan { // ::qan
+
+/*! \brief QML attached object used to reset delegate QML state when an item is pooled or reused.
+ *
+ * \code
+ *  Qan.NodeItem {
+ *    id: nodeItem
+ *    Qan.ItemPool.onPooled: { label.text = "" }
+ *    Qan.ItemPool.onReused: { label.text = nodeItem.node.label }
+ *  }
+ * \endcode
+ */
+class ItemPoolAttached : public QObject
+{
+    Q_OBJECT
+public:
+    explicit ItemPoolAttached( QObject* parent = nullptr ) : QObject{ parent } { }
+signals:
+    //! Emitted when attachee item has been stored in pool (it is invisible and has no parent item).
+    void    pooled();
+    //! Emitted when attachee item has been taken from pool and configured for a new primitive.
+    void    reused();
+};
+
+/*! \brief Pool of delegate items created from QML components, reused instead of creating new items with QQmlComponent::beginCreate().
+ *
+ * Items are pooled by delegate component: an item is only reused for a delegate with the same component. Each
+ * component pool is limited to \c highWaterMark items (could be configured for a specific component with
+ * setComponentHighWaterMark()), items recycled in a full pool are destroyed.
+ *
+ * Pooled items are reset by qan::Recyclable::itemPooled() in C++ and \c Qan.ItemPool.pooled() in QML, reused
+ * items are notified with qan::Recyclable::itemReused() and \c Qan.ItemPool.reused().
+ *
+ * \note qan::ItemPool is usually accessed from a qan::Graph \c itemPool property.
+ */
+class ItemPool : public QObject
+{
+    /*! \name ItemPool Object Management *///----------------------------------
+    //@{
+    Q_OBJECT
+public:
+    explicit ItemPool( QObject* parent = nullptr );
+    virtual ~ItemPool();
+    ItemPool( const ItemPool& ) = delete;
+
+    static ItemPoolAttached*    qmlAttachedProperties( QObject* object );
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Pool Configuration *///------------------------------------------
+    //@{
+public:
+    //! Set to false to disable pooling, recycled items are then destroyed (default to true).
+    Q_PROPERTY( bool enabled READ getEnabled WRITE setEnabled NOTIFY enabledChanged FINAL )
+    //! \copydoc enabled
+    inline bool     getEnabled() const noexcept { return _enabled; }
+    //! \copydoc enabled
+    void            setEnabled( bool enabled ) noexcept;
+private:
+    //! \copydoc enabled
+    bool            _enabled{ true };
+signals:
+    //! \copydoc enabled
+    void            enabledChanged();
+
+public:
+    //! Default maximum number of pooled items per delegate component (default to 256, 0 to disable pooling).
+    Q_PROPERTY( int highWaterMark READ getHighWaterMark WRITE setHighWaterMark NOTIFY highWaterMarkChanged FINAL )
+    //! \copydoc highWaterMark
+    inline int      getHighWaterMark() const noexcept { return _highWaterMark; }
+    //! \copydoc highWaterMark
+    void            setHighWaterMark( int highWaterMark ) noexcept;
+private:
+    //! \copydoc highWaterMark
+    int             _highWaterMark{ 256 };
+signals:
+    //! \copydoc highWaterMark
+    void            highWaterMarkChanged();
+
+public:
+    //! Override \c highWaterMark for \c component pool, a negative \c highWaterMark restore default \c highWaterMark.
+    Q_INVOKABLE void    setComponentHighWaterMark( QQmlComponent* component, int highWaterMark ) noexcept;
+    //! Return effective high water mark for \c component pool.
+    Q_INVOKABLE int     getComponentHighWaterMark( QQmlComponent* component ) const noexcept;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Pool Management *///---------------------------------------------
+    //@{
+private:
+    using Items = QVector<QPointer<QQuickItem>>;
+    struct Pool {
+        Items   items;
+        //! Component specific high water mark, -1 to use default \c highWaterMark.
+        int     highWaterMark{ -1 };
+    };
+
+public:
+    /*! \brief Take an item previously created from \c component out of the pool.
+     *
+     * \return nullptr if there is no pooled item for \c component. Returned item is not visible and has no parent item,
+     * caller must configure it and then call notifyReused().
+     */
+    QQuickItem*     acquire( QQmlComponent* component ) noexcept;
+    //! Call reuse hooks on an \c item returned by acquire() once it has been configured.
+    void            notifyReused( QQuickItem* item ) noexcept;
+
+    //! Register an \c item created from \c component, only tracked items could be recycled.
+    void            track( QQuickItem* item, QQmlComponent* component ) noexcept;
+    //! Return the delegate component a tracked \c item has been created from (or nullptr if \c item is not tracked).
+    inline QQmlComponent*   getComponent( QQuickItem* item ) const noexcept { return _components.value( item, nullptr ); }
+
+    /*! \brief Reset and store \c item in its component pool.
+     *
+     * \c item is destroyed if it has not been tracked, if it is not recyclable, if pooling is disabled or if its component pool is full.
+     * \return true if \c item has been pooled, false if it has been destroyed.
+     */
+    bool            recycle( QQuickItem* item ) noexcept;
+
+    //! Destroy all pooled items (statistics are not reset).
+    Q_INVOKABLE void    clear() noexcept;
+
+private:
+    //! Delete pooled items exceeding \c component pool high water mark.
+    void            trim( QQmlComponent* component ) noexcept;
+    //! Return \c component pool, creating it if necessary.
+    Pool&           componentPool( QQmlComponent* component ) noexcept;
+    //! Drop \c component pool and destroy its items (called when \c component is destroyed).
+    void            removeComponent( QQmlComponent* component ) noexcept;
+
+    //! Pools indexed by delegate component.
+    QHash<QQmlComponent*, Pool>             _pools;
+    //! Delegate component of every tracked item (entries are removed when items are destroyed).
+    QHash<QQuickItem*, QQmlComponent*>      _components;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Pool Statistics *///---------------------------------------------
+    //@{
+public:
+    //! Number of items actually stored in pool (read only).
+    Q_PROPERTY( int pooledCount READ getPooledCount NOTIFY statisticsChanged FINAL )
+    //! \copydoc pooledCount
+    inline int      getPooledCount() const noexcept { return _pooledCount; }
+    //! Number of items actually stored in \c component pool.
+    Q_INVOKABLE int getComponentPooledCount( QQmlComponent* component ) const noexcept;
+
+    //! Number of acquire() calls that returned a pooled item (read only).
+    Q_PROPERTY( int hitCount READ getHitCount NOTIFY statisticsChanged FINAL )
+    //! \copydoc hitCount
+    inline int      getHitCount() const noexcept { return _hitCount; }
+
+    //! Number of acquire() calls that failed, ie items that had to be created from their component (read only).
+    Q_PROPERTY( int missCount READ getMissCount NOTIFY statisticsChanged FINAL )
+    //! \copydoc missCount
+    inline int      getMissCount() const noexcept { return _missCount; }
+
+    //! Number of items successfully stored in pool by recycle() (read only).
+    Q_PROPERTY( int recycledCount READ getRecycledCount NOTIFY statisticsChanged FINAL )
+    //! \copydoc recycledCount
+    inline int      getRecycledCount() const noexcept { return _recycledCount; }
+
+    //! Number of items destroyed by recycle() or because their pool exceeded its high water mark (read only).
+    Q_PROPERTY( int discardedCount READ getDiscardedCount NOTIFY statisticsChanged FINAL )
+    //! \copydoc discardedCount
+    inline int      getDiscardedCount() const noexcept { return _discardedCount; }
+
+    //! Reset hit, miss, recycled and discarded counters to 0.
+    Q_INVOKABLE void    resetStatistics() noexcept;
+
+signals:
+    void            statisticsChanged();
+
+private:
+    int             _pooledCount{ 0 };
+    int             _hitCount{ 0 };
+    int             _missCount{ 0 };
+    int             _recycledCount{ 0 };
+    int             _discardedCount{ 0 };
+    //@}
+    //-------------------------------------------------------------------------
+};
+
+} // ::qan
+
+QML_DECLARE_TYPE( qan::ItemPool )
+QML_DECLARE_TYPEINFO( qan::ItemPool, QML_HAS_ATTACHED_PROPERTIES )
+
+#endif // qanItemPool_h
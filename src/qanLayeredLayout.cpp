@@ -0,0 +1,158 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the QuickQanava software library.
+//
+// \file	qanLayeredLayout.cpp
+// \author	benoit@destrat.io
+// \date	2017 12 23
+//-----------------------------------------------------------------------------
+
+// Qt headers
+#include <QHash>
+
+// GTpo headers
+#include <gtpoLayeredLayout.h>
+
+// QuickQanava headers
+#include "./qanLayeredLayout.h"
+#include "./qanPortItem.h"
+
+namespace qan { // ::qan
+
+/* LayeredLayout Object Management *///----------------------------------------
+LayeredLayout::LayeredLayout( QObject* parent ) :
+    qan::AbstractLayout{ parent },
+    _layout{ std::make_unique<gtpo::LayeredLayout>() }
+{
+}
+
+LayeredLayout::~LayeredLayout()
+{
+    cancel();
+}
+//-----------------------------------------------------------------------------
+
+/* Layout Configuration *///---------------------------------------------------
+void    LayeredLayout::setOrientation( Orientation orientation ) noexcept
+{
+    if ( orientation != _orientation ) {
+        _orientation = orientation;
+        emit orientationChanged();
+    }
+}
+
+void    LayeredLayout::setLayerSpacing( qreal layerSpacing ) noexcept
+{
+    layerSpacing = std::max( 0., layerSpacing );
+    if ( !qFuzzyCompare( 1. + layerSpacing, 1. + _layerSpacing ) ) {
+        _layerSpacing = layerSpacing;
+        emit layerSpacingChanged();
+    }
+}
+
+void    LayeredLayout::setNodeSpacing( qreal nodeSpacing ) noexcept
+{
+    nodeSpacing = std::max( 0., nodeSpacing );
+    if ( !qFuzzyCompare( 1. + nodeSpacing, 1. + _nodeSpacing ) ) {
+        _nodeSpacing = nodeSpacing;
+        emit nodeSpacingChanged();
+    }
+}
+//-----------------------------------------------------------------------------
+
+/* Layout Management *///------------------------------------------------------
+bool    LayeredLayout::start()
+{
+    if ( !_graph ) {
+        qWarning() << "qan::LayeredLayout::start(): Error: No target graph.";
+        return false;
+    }
+    if ( getRunning() ) {
+        qWarning() << "qan::LayeredLayout::start(): Error: A layout is already running.";
+        return false;
+    }
+
+    // Snapshot graph topology in GUI thread: ungrouped nodes sizes and edges between them
+    const bool horizontal = _orientation == Orientation::LeftToRight;
+    auto& layout = *_layout;
+    layout.clear();
+    const auto nodeIndexes = snapshotNodes( [&layout]( const qan::Node&, const QRectF& geometry ) {
+        return layout.addNode( geometry.width(), geometry.height() );
+    } );
+
+    const auto containerItem = _graph->getContainerItem();
+    // Return edge extremity port offset to node center along layer axis, set againstFlow if port is docked on againstDock side
+    const auto portOffset = [=]( const qan::NodeItem* item, const qan::Node& node, qan::NodeItem::Dock againstDock, bool& againstFlow ) -> qreal {
+        const auto port = qobject_cast<const qan::PortItem*>( item );
+        if ( port == nullptr ||
+             containerItem == nullptr )
+            return 0.;
+        againstFlow = againstFlow || port->getDockType() == againstDock;
+        const auto portCenter = port->mapToItem( containerItem, QPointF{ port->width() / 2., port->height() / 2. } );
+        const auto nodeCenter = node.getGeometry().center();
+        return horizontal ? portCenter.y() - nodeCenter.y() : portCenter.x() - nodeCenter.x();
+    };
+    for ( const auto& edge : _graph->getEdges() ) {
+        if ( !edge )
+            continue;
+        const auto srcNode = edge->getSrc().lock();
+        const auto dstNode = edge->getDst().lock();     // Null for hyper edges
+        const auto src = nodeIndexes.constFind( srcNode.get() );
+        const auto dst = nodeIndexes.constFind( dstNode.get() );
+        if ( src == nodeIndexes.constEnd() ||
+             dst == nodeIndexes.constEnd() )
+            continue;
+        qreal srcOffset = 0., dstOffset = 0.;
+        bool reversedHint = false;
+        const auto edgeItem = edge->getItem();
+        if ( edgeItem != nullptr ) {
+            // Edges leaving a port docked on layout input side, or entering a port docked on output side go against flow
+            srcOffset = portOffset( edgeItem->getSourceItem(), *srcNode,
+                                    horizontal ? qan::NodeItem::Dock::Left : qan::NodeItem::Dock::Top, reversedHint );
+            dstOffset = portOffset( edgeItem->getDestinationItem(), *dstNode,
+                                    horizontal ? qan::NodeItem::Dock::Right : qan::NodeItem::Dock::Bottom, reversedHint );
+        }
+        layout.addEdge( src.value(), dst.value(), srcOffset, dstOffset, reversedHint );
+    }
+    layout.horizontal = horizontal;
+    layout.layerSpacing = _layerSpacing;
+    layout.nodeSpacing = _nodeSpacing;
+
+    run( [this]() { _layout->compute(); } );
+    return true;
+}
+
+void    LayeredLayout::apply()
+{
+    const auto& layout = *_layout;
+    moveNodes( layout.x, layout.y, getTranslation( layout.x, layout.y, layout.width, layout.height ) );
+}
+//-----------------------------------------------------------------------------
+
+} // ::qan
+
@@ -0,0 +1,167 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the QuickQanava software library.
+//
+// \file	qanLayeredLayout.h
+// \author	benoit@destrat.io
+// \date	2017 12 23
+//-----------------------------------------------------------------------------
+
+#ifndef qanLayeredLayout_h
+#define qanLayeredLayout_h
+
+// Std headers
+#include <memory>
+#include <vector>
+
+// Qt headers
+#include <QObject>
+
+// QuickQanava headers
+#include "./qanAbstractLayout.h"
+
+namespace gtpo {
+class LayeredLayout;
+}
+
+namespace qan { // ::qan
+
+/*! \brief Hierarchical (Sugiyama) layout for directed acyclic graphs, computed in background.
+ *
+ * Graph topology, node sizes and port positions are copied in a gtpo::LayeredLayout snapshot computed in a worker
+ * thread (see gtpo::LayeredLayout for a description of the algorithm), node positions are then applied to graph
+ * in a single geometry update (see qan::Graph::beginGeometryUpdate()).
+ *
+ * Port dock sides are taken into account: edges are attached to their port position when nodes are ordered in a
+ * layer, and edges leaving a port docked against layout flow (ie a qan::NodeItem::Dock::Left source port in a
+ * LeftToRight layout) or entering a port docked on the flow side are preferably reversed.
+ *
+ * \code
+ *  Qan.LayeredLayout {
+ *    id: layeredLayout
+ *    graph: graphView.graph
+ *    orientation: Qan.LayeredLayout.LeftToRight
+ *    onFinished: graphView.fitInView()
+ *  }
+ *  // layeredLayout.start()
+ * \endcode
+ *
+ * \note Grouped nodes and hyper edges are actually ignored.
+ */
+class LayeredLayout : public qan::AbstractLayout
+{
+    /*! \name LayeredLayout Object Management *///-----------------------------
+    //@{
+    Q_OBJECT
+public:
+    explicit LayeredLayout( QObject* parent = nullptr );
+    virtual ~LayeredLayout();
+    LayeredLayout( const LayeredLayout& ) = delete;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Layout Configuration *///----------------------------------------
+    //@{
+public:
+    enum class Orientation : unsigned int {
+        //! Layers are ordered from left to right, edges are mostly horizontal.
+        LeftToRight = 0,
+        //! Layers are ordered from top to bottom, edges are mostly vertical.
+        TopToBottom = 1
+    };
+    Q_ENUM(Orientation)
+
+    //! Layout flow orientation (default to LeftToRight).
+    Q_PROPERTY( Orientation orientation READ getOrientation WRITE setOrientation NOTIFY orientationChanged FINAL )
+    //! \copydoc orientation
+    inline Orientation  getOrientation() const noexcept { return _orientation; }
+    //! \copydoc orientation
+    void                setOrientation( Orientation orientation ) noexcept;
+private:
+    //! \copydoc orientation
+    Orientation         _orientation{ Orientation::LeftToRight };
+signals:
+    //! \copydoc orientation
+    void                orientationChanged();
+
+public:
+    //! Minimum space between two consecutive layers (default to 80.).
+    Q_PROPERTY( qreal layerSpacing READ getLayerSpacing WRITE setLayerSpacing NOTIFY layerSpacingChanged FINAL )
+    //! \copydoc layerSpacing
+    inline qreal    getLayerSpacing() const noexcept { return _layerSpacing; }
+    //! \copydoc layerSpacing
+    void            setLayerSpacing( qreal layerSpacing ) noexcept;
+private:
+    //! \copydoc layerSpacing
+    qreal           _layerSpacing{ 80. };
+signals:
+    //! \copydoc layerSpacing
+    void            layerSpacingChanged();
+
+public:
+    //! Minimum space between two nodes in the same layer (default to 30.).
+    Q_PROPERTY( qreal nodeSpacing READ getNodeSpacing WRITE setNodeSpacing NOTIFY nodeSpacingChanged FINAL )
+    //! \copydoc nodeSpacing
+    inline qreal    getNodeSpacing() const noexcept { return _nodeSpacing; }
+    //! \copydoc nodeSpacing
+    void            setNodeSpacing( qreal nodeSpacing ) noexcept;
+private:
+    //! \copydoc nodeSpacing
+    qreal           _nodeSpacing{ 30. };
+signals:
+    //! \copydoc nodeSpacing
+    void            nodeSpacingChanged();
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Layout Management *///-------------------------------------------
+    //@{
+public:
+    /*! \brief Start a layout of \c graph in background, layout top left corner is kept at actual nodes top left corner.
+     *
+     * \return false if there is no target graph or if a layout is already running.
+     */
+    Q_INVOKABLE bool    start();
+
+protected:
+    //! Apply node positions computed by layout worker.
+    virtual void    apply() override;
+
+private:
+    //! Layout snapshot, accessed only from the worker thread while layout is running.
+    std::unique_ptr<gtpo::LayeredLayout>    _layout;
+    //@}
+    //-------------------------------------------------------------------------
+};
+
+} // ::qan
+
+QML_DECLARE_TYPE( qan::LayeredLayout )
+
+#endif // qanLayeredLayout_h
+
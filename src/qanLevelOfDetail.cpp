@@ -0,0 +1,108 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the QuickQanava software library.
+//
+// \file	qanLevelOfDetail.cpp
+// \author	benoit@destrat.io
+// \date	2017 12 20
+//-----------------------------------------------------------------------------
+
+// QuickQanava headers
+#include "./qanLevelOfDetail.h"
+
+namespace qan { // ::qan
+
+/* LevelOfDetail Object Management *///----------------------------------------
+LevelOfDetail::LevelOfDetail( QObject* parent ) :
+    QObject{ parent }
+{
+}
+//-----------------------------------------------------------------------------
+
+/* Policy Management *///------------------------------------------------------
+void    LevelOfDetail::setEnabled( bool enabled ) noexcept
+{
+    if ( enabled != _enabled ) {
+        _enabled = enabled;
+        emit enabledChanged();
+        updateLevel();
+    }
+}
+
+void    LevelOfDetail::setZoom( qreal zoom ) noexcept
+{
+    if ( !qFuzzyCompare( 1. + zoom, 1. + _zoom ) ) {
+        _zoom = zoom;
+        emit zoomChanged();
+        updateLevel();
+    }
+}
+
+void    LevelOfDetail::setLabelZoom( qreal labelZoom ) noexcept { setThreshold( _labelZoom, labelZoom ); }
+void    LevelOfDetail::setPortZoom( qreal portZoom ) noexcept { setThreshold( _portZoom, portZoom ); }
+void    LevelOfDetail::setDockZoom( qreal dockZoom ) noexcept { setThreshold( _dockZoom, dockZoom ); }
+void    LevelOfDetail::setArrowZoom( qreal arrowZoom ) noexcept { setThreshold( _arrowZoom, arrowZoom ); }
+void    LevelOfDetail::setCurveZoom( qreal curveZoom ) noexcept { setThreshold( _curveZoom, curveZoom ); }
+void    LevelOfDetail::setDetailZoom( qreal detailZoom ) noexcept { setThreshold( _detailZoom, detailZoom ); }
+
+void    LevelOfDetail::setThreshold( qreal& threshold, qreal value ) noexcept
+{
+    if ( !qFuzzyCompare( 1. + threshold, 1. + value ) ) {
+        threshold = value;
+        emit thresholdsChanged();
+        updateLevel();
+    }
+}
+//-----------------------------------------------------------------------------
+
+/* Level Management *///-------------------------------------------------------
+void    LevelOfDetail::updateLevel() noexcept
+{
+    unsigned int level = All;
+    if ( _enabled ) {
+        const auto hideBelow = [this, &level]( qreal threshold, Detail detail ) {
+            if ( _zoom < threshold )
+                level &= ~static_cast<unsigned int>( detail );
+        };
+        hideBelow( _labelZoom,  Labels );
+        hideBelow( _portZoom,   Ports );
+        hideBelow( _dockZoom,   Docks );
+        hideBelow( _arrowZoom,  Arrows );
+        hideBelow( _curveZoom,  Curves );
+        hideBelow( _detailZoom, Details );
+    }
+    const auto changedDetails = level ^ _level;
+    if ( changedDetails != 0 ) {
+        _level = level;
+        _changedDetails = changedDetails;
+        emit levelChanged();
+    }
+}
+//-----------------------------------------------------------------------------
+
+} // ::qan
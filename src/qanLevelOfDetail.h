@@ -0,0 +1,207 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the QuickQanava software library.
+//
+// \file	qanLevelOfDetail.h
+// \author	benoit@destrat.io
+// \date	2017 12 20
+//-----------------------------------------------------------------------------
+
+#ifndef qanLevelOfDetail_h
+#define qanLevelOfDetail_h
+
+// Qt headers
+#include <QObject>
+#include <QQmlEngine>
+
+namespace qan { // ::qan
+
+/*! \brief Zoom driven level of detail policy for graph primitives rendering.
+ *
+ * When \c enabled, details are hidden or simplified once \c zoom goes below their threshold:
+ * \li \c labelZoom: node labels are hidden (\c showLabels).
+ * \li \c portZoom: port labels are hidden (\c showPorts).
+ * \li \c dockZoom: dock items and their ports are hidden (\c showDocks).
+ * \li \c arrowZoom: edge arrows are hidden (\c showArrows).
+ * \li \c curveZoom: curved edges are drawn as straight lines (\c showCurves).
+ * \li \c detailZoom: node delegates should use a cheaper representation, for example without shadow (\c detailed).
+ *
+ * Policy is evaluated when \c zoom or a threshold change, and levelChanged() is emitted only once when one or
+ * more thresholds are crossed: qan::Graph then apply C++ side modifications (docks and edge geometry) in a single
+ * batched pass, and QML delegates bind to the \c show* properties:
+ * \code
+ * Label {
+ *   visible: nodeItem.graph ? nodeItem.graph.lod.showLabels : true
+ * }
+ * \endcode
+ *
+ * \sa qan::Graph::lod
+ */
+class LevelOfDetail : public QObject
+{
+    /*! \name LevelOfDetail Object Management *///-----------------------------
+    //@{
+    Q_OBJECT
+public:
+    explicit LevelOfDetail( QObject* parent = nullptr );
+    virtual ~LevelOfDetail() override = default;
+    LevelOfDetail( const LevelOfDetail& ) = delete;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Policy Management *///-------------------------------------------
+    //@{
+public:
+    //! Enable level of detail policy, all details are shown when false (default to false).
+    Q_PROPERTY( bool enabled READ getEnabled WRITE setEnabled NOTIFY enabledChanged FINAL )
+    //! \copydoc enabled
+    inline bool     getEnabled() const noexcept { return _enabled; }
+    //! \copydoc enabled
+    void            setEnabled( bool enabled ) noexcept;
+private:
+    //! \copydoc enabled
+    bool            _enabled{ false };
+signals:
+    //! \copydoc enabled
+    void            enabledChanged();
+
+public:
+    //! Current view zoom level (default to 1.0, usually set from qan::Graph::viewZoom).
+    Q_PROPERTY( qreal zoom READ getZoom WRITE setZoom NOTIFY zoomChanged FINAL )
+    //! \copydoc zoom
+    inline qreal    getZoom() const noexcept { return _zoom; }
+    //! \copydoc zoom
+    void            setZoom( qreal zoom ) noexcept;
+private:
+    //! \copydoc zoom
+    qreal           _zoom{ 1.0 };
+signals:
+    //! \copydoc zoom
+    void            zoomChanged();
+
+public:
+    //! Node labels are hidden below \c labelZoom (default to 0.5).
+    Q_PROPERTY( qreal labelZoom READ getLabelZoom WRITE setLabelZoom NOTIFY thresholdsChanged FINAL )
+    inline qreal    getLabelZoom() const noexcept { return _labelZoom; }
+    void            setLabelZoom( qreal labelZoom ) noexcept;
+
+    //! Port labels are hidden below \c portZoom (default to 0.6).
+    Q_PROPERTY( qreal portZoom READ getPortZoom WRITE setPortZoom NOTIFY thresholdsChanged FINAL )
+    inline qreal    getPortZoom() const noexcept { return _portZoom; }
+    void            setPortZoom( qreal portZoom ) noexcept;
+
+    //! Dock items (and their ports) are hidden below \c dockZoom (default to 0.4).
+    Q_PROPERTY( qreal dockZoom READ getDockZoom WRITE setDockZoom NOTIFY thresholdsChanged FINAL )
+    inline qreal    getDockZoom() const noexcept { return _dockZoom; }
+    void            setDockZoom( qreal dockZoom ) noexcept;
+
+    //! Edge arrows are hidden below \c arrowZoom (default to 0.3).
+    Q_PROPERTY( qreal arrowZoom READ getArrowZoom WRITE setArrowZoom NOTIFY thresholdsChanged FINAL )
+    inline qreal    getArrowZoom() const noexcept { return _arrowZoom; }
+    void            setArrowZoom( qreal arrowZoom ) noexcept;
+
+    //! Curved edges are drawn as straight lines below \c curveZoom (default to 0.4).
+    Q_PROPERTY( qreal curveZoom READ getCurveZoom WRITE setCurveZoom NOTIFY thresholdsChanged FINAL )
+    inline qreal    getCurveZoom() const noexcept { return _curveZoom; }
+    void            setCurveZoom( qreal curveZoom ) noexcept;
+
+    //! Node delegates should use a cheaper representation below \c detailZoom (default to 0.7).
+    Q_PROPERTY( qreal detailZoom READ getDetailZoom WRITE setDetailZoom NOTIFY thresholdsChanged FINAL )
+    inline qreal    getDetailZoom() const noexcept { return _detailZoom; }
+    void            setDetailZoom( qreal detailZoom ) noexcept;
+private:
+    //! Set \c threshold to \c value and update policy.
+    void            setThreshold( qreal& threshold, qreal value ) noexcept;
+
+    qreal           _labelZoom{ 0.5 };
+    qreal           _portZoom{ 0.6 };
+    qreal           _dockZoom{ 0.4 };
+    qreal           _arrowZoom{ 0.3 };
+    qreal           _curveZoom{ 0.4 };
+    qreal           _detailZoom{ 0.7 };
+signals:
+    //! Emitted when any zoom threshold is modified.
+    void            thresholdsChanged();
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Level Management *///--------------------------------------------
+    //@{
+public:
+    //! Details that could be hidden or simplified.
+    enum Detail : unsigned int {
+        Labels  = 1 << 0,
+        Ports   = 1 << 1,
+        Docks   = 1 << 2,
+        Arrows  = 1 << 3,
+        Curves  = 1 << 4,
+        Details = 1 << 5,
+        All     = Labels | Ports | Docks | Arrows | Curves | Details
+    };
+    Q_ENUM(Detail)
+
+    //! Return currently shown details (combination of Detail flags).
+    inline unsigned int getLevel() const noexcept { return _level; }
+    //! Return true if \c detail is currently shown.
+    inline bool         shows( Detail detail ) const noexcept { return ( _level & detail ) != 0; }
+
+    Q_PROPERTY( bool showLabels READ getShowLabels NOTIFY levelChanged FINAL )
+    inline bool     getShowLabels() const noexcept { return shows( Labels ); }
+    Q_PROPERTY( bool showPorts READ getShowPorts NOTIFY levelChanged FINAL )
+    inline bool     getShowPorts() const noexcept { return shows( Ports ); }
+    Q_PROPERTY( bool showDocks READ getShowDocks NOTIFY levelChanged FINAL )
+    inline bool     getShowDocks() const noexcept { return shows( Docks ); }
+    Q_PROPERTY( bool showArrows READ getShowArrows NOTIFY levelChanged FINAL )
+    inline bool     getShowArrows() const noexcept { return shows( Arrows ); }
+    Q_PROPERTY( bool showCurves READ getShowCurves NOTIFY levelChanged FINAL )
+    inline bool     getShowCurves() const noexcept { return shows( Curves ); }
+    Q_PROPERTY( bool detailed READ getDetailed NOTIFY levelChanged FINAL )
+    inline bool     getDetailed() const noexcept { return shows( Details ); }
+
+    //! Return details that have been shown or hidden in last levelChanged() emission (combination of Detail flags).
+    inline unsigned int getChangedDetails() const noexcept { return _changedDetails; }
+
+signals:
+    //! Emitted once when one or more zoom thresholds are crossed.
+    void            levelChanged();
+
+private:
+    //! Evaluate shown details for current zoom and emit levelChanged() if they have changed.
+    void            updateLevel() noexcept;
+
+    unsigned int    _level{ All };
+    unsigned int    _changedDetails{ 0 };
+    //@}
+    //-------------------------------------------------------------------------
+};
+
+} // ::qan
+
+QML_DECLARE_TYPE( qan::LevelOfDetail )
+
+#endif // qanLevelOfDetail_h
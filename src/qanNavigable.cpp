@@ -378,6 +378,21 @@ void    Navigable::wheelEvent( QWheelEvent* event )
 }
 //-----------------------------------------------------------------------------
 
+/* Overview Management *///--------------------------------------------------
+void    Navigable::collectOverviewRects( std::vector<QRectF>& rects, std::vector<QRectF>& containerRects ) const
+{
+    rects.clear();
+    containerRects.clear();
+    if ( _containerItem == nullptr )
+        return;
+    for ( const auto item : _containerItem->childItems() )
+        if ( item != nullptr &&
+             item->isVisible() &&
+             item->width() > 0. && item->height() > 0. )
+            rects.emplace_back( item->position(), QSizeF{ item->width(), item->height() } );
+}
+//-----------------------------------------------------------------------------
+
 /* Grid Management *///--------------------------------------------------------
 void    Navigable::setGrid( qan::Grid* grid ) noexcept
 {
@@ -35,6 +35,9 @@
 #ifndef canNavigable_h
 #define canNavigable_h
 
+// Std headers
+#include <vector>
+
 // Qt headers
 #include <QQuickItem>
 
@@ -306,6 +309,15 @@ protected:
     //! Called when the container item is scaled (zoomed) or panned (base implementation empty).
     virtual void    navigableContainerItemModified() { }
 
+public:
+    /*! \brief Collect content primitives bounding rects in \c containerItem CS, used for cheap overviews (see qan::NavigablePreview).
+     *
+     * \c rects receive leaf primitives geometry, \c containerRects receive primitives containing other primitives (for
+     * example graph groups). Both vectors are cleared first. Default implementation return \c containerItem visible
+     * child items geometry in \c rects.
+     */
+    virtual void    collectOverviewRects( std::vector<QRectF>& rects, std::vector<QRectF>& containerRects ) const;
+
 public:
     //! True when the navigable conctent area is actually dragged.
     Q_PROPERTY( bool dragActive READ getDragActive WRITE setDragActive NOTIFY dragActiveChanged FINAL )
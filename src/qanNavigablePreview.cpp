@@ -32,8 +32,16 @@
 // \date	2017 06 02
 //-----------------------------------------------------------------------------
 
+// Std headers
+#include <cmath>        // std::ceil std::pow
+#include <algorithm>    // std::max std::min
+#include <array>
+
 // Qt headers
-// Nil
+#include <QQuickWindow>
+#include <QSGGeometryNode>
+#include <QSGSimpleTextureNode>
+#include <QSGVertexColorMaterial>
 
 // QuickQanava headers
 #include "./qanNavigablePreview.h"
@@ -45,6 +53,12 @@ NavigablePreview::NavigablePreview( QQuickItem* parent ) :
     QQuickItem{parent}
 {
     setFlag(QQuickItem::ItemHasContents);
+    _updateTimer.setInterval( _updateInterval );
+    connect( &_updateTimer, &QTimer::timeout,
+             this,          &NavigablePreview::updateOverview );
+    connect( this, &QQuickItem::widthChanged,   this, &NavigablePreview::invalidateOverview );
+    connect( this, &QQuickItem::heightChanged,  this, &NavigablePreview::invalidateOverview );
+    connect( this, &QQuickItem::visibleChanged, this, &NavigablePreview::configureUpdateTimer );
 }
 //-----------------------------------------------------------------------------
 
@@ -53,9 +67,247 @@ void    NavigablePreview::setSource( qan::Navigable* source ) noexcept
 {
     if ( source != _source ) {
         _source = source;
+        invalidateOverview();
+        configureUpdateTimer();
+        updateOverview();
         emit sourceChanged();
     }
 }
 //-----------------------------------------------------------------------------
 
+/* Overview Management *///----------------------------------------------------
+constexpr int   NavigablePreview::DensityCellSize;
+
+void    NavigablePreview::setPreviewMode( PreviewMode previewMode ) noexcept
+{
+    if ( previewMode != _previewMode ) {
+        _previewMode = previewMode;
+        invalidateOverview();
+        configureUpdateTimer();
+        updateOverview();
+        update();       // Eventually remove overview nodes when switching to SourceTexture
+        emit previewModeChanged();
+    }
+}
+
+void    NavigablePreview::setUpdateInterval( int updateInterval ) noexcept
+{
+    if ( updateInterval < 0 ) {
+        qWarning() << "qan::NavigablePreview::setUpdateInterval(): Error: update interval must be positive.";
+        return;
+    }
+    if ( updateInterval != _updateInterval ) {
+        _updateInterval = updateInterval;
+        _updateTimer.setInterval( _updateInterval );
+        emit updateIntervalChanged();
+    }
+}
+
+void    NavigablePreview::setOverviewColor( QColor overviewColor ) noexcept
+{
+    if ( overviewColor != _overviewColor ) {
+        _overviewColor = overviewColor;
+        invalidateOverview();
+        emit overviewColorChanged();
+    }
+}
+
+void    NavigablePreview::configureUpdateTimer()
+{
+    if ( _source &&
+         _previewMode != PreviewMode::SourceTexture &&
+         isVisible() ) {
+        if ( !_updateTimer.isActive() )
+            _updateTimer.start();
+    } else
+        _updateTimer.stop();
+}
+
+void    NavigablePreview::invalidateOverview()
+{
+    _fullUpdate = true;     // Applied on next updateOverview()
+}
+
+void    NavigablePreview::updateOverview()
+{
+    if ( !_source ||
+         _previewMode == PreviewMode::SourceTexture )
+        return;
+    _source->collectOverviewRects( _sampledRects, _sampledContainerRects );
+
+    QRectF previewRect;
+    for ( const auto& r : _sampledContainerRects )
+        previewRect = previewRect.united( r );
+    for ( const auto& r : _sampledRects )
+        previewRect = previewRect.united( r );
+    if ( previewRect != _previewRect ) {    // Preview scale change, every primitives must be regenerated
+        _previewRect = previewRect;
+        _fullUpdate = true;
+        emit previewRectChanged();
+    }
+    if ( _sampledRects.size() != _rects.size() ||
+         _sampledContainerRects != _containerRects )
+        _fullUpdate = true;
+
+    if ( _fullUpdate ) {
+        _rects.swap( _sampledRects );
+        _containerRects.swap( _sampledContainerRects );
+        _dirtyRects.clear();
+        if ( _previewMode == PreviewMode::DensityMap )
+            generateDensity();
+        update();
+        return;
+    }
+
+    // Incremental update: only modified primitives vertices or density cells are updated
+    const bool density = _previewMode == PreviewMode::DensityMap;
+    for ( std::size_t r = 0; r < _sampledRects.size(); ++r ) {
+        if ( _sampledRects[r] == _rects[r] )
+            continue;
+        if ( density ) {
+            const int previousCell = densityCell( _rects[r] );
+            const int cell = densityCell( _sampledRects[r] );
+            if ( cell != previousCell ) {
+                updateDensityCell( previousCell, -1 );
+                updateDensityCell( cell, 1 );
+            }
+        }
+        _rects[r] = _sampledRects[r];
+        _dirtyRects.push_back( static_cast<int>( r ) );
+    }
+    if ( !_dirtyRects.empty() )
+        update();
+}
+
+int     NavigablePreview::densityCell( const QRectF& r ) const noexcept
+{
+    if ( _densitySize.isEmpty() ||
+         _previewRect.width() <= 0. || _previewRect.height() <= 0. )
+        return -1;
+    const auto center = r.center();
+    const int width = _densitySize.width();
+    const int height = _densitySize.height();
+    const int x = static_cast<int>( ( center.x() - _previewRect.left() ) / _previewRect.width() * width );
+    const int y = static_cast<int>( ( center.y() - _previewRect.top() ) / _previewRect.height() * height );
+    return ( std::max( 0, std::min( y, height - 1 ) ) * width ) + std::max( 0, std::min( x, width - 1 ) );
+}
+
+void    NavigablePreview::updateDensityCell( int cell, int delta ) noexcept
+{
+    if ( cell < 0 ||
+         cell >= static_cast<int>( _density.size() ) )
+        return;
+    const int count = std::max( 0, _density[static_cast<std::size_t>(cell)] + delta );
+    _density[static_cast<std::size_t>(cell)] = count;
+
+    // Saturating density: a cell opacity depends only on its own count, so cells are updated independently
+    const auto alpha = static_cast<int>( 255. * ( 1. - std::pow( 0.7, count ) ) );
+    const QColor& c = _overviewColor;
+    _densityImage.setPixel( cell % _densitySize.width(), cell / _densitySize.width(),
+                            qPremultiply( qRgba( c.red(), c.green(), c.blue(), alpha ) ) );
+    _densityDirty = true;
+}
+
+void    NavigablePreview::generateDensity()
+{
+    _densitySize = QSize{ std::max( 1, static_cast<int>( std::ceil( width() / DensityCellSize ) ) ),
+                          std::max( 1, static_cast<int>( std::ceil( height() / DensityCellSize ) ) ) };
+    _density.assign( static_cast<std::size_t>( _densitySize.width() * _densitySize.height() ), 0 );
+    _densityImage = QImage{ _densitySize, QImage::Format_ARGB32_Premultiplied };
+    _densityImage.fill( Qt::transparent );
+    for ( const auto& r : _rects )
+        updateDensityCell( densityCell( r ), 1 );
+    _densityDirty = true;
+}
+
+QSGNode*    NavigablePreview::updatePaintNode( QSGNode* oldNode, UpdatePaintNodeData* )
+{
+    if ( _previewMode == PreviewMode::SourceTexture ||
+         _previewRect.width() <= 0. || _previewRect.height() <= 0. ||
+         ( _previewMode == PreviewMode::DensityMap && _densityImage.isNull() ) ||
+         window() == nullptr ) {
+        delete oldNode;
+        _fullUpdate = true;
+        return nullptr;
+    }
+
+    if ( _previewMode == PreviewMode::DensityMap ) {
+        auto node = dynamic_cast<QSGSimpleTextureNode*>( oldNode );
+        if ( node == nullptr ) {
+            delete oldNode;
+            node = new QSGSimpleTextureNode{};
+            node->setOwnsTexture( true );
+            node->setFiltering( QSGTexture::Linear );
+            _densityDirty = true;
+        }
+        if ( _densityDirty ||
+             node->texture() == nullptr ) {
+            node->setTexture( window()->createTextureFromImage( _densityImage ) );
+            _densityDirty = false;
+        }
+        node->setRect( boundingRect() );
+        _dirtyRects.clear();
+        _fullUpdate = false;
+        return node;
+    }
+
+    // PointCloud: one flat rectangle per primitive, groups first since they are drawn under nodes
+    auto node = dynamic_cast<QSGSimpleTextureNode*>( oldNode ) == nullptr ? static_cast<QSGGeometryNode*>( oldNode ) : nullptr;
+    if ( node == nullptr ) {
+        delete oldNode;
+        node = new QSGGeometryNode{};
+        auto geometry = new QSGGeometry{ QSGGeometry::defaultAttributes_ColoredPoint2D(), 0 };
+        geometry->setDrawingMode( QSGGeometry::DrawTriangles );
+        node->setGeometry( geometry );
+        node->setFlag( QSGNode::OwnsGeometry );
+        node->setMaterial( new QSGVertexColorMaterial{} );
+        node->setFlag( QSGNode::OwnsMaterial );
+        _fullUpdate = true;
+    }
+
+    const qreal sx = width() / _previewRect.width();
+    const qreal sy = height() / _previewRect.height();
+    auto premultiplied = []( const QColor& c, qreal opacity ) -> std::array<uchar, 4> {
+        const qreal a = c.alphaF() * opacity;
+        return { { static_cast<uchar>( c.red() * a ), static_cast<uchar>( c.green() * a ),
+                   static_cast<uchar>( c.blue() * a ), static_cast<uchar>( 255. * a ) } };
+    };
+    const auto rectColor = premultiplied( _overviewColor, 1. );
+    const auto containerColor = premultiplied( _overviewColor, 0.25 );
+    auto setRect = [this, sx, sy]( QSGGeometry::ColoredPoint2D* v, const QRectF& r, const std::array<uchar, 4>& c ) {
+        const auto left = static_cast<float>( ( r.left() - _previewRect.left() ) * sx );
+        const auto top = static_cast<float>( ( r.top() - _previewRect.top() ) * sy );
+        const auto right = left + static_cast<float>( std::max( 1., r.width() * sx ) );      // At least one pixel
+        const auto bottom = top + static_cast<float>( std::max( 1., r.height() * sy ) );
+        v[0].set( left, top, c[0], c[1], c[2], c[3] );
+        v[1].set( right, top, c[0], c[1], c[2], c[3] );
+        v[2].set( right, bottom, c[0], c[1], c[2], c[3] );
+        v[3] = v[0];
+        v[4] = v[2];
+        v[5].set( left, bottom, c[0], c[1], c[2], c[3] );
+    };
+
+    auto geometry = node->geometry();
+    const int containerCount = static_cast<int>( _containerRects.size() );
+    const int vertexCount = ( containerCount + static_cast<int>( _rects.size() ) ) * 6;
+    if ( _fullUpdate ||
+         geometry->vertexCount() != vertexCount ) {
+        geometry->allocate( vertexCount );
+        auto vertices = geometry->vertexDataAsColoredPoint2D();
+        for ( int r = 0; r < containerCount; ++r )
+            setRect( vertices + r * 6, _containerRects[static_cast<std::size_t>(r)], containerColor );
+        for ( std::size_t r = 0; r < _rects.size(); ++r )
+            setRect( vertices + ( containerCount + static_cast<int>(r) ) * 6, _rects[r], rectColor );
+    } else {
+        auto vertices = geometry->vertexDataAsColoredPoint2D();
+        for ( const auto r : _dirtyRects )
+            setRect( vertices + ( containerCount + r ) * 6, _rects[static_cast<std::size_t>(r)], rectColor );
+    }
+    node->markDirty( QSGNode::DirtyGeometry );
+    _dirtyRects.clear();
+    _fullUpdate = false;
+    return node;
+}
+//-----------------------------------------------------------------------------
+
 } // ::qan
@@ -35,8 +35,14 @@
 #ifndef canNavigablePreview_h
 #define canNavigablePreview_h
 
+// Std headers
+#include <vector>
+
 // Qt headers
 #include <QQuickItem>
+#include <QTimer>
+#include <QImage>
+#include <QColor>
 
 // QuickQanava headers
 #include "./qanNavigable.h"
@@ -44,6 +50,16 @@
 namespace qan { // ::qan
 
 /*! \brief Bastract interface for reduced preview and navigation for qan::Navigable.
+ *
+ * Preview content is drawn according to \c previewMode:
+ * \li \c SourceTexture: Qan.NavigablePreview render source \c containerItem in a texture, the whole graph is
+ * then rendered twice.
+ * \li \c PointCloud: primitives bounding rects (see qan::Navigable::collectOverviewRects()) are drawn as flat
+ * rectangles in a single scene graph node.
+ * \li \c DensityMap: primitives centers are accumulated in a low resolution density texture.
+ *
+ * Overview modes sample source primitives at most once every \c updateInterval ms, only modified primitives
+ * vertices or density cells are updated.
  *
  * See Qan.NavigablePreview component for more documention.
  */
@@ -89,6 +105,107 @@ signals:
     void        visibleWindowChanged(QRectF visibleWindowRect, qreal navigableZoom);
     //@}
     //-------------------------------------------------------------------------
+
+    /*! \name Overview Management *///-----------------------------------------
+    //@{
+public:
+    enum class PreviewMode : unsigned int {
+        SourceTexture   = 0,
+        PointCloud      = 1,
+        DensityMap      = 2
+    };
+    Q_ENUM(PreviewMode)
+
+    //! Preview rendering mode, default to \c SourceTexture.
+    Q_PROPERTY( PreviewMode previewMode READ getPreviewMode WRITE setPreviewMode NOTIFY previewModeChanged FINAL )
+    //! \copydoc previewMode
+    inline PreviewMode  getPreviewMode() const noexcept { return _previewMode; }
+    //! \copydoc previewMode
+    void                setPreviewMode( PreviewMode previewMode ) noexcept;
+private:
+    //! \copydoc previewMode
+    PreviewMode         _previewMode{PreviewMode::SourceTexture};
+signals:
+    //! \copydoc previewMode
+    void                previewModeChanged();
+
+public:
+    //! Minimum interval in ms between two overview updates (default to 250ms, ie 4 updates per second).
+    Q_PROPERTY( int updateInterval READ getUpdateInterval WRITE setUpdateInterval NOTIFY updateIntervalChanged FINAL )
+    //! \copydoc updateInterval
+    inline int          getUpdateInterval() const noexcept { return _updateInterval; }
+    //! \copydoc updateInterval
+    void                setUpdateInterval( int updateInterval ) noexcept;
+private:
+    //! \copydoc updateInterval
+    int                 _updateInterval{250};
+signals:
+    //! \copydoc updateInterval
+    void                updateIntervalChanged();
+
+public:
+    //! Color used to draw primitives in overview modes (groups are drawn with a transparent version of this color).
+    Q_PROPERTY( QColor overviewColor READ getOverviewColor WRITE setOverviewColor NOTIFY overviewColorChanged FINAL )
+    //! \copydoc overviewColor
+    inline QColor       getOverviewColor() const noexcept { return _overviewColor; }
+    //! \copydoc overviewColor
+    void                setOverviewColor( QColor overviewColor ) noexcept;
+private:
+    //! \copydoc overviewColor
+    QColor              _overviewColor{30, 144, 255};   // dodgerblue
+signals:
+    //! \copydoc overviewColor
+    void                overviewColorChanged();
+
+public:
+    //! Source content rect (in source \c containerItem CS) actually drawn in overview modes.
+    Q_PROPERTY( QRectF previewRect READ getPreviewRect NOTIFY previewRectChanged FINAL )
+    //! \copydoc previewRect
+    inline QRectF       getPreviewRect() const noexcept { return _previewRect; }
+private:
+    //! \copydoc previewRect
+    QRectF              _previewRect;
+signals:
+    //! \copydoc previewRect
+    void                previewRectChanged();
+
+public:
+    //! Density map cell size in preview pixels.
+    static constexpr int    DensityCellSize = 4;
+
+protected:
+    //! Sample source primitives and update modified overview primitives.
+    void                updateOverview();
+    //! Start or stop overview update timer according to actual mode, source and visibility.
+    void                configureUpdateTimer();
+    //! Force an overview full rebuild on next update.
+    void                invalidateOverview();
+
+    virtual QSGNode*    updatePaintNode( QSGNode* oldNode, UpdatePaintNodeData* ) override;
+
+private:
+    //! Return density map cell index for container CS rect \c r center, or -1.
+    int                 densityCell( const QRectF& r ) const noexcept;
+    //! Add \c delta to density \c cell and update its density image pixel.
+    void                updateDensityCell( int cell, int delta ) noexcept;
+    //! Regenerate density counts and image for all primitives.
+    void                generateDensity();
+
+    QTimer              _updateTimer;
+    //! Last sampled primitives (container CS), primitives and container are sampled in scratch vectors then compared.
+    std::vector<QRectF> _rects, _containerRects;
+    std::vector<QRectF> _sampledRects, _sampledContainerRects;
+    //! Indexes of _rects modified since last updatePaintNode().
+    std::vector<int>    _dirtyRects;
+    //! When true, every overview primitives are regenerated in next updatePaintNode().
+    bool                _fullUpdate{true};
+    //! Preview size used to generate density map.
+    QSize               _densitySize;
+    std::vector<int>    _density;
+    QImage              _densityImage;
+    bool                _densityDirty{false};
+    //@}
+    //-------------------------------------------------------------------------
 };
 
 } // ::qan
@@ -76,10 +76,40 @@ const qan::NodeItem*    Node::getItem() const noexcept { return _item.data(); }
 
 void    Node::setItem(qan::NodeItem* nodeItem) noexcept
 {
-    if ( nodeItem != nullptr ) {
-        _item = nodeItem;
-        if ( nodeItem->getNode() != this )
-            nodeItem->setNode(this);
+    _item = nodeItem;
+    if ( nodeItem != nullptr &&
+         nodeItem->getNode() != this )
+        nodeItem->setNode(this);
+}
+//-----------------------------------------------------------------------------
+
+/* Node Geometry Management *///-----------------------------------------------
+QRectF  Node::getGeometry() const noexcept
+{
+    if ( !_item )
+        return _geometry;
+    const auto graph = getGraph();
+    const auto containerItem = graph != nullptr ? graph->getContainerItem() : nullptr;
+    if ( containerItem != nullptr &&        // Grouped node items are not direct children of graph container
+         _item->parentItem() != containerItem )
+        return _item->mapRectToItem( containerItem, QRectF{ QPointF{ 0., 0. }, QSizeF{ _item->width(), _item->height() } } );
+    return QRectF{ _item->position(), QSizeF{ _item->width(), _item->height() } };
+}
+
+void    Node::setGeometry( const QRectF& geometry ) noexcept
+{
+    _geometry = geometry;
+    if ( _item ) {
+        const auto graph = getGraph();
+        const auto containerItem = graph != nullptr ? graph->getContainerItem() : nullptr;
+        const auto parentItem = _item->parentItem();
+        _item->setPosition( containerItem != nullptr && parentItem != nullptr && parentItem != containerItem ?
+                                parentItem->mapFromItem( containerItem, geometry.topLeft() ) : geometry.topLeft() );
+        _item->setSize( geometry.size() );
+    } else {
+        const auto graph = getGraph();
+        if ( graph != nullptr )         // Node might enter virtual viewport
+            graph->invalidateVirtualGeometry( this );
     }
 }
 //-----------------------------------------------------------------------------
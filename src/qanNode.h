@@ -90,12 +90,33 @@ public:
     Q_PROPERTY( qan::NodeItem* item READ getItem CONSTANT )
     qan::NodeItem*          getItem() noexcept;
     const qan::NodeItem*    getItem() const noexcept;
+    //! Set node visual \c nodeItem, nullptr detach current item (item is not destroyed).
     void                    setItem(qan::NodeItem* nodeItem) noexcept;
 protected:
     QPointer<qan::NodeItem> _item;
     //@}
     //-------------------------------------------------------------------------
 
+    /*! \name Node Geometry Management *///------------------------------------
+    //@{
+public:
+    /*! \brief Node geometry in graph container item coordinate system.
+     *
+     * When node has a visual item, item geometry is returned, otherwise geometry set with setGeometry() or
+     * saved when node item has been released by a virtualized graph (see qan::Graph::virtualized).
+     */
+    QRectF          getGeometry() const noexcept;
+    /*! \brief Set node geometry in graph container item coordinate system.
+     *
+     * Node item is moved and resized if it exists, geometry is otherwise used when item is created.
+     */
+    void            setGeometry( const QRectF& geometry ) noexcept;
+private:
+    //! Geometry for nodes without visual item (default to Qan.Node default size).
+    QRectF          _geometry{ 0., 0., 110., 50. };
+    //@}
+    //-------------------------------------------------------------------------
+
     /*! \name Node Static Factories *///---------------------------------------
     //@{
 public:
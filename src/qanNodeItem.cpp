@@ -33,7 +33,7 @@
 //-----------------------------------------------------------------------------
 
 // Std headers
-#include <algorithm>    // std::for_each
+#include <algorithm>    // std::for_each std::none_of
 
 // Qt headers
 #include <QPainter>
@@ -42,8 +42,10 @@
 // QuickQanava headers
 #include "./qanNode.h"
 #include "./qanNodeItem.h"
+#include "./qanEdgeItem.h"
 #include "./qanGraph.h"
 #include "./qanDraggableCtrl.h"
+#include "./qanBoundingShapeCache.h"
 
 namespace qan { // ::qan
 
@@ -84,9 +86,12 @@ qan::AbstractDraggableCtrl& NodeItem::draggableCtrl() { Q_ASSERT(_draggableCtrl!
 auto    NodeItem::getNode() noexcept -> qan::Node* { return _node.data(); }
 auto    NodeItem::getNode() const noexcept -> const qan::Node* { return _node.data(); }
 auto    NodeItem::setNode(qan::Node* node) noexcept -> void {
+    const bool nodeChanged = node != _node;
     _node = node;
     const auto nodeDraggableCtrl = static_cast<NodeDraggableCtrl*>(_draggableCtrl.get());
     nodeDraggableCtrl->setTarget(node);
+    if ( nodeChanged )
+        emit this->nodeChanged();
 }
 
 auto    NodeItem::setGraph(qan::Graph* graph) noexcept -> void {
@@ -97,6 +102,53 @@ auto    NodeItem::getGraph() const noexcept -> const qan::Graph* { return _graph
 auto    NodeItem::getGraph() noexcept -> qan::Graph* { return _graph.data(); }
 //-----------------------------------------------------------------------------
 
+/* Recycling Management *///-------------------------------------------------
+bool    NodeItem::isRecyclable() const noexcept
+{
+    return std::none_of( _dockItems.cbegin(), _dockItems.cend(),
+                         [](const QPointer<QQuickItem>& dockItem) { return dockItem != nullptr; } );
+}
+
+void    NodeItem::itemPooled() noexcept
+{
+    setSelected(false);     // Selection item is kept and reused with this item
+    setDragged(false);
+    setNode(nullptr);
+}
+//-----------------------------------------------------------------------------
+
+/* Edge Geometry Management *///-----------------------------------------------
+void    NodeItem::invalidateAdjacentEdges() noexcept
+{
+    const qan::Node* node = _node.data();
+    for ( auto parent = parentItem(); node == nullptr && parent != nullptr; parent = parent->parentItem() ) {
+        const auto parentNodeItem = qobject_cast<const qan::NodeItem*>( parent );   // Port item host node
+        if ( parentNodeItem != nullptr )
+            node = parentNodeItem->getNode();
+    }
+    if ( node == nullptr )
+        return;
+    for ( const auto& inEdge : node->getInEdges() ) {
+        const auto edge = inEdge.lock();
+        if ( edge &&
+             edge->getItem() != nullptr )
+            edge->getItem()->invalidateGeometry();
+    }
+    for ( const auto& outEdge : node->getOutEdges() ) {
+        const auto edge = outEdge.lock();
+        if ( edge &&
+             edge->getItem() != nullptr )
+            edge->getItem()->invalidateGeometry();
+    }
+}
+
+void    NodeItem::geometryChanged( const QRectF& newGeometry, const QRectF& oldGeometry )
+{
+    QQuickItem::geometryChanged( newGeometry, oldGeometry );
+    invalidateAdjacentEdges();
+}
+//-----------------------------------------------------------------------------
+
 /* Selection Management *///---------------------------------------------------
 void    NodeItem::onWidthChanged()
 {
@@ -249,18 +301,20 @@ QPolygonF   NodeItem::getBoundingShape() noexcept
     return _boundingShape;
 }
 
+static constexpr qreal  defaultBoundingShapeRadius = 5.;
+
 QPolygonF    NodeItem::generateDefaultBoundingShape( ) const
 {
-    // Generate a rounded rectangular intersection shape for this node rect new geometry
-    QPainterPath path;
-    qreal shapeRadius( 5. );
-    path.addRoundedRect( QRectF{ 0., 0., width(), height() }, shapeRadius, shapeRadius );
-    return path.toFillPolygon( QTransform{} );
+    // Get a rounded rectangular intersection shape for this node rect new geometry
+    return qan::BoundingShapeCache::shape( qan::BoundingShapeCache::Kind::RoundedRect,
+                                           width(), height(), defaultBoundingShapeRadius );
 }
 
 void    NodeItem::setDefaultBoundingShape( )
 {
-    setBoundingShape( generateDefaultBoundingShape() );
+    _boundingShape = generateDefaultBoundingShape();
+    _defaultBoundingShape = true;
+    emit boundingShapeChanged();
 }
 
 void    NodeItem::setBoundingShape( QVariantList boundingShape )
@@ -269,14 +323,18 @@ void    NodeItem::setBoundingShape( QVariantList boundingShape )
     int p = 0;
     for ( const auto& vp : boundingShape )
         shape[p++] = vp.toPointF( );
-    _boundingShape = ( !shape.isEmpty( ) ? shape : generateDefaultBoundingShape() );
+    _defaultBoundingShape = shape.isEmpty();
+    _boundingShape = ( !_defaultBoundingShape ? shape : generateDefaultBoundingShape() );
     emit boundingShapeChanged();
 }
 
 bool    NodeItem::isInsideBoundingShape( QPointF p )
 {
+    if ( _defaultBoundingShape )        // Fast path, no polygon test for default rounded rectangle
+        return qan::BoundingShapeCache::contains( qan::BoundingShapeCache::Kind::RoundedRect,
+                                                  width(), height(), defaultBoundingShapeRadius, p );
     if ( _boundingShape.isEmpty() )
-        setBoundingShape( generateDefaultBoundingShape() );
+        setDefaultBoundingShape();
     return _boundingShape.containsPoint( p, Qt::OddEvenFill );
 }
 //-----------------------------------------------------------------------------
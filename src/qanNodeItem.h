@@ -53,6 +53,7 @@
 #include "./qanNode.h"
 #include "./qanSelectable.h"
 #include "./qanDraggable.h"
+#include "./qanRecyclable.h"
 #include "./qanAbstractDraggableCtrl.h"
 
 namespace qan { // ::qan
@@ -81,13 +82,15 @@ class Graph;
  */
 class NodeItem : public QQuickItem,
                  public qan::Selectable,
-                 public qan::Draggable
+                 public qan::Draggable,
+                 public qan::Recyclable
 {
     /*! \name Node Object Management *///--------------------------------------
     //@{
     Q_OBJECT
     Q_INTERFACES(qan::Selectable)
     Q_INTERFACES(qan::Draggable)
+    Q_INTERFACES(qan::Recyclable)
 public:
     //! Node constructor.
     explicit NodeItem( QQuickItem* parent = nullptr );
@@ -103,12 +106,15 @@ private:
     std::unique_ptr<qan::AbstractDraggableCtrl> _draggableCtrl;
 
 public:
-    Q_PROPERTY( qan::Node* node READ getNode CONSTANT FINAL )
+    //! Item node (might change when item is reused from a qan::ItemPool).
+    Q_PROPERTY( qan::Node* node READ getNode NOTIFY nodeChanged FINAL )
     auto        getNode() noexcept -> qan::Node*;
     auto        getNode() const noexcept -> const qan::Node*;
     auto        setNode(qan::Node* node) noexcept -> void;
 private:
     QPointer<qan::Node> _node{nullptr};
+signals:
+    void        nodeChanged();
 
 public:
     Q_PROPERTY( qan::Graph* graph READ getGraph CONSTANT FINAL )
@@ -133,6 +139,30 @@ signals:
     //@}
     //-------------------------------------------------------------------------
 
+    /*! \name Recycling Management *///--------------------------------------
+    //@{
+public:
+    //! Return false when node has dock items (ports could not be recycled).
+    virtual bool    isRecyclable() const noexcept override;
+    //! Reset selection, dragging and node reference (see qan::Recyclable::itemPooled()).
+    virtual void    itemPooled() noexcept override;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Edge Geometry Management *///-----------------------------------
+    //@{
+public:
+    /*! \brief Schedule a geometry update for this node adjacent edges (see qan::EdgeItem::invalidateGeometry()).
+     *
+     * Adjacent edges are found in graph topology, items with no node (ports for example) use their host node edges.
+     */
+    virtual void    invalidateAdjacentEdges() noexcept;
+protected:
+    //! Invalidate adjacent edges when node item is moved or resized.
+    virtual void    geometryChanged( const QRectF& newGeometry, const QRectF& oldGeometry ) override;
+    //@}
+    //-------------------------------------------------------------------------
+
     /*! \name Selection Management *///----------------------------------------
     //@{
 public:
@@ -261,17 +291,20 @@ public:
      */
     Q_PROPERTY( QPolygonF boundingShape READ getBoundingShape WRITE setBoundingShape NOTIFY boundingShapeChanged FINAL )
     QPolygonF           getBoundingShape() noexcept;
-    void                setBoundingShape( const QPolygonF& boundingShape ) { _boundingShape = boundingShape; emit boundingShapeChanged(); }
+    void                setBoundingShape( const QPolygonF& boundingShape ) { _boundingShape = boundingShape; _defaultBoundingShape = false; emit boundingShapeChanged(); }
 signals:
     void                boundingShapeChanged();
     //! signal is emmited when the bounding shape become invalid and should be regenerated from QML.
     void                requestUpdateBoundingShape();
 protected:
+    //! Return a rounded rectangle shape for actual node size, polygon is shared by nodes with the same size (see qan::BoundingShapeCache).
     QPolygonF           generateDefaultBoundingShape() const;
     //! Generate a default bounding shape (rounded rectangle) and set it as current bounding shape.
     Q_INVOKABLE void    setDefaultBoundingShape();
 private:
     QPolygonF           _boundingShape;
+    //! True when bounding shape is the default rounded rectangle, isInsideBoundingShape() then use an analytic test.
+    bool                _defaultBoundingShape{true};
 protected:
     /*! \brief Invoke this method from a concrete node component in QML for non rectangular nodes.
      * \code
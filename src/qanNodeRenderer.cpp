@@ -0,0 +1,712 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the QuickQanava software library.
+//
+// \file	qanNodeRenderer.cpp
+// \author	benoit@destrat.io
+// \date	2017 12 19
+//-----------------------------------------------------------------------------
+
+// Std headers
+#include <algorithm>    // std::max
+#include <cmath>        // std::sqrt std::ceil std::atan2
+
+// Qt headers
+#include <QQuickWindow>
+#include <QSGVertexColorMaterial>
+#include <QSGRectangleNode>
+#include <QSGRendererInterface>
+#include <QtMath>
+#include <QPainter>
+#include <QImage>
+
+// QuickQanava headers
+#include "./qanNodeRenderer.h"
+#include "./qanGraph.h"
+#include "./qanNode.h"
+#include "./qanEdge.h"
+#include "./qanStyle.h"
+
+namespace qan { // ::qan
+
+/* NodeRenderer Object Management *///-----------------------------------------
+NodeRenderer::NodeRenderer( QQuickItem* parent ) :
+    QQuickItem{ parent }
+{
+    setFlag( QQuickItem::ItemHasContents, true );
+    setAcceptHoverEvents( true );
+    setAcceptedMouseButtons( Qt::LeftButton | Qt::RightButton );
+    setObjectName( QStringLiteral("qan::NodeRenderer") );
+}
+
+NodeRenderer::~NodeRenderer()
+{
+    for ( auto node = _nodeSlots.keyBegin(); node != _nodeSlots.keyEnd(); ++node )
+        disconnect( *node, nullptr, this, nullptr );
+    for ( auto edge = _edgeSlots.keyBegin(); edge != _edgeSlots.keyEnd(); ++edge )
+        disconnect( *edge, nullptr, this, nullptr );
+}
+
+void    NodeRenderer::setGraph( qan::Graph* graph ) noexcept
+{
+    if ( graph != _graph.data() ) {
+        _graph = graph;
+        invalidate();
+    }
+}
+//-----------------------------------------------------------------------------
+
+/* Primitive Synchronization Management *///-----------------------------------
+bool    NodeRenderer::Slots::markDirty( int slot ) noexcept
+{
+    if ( dirtyFlags[slot] )
+        return false;
+    dirtyFlags[slot] = true;
+    dirtySlots.push_back( slot );
+    return true;
+}
+
+void    NodeRenderer::invalidate() noexcept
+{
+    _syncRequested = true;
+    if ( window() != nullptr )
+        polish();
+    else
+        synchronize();      // No polish pass without a window
+}
+
+void    NodeRenderer::synchronize() noexcept
+{
+    _syncRequested = false;
+    const int nodeCount = _nodeSlots.size();
+
+    // Add or update primitives without item, then release slots that have not been visited
+    std::vector<int> nodeSlots;
+    std::vector<qan::Edge*> edges;
+    if ( _graph &&
+         _graph->getLightweightNodes() ) {
+        for ( const auto& node : _graph->getNodes() )
+            if ( node &&
+                 node->getItem() == nullptr )
+                nodeSlots.push_back( syncNode( *node ) );
+        for ( const auto& edge : _graph->getEdges() )
+            if ( edge &&
+                 edge->getItem() == nullptr ) {
+                syncEdge( *edge );
+                edges.push_back( edge.get() );
+            }
+    }
+    std::vector<bool> visitedNodes( _nodes.nodes.size(), false );
+    for ( const auto slot : nodeSlots )
+        visitedNodes[slot] = true;
+    for ( std::size_t slot = 0; slot < _nodes.nodes.size(); ++slot )
+        if ( _nodes.nodes[slot] != nullptr &&
+             !visitedNodes[slot] )
+            releaseNode( _nodes.nodes[slot] );
+    std::vector<bool> visitedEdges( _edges.edges.size(), false );
+    for ( const auto edge : edges )
+        visitedEdges[_edgeSlots.value( edge )] = true;
+    for ( std::size_t slot = 0; slot < _edges.edges.size(); ++slot )
+        if ( _edges.edges[slot] != nullptr &&
+             !visitedEdges[slot] )
+            releaseEdge( _edges.edges[slot] );
+
+    if ( !_nodes.dirtySlots.empty() ||
+         !_edges.dirtySlots.empty() )
+        update();
+    if ( nodeCount != _nodeSlots.size() )
+        emit nodeCountChanged();
+}
+
+qan::Node*  NodeRenderer::nodeAt( const QPointF& p ) const
+{
+    const auto nodes = _nodeIndex.queryPoint( p.x(), p.y() );
+    return nodes.empty() ? nullptr : nodes.back();
+}
+
+//! Return \c color premultiplied by its alpha and \c opacity.
+static inline QRgb  premultiplied( const QColor& color, qreal opacity = 1. ) noexcept
+{
+    auto rgba = color.rgba();
+    return qPremultiply( qRgba( qRed( rgba ), qGreen( rgba ), qBlue( rgba ),
+                                qRound( qAlpha( rgba ) * opacity ) ) );
+}
+
+int     NodeRenderer::syncNode( qan::Node& node ) noexcept
+{
+    auto style = _graph ? qobject_cast<qan::NodeStyle*>( _graph->getVirtualStyle( &node ) ) : nullptr;
+    if ( style == nullptr )
+        style = qan::Node::style();
+    watchStyle( style );
+    const auto rect = node.getGeometry();
+    const auto backColor = style != nullptr ? premultiplied( style->getBackColor(), style->getBackOpacity() ) : qRgba( 255, 255, 255, 255 );
+    const auto borderColor = style != nullptr ? premultiplied( style->getBorderColor() ) : qRgba( 0, 0, 0, 255 );
+    const auto borderWidth = static_cast<float>( style != nullptr ? style->getBorderWidth() : 1. );
+    const auto label = node.getLabel();
+
+    int slot = _nodeSlots.value( &node, -1 );
+    const bool inserted = slot < 0;
+    if ( inserted ) {
+        if ( !_nodes.freeSlots.empty() ) {
+            slot = _nodes.freeSlots.back();
+            _nodes.freeSlots.pop_back();
+        } else {
+            slot = static_cast<int>( _nodes.nodes.size() );
+            _nodes.nodes.push_back( nullptr );
+            _nodes.rects.emplace_back();
+            _nodes.backColors.push_back( 0 );
+            _nodes.borderColors.push_back( 0 );
+            _nodes.borderWidths.push_back( 0.f );
+            _nodes.labels.emplace_back();
+            _nodes.dirtyFlags.push_back( false );
+        }
+        _nodes.nodes[slot] = &node;
+        _nodeSlots.insert( &node, slot );
+        connect( &node, &qan::Node::labelChanged,
+                 this,  &NodeRenderer::invalidate );
+        connect( &node, &QObject::destroyed,
+                 this,  [this, &node]() { releaseNode( &node ); } );
+    }
+    if ( inserted ||
+         rect != _nodes.rects[slot] ) {
+        _nodes.rects[slot] = rect;
+        _nodeIndex.insert( &node, gtpo::Box::fromRect( rect.x(), rect.y(), rect.width(), rect.height() ) );
+        _nodes.markDirty( slot );
+        _labelsDirty = true;
+    }
+    if ( backColor != _nodes.backColors[slot] ||
+         borderColor != _nodes.borderColors[slot] ||
+         !qFuzzyCompare( 1.f + borderWidth, 1.f + _nodes.borderWidths[slot] ) ) {
+        _nodes.backColors[slot] = backColor;
+        _nodes.borderColors[slot] = borderColor;
+        _nodes.borderWidths[slot] = borderWidth;
+        _nodes.markDirty( slot );
+    }
+    if ( label != _nodes.labels[slot] ) {
+        _nodes.labels[slot] = label;
+        _labelsDirty = true;
+    }
+    return slot;
+}
+
+void    NodeRenderer::syncEdge( qan::Edge& edge ) noexcept
+{
+    auto style = _graph ? qobject_cast<qan::EdgeStyle*>( _graph->getVirtualStyle( &edge ) ) : nullptr;
+    if ( style == nullptr )
+        style = qan::Edge::style();
+    watchStyle( style );
+    const auto src = edge.getSrc().lock();
+    const auto dst = edge.getDst().lock();
+    const auto line = src && dst ? QLineF{ src->getGeometry().center(), dst->getGeometry().center() } :
+                                   QLineF{};    // Hyper edges are not drawn
+    const auto color = style != nullptr ? premultiplied( style->getLineColor() ) : qRgba( 0, 0, 0, 255 );
+    const auto width = static_cast<float>( style != nullptr ? style->getLineWidth() : 2. );
+
+    int slot = _edgeSlots.value( &edge, -1 );
+    const bool inserted = slot < 0;
+    if ( inserted ) {
+        if ( !_edges.freeSlots.empty() ) {
+            slot = _edges.freeSlots.back();
+            _edges.freeSlots.pop_back();
+        } else {
+            slot = static_cast<int>( _edges.edges.size() );
+            _edges.edges.push_back( nullptr );
+            _edges.lines.emplace_back();
+            _edges.colors.push_back( 0 );
+            _edges.widths.push_back( 0.f );
+            _edges.dirtyFlags.push_back( false );
+        }
+        _edges.edges[slot] = &edge;
+        _edgeSlots.insert( &edge, slot );
+        connect( &edge, &QObject::destroyed,
+                 this,  [this, &edge]() { releaseEdge( &edge ); } );
+    }
+    if ( inserted ||
+         line != _edges.lines[slot] ||
+         color != _edges.colors[slot] ||
+         !qFuzzyCompare( 1.f + width, 1.f + _edges.widths[slot] ) ) {
+        _edges.lines[slot] = line;
+        _edges.colors[slot] = color;
+        _edges.widths[slot] = width;
+        _edges.markDirty( slot );
+    }
+}
+
+void    NodeRenderer::releaseNode( qan::Node* node ) noexcept
+{
+    const auto slot = _nodeSlots.find( node );
+    if ( slot == _nodeSlots.end() )
+        return;
+    _nodes.nodes[*slot] = nullptr;
+    _nodes.labels[*slot].clear();
+    _nodes.freeSlots.push_back( *slot );
+    if ( _nodes.markDirty( *slot ) )    // Collapse slot vertices
+        update();
+    _nodeIndex.remove( node );
+    _nodeSlots.erase( slot );
+    disconnect( node, nullptr, this, nullptr );
+    _labelsDirty = true;
+}
+
+void    NodeRenderer::releaseEdge( qan::Edge* edge ) noexcept
+{
+    const auto slot = _edgeSlots.find( edge );
+    if ( slot == _edgeSlots.end() )
+        return;
+    _edges.edges[*slot] = nullptr;
+    _edges.freeSlots.push_back( *slot );
+    if ( _edges.markDirty( *slot ) )
+        update();
+    _edgeSlots.erase( slot );
+    disconnect( edge, nullptr, this, nullptr );
+}
+
+void    NodeRenderer::watchStyle( qan::Style* style ) noexcept
+{
+    if ( style == nullptr ||
+         _styles.contains( style ) )
+        return;
+    _styles.insert( style );
+    const auto nodeStyle = qobject_cast<qan::NodeStyle*>( style );
+    if ( nodeStyle != nullptr ) {
+        connect( nodeStyle, &qan::NodeStyle::backColorChanged,      this, &NodeRenderer::invalidate );
+        connect( nodeStyle, &qan::NodeStyle::backOpacityChanged,    this, &NodeRenderer::invalidate );
+        connect( nodeStyle, &qan::NodeStyle::borderColorChanged,    this, &NodeRenderer::invalidate );
+        connect( nodeStyle, &qan::NodeStyle::borderWidthChanged,    this, &NodeRenderer::invalidate );
+    }
+    const auto edgeStyle = qobject_cast<qan::EdgeStyle*>( style );
+    if ( edgeStyle != nullptr )
+        connect( edgeStyle, &qan::EdgeStyle::styleModified,
+                 this,      &NodeRenderer::invalidate );
+    connect( style, &QObject::destroyed,
+             this,  [this, style]() { _styles.remove( style ); } );
+}
+//-----------------------------------------------------------------------------
+
+/* Labels Management *///------------------------------------------------------
+void    NodeRenderer::setViewport( const QRectF& viewport ) noexcept
+{
+    if ( viewport != _viewport ) {
+        _viewport = viewport;
+        emit viewportChanged();
+        invalidateLabels();
+    }
+}
+
+void    NodeRenderer::setZoom( qreal zoom ) noexcept
+{
+    if ( !qFuzzyCompare( 1. + zoom, 1. + _zoom ) ) {
+        _zoom = zoom;
+        emit zoomChanged();
+        invalidateLabels();
+    }
+}
+
+void    NodeRenderer::setLabelZoom( qreal labelZoom ) noexcept
+{
+    if ( !qFuzzyCompare( 1. + labelZoom, 1. + _labelZoom ) ) {
+        _labelZoom = labelZoom;
+        emit labelZoomChanged();
+        invalidateLabels();
+    }
+}
+
+void    NodeRenderer::invalidateLabels() noexcept
+{
+    _labelsDirty = true;
+    update();
+}
+
+QSGTexture* NodeRenderer::createLabelTexture( const QString& label, const QSize& size ) const noexcept
+{
+    const auto win = window();
+    if ( win == nullptr ||
+         size.isEmpty() )
+        return nullptr;
+    const auto devicePixelRatio = win->effectiveDevicePixelRatio();
+    QImage image{ size, QImage::Format_ARGB32_Premultiplied };
+    image.setDevicePixelRatio( devicePixelRatio );
+    image.fill( Qt::transparent );
+    {
+        QPainter painter{ &image };
+        painter.setRenderHint( QPainter::TextAntialiasing );
+        painter.setPen( Qt::black );
+        painter.drawText( QRectF{ QPointF{ 0., 0. }, QSizeF{ size } / devicePixelRatio },
+                          Qt::AlignCenter | Qt::TextWordWrap, label );
+    }
+    return win->createTextureFromImage( image, QQuickWindow::TextureHasAlphaChannel );
+}
+//-----------------------------------------------------------------------------
+
+/* Hover and Press Management *///---------------------------------------------
+bool    NodeRenderer::contains( const QPointF& point ) const
+{
+    return ( _hoveredNode && _hoveredNode->getGeometry().contains( point ) ) ||
+           nodeAt( point ) != nullptr;
+}
+
+void    NodeRenderer::hoverMoveEvent( QHoverEvent* event )
+{
+    updateHoveredNode( event->posF() );
+    QQuickItem::hoverMoveEvent( event );
+}
+
+void    NodeRenderer::hoverLeaveEvent( QHoverEvent* event )
+{
+    if ( _hoveredNode ) {
+        _hoveredNode.clear();
+        emit nodeHovered( nullptr );
+    }
+    QQuickItem::hoverLeaveEvent( event );
+}
+
+void    NodeRenderer::mousePressEvent( QMouseEvent* event )
+{
+    const auto node = nodeAt( event->localPos() );
+    if ( node == nullptr ) {
+        event->ignore();
+        return;
+    }
+    emit nodePressed( node, event->localPos(), event->button(), event->modifiers() );
+    event->accept();
+}
+
+void    NodeRenderer::updateHoveredNode( const QPointF& p ) noexcept
+{
+    // A hovered node stay hovered while pointer is in its geometry, even once promoted to its delegate
+    qan::Node* node = _hoveredNode.data();
+    if ( node == nullptr ||
+         !node->getGeometry().contains( p ) )
+        node = nodeAt( p );
+    if ( node != _hoveredNode.data() ) {
+        _hoveredNode = node;
+        emit nodeHovered( node );
+    }
+}
+//-----------------------------------------------------------------------------
+
+/* Scene Graph Management *///-------------------------------------------------
+void    NodeRenderer::updatePolish()
+{
+    QQuickItem::updatePolish();
+    if ( _syncRequested )
+        synchronize();
+}
+
+void    NodeRenderer::allocateChunks( QSGNode& parent, std::vector<QSGGeometryNode*>& chunkNodes,
+                                      std::size_t slotCount, int vertexCount ) noexcept
+{
+    // Chunks are never removed, released slots are reused
+    const auto chunkCount = ( slotCount + ChunkCapacity - 1 ) / ChunkCapacity;
+    while ( chunkNodes.size() < chunkCount ) {
+        auto geometry = new QSGGeometry{ QSGGeometry::defaultAttributes_ColoredPoint2D(), ChunkCapacity * vertexCount };
+        geometry->setDrawingMode( QSGGeometry::DrawTriangles );
+        const auto vertices = geometry->vertexDataAsColoredPoint2D();
+        for ( int v = 0; v < geometry->vertexCount(); ++v )     // Collapse all chunk slots
+            vertices[v].set( 0.f, 0.f, 0, 0, 0, 0 );
+        auto chunkNode = new QSGGeometryNode{};
+        chunkNode->setGeometry( geometry );
+        chunkNode->setFlag( QSGNode::OwnsGeometry );
+        chunkNode->setMaterial( new QSGVertexColorMaterial{} );
+        chunkNode->setFlag( QSGNode::OwnsMaterial );
+        parent.appendChildNode( chunkNode );
+        chunkNodes.push_back( chunkNode );
+    }
+}
+
+template < class WriteSlot >
+void    NodeRenderer::updateChunks( Slots& slots, std::vector<QSGGeometryNode*>& chunkNodes,
+                                    int vertexCount, WriteSlot writeSlot ) noexcept
+{
+    std::vector<bool> dirtyChunks( chunkNodes.size(), false );
+    for ( const auto slot : slots.dirtySlots ) {
+        const auto chunk = static_cast<std::size_t>( slot / ChunkCapacity );
+        writeSlot( chunkNodes[chunk]->geometry()->vertexDataAsColoredPoint2D() +
+                   ( slot % ChunkCapacity ) * vertexCount, slot );
+        slots.dirtyFlags[slot] = false;
+        dirtyChunks[chunk] = true;
+    }
+    slots.dirtySlots.clear();
+    for ( std::size_t chunk = 0; chunk < chunkNodes.size(); ++chunk )
+        if ( dirtyChunks[chunk] )
+            chunkNodes[chunk]->markDirty( QSGNode::DirtyGeometry );
+}
+
+QSGNode*    NodeRenderer::updatePaintNode( QSGNode* oldNode, UpdatePaintNodeData* )
+{
+    auto root = oldNode;
+    if ( root == nullptr ) {    // First frame or scene graph invalidation: all nodes are created again
+        root = new QSGNode{};
+        root->appendChildNode( new QSGNode{} );     // Edges are drawn below nodes
+        root->appendChildNode( new QSGNode{} );
+        _labelsNode = new QSGNode{};
+        root->appendChildNode( _labelsNode );
+        _edgeChunkNodes.clear();
+        _nodeChunkNodes.clear();
+        _edgeRectNodes.clear();
+        _nodeRectNodes.clear();
+        _labelNodes.clear();
+        const auto rendererInterface = window() != nullptr ? window()->rendererInterface() : nullptr;
+        _softwareBackend = rendererInterface != nullptr &&
+                           rendererInterface->graphicsApi() == QSGRendererInterface::Software;
+        _labelsDirty = true;
+        const auto markAllDirty = []( Slots& slots, std::size_t slotCount ) {
+            slots.dirtySlots.clear();
+            for ( std::size_t s = 0; s < slotCount; ++s ) {
+                slots.dirtyFlags[s] = true;
+                slots.dirtySlots.push_back( static_cast<int>( s ) );
+            }
+        };
+        markAllDirty( _edges, _edges.edges.size() );
+        markAllDirty( _nodes, _nodes.nodes.size() );
+    }
+
+    if ( _softwareBackend )     // Vertex color geometry is not supported by software backend
+        updateRectNodes( *root->childAtIndex( 0 ), *root->childAtIndex( 1 ) );
+    else {
+        allocateChunks( *root->childAtIndex( 0 ), _edgeChunkNodes, _edges.edges.size(), EdgeVertexCount );
+        updateChunks( _edges, _edgeChunkNodes, EdgeVertexCount,
+                      [this]( QSGGeometry::ColoredPoint2D* vertices, int slot ) { writeEdgeSlot( vertices, slot ); } );
+        allocateChunks( *root->childAtIndex( 1 ), _nodeChunkNodes, _nodes.nodes.size(), NodeVertexCount );
+        updateChunks( _nodes, _nodeChunkNodes, NodeVertexCount,
+                      [this]( QSGGeometry::ColoredPoint2D* vertices, int slot ) { writeNodeSlot( vertices, slot ); } );
+    }
+    updateLabelNodes( *_labelsNode );
+    return root;
+}
+
+//! Append a two triangles quad to \c vertex with a premultiplied \c color.
+static inline void  appendQuad( QSGGeometry::ColoredPoint2D*& vertex,
+                                float x1, float y1, float x2, float y2, QRgb color ) noexcept
+{
+    const auto r = static_cast<uchar>( qRed( color ) ), g = static_cast<uchar>( qGreen( color ) );
+    const auto b = static_cast<uchar>( qBlue( color ) ), a = static_cast<uchar>( qAlpha( color ) );
+    ( vertex++ )->set( x1, y1, r, g, b, a );
+    ( vertex++ )->set( x2, y1, r, g, b, a );
+    ( vertex++ )->set( x1, y2, r, g, b, a );
+    ( vertex++ )->set( x1, y2, r, g, b, a );
+    ( vertex++ )->set( x2, y1, r, g, b, a );
+    ( vertex++ )->set( x2, y2, r, g, b, a );
+}
+
+void    NodeRenderer::writeNodeSlot( QSGGeometry::ColoredPoint2D* vertices, int slot ) const noexcept
+{
+    if ( _nodes.nodes[slot] == nullptr ) {
+        for ( int v = 0; v < NodeVertexCount; ++v )     // Degenerated triangles are not rasterized
+            vertices[v].set( 0.f, 0.f, 0, 0, 0, 0 );
+        return;
+    }
+    const auto& rect = _nodes.rects[slot];
+    const float left = static_cast<float>( rect.left() ), top = static_cast<float>( rect.top() );
+    const float right = static_cast<float>( rect.right() ), bottom = static_cast<float>( rect.bottom() );
+    // Border is drawn inside node geometry, background fill border inner rect (no overdraw with translucent colors)
+    const float border = std::max( 0.f, std::min( _nodes.borderWidths[slot],
+                                                  std::min( right - left, bottom - top ) / 2.f ) );
+    const auto borderColor = _nodes.borderColors[slot];
+    auto vertex = vertices;
+    appendQuad( vertex, left + border, top + border, right - border, bottom - border, _nodes.backColors[slot] );
+    appendQuad( vertex, left, top, right, top + border, borderColor );
+    appendQuad( vertex, left, bottom - border, right, bottom, borderColor );
+    appendQuad( vertex, left, top + border, left + border, bottom - border, borderColor );
+    appendQuad( vertex, right - border, top + border, right, bottom - border, borderColor );
+}
+
+void    NodeRenderer::writeEdgeSlot( QSGGeometry::ColoredPoint2D* vertices, int slot ) const noexcept
+{
+    const auto& line = _edges.lines[slot];
+    if ( _edges.edges[slot] == nullptr ||
+         line.isNull() ) {
+        for ( int v = 0; v < EdgeVertexCount; ++v )
+            vertices[v].set( 0.f, 0.f, 0, 0, 0, 0 );
+        return;
+    }
+    const auto color = _edges.colors[slot];
+    const auto r = static_cast<uchar>( qRed( color ) ), g = static_cast<uchar>( qGreen( color ) );
+    const auto b = static_cast<uchar>( qBlue( color ) ), a = static_cast<uchar>( qAlpha( color ) );
+    const float sx = static_cast<float>( line.x1() ), sy = static_cast<float>( line.y1() );
+    const float ex = static_cast<float>( line.x2() ), ey = static_cast<float>( line.y2() );
+    float nx = sy - ey;     // Line normal
+    float ny = ex - sx;
+    const float length = std::sqrt( nx * nx + ny * ny );
+    const float halfWidth = _edges.widths[slot] / 2.f;
+    if ( length > 0.0001f ) {
+        nx *= halfWidth / length;
+        ny *= halfWidth / length;
+    } else
+        nx = ny = 0.f;
+    auto vertex = vertices;
+    ( vertex++ )->set( sx + nx, sy + ny, r, g, b, a );
+    ( vertex++ )->set( sx - nx, sy - ny, r, g, b, a );
+    ( vertex++ )->set( ex + nx, ey + ny, r, g, b, a );
+    ( vertex++ )->set( ex + nx, ey + ny, r, g, b, a );
+    ( vertex++ )->set( sx - nx, sy - ny, r, g, b, a );
+    ( vertex++ )->set( ex - nx, ey - ny, r, g, b, a );
+}
+
+void    NodeRenderer::updateRectNodes( QSGNode& edgesNode, QSGNode& nodesNode ) noexcept
+{
+    const auto win = window();
+    if ( win == nullptr )
+        return;
+    // Slot nodes are never removed, released slots are reused
+    while ( _edgeRectNodes.size() < _edges.edges.size() ) {
+        auto slotNode = new QSGTransformNode{};
+        slotNode->appendChildNode( win->createRectangleNode() );
+        edgesNode.appendChildNode( slotNode );
+        _edgeRectNodes.push_back( slotNode );
+    }
+    while ( _nodeRectNodes.size() < _nodes.nodes.size() ) {
+        auto slotNode = new QSGNode{};
+        for ( int r = 0; r < NodeRectCount; ++r )
+            slotNode->appendChildNode( win->createRectangleNode() );
+        nodesNode.appendChildNode( slotNode );
+        _nodeRectNodes.push_back( slotNode );
+    }
+    for ( const auto slot : _edges.dirtySlots ) {
+        writeEdgeRects( *_edgeRectNodes[slot], slot );
+        _edges.dirtyFlags[slot] = false;
+    }
+    _edges.dirtySlots.clear();
+    for ( const auto slot : _nodes.dirtySlots ) {
+        writeNodeRects( *_nodeRectNodes[slot], slot );
+        _nodes.dirtyFlags[slot] = false;
+    }
+    _nodes.dirtySlots.clear();
+}
+
+//! Set \c rectNode geometry and color from a premultiplied \c color.
+static inline void  setRectNode( QSGNode* rectNode, const QRectF& rect, QRgb color ) noexcept
+{
+    auto rectangleNode = static_cast<QSGRectangleNode*>( rectNode );
+    rectangleNode->setRect( rect );
+    rectangleNode->setColor( QColor::fromRgba( qUnpremultiply( color ) ) );
+}
+
+void    NodeRenderer::writeNodeRects( QSGNode& slotNode, int slot ) const noexcept
+{
+    if ( _nodes.nodes[slot] == nullptr ) {
+        for ( auto rectNode = slotNode.firstChild(); rectNode != nullptr; rectNode = rectNode->nextSibling() )
+            static_cast<QSGRectangleNode*>( rectNode )->setRect( QRectF{} );     // Empty rectangles are not drawn
+        return;
+    }
+    const auto& rect = _nodes.rects[slot];
+    const qreal border = std::max( 0., std::min( static_cast<qreal>( _nodes.borderWidths[slot] ),
+                                                 std::min( rect.width(), rect.height() ) / 2. ) );
+    const auto borderColor = _nodes.borderColors[slot];
+    auto rectNode = slotNode.firstChild();
+    setRectNode( rectNode, rect.adjusted( border, border, -border, -border ), _nodes.backColors[slot] );
+    rectNode = rectNode->nextSibling();
+    setRectNode( rectNode, QRectF{ rect.left(), rect.top(), rect.width(), border }, borderColor );
+    rectNode = rectNode->nextSibling();
+    setRectNode( rectNode, QRectF{ rect.left(), rect.bottom() - border, rect.width(), border }, borderColor );
+    rectNode = rectNode->nextSibling();
+    setRectNode( rectNode, QRectF{ rect.left(), rect.top() + border, border, rect.height() - 2. * border }, borderColor );
+    rectNode = rectNode->nextSibling();
+    setRectNode( rectNode, QRectF{ rect.right() - border, rect.top() + border, border, rect.height() - 2. * border }, borderColor );
+}
+
+void    NodeRenderer::writeEdgeRects( QSGTransformNode& slotNode, int slot ) const noexcept
+{
+    const auto rectNode = slotNode.firstChild();
+    const auto& line = _edges.lines[slot];
+    if ( _edges.edges[slot] == nullptr ||
+         line.isNull() ) {
+        static_cast<QSGRectangleNode*>( rectNode )->setRect( QRectF{} );
+        return;
+    }
+    // Line is drawn as a rectangle along x axis, then rotated and translated to line start point
+    QMatrix4x4 matrix;
+    matrix.translate( static_cast<float>( line.x1() ), static_cast<float>( line.y1() ) );
+    matrix.rotate( static_cast<float>( qRadiansToDegrees( std::atan2( line.dy(), line.dx() ) ) ), 0.f, 0.f, 1.f );
+    slotNode.setMatrix( matrix );
+    const qreal halfWidth = static_cast<qreal>( _edges.widths[slot] ) / 2.;
+    setRectNode( rectNode, QRectF{ 0., -halfWidth, line.length(), 2. * halfWidth }, _edges.colors[slot] );
+}
+
+void    NodeRenderer::updateLabelNodes( QSGNode& labelsNode ) noexcept
+{
+    if ( !_labelsDirty )
+        return;
+    _labelsDirty = false;
+
+    // Labels are drawn only for a reasonable number of visible nodes
+    std::vector<qan::Node*> labelledNodes;
+    if ( window() != nullptr &&
+         _zoom >= _labelZoom &&
+         !_viewport.isEmpty() ) {
+        labelledNodes = _nodeIndex.queryRect( gtpo::Box::fromRect( _viewport.x(), _viewport.y(),
+                                                                   _viewport.width(), _viewport.height() ) );
+        if ( labelledNodes.size() > static_cast<std::size_t>( MaxLabelCount ) )
+            labelledNodes.clear();
+    }
+    QSet<qan::Node*> labelled;
+    for ( const auto node : labelledNodes )
+        if ( !_nodes.labels[_nodeSlots.value( node )].isEmpty() )
+            labelled.insert( node );
+
+    for ( auto labelNode = _labelNodes.begin(); labelNode != _labelNodes.end(); ) {
+        if ( !labelled.contains( labelNode.key() ) ) {
+            labelsNode.removeChildNode( labelNode->node );
+            delete labelNode->node;     // Texture is owned by node
+            labelNode = _labelNodes.erase( labelNode );
+        } else
+            ++labelNode;
+    }
+    const auto devicePixelRatio = window() != nullptr ? window()->effectiveDevicePixelRatio() : 1.;
+    for ( const auto node : labelled ) {
+        const auto slot = _nodeSlots.value( node );
+        const auto& rect = _nodes.rects[slot];
+        const auto& label = _nodes.labels[slot];
+        const QSize size{ static_cast<int>( std::ceil( rect.width() * devicePixelRatio ) ),
+                          static_cast<int>( std::ceil( rect.height() * devicePixelRatio ) ) };
+        auto& labelNode = _labelNodes[node];
+        if ( labelNode.node != nullptr &&
+             ( labelNode.label != label || labelNode.size != size ) ) {
+            labelsNode.removeChildNode( labelNode.node );
+            delete labelNode.node;
+            labelNode.node = nullptr;
+        }
+        if ( labelNode.node == nullptr ) {
+            const auto texture = createLabelTexture( label, size );
+            if ( texture == nullptr ) {
+                _labelNodes.remove( node );
+                continue;
+            }
+            labelNode.node = new QSGSimpleTextureNode{};
+            labelNode.node->setTexture( texture );
+            labelNode.node->setOwnsTexture( true );
+            labelNode.label = label;
+            labelNode.size = size;
+            labelsNode.appendChildNode( labelNode.node );
+        }
+        labelNode.node->setRect( rect );
+    }
+}
+//-----------------------------------------------------------------------------
+
+} // ::qan
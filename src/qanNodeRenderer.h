@@ -0,0 +1,320 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the QuickQanava software library.
+//
+// \file	qanNodeRenderer.h
+// \author	benoit@destrat.io
+// \date	2017 12 19
+//-----------------------------------------------------------------------------
+
+#ifndef qanNodeRenderer_h
+#define qanNodeRenderer_h
+
+// Std headers
+#include <vector>
+
+// Qt headers
+#include <QQuickItem>
+#include <QPointer>
+#include <QHash>
+#include <QSet>
+#include <QSGNode>
+#include <QSGGeometry>
+#include <QSGSimpleTextureNode>
+
+// GTpo headers
+#include <gtpoSpatialIndex.h>
+
+namespace qan { // ::qan
+
+class Graph;
+class Node;
+class Edge;
+class Style;
+
+/*! \brief Draw nodes and edges that have no visual delegate as batched rectangles, borders, labels and lines.
+ *
+ * Used by qan::Graph when \c lightweightNodes is true: nodes without item (ie not promoted to their QML
+ * delegate) are drawn from their geometry (see qan::Node::getGeometry()), label and node style \c backColor,
+ * \c backOpacity, \c borderColor and \c borderWidth. Edges without item are drawn as straight lines between
+ * their end points centers with their style \c lineColor and \c lineWidth.
+ *
+ * Drawn primitives are stored in flat arrays, every primitive owns a fixed size vertex sub range in a
+ * shared chunk vertex buffer: synchronize() only rewrite sub ranges of primitives whose geometry or style
+ * has changed. Labels are rendered to textures only for nodes intersecting \c viewport when \c zoom is greater
+ * than \c labelZoom.
+ *
+ * Vertex color chunks can't be drawn by the Qt Quick software backend (QSGGeometryNode with custom materials
+ * are ignored): when window scene graph backend is QSGRendererInterface::Software, every drawn primitive slot
+ * is mapped to rectangle nodes created with QQuickWindow::createRectangleNode() (a background and four border
+ * rectangles for nodes, a rotated rectangle for edges). Slots are updated with the same dirty slots tracking,
+ * with a higher scene graph node count.
+ *
+ * Renderer also provide hover and press detection for drawn nodes with a spatial index, see nodeHovered()
+ * and nodePressed().
+ *
+ * \sa qan::Graph::lightweightNodes
+ */
+class NodeRenderer : public QQuickItem
+{
+    /*! \name NodeRenderer Object Management *///------------------------------
+    //@{
+    Q_OBJECT
+public:
+    explicit NodeRenderer( QQuickItem* parent = nullptr );
+    virtual ~NodeRenderer() override;
+    NodeRenderer( const NodeRenderer& ) = delete;
+    NodeRenderer& operator=( const NodeRenderer& ) = delete;
+    NodeRenderer( NodeRenderer&& ) = delete;
+    NodeRenderer& operator=( NodeRenderer&& ) = delete;
+
+public:
+    //! Set the graph whose primitives without item are drawn by this renderer.
+    void                setGraph( qan::Graph* graph ) noexcept;
+    inline qan::Graph*  getGraph() const noexcept { return _graph.data(); }
+private:
+    QPointer<qan::Graph>    _graph;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Primitive Synchronization Management *///------------------------
+    //@{
+public:
+    //! Number of nodes drawn by this renderer (read only).
+    Q_PROPERTY( int nodeCount READ getNodeCount NOTIFY nodeCountChanged FINAL )
+    //! \copydoc nodeCount
+    inline int      getNodeCount() const noexcept { return _nodeSlots.size(); }
+signals:
+    //! \copydoc nodeCount
+    void            nodeCountChanged();
+
+public:
+    //! Schedule a synchronize() before next frame (multiple requests are coalesced).
+    void            invalidate() noexcept;
+    /*! \brief Synchronize drawn primitives with graph nodes and edges that have no item.
+     *
+     * Nodes or edges that have been promoted to an item are removed, demoted ones are added, and only
+     * primitives whose geometry, label or style has changed are marked for update.
+     */
+    void            synchronize() noexcept;
+
+    //! Return the drawn node whose geometry contains \c p (in renderer coordinate system), or nullptr.
+    Q_INVOKABLE qan::Node*  nodeAt( const QPointF& p ) const;
+
+private:
+    //! Fixed size vertex slots allocator with dirty slots tracking.
+    struct Slots {
+        std::vector<int>    freeSlots;
+        //! Dirty slot indexes (with no duplicates, see \c dirtyFlags), processed in updatePaintNode().
+        std::vector<int>    dirtySlots;
+        std::vector<bool>   dirtyFlags;
+        //! Return true if \c slot was not already dirty.
+        bool                markDirty( int slot ) noexcept;
+    };
+    //! Drawn nodes data, indexed by slot (a nullptr node mark a free slot).
+    struct NodeArrays : public Slots {
+        std::vector<qan::Node*> nodes;
+        std::vector<QRectF>     rects;
+        std::vector<QRgb>       backColors;     // Premultiplied
+        std::vector<QRgb>       borderColors;   // Premultiplied
+        std::vector<float>      borderWidths;
+        std::vector<QString>    labels;
+    };
+    //! Drawn edges data, indexed by slot (a nullptr edge mark a free slot).
+    struct EdgeArrays : public Slots {
+        std::vector<qan::Edge*> edges;
+        std::vector<QLineF>     lines;
+        std::vector<QRgb>       colors;         // Premultiplied
+        std::vector<float>      widths;
+    };
+
+    //! Add or update \c node data in its slot, return node slot.
+    int             syncNode( qan::Node& node ) noexcept;
+    //! Add or update \c edge data in its slot.
+    void            syncEdge( qan::Edge& edge ) noexcept;
+    //! Release \c node slot, its vertices are collapsed on next update.
+    void            releaseNode( qan::Node* node ) noexcept;
+    //! Release \c edge slot, its vertices are collapsed on next update.
+    void            releaseEdge( qan::Edge* edge ) noexcept;
+    //! Monitor \c style modifications (shared by many primitives).
+    void            watchStyle( qan::Style* style ) noexcept;
+    //! Mark labels for update and schedule a new frame.
+    void            invalidateLabels() noexcept;
+
+    NodeArrays              _nodes;
+    EdgeArrays              _edges;
+    QHash<qan::Node*, int>  _nodeSlots;
+    QHash<qan::Edge*, int>  _edgeSlots;
+    //! Spatial index of drawn nodes (in renderer coordinate system).
+    gtpo::SpatialIndex<qan::Node*>  _nodeIndex;
+    QSet<qan::Style*>       _styles;
+    bool                    _syncRequested{ false };
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Labels Management *///-------------------------------------------
+    //@{
+public:
+    //! Visible rectangle in renderer coordinate system, labels are drawn only for nodes intersecting viewport.
+    Q_PROPERTY( QRectF viewport READ getViewport WRITE setViewport NOTIFY viewportChanged FINAL )
+    //! \copydoc viewport
+    inline QRectF   getViewport() const noexcept { return _viewport; }
+    //! \copydoc viewport
+    void            setViewport( const QRectF& viewport ) noexcept;
+private:
+    //! \copydoc viewport
+    QRectF          _viewport{};
+signals:
+    //! \copydoc viewport
+    void            viewportChanged();
+
+public:
+    //! Current view zoom level (default to 1.0).
+    Q_PROPERTY( qreal zoom READ getZoom WRITE setZoom NOTIFY zoomChanged FINAL )
+    //! \copydoc zoom
+    inline qreal    getZoom() const noexcept { return _zoom; }
+    //! \copydoc zoom
+    void            setZoom( qreal zoom ) noexcept;
+private:
+    //! \copydoc zoom
+    qreal           _zoom{ 1.0 };
+signals:
+    //! \copydoc zoom
+    void            zoomChanged();
+
+public:
+    //! Node labels are not drawn when \c zoom is less than \c labelZoom (default to 0.5).
+    Q_PROPERTY( qreal labelZoom READ getLabelZoom WRITE setLabelZoom NOTIFY labelZoomChanged FINAL )
+    //! \copydoc labelZoom
+    inline qreal    getLabelZoom() const noexcept { return _labelZoom; }
+    //! \copydoc labelZoom
+    void            setLabelZoom( qreal labelZoom ) noexcept;
+private:
+    //! \copydoc labelZoom
+    qreal           _labelZoom{ 0.5 };
+signals:
+    //! \copydoc labelZoom
+    void            labelZoomChanged();
+
+public:
+    //! Maximum number of label textures, labels are not drawn when more nodes are visible.
+    static constexpr int    MaxLabelCount = 512;
+
+private:
+    //! Render \c label in a texture of \c size.
+    QSGTexture*     createLabelTexture( const QString& label, const QSize& size ) const noexcept;
+    //! Label texture node with the label and size used to create its texture.
+    struct LabelNode {
+        QSGSimpleTextureNode*   node{ nullptr };
+        QString                 label{};
+        QSize                   size{};
+    };
+    //! Label nodes (owned by labels scene graph parent node), only accessed from updatePaintNode().
+    QHash<qan::Node*, LabelNode>    _labelNodes;
+    bool                            _labelsDirty{ true };
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Hover and Press Management *///----------------------------------
+    //@{
+public:
+    //! Hit test restricted to drawn nodes and hovered node (renderer has no size).
+    virtual bool    contains( const QPointF& point ) const override;
+signals:
+    //! Emitted when the hovered node change (\c node might be a drawn node or a node that has been promoted since hovered, or nullptr).
+    void            nodeHovered( qan::Node* node );
+    //! Emitted when a drawn node is pressed.
+    void            nodePressed( qan::Node* node, QPointF pos, Qt::MouseButton button, Qt::KeyboardModifiers modifiers );
+
+protected:
+    virtual void    hoverMoveEvent( QHoverEvent* event ) override;
+    virtual void    hoverLeaveEvent( QHoverEvent* event ) override;
+    virtual void    mousePressEvent( QMouseEvent* event ) override;
+private:
+    //! Update hovered node for a pointer at \c p.
+    void            updateHoveredNode( const QPointF& p ) noexcept;
+    QPointer<qan::Node>     _hoveredNode;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Scene Graph Management *///--------------------------------------
+    //@{
+public:
+    //! Maximum number of primitives in a chunk geometry node.
+    static constexpr int    ChunkCapacity = 1024;
+    //! Number of vertices of a node slot (background quad and four border quads).
+    static constexpr int    NodeVertexCount = 30;
+    //! Number of vertices of an edge slot (line quad).
+    static constexpr int    EdgeVertexCount = 6;
+    //! Number of rectangle nodes of a node slot with software backend (background and four borders).
+    static constexpr int    NodeRectCount = 5;
+
+protected:
+    //! Run a pending synchronize() before the scene graph is synchronized.
+    virtual void        updatePolish() override;
+    virtual QSGNode*    updatePaintNode( QSGNode* oldNode, UpdatePaintNodeData* ) override;
+private:
+    //! Append chunk geometry nodes to \c parent until \c chunkNodes can store \c slotCount slots of \c vertexCount vertices.
+    static void         allocateChunks( QSGNode& parent, std::vector<QSGGeometryNode*>& chunkNodes,
+                                        std::size_t slotCount, int vertexCount ) noexcept;
+    //! Rewrite \c slots dirty sub ranges in \c chunkNodes with \c writeSlot.
+    template < class WriteSlot >
+    static void         updateChunks( Slots& slots, std::vector<QSGGeometryNode*>& chunkNodes,
+                                      int vertexCount, WriteSlot writeSlot ) noexcept;
+    //! Write node \c slot triangles in \c vertices (collapse them if slot is free).
+    void                writeNodeSlot( QSGGeometry::ColoredPoint2D* vertices, int slot ) const noexcept;
+    //! Write edge \c slot triangles in \c vertices (collapse them if slot is free).
+    void                writeEdgeSlot( QSGGeometry::ColoredPoint2D* vertices, int slot ) const noexcept;
+    //! Update label texture nodes for drawn nodes in \c viewport.
+    void                updateLabelNodes( QSGNode& labelsNode ) noexcept;
+
+    //! Software backend: append per slot rectangle nodes, then rewrite dirty slots rectangles.
+    void                updateRectNodes( QSGNode& edgesNode, QSGNode& nodesNode ) noexcept;
+    //! Software backend: write node \c slot background and border rectangles in \c slotNode children (empty rectangles if slot is free).
+    void                writeNodeRects( QSGNode& slotNode, int slot ) const noexcept;
+    //! Software backend: write edge \c slot line rectangle and its transformation in \c slotNode (empty rectangle if slot is free).
+    void                writeEdgeRects( QSGTransformNode& slotNode, int slot ) const noexcept;
+
+    //! Scene graph nodes, only accessed from updatePaintNode() (owned by scene graph root node).
+    std::vector<QSGGeometryNode*>   _edgeChunkNodes;
+    std::vector<QSGGeometryNode*>   _nodeChunkNodes;
+    QSGNode*                        _labelsNode{ nullptr };
+    //! True when window scene graph use the software backend, set when scene graph nodes are created.
+    bool                            _softwareBackend{ false };
+    //! Software backend per slot nodes (rectangle nodes are children of slot nodes).
+    std::vector<QSGNode*>           _nodeRectNodes;
+    std::vector<QSGTransformNode*>  _edgeRectNodes;
+    //@}
+    //-------------------------------------------------------------------------
+};
+
+} // ::qan
+
+QML_DECLARE_TYPE( qan::NodeRenderer )
+
+#endif // qanNodeRenderer_h
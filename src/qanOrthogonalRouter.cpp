@@ -0,0 +1,454 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the QuickQanava software library.
+//
+// \file	qanOrthogonalRouter.cpp
+// \author	benoit@destrat.io
+// \date	2017 12 29
+//-----------------------------------------------------------------------------
+
+// Std headers
+#include <algorithm>
+
+// Qt headers
+#include <QtConcurrent>
+
+// GTpo headers
+#include <gtpoOrthogonalRouter.h>
+
+// QuickQanava headers
+#include "./qanOrthogonalRouter.h"
+#include "./qanNodeItem.h"
+#include "./qanGroupItem.h"
+#include "./qanEdgeItem.h"
+#include "./qanPortItem.h"
+#include "./qanGroup.h"
+
+namespace qan { // ::qan
+
+/* OrthogonalRouter Object Management *///-------------------------------------
+OrthogonalRouter::OrthogonalRouter( QObject* parent ) :
+    QObject{ parent },
+    _router{ std::make_unique<gtpo::OrthogonalRouter>() }
+{
+    _routingTimer.setSingleShot( true );
+    _routingTimer.setInterval( 0 );
+    connect( &_routingTimer,    &QTimer::timeout,
+             this,              &OrthogonalRouter::processEdits );
+    connect( &_routingWatcher,  &QFutureWatcher<void>::finished,
+             this,              &OrthogonalRouter::routingFinished );
+}
+
+OrthogonalRouter::~OrthogonalRouter()
+{
+    _routingWatcher.waitForFinished();  // Worker thread reference _router
+    if ( _graph )
+        ForwardingBehaviour<qan::OrthogonalRouter>::uninstall( *_graph, this );
+}
+//-----------------------------------------------------------------------------
+
+/* Router Configuration *///---------------------------------------------------
+void    OrthogonalRouter::setGraph( qan::Graph* graph ) noexcept
+{
+    if ( graph != _graph ) {
+        _routingWatcher.waitForFinished();
+        if ( _graph ) {
+            ForwardingBehaviour<qan::OrthogonalRouter>::uninstall( *_graph, this );
+            disconnect( _graph, nullptr, this, nullptr );
+        }
+        _graph = graph;
+        if ( _graph ) {
+            ForwardingBehaviour<qan::OrthogonalRouter>::install( *_graph, this );
+            connect( _graph,    &qan::Graph::cleared,
+                     this,      &OrthogonalRouter::graphCleared );
+        }
+        reset();
+        emit graphChanged();
+    }
+}
+
+void    OrthogonalRouter::setMargin( qreal margin ) noexcept
+{
+    margin = std::max( 0., margin );
+    if ( !qFuzzyCompare( 1. + margin, 1. + _margin ) ) {
+        _margin = margin;
+        scheduleReset();    // All routes depend on margin
+        emit marginChanged();
+    }
+}
+
+void    OrthogonalRouter::setBendPenalty( qreal bendPenalty ) noexcept
+{
+    bendPenalty = std::max( 0., bendPenalty );
+    if ( !qFuzzyCompare( 1. + bendPenalty, 1. + _bendPenalty ) ) {
+        _bendPenalty = bendPenalty;
+        scheduleReset();
+        emit bendPenaltyChanged();
+    }
+}
+
+void    OrthogonalRouter::setNudgeSpacing( qreal nudgeSpacing ) noexcept
+{
+    nudgeSpacing = std::max( 0., nudgeSpacing );
+    if ( !qFuzzyCompare( 1. + nudgeSpacing, 1. + _nudgeSpacing ) ) {
+        _nudgeSpacing = nudgeSpacing;
+        scheduleReset();
+        emit nudgeSpacingChanged();
+    }
+}
+//-----------------------------------------------------------------------------
+
+/* Routing Management *///-----------------------------------------------------
+void    OrthogonalRouter::reset()
+{
+    if ( _running ) {       // Router is used from worker thread
+        scheduleReset();
+        return;
+    }
+    _resetPending = false;
+    _router->clear();
+    _items.clear();
+    _obstacles.clear();
+    _groupContents.clear();
+    _insertedNodes.clear();
+    _insertedEdges.clear();
+    _removedObstacles.clear();
+    _removedRoutes.clear();
+    _movedObstacles.clear();
+    // Edges routed until now are drawn straight until they are routed again
+    for ( const auto& edge : _edges )
+        if ( edge && edge->getItem() != nullptr )
+            edge->getItem()->setRoute( QPolygonF{} );
+    _edges.clear();
+    _routes.clear();
+    if ( !_graph )
+        return;
+
+    // Groups are loaded first, they are grouped nodes containers: sort groups by nesting depth
+    std::vector<std::pair<int, qan::Group*>> groups;
+    groups.reserve( static_cast<std::size_t>( _graph->getGroupCount() ) );
+    for ( const auto& group : _graph->getGroups() ) {
+        if ( !group )
+            continue;
+        int depth = 0;
+        for ( auto parent = group->getGroup().lock(); parent; parent = parent->getGroup().lock() )
+            ++depth;
+        groups.emplace_back( depth, group.get() );
+    }
+    std::stable_sort( groups.begin(), groups.end(),
+                      []( const std::pair<int, qan::Group*>& a, const std::pair<int, qan::Group*>& b ) { return a.first < b.first; } );
+    for ( const auto& group : groups ) {
+        const auto groupItem = group.second->getItem();
+        if ( groupItem == nullptr )
+            continue;
+        const auto parent = group.second->getGroup().lock();
+        const auto container = _obstacles.constFind( parent ? parent->getItem() : nullptr );
+        if ( container != _obstacles.constEnd() )
+            _groupContents[ container.value() ].push_back( addObstacle( groupItem, container.value() ) );
+        else
+            addObstacle( groupItem, gtpo::OrthogonalRouter::NoIndex );
+        connect( groupItem,     &QObject::destroyed,       // Grouped nodes are ungrouped
+                 this,          &OrthogonalRouter::scheduleReset, Qt::UniqueConnection );
+    }
+    for ( const auto& node : _graph->getNodes() )
+        if ( node )
+            _insertedNodes.emplace_back( node.get() );
+    for ( const auto& edge : _graph->getEdges() )
+        if ( edge )
+            _insertedEdges.emplace_back( edge.get() );
+    scheduleRouting();
+}
+
+void    OrthogonalRouter::setRunning( bool running ) noexcept
+{
+    if ( running != _running ) {
+        _running = running;
+        emit runningChanged();
+    }
+}
+
+void    OrthogonalRouter::nodeInserted( qan::Node* node )
+{
+    if ( node == nullptr )
+        return;
+    _insertedNodes.emplace_back( node );
+    scheduleRouting();
+}
+
+void    OrthogonalRouter::nodeRemoved( qan::Node* node )
+{
+    if ( node == nullptr )
+        return;
+    // Node might be destroyed later, it must not be inserted on next processEdits()
+    _insertedNodes.erase( std::remove( _insertedNodes.begin(), _insertedNodes.end(), node ), _insertedNodes.end() );
+    const auto index = _obstacles.find( node->getItem() );
+    if ( index == _obstacles.end() )
+        return;
+    // Adjacent edges routes are removed from router with their obstacle, edges are notified afterward
+    for ( const auto& inEdge : node->getInEdges() )
+        removeRoute( inEdge.lock().get() );
+    for ( const auto& outEdge : node->getOutEdges() )
+        removeRoute( outEdge.lock().get() );
+    _removedObstacles.push_back( index.value() );
+    _items[ index.value() ] = nullptr;
+    _obstacles.erase( index );
+    scheduleRouting();
+}
+
+void    OrthogonalRouter::edgeInserted( qan::Edge* edge )
+{
+    if ( edge == nullptr )
+        return;
+    _insertedEdges.emplace_back( edge );
+    scheduleRouting();
+}
+
+void    OrthogonalRouter::edgeRemoved( qan::Edge* edge )
+{
+    if ( edge == nullptr )
+        return;
+    _insertedEdges.erase( std::remove( _insertedEdges.begin(), _insertedEdges.end(), edge ), _insertedEdges.end() );
+    removeRoute( edge );
+}
+
+void    OrthogonalRouter::graphCleared()
+{
+    if ( _graph )
+        ForwardingBehaviour<qan::OrthogonalRouter>::install( *_graph, this );
+    reset();
+}
+
+void    OrthogonalRouter::itemGeometryChanged()
+{
+    const auto index = _obstacles.constFind( qobject_cast<QQuickItem*>( sender() ) );
+    if ( index == _obstacles.constEnd() )
+        return;
+    // Group content (including sub groups content) is moved with its group
+    const auto first = _movedObstacles.size();
+    _movedObstacles.push_back( index.value() );
+    for ( auto moved = first; moved < _movedObstacles.size(); ++moved ) {
+        const auto content = _groupContents.constFind( _movedObstacles[ moved ] );
+        if ( content != _groupContents.constEnd() )
+            _movedObstacles.insert( _movedObstacles.end(), content->begin(), content->end() );
+    }
+    scheduleRouting();
+}
+
+void    OrthogonalRouter::edgeStyleChanged()
+{
+    const auto edgeItem = qobject_cast<qan::EdgeItem*>( sender() );
+    if ( edgeItem == nullptr ) {        // A shared style line type has been modified
+        scheduleReset();
+        return;
+    }
+    const auto edge = edgeItem->getEdge();
+    if ( edge == nullptr )
+        return;
+    removeRoute( edge );
+    _insertedEdges.emplace_back( edge );
+    scheduleRouting();
+}
+
+void    OrthogonalRouter::scheduleReset() noexcept
+{
+    _resetPending = true;
+    scheduleRouting();
+}
+
+void    OrthogonalRouter::scheduleRouting() noexcept
+{
+    if ( !_routingTimer.isActive() )
+        _routingTimer.start();
+}
+
+void    OrthogonalRouter::processEdits()
+{
+    if ( _running )     // Edits are processed once running routing has finished, see routingFinished()
+        return;
+    if ( _resetPending ) {
+        reset();        // Schedule a new processEdits() call
+        return;
+    }
+    if ( !_graph )
+        return;
+    auto& router = *_router;
+
+    // Removed routes first, obstacles removal also remove their routes
+    for ( const auto route : _removedRoutes )
+        if ( router.isRoute( route ) )
+            router.removeRoute( route );
+    _removedRoutes.clear();
+    for ( const auto obstacle : _removedObstacles )
+        if ( router.isObstacle( obstacle ) )
+            router.removeObstacle( obstacle );
+    _removedObstacles.clear();
+
+    std::sort( _movedObstacles.begin(), _movedObstacles.end() );
+    _movedObstacles.erase( std::unique( _movedObstacles.begin(), _movedObstacles.end() ), _movedObstacles.end() );
+    for ( const auto obstacle : _movedObstacles ) {
+        const auto item = obstacle < _items.size() ? _items[ obstacle ].data() : nullptr;
+        if ( item != nullptr &&
+             router.isObstacle( obstacle ) ) {
+            const auto rect = itemRect( item );
+            router.setObstacle( obstacle, rect.x(), rect.y(), rect.width(), rect.height() );
+        }
+    }
+    _movedObstacles.clear();
+
+    // Inserted nodes and edges are now fully initialized (node and edge items are set)
+    for ( const auto& node : _insertedNodes ) {
+        const auto nodeItem = node ? node->getItem() : nullptr;
+        if ( nodeItem == nullptr ||
+             _obstacles.contains( nodeItem ) )
+            continue;
+        auto container = gtpo::OrthogonalRouter::NoIndex;
+        const auto group = node->getGroup().lock();
+        const auto groupItem = group ? group->getItem() : nullptr;
+        const auto groupObstacle = _obstacles.constFind( groupItem );
+        if ( groupItem != nullptr ) {
+            if ( groupObstacle == _obstacles.constEnd() ) {     // Group inserted after last reset()
+                scheduleReset();
+                return;
+            }
+            container = groupObstacle.value();
+        }
+        const auto obstacle = addObstacle( nodeItem, container );
+        if ( container != gtpo::OrthogonalRouter::NoIndex )
+            _groupContents[ container ].push_back( obstacle );
+        connect( nodeItem,  &QQuickItem::parentChanged,     // Node has been grouped or ungrouped
+                 this,      &OrthogonalRouter::scheduleReset, Qt::UniqueConnection );
+    }
+    _insertedNodes.clear();
+    for ( const auto& edge : _insertedEdges )
+        if ( edge )
+            addRoute( edge.data() );
+    _insertedEdges.clear();
+    if ( !router.hasDirtyRoutes() )
+        return;
+
+    router.margin = _margin;
+    router.bendPenalty = _bendPenalty;
+    router.nudgeSpacing = _nudgeSpacing;
+    setRunning( true );
+    _routingWatcher.setFuture( QtConcurrent::run( [this]() { _changedRoutes = _router->route(); } ) );
+}
+
+void    OrthogonalRouter::routingFinished()
+{
+    setRunning( false );
+    for ( const auto route : _changedRoutes ) {
+        const auto edge = route < _edges.size() ? _edges[ route ].data() : nullptr;
+        const auto edgeItem = edge != nullptr ? edge->getItem() : nullptr;
+        if ( edgeItem == nullptr )          // Edge has been removed while routing was running
+            continue;
+        const auto& points = _router->getRoute( route );
+        QPolygonF polygon;
+        polygon.reserve( static_cast<int>( points.size() ) );
+        for ( const auto& point : points )
+            polygon.append( QPointF{ point.x, point.y } );
+        edgeItem->setRoute( polygon );
+    }
+    _changedRoutes.clear();
+    emit finished();
+    if ( _resetPending ||
+         !_insertedNodes.empty() || !_insertedEdges.empty() ||
+         !_removedObstacles.empty() || !_removedRoutes.empty() || !_movedObstacles.empty() )
+        scheduleRouting();
+}
+
+std::uint32_t   OrthogonalRouter::addObstacle( QQuickItem* item, std::uint32_t container )
+{
+    const auto rect = itemRect( item );
+    const auto obstacle = _router->addObstacle( rect.x(), rect.y(), rect.width(), rect.height(), container );
+    if ( obstacle >= _items.size() )
+        _items.resize( obstacle + 1 );
+    _items[ obstacle ] = item;
+    _obstacles.insert( item, obstacle );
+    for ( const auto signal : { &QQuickItem::xChanged, &QQuickItem::yChanged,
+                                &QQuickItem::widthChanged, &QQuickItem::heightChanged } )
+        connect( item,  signal,
+                 this,  &OrthogonalRouter::itemGeometryChanged, Qt::UniqueConnection );
+    return obstacle;
+}
+
+void    OrthogonalRouter::addRoute( qan::Edge* edge )
+{
+    const auto edgeItem = edge->getItem();
+    if ( edgeItem == nullptr ||
+         _routes.contains( edge ) )
+        return;
+    // Route edges whose style become orthogonal
+    connect( edgeItem,  &qan::EdgeItem::styleChanged,
+             this,      &OrthogonalRouter::edgeStyleChanged, Qt::UniqueConnection );
+    const auto style = edgeItem->getStyle();
+    if ( style == nullptr )
+        return;
+    connect( style,     &qan::EdgeStyle::lineTypeChanged,
+             this,      &OrthogonalRouter::edgeStyleChanged, Qt::UniqueConnection );
+    if ( style->getLineType() != qan::EdgeStyle::LineType::Ortho ||
+         edgeItem->isHyperEdge() ||
+         qobject_cast<qan::PortItem*>( edgeItem->getSourceItem() ) != nullptr ||
+         qobject_cast<qan::PortItem*>( edgeItem->getDestinationItem() ) != nullptr )
+        return;
+    const auto src = edge->getSrc().lock();
+    const auto dst = edge->getDst().lock();
+    const auto srcObstacle = _obstacles.constFind( src ? static_cast<qan::Node*>( src.get() )->getItem() : nullptr );
+    const auto dstObstacle = _obstacles.constFind( dst ? static_cast<qan::Node*>( dst.get() )->getItem() : nullptr );
+    if ( srcObstacle == _obstacles.constEnd() ||
+         dstObstacle == _obstacles.constEnd() )
+        return;
+    const auto route = _router->addRoute( srcObstacle.value(), dstObstacle.value() );
+    if ( route >= _edges.size() )
+        _edges.resize( route + 1 );
+    _edges[ route ] = edge;
+    _routes.insert( edge, route );
+}
+
+void    OrthogonalRouter::removeRoute( qan::Edge* edge )
+{
+    const auto index = _routes.find( edge );
+    if ( index == _routes.end() )
+        return;
+    _removedRoutes.push_back( index.value() );
+    _edges[ index.value() ] = nullptr;
+    _routes.erase( index );
+    if ( edge->getItem() != nullptr )
+        edge->getItem()->setRoute( QPolygonF{} );
+    scheduleRouting();
+}
+
+QRectF  OrthogonalRouter::itemRect( const QQuickItem* item ) const noexcept
+{
+    const auto containerItem = _graph ? _graph->getContainerItem() : nullptr;
+    const QRectF rect{ 0., 0., item->width(), item->height() };
+    return containerItem != nullptr ? item->mapRectToItem( containerItem, rect ) :
+                                      QRectF{ item->position(), rect.size() };
+}
+//-----------------------------------------------------------------------------
+
+} // ::qan
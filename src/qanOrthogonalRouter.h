@@ -0,0 +1,243 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the QuickQanava software library.
+//
+// \file	qanOrthogonalRouter.h
+// \author	benoit@destrat.io
+// \date	2017 12 29
+//-----------------------------------------------------------------------------
+
+#ifndef qanOrthogonalRouter_h
+#define qanOrthogonalRouter_h
+
+// Std headers
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Qt headers
+#include <QObject>
+#include <QPointer>
+#include <QHash>
+#include <QTimer>
+#include <QFutureWatcher>
+
+// QuickQanava headers
+#include "./qanGraph.h"
+#include "./qanForwardingBehaviour.h"
+
+namespace gtpo {
+class OrthogonalRouter;
+}
+
+namespace qan { // ::qan
+
+/*! \brief Orthogonal routing of graph edges around node and group obstacles, computed in background.
+ *
+ * Router observe \c graph topology with a GTpo graph behaviour and node and group items geometry: edges whose
+ * style line type is qan::EdgeStyle::LineType::Ortho are routed with gtpo::OrthogonalRouter on a worker thread,
+ * computed routes are then applied to edge items with qan::EdgeItem::setRoute() and drawn as polylines.
+ *
+ * Edits are coalesced and routing is incremental: when a node is moved, only its edges and the routes crossing its
+ * previous or new area are routed again. Edits occuring while routes are computed are processed once the running
+ * routing has finished.
+ *
+ * \code
+ *  Qan.OrthogonalRouter {
+ *    graph: graphView.graph
+ *    margin: 15
+ *  }
+ *  // Only edges with an orthogonal style are routed: edgeStyle.lineType = Qan.EdgeStyle.Ortho
+ * \endcode
+ *
+ * \note Hyper edges and edges connected to ports are not routed. Groups are loaded on reset() and when a node
+ * is grouped or ungrouped.
+ */
+class OrthogonalRouter : public QObject
+{
+    /*! \name OrthogonalRouter Object Management *///--------------------------
+    //@{
+    Q_OBJECT
+public:
+    explicit OrthogonalRouter( QObject* parent = nullptr );
+    virtual ~OrthogonalRouter();
+    OrthogonalRouter( const OrthogonalRouter& ) = delete;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Router Configuration *///----------------------------------------
+    //@{
+public:
+    //! Routed graph (default to nullptr).
+    Q_PROPERTY( qan::Graph* graph READ getGraph WRITE setGraph NOTIFY graphChanged FINAL )
+    //! \copydoc graph
+    inline qan::Graph*  getGraph() const noexcept { return _graph.data(); }
+    //! \copydoc graph
+    void                setGraph( qan::Graph* graph ) noexcept;
+private:
+    //! \copydoc graph
+    QPointer<qan::Graph> _graph;
+signals:
+    //! \copydoc graph
+    void                graphChanged();
+
+public:
+    //! Minimum distance between a route and a node or group border (default to 10.).
+    Q_PROPERTY( qreal margin READ getMargin WRITE setMargin NOTIFY marginChanged FINAL )
+    //! \copydoc margin
+    inline qreal    getMargin() const noexcept { return _margin; }
+    //! \copydoc margin
+    void            setMargin( qreal margin ) noexcept;
+private:
+    //! \copydoc margin
+    qreal           _margin{ 10. };
+signals:
+    //! \copydoc margin
+    void            marginChanged();
+
+public:
+    //! Cost of a route bend, expressed as a route length, higher values give routes with fewer bends (default to 40.).
+    Q_PROPERTY( qreal bendPenalty READ getBendPenalty WRITE setBendPenalty NOTIFY bendPenaltyChanged FINAL )
+    //! \copydoc bendPenalty
+    inline qreal    getBendPenalty() const noexcept { return _bendPenalty; }
+    //! \copydoc bendPenalty
+    void            setBendPenalty( qreal bendPenalty ) noexcept;
+private:
+    //! \copydoc bendPenalty
+    qreal           _bendPenalty{ 40. };
+signals:
+    //! \copydoc bendPenalty
+    void            bendPenaltyChanged();
+
+public:
+    //! Distance between parallel overlapping route segments (default to 6.).
+    Q_PROPERTY( qreal nudgeSpacing READ getNudgeSpacing WRITE setNudgeSpacing NOTIFY nudgeSpacingChanged FINAL )
+    //! \copydoc nudgeSpacing
+    inline qreal    getNudgeSpacing() const noexcept { return _nudgeSpacing; }
+    //! \copydoc nudgeSpacing
+    void            setNudgeSpacing( qreal nudgeSpacing ) noexcept;
+private:
+    //! \copydoc nudgeSpacing
+    qreal           _nudgeSpacing{ 6. };
+signals:
+    //! \copydoc nudgeSpacing
+    void            nudgeSpacingChanged();
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Routing Management *///------------------------------------------
+    //@{
+public:
+    //! Reload \c graph actual nodes, groups and orthogonal edges, then route all edges again.
+    Q_INVOKABLE void    reset();
+
+public:
+    //! True while routes are computed in background (read only).
+    Q_PROPERTY( bool running READ getRunning NOTIFY runningChanged FINAL )
+    //! \copydoc running
+    inline bool     getRunning() const noexcept { return _running; }
+private:
+    //! \copydoc running
+    void            setRunning( bool running ) noexcept;
+    //! \copydoc running
+    bool            _running{ false };
+signals:
+    //! \copydoc running
+    void            runningChanged();
+    //! Emitted when modified routes have been computed and applied to edge items.
+    void            finished();
+
+private:
+    friend class qan::ForwardingBehaviour<qan::OrthogonalRouter>;
+    //! Called from \c graph behaviour when a node is inserted (node is not fully initialized yet).
+    void            nodeInserted( qan::Node* node );
+    //! Called from \c graph behaviour before a node is removed.
+    void            nodeRemoved( qan::Node* node );
+    //! Called from \c graph behaviour when an edge is inserted (edge is not fully initialized yet).
+    void            edgeInserted( qan::Edge* edge );
+    //! Called from \c graph behaviour before an edge is removed.
+    void            edgeRemoved( qan::Edge* edge );
+    //! Reinstall \c graph behaviour (destroyed with graph content) and reload empty graph after qan::Graph::clear().
+    void            graphCleared();
+
+    //! Called when an obstacle node or group item is moved or resized.
+    void            itemGeometryChanged();
+    //! Called when an edge item style or style line type is modified.
+    void            edgeStyleChanged();
+    //! Schedule a reset() once running routing has finished (group membership has changed).
+    void            scheduleReset() noexcept;
+
+    //! Schedule processEdits() on next event loop iteration.
+    void            scheduleRouting() noexcept;
+    //! Apply pending edits to router, then start routing dirty routes in background.
+    void            processEdits();
+    //! Called from GUI thread when routing worker has finished, apply modified routes to edge items.
+    void            routingFinished();
+
+    //! Insert \c item as an obstacle inside \c container obstacle and monitor its geometry.
+    std::uint32_t   addObstacle( QQuickItem* item, std::uint32_t container );
+    //! Insert \c edge route if edge is a node to node orthogonal edge.
+    void            addRoute( qan::Edge* edge );
+    //! Remove \c edge route (if any) and restore its straight geometry.
+    void            removeRoute( qan::Edge* edge );
+    //! Return \c item bounding rect in graph container item CS.
+    QRectF          itemRect( const QQuickItem* item ) const noexcept;
+
+private:
+    //! Router, accessed only from the worker thread while routing is running.
+    std::unique_ptr<gtpo::OrthogonalRouter>     _router;
+    //! Obstacles node and group items, in router obstacle index order.
+    std::vector<QPointer<QQuickItem>>           _items;
+    QHash<const QQuickItem*, std::uint32_t>     _obstacles;
+    //! Obstacle contained in every group obstacle (a moved group move its content).
+    QHash<std::uint32_t, std::vector<std::uint32_t>>   _groupContents;
+    //! Routed edges, in router route index order.
+    std::vector<QPointer<qan::Edge>>            _edges;
+    QHash<const qan::Edge*, std::uint32_t>      _routes;
+
+    //! Edits occuring since last processEdits(), applied to router once routing is not running.
+    std::vector<QPointer<qan::Node>>            _insertedNodes;
+    std::vector<QPointer<qan::Edge>>            _insertedEdges;
+    std::vector<std::uint32_t>                  _removedObstacles;
+    std::vector<std::uint32_t>                  _removedRoutes;
+    std::vector<std::uint32_t>                  _movedObstacles;
+    bool                                        _resetPending{ false };
+
+    //! Routes modified by last routing, written from the worker thread while routing is running.
+    std::vector<std::uint32_t>                  _changedRoutes;
+    QTimer                                      _routingTimer;
+    QFutureWatcher<void>                        _routingWatcher;
+    //@}
+    //-------------------------------------------------------------------------
+};
+
+} // ::qan
+
+QML_DECLARE_TYPE( qan::OrthogonalRouter )
+
+#endif // qanOrthogonalRouter_h
@@ -0,0 +1,239 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+//-----------------------------------------------------------------------------
+// This file is a part of the QuickQanava software library.
+//
+// \file	qanOutOfCoreMaterializer.cpp
+// \author	benoit@destrat.io
+// \date	2017 12 10
+//-----------------------------------------------------------------------------
+
+// Std headers
+#include <vector>
+#include <algorithm>
+#include <exception>
+
+// Qt headers
+#include <QUrl>
+#include <QSet>
+
+// QuickQanava headers
+#include "./qanOutOfCoreMaterializer.h"
+#include "./qanNodeItem.h"
+
+namespace qan { // ::qan
+
+/* OutOfCoreMaterializer Object Management *///--------------------------------
+OutOfCoreMaterializer::OutOfCoreMaterializer( QObject* parent ) :
+    QObject{ parent }
+{
+    _updateTimer.setSingleShot( true );
+    _updateTimer.setInterval( 0 );
+    connect( &_updateTimer, &QTimer::timeout,
+             this,          &OutOfCoreMaterializer::update );
+}
+
+OutOfCoreMaterializer::~OutOfCoreMaterializer() { /* _storage unique_ptr destructor must be generated here */ }
+//-----------------------------------------------------------------------------
+
+/* Materializer Configuration *///---------------------------------------------
+void    OutOfCoreMaterializer::setGraph( qan::Graph* graph ) noexcept
+{
+    if ( graph != _graph ) {
+        clear();
+        _graph = graph;
+        emit graphChanged();
+        scheduleUpdate();
+    }
+}
+
+void    OutOfCoreMaterializer::setNavigable( qan::Navigable* navigable ) noexcept
+{
+    if ( navigable != _navigable ) {
+        if ( _navigable )
+            _navigable->disconnect( this );
+        _navigable = navigable;
+        if ( _navigable ) {
+            connect( _navigable,    &qan::Navigable::containerItemModified,
+                     this,          &OutOfCoreMaterializer::scheduleUpdate );
+            connect( _navigable,    &QQuickItem::widthChanged,
+                     this,          &OutOfCoreMaterializer::scheduleUpdate );
+            connect( _navigable,    &QQuickItem::heightChanged,
+                     this,          &OutOfCoreMaterializer::scheduleUpdate );
+        }
+        emit navigableChanged();
+        scheduleUpdate();
+    }
+}
+
+void    OutOfCoreMaterializer::setSource( const QString& source ) noexcept
+{
+    if ( source == _source )
+        return;
+    clear();
+    _storage.reset();
+    _source = source;
+    if ( !source.isEmpty() ) {
+        const QUrl url{ source };
+        const auto basePath = url.isLocalFile() ? url.toLocalFile() : source;
+        try {
+            _storage = std::make_unique<gtpo::OutOfCoreGraph>( basePath.toStdString() );
+        } catch ( const std::exception& e ) {
+            qWarning() << "qan::OutOfCoreMaterializer::setSource(): Error: " << e.what();
+        }
+    }
+    emit sourceChanged();
+    scheduleUpdate();
+}
+
+void    OutOfCoreMaterializer::setMaxNodes( int maxNodes ) noexcept
+{
+    if ( maxNodes != _maxNodes ) {
+        _maxNodes = std::max( 0, maxNodes );
+        emit maxNodesChanged();
+        scheduleUpdate();
+    }
+}
+//-----------------------------------------------------------------------------
+
+/* Materialization Management *///---------------------------------------------
+qint64  OutOfCoreMaterializer::getStorageNodeCount() const noexcept
+{
+    return _storage ? static_cast<qint64>( _storage->getNodeCount() ) : 0;
+}
+
+void    OutOfCoreMaterializer::update()
+{
+    if ( !_graph || !_navigable || !_storage ) {
+        clear();
+        return;
+    }
+    const auto containerItem = _navigable->getContainerItem();
+    if ( containerItem == nullptr )
+        return;
+    const auto viewport = containerItem->mapRectFromItem( _navigable, _navigable->boundingRect() );
+    gtpo::OutOfCoreGraph::Rect rect;
+    rect.x = static_cast<float>( viewport.x() );
+    rect.y = static_cast<float>( viewport.y() );
+    rect.width = static_cast<float>( viewport.width() );
+    rect.height = static_cast<float>( viewport.height() );
+
+    _graph->beginBatchUpdate();
+    try {
+        const auto visibleIds = _storage->getNodesIn( rect, static_cast<std::size_t>( _maxNodes ) );
+        QSet<quint64> visible;
+        visible.reserve( static_cast<int>( visibleIds.size() ) );
+        for ( const auto id : visibleIds )
+            visible.insert( id );
+
+        // Remove nodes that have left the viewport (their edges are removed with them)
+        for ( auto node = _nodes.begin(); node != _nodes.end(); ) {
+            if ( !node.value() ) {                      // Node has been removed from graph by user
+                node = _nodes.erase( node );
+            } else if ( !visible.contains( node.key() ) ) {
+                _graph->removeNode( node.value().data() );
+                node = _nodes.erase( node );
+            } else
+                ++node;
+        }
+
+        // Materialize nodes entering the viewport
+        std::vector<quint64> inserted;
+        QSet<quint64> insertedSet;
+        for ( const auto id : visibleIds ) {
+            if ( _nodes.contains( id ) )
+                continue;
+            auto node = _graph->insertNode();
+            if ( node == nullptr )
+                continue;
+            node->setLabel( QString::number( id ) );
+            const auto position = _storage->getPosition( id );
+            node->setGeometry( QRectF{ QPointF{ position.x, position.y },    // Also valid while node item is incubated
+                                       node->getGeometry().size() } );
+            _nodes.insert( id, node );
+            inserted.push_back( id );
+            insertedSet.insert( id );
+        }
+
+        // Connect inserted nodes: out edges to any materialized node, in edges only from previously
+        // materialized nodes (edges between two inserted nodes are created from their source out edges).
+        for ( const auto id : inserted ) {
+            auto node = _nodes.value( id ).data();
+            for ( const auto target : _storage->getOutNodes( id ) ) {
+                auto targetNode = _nodes.value( target ).data();
+                if ( targetNode != nullptr &&
+                     !_graph->hasEdge( node, targetNode ) )
+                    _graph->insertEdge( node, targetNode );
+            }
+            for ( const auto source : _storage->getInNodes( id ) ) {
+                if ( insertedSet.contains( source ) )
+                    continue;
+                auto sourceNode = _nodes.value( source ).data();
+                if ( sourceNode != nullptr &&
+                     !_graph->hasEdge( sourceNode, node ) )
+                    _graph->insertEdge( sourceNode, node );
+            }
+        }
+    } catch ( const std::exception& e ) {
+        qWarning() << "qan::OutOfCoreMaterializer::update(): Error: " << e.what();
+    }
+    _graph->endBatchUpdate();
+    emit materialized();
+}
+
+void    OutOfCoreMaterializer::clear()
+{
+    if ( _nodes.isEmpty() )
+        return;
+    if ( _graph ) {
+        _graph->beginBatchUpdate();
+        for ( const auto& node : _nodes )
+            if ( node )
+                _graph->removeNode( node.data() );
+        _graph->endBatchUpdate();
+    }
+    _nodes.clear();
+    emit materialized();
+}
+
+qint64  OutOfCoreMaterializer::getNodeId( qan::Node* node ) const noexcept
+{
+    for ( auto materialized = _nodes.cbegin(); materialized != _nodes.cend(); ++materialized )
+        if ( materialized.value() == node )
+            return static_cast<qint64>( materialized.key() );
+    return -1;
+}
+
+void    OutOfCoreMaterializer::scheduleUpdate() noexcept
+{
+    if ( !_updateTimer.isActive() )
+        _updateTimer.start();
+}
+//-----------------------------------------------------------------------------
+
+} // ::qan
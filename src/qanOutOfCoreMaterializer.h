@@ -0,0 +1,188 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+//-----------------------------------------------------------------------------
+// This file is a part of the QuickQanava software library.
+//
+// \file	qanOutOfCoreMaterializer.h
+// \author	benoit@destrat.io
+// \date	2017 12 10
+//-----------------------------------------------------------------------------
+
+#ifndef qanOutOfCoreMaterializer_h
+#define qanOutOfCoreMaterializer_h
+
+// Std headers
+#include <memory>
+
+// Qt headers
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+#include <QHash>
+
+// GTpo headers
+#include <gtpoOutOfCoreGraph.h>
+
+// QuickQanava headers
+#include "./qanGraph.h"
+#include "./qanNavigable.h"
+
+namespace qan { // ::qan
+
+/*! \brief Materialize the visible part of a gtpo::OutOfCoreGraph storage in a qan::Graph.
+ *
+ * Out-of-core storage might be much larger than RAM, only nodes whose position lies in \c navigable viewport
+ * (at most \c maxNodes) are inserted in \c graph, with edges between materialized nodes. Nodes leaving the
+ * viewport are removed from graph when the view is panned or zoomed.
+ *
+ * Storage is generated with gtpo::OutOfCoreGraphBuilder, \c source is the storage base path.
+ *
+ * \code
+ *  Qan.OutOfCoreMaterializer {
+ *    graph: graphView.graph
+ *    navigable: graphView
+ *    source: "/data/capture"
+ *    maxNodes: 2000
+ *  }
+ * \endcode
+ */
+class OutOfCoreMaterializer : public QObject
+{
+    /*! \name OutOfCoreMaterializer Object Management *///---------------------
+    //@{
+    Q_OBJECT
+public:
+    explicit OutOfCoreMaterializer( QObject* parent = nullptr );
+    virtual ~OutOfCoreMaterializer();
+    OutOfCoreMaterializer( const OutOfCoreMaterializer& ) = delete;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Materializer Configuration *///----------------------------------
+    //@{
+public:
+    //! Target graph, materialized nodes and edges are inserted in \c graph (default to nullptr).
+    Q_PROPERTY( qan::Graph* graph READ getGraph WRITE setGraph NOTIFY graphChanged FINAL )
+    //! \copydoc graph
+    inline qan::Graph*  getGraph() const noexcept { return _graph.data(); }
+    //! \copydoc graph
+    void                setGraph( qan::Graph* graph ) noexcept;
+private:
+    //! \copydoc graph
+    QPointer<qan::Graph> _graph;
+signals:
+    //! \copydoc graph
+    void                graphChanged();
+
+public:
+    //! Navigable area whose viewport define materialized nodes, usually graph view (default to nullptr).
+    Q_PROPERTY( qan::Navigable* navigable READ getNavigable WRITE setNavigable NOTIFY navigableChanged FINAL )
+    //! \copydoc navigable
+    inline qan::Navigable*  getNavigable() const noexcept { return _navigable.data(); }
+    //! \copydoc navigable
+    void                    setNavigable( qan::Navigable* navigable ) noexcept;
+private:
+    //! \copydoc navigable
+    QPointer<qan::Navigable> _navigable;
+signals:
+    //! \copydoc navigable
+    void                    navigableChanged();
+
+public:
+    //! Out-of-core storage base path (local file urls are supported), empty to close storage.
+    Q_PROPERTY( QString source READ getSource WRITE setSource NOTIFY sourceChanged FINAL )
+    //! \copydoc source
+    inline QString  getSource() const noexcept { return _source; }
+    //! \copydoc source
+    void            setSource( const QString& source ) noexcept;
+private:
+    //! \copydoc source
+    QString         _source{};
+signals:
+    //! \copydoc source
+    void            sourceChanged();
+
+public:
+    //! Maximum number of simultaneously materialized nodes (default to 2000).
+    Q_PROPERTY( int maxNodes READ getMaxNodes WRITE setMaxNodes NOTIFY maxNodesChanged FINAL )
+    //! \copydoc maxNodes
+    inline int      getMaxNodes() const noexcept { return _maxNodes; }
+    //! \copydoc maxNodes
+    void            setMaxNodes( int maxNodes ) noexcept;
+private:
+    //! \copydoc maxNodes
+    int             _maxNodes{ 2000 };
+signals:
+    //! \copydoc maxNodes
+    void            maxNodesChanged();
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Materialization Management *///----------------------------------
+    //@{
+public:
+    //! Total node count in storage (read only).
+    Q_PROPERTY( qint64 storageNodeCount READ getStorageNodeCount NOTIFY sourceChanged FINAL )
+    //! \copydoc storageNodeCount
+    qint64          getStorageNodeCount() const noexcept;
+
+    //! Number of actually materialized nodes (read only).
+    Q_PROPERTY( int nodeCount READ getNodeCount NOTIFY materialized FINAL )
+    //! \copydoc nodeCount
+    inline int      getNodeCount() const noexcept { return _nodes.size(); }
+
+    //! Synchronize materialized nodes with current viewport (called automatically on navigable pan/zoom/resize).
+    Q_INVOKABLE void    update();
+    //! Remove all materialized nodes from graph.
+    Q_INVOKABLE void    clear();
+
+    //! Return storage node id for a materialized \c node, or -1 if \c node has not been materialized.
+    Q_INVOKABLE qint64  getNodeId( qan::Node* node ) const noexcept;
+
+signals:
+    //! Emitted once materialized nodes have been synchronized with viewport.
+    void                materialized();
+
+private:
+    //! Schedule an update() on next event loop iteration, multiple pan/zoom events are coalesced in one update.
+    void                scheduleUpdate() noexcept;
+
+private:
+    std::unique_ptr<gtpo::OutOfCoreGraph>       _storage;
+    //! Materialized nodes indexed by storage node id.
+    QHash<quint64, QPointer<qan::Node>>         _nodes;
+    QTimer                                      _updateTimer;
+    //@}
+    //-------------------------------------------------------------------------
+};
+
+} // ::qan
+
+QML_DECLARE_TYPE( qan::OutOfCoreMaterializer )
+
+#endif // qanOutOfCoreMaterializer_h
@@ -0,0 +1,87 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the QuickQanava software library.
+//
+// \file	qanRecyclable.h
+// \author	benoit@destrat.io
+// \date	2017 12 14
+//-----------------------------------------------------------------------------
+
+#ifndef qanRecyclable_h
+#define qanRecyclable_h
+
+// Qt headers
+#include <QObject>      // Q_DECLARE_INTERFACE
+
+namespace qan { // ::qan
+
+/*! \brief Interface for a graph primitive item that could be stored in a qan::ItemPool and reused for another primitive.
+ *
+ * C++ reset hooks, QML delegates should reset their own state from qan::ItemPool \c pooled() and \c reused()
+ * attached signals.
+ *
+ * \nosubgrouping
+ */
+class Recyclable
+{
+    /*! \name Recyclable Object Management *///--------------------------------
+    //@{
+public:
+    Recyclable() = default;
+    virtual ~Recyclable() = default;
+    Recyclable( const Recyclable& ) = delete;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Recycling Management *///----------------------------------------
+    //@{
+public:
+    //! Return false if item state could not be reset (it is then destroyed instead of being pooled), default to true.
+    virtual bool    isRecyclable() const noexcept { return true; }
+
+    /*! \brief Called when item is stored in a pool, after it has been detached from its primitive and graph container item.
+     *
+     * Reset transient state (selection, dragging, primitive and topology references) there, configuration
+     * properties (style, draggable, resizable, etc.) are left unchanged.
+     */
+    virtual void    itemPooled() noexcept { }
+
+    //! Called when item is taken from a pool, once it has been configured for its new primitive.
+    virtual void    itemReused() noexcept { }
+    //@}
+    //-------------------------------------------------------------------------
+};
+
+} // ::qan
+
+Q_DECLARE_INTERFACE(
+    qan::Recyclable,
+    "com.destrat.io.QuickQanava.Recyclable/3.0"
+)
+
+#endif // qanRecyclable_h
@@ -0,0 +1,492 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the QuickQanava software library.
+//
+// \file	qanSceneSerializer.cpp
+// \author	benoit@destrat.io
+// \date	2017 12 08
+//-----------------------------------------------------------------------------
+
+// Std headers
+#include <vector>
+
+// Qt headers
+#include <QFile>
+#include <QUrl>
+#include <QHash>
+#include <QVector>
+#include <QDataStream>
+
+// QuickQanava headers
+#include "./qanSceneSerializer.h"
+#include "./qanNodeItem.h"
+#include "./qanPortItem.h"
+#include "./qanEdgeItem.h"
+#include "./qanGroupItem.h"
+
+namespace qan { // ::qan
+
+namespace { // ::qan::anonymous
+
+//! Scene file magic number ("QANS").
+constexpr quint32   sceneMagic{ 0x51414E53 };
+//! Current scene format version (version 2 add group size, group nesting and edge port end points).
+constexpr quint16   sceneVersion{ 2 };
+
+//! Kind of a serialized style, used to resolve style references in target graph.
+enum class StyleKind : quint8 {
+    Style       = 0,
+    NodeStyle   = 1,
+    EdgeStyle   = 2
+};
+
+inline StyleKind    styleKind( const qan::Style* style ) noexcept
+{
+    if ( qobject_cast<const qan::NodeStyle*>( style ) != nullptr )
+        return StyleKind::NodeStyle;
+    if ( qobject_cast<const qan::EdgeStyle*>( style ) != nullptr )
+        return StyleKind::EdgeStyle;
+    return StyleKind::Style;
+}
+
+inline QString      toLocalFile( const QString& fileName )
+{
+    const QUrl url{ fileName };
+    return url.isLocalFile() ? url.toLocalFile() : fileName;
+}
+
+//! Return all ports items of \c nodeItem, either docked or directly parented to node item.
+std::vector<qan::PortItem*> nodePorts( qan::NodeItem& nodeItem )
+{
+    std::vector<qan::PortItem*> ports;
+    const auto collectPorts = [&ports, &nodeItem]( QQuickItem* parent ) {
+        if ( parent == nullptr )
+            return;
+        for ( const auto child : parent->childItems() ) {
+            const auto portItem = qobject_cast<qan::PortItem*>( child );
+            if ( portItem != nullptr &&
+                 portItem->getNode() == nodeItem.getNode() )
+                ports.push_back( portItem );
+        }
+    };
+    collectPorts( &nodeItem );
+    for ( const auto dock : { qan::NodeItem::Dock::Left, qan::NodeItem::Dock::Top,
+                              qan::NodeItem::Dock::Right, qan::NodeItem::Dock::Bottom } )
+        collectPorts( nodeItem.getDock( dock ) );
+    return ports;
+}
+
+} // ::qan::anonymous
+
+/* SceneSerializer Object Management *///--------------------------------------
+SceneSerializer::SceneSerializer( QObject* parent ) :
+    QObject{ parent }
+{
+}
+//-----------------------------------------------------------------------------
+
+/* Scene Serialization *///----------------------------------------------------
+bool    SceneSerializer::save( qan::Graph* graph, const QString& fileName )
+{
+    if ( graph == nullptr ) {
+        setErrorString( QStringLiteral( "Invalid nullptr graph." ) );
+        return false;
+    }
+    QFile file{ toLocalFile( fileName ) };
+    if ( !file.open( QIODevice::WriteOnly | QIODevice::Truncate ) ) {
+        setErrorString( QStringLiteral( "Can't open " ) + file.fileName() + QStringLiteral( ": " ) + file.errorString() );
+        return false;
+    }
+    return save( *graph, file );
+}
+
+bool    SceneSerializer::restore( qan::Graph* graph, const QString& fileName )
+{
+    if ( graph == nullptr ) {
+        setErrorString( QStringLiteral( "Invalid nullptr graph." ) );
+        return false;
+    }
+    QFile file{ toLocalFile( fileName ) };
+    if ( !file.open( QIODevice::ReadOnly ) ) {
+        setErrorString( QStringLiteral( "Can't open " ) + file.fileName() + QStringLiteral( ": " ) + file.errorString() );
+        return false;
+    }
+    return restore( *graph, file );
+}
+
+bool    SceneSerializer::save( qan::Graph& graph, QIODevice& device )
+{
+    // Collect referenced styles, they are saved first to be resolved before primitives creation at restore
+    QVector<qan::Style*>                styles;
+    QHash<const qan::Style*, qint32>    styleIds;
+    const auto styleId = [&styles, &styleIds]( qan::Style* style ) -> qint32 {
+        if ( style == nullptr )
+            return -1;
+        const auto id = styleIds.constFind( style );
+        if ( id != styleIds.constEnd() )
+            return id.value();
+        const auto newId = static_cast<qint32>( styles.size() );
+        styles.append( style );
+        styleIds.insert( style, newId );
+        return newId;
+    };
+    for ( const auto& group : graph.getGroups() )
+        if ( group && group->getItem() != nullptr )
+            styleId( group->getItem()->getStyle() );
+    for ( const auto& node : graph.getNodes() )
+        if ( node && node->getItem() != nullptr )
+            styleId( node->getItem()->getStyle() );
+    for ( const auto& edge : graph.getEdges() )
+        if ( edge && edge->getItem() != nullptr )
+            styleId( edge->getItem()->getStyle() );
+
+    QDataStream out{ &device };
+    out.setVersion( QDataStream::Qt_5_9 );
+    out.setFloatingPointPrecision( QDataStream::SinglePrecision );
+    out << sceneMagic << sceneVersion;
+
+    out << static_cast<qint32>( styles.size() );
+    for ( const auto style : styles )
+        out << style->getName() << static_cast<quint8>( styleKind( style ) );
+
+    // Groups: label, parent group, geometry (in parent group coordinate system), collapsed state and style
+    QHash<const qan::Group*, qint32> groupIds;
+    for ( const auto& group : graph.getGroups() )
+        groupIds.insert( group.get(), groupIds.size() );
+    out << static_cast<qint32>( graph.getGroups().size() );
+    for ( const auto& group : graph.getGroups() ) {
+        const auto groupItem = group->getItem();
+        out << group->getLabel() << static_cast<bool>( groupItem != nullptr )
+            << groupIds.value( group->getGroup().lock().get(), -1 );
+        if ( groupItem != nullptr )
+            out << groupItem->x() << groupItem->y() << groupItem->z()
+                << groupItem->width() << groupItem->height()
+                << groupItem->getCollapsed() << styleId( groupItem->getStyle() );
+    }
+
+    // Nodes: label, geometry (in parent group coordinate system), group, style and ports
+    QHash<const qan::Node*, qint32> nodeIds;
+    QHash<const qan::PortItem*, qint16> portIds;   // Port index in its node ports
+    out << static_cast<qint32>( graph.getNodes().size() );
+    for ( const auto& node : graph.getNodes() ) {
+        nodeIds.insert( node.get(), nodeIds.size() );
+        const auto nodeItem = node->getItem();
+        const auto group = node->getGroup().lock();
+        out << node->getLabel() << static_cast<bool>( nodeItem != nullptr )
+            << groupIds.value( group.get(), -1 );
+        if ( nodeItem == nullptr )
+            continue;
+        out << nodeItem->x() << nodeItem->y() << nodeItem->z()
+            << nodeItem->width() << nodeItem->height()
+            << styleId( nodeItem->getStyle() );
+        const auto ports = nodePorts( *nodeItem );
+        out << static_cast<quint16>( ports.size() );
+        for ( std::size_t p = 0; p < ports.size(); ++p ) {
+            const auto port = ports[p];
+            portIds.insert( port, static_cast<qint16>( p ) );
+            out << static_cast<quint8>( port->getDockType() )
+                << static_cast<quint8>( port->getType() )
+                << port->getLabel();
+        }
+    }
+
+    // Edges: source and destination node ids, label, weight, style and source and destination ports (hyper edges are ignored)
+    std::vector<qan::Edge*> edges;
+    edges.reserve( static_cast<std::size_t>( graph.getEdgeCount() ) );
+    for ( const auto& edge : graph.getEdges() ) {
+        if ( edge &&
+             nodeIds.contains( edge->getSrc().lock().get() ) &&
+             nodeIds.contains( edge->getDst().lock().get() ) )
+            edges.push_back( edge.get() );
+    }
+    out << static_cast<qint32>( edges.size() );
+    for ( const auto edge : edges ) {
+        const auto edgeItem = edge->getItem();
+        out << nodeIds.value( edge->getSrc().lock().get() )
+            << nodeIds.value( edge->getDst().lock().get() )
+            << edge->getLabel() << edge->getWeight()
+            << static_cast<bool>( edgeItem != nullptr );
+        if ( edgeItem != nullptr )
+            out << styleId( edgeItem->getStyle() )
+                << portIds.value( qobject_cast<qan::PortItem*>( edgeItem->getSourceItem() ), -1 )
+                << portIds.value( qobject_cast<qan::PortItem*>( edgeItem->getDestinationItem() ), -1 );
+    }
+
+    if ( out.status() != QDataStream::Ok ) {
+        setErrorString( QStringLiteral( "Error while writing scene: " ) + device.errorString() );
+        return false;
+    }
+    setErrorString( QString{} );
+    return true;
+}
+
+bool    SceneSerializer::restore( qan::Graph& graph, QIODevice& device )
+{
+    QDataStream in{ &device };
+    in.setVersion( QDataStream::Qt_5_9 );
+    in.setFloatingPointPrecision( QDataStream::SinglePrecision );
+
+    quint32 magic{ 0 };
+    quint16 version{ 0 };
+    in >> magic >> version;
+    if ( magic != sceneMagic ) {
+        setErrorString( QStringLiteral( "Input is not a QuickQanava scene." ) );
+        return false;
+    }
+    if ( version > sceneVersion ) {
+        setErrorString( QStringLiteral( "Unsupported scene version %1." ).arg( version ) );
+        return false;
+    }
+    const auto streamError = [this, &in]() {
+        if ( in.status() == QDataStream::Ok )
+            return false;
+        setErrorString( QStringLiteral( "Scene is truncated or corrupted." ) );
+        return true;
+    };
+    const auto checkCount = [this]( qint32 count ) {
+        if ( count >= 0 )
+            return true;
+        setErrorString( QStringLiteral( "Scene is corrupted (invalid primitive count)." ) );
+        return false;
+    };
+
+    // Resolve style references by name and kind in graph style manager and default primitives styles
+    qint32 styleCount{ 0 };
+    in >> styleCount;
+    if ( streamError() || !checkCount( styleCount ) )
+        return false;
+    std::vector<qan::Style*> candidates;
+    for ( const auto style : graph.getStyleManager()->getStyles() )
+        candidates.push_back( qobject_cast<qan::Style*>( style ) );
+    candidates.push_back( qan::Node::style() );
+    candidates.push_back( qan::Edge::style() );
+    candidates.push_back( qan::Group::style() );
+    std::vector<qan::Style*> styles;
+    styles.reserve( static_cast<std::size_t>( styleCount ) );
+    for ( qint32 s = 0; s < styleCount; ++s ) {
+        QString name;
+        quint8  kind{ 0 };
+        in >> name >> kind;
+        if ( streamError() )
+            return false;
+        qan::Style* resolved{ nullptr };
+        for ( const auto candidate : candidates )
+            if ( candidate != nullptr &&
+                 candidate->getName() == name &&
+                 static_cast<quint8>( styleKind( candidate ) ) == kind ) {
+                resolved = candidate;
+                break;
+            }
+        styles.push_back( resolved );
+    }
+    const auto style = [&styles]( qint32 id ) -> qan::Style* {
+        return id >= 0 && static_cast<std::size_t>( id ) < styles.size() ? styles[static_cast<std::size_t>( id )] : nullptr;
+    };
+
+    // Edges geometry is updated once at the end of restoration
+    graph.beginBatchUpdate();
+    const auto restored = [&]() -> bool {
+        qint32 groupCount{ 0 };
+        in >> groupCount;
+        if ( streamError() || !checkCount( groupCount ) )
+            return false;
+        std::vector<qan::Group*> groups;
+        std::vector<qint32> parentIds;
+        groups.reserve( static_cast<std::size_t>( groupCount ) );
+        for ( qint32 g = 0; g < groupCount; ++g ) {
+            QString label;
+            bool    hasItem{ false };
+            qint32  parentId{ -1 };
+            qreal   x{ 0. }, y{ 0. }, z{ 0. }, width{ -1. }, height{ -1. };
+            bool    collapsed{ false };
+            qint32  styleId{ -1 };
+            in >> label >> hasItem;
+            if ( version >= 2 )
+                in >> parentId;
+            if ( hasItem ) {
+                in >> x >> y >> z;
+                if ( version >= 2 )
+                    in >> width >> height;
+                in >> collapsed >> styleId;
+            }
+            if ( streamError() )
+                return false;
+            const auto group = graph.insertGroup();
+            groups.push_back( group );
+            parentIds.push_back( parentId );
+            if ( group == nullptr )
+                continue;
+            group->setLabel( label );
+            const auto groupItem = group->getItem();
+            if ( groupItem != nullptr ) {
+                if ( style( styleId ) != nullptr )
+                    groupItem->setStyle( style( styleId ) );
+                groupItem->setPosition( QPointF{ x, y } );
+                groupItem->setZ( z );
+                if ( width >= 0. && height >= 0. )
+                    groupItem->setSize( QSizeF{ width, height } );
+                groupItem->setCollapsed( collapsed );
+            }
+        }
+        // Groups are nested once all groups are created, saved position is already in parent group coordinate system
+        for ( std::size_t g = 0; g < groups.size(); ++g ) {
+            const auto parentId = parentIds[g];
+            if ( parentId >= 0 &&
+                 static_cast<std::size_t>( parentId ) < groups.size() &&
+                 groups[g] != nullptr )
+                graph.groupNode( groups[static_cast<std::size_t>( parentId )], groups[g], false );
+        }
+
+        qint32 nodeCount{ 0 };
+        in >> nodeCount;
+        if ( streamError() || !checkCount( nodeCount ) )
+            return false;
+        std::vector<qan::Node*> nodes;
+        nodes.reserve( static_cast<std::size_t>( nodeCount ) );
+        std::vector<std::vector<qan::PortItem*>> ports;     // Restored ports in saved order, indexed by node
+        ports.reserve( static_cast<std::size_t>( nodeCount ) );
+        for ( qint32 n = 0; n < nodeCount; ++n ) {
+            QString label;
+            bool    hasItem{ false };
+            qint32  groupId{ -1 };
+            in >> label >> hasItem >> groupId;
+            if ( streamError() )
+                return false;
+            const auto node = hasItem ? graph.insertNode() :
+                                        graph.insertNonVisualNode<qan::Node>();
+            nodes.push_back( node );
+            ports.emplace_back();
+            if ( node != nullptr )
+                node->setLabel( label );
+            const auto group = groupId >= 0 && static_cast<std::size_t>( groupId ) < groups.size() ?
+                                   groups[static_cast<std::size_t>( groupId )] : nullptr;
+            if ( node != nullptr && group != nullptr )
+                graph.groupNode( group, node, false );  // Saved position is already in group coordinate system
+            if ( !hasItem )
+                continue;
+            qreal   x{ 0. }, y{ 0. }, z{ 0. }, width{ 0. }, height{ 0. };
+            qint32  styleId{ -1 };
+            quint16 portCount{ 0 };
+            in >> x >> y >> z >> width >> height >> styleId >> portCount;
+            if ( streamError() )
+                return false;
+            const auto nodeItem = node != nullptr ? node->getItem() : nullptr;
+            if ( nodeItem != nullptr ) {
+                const auto nodeStyle = qobject_cast<qan::NodeStyle*>( style( styleId ) );
+                if ( nodeStyle != nullptr )
+                    nodeItem->setStyle( nodeStyle );
+                nodeItem->setPosition( QPointF{ x, y } );
+                nodeItem->setZ( z );
+                nodeItem->setSize( QSizeF{ width, height } );
+            }
+            for ( quint16 p = 0; p < portCount; ++p ) {
+                quint8  dock{ 0 }, type{ 0 };
+                QString portLabel;
+                in >> dock >> type >> portLabel;
+                if ( streamError() )
+                    return false;
+                ports.back().push_back( nullptr );
+                if ( node == nullptr ||
+                     dock > static_cast<quint8>( qan::NodeItem::Dock::Bottom ) )
+                    continue;
+                const auto dockType = static_cast<qan::NodeItem::Dock>( dock );
+                const auto portItem = type == static_cast<quint8>( qan::PortItem::Type::Out ) ?
+                                          graph.insertOutPort( node, dockType, portLabel ) :
+                                          graph.insertInPort( node, dockType, portLabel );
+                if ( portItem != nullptr )
+                    portItem->setType( static_cast<qan::PortItem::Type>( type ) );
+                ports.back().back() = portItem;
+            }
+        }
+
+        qint32 edgeCount{ 0 };
+        in >> edgeCount;
+        if ( streamError() || !checkCount( edgeCount ) )
+            return false;
+        for ( qint32 e = 0; e < edgeCount; ++e ) {
+            qint32  srcId{ -1 }, dstId{ -1 };
+            QString label;
+            qreal   weight{ 1. };
+            bool    hasItem{ false };
+            qint32  styleId{ -1 };
+            qint16  srcPort{ -1 }, dstPort{ -1 };
+            in >> srcId >> dstId >> label >> weight >> hasItem;
+            if ( hasItem )
+                in >> styleId;
+            if ( hasItem && version >= 2 )
+                in >> srcPort >> dstPort;
+            if ( streamError() )
+                return false;
+            if ( srcId < 0 || static_cast<std::size_t>( srcId ) >= nodes.size() ||
+                 dstId < 0 || static_cast<std::size_t>( dstId ) >= nodes.size() ) {
+                setErrorString( QStringLiteral( "Scene is corrupted (invalid edge node reference)." ) );
+                return false;
+            }
+            const auto src = nodes[static_cast<std::size_t>( srcId )];
+            const auto dst = nodes[static_cast<std::size_t>( dstId )];
+            if ( src == nullptr || dst == nullptr )
+                continue;
+            const auto edge = hasItem && src->getItem() != nullptr && dst->getItem() != nullptr ?
+                                  graph.insertEdge( src, dst ) :
+                                  graph.insertNonVisualEdge<qan::Edge>( *src, dst );
+            if ( edge == nullptr )
+                continue;
+            edge->setLabel( label );
+            edge->setWeight( weight );
+            const auto edgeStyle = qobject_cast<qan::EdgeStyle*>( style( styleId ) );
+            if ( edgeStyle != nullptr &&
+                 edge->getItem() != nullptr )
+                edge->getItem()->setStyle( edgeStyle );
+            const auto port = [&ports]( qint32 nodeId, qint16 portId ) -> qan::PortItem* {
+                const auto& nodePorts = ports[static_cast<std::size_t>( nodeId )];
+                return portId >= 0 && static_cast<std::size_t>( portId ) < nodePorts.size() ?
+                           nodePorts[static_cast<std::size_t>( portId )] : nullptr;
+            };
+            graph.bindEdgeSource( edge, port( srcId, srcPort ) );       // Ignored for nullptr ports
+            graph.bindEdgeDestination( edge, port( dstId, dstPort ) );
+        }
+        return true;
+    }();
+    graph.endBatchUpdate();
+    if ( restored )
+        setErrorString( QString{} );
+    return restored;
+}
+
+void    SceneSerializer::setErrorString( const QString& errorString ) noexcept
+{
+    if ( errorString != _errorString ) {
+        _errorString = errorString;
+        emit errorStringChanged();
+    }
+    if ( !errorString.isEmpty() )
+        qWarning() << "qan::SceneSerializer: Error:" << errorString;
+}
+//-----------------------------------------------------------------------------
+
+} // ::qan
@@ -0,0 +1,114 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the QuickQanava software library.
+//
+// \file	qanSceneSerializer.h
+// \author	benoit@destrat.io
+// \date	2017 12 08
+//-----------------------------------------------------------------------------
+
+#ifndef qanSceneSerializer_h
+#define qanSceneSerializer_h
+
+// Qt headers
+#include <QObject>
+#include <QIODevice>
+
+// QuickQanava headers
+#include "./qanGraph.h"
+
+namespace qan { // ::qan
+
+/*! \brief Compact binary save/restore of a qan::Graph visual scene.
+ *
+ * Scene format store graph topology (nodes, edges, groups) with node and group geometry, group membership,
+ * group nesting, port docks, edge port end points and style references. Styles are referenced by name and
+ * resolved in target graph style manager at restore time (primitives with unresolved styles keep their default style).
+ *
+ * Restoration is done in one batched pass: groups are created and nested first, then nodes are created with their
+ * geometry, group and ports before edges are connected and bound to their ports. Edge geometry updates and graph
+ * models notifications are suspended with qan::Graph::beginBatchUpdate() until the whole scene has been restored,
+ * views then observe a single model reset.
+ *
+ * \note Only default node, edge and group delegates are restored, hyper edges are not serialized.
+ *
+ * \code
+ *  Qan.SceneSerializer { id: serializer }
+ *  // serializer.save( graph, "scene.qan" )
+ *  // serializer.restore( graph, "scene.qan" )
+ * \endcode
+ */
+class SceneSerializer : public QObject
+{
+    /*! \name SceneSerializer Object Management *///---------------------------
+    //@{
+    Q_OBJECT
+public:
+    explicit SceneSerializer( QObject* parent = nullptr );
+    virtual ~SceneSerializer() { /* Nil */ }
+    SceneSerializer( const SceneSerializer& ) = delete;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Scene Serialization *///-----------------------------------------
+    //@{
+public:
+    //! Save \c graph scene to \c fileName (local file urls are supported), return false on error.
+    Q_INVOKABLE bool    save( qan::Graph* graph, const QString& fileName );
+
+    //! Restore scene saved in \c fileName in \c graph (content is added to existing graph content), return false on error.
+    Q_INVOKABLE bool    restore( qan::Graph* graph, const QString& fileName );
+
+    //! Save \c graph scene to an open \c device.
+    bool                save( qan::Graph& graph, QIODevice& device );
+
+    //! Restore scene from an open \c device in \c graph, content restored before an error occurs is not removed.
+    bool                restore( qan::Graph& graph, QIODevice& device );
+
+public:
+    //! Description of the last save or restore error (read only).
+    Q_PROPERTY( QString errorString READ getErrorString NOTIFY errorStringChanged FINAL )
+    //! \copydoc errorString
+    inline QString  getErrorString() const noexcept { return _errorString; }
+private:
+    //! \copydoc errorString
+    void            setErrorString( const QString& errorString ) noexcept;
+    //! \copydoc errorString
+    QString         _errorString{};
+signals:
+    //! \copydoc errorString
+    void            errorStringChanged();
+    //@}
+    //-------------------------------------------------------------------------
+};
+
+} // ::qan
+
+QML_DECLARE_TYPE( qan::SceneSerializer )
+
+#endif // qanSceneSerializer_h
@@ -42,9 +42,13 @@ namespace qan { // ::qan
 Selectable::Selectable() { /* Nil */ }
 
 Selectable::~Selectable() {
-    if ( _selectionItem &&  // Delete selection item if it has Cpp ownership
-         QQmlEngine::objectOwnership(_selectionItem.data()) == QQmlEngine::CppOwnership )
-        _selectionItem->deleteLater();
+    if ( _selectionItem &&  // Recycle (or delete) selection item if it has Cpp ownership
+         QQmlEngine::objectOwnership(_selectionItem.data()) == QQmlEngine::CppOwnership ) {
+        if ( _graph )
+            _graph->recycleSelectionItem(_selectionItem.data());
+        else
+            _selectionItem->deleteLater();
+    }
 }
 
 void    Selectable::configure(QQuickItem* target, qan::Graph* graph)
@@ -102,8 +106,12 @@ void    Selectable::setSelectionItem( QQuickItem* selectionItem ) noexcept
             _selectionItem->setParentItem(nullptr); // Force QML garbage collection
             _selectionItem->setEnabled(false);      // Disable and hide item in case it is not
             _selectionItem->setVisible(false);      // immediately destroyed or garbage collected
-            if ( QQmlEngine::objectOwnership(_selectionItem.data()) == QQmlEngine::CppOwnership )
-                _selectionItem->deleteLater();
+            if ( QQmlEngine::objectOwnership(_selectionItem.data()) == QQmlEngine::CppOwnership ) {
+                if ( _graph )
+                    _graph->recycleSelectionItem(_selectionItem.data());
+                else
+                    _selectionItem->deleteLater();
+            }
         }
 
         if ( selectionItem ) {
@@ -255,15 +255,16 @@ signals:
     void            styleModified();
 
 public:
-    //! Define edge style: either straight (drawn with a line) or curved (drawn with a cubic path).
+    //! Define edge style: either straight (drawn with a line), curved (drawn with a cubic path) or orthogonal (drawn with a polyline routed by qan::OrthogonalRouter).
     enum class LineType : unsigned int {
         Straight    = 0,
-        Curved      = 1
+        Curved      = 1,
+        Ortho       = 2
     };
     Q_ENUM(LineType)
 
 public:
-    //! Define edge line type: either plain line (Straight) or curved cubic path (Curved), default to Straight.
+    //! Define edge line type: either plain line (Straight), curved cubic path (Curved) or orthogonal route (Ortho), default to Straight.
     Q_PROPERTY( LineType lineType READ getLineType WRITE setLineType NOTIFY lineTypeChanged FINAL )
     void            setLineType( LineType lineType ) noexcept;
     inline LineType getLineType() const noexcept { return _lineType; }
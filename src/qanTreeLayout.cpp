@@ -0,0 +1,261 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the QuickQanava software library.
+//
+// \file	qanTreeLayout.cpp
+// \author	benoit@destrat.io
+// \date	2017 12 24
+//-----------------------------------------------------------------------------
+
+// Std headers
+#include <limits>
+
+// GTpo headers
+#include <gtpoTreeLayout.h>
+
+// QuickQanava headers
+#include "./qanTreeLayout.h"
+
+namespace qan { // ::qan
+
+/* TreeLayout Object Management *///-------------------------------------------
+TreeLayout::TreeLayout( QObject* parent ) :
+    QObject{ parent },
+    _layout{ std::make_unique<gtpo::TreeLayout>() }
+{
+}
+
+TreeLayout::~TreeLayout()
+{
+    if ( _graph )
+        ForwardingBehaviour<qan::TreeLayout>::uninstall( *_graph, this );
+}
+//-----------------------------------------------------------------------------
+
+/* Layout Configuration *///---------------------------------------------------
+void    TreeLayout::setGraph( qan::Graph* graph ) noexcept
+{
+    if ( graph != _graph ) {
+        clearCollapsed();
+        if ( _graph ) {
+            ForwardingBehaviour<qan::TreeLayout>::uninstall( *_graph, this );
+            disconnect( _graph, nullptr, this, nullptr );
+        }
+        _graph = graph;
+        if ( _graph ) {
+            ForwardingBehaviour<qan::TreeLayout>::install( *_graph, this );
+            connect( _graph,    &qan::Graph::cleared,
+                     this,      &TreeLayout::graphCleared );
+        }
+        _snapshotValid = false;
+        emit graphChanged();
+    }
+}
+
+void    TreeLayout::setOrientation( Orientation orientation ) noexcept
+{
+    if ( orientation != _orientation ) {
+        _orientation = orientation;
+        emit orientationChanged();
+    }
+}
+
+void    TreeLayout::setRadial( bool radial ) noexcept
+{
+    if ( radial != _radial ) {
+        _radial = radial;
+        emit radialChanged();
+    }
+}
+
+void    TreeLayout::setSiblingSpacing( qreal siblingSpacing ) noexcept
+{
+    siblingSpacing = std::max( 0., siblingSpacing );
+    if ( !qFuzzyCompare( 1. + siblingSpacing, 1. + _siblingSpacing ) ) {
+        _siblingSpacing = siblingSpacing;
+        emit siblingSpacingChanged();
+    }
+}
+
+void    TreeLayout::setLevelSpacing( qreal levelSpacing ) noexcept
+{
+    levelSpacing = std::max( 0., levelSpacing );
+    if ( !qFuzzyCompare( 1. + levelSpacing, 1. + _levelSpacing ) ) {
+        _levelSpacing = levelSpacing;
+        emit levelSpacingChanged();
+    }
+}
+//-----------------------------------------------------------------------------
+
+/* Layout Management *///------------------------------------------------------
+bool    TreeLayout::layout()
+{
+    if ( !_graph ) {
+        qWarning() << "qan::TreeLayout::layout(): Error: No target graph.";
+        return false;
+    }
+
+    // Snapshot graph topology: ungrouped nodes sizes, edges between them and graph roots
+    auto& layout = *_layout;
+    layout.clear();
+    _nodes.clear();
+    _nodes.reserve( static_cast<std::size_t>( _graph->getNodeCount() ) );
+    _nodeIndexes.clear();
+    _nodeIndexes.reserve( _graph->getNodeCount() );
+    qreal left = std::numeric_limits<qreal>::max(), top = std::numeric_limits<qreal>::max();
+    for ( const auto& node : _graph->getNodes() ) {
+        if ( !node ||
+             !node->getGroup().expired() )
+            continue;
+        const auto geometry = node->getGeometry();
+        left = std::min( left, geometry.left() );
+        top = std::min( top, geometry.top() );
+        const auto index = layout.addNode( geometry.width(), geometry.height() );
+        layout.collapsed[index] = _collapsed.contains( node.get() ) ? 1 : 0;
+        _nodeIndexes.insert( node.get(), index );
+        _nodes.emplace_back( node.get() );
+    }
+    for ( const auto& edge : _graph->getEdges() ) {
+        if ( !edge )
+            continue;
+        const auto src = _nodeIndexes.constFind( edge->getSrc().lock().get() );
+        const auto dst = _nodeIndexes.constFind( edge->getDst().lock().get() );  // Null for hyper edges
+        if ( src != _nodeIndexes.constEnd() &&
+             dst != _nodeIndexes.constEnd() )
+            layout.addEdge( src.value(), dst.value() );
+    }
+    for ( const auto& weakRoot : _graph->getRootNodes() ) {
+        const auto root = _nodeIndexes.constFind( weakRoot.lock().get() );
+        if ( root != _nodeIndexes.constEnd() )
+            layout.roots.push_back( static_cast<std::uint32_t>( root.value() ) );
+    }
+    _snapshotValid = true;
+
+    layout.horizontal = _orientation == Orientation::LeftToRight;
+    layout.radial = _radial;
+    layout.siblingSpacing = _siblingSpacing;
+    layout.levelSpacing = _levelSpacing;
+    layout.compute();
+
+    // Translate layout to keep nodes bounding rect top left corner unchanged
+    qreal layoutLeft = std::numeric_limits<qreal>::max(), layoutTop = std::numeric_limits<qreal>::max();
+    for ( std::size_t n = 0; n < _nodes.size(); ++n ) {
+        layoutLeft = std::min( layoutLeft, layout.x[n] - layout.width[n] / 2. );
+        layoutTop = std::min( layoutTop, layout.y[n] - layout.height[n] / 2. );
+    }
+    _translation = _nodes.empty() ? QPointF{} : QPointF{ left - layoutLeft, top - layoutTop };
+    applyLayout();
+    return true;
+}
+
+void    TreeLayout::setCollapsed( qan::Node* node, bool collapsed )
+{
+    if ( node == nullptr )
+        return;
+    if ( collapsed &&
+         !_collapsed.contains( node ) ) {
+        _collapsed.insert( node );
+        connect( node, &QObject::destroyed, this, [this, node]() { _collapsed.remove( node ); } );
+    } else if ( !collapsed &&
+                _collapsed.remove( node ) )
+        disconnect( node, &QObject::destroyed, this, nullptr );
+    else
+        return;
+
+    // Incremental layout when last snapshot is still valid, complete layout otherwise
+    const auto index = _nodeIndexes.constFind( node );
+    if ( !_graph ||
+         !_snapshotValid ||
+         index == _nodeIndexes.constEnd() ) {
+        layout();
+        return;
+    }
+    _layout->collapsed[index.value()] = collapsed ? 1 : 0;
+    _layout->update( index.value() );
+    applyLayout();
+}
+
+bool    TreeLayout::isCollapsed( qan::Node* node ) const noexcept
+{
+    return node != nullptr && _collapsed.contains( node );
+}
+
+void    TreeLayout::clearCollapsed() noexcept
+{
+    for ( const auto node : _collapsed )
+        disconnect( node, &QObject::destroyed, this, nullptr );
+    _collapsed.clear();
+}
+
+void    TreeLayout::applyLayout()
+{
+    const auto& layout = *_layout;
+    if ( !_graph ||
+         layout.x.size() != _nodes.size() )
+        return;
+
+    // Apply modified nodes positions in a single batch (all nodes after compute()), edges are then updated once
+    const auto setEdgeVisible = [this, &layout]( const qan::Edge* edge ) {
+        const auto edgeItem = edge != nullptr ? edge->getItem() : nullptr;
+        if ( edgeItem == nullptr )
+            return;
+        // Edges are visible only when both their end nodes are visible
+        const auto src = _nodeIndexes.constFind( edge->getSrc().lock().get() );
+        const auto dst = _nodeIndexes.constFind( edge->getDst().lock().get() );
+        edgeItem->setVisible( ( src == _nodeIndexes.constEnd() || layout.visible[src.value()] ) &&
+                              ( dst == _nodeIndexes.constEnd() || layout.visible[dst.value()] ) );
+    };
+    _graph->beginGeometryUpdate();
+    for ( const auto n : layout.modified ) {
+        const auto node = _nodes[n].data();
+        if ( node == nullptr )
+            continue;
+        auto geometry = node->getGeometry();
+        geometry.moveCenter( QPointF{ layout.x[n], layout.y[n] } + _translation );
+        node->setGeometry( geometry );
+        if ( node->getItem() != nullptr )
+            node->getItem()->setVisible( layout.visible[n] != 0 );
+        for ( const auto& inEdge : node->getInEdges() )
+            setEdgeVisible( inEdge.lock().get() );
+        for ( const auto& outEdge : node->getOutEdges() )
+            setEdgeVisible( outEdge.lock().get() );
+    }
+    _graph->endGeometryUpdate();
+    emit finished();
+}
+
+void    TreeLayout::graphCleared()
+{
+    if ( _graph )
+        ForwardingBehaviour<qan::TreeLayout>::install( *_graph, this );
+    _snapshotValid = false;
+}
+//-----------------------------------------------------------------------------
+
+} // ::qan
+
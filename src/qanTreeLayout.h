@@ -0,0 +1,237 @@
+/*
+ Copyright (c) 2008-2017, Benoit AUTHEMAN All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the author or Destrat.io nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL AUTHOR BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//-----------------------------------------------------------------------------
+// This file is a part of the QuickQanava software library.
+//
+// \file	qanTreeLayout.h
+// \author	benoit@destrat.io
+// \date	2017 12 24
+//-----------------------------------------------------------------------------
+
+#ifndef qanTreeLayout_h
+#define qanTreeLayout_h
+
+// Std headers
+#include <memory>
+#include <vector>
+
+// Qt headers
+#include <QObject>
+#include <QPointer>
+#include <QHash>
+#include <QSet>
+
+// QuickQanava headers
+#include "./qanGraph.h"
+#include "./qanForwardingBehaviour.h"
+
+namespace gtpo {
+class TreeLayout;
+}
+
+namespace qan { // ::qan
+
+/*! \brief Tidy tree (Reingold-Tilford) and radial tree layouts with collapsible subtrees.
+ *
+ * Graph roots (see gtpo::GenGraph::getRootNodes()) are used as tree roots, a spanning forest is extracted from graph
+ * edges and laid out in linear time (see gtpo::TreeLayout for a description of the algorithm). Layout is fast enough
+ * to be computed synchronously in the GUI thread, node positions are applied in a single geometry update (see
+ * qan::Graph::beginGeometryUpdate()).
+ *
+ * A subtree could be collapsed with setCollapsed(): descendants of a collapsed node are moved under it and their
+ * items (and the items of their edges) are hidden. Collapsing or expanding a subtree is incremental, only the
+ * modified subtree and its ancestors are laid out again, other subtrees keep their relative position, and only
+ * the nodes that have moved (or whose visibility has changed) are updated.
+ *
+ * \code
+ *  Qan.TreeLayout {
+ *    id: treeLayout
+ *    graph: graphView.graph
+ *    orientation: Qan.TreeLayout.TopToBottom
+ *  }
+ *  // treeLayout.layout()
+ *  // treeLayout.setCollapsed( node, !treeLayout.isCollapsed( node ) )
+ * \endcode
+ *
+ * \note Grouped nodes and hyper edges are actually ignored. Graph topology modifications (node or edge
+ * insertion or removal) invalidate last layout, next setCollapsed() call then lay out graph completely.
+ * In a virtualized graph, items created after a subtree has been collapsed are not hidden.
+ */
+class TreeLayout : public QObject
+{
+    /*! \name TreeLayout Object Management *///--------------------------------
+    //@{
+    Q_OBJECT
+public:
+    explicit TreeLayout( QObject* parent = nullptr );
+    virtual ~TreeLayout();
+    TreeLayout( const TreeLayout& ) = delete;
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Layout Configuration *///----------------------------------------
+    //@{
+public:
+    //! Laid out graph (default to nullptr).
+    Q_PROPERTY( qan::Graph* graph READ getGraph WRITE setGraph NOTIFY graphChanged FINAL )
+    //! \copydoc graph
+    inline qan::Graph*  getGraph() const noexcept { return _graph.data(); }
+    //! \copydoc graph
+    void                setGraph( qan::Graph* graph ) noexcept;
+private:
+    //! \copydoc graph
+    QPointer<qan::Graph> _graph;
+signals:
+    //! \copydoc graph
+    void                graphChanged();
+
+public:
+    enum class Orientation : unsigned int {
+        //! Roots are on top, tree levels are ordered from top to bottom.
+        TopToBottom = 0,
+        //! Roots are on left, tree levels are ordered from left to right.
+        LeftToRight = 1
+    };
+    Q_ENUM(Orientation)
+
+    //! Tree levels orientation, ignored for a radial layout (default to TopToBottom).
+    Q_PROPERTY( Orientation orientation READ getOrientation WRITE setOrientation NOTIFY orientationChanged FINAL )
+    //! \copydoc orientation
+    inline Orientation  getOrientation() const noexcept { return _orientation; }
+    //! \copydoc orientation
+    void                setOrientation( Orientation orientation ) noexcept;
+private:
+    //! \copydoc orientation
+    Orientation         _orientation{ Orientation::TopToBottom };
+signals:
+    //! \copydoc orientation
+    void                orientationChanged();
+
+public:
+    //! Generate a radial layout with root at center and tree levels on concentric circles (default to false).
+    Q_PROPERTY( bool radial READ getRadial WRITE setRadial NOTIFY radialChanged FINAL )
+    //! \copydoc radial
+    inline bool     getRadial() const noexcept { return _radial; }
+    //! \copydoc radial
+    void            setRadial( bool radial ) noexcept;
+private:
+    //! \copydoc radial
+    bool            _radial{ false };
+signals:
+    //! \copydoc radial
+    void            radialChanged();
+
+public:
+    //! Minimum space between two nodes in the same tree level (default to 20.).
+    Q_PROPERTY( qreal siblingSpacing READ getSiblingSpacing WRITE setSiblingSpacing NOTIFY siblingSpacingChanged FINAL )
+    //! \copydoc siblingSpacing
+    inline qreal    getSiblingSpacing() const noexcept { return _siblingSpacing; }
+    //! \copydoc siblingSpacing
+    void            setSiblingSpacing( qreal siblingSpacing ) noexcept;
+private:
+    //! \copydoc siblingSpacing
+    qreal           _siblingSpacing{ 20. };
+signals:
+    //! \copydoc siblingSpacing
+    void            siblingSpacingChanged();
+
+public:
+    //! Minimum space between two consecutive tree levels (default to 60.).
+    Q_PROPERTY( qreal levelSpacing READ getLevelSpacing WRITE setLevelSpacing NOTIFY levelSpacingChanged FINAL )
+    //! \copydoc levelSpacing
+    inline qreal    getLevelSpacing() const noexcept { return _levelSpacing; }
+    //! \copydoc levelSpacing
+    void            setLevelSpacing( qreal levelSpacing ) noexcept;
+private:
+    //! \copydoc levelSpacing
+    qreal           _levelSpacing{ 60. };
+signals:
+    //! \copydoc levelSpacing
+    void            levelSpacingChanged();
+    //@}
+    //-------------------------------------------------------------------------
+
+    /*! \name Layout Management *///-------------------------------------------
+    //@{
+public:
+    /*! \brief Lay out \c graph, layout top left corner is kept at actual nodes top left corner.
+     *
+     * \return false if there is no target graph.
+     */
+    Q_INVOKABLE bool    layout();
+
+    /*! \brief Collapse (or expand) \c node subtree.
+     *
+     * When graph has already been laid out, only \c node subtree and its ancestors are laid out again, graph is
+     * completely laid out otherwise (see layout()).
+     */
+    Q_INVOKABLE void    setCollapsed( qan::Node* node, bool collapsed = true );
+    //! Return true if \c node has been collapsed with setCollapsed().
+    Q_INVOKABLE bool    isCollapsed( qan::Node* node ) const noexcept;
+    //! Expand all collapsed nodes (modification apply on next layout()).
+    Q_INVOKABLE void    clearCollapsed() noexcept;
+
+signals:
+    //! Emitted when node positions have been applied to graph after layout() or setCollapsed().
+    void            finished();
+
+private:
+    //! Apply modified nodes layout positions and collapsed subtrees visibility to graph nodes and edges.
+    void            applyLayout();
+
+private:
+    friend class qan::ForwardingBehaviour<qan::TreeLayout>;
+    //! Called from \c graph behaviour when a node is inserted, last layout() snapshot is invalidated.
+    void            nodeInserted( qan::Node* node ) { Q_UNUSED( node ); _snapshotValid = false; }
+    //! Called from \c graph behaviour before a node is removed, last layout() snapshot is invalidated.
+    void            nodeRemoved( qan::Node* node ) { Q_UNUSED( node ); _snapshotValid = false; }
+    //! Called from \c graph behaviour when an edge is inserted, last layout() snapshot is invalidated.
+    void            edgeInserted( qan::Edge* edge ) { Q_UNUSED( edge ); _snapshotValid = false; }
+    //! Called from \c graph behaviour before an edge is removed, last layout() snapshot is invalidated.
+    void            edgeRemoved( qan::Edge* edge ) { Q_UNUSED( edge ); _snapshotValid = false; }
+    //! Reinstall \c graph behaviour (destroyed with graph content) after qan::Graph::clear().
+    void            graphCleared();
+
+private:
+    QSet<const qan::Node*>                  _collapsed;
+    std::unique_ptr<gtpo::TreeLayout>       _layout;
+    //! Nodes of last layout() snapshot, in layout node index order.
+    std::vector<QPointer<qan::Node>>        _nodes;
+    QHash<const qan::Node*, std::size_t>    _nodeIndexes;
+    //! False when graph topology has been modified since last layout() snapshot has been taken.
+    bool                                    _snapshotValid{ false };
+    //! Translation from layout coordinates to graph coordinates, fixed by layout() to keep incremental updates stable.
+    QPointF                                 _translation;
+    //@}
+    //-------------------------------------------------------------------------
+};
+
+} // ::qan
+
+QML_DECLARE_TYPE( qan::TreeLayout )
+
+#endif // qanTreeLayout_h
@@ -1,6 +1,6 @@
 
 CONFIG      += warn_on qt thread c++14
-QT          += core widgets gui qml quick
+QT          += core widgets gui qml quick concurrent
 
 include(../GTpo/src/gtpo.pri)
 include(../QuickContainers/src/quickcontainers.pri)
@@ -22,11 +22,13 @@ HEADERS +=  $$PWD/QuickQanava.h             \
             $$PWD/qanPortItem.h             \
             $$PWD/qanSelectable.h           \
             $$PWD/qanDraggable.h            \
+            $$PWD/qanRecyclable.h           \
             $$PWD/qanAbstractDraggableCtrl.h\
             $$PWD/qanDraggableCtrl.h        \
             $$PWD/qanDraggableCtrl.hpp      \
             $$PWD/qanConnector.h            \
             $$PWD/qanBehaviour.h            \
+            $$PWD/qanForwardingBehaviour.h  \
             $$PWD/qanGroup.h                \
             $$PWD/qanGroupItem.h            \
             $$PWD/qanGraph.h                \
@@ -36,6 +38,23 @@ HEADERS +=  $$PWD/QuickQanava.h             \
             $$PWD/qanNavigable.h            \
             $$PWD/qanNavigablePreview.h     \
             $$PWD/qanGrid.h                 \
+            $$PWD/qanEdgeListLoader.h       \
+            $$PWD/qanSceneSerializer.h      \
+            $$PWD/qanOutOfCoreMaterializer.h    \
+            $$PWD/qanItemPool.h             \
+            $$PWD/qanEdgeRenderer.h         \
+            $$PWD/qanNodeRenderer.h         \
+            $$PWD/qanLevelOfDetail.h        \
+            $$PWD/qanBoundingShapeCache.h   \
+            $$PWD/qanAbstractLayout.h       \
+            $$PWD/qanForceDirectedLayout.h  \
+            $$PWD/qanLayeredLayout.h        \
+            $$PWD/qanTreeLayout.h           \
+            $$PWD/qanCompoundLayout.h       \
+            $$PWD/qanComponentLayout.h      \
+            $$PWD/qanIncrementalLayout.h    \
+            $$PWD/qanOrthogonalRouter.h     \
+            $$PWD/qanEdgeBundler.h          \
             $$PWD/qanContainerAdapter.h     \
             $$PWD/qanBottomRightResizer.h
 
@@ -58,6 +77,23 @@ SOURCES +=  $$PWD/qanGraphView.cpp          \
             $$PWD/qanNavigable.cpp          \
             $$PWD/qanNavigablePreview.cpp   \
             $$PWD/qanGrid.cpp               \
+            $$PWD/qanEdgeListLoader.cpp     \
+            $$PWD/qanSceneSerializer.cpp    \
+            $$PWD/qanOutOfCoreMaterializer.cpp  \
+            $$PWD/qanItemPool.cpp           \
+            $$PWD/qanEdgeRenderer.cpp       \
+            $$PWD/qanNodeRenderer.cpp       \
+            $$PWD/qanLevelOfDetail.cpp      \
+            $$PWD/qanBoundingShapeCache.cpp \
+            $$PWD/qanAbstractLayout.cpp     \
+            $$PWD/qanForceDirectedLayout.cpp    \
+            $$PWD/qanLayeredLayout.cpp      \
+            $$PWD/qanTreeLayout.cpp         \
+            $$PWD/qanCompoundLayout.cpp     \
+            $$PWD/qanComponentLayout.cpp    \
+            $$PWD/qanIncrementalLayout.cpp  \
+            $$PWD/qanOrthogonalRouter.cpp   \
+            $$PWD/qanEdgeBundler.cpp        \
             $$PWD/qanBottomRightResizer.cpp
 
 OTHER_FILES +=  $$PWD/QuickQanava               \
@@ -77,6 +113,7 @@ OTHER_FILES +=  $$PWD/QuickQanava               \
                 $$PWD/VerticalDock.qml          \
                 $$PWD/Edge.qml                  \
                 $$PWD/EdgeTemplate.qml                  \
+                $$PWD/BatchedEdge.qml           \
                 $$PWD/SelectionItem.qml         \
                 $$PWD/StyleListView.qml         \
                 $$PWD/StyleEditor.qml           \